@@ -251,7 +251,8 @@ bool BlockFS::deleteSource(const std::string &name_or_id) {
 
 std::shared_ptr<base::IDataArray> BlockFS::createDataArray(const std::string &name, const std::string &type,
                                                            nix::DataType data_type, const NDSize &shape,
-                                                           const Compression &compression) {
+                                                           const Compression &compression,
+                                                           const StringStorage &strings) {
     if (name.empty()) {
         throw EmptyString("Block::createDataArray empty name provided!");
     }
@@ -264,6 +265,12 @@ std::shared_ptr<base::IDataArray> BlockFS::createDataArray(const std::string &na
     return std::make_shared<DataArrayFS>(da);
 }
 
+std::shared_ptr<base::IDataArray> BlockFS::createVirtualDataArray(const std::string &name, const std::string &type,
+                                                                  nix::DataType data_type, const NDSize &shape,
+                                                                  const std::vector<base::VirtualSource> &sources) {
+    throw std::runtime_error("not implemented");
+}
+
 //--------------------------------------------------
 // Methods concerning data arrays
 //--------------------------------------------------
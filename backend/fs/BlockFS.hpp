@@ -117,7 +117,13 @@ public:
 
     std::shared_ptr<base::IDataArray> createDataArray(const std::string &name, const std::string &type,
                                                       nix::DataType data_type, const NDSize &shape,
-                                                      const Compression &compression);
+                                                      const Compression &compression,
+                                                      const StringStorage &strings);
+
+
+    std::shared_ptr<base::IDataArray> createVirtualDataArray(const std::string &name, const std::string &type,
+                                                             DataType data_type, const NDSize &shape,
+                                                             const std::vector<base::VirtualSource> &sources);
 
     //--------------------------------------------------
     // Methods concerning data frames
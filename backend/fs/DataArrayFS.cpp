@@ -184,24 +184,28 @@ std::shared_ptr<base::IDimension> DataArrayFS::getDimension(ndsize_t index) cons
 
 std::shared_ptr<base::ISetDimension> DataArrayFS::createSetDimension(ndsize_t index) {
     SetDimensionFS dim(dimensions.location(), index, fileMode());
+    forceUpdatedAt();
     return std::make_shared<SetDimensionFS>(dim);
 }
 
 
 std::shared_ptr<base::IRangeDimension> DataArrayFS::createRangeDimension(ndsize_t index, const std::vector<double> &ticks) {
     RangeDimensionFS dim(dimensions.location(), index, ticks, fileMode());
+    forceUpdatedAt();
     return std::make_shared<RangeDimensionFS>(dim);
 }
 
 
 std::shared_ptr<base::IRangeDimension> DataArrayFS::createAliasRangeDimension() {
     RangeDimensionFS dim(dimensions.location(), 1, *this, fileMode());
+    forceUpdatedAt();
     return std::make_shared<RangeDimensionFS>(dim);
 }
 
 
 std::shared_ptr<base::ISampledDimension> DataArrayFS::createSampledDimension(ndsize_t index, double sampling_interval) {
     SampledDimensionFS dim(dimensions.location(), index, sampling_interval, fileMode());
+    forceUpdatedAt();
     return std::make_shared<SampledDimensionFS>(dim);
 }
 
@@ -225,6 +229,7 @@ Group DataArrayFS::createDimensionGroup(size_t index) {
 bool DataArrayFS::deleteDimensions() {
     if (fileMode() != FileMode::ReadOnly) {
         this->dimensions.removeAll();
+        forceUpdatedAt();
         return true;
     } else {
         return false;
@@ -280,6 +285,11 @@ void DataArrayFS::write(DataType dtype, const void *data, const NDSize &count, c
     */ // FIXME
 }
 
+void DataArrayFS::writeParallel(DataType dtype, const void *data, const NDSize &count, const NDSize &offset,
+                                size_t nthreads) {
+    write(dtype, data, count, offset);
+}
+
 void DataArrayFS::read(DataType dtype, void *data, const NDSize &count, const NDSize &offset) const {
     if (!hasObject("data")) {
         return;
@@ -301,6 +311,24 @@ void DataArrayFS::read(DataType dtype, void *data, const NDSize &count, const ND
     */
 }
 
+void DataArrayFS::read(DataType dtype, void *data, const Selection &selection) const {
+    const NDSize extent = dataExtent();
+    const size_t esize = dtype == DataType::String ? sizeof(std::string) : data_type_to_size(dtype);
+    char *ptr = static_cast<char *>(data);
+
+    for (const Selection::Run &run : selection.runs(extent)) {
+        NDSize count(extent.size(), 1);
+        count[count.size() - 1] = run.length;
+        read(dtype, ptr, count, run.offset);
+        ptr += run.length * esize;
+    }
+}
+
+void DataArrayFS::readParallel(DataType dtype, void *buffer, const NDSize &count, const NDSize &offset,
+                               size_t nthreads) const {
+    read(dtype, buffer, count, offset);
+}
+
 NDSize DataArrayFS::dataExtent(void) const {
     if (!hasAttr("extent")) {
         return NDSize{};
@@ -323,6 +351,7 @@ void DataArrayFS::dataExtent(const NDSize &extent) {
         removeAttr("extent");
     }
     setAttr("extent", ext);
+    forceUpdatedAt();
 }
 
 DataType DataArrayFS::dataType(void) const {
@@ -335,6 +364,57 @@ DataType DataArrayFS::dataType(void) const {
 }
 
 
+NDSize DataArrayFS::dataChunks(void) const {
+    return NDSize{};
+}
+
+ndsize_t DataArrayFS::dataStorageSize(void) const {
+    return 0;
+}
+
+StorageLayout DataArrayFS::dataLayout(void) const {
+    StorageLayout layout;
+    layout.shape = dataExtent();
+    DataType dtype = dataType();
+    if (data_type_is_numeric(dtype)) {
+        layout.element_size = data_type_to_size(dtype);
+    }
+    return layout;
+}
+
+StringStorage DataArrayFS::stringStorage(void) const {
+    return StringStorage();
+}
+
+std::vector<std::string> DataArrayFS::stringDictionary(void) const {
+    return std::vector<std::string>();
+}
+
+void DataArrayFS::readStringCodes(uint32_t *codes, const NDSize &count, const NDSize &offset) const {
+}
+
+// FIXME: envelopes need data storage, which is not implemented yet
+ndsize_t DataArrayFS::envelopeFactor() const {
+    return 0;
+}
+
+void DataArrayFS::envelopeFactor(ndsize_t factor) {
+}
+
+ndsize_t DataArrayFS::envelopeSize(size_t level) const {
+    return 0;
+}
+
+void DataArrayFS::envelopeSize(size_t level, ndsize_t size) {
+}
+
+void DataArrayFS::readEnvelope(size_t level, double *data, ndsize_t count, ndsize_t offset) const {
+}
+
+void DataArrayFS::writeEnvelope(size_t level, const double *data, ndsize_t count, ndsize_t offset) {
+}
+
+
 void DataArrayFS::setDtype(nix::DataType dtype) {
     if (hasAttr("dtype")) {
         removeAttr("dtype");
@@ -149,9 +149,20 @@ public:
     void write(DataType dtype, const void *data, const NDSize &count, const NDSize &offset);
 
 
+    void writeParallel(DataType dtype, const void *data, const NDSize &count, const NDSize &offset,
+                       size_t nthreads);
+
+
     void read(DataType dtype, void *buffer, const NDSize &count, const NDSize &offset) const;
 
 
+    void read(DataType dtype, void *buffer, const Selection &selection) const;
+
+
+    void readParallel(DataType dtype, void *buffer, const NDSize &count, const NDSize &offset,
+                      size_t nthreads) const;
+
+
     NDSize dataExtent(void) const;
 
 
@@ -160,6 +171,45 @@ public:
 
     DataType dataType(void) const;
 
+
+    NDSize dataChunks(void) const;
+
+
+    ndsize_t dataStorageSize(void) const;
+
+
+    StorageLayout dataLayout(void) const;
+
+
+    StringStorage stringStorage(void) const;
+
+
+    std::vector<std::string> stringDictionary(void) const;
+
+
+    void readStringCodes(uint32_t *codes, const NDSize &count, const NDSize &offset) const;
+
+    //--------------------------------------------------
+    // Methods concerning data envelopes.
+    //--------------------------------------------------
+
+    ndsize_t envelopeFactor() const;
+
+
+    void envelopeFactor(ndsize_t factor);
+
+
+    ndsize_t envelopeSize(size_t level) const;
+
+
+    void envelopeSize(size_t level, ndsize_t size);
+
+
+    void readEnvelope(size_t level, double *data, ndsize_t count, ndsize_t offset) const;
+
+
+    void writeEnvelope(size_t level, const double *data, ndsize_t count, ndsize_t offset);
+
 };
 
 
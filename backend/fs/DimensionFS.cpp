@@ -285,6 +285,11 @@ std::vector<std::string> SetDimensionFS::labels() const {
 }
 
 
+ndsize_t SetDimensionFS::labelCount() const {
+    return labels().size();
+}
+
+
 void SetDimensionFS::labels(const std::vector<std::string> &labels) {
     setAttr("labels", labels);
 }
@@ -426,6 +431,11 @@ std::vector<double> RangeDimensionFS::ticks() const {
 }
 
 
+ndsize_t RangeDimensionFS::tickCount() const {
+    return ticks().size();
+}
+
+
 void RangeDimensionFS::ticks(const std::vector<double> &ticks) {
     /*
     Group g = redirectGroup();
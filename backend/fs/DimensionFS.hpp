@@ -131,6 +131,9 @@ public:
     std::vector<std::string> labels() const;
 
 
+    ndsize_t labelCount() const;
+
+
     void labels(const std::vector<std::string> &labels);
 
 
@@ -184,6 +187,9 @@ public:
     std::vector<double> ticks() const;
 
 
+    ndsize_t tickCount() const;
+
+
     void ticks(const std::vector<double> &ticks);
 
 
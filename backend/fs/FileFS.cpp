@@ -135,14 +135,26 @@ std::shared_ptr<base::ISection> FileFS::createSection(const std::string &name, c
     }
     std::string id = util::createId();
     SectionFS s(file(), metadata_dir.location(), id, type, name);
+    metadata_snapshot.reset();
     return std::make_shared<SectionFS>(s);
 }
 
 
 bool FileFS::deleteSection(const std::string &name_or_id) {
+    metadata_snapshot.reset();
     return metadata_dir.removeObjectByNameOrAttribute("entity_id", name_or_id);
 }
 
+
+std::shared_ptr<const MetadataSnapshot> FileFS::metadataSnapshot() const {
+    return metadata_snapshot;
+}
+
+
+void FileFS::metadataSnapshot(const std::shared_ptr<const MetadataSnapshot> &snapshot) {
+    metadata_snapshot = snapshot;
+}
+
 //--------------------------------------------------
 // Methods for file attribute access.
 //--------------------------------------------------
@@ -208,6 +220,21 @@ void FileFS::forceCreatedAt(time_t t) {
 }
 
 
+time_t FileFS::validatedAt() const {
+    if (!hasAttr("validated_at")) {
+        return 0;
+    }
+    std::string temp_t;
+    getAttr("validated_at", temp_t);
+    return util::strToTime(temp_t);
+}
+
+
+void FileFS::forceValidatedAt(time_t t) {
+    setAttr("validated_at", util::timeToStr(t));
+}
+
+
 void FileFS::close() {} // FIXME not needed?
 
 bool FileFS::isOpen() const { //FIXME not needed?
@@ -258,6 +285,11 @@ FileMode FileFS::fileMode() const {
     return mode;
 }
 
+
+void FileFS::startSwmrWrite() {
+    throw std::runtime_error("FileFS::startSwmrWrite: SWMR is only supported by the hdf5 backend");
+}
+
 Compression FileFS::compression() const {
     return compr;
 }
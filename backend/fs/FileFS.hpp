@@ -25,6 +25,7 @@ private:
     Directory data_dir, metadata_dir;
     Compression compr;
     FileMode mode;
+    std::shared_ptr<const MetadataSnapshot> metadata_snapshot;
 
     void create_subfolders(const std::string &loc);
 
@@ -73,6 +74,12 @@ public:
 
     bool deleteSection(const std::string &name_or_id);
 
+
+    std::shared_ptr<const MetadataSnapshot> metadataSnapshot() const;
+
+
+    void metadataSnapshot(const std::shared_ptr<const MetadataSnapshot> &snapshot);
+
     //--------------------------------------------------
     // Methods for file attribute access.
     //--------------------------------------------------
@@ -105,6 +112,12 @@ public:
     void forceCreatedAt(time_t t);
 
 
+    time_t validatedAt() const;
+
+
+    void forceValidatedAt(time_t t);
+
+
     void close();
 
 
@@ -114,6 +127,9 @@ public:
     FileMode fileMode() const;
 
 
+    void startSwmrWrite();
+
+
     Compression compression() const;
 
 
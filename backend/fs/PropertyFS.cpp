@@ -220,6 +220,16 @@ void PropertyFS::values(const nix::none_t t) {
 }
 
 
+void PropertyFS::readValues(DataType dtype, void *data, ndsize_t count, ndsize_t offset) const {
+    // FIXME
+}
+
+
+void PropertyFS::writeValues(DataType dtype, const void *data, ndsize_t count, ndsize_t offset) {
+    // FIXME
+}
+
+
 bool PropertyFS::isValidEntity() const {
     return isValid();
 }
@@ -83,6 +83,12 @@ void SectionFS::repository(const std::string &repository) {
 }
 
 
+void SectionFS::forceUpdatedAt() {
+    NamedEntityFS::forceUpdatedAt();
+    file()->metadataSnapshot(nullptr);
+}
+
+
 boost::optional<std::string> SectionFS::repository() const {
     boost::optional<std::string> ret;
     std::string repository;
@@ -123,7 +129,7 @@ void SectionFS::link(const std::string &id) {
 std::shared_ptr<base::ISection> SectionFS::link() const {
     std::shared_ptr<base::ISection> sec;
 
-    if (bfs::exists({location() + "/link"})) {
+    if (bfs::exists(bfs::path{location() + "/link"})) {
         auto sec_tmp = std::make_shared<SectionFS>(file(), location() + "/link");
         // re-get above section "sec_tmp": parent missing, findSections will set it!
         auto found = File(file()).findSections(util::IdFilter<Section>(sec_tmp->id()));
@@ -136,7 +142,7 @@ std::shared_ptr<base::ISection> SectionFS::link() const {
 
 
 void SectionFS::link(const none_t t) {
-    if (bfs::exists({location() + "/link"})) {
+    if (bfs::exists(bfs::path{location() + "/link"})) {
         bfs::remove_all({location() + "/link"});
     }
     forceUpdatedAt();
@@ -193,6 +199,7 @@ std::shared_ptr<base::ISection> SectionFS::createSection(const std::string &name
     }
     std::string id = util::createId();
     SectionFS s(file(), shared_from_this(), subsection_dir.location(), id, type, name);
+    file()->metadataSnapshot(nullptr);
     return std::make_shared<SectionFS>(s);
 }
 
@@ -200,6 +207,7 @@ std::shared_ptr<base::ISection> SectionFS::createSection(const std::string &name
 bool SectionFS::deleteSection(const std::string &name_or_id) {
     bool success = true;
     Section s = getSection(name_or_id);
+    file()->metadataSnapshot(nullptr);
     success = SectionFS::removeSubsections(s);
     if (success) {
         success = success && subsection_dir.removeObjectByNameOrAttribute("entity_id", name_or_id);
@@ -256,10 +264,18 @@ std::shared_ptr<base::IProperty> SectionFS::createProperty(const std::string &na
         throw DuplicateName("hasProperty");
     }
     std::string new_id = util::createId();
+    file()->metadataSnapshot(nullptr);
     return std::make_shared<PropertyFS>(file(), property_dir.location(), new_id, name, dtype);
 }
 
 
+std::shared_ptr<base::IProperty> SectionFS::createProperty(const std::string &name, const DataType &dtype,
+                                                           const StringStorage &strings) {
+    // values are stored as text, the layout of strings does not apply
+    return createProperty(name, dtype);
+}
+
+
 std::shared_ptr<base::IProperty> SectionFS::createProperty(const std::string &name, const Variant &value) {
     std::shared_ptr<base::IProperty> p = createProperty(name, value.type());
     std::vector<Variant> val{value};
@@ -279,6 +295,7 @@ std::shared_ptr<base::IProperty> SectionFS::createProperty(const std::string &na
 
 
 bool SectionFS::deleteProperty(const std::string &name_or_id) {
+    file()->metadataSnapshot(nullptr);
     return property_dir.removeObjectByNameOrAttribute("entity_id", name_or_id);
 }
 
@@ -308,7 +308,8 @@ shared_ptr<IDataArray> BlockHDF5::createDataArray(const std::string &name,
                                                   const std::string &type,
                                                   nix::DataType data_type,
                                                   const NDSize &shape,
-                                                  const Compression &compression) {
+                                                  const Compression &compression,
+                                                  const StringStorage &strings) {
     string id = util::createId();
     boost::optional<H5Group> g = data_array_group(true);
 
@@ -316,7 +317,30 @@ shared_ptr<IDataArray> BlockHDF5::createDataArray(const std::string &name,
     auto da = make_shared<DataArrayHDF5>(file(), block(), group, id, type, name);
 
     // now create the actual H5::DataSet
-    da->createData(data_type, shape, compression == Compression::Auto ? compr : compression);
+    da->createData(data_type, shape, compression == Compression::Auto ? compr : compression, strings);
+    return da;
+}
+
+shared_ptr<IDataArray> BlockHDF5::createVirtualDataArray(const std::string &name,
+                                                         const std::string &type,
+                                                         nix::DataType data_type,
+                                                         const NDSize &shape,
+                                                         const std::vector<VirtualSource> &sources) {
+    // fail before anything is created
+    const std::vector<VirtualSlab> slabs = DataArrayHDF5::virtualSlabs(sources);
+
+    string id = util::createId();
+    boost::optional<H5Group> g = data_array_group(true);
+
+    H5Group group = g->openGroup(name, true);
+    auto da = make_shared<DataArrayHDF5>(file(), block(), group, id, type, name);
+
+    try {
+        da->createVirtualData(data_type, shape, slabs);
+    } catch (...) {
+        g->removeGroup(name);
+        throw;
+    }
     return da;
 }
 
@@ -11,6 +11,7 @@
 #include "DataArrayHDF5.hpp"
 #include "h5x/H5DataSet.hpp"
 #include "DimensionHDF5.hpp"
+#include "StringDictionaryHDF5.hpp"
 
 using namespace std;
 using namespace nix::base;
@@ -18,9 +19,12 @@ using namespace nix::base;
 namespace nix {
 namespace hdf5 {
 
+// each envelope entry holds min, max and mean
+static const ndsize_t ENVELOPE_WIDTH = 3;
+
 
 DataArrayHDF5::DataArrayHDF5(const std::shared_ptr<base::IFile> &file, const std::shared_ptr<base::IBlock> &block, const H5Group &group)
-        : EntityWithSourcesHDF5(file, block, group) {
+        : EntityWithSourcesHDF5(file, block, group), extent_stamped(0) {
     dimension_group = this->group().openOptGroup("dimensions");
 }
 
@@ -33,7 +37,7 @@ DataArrayHDF5::DataArrayHDF5(const shared_ptr<IFile> &file, const shared_ptr<IBl
 
 DataArrayHDF5::DataArrayHDF5(const shared_ptr<IFile> &file, const shared_ptr<IBlock> &block, const H5Group &group,
                              const string &id, const string &type, const string &name, time_t time)
-        : EntityWithSourcesHDF5(file, block, group, id, type, name, time) {
+        : EntityWithSourcesHDF5(file, block, group, id, type, name, time), extent_stamped(0) {
     dimension_group = this->group().openOptGroup("dimensions");
 }
 
@@ -218,6 +222,7 @@ H5Group DataArrayHDF5::createDimensionGroup(ndsize_t index) {
         g->removeGroup(str_id);
     }
 
+    forceUpdatedAt();
     return g->openGroup(str_id, true);
 }
 
@@ -231,6 +236,7 @@ bool DataArrayHDF5::deleteDimensions() {
             g->removeGroup(dim_id);
         }
     }
+    forceUpdatedAt();
     return true;
 }
 
@@ -244,12 +250,68 @@ DataArrayHDF5::~DataArrayHDF5() {
 }
 
 void DataArrayHDF5::createData(DataType dtype, const NDSize &size, const Compression &compression) {
+    createData(dtype, size, compression, StringStorage());
+}
+
+void DataArrayHDF5::createData(DataType dtype, const NDSize &size, const Compression &compression,
+                               const StringStorage &strings) {
     if (group().hasData("data")) {
         throw ConsistencyError("DataArray's hdf5 data group already exists!");
     }
 
-    h5x::DataType fileType = data_type_to_h5_filetype(dtype);
+    h5x::DataType fileType;
+    switch (strings.mode) {
+        case StringStorage::Mode::Variable:
+            fileType = data_type_to_h5_filetype(dtype);
+            break;
+        case StringStorage::Mode::Fixed:
+            fileType = h5x::DataType::makeStrType(strings.length);
+            break;
+        case StringStorage::Mode::Dictionary: {
+            fileType = data_type_to_h5_filetype(DataType::UInt32);
+            // code 0 is the empty string, the fill value of the codes
+            StringDictionary dict = StringDictionary::create(group(), "dictionary", compression);
+            dict.encode("");
+            dict.flush();
+            break;
+        }
+    }
+
     group().createData("data", fileType, size, compression);
+    dictionary_encoded = strings.mode == StringStorage::Mode::Dictionary;
+}
+
+std::vector<VirtualSlab> DataArrayHDF5::virtualSlabs(const std::vector<base::VirtualSource> &sources) {
+    if (!H5Group::canCreateVirtualData()) {
+        throw H5Exception("DataArray: virtual data needs HDF5 >= 1.10");
+    }
+
+    std::vector<VirtualSlab> slabs;
+    for (const base::VirtualSource &source : sources) {
+        auto array = std::dynamic_pointer_cast<DataArrayHDF5>(source.array);
+        if (!array) {
+            throw std::invalid_argument("DataArray: virtual data can only map DataArrays of the hdf5 backend");
+        }
+        if (!array->group().hasData("data")) {
+            throw ConsistencyError("DataArray with missing h5df DataSet");
+        }
+        if (array->stringStorage().mode == StringStorage::Mode::Dictionary) {
+            throw std::invalid_argument("DataArray: dictionary encoded data cannot be mapped");
+        }
+
+        DataSet ds = array->group().openData("data");
+        slabs.push_back(VirtualSlab {ds, source.count, source.source_offset, source.offset});
+    }
+    return slabs;
+}
+
+void DataArrayHDF5::createVirtualData(DataType dtype, const NDSize &size, const std::vector<VirtualSlab> &slabs) {
+    if (group().hasData("data")) {
+        throw ConsistencyError("DataArray's hdf5 data group already exists!");
+    }
+
+    h5x::DataType fileType = slabs.empty() ? data_type_to_h5_filetype(dtype) : slabs[0].source.dataType();
+    group().createVirtualData("data", fileType, size, slabs);
 }
 
 bool DataArrayHDF5::hasData() const {
@@ -265,10 +327,28 @@ void DataArrayHDF5::write(DataType dtype, const void *data, const NDSize &count,
     DataSet ds = group().openData("data");
     h5x::DataType memType = data_type_to_h5_memtype(dtype);
 
+    // only strings care about the layout
+    StringStorage strings;
+    if (dtype == DataType::String) {
+        strings = stringStorage(ds);
+    } else if (dictionaryEncoded()) {
+        throw std::invalid_argument("DataArray: dictionary encoded data can only be written as strings");
+    }
+
     DataSpace fileSpace, memSpace;
     std::tie(memSpace, fileSpace) = ds.offsetCount2DataSpaces(count, offset);
 
-    if (dtype == DataType::String) {
+    if (dtype == DataType::String && strings.mode == StringStorage::Mode::Fixed) {
+        FixedStringReader reader(count, data, strings.length);
+        ds.write(*reader, ds.dataType(), memSpace, fileSpace);
+    } else if (dtype == DataType::String && strings.mode == StringStorage::Mode::Dictionary) {
+        size_t n = nix::check::fits_in_size_t(count.nelms(), "Cannot allocate storage (exceeds memory)");
+        ScratchBuffer<uint32_t> codes(n);
+        StringDictionary dict(group().openData("dictionary"));
+        dict.encode(static_cast<const std::string *>(data), codes.data(), n);
+        dict.flush();
+        ds.write(codes.data(), data_type_to_h5_memtype(DataType::UInt32), memSpace, fileSpace);
+    } else if (dtype == DataType::String) {
         StringReader reader(count, data);
         ds.write(*reader, memType, memSpace, fileSpace);
     } else {
@@ -276,32 +356,94 @@ void DataArrayHDF5::write(DataType dtype, const void *data, const NDSize &count,
     }
 }
 
+void DataArrayHDF5::writeParallel(DataType dtype, const void *data, const NDSize &count, const NDSize &offset,
+                                  size_t nthreads) {
+    if (dtype == DataType::String || dictionaryEncoded() || !group().hasData("data")) {
+        write(dtype, data, count, offset);
+        return;
+    }
+
+    DataSet ds = group().openData("data");
+    ds.writeParallel(data, data_type_to_h5_memtype(dtype), count, offset, nthreads);
+}
+
 void DataArrayHDF5::read(DataType dtype, void *data, const NDSize &count, const NDSize &offset) const {
     if (!group().hasData("data")) {
         throw ConsistencyError("DataArray with missing h5df DataSet");
     }
 
     DataSet ds = group().openData("data");
-    h5x::DataType memType = data_type_to_h5_memtype(dtype);
     DataSpace fileSpace, memSpace;
     std::tie(memSpace, fileSpace) = ds.offsetCount2DataSpaces(count, offset);
+    read(ds, dtype, data, count, memSpace, fileSpace);
+}
+
+void DataArrayHDF5::read(DataType dtype, void *data, const Selection &selection) const {
+    if (!group().hasData("data")) {
+        throw ConsistencyError("DataArray with missing h5df DataSet");
+    }
 
+    DataSet ds = group().openData("data");
+    DataSpace fileSpace, memSpace;
+    std::tie(memSpace, fileSpace) = ds.selection2DataSpaces(selection);
+    const NDSize count = memSpace.extent();
+    if (count.nelms() > 0) {
+        read(ds, dtype, data, count, memSpace, fileSpace);
+    }
+}
+
+void DataArrayHDF5::read(const DataSet &ds, DataType dtype, void *data, const NDSize &count,
+                         const DataSpace &memSpace, const DataSpace &fileSpace) const {
+    h5x::DataType memType = data_type_to_h5_memtype(dtype);
+
+    StringStorage strings;
     if (dtype == DataType::String) {
+        strings = stringStorage(ds);
+    } else if (dictionaryEncoded()) {
+        throw std::invalid_argument("DataArray: dictionary encoded data can only be read as strings");
+    }
+
+    if (dtype == DataType::String && strings.mode == StringStorage::Mode::Fixed) {
+        FixedStringWriter writer(count, data, strings.length);
+        ds.read(*writer, ds.dataType(), memSpace, fileSpace);
+        writer.finish();
+    } else if (dtype == DataType::String && strings.mode == StringStorage::Mode::Dictionary) {
+        size_t n = nix::check::fits_in_size_t(count.nelms(), "Cannot allocate storage (exceeds memory)");
+        ScratchBuffer<uint32_t> codes(n);
+        ds.read(codes.data(), data_type_to_h5_memtype(DataType::UInt32), memSpace, fileSpace);
+        StringDictionary dict(group().openData("dictionary"));
+        dict.decode(codes.data(), static_cast<std::string *>(data), n);
+    } else if (dtype == DataType::String) {
         StringWriter writer(count, data);
         ds.read(*writer, memType, memSpace, fileSpace);
         writer.finish();
-        ds.vlenReclaim(memType.h5id(), *writer, &memSpace);
+        DataSpace space = memSpace;
+        ds.vlenReclaim(memType.h5id(), *writer, &space);
     } else {
         ds.read(data, memType, memSpace, fileSpace);
     }
 }
 
+void DataArrayHDF5::readParallel(DataType dtype, void *buffer, const NDSize &count, const NDSize &offset,
+                                 size_t nthreads) const {
+    if (dtype == DataType::String || dictionaryEncoded() || !group().hasData("data")) {
+        read(dtype, buffer, count, offset);
+        return;
+    }
+
+    DataSet ds = group().openData("data");
+    ds.readParallel(buffer, data_type_to_h5_memtype(dtype), count, offset, nthreads);
+}
+
 NDSize DataArrayHDF5::dataExtent(void) const {
     if (!group().hasData("data")) {
         return NDSize{};
     }
 
     DataSet ds = group().openData("data");
+    if (file()->fileMode() == FileMode::SwmrRead) {
+        ds.refresh();
+    }
     return ds.size();
 }
 
@@ -311,7 +453,17 @@ void DataArrayHDF5::dataExtent(const NDSize &extent) {
     }
 
     DataSet ds = group().openData("data");
+    if (ds.size() == extent) {
+        return;
+    }
     ds.setExtent(extent);
+
+    // appends resize in quick succession, stamp at most once a second
+    const time_t now = util::getTime();
+    if (now != extent_stamped) {
+        forceUpdatedAt();
+        extent_stamped = now;
+    }
 }
 
 DataType DataArrayHDF5::dataType(void) const {
@@ -321,8 +473,155 @@ DataType DataArrayHDF5::dataType(void) const {
 
     DataSet ds = group().openData("data");
     const h5x::DataType dtype = ds.dataType();
+    if (dtype.class_t() == H5T_INTEGER && dictionaryEncoded()) {
+        return DataType::String;
+    }
     return data_type_from_h5(dtype);
 }
 
+NDSize DataArrayHDF5::dataChunks(void) const {
+    if (!group().hasData("data")) {
+        return NDSize{};
+    }
+
+    DataSet ds = group().openData("data");
+    return ds.chunking();
+}
+
+ndsize_t DataArrayHDF5::dataStorageSize(void) const {
+    if (!group().hasData("data")) {
+        return 0;
+    }
+
+    DataSet ds = group().openData("data");
+    return ds.storageSize();
+}
+
+StorageLayout DataArrayHDF5::dataLayout(void) const {
+    if (!group().hasData("data")) {
+        return StorageLayout();
+    }
+
+    DataSet ds = group().openData("data");
+    return ds.layout();
+}
+
+StringStorage DataArrayHDF5::stringStorage(void) const {
+    if (!group().hasData("data")) {
+        return StringStorage();
+    }
+
+    return stringStorage(group().openData("data"));
+}
+
+StringStorage DataArrayHDF5::stringStorage(const DataSet &ds) const {
+    const h5x::DataType dtype = ds.dataType();
+    if (dtype.isFixedString()) {
+        return StringStorage::fixed(dtype.size());
+    } else if (dtype.class_t() == H5T_INTEGER && dictionaryEncoded()) {
+        return StringStorage::dictionary();
+    }
+    return StringStorage();
+}
+
+bool DataArrayHDF5::dictionaryEncoded() const {
+    if (!dictionary_encoded) {
+        dictionary_encoded = group().hasData("dictionary");
+    }
+    return *dictionary_encoded;
+}
+
+std::vector<std::string> DataArrayHDF5::stringDictionary(void) const {
+    if (!group().hasData("dictionary")) {
+        return std::vector<std::string>();
+    }
+
+    StringDictionary dict(group().openData("dictionary"));
+    return dict.entries();
+}
+
+void DataArrayHDF5::readStringCodes(uint32_t *codes, const NDSize &count, const NDSize &offset) const {
+    if (!group().hasData("dictionary")) {
+        throw std::invalid_argument("DataArray: data are not dictionary encoded");
+    }
+
+    DataSet ds = group().openData("data");
+    ds.read(codes, data_type_to_h5_memtype(DataType::UInt32), count, offset);
+}
+
+//--------------------------------------------------
+// Methods concerning data envelopes
+//--------------------------------------------------
+
+ndsize_t DataArrayHDF5::envelopeFactor() const {
+    if (!group().hasGroup("envelopes")) {
+        return 0;
+    }
+
+    ndsize_t factor = 0;
+    group().openGroup("envelopes", false).getAttr("factor", factor);
+    return factor;
+}
+
+
+void DataArrayHDF5::envelopeFactor(ndsize_t factor) {
+    if (group().hasGroup("envelopes")) {
+        group().removeGroup("envelopes");
+    }
+
+    if (factor > 0) {
+        H5Group g = group().openGroup("envelopes", true);
+        g.setAttr("factor", factor);
+    }
+}
+
+
+ndsize_t DataArrayHDF5::envelopeSize(size_t level) const {
+    const string name = util::numToStr(level);
+    if (!group().hasGroup("envelopes")) {
+        return 0;
+    }
+
+    H5Group g = group().openGroup("envelopes", false);
+    if (!g.hasData(name)) {
+        return 0;
+    }
+
+    return g.openData(name).size()[0];
+}
+
+
+void DataArrayHDF5::envelopeSize(size_t level, ndsize_t size) {
+    const string name = util::numToStr(level);
+    if (!group().hasGroup("envelopes")) {
+        throw ConsistencyError("DataArray has no envelopes");
+    }
+
+    H5Group g = group().openGroup("envelopes", false);
+    if (size == 0) {
+        if (g.hasData(name)) {
+            g.removeData(name);
+        }
+    } else if (g.hasData(name)) {
+        g.openData(name).setExtent({size, ENVELOPE_WIDTH});
+    } else {
+        g.createData(name, H5T_NATIVE_DOUBLE, {size, ENVELOPE_WIDTH});
+    }
+}
+
+
+void DataArrayHDF5::readEnvelope(size_t level, double *data, ndsize_t count, ndsize_t offset) const {
+    H5Group g = group().openGroup("envelopes", false);
+    DataSet ds = g.openData(util::numToStr(level));
+    ds.read(data, H5T_NATIVE_DOUBLE, {count, ENVELOPE_WIDTH}, {offset, ndsize_t(0)});
+}
+
+
+void DataArrayHDF5::writeEnvelope(size_t level, const double *data, ndsize_t count, ndsize_t offset) {
+    H5Group g = group().openGroup("envelopes", false);
+    DataSet ds = g.openData(util::numToStr(level));
+    ds.write(data, H5T_NATIVE_DOUBLE, {count, ENVELOPE_WIDTH}, {offset, ndsize_t(0)});
+}
+
 } // ns nix::hdf5
 } // ns nix
@@ -32,6 +32,12 @@ private:
 
     optGroup dimension_group;
 
+    // when dataExtent(extent) last bumped updated_at
+    time_t extent_stamped;
+
+    // cached, a dictionary is only ever created together with the data
+    mutable boost::optional<bool> dictionary_encoded;
+
 public:
 
     /**
@@ -131,15 +137,38 @@ public:
     virtual void createData(DataType dtype, const NDSize &size, const Compression &compression);
 
 
+    void createData(DataType dtype, const NDSize &size, const Compression &compression,
+                    const StringStorage &strings);
+
+
+    // the boxes of the sources, which must be hdf5 DataArrays, to map into virtual data
+    static std::vector<VirtualSlab> virtualSlabs(const std::vector<base::VirtualSource> &sources);
+
+
+    // create the data as virtual data set of the slabs
+    void createVirtualData(DataType dtype, const NDSize &size, const std::vector<VirtualSlab> &slabs);
+
+
     bool hasData() const;
 
 
     void write(DataType dtype, const void *data, const NDSize &count, const NDSize &offset);
 
 
+    void writeParallel(DataType dtype, const void *data, const NDSize &count, const NDSize &offset,
+                       size_t nthreads);
+
+
     void read(DataType dtype, void *buffer, const NDSize &count, const NDSize &offset) const;
 
 
+    void read(DataType dtype, void *buffer, const Selection &selection) const;
+
+
+    void readParallel(DataType dtype, void *buffer, const NDSize &count, const NDSize &offset,
+                      size_t nthreads) const;
+
+
     NDSize dataExtent(void) const;
 
 
@@ -148,8 +177,56 @@ public:
 
     DataType dataType(void) const;
 
+
+    NDSize dataChunks(void) const;
+
+
+    ndsize_t dataStorageSize(void) const;
+
+
+    StorageLayout dataLayout(void) const;
+
+
+    StringStorage stringStorage(void) const;
+
+
+    std::vector<std::string> stringDictionary(void) const;
+
+
+    void readStringCodes(uint32_t *codes, const NDSize &count, const NDSize &offset) const;
+
+    //--------------------------------------------------
+    // Methods concerning data envelopes.
+    //--------------------------------------------------
+
+    ndsize_t envelopeFactor() const;
+
+
+    void envelopeFactor(ndsize_t factor);
+
+
+    ndsize_t envelopeSize(size_t level) const;
+
+
+    void envelopeSize(size_t level, ndsize_t size);
+
+
+    void readEnvelope(size_t level, double *data, ndsize_t count, ndsize_t offset) const;
+
+
+    void writeEnvelope(size_t level, const double *data, ndsize_t count, ndsize_t offset);
+
 private:
 
+    // the string layout of the already opened data
+    StringStorage stringStorage(const DataSet &ds) const;
+
+    bool dictionaryEncoded() const;
+
+    // read the elements selected by fileSpace into memSpace, count elements in total
+    void read(const DataSet &ds, DataType dtype, void *data, const NDSize &count,
+              const DataSpace &memSpace, const DataSpace &fileSpace) const;
+
     // small helper for handling dimension groups
     H5Group createDimensionGroup(ndsize_t index);
 };
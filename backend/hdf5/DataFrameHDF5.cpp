@@ -16,6 +16,7 @@
 #include "h5x/H5DataSet.hpp"
 
 #include <cstring>
+#include <map>
 #include <numeric>
 #include <algorithm>
 
@@ -48,7 +49,24 @@ void DataFrameHDF5::createData(const std::vector<Column> &cols, const Compressio
 
     size_t s = 0;
     for (size_t i = 0; i < cols.size(); i++) {
-        h5x::DataType ft = data_type_to_h5_filetype(cols[i].dtype);
+        h5x::DataType ft;
+        switch (cols[i].strings.mode) {
+            case StringStorage::Mode::Variable:
+                ft = data_type_to_h5_filetype(cols[i].dtype);
+                break;
+            case StringStorage::Mode::Fixed:
+                ft = h5x::DataType::makeStrType(cols[i].strings.length);
+                break;
+            case StringStorage::Mode::Dictionary: {
+                ft = data_type_to_h5_filetype(DataType::UInt32);
+                // code 0 is the empty string, the fill value of the codes
+                H5Group g = group().openGroup("dictionaries", true);
+                StringDictionary dict = StringDictionary::create(g, cols[i].name, compression);
+                dict.encode("");
+                dict.flush();
+                break;
+            }
+        }
         dtypes[i] = ft;
         offset[i] = s;
         s += ft.size();
@@ -79,15 +97,82 @@ std::vector<Column> DataFrameHDF5::columns() const {
     std::vector<std::string> units(n);
     ds.getAttr("units", units);
 
+    boost::optional<H5Group> dicts;
+    if (group().hasGroup("dictionaries")) {
+        dicts = group().openGroup("dictionaries", false);
+    }
+
     for (unsigned i = 0; i < n; i++) {
-        cols[i].dtype = data_type_from_h5(dt.member_type(i));
+        h5x::DataType mt = dt.member_type(i);
+        cols[i].dtype = data_type_from_h5(mt);
         cols[i].name = dt.member_name(i);
         cols[i].unit = units[i];
+
+        if (mt.isFixedString()) {
+            cols[i].strings = StringStorage::fixed(mt.size());
+        } else if (mt.class_t() == H5T_INTEGER && dicts && dicts->hasData(cols[i].name)) {
+            cols[i].dtype = DataType::String;
+            cols[i].strings = StringStorage::dictionary();
+        }
     }
 
     return cols;
 }
 
+boost::optional<StringDictionary> DataFrameHDF5::dictionary(const std::string &col) const {
+    boost::optional<StringDictionary> dict;
+    if (group().hasGroup("dictionaries")) {
+        H5Group g = group().openGroup("dictionaries", false);
+        if (g.hasData(col)) {
+            dict = StringDictionary(g.openData(col));
+        }
+    }
+    return dict;
+}
+
+void DataFrameHDF5::encodeCells(const h5x::DataType &dtype, std::vector<Cell> &cells) {
+    if (!group().hasGroup("dictionaries")) {
+        return;
+    }
+
+    H5Group g = group().openGroup("dictionaries", false);
+    std::map<std::string, StringDictionary> dicts;
+
+    for (Cell &c : cells) {
+        const std::string name = c.haveName() ? c.name : dtype.member_name(c.col);
+        if (!g.hasData(name)) {
+            continue;
+        }
+        if (c.type() != DataType::String) {
+            throw std::invalid_argument("DataFrame: dictionary encoded column " + name + " only holds strings");
+        }
+
+        auto it = dicts.find(name);
+        if (it == dicts.end()) {
+            it = dicts.emplace(name, StringDictionary(g.openData(name))).first;
+        }
+        c.set(it->second.encode(c.get<const char *>()));
+    }
+
+    for (auto &dict : dicts) {
+        dict.second.flush();
+    }
+}
+
+void DataFrameHDF5::decodeCells(std::vector<Cell> &cells) const {
+    if (!group().hasGroup("dictionaries")) {
+        return;
+    }
+
+    H5Group g = group().openGroup("dictionaries", false);
+    for (Cell &c : cells) {
+        if (c.type() == DataType::UInt32 && g.hasData(c.name)) {
+            StringDictionary dict(g.openData(c.name));
+            c.set(dict.decode(c.get<uint32_t>()));
+        }
+    }
+}
+
 unsigned DataFrameHDF5::colIndex(const std::string &name) const {
     DataSet ds = data();
     h5x::DataType dtype = ds.dataType();
@@ -137,6 +222,11 @@ void DataFrameHDF5::rows(ndsize_t n) {
     ds.setExtent({n});
 }
 
+StorageLayout DataFrameHDF5::dataLayout() const {
+    DataSet ds = data();
+    return ds.layout();
+}
+
 struct Janus {
 
     explicit Janus(const h5x::DataType &dst, const std::vector<Cell> &cells) {
@@ -144,7 +234,15 @@ struct Janus {
         std::vector<h5x::DataType> dtypes(cells.size());
 
         std::transform(cells.cbegin(), cells.cend(), dtypes.begin(),
-                       [](const Cell &c){
+                       [&dst](const Cell &c){
+                           if (c.type() == DataType::String) {
+                               // fixed length strings are stored as they are
+                               const std::string &name = c.haveName() ? c.name : dst.member_name(c.col);
+                               h5x::DataType ft = dst.member_type(name);
+                               if (ft.isFixedString()) {
+                                   return ft;
+                               }
+                           }
                            return data_type_to_h5_memtype(c.type());
                        });
 
@@ -160,7 +258,8 @@ struct Janus {
                                         return size + s;
                                     });
 
-        data = new char[ms];
+        buffer.resize(ms);
+        data = buffer.data();
         dtype = h5x::DataType::makeCompound(ms);
 
         size_t offset = 0;
@@ -173,7 +272,11 @@ struct Janus {
                                           dst.member_name(c.col);
 
             dtype.insert(name, offset, t);
-            copyValue(offset, c);
+            if (t.isFixedString()) {
+                fixed_string_pack(data + offset, c.get<const char *>(), s);
+            } else {
+                copyValue(offset, c);
+            }
             offset += s;
         }
     }
@@ -194,13 +297,18 @@ struct Janus {
                                     });
 
         dtype = h5x::DataType::makeCompound(ms);
-        data = new char[ms];
+        buffer.resize(ms);
+        data = buffer.data();
 
         size_t offset = 0;
         for (size_t i = 0; i < cols.size(); i++) {
             const std::string &name = cols[i];
-            DataType nix_type = data_type_from_h5(dtypes[i]);
-            dtype.insert(name, offset, data_type_to_h5_memtype(nix_type));
+            if (dtypes[i].isFixedString()) {
+                dtype.insert(name, offset, dtypes[i]);
+            } else {
+                DataType nix_type = data_type_from_h5(dtypes[i]);
+                dtype.insert(name, offset, data_type_to_h5_memtype(nix_type));
+            }
             offset += dtypes[i].size();
         }
 
@@ -311,8 +419,13 @@ struct Janus {
     void copyData(Variant &v, unsigned i) {
         size_t offset = dtype.member_offset(i);
         h5x::DataType dt = dtype.member_type(i);
-        DataType nt = data_type_from_h5(dt);
 
+        if (dt.isFixedString()) {
+            v.set(fixed_string_unpack(data + offset, dt.size()));
+            return;
+        }
+
+        DataType nt = data_type_from_h5(dt);
         copyData(v, offset, nt);
     }
 
@@ -338,10 +451,7 @@ struct Janus {
         }
     }
 
-    ~Janus() {
-        delete[] data;
-    }
-
+    ScratchBuffer<char> buffer;
     char *data;
     h5x::DataType dtype;
 };
@@ -350,7 +460,9 @@ struct Janus {
 void DataFrameHDF5::writeCells(ndsize_t row, const std::vector<Cell> &cells) {
     DataSet ds = data();
     h5x::DataType dt = ds.dataType();
-    Janus j{dt, cells};
+    std::vector<Cell> encoded = cells;
+    encodeCells(dt, encoded);
+    Janus j{dt, encoded};
 
     ds.write(j.data, j.dtype, NDSize{1}, NDSize{row});
 }
@@ -367,6 +479,7 @@ void DataFrameHDF5::writeRow(ndsize_t row, const std::vector<Variant> &vals) {
                        return Cell{dt.member_name(k), v};
                    });
 
+    encodeCells(dt, cells);
     Janus j{dt, cells};
 
     ds.write(j.data, j.dtype, NDSize{1}, NDSize{row});
@@ -386,6 +499,7 @@ std::vector<Cell> DataFrameHDF5::readCells(ndsize_t row, const std::vector<std::
 
     std::vector<Cell> res = j.copyData();
     ds.vlenReclaim(j.dtype.h5id(), j.data, &memSpace);
+    decodeCells(res);
 
     return res;
 }
@@ -410,10 +524,14 @@ std::vector<Variant> DataFrameHDF5::readRow(ndsize_t row) const {
 
     ds.read(j.data, j.dtype, count, offset);
 
-    std::vector<Variant> res(cols.size());
-    j.copyData(res);
-
+    std::vector<Cell> cells = j.copyData();
     ds.vlenReclaim(j.dtype.h5id(), j.data, &memSpace);
+    decodeCells(cells);
+
+    std::vector<Variant> res(cells.size());
+    std::transform(cells.cbegin(), cells.cend(), res.begin(), [](const Cell &c) {
+            return static_cast<const Variant &>(c);
+        });
 
     return res;
 }
@@ -425,7 +543,21 @@ void DataFrameHDF5::writeColumn(const std::string &name,
                                 const void *data) {
     DataSet ds = this->data();
     h5x::DataType dts = ds.dataType();
-    h5x::DataType memType = data_type_to_h5_memtype(dtype);
+    h5x::DataType fileType = dts.member_type(name);
+    boost::optional<StringDictionary> dict = dictionary(name);
+
+    if (dict && dtype != DataType::String) {
+        throw std::invalid_argument("DataFrame: dictionary encoded column " + name + " only holds strings");
+    }
+
+    h5x::DataType memType;
+    if (dict) {
+        memType = data_type_to_h5_memtype(DataType::UInt32);
+    } else if (dtype == DataType::String && fileType.isFixedString()) {
+        memType = fileType;
+    } else {
+        memType = data_type_to_h5_memtype(dtype);
+    }
     size_t ms = memType.size();
 
     h5x::DataType ct = h5x::DataType::makeCompound(ms);
@@ -436,7 +568,16 @@ void DataFrameHDF5::writeColumn(const std::string &name,
     DataSpace fileSpace, memSpace;
     std::tie(memSpace, fileSpace) = ds.offsetCount2DataSpaces(ndcount, ndoffset);
 
-    if (dtype == DataType::String) {
+    if (dict) {
+        size_t n = nix::check::fits_in_size_t(count, "Cannot allocate storage (exceeds memory)");
+        ScratchBuffer<uint32_t> codes(n);
+        dict->encode(static_cast<const std::string *>(data), codes.data(), n);
+        dict->flush();
+        ds.write(codes.data(), ct, memSpace, fileSpace);
+    } else if (dtype == DataType::String && fileType.isFixedString()) {
+        FixedStringReader reader(ndcount, data, fileType.size());
+        ds.write(*reader, ct, memSpace, fileSpace);
+    } else if (dtype == DataType::String) {
         StringReader reader(ndcount, data);
         ds.write(*reader, ct, memSpace, fileSpace);
     } else {
@@ -451,7 +592,21 @@ void DataFrameHDF5::readColumn(const std::string &name,
                                void *data) const {
     DataSet ds = this->data();
     h5x::DataType dts = ds.dataType();
-    h5x::DataType memType = data_type_to_h5_memtype(dtype);
+    h5x::DataType fileType = dts.member_type(name);
+    boost::optional<StringDictionary> dict = dictionary(name);
+
+    if (dict && dtype != DataType::String) {
+        throw std::invalid_argument("DataFrame: dictionary encoded column " + name + " only holds strings");
+    }
+
+    h5x::DataType memType;
+    if (dict) {
+        memType = data_type_to_h5_memtype(DataType::UInt32);
+    } else if (dtype == DataType::String && fileType.isFixedString()) {
+        memType = fileType;
+    } else {
+        memType = data_type_to_h5_memtype(dtype);
+    }
 
     size_t ms = memType.size();
     h5x::DataType ct = h5x::DataType::makeCompound(ms);
@@ -462,7 +617,16 @@ void DataFrameHDF5::readColumn(const std::string &name,
     DataSpace fileSpace, memSpace;
     std::tie(memSpace, fileSpace) = ds.offsetCount2DataSpaces(ndcount, ndoffset);
 
-    if (dtype == DataType::String) {
+    if (dict) {
+        size_t n = nix::check::fits_in_size_t(count, "Cannot allocate storage (exceeds memory)");
+        ScratchBuffer<uint32_t> codes(n);
+        ds.read(codes.data(), ct, memSpace, fileSpace);
+        dict->decode(codes.data(), static_cast<std::string *>(data), n);
+    } else if (dtype == DataType::String && fileType.isFixedString()) {
+        FixedStringWriter writer(ndcount, data, fileType.size());
+        ds.read(*writer, ct, memSpace, fileSpace);
+        writer.finish();
+    } else if (dtype == DataType::String) {
         StringWriter writer(ndcount, data);
         ds.read(*writer, ct, memSpace, fileSpace);
         writer.finish();
@@ -15,6 +15,9 @@
 #include <nix/NDSize.hpp>
 #include <nix/base/IDataFrame.hpp>
 #include "EntityWithSourcesHDF5.hpp"
+#include "StringDictionaryHDF5.hpp"
+
+#include <boost/optional.hpp>
 
 namespace nix {
 namespace hdf5 {
@@ -54,6 +57,8 @@ public:
     ndsize_t rows() const override;
     void rows(ndsize_t n) override;
 
+    StorageLayout dataLayout() const override;
+
     std::vector<Variant> readRow(ndsize_t row) const override;
     void writeRow(ndsize_t row, const std::vector<Variant> &v) override;
 
@@ -82,6 +87,12 @@ private:
         return group().openData("data");
     }
 
+    boost::optional<StringDictionary> dictionary(const std::string &col) const;
+
+    void encodeCells(const h5x::DataType &dtype, std::vector<Cell> &cells);
+
+    void decodeCells(std::vector<Cell> &cells) const;
+
 };
 
 
@@ -247,6 +247,14 @@ vector<string> SetDimensionHDF5::labels() const {
 }
 
 
+ndsize_t SetDimensionHDF5::labelCount() const {
+    if (!group.hasData("labels")) {
+        return 0;
+    }
+    return group.openData("labels").size().nelms();
+}
+
+
 void SetDimensionHDF5::labels(const vector<string> &labels) {
    group.setData("labels", labels);
 }
@@ -378,6 +386,18 @@ vector<double> RangeDimensionHDF5::ticks() const {
 }
 
 
+ndsize_t RangeDimensionHDF5::tickCount() const {
+    H5Group g = redirectGroup();
+    if (g.hasData("ticks")) {
+        return g.openData("ticks").size().nelms();
+    } else if (g.hasData("data")) {
+        return g.openData("data").size().nelms();
+    } else {
+        throw MissingAttr("ticks");
+    }
+}
+
+
 void RangeDimensionHDF5::ticks(const vector<double> &ticks) {
     H5Group g = redirectGroup();
     if (!alias()) {
@@ -124,6 +124,9 @@ public:
     std::vector<std::string> labels() const;
 
 
+    ndsize_t labelCount() const;
+
+
     void labels(const std::vector<std::string> &labels);
 
 
@@ -175,6 +178,9 @@ public:
     std::vector<double> ticks() const;
 
 
+    ndsize_t tickCount() const;
+
+
     void ticks(const std::vector<double> &ticks);
 
 
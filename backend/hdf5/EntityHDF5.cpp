@@ -65,7 +65,26 @@ void EntityHDF5::setUpdatedAt() {
 }
 
 
+// true once SWMR writing started, where attributes must not change
+static bool swmr_writing(const std::shared_ptr<IFile> &file, const H5Group &group) {
+#if H5_VERSION_GE(1, 10, 0)
+    if (file->fileMode() != FileMode::SwmrWrite) {
+        return false;
+    }
+    H5Object fid = H5Iget_file_id(group.h5id());
+    unsigned intent = 0;
+    HErr res = H5Fget_intent(fid.h5id(), &intent);
+    return !res.isError() && (intent & H5F_ACC_SWMR_WRITE) != 0;
+#else
+    return false;
+#endif
+}
+
+
 void EntityHDF5::forceUpdatedAt() {
+    if (swmr_writing(file(), group())) {
+        return;
+    }
     time_t t = util::getTime();
     group().setAttr("updated_at", util::timeToStr(t));
 }
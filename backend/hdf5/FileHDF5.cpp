@@ -14,6 +14,7 @@
 #include "h5x/H5Exception.hpp"
 
 
+#include <atomic>
 #include <fstream>
 #include <vector>
 #include <ctime>
@@ -36,16 +37,219 @@ static unsigned int map_file_mode(FileMode mode) {
         case FileMode::Overwrite:
             return H5F_ACC_TRUNC;
 
+        case FileMode::SwmrWrite:
+            // SWMR writing is started after the layout is created
+            return H5F_ACC_RDWR;
+
+        case FileMode::SwmrRead:
+#if H5_VERSION_GE(1, 10, 0)
+            return H5F_ACC_RDONLY | H5F_ACC_SWMR_READ;
+#else
+            return H5F_ACC_RDONLY;
+#endif
+
         default:
             return H5F_ACC_DEFAULT;
     }
 }
 
 
-    FileHDF5::FileHDF5(const string &name, FileMode mode, Compression compression) {
-    if (!fileExists(name)) {
+namespace {
+
+/*
+ * File image callbacks that let the core driver use a caller-owned,
+ * read-only buffer in place instead of copying it: every "allocation"
+ * of the image size returns the buffer, copies into it are no-ops and
+ * it is never freed. The udata lives as long as any property list or
+ * open file refers to it.
+ */
+struct BufferImage {
+    void   *data;
+    size_t  size;
+    int     refs;
+};
+
+
+herr_t buffer_image_udata_free(void *udata);
+
+
+void *buffer_image_malloc(size_t size, H5FD_file_image_op_t op, void *udata) {
+    BufferImage *image = static_cast<BufferImage *>(udata);
+    if (size != image->size) {
+        return nullptr;
+    }
+    switch (op) {
+        case H5FD_FILE_IMAGE_OP_PROPERTY_LIST_SET:
+        case H5FD_FILE_IMAGE_OP_PROPERTY_LIST_COPY:
+        case H5FD_FILE_IMAGE_OP_PROPERTY_LIST_GET:
+            return image->data;
+        case H5FD_FILE_IMAGE_OP_FILE_OPEN:
+            // the driver keeps the callbacks without copying the udata
+            image->refs++;
+            return image->data;
+        default:
+            return nullptr;
+    }
+}
+
+
+void *buffer_image_memcpy(void *dest, const void *src, size_t size, H5FD_file_image_op_t, void *udata) {
+    BufferImage *image = static_cast<BufferImage *>(udata);
+    if (dest != image->data || src != image->data || size != image->size) {
+        return nullptr;
+    }
+    return dest;
+}
+
+
+void *buffer_image_realloc(void *, size_t, H5FD_file_image_op_t, void *) {
+    // the file is read-only, the image never grows
+    return nullptr;
+}
+
+
+herr_t buffer_image_free(void *ptr, H5FD_file_image_op_t op, void *udata) {
+    BufferImage *image = static_cast<BufferImage *>(udata);
+    if (ptr != image->data) {
+        return -1;
+    }
+    if (op == H5FD_FILE_IMAGE_OP_FILE_CLOSE) {
+        buffer_image_udata_free(udata);
+    }
+    return 0;
+}
+
+
+void *buffer_image_udata_copy(void *udata) {
+    static_cast<BufferImage *>(udata)->refs++;
+    return udata;
+}
+
+
+herr_t buffer_image_udata_free(void *udata) {
+    BufferImage *image = static_cast<BufferImage *>(udata);
+    if (--image->refs == 0) {
+        delete image;
+    }
+    return 0;
+}
+
+
+H5Object core_fapl(bool backing_store) {
+    H5Object fapl = H5Pcreate(H5P_FILE_ACCESS);
+    fapl.check("Could not create file access plist");
+    // grow in-memory files in steps of 1 MiB
+    HErr res = H5Pset_fapl_core(fapl.h5id(), 1 << 20, backing_store ? 1 : 0);
+    res.check("Unable to create file (H5Pset_fapl_core failed.)");
+    return fapl;
+}
+
+
+std::string memory_file_name() {
+    static std::atomic<unsigned long> counter {0};
+    return "nix-memory-" + std::to_string(counter++) + ".h5";
+}
+
+} // namespace
+
+
+FileHDF5::FileHDF5(const string &name, FileMode mode, Compression compression) {
+#if !H5_VERSION_GE(1, 10, 0)
+    if (mode == FileMode::SwmrWrite || mode == FileMode::SwmrRead) {
+        throw std::runtime_error("SWMR needs HDF5 >= 1.10");
+    }
+#endif
+    if (!fileExists(name) && mode != FileMode::SwmrWrite) {
         mode = FileMode::Overwrite;
     }
+    unsigned int h5mode =  map_file_mode(mode);
+
+    // SWMR needs the file format of HDF5 1.10, which older versions
+    // of the library cannot read; only use it when asked for
+    H5Object fapl = H5Pcreate(H5P_FILE_ACCESS);
+    fapl.check("Could not create file access plist");
+    if (mode == FileMode::SwmrWrite) {
+        HErr res = H5Pset_libver_bounds(fapl.h5id(), H5F_LIBVER_LATEST, H5F_LIBVER_LATEST);
+        res.check("Unable to create file (H5Pset_libver_bounds failed.)");
+    }
+
+    bool is_create = !fileExists(name) || h5mode == H5F_ACC_TRUNC;
+    open(name, mode, compression, fapl, is_create);
+}
+
+
+FileHDF5::FileHDF5(const string &name, FileMode mode, Compression compression, const H5Object &fapl) {
+    open(name, mode, compression, fapl, mode == FileMode::Overwrite);
+}
+
+
+shared_ptr<FileHDF5> FileHDF5::openImage(const void *data, size_t size, FileMode mode, Compression compression) {
+    if (mode != FileMode::ReadOnly && mode != FileMode::ReadWrite) {
+        throw std::invalid_argument("FileHDF5::openImage: file images can only be opened ReadOnly or ReadWrite");
+    }
+
+    H5Object fapl = core_fapl(false);
+    HErr res;
+
+    if (mode == FileMode::ReadOnly) {
+        H5FD_file_image_callbacks_t callbacks = {
+            buffer_image_malloc, buffer_image_memcpy, buffer_image_realloc, buffer_image_free,
+            buffer_image_udata_copy, buffer_image_udata_free, nullptr
+        };
+        // the buffer is only read, see buffer_image_realloc
+        BufferImage *image = new BufferImage {const_cast<void *>(data), size, 1};
+        callbacks.udata = image;
+        res = H5Pset_file_image_callbacks(fapl.h5id(), &callbacks);
+        // the property list holds its own reference now
+        buffer_image_udata_free(image);
+        res.check("Unable to open file image (H5Pset_file_image_callbacks failed.)");
+    }
+
+    // copies the buffer unless the callbacks above are set
+    res = H5Pset_file_image(fapl.h5id(), const_cast<void *>(data), size);
+    res.check("Unable to open file image (H5Pset_file_image failed.)");
+
+    return make_shared<FileHDF5>(memory_file_name(), mode, compression, fapl);
+}
+
+
+shared_ptr<FileHDF5> FileHDF5::createInMemory(const string &backing_store, Compression compression) {
+    H5Object fapl = core_fapl(!backing_store.empty());
+    string name = backing_store.empty() ? memory_file_name() : backing_store;
+    return make_shared<FileHDF5>(name, FileMode::Overwrite, compression, fapl);
+}
+
+
+void FileHDF5::saveImage(const string &path) const {
+    vector<char> buffer = image();
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    out.close();
+    if (!out) {
+        throw std::runtime_error("FileHDF5::saveImage: Could not write " + path);
+    }
+}
+
+
+vector<char> FileHDF5::image() const {
+    HErr res = H5Fflush(hid, H5F_SCOPE_GLOBAL);
+    res.check("FileHDF5::image: Could not flush the file");
+
+    ssize_t size = H5Fget_file_image(hid, nullptr, 0);
+    if (size < 0) {
+        throw H5Exception("FileHDF5::image: Could not get the size of the file image");
+    }
+
+    vector<char> buffer(static_cast<size_t>(size));
+    if (size > 0 && H5Fget_file_image(hid, buffer.data(), buffer.size()) < 0) {
+        throw H5Exception("FileHDF5::image: Could not get the file image");
+    }
+    return buffer;
+}
+
+
+void FileHDF5::open(const string &name, FileMode mode, Compression compression,
+                    const H5Object &fapl, bool is_create) {
     this->mode = mode;
     this->compr = compression;
     //we want hdf5 to keep track of the order in which links were created so that
@@ -54,14 +258,11 @@ static unsigned int map_file_mode(FileMode mode) {
     fcpl.check("Could not create file creation plist");
     HErr res = H5Pset_link_creation_order(fcpl.h5id(), H5P_CRT_ORDER_TRACKED|H5P_CRT_ORDER_INDEXED);
     res.check("Unable to create file (H5Pset_link_creation_order failed.)");
-    unsigned int h5mode =  map_file_mode(mode);
-
-    bool is_create = !fileExists(name) || h5mode == H5F_ACC_TRUNC;
 
     if (is_create) {
-        hid = H5Fcreate(name.c_str(), h5mode, fcpl.h5id(), H5P_DEFAULT);
+        hid = H5Fcreate(name.c_str(), H5F_ACC_TRUNC, fcpl.h5id(), fapl.h5id());
     } else {
-        hid = H5Fopen(name.c_str(), h5mode, H5P_DEFAULT);
+        hid = H5Fopen(name.c_str(), map_file_mode(mode), fapl.h5id());
     }
 
     if (!H5Iis_valid(hid)) {
@@ -171,6 +372,7 @@ shared_ptr<base::ISection> FileHDF5::createSection(const string &name, const  st
     string id = util::createId();
 
     H5Group group = metadata.openGroup(name, true);
+    metadata_snapshot.reset();
     return make_shared<SectionHDF5>(file(), group, id, type, name);
 }
 
@@ -188,12 +390,23 @@ bool FileHDF5::deleteSection(const std::string &name_or_id) {
         }
         // if hasSection is true then section_group always exists
         deleted = metadata.removeAllLinks(section.name());
+        metadata_snapshot.reset();
     }
 
     return deleted;
 }
 
 
+shared_ptr<const MetadataSnapshot> FileHDF5::metadataSnapshot() const {
+    return metadata_snapshot;
+}
+
+
+void FileHDF5::metadataSnapshot(const shared_ptr<const MetadataSnapshot> &snapshot) {
+    metadata_snapshot = snapshot;
+}
+
+
 ndsize_t FileHDF5::sectionCount() const {
     return metadata.objectCount();
 }
@@ -245,6 +458,21 @@ void FileHDF5::forceCreatedAt(time_t t) {
 }
 
 
+time_t FileHDF5::validatedAt() const {
+    if (!root.hasAttr("validated_at")) {
+        return 0;
+    }
+    string t;
+    root.getAttr("validated_at", t);
+    return util::strToTime(t);
+}
+
+
+void FileHDF5::forceValidatedAt(time_t t) {
+    root.setAttr("validated_at", util::timeToStr(t));
+}
+
+
 vector<int> FileHDF5::version() const {
     vector<int> version;
     root.getAttr("version",version);
@@ -325,6 +553,42 @@ FileMode FileHDF5::fileMode() const {
 }
 
 
+void FileHDF5::startSwmrWrite() {
+    if (mode != FileMode::SwmrWrite) {
+        throw std::runtime_error("FileHDF5::startSwmrWrite: the file was not opened with FileMode::SwmrWrite");
+    }
+
+#if H5_VERSION_GE(1, 10, 0)
+    // H5Fstart_swmr_write re-opens all open objects, which fails for
+    // IDs shared by several handles; close the groups of the file itself
+    // for the call and open them again afterwards
+    metadata.close();
+    data.close();
+    root.close();
+
+    const unsigned types = H5F_OBJ_GROUP|H5F_OBJ_DATASET|H5F_OBJ_DATATYPE|H5F_OBJ_ATTR;
+    const ssize_t obj_count = H5Fget_obj_count(hid, types);
+    HErr res;
+    if (obj_count == 0) {
+        res = H5Fstart_swmr_write(hid);
+    }
+
+    openRoot();
+    metadata = root.openGroup("metadata", false);
+    data = root.openGroup("data", false);
+
+    if (obj_count < 0) {
+        throw H5Exception("FileHDF5::startSwmrWrite: Could not get object count");
+    } else if (obj_count > 0) {
+        throw std::runtime_error("FileHDF5::startSwmrWrite: entities of the file are still in use");
+    }
+    res.check("FileHDF5::startSwmrWrite: Could not start SWMR writing (file not created with FileMode::SwmrWrite?)");
+#else
+    throw std::runtime_error("SWMR needs HDF5 >= 1.10");
+#endif
+}
+
+
 Compression FileHDF5::compression() const {
      return compr;
 }
@@ -351,7 +615,7 @@ bool FileHDF5::checkHeader(FileMode mode) const {
         } else {
             FormatVersion ver = FormatVersion(vv);
 
-            if (mode == FileMode::ReadWrite) {
+            if (mode == FileMode::ReadWrite || mode == FileMode::SwmrWrite) {
                 check = my_version.canWrite(ver);
             } else {
                 check = my_version.canRead(ver);
@@ -16,6 +16,7 @@
 
 #include <string>
 #include <memory>
+#include <vector>
 
 #define HDF5_FF_VERSION nix::FormatVersion({1, 1, 1})
 
@@ -33,6 +34,7 @@ private:
     Compression compr;
     H5Group root, metadata, data;
     FileMode mode;
+    std::shared_ptr<const MetadataSnapshot> metadata_snapshot;
 
 public:
 
@@ -41,10 +43,40 @@ public:
      *
      * @param name    The name of the file to open.
      * @param prefix  The prefix used for IDs.
-     * @param mode    File open mode ReadOnly, ReadWrite or Overwrite.
+     * @param mode    File open mode ReadOnly, ReadWrite, Overwrite, SwmrWrite or SwmrRead.
      */
     FileHDF5(const std::string &name, const FileMode mode = FileMode::ReadWrite, const Compression compression = Compression::Auto);
 
+    /**
+     * Constructor that opens the file with the given file access plist,
+     * e.g. one of the core driver. The file is created if the mode is
+     * Overwrite and opened otherwise.
+     */
+    FileHDF5(const std::string &name, FileMode mode, Compression compression, const H5Object &fapl);
+
+    /**
+     * Open a file from an image in memory. A ReadOnly file uses the
+     * buffer in place, which then must outlive the file, a ReadWrite
+     * file works on a copy.
+     */
+    static std::shared_ptr<FileHDF5> openImage(const void *data, size_t size, FileMode mode, Compression compression);
+
+    /**
+     * Create a file in memory, which is written to backing_store when
+     * flushed or closed unless that is empty.
+     */
+    static std::shared_ptr<FileHDF5> createInMemory(const std::string &backing_store, Compression compression);
+
+    /**
+     * The current image of the file, as it would be on disk.
+     */
+    std::vector<char> image() const;
+
+    /**
+     * Write the current image of the file to path at once.
+     */
+    void saveImage(const std::string &path) const;
+
     //--------------------------------------------------
     // Methods concerning blocks
     //--------------------------------------------------
@@ -90,6 +122,12 @@ public:
 
     bool deleteSection(const std::string &name_or_id);
 
+
+    std::shared_ptr<const MetadataSnapshot> metadataSnapshot() const;
+
+
+    void metadataSnapshot(const std::shared_ptr<const MetadataSnapshot> &snapshot);
+
     //--------------------------------------------------
     // Methods for file attribute access.
     //--------------------------------------------------
@@ -122,6 +160,12 @@ public:
     void forceCreatedAt(time_t t);
 
 
+    time_t validatedAt() const;
+
+
+    void forceValidatedAt(time_t t);
+
+
     void close();
 
 
@@ -131,6 +175,9 @@ public:
     FileMode fileMode() const;
 
 
+    void startSwmrWrite();
+
+
     Compression compression() const;
 
 
@@ -146,6 +193,9 @@ private:
 
     std::shared_ptr<base::IFile> file() const;
 
+    void open(const std::string &name, FileMode mode, Compression compression,
+              const H5Object &fapl, bool is_create);
+
     // check for existence
     bool fileExists(const std::string &name) const;
 
@@ -10,7 +10,9 @@
 
 #include <nix/util/util.hpp>
 
+#include <cstring>
 #include <iostream>
+#include <memory>
 
 using namespace std;
 
@@ -279,9 +281,8 @@ void do_read_value(const DataSet &h5ds, size_t size, std::vector<Variant> &value
     h5x::DataType memType = h5_type_for_value<T>(true);
 
     typedef FileValue<T> file_value_t;
-    std::vector<file_value_t> fileValues;
+    ScratchBuffer<file_value_t> fileValues(size);
 
-    fileValues.resize(size);
     values.resize(size);
 
     h5ds.read(fileValues.data(), memType, H5S_ALL, H5S_ALL);
@@ -301,9 +302,7 @@ template<typename T>
 void do_write_value(DataSet &h5ds, const std::vector<Variant> &values)
 {
     typedef FileValue<T> file_value_t;
-    std::vector<file_value_t> fileValues;
-
-    fileValues.resize(values.size());
+    ScratchBuffer<file_value_t> fileValues(values.size());
 
     std::transform(values.begin(), values.end(), fileValues.begin(), [](const Variant &val) {
         file_value_t fileVal(val.get<T>());
@@ -314,6 +313,33 @@ void do_write_value(DataSet &h5ds, const std::vector<Variant> &values)
     h5ds.write(fileValues.data(), memType, H5S_ALL, H5S_ALL);
 }
 
+void do_read_fixed_strings(const DataSet &h5ds, size_t size, std::vector<Variant> &values)
+{
+    h5x::DataType fileType = h5ds.dataType();
+    const size_t width = fileType.size();
+    ScratchBuffer<char> buffer(size * width);
+    h5ds.read(buffer.data(), fileType, H5S_ALL, H5S_ALL);
+
+    values.resize(size);
+    for (size_t i = 0; i < size; i++) {
+        values[i].set(fixed_string_unpack(buffer.data() + i * width, width));
+    }
+}
+
+
+void do_write_fixed_strings(DataSet &h5ds, const std::vector<Variant> &values)
+{
+    h5x::DataType fileType = h5ds.dataType();
+    const size_t width = fileType.size();
+    ScratchBuffer<char> buffer(values.size() * width);
+
+    for (size_t i = 0; i < values.size(); i++) {
+        fixed_string_pack(buffer.data() + i * width, values[i].get<const char *>(), width);
+    }
+
+    h5ds.write(buffer.data(), fileType, H5S_ALL, H5S_ALL);
+}
+
 // value public API
 
 void PropertyHDF5::deleteValues() {
@@ -335,9 +361,25 @@ void PropertyHDF5::values(const std::vector<Variant> &values)
     }
     DataSet dset = dataset();
     DataType dt = values[0].type();
-    if (dt != data_type_from_h5(dset.dataType())) {
+    h5x::DataType fileType = dset.dataType();
+    if (dt != data_type_from_h5(fileType)) {
         throw std::invalid_argument("Inconsistent DataTypes!");
     }
+
+    if (fileType.isFixedString()) {
+        // check all lengths before changing the extent
+        const size_t width = fileType.size();
+        for (const Variant &v : values) {
+            if (std::strlen(v.get<const char *>()) > width) {
+                throw std::invalid_argument("Property value exceeds fixed length of " +
+                                            std::to_string(width) + " bytes");
+            }
+        }
+        dset.setExtent(NDSize{values.size()});
+        do_write_fixed_strings(dset, values);
+        return;
+    }
+
     dset.setExtent(NDSize{values.size()});
 
      switch(values[0].type()) {
@@ -375,7 +417,13 @@ std::vector<Variant> PropertyHDF5::values(void) const
         case DataType::UInt32: do_read_value<uint32_t>(dset, nvalues, values); break;
         case DataType::Int64:  do_read_value<int64_t>(dset, nvalues, values);  break;
         case DataType::UInt64: do_read_value<uint64_t>(dset, nvalues, values); break;
-        case DataType::String: do_read_value<char *>(dset, nvalues, values);   break;
+        case DataType::String:
+            if (dset.dataType().isFixedString()) {
+                do_read_fixed_strings(dset, nvalues, values);
+            } else {
+                do_read_value<char *>(dset, nvalues, values);
+            }
+            break;
         case DataType::Double: do_read_value<double>(dset, nvalues, values);   break;
 #ifndef CHECK_SUPOORTED_VALUES
     default: assert(DATATYPE_SUPPORT_NOT_IMPLEMENTED);
@@ -391,6 +439,64 @@ void PropertyHDF5::values(const nix::none_t t) {
 }
 
 
+void PropertyHDF5::readValues(DataType dtype, void *data, ndsize_t count, ndsize_t offset) const
+{
+    DataSet dset = dataset();
+    h5x::DataType fileType = dset.dataType();
+    const NDSize ndcount {count};
+
+    DataSpace fileSpace, memSpace;
+    std::tie(memSpace, fileSpace) = dset.offsetCount2DataSpaces(ndcount, NDSize{offset});
+
+    if (dtype == DataType::String && fileType.isFixedString()) {
+        FixedStringWriter writer(ndcount, data, fileType.size());
+        dset.read(*writer, fileType, memSpace, fileSpace);
+        writer.finish();
+    } else if (dtype == DataType::String) {
+        h5x::DataType memType = data_type_to_h5_memtype(dtype);
+        StringWriter writer(ndcount, data);
+        dset.read(*writer, memType, memSpace, fileSpace);
+        writer.finish();
+        dset.vlenReclaim(memType, *writer, &memSpace);
+    } else {
+        dset.read(data, data_type_to_h5_memtype(dtype), memSpace, fileSpace);
+    }
+}
+
+
+void PropertyHDF5::writeValues(DataType dtype, const void *data, ndsize_t count, ndsize_t offset)
+{
+    DataSet dset = dataset();
+    h5x::DataType fileType = dset.dataType();
+    if (dtype != data_type_from_h5(fileType)) {
+        throw std::invalid_argument("Inconsistent DataTypes!");
+    }
+
+    const NDSize ndcount {count};
+    std::unique_ptr<FixedStringReader> fixed;
+    if (fileType.isFixedString()) {
+        // check all lengths before changing the extent
+        fixed.reset(new FixedStringReader(ndcount, data, fileType.size()));
+    }
+
+    if (offset + count > valueCount()) {
+        dset.setExtent(NDSize{offset + count});
+    }
+
+    DataSpace fileSpace, memSpace;
+    std::tie(memSpace, fileSpace) = dset.offsetCount2DataSpaces(ndcount, NDSize{offset});
+
+    if (fixed) {
+        dset.write(**fixed, fileType, memSpace, fileSpace);
+    } else if (dtype == DataType::String) {
+        StringReader reader(ndcount, data);
+        dset.write(*reader, data_type_to_h5_memtype(dtype), memSpace, fileSpace);
+    } else {
+        dset.write(data, data_type_to_h5_memtype(dtype), memSpace, fileSpace);
+    }
+}
+
+
 
 } // ns nix::hdf5
 } // ns nix
@@ -0,0 +1,435 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "RepackHDF5.hpp"
+#include "h5x/H5DataSet.hpp"
+#include "h5x/H5Exception.hpp"
+
+#include <nix/Exception.hpp>
+
+#include <algorithm>
+#include <future>
+#include <map>
+#include <thread>
+#include <vector>
+
+namespace nix {
+namespace hdf5 {
+
+// upper bound of the chunk data that is held in memory at once
+static const size_t batch_bytes = 32 * 1024 * 1024;
+
+
+static herr_t collect_link(hid_t, const char *name, const H5L_info_t *, void *names) {
+    static_cast<std::vector<std::string> *>(names)->push_back(name);
+    return 0;
+}
+
+static herr_t collect_attr(hid_t, const char *name, const H5A_info_t *, void *names) {
+    static_cast<std::vector<std::string> *>(names)->push_back(name);
+    return 0;
+}
+
+// names of the links of a group, in creation order if it is tracked
+static std::vector<std::string> link_names(hid_t group) {
+    std::vector<std::string> names;
+    hsize_t idx = 0;
+    if (H5Literate(group, H5_INDEX_CRT_ORDER, H5_ITER_INC, &idx, collect_link, &names) < 0) {
+        names.clear();
+        idx = 0;
+        HErr res = H5Literate(group, H5_INDEX_NAME, H5_ITER_INC, &idx, collect_link, &names);
+        res.check("repack: Could not iterate over group");
+    }
+    return names;
+}
+
+static std::vector<std::string> attr_names(hid_t obj) {
+    std::vector<std::string> names;
+    hsize_t idx = 0;
+    if (H5Aiterate2(obj, H5_INDEX_CRT_ORDER, H5_ITER_INC, &idx, collect_attr, &names) < 0) {
+        names.clear();
+        idx = 0;
+        HErr res = H5Aiterate2(obj, H5_INDEX_NAME, H5_ITER_INC, &idx, collect_attr, &names);
+        res.check("repack: Could not iterate over attributes");
+    }
+    return names;
+}
+
+static bool has_vlen(hid_t type) {
+    switch (H5Tget_class(type)) {
+        case H5T_VLEN:
+            return true;
+        case H5T_STRING:
+            return H5Tis_variable_str(type) > 0;
+        case H5T_ARRAY: {
+            H5Object base = H5Tget_super(type);
+            return has_vlen(base.h5id());
+        }
+        case H5T_COMPOUND: {
+            const int n = H5Tget_nmembers(type);
+            for (int i = 0; i < n; i++) {
+                H5Object member = H5Tget_member_type(type, static_cast<unsigned>(i));
+                if (has_vlen(member.h5id())) {
+                    return true;
+                }
+            }
+            return false;
+        }
+        default:
+            return false;
+    }
+}
+
+static haddr_t object_address(hid_t loc, const std::string &name) {
+    H5Object obj = H5Oopen(loc, name.c_str(), H5P_DEFAULT);
+    obj.check("repack: Could not open object " + name);
+    H5O_info_t info;
+    HErr res = H5Oget_info(obj.h5id(), &info);
+    res.check("repack: Could not obtain object info");
+    return info.addr;
+}
+
+
+
+class Repacker {
+
+public:
+
+    Repacker(hid_t src, hid_t dst, const RepackRule &rule, size_t nthreads)
+        : src_file(src), dst_file(dst), rule(rule), nthreads(nthreads) { }
+
+    RepackStats run() {
+        findData();
+        copied[object_address(src_file, "/")] = "/";
+        copyAttributes(src_file, dst_file);
+        copyGroup(src_file, dst_file, "");
+        return stats;
+    }
+
+private:
+
+    // the data sets of all DataArrays and DataFrames, with the entity names
+    void findData() {
+        if (H5Lexists(src_file, "data", H5P_DEFAULT) <= 0) {
+            return;
+        }
+        H5Object data_group = H5Gopen2(src_file, "data", H5P_DEFAULT);
+        data_group.check("repack: Could not open data group");
+
+        for (const auto &block_name : link_names(data_group.h5id())) {
+            H5Object block = H5Gopen2(data_group.h5id(), block_name.c_str(), H5P_DEFAULT);
+            if (!block.isValid()) {
+                continue;
+            }
+
+            for (const char *kind : {"data_arrays", "data_frames"}) {
+                if (H5Lexists(block.h5id(), kind, H5P_DEFAULT) <= 0) {
+                    continue;
+                }
+                H5Object entities = H5Gopen2(block.h5id(), kind, H5P_DEFAULT);
+                entities.check("repack: Could not open group");
+
+                for (const auto &name : link_names(entities.h5id())) {
+                    H5Object entity = H5Gopen2(entities.h5id(), name.c_str(), H5P_DEFAULT);
+                    if (entity.isValid() && H5Lexists(entity.h5id(), "data", H5P_DEFAULT) > 0) {
+                        data[object_address(entity.h5id(), "data")] = name;
+                    }
+                }
+            }
+        }
+    }
+
+    void copyAttributes(hid_t src, hid_t dst) {
+        for (const auto &name : attr_names(src)) {
+            H5Object attr = H5Aopen(src, name.c_str(), H5P_DEFAULT);
+            attr.check("repack: Could not open attribute " + name);
+
+            H5Object ftype = H5Aget_type(attr.h5id());
+            H5Object mtype = H5Tget_native_type(ftype.h5id(), H5T_DIR_DEFAULT);
+            H5Object space = H5Aget_space(attr.h5id());
+            mtype.check("repack: Could not obtain type of attribute " + name);
+
+            const hssize_t npoints = H5Sget_simple_extent_npoints(space.h5id());
+            std::vector<char> buffer(static_cast<size_t>(std::max<hssize_t>(npoints, 1)) * H5Tget_size(mtype.h5id()));
+
+            HErr res = H5Aread(attr.h5id(), mtype.h5id(), buffer.data());
+            res.check("repack: Could not read attribute " + name);
+
+            H5Object acpl = H5Aget_create_plist(attr.h5id());
+            H5Object copy = H5Acreate2(dst, name.c_str(), ftype.h5id(), space.h5id(), acpl.h5id(), H5P_DEFAULT);
+            copy.check("repack: Could not create attribute " + name);
+
+            res = H5Awrite(copy.h5id(), mtype.h5id(), buffer.data());
+            if (has_vlen(mtype.h5id())) {
+                H5Dvlen_reclaim(mtype.h5id(), space.h5id(), H5P_DEFAULT, buffer.data());
+            }
+            res.check("repack: Could not write attribute " + name);
+
+            stats.attributes++;
+        }
+    }
+
+    void copyGroup(hid_t src, hid_t dst, const std::string &path) {
+        for (const auto &name : link_names(src)) {
+            copyLink(src, dst, path + "/" + name, name);
+        }
+    }
+
+    void copyLink(hid_t src, hid_t dst, const std::string &path, const std::string &name) {
+        H5L_info_t info;
+        HErr res = H5Lget_info(src, name.c_str(), &info, H5P_DEFAULT);
+        res.check("repack: Could not obtain link info of " + path);
+
+        H5Object lcpl = H5Pcreate(H5P_LINK_CREATE);
+        res = H5Pset_char_encoding(lcpl.h5id(), info.cset);
+        res.check("repack: Could not set link encoding");
+
+        if (info.type == H5L_TYPE_SOFT || info.type == H5L_TYPE_EXTERNAL) {
+            std::vector<char> value(info.u.val_size);
+            res = H5Lget_val(src, name.c_str(), value.data(), value.size(), H5P_DEFAULT);
+            res.check("repack: Could not read link " + path);
+
+            if (info.type == H5L_TYPE_SOFT) {
+                res = H5Lcreate_soft(value.data(), dst, name.c_str(), lcpl.h5id(), H5P_DEFAULT);
+            } else {
+                const char *file_name = nullptr, *obj_name = nullptr;
+                unsigned flags = 0;
+                res = H5Lunpack_elink_val(value.data(), value.size(), &flags, &file_name, &obj_name);
+                res.check("repack: Could not unpack external link " + path);
+                res = H5Lcreate_external(file_name, obj_name, dst, name.c_str(), lcpl.h5id(), H5P_DEFAULT);
+            }
+            res.check("repack: Could not create link " + path);
+            stats.links++;
+            return;
+        }
+
+        if (info.type != H5L_TYPE_HARD) {
+            throw H5Exception("repack: Unsupported link type of " + path);
+        }
+
+        // all further hard links to an object become hard links to its copy
+        auto it = copied.find(info.u.address);
+        if (it != copied.end()) {
+            res = H5Lcreate_hard(dst_file, it->second.c_str(), dst, name.c_str(), lcpl.h5id(), H5P_DEFAULT);
+            res.check("repack: Could not create link " + path);
+            stats.links++;
+            return;
+        }
+        copied[info.u.address] = path;
+
+        H5Object obj = H5Oopen(src, name.c_str(), H5P_DEFAULT);
+        obj.check("repack: Could not open object " + path);
+        H5O_info_t oinfo;
+        res = H5Oget_info(obj.h5id(), &oinfo);
+        res.check("repack: Could not obtain object info of " + path);
+
+        if (oinfo.type == H5O_TYPE_GROUP) {
+            H5Object gcpl = H5Gget_create_plist(obj.h5id());
+            H5Object group = H5Gcreate2(dst, name.c_str(), lcpl.h5id(), gcpl.h5id(), H5P_DEFAULT);
+            group.check("repack: Could not create group " + path);
+            stats.groups++;
+
+            copyAttributes(obj.h5id(), group.h5id());
+            copyGroup(obj.h5id(), group.h5id(), path);
+            return;
+        }
+
+        auto entity = data.find(info.u.address);
+        if (oinfo.type == H5O_TYPE_DATASET && entity != data.end() && rewriteData(src, dst, name, entity->second, lcpl.h5id())) {
+            stats.datasets++;
+            stats.rewritten++;
+            return;
+        }
+
+        res = H5Ocopy(src, name.c_str(), dst, name.c_str(), H5P_DEFAULT, lcpl.h5id());
+        res.check("repack: Could not copy object " + path);
+        if (oinfo.type == H5O_TYPE_DATASET) {
+            stats.datasets++;
+        }
+    }
+
+    bool rewriteData(hid_t src, hid_t dst, const std::string &name, const std::string &entity, hid_t lcpl) {
+        DataSet source = H5Dopen2(src, name.c_str(), H5P_DEFAULT);
+        source.check("repack: Could not open data of " + entity);
+
+        h5x::DataType ftype = source.dataType();
+        const StorageLayout layout = source.layout();
+        const size_t rank = layout.shape.size();
+        if (rank == 0 || has_vlen(ftype.h5id())) {
+            return false;
+        }
+
+        const RepackTarget target = rule ? rule(entity, layout) : RepackTarget();
+        NDSize chunks = target.chunks ? target.chunks : DataSet::guessChunking(layout.shape, layout.element_size);
+        if (chunks.size() != rank) {
+            throw IncompatibleDimensions("Rank of the chunks must match the data", "repack");
+        }
+
+        DataSpace space = source.getSpace();
+        std::vector<hsize_t> dims(rank), maxdims(rank);
+        H5Sget_simple_extent_dims(space.h5id(), dims.data(), maxdims.data());
+        for (size_t i = 0; i < rank; i++) {
+            chunks[i] = std::max<ndsize_t>(chunks[i], 1);
+            if (maxdims[i] != H5S_UNLIMITED) {
+                chunks[i] = std::min<ndsize_t>(chunks[i], std::max<hsize_t>(maxdims[i], 1));
+            }
+        }
+
+        H5Object src_dcpl = H5Dget_create_plist(source.h5id());
+        H5Object dcpl = H5Pcopy(src_dcpl.h5id());
+        dcpl.check("repack: Could not copy creation plist of " + entity);
+
+        HErr res;
+        if (target.compression != Compression::Auto) {
+            res = H5Premove_filter(dcpl.h5id(), H5Z_FILTER_ALL);
+            res.check("repack: Could not remove filters");
+        }
+        if (target.compression == Compression::DeflateNormal) {
+            res = H5Pset_deflate(dcpl.h5id(), 6);
+            res.check("repack: Could not set deflate filter");
+        }
+        res = H5Pset_chunk(dcpl.h5id(), static_cast<int>(rank), chunks.data());
+        res.check("repack: Could not set chunk size");
+
+        DataSet copy = H5Dcreate2(dst, name.c_str(), ftype.h5id(), space.h5id(), lcpl, dcpl.h5id(), H5P_DEFAULT);
+        copy.check("repack: Could not create data of " + entity);
+
+        // the chunks are written directly if we can apply the filters ourselves
+        int level = -1;
+        bool direct = H5Pget_nfilters(dcpl.h5id()) == 0;
+#ifdef HAVE_ZLIB
+        if (!direct) {
+            level = copy.deflateLevel();
+            direct = level >= 0;
+        }
+#endif
+        direct = direct && DataSet::canWriteChunks();
+
+        copyChunks(source, copy, ftype, layout.shape, chunks, direct, level);
+        copyAttributes(source.h5id(), copy.h5id());
+
+        stats.bytes_in += layout.storage_size;
+        stats.bytes_out += copy.storageSize();
+        return true;
+    }
+
+    void copyChunks(const DataSet &source, DataSet &copy, const h5x::DataType &ftype,
+                    const NDSize &shape, const NDSize &chunks, bool direct, int level) {
+        const size_t rank = shape.size();
+        NDSize grid(rank);
+        for (size_t i = 0; i < rank; i++) {
+            grid[i] = (shape[i] + chunks[i] - 1) / chunks[i];
+        }
+
+        const ndsize_t nchunks = grid.nelms();
+        if (nchunks == 0) {
+            return;
+        }
+
+        const size_t chunk_bytes = nix::check::fits_in_size_t(chunks.nelms() * ftype.size(),
+                                                         "repack: Chunk exceeds memory");
+        const size_t workers = nthreads > 0 ? nthreads : std::max<size_t>(std::thread::hardware_concurrency(), 1);
+        const size_t batch = std::max<size_t>(std::min(batch_bytes / std::max<size_t>(chunk_bytes, 1), 4 * workers), 1);
+
+        std::vector<std::vector<char>> raw;
+        std::vector<NDSize> offsets;
+
+        for (ndsize_t first = 0; first < nchunks; first += batch) {
+            const size_t count = static_cast<size_t>(std::min<ndsize_t>(batch, nchunks - first));
+            raw.assign(count, std::vector<char>());
+            offsets.assign(count, NDSize(rank));
+
+            for (size_t k = 0; k < count; k++) {
+                // row-major position of the chunk in the chunk grid
+                ndsize_t index = first + k;
+                for (size_t i = rank; i-- > 0;) {
+                    offsets[k][i] = (index % grid[i]) * chunks[i];
+                    index /= grid[i];
+                }
+
+                NDSize region(rank);
+                for (size_t i = 0; i < rank; i++) {
+                    region[i] = std::min(chunks[i], shape[i] - offsets[k][i]);
+                }
+
+                // edge chunks are padded to the full chunk shape
+                raw[k].assign(chunk_bytes, 0);
+                DataSpace memSpace = DataSpace::create(chunks, false);
+                memSpace.hyperslab(region, NDSize(rank, 0));
+                DataSpace fileSpace = source.getSpace();
+                fileSpace.hyperslab(region, offsets[k]);
+                source.read(raw[k].data(), ftype, memSpace, fileSpace);
+
+                if (!direct) {
+                    // the library applies the filters
+                    DataSpace dstSpace = copy.getSpace();
+                    dstSpace.hyperslab(region, offsets[k]);
+                    copy.write(raw[k].data(), ftype, memSpace, dstSpace);
+                    raw[k].clear();
+                }
+            }
+
+            if (!direct) {
+                continue;
+            }
+
+#ifdef HAVE_ZLIB
+            if (level >= 0) {
+                std::vector<std::vector<char>> packed(count);
+                std::vector<std::future<void>> tasks;
+                const size_t ntasks = std::min(workers, count);
+                for (size_t w = 0; w < ntasks; w++) {
+                    tasks.push_back(std::async(std::launch::async, [&raw, &packed, level, ntasks, count, w]() {
+                        for (size_t k = w; k < count; k += ntasks) {
+                            packed[k] = DataSet::deflateChunk(raw[k].data(), raw[k].size(), level);
+                        }
+                    }));
+                }
+                for (auto &task : tasks) {
+                    task.get();
+                }
+                raw.swap(packed);
+            }
+#endif
+
+            for (size_t k = 0; k < count; k++) {
+                copy.writeChunk(offsets[k], raw[k].data(), raw[k].size());
+            }
+        }
+    }
+
+    hid_t       src_file;
+    hid_t       dst_file;
+    RepackRule  rule;
+    size_t      nthreads;
+    RepackStats stats;
+
+    // source address -> path of the copy
+    std::map<haddr_t, std::string> copied;
+    // source address of the data of a DataArray or DataFrame -> its name
+    std::map<haddr_t, std::string> data;
+};
+
+
+RepackStats repack(const std::string &src, const std::string &dst,
+                   const RepackRule &rule, size_t nthreads) {
+    H5Object src_file = H5Fopen(src.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    src_file.check("repack: Could not open file " + src);
+
+    H5Object fcpl = H5Fget_create_plist(src_file.h5id());
+    fcpl.check("repack: Could not obtain file creation plist");
+
+    H5Object dst_file = H5Fcreate(dst.c_str(), H5F_ACC_TRUNC, fcpl.h5id(), H5P_DEFAULT);
+    dst_file.check("repack: Could not create file " + dst);
+
+    Repacker repacker(src_file.h5id(), dst_file.h5id(), rule, nthreads);
+    return repacker.run();
+}
+
+} // namespace hdf5
+} // namespace nix
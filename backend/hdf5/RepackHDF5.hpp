@@ -0,0 +1,28 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_REPACK_HDF5_H
+#define NIX_REPACK_HDF5_H
+
+#include <nix/Repack.hpp>
+
+#include <string>
+
+namespace nix {
+namespace hdf5 {
+
+/**
+ * @brief Copy the HDF5 file src to dst, see {@link nix::repack}.
+ */
+RepackStats repack(const std::string &src, const std::string &dst,
+                   const RepackRule &rule, size_t nthreads);
+
+} // namespace hdf5
+} // namespace nix
+
+#endif // NIX_REPACK_HDF5_H
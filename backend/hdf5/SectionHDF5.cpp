@@ -69,6 +69,12 @@ SectionHDF5::SectionHDF5(const shared_ptr<IFile> &file, const shared_ptr<ISectio
 // Attribute getter and setter
 //--------------------------------------------------
 
+void SectionHDF5::forceUpdatedAt() {
+    NamedEntityHDF5::forceUpdatedAt();
+    file()->metadataSnapshot(nullptr);
+}
+
+
 void SectionHDF5::repository(const string &repository) {
     group().setAttr("repository", repository);
     forceUpdatedAt();
@@ -105,6 +111,7 @@ void SectionHDF5::link(const std::string &id) {
     auto target = dynamic_pointer_cast<SectionHDF5>(found.front().impl());
 
     group().createLink(target->group(), "link");
+    file()->metadataSnapshot(nullptr);
 }
 
 
@@ -188,6 +195,7 @@ shared_ptr<ISection> SectionHDF5::createSection(const string &name, const string
 
     auto p = const_pointer_cast<SectionHDF5>(shared_from_this());
     H5Group grp = g->openGroup(name, true);
+    file()->metadataSnapshot(nullptr);
     return make_shared<SectionHDF5>(file(), p, grp, new_id, type, name);
 }
 
@@ -207,6 +215,7 @@ bool SectionHDF5::deleteSection(const string &name_or_id) {
             }
             // if hasSection is true then section_group always exists
             deleted = g->removeAllLinks(section.name());
+            file()->metadataSnapshot(nullptr);
         }
     }
 
@@ -252,9 +261,23 @@ shared_ptr<IProperty> SectionHDF5::getProperty(ndsize_t index) const {
 
 
 shared_ptr<IProperty> SectionHDF5::createProperty(const string &name, const DataType &dtype) {
+    return createProperty(name, dtype, StringStorage());
+}
+
+
+shared_ptr<IProperty> SectionHDF5::createProperty(const string &name, const DataType &dtype,
+                                                  const StringStorage &strings) {
+    if (strings.mode == StringStorage::Mode::Dictionary) {
+        throw std::invalid_argument("Dictionary storage is not supported for properties");
+    }
+
     string new_id = util::createId();
     boost::optional<H5Group> g = property_group(true);
-    DataSet ds = g->createData(name, data_type_to_h5_filetype(dtype), {0});
+    h5x::DataType fileType = strings.mode == StringStorage::Mode::Fixed ?
+                             h5x::DataType::makeStrType(strings.length) :
+                             data_type_to_h5_filetype(dtype);
+    DataSet ds = g->createData(name, fileType, {0});
+    file()->metadataSnapshot(nullptr);
     return make_shared<PropertyHDF5>(file(), ds, new_id, name);
 }
 
@@ -279,6 +302,7 @@ bool SectionHDF5::deleteProperty(const string &name_or_id) {
     bool deleted = false;
     if (g && hasProperty(name_or_id)) {
         g->removeData(getProperty(name_or_id)->name());
+        file()->metadataSnapshot(nullptr);
         deleted = true;
     }
 
@@ -69,6 +69,10 @@ public:
     // Attribute getter and setter
     //--------------------------------------------------
 
+    // also drops the metadata snapshot of the file
+    void forceUpdatedAt();
+
+
     void repository(const std::string &repository);
 
 
@@ -137,6 +141,10 @@ public:
     std::shared_ptr<base::IProperty> createProperty(const std::string &name, const DataType &dtype);
 
 
+    std::shared_ptr<base::IProperty> createProperty(const std::string &name, const DataType &dtype,
+                                                    const StringStorage &strings);
+
+
     std::shared_ptr<base::IProperty> createProperty(const std::string &name, const Variant &value);
 
 
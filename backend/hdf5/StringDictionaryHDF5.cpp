@@ -0,0 +1,103 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "StringDictionaryHDF5.hpp"
+
+#include <nix/Exception.hpp>
+
+#include <limits>
+
+namespace nix {
+namespace hdf5 {
+
+
+StringDictionary StringDictionary::create(const H5Group &group, const std::string &name,
+                                          const Compression &compression) {
+    DataSet ds = group.createData(name, h5x::DataType::makeStrType(), {0}, compression);
+    return StringDictionary(ds);
+}
+
+
+StringDictionary::StringDictionary(const DataSet &ds)
+    : ds(ds) {
+    const NDSize size = ds.size();
+    table.resize(nix::check::fits_in_size_t(size[0], "Cannot allocate storage (exceeds memory)"));
+
+    if (!table.empty()) {
+        h5x::DataType memType = h5x::DataType::makeStrType();
+        StringWriter writer(size, table.data());
+        ds.read(*writer, memType, size);
+        writer.finish();
+        ds.vlenReclaim(memType, *writer);
+    }
+    stored = table.size();
+
+    index.reserve(table.size());
+    for (size_t i = 0; i < table.size(); i++) {
+        index.emplace(table[i], static_cast<uint32_t>(i));
+    }
+}
+
+
+uint32_t StringDictionary::encode(const std::string &str) {
+    auto it = index.find(str);
+    if (it != index.end()) {
+        return it->second;
+    }
+
+    if (table.size() >= std::numeric_limits<uint32_t>::max()) {
+        throw std::length_error("StringDictionary: too many distinct strings");
+    }
+
+    uint32_t code = static_cast<uint32_t>(table.size());
+    table.push_back(str);
+    index.emplace(str, code);
+    return code;
+}
+
+
+void StringDictionary::encode(const std::string *strings, uint32_t *codes, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        codes[i] = encode(strings[i]);
+    }
+}
+
+
+const std::string &StringDictionary::decode(uint32_t code) const {
+    if (code >= table.size()) {
+        throw ConsistencyError("String code " + std::to_string(code) +
+                               " is not in the dictionary of " + ds.name());
+    }
+    return table[code];
+}
+
+
+void StringDictionary::decode(const uint32_t *codes, std::string *strings, size_t n) const {
+    for (size_t i = 0; i < n; i++) {
+        strings[i] = decode(codes[i]);
+    }
+}
+
+
+void StringDictionary::flush() {
+    if (stored == table.size()) {
+        return;
+    }
+
+    const NDSize count {table.size() - stored};
+    const NDSize offset {stored};
+    ds.setExtent({table.size()});
+
+    h5x::DataType memType = h5x::DataType::makeStrType();
+    StringReader reader(count, table.data() + stored);
+    ds.write(*reader, memType, count, offset);
+    stored = table.size();
+}
+
+} // namespace hdf5
+} // namespace nix
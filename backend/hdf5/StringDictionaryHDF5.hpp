@@ -0,0 +1,66 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_STRING_DICTIONARY_HDF5_H
+#define NIX_STRING_DICTIONARY_HDF5_H
+
+#include "h5x/H5Group.hpp"
+#include "h5x/H5DataSet.hpp"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace nix {
+namespace hdf5 {
+
+/**
+ * The string table of dictionary encoded string data: a 1-d data set
+ * of distinct variable length strings, the data stores the index of
+ * each string in it. Entries are only ever appended, so existing codes
+ * stay valid.
+ */
+class StringDictionary {
+
+public:
+
+    static StringDictionary create(const H5Group &group, const std::string &name,
+                                   const Compression &compression);
+
+    explicit StringDictionary(const DataSet &ds);
+
+    const std::vector<std::string> &entries() const {
+        return table;
+    }
+
+    void encode(const std::string *strings, uint32_t *codes, size_t n);
+
+    void decode(const uint32_t *codes, std::string *strings, size_t n) const;
+
+    const std::string &decode(uint32_t code) const;
+
+    uint32_t encode(const std::string &str);
+
+    /**
+     * Write the entries added by encode to the file.
+     */
+    void flush();
+
+private:
+
+    DataSet                                     ds;
+    std::vector<std::string>                    table;
+    std::unordered_map<std::string, uint32_t>   index;
+    size_t                                      stored;
+};
+
+} // namespace hdf5
+} // namespace nix
+
+#endif // NIX_STRING_DICTIONARY_HDF5_H
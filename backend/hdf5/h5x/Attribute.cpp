@@ -10,6 +10,7 @@
 
 #include "Attribute.hpp"
 #include "H5DataType.hpp"
+#include "H5Trace.hpp"
 
 namespace nix {
 namespace hdf5 {
@@ -26,8 +27,13 @@ Attribute::Attribute(const Attribute &other) : H5Object(other) {
 
 
 void Attribute::read(h5x::DataType mem_type, const NDSize &size, void *data) {
+    TraceScope trace(IOOperation::AttrRead, hid);
     HErr status = H5Aread(hid, mem_type.h5id(), data);
     status.check("Attribute::read(): Could not read data");
+
+    if (trace.isActive()) {
+        trace.bytes(size.nelms() * mem_type.size());
+    }
 }
 
 void Attribute::read(h5x::DataType mem_type, const NDSize &size, std::string *data) {
@@ -42,8 +48,13 @@ void Attribute::read(h5x::DataType mem_type, const NDSize &size, std::string *da
 }
 
 void Attribute::write(h5x::DataType mem_type, const NDSize &size, const void *data) {
+    TraceScope trace(IOOperation::AttrWrite, hid);
     HErr status = H5Awrite(hid, mem_type.h5id(), data);
     status.check("Attribute::write(): Could not write data");
+
+    if (trace.isActive()) {
+        trace.bytes(size.nelms() * mem_type.size());
+    }
 }
 
 void Attribute::write(h5x::DataType mem_type, const NDSize &size, const std::string *data) {
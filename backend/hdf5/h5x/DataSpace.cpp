@@ -72,5 +72,29 @@ void DataSpace::hyperslab(const NDSize &count, const NDSize &start, H5S_seloper_
     status.check("DataSpace::hyperslab(): H5Sselect_hyperslab() failed!");
 }
 
+
+void DataSpace::hyperslab(const NDSize &count, const NDSize &start, const NDSize &stride, const NDSize &block,
+                          H5S_seloper_t op) {
+    HErr status = H5Sselect_hyperslab(hid, op, start.data(), stride.data(), count.data(), block.data());
+    status.check("DataSpace::hyperslab(): H5Sselect_hyperslab() failed!");
+}
+
+
+void DataSpace::elements(const std::vector<ndsize_t> &coords, H5S_seloper_t op) {
+    const int rank = H5Sget_simple_extent_ndims(hid);
+    if (rank <= 0) {
+        throw H5Exception("DataSpace::elements(): could not obtain the rank");
+    }
+    const size_t npoints = coords.size() / static_cast<size_t>(rank);
+    HErr status = H5Sselect_elements(hid, op, npoints, coords.data());
+    status.check("DataSpace::elements(): H5Sselect_elements() failed!");
+}
+
+
+void DataSpace::selectNone() {
+    HErr status = H5Sselect_none(hid);
+    status.check("DataSpace::selectNone(): H5Sselect_none() failed!");
+}
+
 } //::nix::hdf5
 } //::nix
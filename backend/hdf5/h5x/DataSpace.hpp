@@ -33,6 +33,17 @@ public:
 
     void hyperslab(const NDSize &count, const NDSize &start, H5S_seloper_t op = H5S_SELECT_SET);
 
+    void hyperslab(const NDSize &count, const NDSize &start, const NDSize &stride, const NDSize &block,
+                   H5S_seloper_t op = H5S_SELECT_SET);
+
+    /**
+     * @brief Select the points whose coordinates follow each other
+     *        in coords, rank values per point, in that order.
+     */
+    void elements(const std::vector<ndsize_t> &coords, H5S_seloper_t op = H5S_SELECT_SET);
+
+    void selectNone();
+
 };
 
 } //::nix::hdf5
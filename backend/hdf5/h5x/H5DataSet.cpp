@@ -8,9 +8,24 @@
 
 #include "H5DataSet.hpp"
 #include "H5Exception.hpp"
+#include "H5Trace.hpp"
 
+#include <nix/util/util.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <functional>
 #include <iostream>
 #include <cmath>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
 
 namespace nix {
 namespace hdf5 {
@@ -25,16 +40,41 @@ DataSet::DataSet(const DataSet &other)
 
 }
 
+// the number of bytes transferred in memory by a read or write
+static ndsize_t selection_bytes(hid_t dset, const h5x::DataType &memType, const DataSpace &memSpace, const DataSpace &fileSpace)
+{
+    hssize_t npoints = 0;
+    if (memSpace.h5id() != H5S_ALL) {
+        npoints = H5Sget_select_npoints(memSpace.h5id());
+    } else if (fileSpace.h5id() != H5S_ALL) {
+        npoints = H5Sget_select_npoints(fileSpace.h5id());
+    } else {
+        DataSpace space = H5Dget_space(dset);
+        npoints = H5Sget_select_npoints(space.h5id());
+    }
+    return npoints > 0 ? static_cast<ndsize_t>(npoints) * memType.size() : 0;
+}
+
 void DataSet::read(void *data, const h5x::DataType &memType, const DataSpace &memSpace, const DataSpace &fileSpace) const
 {
+    TraceScope trace(IOOperation::DataRead, hid);
     HErr res = H5Dread(hid, memType.h5id(), memSpace.h5id(), fileSpace.h5id(), H5P_DEFAULT, data);
     res.check("DataSet::read() IO error");
+
+    if (trace.isActive()) {
+        trace.bytes(selection_bytes(hid, memType, memSpace, fileSpace));
+    }
 }
 
 void DataSet::write(const void *data, const h5x::DataType &memType, const DataSpace &memSpace, const DataSpace &fileSpace)
 {
+    TraceScope trace(IOOperation::DataWrite, hid);
     HErr res = H5Dwrite(hid, memType.h5id(), memSpace.h5id(), fileSpace.h5id(), H5P_DEFAULT, data);
     res.check("DataSet::write() IOError");
+
+    if (trace.isActive()) {
+        trace.bytes(selection_bytes(hid, memType, memSpace, fileSpace));
+    }
 }
 
 void DataSet::read(void *data, h5x::DataType memType, const NDSize &count, const NDSize &offset) const
@@ -171,6 +211,566 @@ NDSize DataSet::size() const
     return getSpace().extent();
 }
 
+void DataSet::refresh()
+{
+#if H5_VERSION_GE(1, 10, 0)
+    HErr res = H5Drefresh(hid);
+    res.check("DataSet::refresh(): Could not refresh the DataSet");
+#else
+    throw H5Exception("DataSet::refresh(): SWMR needs HDF5 >= 1.10");
+#endif
+}
+
+NDSize DataSet::chunking() const
+{
+    H5Object dcpl = H5Dget_create_plist(hid);
+    dcpl.check("DataSet::chunking(): Could not obtain creation plist");
+
+    if (H5Pget_layout(dcpl.h5id()) != H5D_CHUNKED) {
+        return NDSize{};
+    }
+
+    NDSize chunks(size().size());
+    int rank = H5Pget_chunk(dcpl.h5id(), static_cast<int>(chunks.size()), chunks.data());
+    if (rank < 0) {
+        throw H5Exception("DataSet::chunking(): Could not obtain chunk size");
+    }
+
+    return chunks;
+}
+
+ndsize_t DataSet::storageSize() const
+{
+    return H5Dget_storage_size(hid);
+}
+
+ndsize_t DataSet::chunkCount() const
+{
+    const NDSize chunks = chunking();
+    if (!chunks) {
+        return 0;
+    }
+
+#if H5_VERSION_GE(1, 10, 5)
+    DataSpace space = getSpace();
+    hsize_t nchunks = 0;
+    HErr res = H5Dget_num_chunks(hid, space.h5id(), &nchunks);
+    res.check("DataSet::chunkCount(): Could not obtain number of chunks");
+    return nchunks;
+#else
+    // no chunk query, assume the whole grid is allocated once written to
+    if (storageSize() == 0) {
+        return 0;
+    }
+
+    const NDSize extent = size();
+    ndsize_t nchunks = 1;
+    for (size_t i = 0; i < extent.size(); i++) {
+        nchunks *= (extent[i] + chunks[i] - 1) / chunks[i];
+    }
+    return nchunks;
+#endif
+}
+
+std::vector<std::string> DataSet::filters() const
+{
+    H5Object dcpl = H5Dget_create_plist(hid);
+    dcpl.check("DataSet::filters(): Could not obtain creation plist");
+
+    std::vector<std::string> names;
+    int nfilters = H5Pget_nfilters(dcpl.h5id());
+    for (int i = 0; i < nfilters; i++) {
+        unsigned int flags = 0, config = 0;
+        unsigned int cd_values[8];
+        size_t cd_nelmts = 8;
+        char name[256] = "";
+
+        H5Z_filter_t id = H5Pget_filter2(dcpl.h5id(), static_cast<unsigned>(i), &flags, &cd_nelmts,
+                                         cd_values, sizeof(name), name, &config);
+        if (id < 0) {
+            throw H5Exception("DataSet::filters(): Could not obtain filter");
+        }
+
+        std::string str = name[0] != '\0' ? std::string(name) : "filter " + std::to_string(id);
+        if (id == H5Z_FILTER_DEFLATE && cd_nelmts > 0) {
+            str += " " + std::to_string(cd_values[0]);
+        }
+        names.push_back(str);
+    }
+
+    return names;
+}
+
+StorageLayout DataSet::layout() const
+{
+    StorageLayout layout;
+    layout.shape = size();
+    layout.chunks = chunking();
+    layout.element_size = dataType().size();
+    layout.storage_size = storageSize();
+    layout.allocated_chunks = chunkCount();
+    layout.filters = filters();
+
+#if H5_VERSION_GE(1, 10, 0)
+    H5Object dcpl = H5Dget_create_plist(hid);
+    dcpl.check("DataSet::layout(): Could not obtain creation plist");
+    if (H5Pget_layout(dcpl.h5id()) == H5D_VIRTUAL) {
+        size_t count = 0;
+        HErr res = H5Pget_virtual_count(dcpl.h5id(), &count);
+        res.check("DataSet::layout(): Could not obtain the number of virtual sources");
+        layout.virtual_sources = count;
+    }
+#endif
+    return layout;
+}
+
+void DataSet::writeChunk(const NDSize &offset, const void *data, size_t size, uint32_t filter_mask)
+{
+#if H5_VERSION_GE(1, 10, 2)
+    TraceScope trace(IOOperation::DataWrite, hid);
+    HErr res = H5Dwrite_chunk(hid, H5P_DEFAULT, filter_mask, offset.data(), size, data);
+    res.check("DataSet::writeChunk(): Could not write chunk");
+    trace.bytes(size);
+#else
+    throw H5Exception("DataSet::writeChunk(): Writing chunks directly needs HDF5 >= 1.10.2");
+#endif
+}
+
+bool DataSet::canWriteChunks()
+{
+    return H5_VERSION_GE(1, 10, 2);
+}
+
+std::vector<char> DataSet::readChunk(const NDSize &offset, uint32_t &filter_mask) const
+{
+#if H5_VERSION_GE(1, 10, 5)
+    TraceScope trace(IOOperation::DataRead, hid);
+    unsigned mask = 0;
+    haddr_t addr = HADDR_UNDEF;
+    hsize_t size = 0;
+    HErr res = H5Dget_chunk_info_by_coord(hid, offset.data(), &mask, &addr, &size);
+    res.check("DataSet::readChunk(): Could not get chunk info");
+
+    std::vector<char> bytes;
+    if (addr == HADDR_UNDEF || size == 0) {
+        return bytes;
+    }
+
+    bytes.resize(nix::check::fits_in_size_t(size, "DataSet::readChunk(): Chunk exceeds memory"));
+    res = H5Dread_chunk(hid, H5P_DEFAULT, offset.data(), &filter_mask, bytes.data());
+    res.check("DataSet::readChunk(): Could not read chunk");
+    trace.bytes(size);
+    return bytes;
+#else
+    throw H5Exception("DataSet::readChunk(): Reading chunks directly needs HDF5 >= 1.10.5");
+#endif
+}
+
+bool DataSet::canReadChunks()
+{
+    return H5_VERSION_GE(1, 10, 5);
+}
+
+int DataSet::deflateLevel() const
+{
+    H5Object dcpl = H5Dget_create_plist(hid);
+    dcpl.check("DataSet::deflateLevel(): Could not obtain creation plist");
+
+    if (H5Pget_nfilters(dcpl.h5id()) != 1) {
+        return -1;
+    }
+
+    unsigned int flags = 0, config = 0, cd_values[8];
+    size_t cd_nelmts = 8;
+    char name[64];
+    H5Z_filter_t id = H5Pget_filter2(dcpl.h5id(), 0, &flags, &cd_nelmts, cd_values,
+                                     sizeof(name), name, &config);
+    if (id != H5Z_FILTER_DEFLATE || cd_nelmts == 0) {
+        return -1;
+    }
+    return static_cast<int>(cd_values[0]);
+}
+
+std::vector<char> DataSet::deflateChunk(const void *data, size_t size, int level)
+{
+#ifdef HAVE_ZLIB
+    uLongf len = compressBound(static_cast<uLong>(size));
+    std::vector<char> packed(len);
+    int res = compress2(reinterpret_cast<Bytef *>(packed.data()), &len,
+                        static_cast<const Bytef *>(data), static_cast<uLong>(size), level);
+    if (res != Z_OK) {
+        throw std::runtime_error("DataSet::deflateChunk(): Could not compress chunk");
+    }
+    packed.resize(len);
+    return packed;
+#else
+    throw std::runtime_error("DataSet::deflateChunk(): NIX was built without zlib");
+#endif
+}
+
+void DataSet::inflateChunk(const void *data, size_t size, void *raw, size_t raw_size)
+{
+#ifdef HAVE_ZLIB
+    uLongf len = static_cast<uLongf>(raw_size);
+    int res = uncompress(static_cast<Bytef *>(raw), &len, static_cast<const Bytef *>(data), static_cast<uLong>(size));
+    if (res != Z_OK || len != raw_size) {
+        throw std::runtime_error("DataSet::inflateChunk(): Could not decompress chunk");
+    }
+#else
+    throw std::runtime_error("DataSet::inflateChunk(): NIX was built without zlib");
+#endif
+}
+
+// upper bound of the chunk data that writeParallel and readParallel
+// keep in memory at once
+static const size_t parallel_batch_bytes = 32 * 1024 * 1024;
+
+// Passes the items [0, n) through two steps, both in order of the items:
+// the step done by serial runs on the calling thread (all calls into
+// HDF5), the other one on a fixed set of nthreads worker threads. If
+// serial_first, serial(k) runs before parallel(k), otherwise after it.
+// At most window items are between the steps at any time, item k uses
+// slot k % window. The first exception ends the run and is rethrown.
+template<typename Serial, typename Parallel>
+static void run_pipeline(ndsize_t n, size_t nthreads, size_t window, bool serial_first,
+                         const Serial &serial, const Parallel &parallel)
+{
+    enum class Slot { Free, InFirst, Filled, InSecond };
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::vector<Slot> slots(window, Slot::Free);
+    ndsize_t next[2] = {0, 0};
+    std::exception_ptr error;
+
+    auto step = [&](int which, const std::function<void(ndsize_t, size_t)> &func) {
+        const Slot ready = which == 0 ? Slot::Free : Slot::Filled;
+        std::unique_lock<std::mutex> lock(mtx);
+        while (true) {
+            cv.wait(lock, [&] { return error || next[which] == n || slots[next[which] % window] == ready; });
+            if (error || next[which] == n) {
+                return;
+            }
+
+            const ndsize_t item = next[which]++;
+            const size_t slot = static_cast<size_t>(item % window);
+            slots[slot] = which == 0 ? Slot::InFirst : Slot::InSecond;
+
+            lock.unlock();
+            try {
+                func(item, slot);
+            } catch (...) {
+                lock.lock();
+                if (!error) {
+                    error = std::current_exception();
+                }
+                cv.notify_all();
+                return;
+            }
+            lock.lock();
+
+            slots[slot] = which == 0 ? Slot::Filled : Slot::Free;
+            cv.notify_all();
+        }
+    };
+
+    const int serial_step = serial_first ? 0 : 1;
+    std::vector<std::thread> workers;
+    try {
+        for (size_t w = 0; w < nthreads; w++) {
+            workers.emplace_back(step, 1 - serial_step, std::cref(parallel));
+        }
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(mtx);
+        error = std::current_exception();
+        cv.notify_all();
+    }
+
+    step(serial_step, serial);
+
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+// copy the chunk at pos (relative to the start of data) out of the
+// row-major data of the given shape
+static void gather_chunk(const char *data, const NDSize &shape, const NDSize &pos,
+                         const NDSize &chunks, size_t esize, char *chunk)
+{
+    const size_t rank = shape.size();
+    const size_t row = static_cast<size_t>(chunks[rank - 1]) * esize;
+    const ndsize_t nrows = chunks.nelms() / chunks[rank - 1];
+
+    NDSize idx(rank, 0);
+    for (ndsize_t r = 0; r < nrows; r++) {
+        ndsize_t index = 0;
+        for (size_t i = 0; i < rank; i++) {
+            index = index * shape[i] + pos[i] + idx[i];
+        }
+        std::memcpy(chunk + r * row, data + index * esize, row);
+
+        for (size_t i = rank - 1; i-- > 0;) {
+            if (++idx[i] < chunks[i]) {
+                break;
+            }
+            idx[i] = 0;
+        }
+    }
+}
+
+// copy the part of the chunk at pos that lies in the region [start, start + shape)
+// into the row-major data of that region
+static void scatter_chunk(const char *chunk, const NDSize &pos, const NDSize &chunks,
+                          const NDSize &start, const NDSize &shape, size_t esize, char *data)
+{
+    const size_t rank = shape.size();
+    NDSize lo(rank), count(rank);
+    for (size_t i = 0; i < rank; i++) {
+        lo[i] = std::max(pos[i], start[i]);
+        count[i] = std::min(pos[i] + chunks[i], start[i] + shape[i]) - lo[i];
+    }
+
+    const size_t row = static_cast<size_t>(count[rank - 1]) * esize;
+    const ndsize_t nrows = count.nelms() / count[rank - 1];
+
+    NDSize idx(rank, 0);
+    for (ndsize_t r = 0; r < nrows; r++) {
+        ndsize_t src = 0, dst = 0;
+        for (size_t i = 0; i < rank; i++) {
+            src = src * chunks[i] + lo[i] - pos[i] + idx[i];
+            dst = dst * shape[i] + lo[i] - start[i] + idx[i];
+        }
+        std::memcpy(data + dst * esize, chunk + src * esize, row);
+
+        for (size_t i = rank - 1; i-- > 0;) {
+            if (++idx[i] < count[i]) {
+                break;
+            }
+            idx[i] = 0;
+        }
+    }
+}
+
+void DataSet::writeParallel(const void *data, const h5x::DataType &memType,
+                            const NDSize &count, const NDSize &offset, size_t nthreads)
+{
+    const size_t rank = count.size();
+    const NDSize chunks = chunking();
+    int level = deflateLevel();
+#ifndef HAVE_ZLIB
+    level = -1;
+#endif
+
+    // chunks written directly skip the type conversion of the library
+    const h5x::DataType fileType = dataType();
+    bool direct = canWriteChunks() && level >= 0 && rank > 0 && chunks.size() == rank &&
+                  !memType.isVariableString() && memType.equal(fileType);
+
+    const NDSize start = offset ? offset : NDSize(rank, 0);
+    if (direct) {
+        // let write() report regions outside of the DataSet
+        const NDSize extent = size();
+        for (size_t i = 0; i < rank; i++) {
+            direct = direct && start.size() == rank && start[i] + count[i] <= extent[i];
+        }
+    }
+
+    // the chunks that lie completely inside the region: [lo, hi)
+    NDSize lo(rank), hi(rank);
+    for (size_t i = 0; direct && i < rank; i++) {
+        lo[i] = (start[i] + chunks[i] - 1) / chunks[i] * chunks[i];
+        hi[i] = (start[i] + count[i]) / chunks[i] * chunks[i];
+        direct = hi[i] > lo[i];
+    }
+
+    if (!direct) {
+        write(data, memType, count, offset);
+        return;
+    }
+
+    // the rest of the region, as up to two boxes per dimension
+    for (size_t d = 0; d < rank; d++) {
+        const ndsize_t end = start[d] + count[d];
+        for (int side = 0; side < 2; side++) {
+            NDSize box_offset(rank), box_count(rank);
+            for (size_t i = 0; i < rank; i++) {
+                if (i < d) {
+                    box_offset[i] = lo[i];
+                    box_count[i] = hi[i] - lo[i];
+                } else if (i > d) {
+                    box_offset[i] = start[i];
+                    box_count[i] = count[i];
+                } else if (side == 0) {
+                    box_offset[i] = start[i];
+                    box_count[i] = lo[i] - start[i];
+                } else {
+                    box_offset[i] = hi[i];
+                    box_count[i] = end - hi[i];
+                }
+            }
+            if (box_count.nelms() == 0) {
+                continue;
+            }
+
+            DataSpace memSpace = DataSpace::create(count, false);
+            memSpace.hyperslab(box_count, box_offset - start);
+            DataSpace fileSpace = getSpace();
+            fileSpace.hyperslab(box_count, box_offset);
+            write(data, memType, memSpace, fileSpace);
+        }
+    }
+
+    NDSize grid(rank);
+    for (size_t i = 0; i < rank; i++) {
+        grid[i] = (hi[i] - lo[i]) / chunks[i];
+    }
+    const ndsize_t nchunks = grid.nelms();
+
+    auto chunk_offset = [&](ndsize_t index) {
+        NDSize pos(rank);
+        for (size_t i = rank; i-- > 0;) {
+            pos[i] = lo[i] + (index % grid[i]) * chunks[i];
+            index /= grid[i];
+        }
+        return pos;
+    };
+
+    const size_t esize = memType.size();
+    const size_t chunk_bytes = nix::check::fits_in_size_t(chunks.nelms() * esize,
+                                                          "DataSet::writeParallel(): Chunk exceeds memory");
+    const size_t workers = nthreads > 0 ? nthreads : std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    const size_t window = std::max<size_t>(std::min(parallel_batch_bytes / chunk_bytes, 4 * workers), 1);
+    const char *bytes = static_cast<const char *>(data);
+
+    // the workers compress the chunks, this thread writes them in order
+    std::vector<std::vector<char>> raw(window), packed(window);
+    run_pipeline(nchunks, static_cast<size_t>(std::min<ndsize_t>(workers, nchunks)), window, false,
+                 [&](ndsize_t k, size_t slot) {
+                     writeChunk(chunk_offset(k), packed[slot].data(), packed[slot].size());
+                 },
+                 [&](ndsize_t k, size_t slot) {
+                     raw[slot].resize(chunk_bytes);
+                     gather_chunk(bytes, count, chunk_offset(k) - start, chunks, esize, raw[slot].data());
+                     packed[slot] = deflateChunk(raw[slot].data(), raw[slot].size(), level);
+                 });
+}
+
+void DataSet::readParallel(void *data, const h5x::DataType &memType,
+                           const NDSize &count, const NDSize &offset, size_t nthreads) const
+{
+    const size_t rank = count.size();
+    const NDSize chunks = chunking();
+    int level = deflateLevel();
+#ifndef HAVE_ZLIB
+    level = -1;
+#endif
+
+    const h5x::DataType fileType = dataType();
+    const NDSize start = offset ? offset : NDSize(rank, 0);
+    bool direct = canReadChunks() && level >= 0 && rank > 0 && chunks.size() == rank && count.nelms() > 0 &&
+                  start.size() == rank && !fileType.isVariableString();
+    if (direct) {
+        // let read() report regions outside of the DataSet
+        const NDSize extent = size();
+        for (size_t i = 0; i < rank; i++) {
+            direct = direct && start[i] + count[i] <= extent[i];
+        }
+    }
+
+    if (!direct) {
+        read(data, memType, count, offset);
+        return;
+    }
+
+    if (!memType.equal(fileType)) {
+        const H5T_class_t mem_class = memType.class_t(), file_class = fileType.class_t();
+        auto numeric = [](H5T_class_t c) { return c == H5T_INTEGER || c == H5T_FLOAT; };
+        if (!numeric(mem_class) || !numeric(file_class)) {
+            read(data, memType, count, offset);
+            return;
+        }
+
+        // decompress in the type of the file, then convert in place
+        const size_t n = nix::check::fits_in_size_t(count.nelms(), "DataSet::readParallel(): Data exceeds memory");
+        std::vector<char> buffer(n * std::max(fileType.size(), memType.size()));
+        readParallel(buffer.data(), fileType, count, offset, nthreads);
+        HErr res = H5Tconvert(fileType.h5id(), memType.h5id(), n, buffer.data(), nullptr, H5P_DEFAULT);
+        res.check("DataSet::readParallel(): Could not convert data");
+        std::memcpy(data, buffer.data(), n * memType.size());
+        return;
+    }
+
+    // the chunks that intersect the region: [lo, hi)
+    NDSize lo(rank), grid(rank);
+    for (size_t i = 0; i < rank; i++) {
+        lo[i] = start[i] / chunks[i] * chunks[i];
+        grid[i] = (start[i] + count[i] - lo[i] + chunks[i] - 1) / chunks[i];
+    }
+    const ndsize_t nchunks = grid.nelms();
+
+    auto chunk_offset = [&](ndsize_t index) {
+        NDSize pos(rank);
+        for (size_t i = rank; i-- > 0;) {
+            pos[i] = lo[i] + (index % grid[i]) * chunks[i];
+            index /= grid[i];
+        }
+        return pos;
+    };
+
+    const size_t esize = memType.size();
+    const size_t chunk_bytes = nix::check::fits_in_size_t(chunks.nelms() * esize,
+                                                          "DataSet::readParallel(): Chunk exceeds memory");
+    const size_t workers = nthreads > 0 ? nthreads : std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    const size_t window = std::max<size_t>(std::min(parallel_batch_bytes / chunk_bytes, 4 * workers), 1);
+    char *bytes = static_cast<char *>(data);
+
+    // this thread reads the chunks in order, the workers decompress them
+    std::vector<std::vector<char>> fetched(window), raw(window);
+    std::vector<uint32_t> masks(window);
+    run_pipeline(nchunks, static_cast<size_t>(std::min<ndsize_t>(workers, nchunks)), window, true,
+                 [&](ndsize_t k, size_t slot) {
+                     const NDSize pos = chunk_offset(k);
+                     masks[slot] = 0;
+                     fetched[slot] = readChunk(pos, masks[slot]);
+                     if (!fetched[slot].empty()) {
+                         return;
+                     }
+
+                     // not allocated: read() supplies the fill value
+                     NDSize box_offset(rank), box_count(rank);
+                     for (size_t i = 0; i < rank; i++) {
+                         box_offset[i] = std::max(pos[i], start[i]);
+                         box_count[i] = std::min(pos[i] + chunks[i], start[i] + count[i]) - box_offset[i];
+                     }
+                     DataSpace memSpace = DataSpace::create(count, false);
+                     memSpace.hyperslab(box_count, box_offset - start);
+                     DataSpace fileSpace = getSpace();
+                     fileSpace.hyperslab(box_count, box_offset);
+                     read(data, memType, memSpace, fileSpace);
+                 },
+                 [&](ndsize_t k, size_t slot) {
+                     const std::vector<char> &in = fetched[slot];
+                     if (in.empty()) {
+                         return;
+                     }
+
+                     const char *chunk = in.data();
+                     // bit 0 of the mask is set if deflate was skipped
+                     if ((masks[slot] & 1) == 0) {
+                         raw[slot].resize(chunk_bytes);
+                         inflateChunk(in.data(), in.size(), raw[slot].data(), raw[slot].size());
+                         chunk = raw[slot].data();
+                     } else if (in.size() != chunk_bytes) {
+                         throw std::runtime_error("DataSet::readParallel(): Unexpected size of unfiltered chunk");
+                     }
+                     scatter_chunk(chunk, chunk_offset(k), chunks, start, count, esize, bytes);
+                 });
+}
+
 void DataSet::vlenReclaim(h5x::DataType mem_type, void *data, DataSpace *dspace) const
 {
     HErr res;
@@ -214,5 +814,109 @@ std::tuple<DataSpace, DataSpace> DataSet::offsetCount2DataSpaces(const NDSize &c
     return std::tuple<DataSpace, DataSpace>(memSpace, fileSpace);
 }
 
+
+// above this number of hyperslabs a selection is made of points, if
+// the hyperslabs hold at most max_points_per_slab elements on average
+static const ndsize_t max_selection_slabs = 64;
+static const ndsize_t max_points_per_slab = 16;
+
+std::tuple<DataSpace, DataSpace> DataSet::selection2DataSpaces(const Selection &selection) const
+{
+    DataSpace fileSpace = getSpace();
+    const NDSize extent = fileSpace.extent();
+    const size_t rank = extent.size();
+
+    // one hyperslab (start, stride, count, block) per slab, one per run of an index list
+    struct Slab {
+        hsize_t start, stride, count, block;
+    };
+
+    std::vector<std::vector<std::vector<Slab>>> parts;
+    ndsize_t nslabs = 0, nelms = 0;
+    for (const std::vector<Selection::Dim> &part : selection.resolve(extent)) {
+        std::vector<std::vector<Slab>> slabs(rank);
+        ndsize_t combinations = 1, elements = 1;
+        for (size_t d = 0; d < rank; d++) {
+            const Selection::Dim &dim = part[d];
+            if (dim.kind == Selection::Dim::Kind::Indices) {
+                for (ndsize_t i : dim.indices) {
+                    if (!slabs[d].empty() && slabs[d].back().start + slabs[d].back().block == i) {
+                        slabs[d].back().block++;
+                    } else {
+                        slabs[d].push_back(Slab {i, 1, 1, 1});
+                    }
+                }
+                elements *= dim.indices.size();
+            } else if (dim.count > 0) {
+                slabs[d].push_back(Slab {dim.start, std::max(dim.stride, dim.block), dim.count, dim.block});
+                elements *= dim.count * dim.block;
+            }
+            combinations *= slabs[d].size();
+        }
+        if (combinations > 0) {
+            parts.push_back(std::move(slabs));
+            nslabs += combinations;
+            nelms += elements;
+        }
+    }
+
+    // OR-ing many small hyperslabs is slow: index lists in several
+    // dimensions are selected as points instead, in row-major order
+    const bool points = nslabs > max_selection_slabs && nelms <= max_points_per_slab * nslabs;
+    if (points) {
+        std::vector<ndsize_t> coords;
+        coords.reserve(nix::check::fits_in_size_t(nelms * rank, "DataSet::selection2DataSpaces(): Selection exceeds memory"));
+        for (const Selection::Run &run : selection.runs(extent)) {
+            for (ndsize_t k = 0; k < run.length; k++) {
+                coords.insert(coords.end(), run.offset.data(), run.offset.data() + rank);
+                coords.back() += k;
+            }
+        }
+        fileSpace.elements(coords);
+        parts.clear();
+    }
+
+    bool selected = points;
+    for (const std::vector<std::vector<Slab>> &slabs : parts) {
+        // the cartesian product of the slabs of all dimensions
+        std::vector<size_t> pos(rank, 0);
+        NDSize start(rank), stride(rank), count(rank), block(rank);
+        while (true) {
+            for (size_t d = 0; d < rank; d++) {
+                const Slab &slab = slabs[d][pos[d]];
+                start[d] = slab.start;
+                stride[d] = slab.stride;
+                count[d] = slab.count;
+                block[d] = slab.block;
+            }
+            fileSpace.hyperslab(count, start, stride, block, selected ? H5S_SELECT_OR : H5S_SELECT_SET);
+            selected = true;
+
+            size_t d = rank;
+            while (d > 0 && ++pos[d - 1] == slabs[d - 1].size()) {
+                pos[--d] = 0;
+            }
+            if (d == 0) {
+                break;
+            }
+        }
+    }
+
+    if (!selected) {
+        fileSpace.selectNone();
+    }
+
+    hssize_t npoints = H5Sget_select_npoints(fileSpace.h5id());
+    if (npoints < 0) {
+        throw H5Exception("DataSet::selection2DataSpaces(): could not count the selected elements");
+    }
+    DataSpace memSpace = DataSpace::create(NDSize({static_cast<ndsize_t>(npoints)}), false);
+    if (npoints == 0) {
+        memSpace.selectNone();
+    }
+
+    return std::tuple<DataSpace, DataSpace>(memSpace, fileSpace);
+}
+
 } // namespace hdf5
 } // namespace nix
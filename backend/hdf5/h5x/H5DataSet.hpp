@@ -13,11 +13,14 @@
 #include "H5DataType.hpp"
 #include "LocID.hpp"
 #include <nix/Hydra.hpp>
+#include <nix/Selection.hpp>
 #include <nix/Value.hpp>
+#include <nix/StorageLayout.hpp>
 
 #include <nix/Platform.hpp>
 
 #include <tuple>
+#include <vector>
 
 namespace nix {
 namespace hdf5 {
@@ -56,6 +59,117 @@ public:
     void setExtent(const NDSize &dims);
     NDSize size() const;
 
+    /**
+     * @brief Re-read the metadata of the DataSet, e.g. the extent a
+     * SWMR writer changed since the file was opened.
+     */
+    void refresh();
+
+    /**
+     * @brief The chunk shape of the DataSet or an empty NDSize if
+     *        the DataSet is not chunked.
+     */
+    NDSize chunking() const;
+
+    /**
+     * @brief The number of bytes allocated in the file for the data,
+     *        i.e. after compression.
+     */
+    ndsize_t storageSize() const;
+
+    /**
+     * @brief The number of chunks allocated in the file, 0 if the
+     *        DataSet is not chunked.
+     *
+     * HDF5 before 1.10.5 cannot count the allocated chunks, there
+     * this is the number of chunks covering the extent once any
+     * storage is allocated.
+     */
+    ndsize_t chunkCount() const;
+
+    /**
+     * @brief The names of the filters in the filter pipeline; the
+     *        deflate filter includes the compression level.
+     */
+    std::vector<std::string> filters() const;
+
+    StorageLayout layout() const;
+
+    /**
+     * @brief Write the already filtered bytes of the chunk starting
+     *        at offset, bypassing the filter pipeline.
+     *
+     * @param filter_mask  Bit i set if filter i was not applied.
+     *
+     * Throws if the HDF5 library is older than 1.10.2.
+     */
+    void writeChunk(const NDSize &offset, const void *data, size_t size, uint32_t filter_mask = 0);
+
+    /**
+     * @brief Whether the HDF5 library supports writeChunk.
+     */
+    static bool canWriteChunks();
+
+    /**
+     * @brief Read the filtered bytes of the chunk starting at offset,
+     *        bypassing the filter pipeline.
+     *
+     * @param filter_mask  Set to the filters that were not applied.
+     *
+     * @return The bytes or an empty vector if the chunk is not allocated.
+     *
+     * Throws if the HDF5 library is older than 1.10.5.
+     */
+    std::vector<char> readChunk(const NDSize &offset, uint32_t &filter_mask) const;
+
+    /**
+     * @brief Whether the HDF5 library supports readChunk.
+     */
+    static bool canReadChunks();
+
+    /**
+     * @brief The level of the deflate filter if that is the only filter
+     *        in the filter pipeline, -1 otherwise.
+     */
+    int deflateLevel() const;
+
+    /**
+     * @brief Compress the bytes of a chunk like the deflate filter with
+     *        the given level; throws if built without zlib.
+     */
+    static std::vector<char> deflateChunk(const void *data, size_t size, int level);
+
+    /**
+     * @brief Decompress a chunk compressed by the deflate filter into
+     *        raw_size bytes at raw; throws if built without zlib.
+     */
+    static void inflateChunk(const void *data, size_t size, void *raw, size_t raw_size);
+
+    /**
+     * @brief Write data like write(), but compress the chunks the region
+     *        covers completely on nthreads threads (0: one per core) and
+     *        write them with writeChunk.
+     *
+     * Only the compression runs in parallel, all calls into HDF5 stay on
+     * the calling thread. The rest of the region and data that cannot
+     * be written directly (other filters, type conversions) take the
+     * normal path.
+     */
+    void writeParallel(const void *data, const h5x::DataType &memType,
+                       const NDSize &count, const NDSize &offset, size_t nthreads);
+
+    /**
+     * @brief Read data like read(), but fetch the chunks that intersect
+     *        the region with readChunk and decompress them on nthreads
+     *        threads (0: one per core).
+     *
+     * Numbers of another type than in the file are converted after
+     * decompression. Chunks that are not allocated and data that cannot
+     * be read directly (other filters, strings) take the normal path.
+     */
+    void readParallel(void *data, const h5x::DataType &memType,
+                      const NDSize &count, const NDSize &offset, size_t nthreads) const;
+
     void vlenReclaim(h5x::DataType mem_type, void *data, DataSpace *dspace = nullptr) const;
 
     h5x::DataType dataType(void) const;
@@ -63,6 +177,16 @@ public:
     DataSpace getSpace() const;
 
     std::tuple<DataSpace, DataSpace> offsetCount2DataSpaces(const NDSize &count, const NDSize &offset={}) const;
+
+    /**
+     * @brief The data spaces to read a selection with one H5Dread: the
+     *        selection as union of hyperslabs in the file and a 1-d
+     *        memory space of the number of selected elements.
+     *
+     * Index lists in several dimensions multiply into many small
+     * hyperslabs; above a threshold they are selected as points instead.
+     */
+    std::tuple<DataSpace, DataSpace> selection2DataSpaces(const Selection &selection) const;
 };
 
 
@@ -38,6 +38,10 @@ DataType DataType::makeStrType(size_t size) {
     DataType str_type = H5Tcopy(H5T_C_S1);
     str_type.check("Could not create string type");
     str_type.size(size);
+    if (size != H5T_VARIABLE) {
+        HErr res = H5Tset_strpad(str_type.h5id(), H5T_STR_NULLPAD);
+        res.check("Could not set string padding");
+    }
     return str_type;
 }
 
@@ -82,6 +86,10 @@ bool DataType::isVariableString() const {
     return res.result();
 }
 
+bool DataType::isFixedString() const {
+    return class_t() == H5T_STRING && !isVariableString();
+}
+
 bool DataType::isCompound() const {
     return class_t() == H5T_COMPOUND;
 }
@@ -54,6 +54,7 @@ public:
     H5T_sign_t sign() const;
 
     bool isVariableString() const;
+    bool isFixedString() const;
 
     // Compound type related
     bool isCompound() const;
@@ -7,6 +7,7 @@
 // LICENSE file in the root of the Project.
 
 #include "H5Group.hpp"
+#include "H5Trace.hpp"
 #include <nix/util/util.hpp>
 #include "H5Exception.hpp"
 
@@ -43,6 +44,7 @@ bool H5Group::hasObject(const std::string &name) const {
         return false;
     }
 
+    TraceScope trace(IOOperation::ObjectLookup, hid);
     HTri res = H5Lexists(hid, name.c_str(), H5P_DEFAULT);
     return res.check("H5Group::hasObject(): H5Lexists failed");
 }
@@ -130,6 +132,8 @@ std::string H5Group::objectName(ndsize_t index) const {
 			              static_cast<size_t>(index));
     }
 
+    TraceScope trace(IOOperation::ObjectName, hid);
+
     std::string str_name;
     // check whether name is found by index
     H5_index_t index_type = H5_INDEX_CRT_ORDER;
@@ -240,6 +244,67 @@ DataSet H5Group::createData(const std::string &name,
 }
 
 
+#if H5_VERSION_GE(1, 10, 0)
+// '%' starts a pattern in the names of virtual data set sources
+static std::string escape_vds_name(const std::string &name) {
+    std::string escaped;
+    for (char c : name) {
+        if (c == '%') {
+            escaped += '%';
+        }
+        escaped += c;
+    }
+    return escaped;
+}
+#endif
+
+
+DataSet H5Group::createVirtualData(const std::string &name,
+                                   const h5x::DataType &fileType,
+                                   const NDSize &size,
+                                   const std::vector<VirtualSlab> &slabs) const
+{
+#if H5_VERSION_GE(1, 10, 0)
+    DataSpace space = DataSpace::create(size, false);
+    DataSpace mapped = DataSpace::create(size, false);
+
+    H5Object dcpl = H5Pcreate(H5P_DATASET_CREATE);
+    dcpl.check("Could not create data creation plist");
+
+    const std::string own_file = fileName();
+    for (const VirtualSlab &slab : slabs) {
+        if (slab.count.nelms() == 0) {
+            continue;
+        }
+
+        mapped.hyperslab(slab.count, slab.offset);
+        DataSpace source_space = slab.source.getSpace();
+        source_space.hyperslab(slab.count, slab.source_offset);
+
+        const std::string file = slab.source.fileName();
+        const std::string src_file = file == own_file ? "." : escape_vds_name(file);
+        const std::string src_name = escape_vds_name(slab.source.name());
+        HErr res = H5Pset_virtual(dcpl.h5id(), mapped.h5id(), src_file.c_str(), src_name.c_str(),
+                                  source_space.h5id());
+        res.check("H5Group::createVirtualData: Could not map " + slab.source.name());
+    }
+
+    DataSet ds = H5Dcreate(hid, name.c_str(), fileType.h5id(), space.h5id(), H5P_DEFAULT, dcpl.h5id(), H5P_DEFAULT);
+    ds.check("H5Group::createVirtualData: Could not create DataSet with name " + name);
+
+    return ds;
+#else
+    throw H5Exception("H5Group::createVirtualData: Virtual data sets need HDF5 >= 1.10");
+#endif
+}
+
+
+bool H5Group::canCreateVirtualData()
+{
+    return H5_VERSION_GE(1, 10, 0);
+}
+
+
 DataSet H5Group::openData(const std::string &name) const {
     DataSet ds = H5Dopen(hid, name.c_str(), H5P_DEFAULT);
     ds.check("H5Group::openData(): Could not open DataSet");
@@ -254,6 +319,7 @@ bool H5Group::hasGroup(const std::string &name) const {
 
 H5Group H5Group::openGroup(const std::string &name, bool create) const {
     check_h5_arg_name(name);
+    TraceScope trace(IOOperation::GroupOpen, hid);
 
     H5Group g;
 
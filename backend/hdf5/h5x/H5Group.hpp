@@ -26,9 +26,20 @@ namespace hdf5 {
 
 struct optGroup;
 
+/**
+ * @brief A box of a data set mapped into a virtual data set.
+ */
+struct VirtualSlab {
+    DataSet source;
+    NDSize  count;
+    NDSize  source_offset;
+    NDSize  offset;
+};
+
 /**
  * TODO documentation
  */
+
 class NIXAPI H5Group : public LocID {
 
 public:
@@ -52,6 +63,20 @@ public:
                        const NDSize &maxsize = {}, NDSize chunks = {},
                        bool maxSizeUnlimited = true, bool guessChunks = true) const;
 
+    /**
+     * @brief Create a virtual data set that maps boxes of other data sets.
+     *
+     * Sources in the file of the group are mapped with ".", all others by
+     * the name of their file. Elements not mapped read as fill value.
+     */
+    DataSet createVirtualData(const std::string &name, const h5x::DataType &fileType,
+                              const NDSize &size, const std::vector<VirtualSlab> &slabs) const;
+
+    /**
+     * @brief Whether the HDF5 library supports virtual data sets (>= 1.10).
+     */
+    static bool canCreateVirtualData();
+
     DataSet openData(const std::string &name) const;
     void removeData(const std::string &name);
 
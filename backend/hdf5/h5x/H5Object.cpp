@@ -99,6 +99,24 @@ std::string H5Object::name() const {
 }
 
 
+std::string H5Object::fileName() const {
+    ssize_t len = H5Fget_name(hid, nullptr, 0);
+
+    if (len < 0) {
+        throw H5Exception("Could not get size of file name");
+    }
+
+    std::vector<char> buffer(static_cast<size_t>(len + 1), 0);
+    len = H5Fget_name(hid, buffer.data(), buffer.size());
+
+    if (len < 0) {
+        throw H5Exception("Could not obtain file name");
+    }
+
+    return std::string(buffer.data());
+}
+
+
 H5I_type_t H5Object::type() const {
     return H5Iget_type(hid);
 }
@@ -14,8 +14,12 @@
 
 #include <nix/Platform.hpp>
 #include <nix/Hydra.hpp>
+#include <nix/Arena.hpp>
 #include "H5Exception.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
 #include <string>
 #include <boost/optional.hpp>
 
@@ -34,14 +38,12 @@ public:
         : StringWriter(size, static_cast<pointer>(data)) { }
 
     StringWriter(const NDSize &size, pointer stringdata)
-            : nelms(size.nelms()), data(stringdata) {
-		size_t bs = nix::check::fits_in_size_t(nelms,
-                         "Cannot allocate storage (exceeds memory)");
-        buffer = new data_type[bs];
+            : nelms(size.nelms()), data(stringdata),
+              buffer(nix::check::fits_in_size_t(nelms, "Cannot allocate storage (exceeds memory)")) {
     }
 
     data_ptr operator*() {
-        return buffer;
+        return buffer.data();
     }
 
     void finish() {
@@ -50,14 +52,10 @@ public:
         }
     }
 
-    ~StringWriter() {
-        delete[] buffer;
-    }
-
 private:
     ndsize_t nelms;
     pointer  data;
-    data_ptr buffer;
+    ScratchBuffer<data_type> buffer;
 };
 
 class StringReader {
@@ -71,27 +69,93 @@ public:
         : StringReader(size, static_cast<pointer>(data)) { }
 
     StringReader(const NDSize &size, pointer stringdata)
-            : nelms(size.nelms()), data(stringdata) {
-		size_t bs = nix::check::fits_in_size_t(nelms,
-                         "Cannot allocate storage (exceeds memory)");
-        buffer = new data_type[bs];
-        for (ndsize_t i = 0; i < bs; i++) {
+            : nelms(size.nelms()), data(stringdata),
+              buffer(nix::check::fits_in_size_t(nelms, "Cannot allocate storage (exceeds memory)")) {
+        for (size_t i = 0; i < buffer.size(); i++) {
             buffer[i] = data[i].c_str();
         }
     }
 
     data_ptr operator*() {
-        return buffer;
+        return buffer.data();
+    }
+
+private:
+    ndsize_t   nelms;
+    pointer  data;
+    ScratchBuffer<data_type> buffer;
+};
+
+
+/**
+ * Copy str into the fixed length string of width bytes at dest,
+ * padding it with null bytes.
+ */
+inline void fixed_string_pack(char *dest, const std::string &str, size_t width) {
+    if (str.size() > width) {
+        throw std::invalid_argument("String '" + str + "' exceeds fixed length of " +
+                                    std::to_string(width) + " bytes");
     }
+    std::memcpy(dest, str.data(), str.size());
+    std::memset(dest + str.size(), 0, width - str.size());
+}
+
+inline std::string fixed_string_unpack(const char *src, size_t width) {
+    return std::string(src, std::find(src, src + width, '\0'));
+}
+
+/**
+ * Like StringWriter, but for fixed length strings of width bytes.
+ */
+class FixedStringWriter {
+public:
+    typedef std::string  value_type;
+    typedef value_type  *pointer;
 
-    ~StringReader() {
-        delete[] buffer;
+    FixedStringWriter(const NDSize &size, void *data, size_t width)
+            : nelms(size.nelms()), width(width), data(static_cast<pointer>(data)),
+              buffer(nix::check::fits_in_size_t(nelms * width, "Cannot allocate storage (exceeds memory)")) {
+    }
+
+    char *operator*() {
+        return buffer.data();
+    }
+
+    void finish() {
+        for (ndsize_t i = 0; i < nelms; i++) {
+            data[i] = fixed_string_unpack(buffer.data() + i * width, width);
+        }
     }
 
 private:
-    ndsize_t   nelms;
+    ndsize_t nelms;
+    size_t   width;
     pointer  data;
-    data_ptr buffer;
+    ScratchBuffer<char> buffer;
+};
+
+/**
+ * Like StringReader, but for fixed length strings of width bytes.
+ */
+class FixedStringReader {
+public:
+    typedef const std::string   value_type;
+    typedef value_type         *pointer;
+
+    FixedStringReader(const NDSize &size, const void *data, size_t width)
+            : buffer(nix::check::fits_in_size_t(size.nelms() * width, "Cannot allocate storage (exceeds memory)")) {
+        pointer strings = static_cast<pointer>(data);
+        for (size_t i = 0; i < size.nelms(); i++) {
+            fixed_string_pack(buffer.data() + i * width, strings[i], width);
+        }
+    }
+
+    char *operator*() {
+        return buffer.data();
+    }
+
+private:
+    ScratchBuffer<char> buffer;
 };
 
 
@@ -140,6 +204,8 @@ public:
 
     std::string name() const;
 
+    std::string fileName() const;
+
     H5I_type_t type() const;
 
     virtual void close();
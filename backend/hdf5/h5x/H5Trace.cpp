@@ -0,0 +1,40 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "H5Trace.hpp"
+
+#include <vector>
+
+namespace nix {
+namespace hdf5 {
+
+void TraceScope::finish() noexcept {
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    const uint64_t ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+
+    try {
+        ssize_t len = H5Fget_name(loc, nullptr, 0);
+        std::vector<char> file(len > 0 ? len + 1 : 1, '\0');
+        if (len > 0) {
+            H5Fget_name(loc, file.data(), file.size());
+        }
+
+        len = H5Iget_name(loc, nullptr, 0);
+        std::vector<char> entity(len > 0 ? len + 1 : 1, '\0');
+        if (len > 0) {
+            H5Iget_name(loc, entity.data(), entity.size());
+        }
+
+        IOTrace::record(file.data(), entity.data(), op, nbytes, ns);
+    } catch (...) {
+        // tracing must never fail the traced operation
+    }
+}
+
+} // namespace hdf5
+} // namespace nix
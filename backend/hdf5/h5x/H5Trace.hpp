@@ -0,0 +1,66 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_H5_TRACE_H
+#define NIX_H5_TRACE_H
+
+#include <nix/IOTrace.hpp>
+
+#include <hdf5.h>
+
+#include <chrono>
+
+namespace nix {
+namespace hdf5 {
+
+/**
+ * @brief Times the enclosing scope and records it with {@link IOTrace}
+ *        for the object loc, if tracing is enabled.
+ */
+class TraceScope {
+
+public:
+
+    TraceScope(IOOperation op, hid_t loc) : op(op), loc(loc), nbytes(0), active(IOTrace::enabled()) {
+        if (active) {
+            start = std::chrono::steady_clock::now();
+        }
+    }
+
+    TraceScope(const TraceScope &other) = delete;
+    TraceScope &operator=(const TraceScope &other) = delete;
+
+    bool isActive() const {
+        return active;
+    }
+
+    void bytes(ndsize_t n) {
+        nbytes = n;
+    }
+
+    ~TraceScope() {
+        if (active) {
+            finish();
+        }
+    }
+
+private:
+
+    void finish() noexcept;
+
+    IOOperation                           op;
+    hid_t                                 loc;
+    ndsize_t                              nbytes;
+    bool                                  active;
+    std::chrono::steady_clock::time_point start;
+};
+
+} // namespace hdf5
+} // namespace nix
+
+#endif // NIX_H5_TRACE_H
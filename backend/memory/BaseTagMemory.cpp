@@ -0,0 +1,146 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "BaseTagMemory.hpp"
+
+#include <nix/DataArray.hpp>
+#include "DataArrayMemory.hpp"
+#include "FeatureMemory.hpp"
+
+using namespace std;
+using namespace nix::base;
+
+namespace nix {
+namespace memory {
+
+
+BaseTagMemory::BaseTagMemory(const shared_ptr<FileMemory> &file, const shared_ptr<BlockNode> &block,
+                             const shared_ptr<BaseTagNode> &node)
+    : EntityWithSourcesMemory(file, block, node)
+{
+}
+
+
+shared_ptr<DataArrayNode> BaseTagMemory::findReference(const string &name_or_id) const {
+    shared_ptr<DataArrayNode> da = findNode(blockNode()->data_arrays, {name_or_id, ObjectType::DataArray});
+    return da && node<BaseTagNode>()->references.has(da->id) ? da : nullptr;
+}
+
+
+bool BaseTagMemory::hasReference(const string &name_or_id) const {
+    return findReference(name_or_id) != nullptr;
+}
+
+
+ndsize_t BaseTagMemory::referenceCount() const {
+    return node<BaseTagNode>()->references.size();
+}
+
+
+shared_ptr<IDataArray> BaseTagMemory::getReference(const string &name_or_id) const {
+    shared_ptr<DataArrayNode> da = findReference(name_or_id);
+    return da ? make_shared<DataArrayMemory>(file(), blockNode(), da) : nullptr;
+}
+
+
+shared_ptr<IDataArray> BaseTagMemory::getReference(ndsize_t index) const {
+    return make_shared<DataArrayMemory>(file(), blockNode(), node<BaseTagNode>()->references.at(index));
+}
+
+
+void BaseTagMemory::addReference(const string &name_or_id) {
+    shared_ptr<DataArrayNode> da = findNode(blockNode()->data_arrays, {name_or_id, ObjectType::DataArray});
+    if (!da) {
+        throw std::runtime_error("BaseTagMemory::addReference: DataArray not found in block!");
+    }
+    node<BaseTagNode>()->references.add(da);
+}
+
+
+bool BaseTagMemory::removeReference(const string &name_or_id) {
+    shared_ptr<DataArrayNode> da = findReference(name_or_id);
+    return da ? node<BaseTagNode>()->references.remove(da->id) : false;
+}
+
+
+void BaseTagMemory::references(const vector<DataArray> &refs_new) {
+    node<BaseTagNode>()->references.clear();
+
+    for (const auto &ref : refs_new) {
+        addReference(ref.id());
+    }
+}
+
+
+shared_ptr<FeatureNode> BaseTagMemory::findFeature(const string &name_or_id) const {
+    const NodeList<FeatureNode> &features = node<BaseTagNode>()->features;
+    shared_ptr<FeatureNode> feature = features.byId(name_or_id);
+    if (feature) {
+        return feature;
+    }
+
+    // a feature can also be found by the DataArray it links
+    for (const shared_ptr<FeatureNode> &feat : features.all()) {
+        shared_ptr<DataArrayNode> da = live(feat->data);
+        if (da && (da->name == name_or_id || da->id == name_or_id)) {
+            return feat;
+        }
+    }
+    return nullptr;
+}
+
+
+bool BaseTagMemory::hasFeature(const string &name_or_id) const {
+    return findFeature(name_or_id) != nullptr;
+}
+
+
+ndsize_t BaseTagMemory::featureCount() const {
+    return node<BaseTagNode>()->features.size();
+}
+
+
+shared_ptr<IFeature> BaseTagMemory::getFeature(const string &name_or_id) const {
+    shared_ptr<FeatureNode> feature = findFeature(name_or_id);
+    return feature ? make_shared<FeatureMemory>(file(), blockNode(), feature) : nullptr;
+}
+
+
+shared_ptr<IFeature> BaseTagMemory::getFeature(ndsize_t index) const {
+    return make_shared<FeatureMemory>(file(), blockNode(), node<BaseTagNode>()->features.at(index));
+}
+
+
+shared_ptr<IFeature> BaseTagMemory::createFeature(const string &name_or_id, LinkType link_type) {
+    shared_ptr<DataArrayNode> da = findNode(blockNode()->data_arrays, {name_or_id, ObjectType::DataArray});
+    if (!da) {
+        throw std::runtime_error("DataArray not found in Block!");
+    }
+
+    shared_ptr<FeatureNode> feature = makeNode(make_shared<FeatureNode>());
+    feature->link_type = link_type;
+    feature->data = da;
+    node<BaseTagNode>()->features.add(feature);
+    return make_shared<FeatureMemory>(file(), blockNode(), feature);
+}
+
+
+bool BaseTagMemory::deleteFeature(const string &name_or_id) {
+    shared_ptr<FeatureNode> feature = findFeature(name_or_id);
+    if (!feature) {
+        return false;
+    }
+    node<BaseTagNode>()->features.erase(feature);
+    return true;
+}
+
+
+BaseTagMemory::~BaseTagMemory() {}
+
+} // ns nix::memory
+} // ns nix
@@ -0,0 +1,93 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_BASETAG_MEMORY_H
+#define NIX_BASETAG_MEMORY_H
+
+#include "EntityWithSourcesMemory.hpp"
+#include <nix/base/IBaseTag.hpp>
+
+namespace nix {
+namespace memory {
+
+
+/**
+ * Class that represents a NIX tag.
+ */
+class BaseTagMemory : public EntityWithSourcesMemory, virtual public base::IBaseTag {
+
+public:
+
+    BaseTagMemory(const std::shared_ptr<FileMemory> &file, const std::shared_ptr<BlockNode> &block,
+                  const std::shared_ptr<BaseTagNode> &node);
+
+    //--------------------------------------------------
+    // Methods concerning references.
+    //--------------------------------------------------
+
+    virtual bool hasReference(const std::string &name_or_id) const;
+
+
+    virtual ndsize_t referenceCount() const;
+
+
+    virtual std::shared_ptr<base::IDataArray> getReference(const std::string &name_or_id) const;
+
+
+    virtual std::shared_ptr<base::IDataArray> getReference(ndsize_t index) const;
+
+
+    virtual void addReference(const std::string &name_or_id);
+
+
+    virtual bool removeReference(const std::string &name_or_id);
+
+
+    virtual void references(const std::vector<DataArray> &references);
+
+    //--------------------------------------------------
+    // Methods concerning features.
+    //--------------------------------------------------
+
+    virtual bool hasFeature(const std::string &name_or_id) const;
+
+
+    virtual ndsize_t featureCount() const;
+
+
+    virtual std::shared_ptr<base::IFeature> getFeature(const std::string &name_or_id) const;
+
+
+    virtual std::shared_ptr<base::IFeature> getFeature(ndsize_t index) const;
+
+
+    virtual std::shared_ptr<base::IFeature> createFeature(const std::string &name_or_id, LinkType link_type);
+
+
+    virtual bool deleteFeature(const std::string &name_or_id);
+
+    //--------------------------------------------------
+    // Other methods and functions
+    //--------------------------------------------------
+
+    virtual ~BaseTagMemory();
+
+private:
+
+    std::shared_ptr<DataArrayNode> findReference(const std::string &name_or_id) const;
+
+
+    std::shared_ptr<FeatureNode> findFeature(const std::string &name_or_id) const;
+
+};
+
+
+} // namespace memory
+} // namespace nix
+
+#endif // NIX_BASETAG_MEMORY_H
@@ -0,0 +1,368 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "BlockMemory.hpp"
+
+#include <nix/DataArray.hpp>
+#include "SourceMemory.hpp"
+#include "DataArrayMemory.hpp"
+#include "DataFrameMemory.hpp"
+#include "TagMemory.hpp"
+#include "MultiTagMemory.hpp"
+#include "GroupMemory.hpp"
+
+using namespace std;
+using namespace nix::base;
+
+namespace nix {
+namespace memory {
+
+namespace {
+
+template<typename H, typename T>
+shared_ptr<IEntity> make_entity(const shared_ptr<FileMemory> &file, const shared_ptr<BlockNode> &block,
+                                const shared_ptr<T> &node) {
+    return node ? make_shared<H>(file, block, node) : shared_ptr<H>();
+}
+
+
+template<typename T>
+void drop_all(const NodeList<T> &nodes) {
+    for (const shared_ptr<T> &node : nodes.all()) {
+        node->deleted = true;
+    }
+}
+
+} // namespace
+
+
+BlockMemory::BlockMemory(const shared_ptr<FileMemory> &file, const shared_ptr<BlockNode> &node)
+    : EntityWithMetadataMemory(file, node)
+{
+}
+
+
+string BlockMemory::resolveEntityId(const nix::Identity &ident) const {
+    if (!ident.id().empty()) {
+        return ident.id();
+    }
+
+    shared_ptr<IEntity> entity = getEntity(ident);
+    return entity ? entity->id() : "";
+}
+
+
+bool BlockMemory::hasEntity(const nix::Identity &ident) const {
+    return getEntity(ident) != nullptr;
+}
+
+
+shared_ptr<IEntity> BlockMemory::getEntity(const nix::Identity &ident) const {
+    shared_ptr<BlockNode> b = node<BlockNode>();
+
+    switch (ident.type()) {
+    case ObjectType::DataArray:
+        return make_entity<DataArrayMemory>(file(), b, findNode(b->data_arrays, ident));
+    case ObjectType::DataFrame:
+        return make_entity<DataFrameMemory>(file(), b, findNode(b->data_frames, ident));
+    case ObjectType::Tag:
+        return make_entity<TagMemory>(file(), b, findNode(b->tags, ident));
+    case ObjectType::MultiTag:
+        return make_entity<MultiTagMemory>(file(), b, findNode(b->multi_tags, ident));
+    case ObjectType::Group:
+        return make_entity<GroupMemory>(file(), b, findNode(b->groups, ident));
+    case ObjectType::Source:
+        return make_entity<SourceMemory>(file(), b, findNode(b->sources, ident));
+    default:
+        return shared_ptr<IEntity>();
+    }
+}
+
+
+shared_ptr<IEntity> BlockMemory::getEntity(ObjectType type, ndsize_t index) const {
+    shared_ptr<BlockNode> b = node<BlockNode>();
+
+    switch (type) {
+    case ObjectType::DataArray:
+        return make_entity<DataArrayMemory>(file(), b, b->data_arrays.at(index));
+    case ObjectType::DataFrame:
+        return make_entity<DataFrameMemory>(file(), b, b->data_frames.at(index));
+    case ObjectType::Tag:
+        return make_entity<TagMemory>(file(), b, b->tags.at(index));
+    case ObjectType::MultiTag:
+        return make_entity<MultiTagMemory>(file(), b, b->multi_tags.at(index));
+    case ObjectType::Group:
+        return make_entity<GroupMemory>(file(), b, b->groups.at(index));
+    case ObjectType::Source:
+        return make_entity<SourceMemory>(file(), b, b->sources.at(index));
+    default:
+        return shared_ptr<IEntity>();
+    }
+}
+
+
+ndsize_t BlockMemory::entityCount(ObjectType type) const {
+    shared_ptr<BlockNode> b = node<BlockNode>();
+
+    switch (type) {
+    case ObjectType::DataArray:
+        return b->data_arrays.size();
+    case ObjectType::DataFrame:
+        return b->data_frames.size();
+    case ObjectType::Tag:
+        return b->tags.size();
+    case ObjectType::MultiTag:
+        return b->multi_tags.size();
+    case ObjectType::Group:
+        return b->groups.size();
+    case ObjectType::Source:
+        return b->sources.size();
+    default:
+        return 0;
+    }
+}
+
+
+bool BlockMemory::removeEntity(const nix::Identity &ident) {
+    shared_ptr<BlockNode> b = node<BlockNode>();
+
+    // links to the entity go with it, as all links to an HDF5 group do
+    switch (ident.type()) {
+    case ObjectType::DataArray: {
+        shared_ptr<DataArrayNode> da = findNode(b->data_arrays, ident);
+        if (!da) {
+            return false;
+        }
+        for (const auto &tag : b->tags.all()) {
+            tag->references.remove(da->id);
+        }
+        for (const auto &tag : b->multi_tags.all()) {
+            tag->references.remove(da->id);
+        }
+        for (const auto &group : b->groups.all()) {
+            group->data_arrays.remove(da->id);
+        }
+        b->data_arrays.erase(da);
+        return true;
+    }
+
+    case ObjectType::DataFrame: {
+        shared_ptr<DataFrameNode> df = findNode(b->data_frames, ident);
+        if (!df) {
+            return false;
+        }
+        for (const auto &group : b->groups.all()) {
+            group->data_frames.remove(df->id);
+        }
+        b->data_frames.erase(df);
+        return true;
+    }
+
+    case ObjectType::Tag: {
+        shared_ptr<TagNode> tag = findNode(b->tags, ident);
+        if (!tag) {
+            return false;
+        }
+        for (const auto &group : b->groups.all()) {
+            group->tags.remove(tag->id);
+        }
+        drop_all(tag->features);
+        b->tags.erase(tag);
+        return true;
+    }
+
+    case ObjectType::MultiTag: {
+        shared_ptr<MultiTagNode> tag = findNode(b->multi_tags, ident);
+        if (!tag) {
+            return false;
+        }
+        for (const auto &group : b->groups.all()) {
+            group->multi_tags.remove(tag->id);
+        }
+        drop_all(tag->features);
+        b->multi_tags.erase(tag);
+        return true;
+    }
+
+    case ObjectType::Group: {
+        shared_ptr<GroupNode> group = findNode(b->groups, ident);
+        if (!group) {
+            return false;
+        }
+        b->groups.erase(group);
+        return true;
+    }
+
+    case ObjectType::Source: {
+        shared_ptr<SourceNode> source = findNode(b->sources, ident);
+        if (!source) {
+            return false;
+        }
+        dropSource(*b, source);
+        b->sources.erase(source);
+        return true;
+    }
+
+    default:
+        return false;
+    }
+}
+
+
+void BlockMemory::dropSource(BlockNode &block, const shared_ptr<SourceNode> &source) {
+    for (const auto &child : source->sources.all()) {
+        dropSource(block, child);
+    }
+
+    block.source_index.erase(source->id);
+    for (const auto &da : block.data_arrays.all()) {
+        da->sources.remove(source->id);
+    }
+    for (const auto &df : block.data_frames.all()) {
+        df->sources.remove(source->id);
+    }
+    for (const auto &tag : block.tags.all()) {
+        tag->sources.remove(source->id);
+    }
+    for (const auto &tag : block.multi_tags.all()) {
+        tag->sources.remove(source->id);
+    }
+    for (const auto &group : block.groups.all()) {
+        group->sources.remove(source->id);
+    }
+    source->deleted = true;
+}
+
+
+void BlockMemory::dropBlock(BlockNode &block) {
+    for (const auto &source : block.sources.all()) {
+        dropSource(block, source);
+    }
+    drop_all(block.data_arrays);
+    drop_all(block.data_frames);
+    for (const auto &tag : block.tags.all()) {
+        drop_all(tag->features);
+    }
+    drop_all(block.tags);
+    for (const auto &tag : block.multi_tags.all()) {
+        drop_all(tag->features);
+    }
+    drop_all(block.multi_tags);
+    drop_all(block.groups);
+    block.deleted = true;
+}
+
+
+shared_ptr<ISource> BlockMemory::createSource(const string &name, const string &type) {
+    shared_ptr<BlockNode> b = node<BlockNode>();
+    shared_ptr<SourceNode> source = makeNode<SourceNode>(name, type);
+    b->sources.add(source);
+    b->source_index[source->id] = source;
+    return make_shared<SourceMemory>(file(), b, source);
+}
+
+
+bool BlockMemory::deleteSource(const string &name_or_id) {
+    return removeEntity({name_or_id, ObjectType::Source});
+}
+
+
+Compression BlockMemory::compression(const Compression &compression) const {
+    return compression == Compression::Auto ? node<BlockNode>()->compression : compression;
+}
+
+
+shared_ptr<IDataArray> BlockMemory::createDataArray(const string &name,
+                                                    const string &type,
+                                                    nix::DataType data_type,
+                                                    const NDSize &shape,
+                                                    const Compression &compression,
+                                                    const StringStorage &strings) {
+    shared_ptr<BlockNode> b = node<BlockNode>();
+    shared_ptr<DataArrayNode> da = makeNode<DataArrayNode>(name, type);
+    auto array = make_shared<DataArrayMemory>(file(), b, da);
+
+    // the DataArray is only added once its data exist
+    array->createData(data_type, shape, this->compression(compression), strings);
+    b->data_arrays.add(da);
+    return array;
+}
+
+
+shared_ptr<IDataArray> BlockMemory::createVirtualDataArray(const string &name,
+                                                           const string &type,
+                                                           nix::DataType data_type,
+                                                           const NDSize &shape,
+                                                           const vector<VirtualSource> &sources) {
+    // fail before anything is created
+    const vector<VirtualSlab> slabs = DataArrayMemory::virtualSlabs(sources);
+
+    shared_ptr<BlockNode> b = node<BlockNode>();
+    shared_ptr<DataArrayNode> da = makeNode<DataArrayNode>(name, type);
+    auto array = make_shared<DataArrayMemory>(file(), b, da);
+
+    array->createVirtualData(data_type, shape, slabs);
+    b->data_arrays.add(da);
+    return array;
+}
+
+
+shared_ptr<IDataFrame> BlockMemory::createDataFrame(const string &name,
+                                                    const string &type,
+                                                    const vector<Column> &cols,
+                                                    const Compression &compression) {
+    shared_ptr<BlockNode> b = node<BlockNode>();
+    shared_ptr<DataFrameNode> df = makeNode<DataFrameNode>(name, type);
+    auto frame = make_shared<DataFrameMemory>(file(), b, df);
+
+    frame->createData(cols, this->compression(compression));
+    b->data_frames.add(df);
+    return frame;
+}
+
+
+shared_ptr<ITag> BlockMemory::createTag(const string &name, const string &type,
+                                        const vector<double> &position) {
+    shared_ptr<BlockNode> b = node<BlockNode>();
+    shared_ptr<TagNode> tag = makeNode<TagNode>(name, type);
+    tag->position = position;
+    b->tags.add(tag);
+    return make_shared<TagMemory>(file(), b, tag);
+}
+
+
+shared_ptr<IMultiTag> BlockMemory::createMultiTag(const string &name, const string &type,
+                                                  const DataArray &positions) {
+    shared_ptr<BlockNode> b = node<BlockNode>();
+    shared_ptr<MultiTagNode> tag = makeNode<MultiTagNode>(name, type);
+    auto mtag = make_shared<MultiTagMemory>(file(), b, tag);
+
+    // throws if the positions are not in this block
+    mtag->positions(positions.id());
+    b->multi_tags.add(tag);
+    return mtag;
+}
+
+
+shared_ptr<IGroup> BlockMemory::createGroup(const string &name, const string &type) {
+    shared_ptr<BlockNode> b = node<BlockNode>();
+    shared_ptr<GroupNode> group = makeNode<GroupNode>(name, type);
+    b->groups.add(group);
+    return make_shared<GroupMemory>(file(), b, group);
+}
+
+
+shared_ptr<IBlock> BlockMemory::block() const {
+    return make_shared<BlockMemory>(file(), node<BlockNode>());
+}
+
+
+BlockMemory::~BlockMemory() {}
+
+} // ns nix::memory
+} // ns nix
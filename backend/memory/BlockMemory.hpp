@@ -0,0 +1,134 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_BLOCK_MEMORY_H
+#define NIX_BLOCK_MEMORY_H
+
+#include <nix/base/IBlock.hpp>
+#include "EntityWithMetadataMemory.hpp"
+
+#include <vector>
+#include <string>
+
+namespace nix {
+namespace memory {
+
+/**
+ * Class that represents a NIX Block entity.
+ */
+class BlockMemory : virtual public base::IBlock, public EntityWithMetadataMemory {
+
+public:
+
+    BlockMemory(const std::shared_ptr<FileMemory> &file, const std::shared_ptr<BlockNode> &node);
+
+    //--------------------------------------------------
+    // Generic entity methods
+    //--------------------------------------------------
+
+    std::string resolveEntityId(const nix::Identity &ident) const;
+
+
+    bool hasEntity(const nix::Identity &ident) const;
+
+
+    std::shared_ptr<base::IEntity> getEntity(const nix::Identity &ident) const;
+
+
+    std::shared_ptr<base::IEntity> getEntity(ObjectType type, ndsize_t index) const;
+
+
+    ndsize_t entityCount(ObjectType type) const;
+
+
+    bool removeEntity(const nix::Identity &ident);
+
+    //--------------------------------------------------
+    // Methods concerning sources
+    //--------------------------------------------------
+
+    std::shared_ptr<base::ISource> createSource(const std::string &name, const std::string &type);
+
+
+    bool deleteSource(const std::string &name_or_id);
+
+    //--------------------------------------------------
+    // Methods concerning data arrays
+    //--------------------------------------------------
+
+    std::shared_ptr<base::IDataArray> createDataArray(const std::string &name, const std::string &type,
+                                                      nix::DataType data_type, const NDSize &shape,
+                                                      const Compression &compression,
+                                                      const StringStorage &strings);
+
+
+    std::shared_ptr<base::IDataArray> createVirtualDataArray(const std::string &name, const std::string &type,
+                                                             DataType data_type, const NDSize &shape,
+                                                             const std::vector<base::VirtualSource> &sources);
+
+    //--------------------------------------------------
+    // Methods concerning DataFrames
+    //--------------------------------------------------
+
+    std::shared_ptr<base::IDataFrame> createDataFrame(const std::string &name,
+                                                      const std::string &type,
+                                                      const std::vector<Column> &cols,
+                                                      const Compression &compression);
+
+    //--------------------------------------------------
+    // Methods concerning tags.
+    //--------------------------------------------------
+
+    std::shared_ptr<base::ITag> createTag(const std::string &name, const std::string &type,
+                                          const std::vector<double> &position);
+
+    //--------------------------------------------------
+    // Methods concerning multi tags.
+    //--------------------------------------------------
+
+    std::shared_ptr<base::IMultiTag> createMultiTag(const std::string &name, const std::string &type,
+                                                    const DataArray &positions);
+
+    //--------------------------------------------------
+    // Methods concerning groups.
+    //--------------------------------------------------
+
+    std::shared_ptr<base::IGroup> createGroup(const std::string &name, const std::string &type);
+
+    //--------------------------------------------------
+    // Other methods and functions
+    //--------------------------------------------------
+
+    /**
+     * Mark the source and its sub-sources deleted and unlink them from
+     * every entity of the block.
+     */
+    static void dropSource(BlockNode &block, const std::shared_ptr<SourceNode> &source);
+
+    /**
+     * Mark the block and everything it holds deleted.
+     */
+    static void dropBlock(BlockNode &block);
+
+
+    virtual ~BlockMemory();
+
+
+    std::shared_ptr<base::IBlock> block() const;
+
+private:
+
+    Compression compression(const Compression &compression) const;
+
+};
+
+
+} // namespace memory
+} // namespace nix
+
+#endif // NIX_BLOCK_MEMORY_H
@@ -0,0 +1,749 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "ConvertMemory.hpp"
+
+#include <nix/base/IBlock.hpp>
+#include <nix/base/ISection.hpp>
+#include <nix/base/IProperty.hpp>
+#include <nix/base/IDataArray.hpp>
+#include <nix/base/IDataFrame.hpp>
+#include <nix/base/ITag.hpp>
+#include <nix/base/IMultiTag.hpp>
+#include <nix/base/IGroup.hpp>
+#include <nix/base/ISource.hpp>
+#include <nix/DataArray.hpp>
+#include <nix/util/util.hpp>
+
+#include "FileMemory.hpp"
+#include "DataArrayMemory.hpp"
+#include "DataFrameMemory.hpp"
+#include "PropertyMemory.hpp"
+#include "hdf5/FileHDF5.hpp"
+#include "hdf5/EntityHDF5.hpp"
+#include "hdf5/FeatureHDF5.hpp"
+
+#include <utility>
+
+using namespace std;
+using namespace nix::base;
+
+namespace nix {
+namespace memory {
+
+namespace {
+
+//--------------------------------------------------
+// Helpers for both directions
+//--------------------------------------------------
+
+/*
+ * Copy all data of src to dst, which has the same type and extent.
+ */
+void copy_data(const IDataArray &src, IDataArray &dst) {
+    NDSize extent = src.dataExtent();
+    ndsize_t nelms = extent.size() == 0 ? 0 : extent.nelms();
+    if (nelms == 0) {
+        return;
+    }
+
+    NDSize offset(extent.size(), 0);
+    size_t n = check::fits_in_size_t(nelms, "copy_data: data too large to copy");
+    DataType dtype = src.dataType();
+    if (dtype == DataType::String) {
+        vector<string> buffer(n);
+        src.read(dtype, buffer.data(), extent, offset);
+        dst.write(dtype, buffer.data(), extent, offset);
+    } else {
+        vector<char> buffer(n * data_type_to_size(dtype));
+        src.read(dtype, buffer.data(), extent, offset);
+        dst.write(dtype, buffer.data(), extent, offset);
+    }
+}
+
+
+/*
+ * Copy the envelopes of src to dst.
+ */
+void copy_envelopes(const IDataArray &src, IDataArray &dst) {
+    ndsize_t factor = src.envelopeFactor();
+    if (factor == 0) {
+        return;
+    }
+
+    dst.envelopeFactor(factor);
+    for (size_t level = 0; src.envelopeSize(level) > 0; level++) {
+        ndsize_t size = src.envelopeSize(level);
+        vector<double> buffer(check::fits_in_size_t(size * 3, "copy_envelopes: envelope too large to copy"));
+        src.readEnvelope(level, buffer.data(), size, 0);
+        dst.envelopeSize(level, size);
+        dst.writeEnvelope(level, buffer.data(), size, 0);
+    }
+}
+
+
+/*
+ * Copy the rows of src to dst, which has the same columns.
+ */
+void copy_frame(const IDataFrame &src, IDataFrame &dst) {
+    ndsize_t rows = src.rows();
+    dst.rows(rows);
+    if (rows == 0) {
+        return;
+    }
+
+    size_t n = check::fits_in_size_t(rows, "copy_frame: DataFrame too large to copy");
+    for (const Column &col : src.columns()) {
+        if (col.dtype == DataType::String) {
+            vector<string> buffer(n);
+            src.readColumn(col.name, 0, rows, col.dtype, buffer.data());
+            dst.writeColumn(col.name, 0, rows, col.dtype, buffer.data());
+        } else {
+            vector<char> buffer(n * data_type_to_size(col.dtype));
+            src.readColumn(col.name, 0, rows, col.dtype, buffer.data());
+            dst.writeColumn(col.name, 0, rows, col.dtype, buffer.data());
+        }
+    }
+}
+
+//--------------------------------------------------
+// Reading a file into memory
+//--------------------------------------------------
+
+void load_named(const INamedEntity &src, NamedNode &node) {
+    node.id = src.id();
+    node.name = src.name();
+    node.type = src.type();
+    node.definition = src.definition();
+}
+
+
+/*
+ * Set last, as filling a node through a handle touches the times.
+ */
+void load_times(const IEntity &src, EntityNode &node) {
+    node.created_at = src.createdAt();
+    node.updated_at = src.updatedAt();
+}
+
+
+void load_metadata(const IEntityWithMetadata &src, MetadataNode &node, const FileMemory &file) {
+    shared_ptr<ISection> metadata = src.metadata();
+    if (metadata) {
+        node.metadata = file.findSection(metadata->id());
+    }
+}
+
+
+void load_sources(const IEntityWithSources &src, SourcesNode &node, const BlockNode &block) {
+    for (size_t i = 0; i < src.sourceCount(); i++) {
+        auto it = block.source_index.find(src.getSource(i)->id());
+        shared_ptr<SourceNode> source = it == block.source_index.end() ? nullptr : live(it->second);
+        if (source) {
+            node.sources.add(source);
+        }
+    }
+}
+
+
+shared_ptr<PropertyNode> load_property(const IProperty &src, const shared_ptr<FileMemory> &file) {
+    auto property = make_shared<PropertyNode>(src.dataType(), StringStorage());
+    property->id = src.id();
+    property->name = src.name();
+    property->definition = src.definition();
+    property->unit = src.unit();
+    property->uncertainty = src.uncertainty();
+
+    PropertyMemory handle(file, property);
+    handle.values(src.values());
+
+    load_times(src, *property);
+    return property;
+}
+
+
+shared_ptr<SectionNode> load_section(const ISection &src, const shared_ptr<SectionNode> &parent,
+                                     const shared_ptr<FileMemory> &file) {
+    auto section = make_shared<SectionNode>();
+    load_named(src, *section);
+    section->repository = src.repository();
+    section->parent = parent;
+
+    for (ndsize_t i = 0; i < src.propertyCount(); i++) {
+        section->properties.add(load_property(*src.getProperty(i), file));
+    }
+    for (ndsize_t i = 0; i < src.sectionCount(); i++) {
+        section->sections.add(load_section(*src.getSection(i), section, file));
+    }
+
+    file->indexSection(section);
+    load_times(src, *section);
+    return section;
+}
+
+
+/*
+ * Links may point anywhere in the file, so they are set once every
+ * section is read in.
+ */
+void load_links(const ISection &src, const FileMemory &file) {
+    shared_ptr<ISection> link = src.link();
+    if (link) {
+        file.findSection(src.id())->link = file.findSection(link->id());
+    }
+    for (ndsize_t i = 0; i < src.sectionCount(); i++) {
+        load_links(*src.getSection(i), file);
+    }
+}
+
+
+shared_ptr<SourceNode> load_source(const ISource &src, BlockNode &block, const FileMemory &file) {
+    auto source = make_shared<SourceNode>();
+    load_named(src, *source);
+    load_metadata(src, *source, file);
+
+    for (ndsize_t i = 0; i < src.sourceCount(); i++) {
+        source->sources.add(load_source(*src.getSource(i), block, file));
+    }
+
+    block.source_index[source->id] = source;
+    load_times(src, *source);
+    return source;
+}
+
+
+shared_ptr<DimensionNode> load_dimension(const IDimension &src, const shared_ptr<DataArrayNode> &array) {
+    auto dim = make_shared<DimensionNode>(src.dimensionType());
+
+    switch (src.dimensionType()) {
+        case DimensionType::Sample: {
+            auto &sampled = dynamic_cast<const ISampledDimension &>(src);
+            dim->label = sampled.label();
+            dim->unit = sampled.unit();
+            dim->sampling_interval = sampled.samplingInterval();
+            dim->offset = sampled.offset();
+            break;
+        }
+        case DimensionType::Set: {
+            auto &set = dynamic_cast<const ISetDimension &>(src);
+            dim->labels = set.labels();
+            break;
+        }
+        case DimensionType::Range: {
+            auto &range = dynamic_cast<const IRangeDimension &>(src);
+            if (range.alias()) {
+                dim->alias = array;
+            } else {
+                dim->label = range.label();
+                dim->unit = range.unit();
+                dim->ticks = range.ticks();
+            }
+            break;
+        }
+    }
+
+    return dim;
+}
+
+
+shared_ptr<DataArrayNode> load_data_array(const IDataArray &src, const shared_ptr<FileMemory> &file,
+                                          const shared_ptr<BlockNode> &block) {
+    auto array = make_shared<DataArrayNode>();
+    load_named(src, *array);
+    load_metadata(src, *array, *file);
+    load_sources(src, *array, *block);
+
+    array->label = src.label();
+    array->unit = src.unit();
+    array->expansion_origin = src.expansionOrigin();
+    array->polynom = src.polynomCoefficients();
+
+    // virtual arrays are read in as copies of their data
+    DataArrayMemory handle(file, block, array);
+    handle.createData(src.dataType(), src.dataExtent(), block->compression, src.stringStorage());
+    copy_data(src, handle);
+    copy_envelopes(src, handle);
+
+    for (ndsize_t i = 1; i <= src.dimensionCount(); i++) {
+        array->dimensions.push_back(load_dimension(*src.getDimension(i), array));
+    }
+
+    load_times(src, *array);
+    return array;
+}
+
+
+shared_ptr<DataFrameNode> load_data_frame(const IDataFrame &src, const shared_ptr<FileMemory> &file,
+                                          const shared_ptr<BlockNode> &block) {
+    auto frame = make_shared<DataFrameNode>();
+    load_named(src, *frame);
+    load_metadata(src, *frame, *file);
+    load_sources(src, *frame, *block);
+
+    DataFrameMemory handle(file, block, frame);
+    handle.createData(src.columns(), block->compression);
+    copy_frame(src, handle);
+
+    load_times(src, *frame);
+    return frame;
+}
+
+
+void load_base_tag(const IBaseTag &src, BaseTagNode &tag, const shared_ptr<FileMemory> &file, const BlockNode &block) {
+    load_named(src, tag);
+    load_metadata(src, tag, *file);
+    load_sources(src, tag, block);
+
+    for (ndsize_t i = 0; i < src.referenceCount(); i++) {
+        shared_ptr<DataArrayNode> array = block.data_arrays.byId(src.getReference(i)->id());
+        if (array) {
+            tag.references.add(array);
+        }
+    }
+
+    for (ndsize_t i = 0; i < src.featureCount(); i++) {
+        shared_ptr<IFeature> feature = src.getFeature(i);
+        auto node = make_shared<FeatureNode>();
+        node->id = feature->id();
+        node->link_type = feature->linkType();
+
+        shared_ptr<IDataArray> data = feature->data();
+        if (data) {
+            node->data = block.data_arrays.byId(data->id());
+        }
+
+        load_times(*feature, *node);
+        tag.features.add(node);
+    }
+}
+
+
+shared_ptr<TagNode> load_tag(const ITag &src, const shared_ptr<FileMemory> &file, const BlockNode &block) {
+    auto tag = make_shared<TagNode>();
+    load_base_tag(src, *tag, file, block);
+
+    tag->position = src.position();
+    tag->extent = src.extent();
+    tag->units = src.units();
+
+    load_times(src, *tag);
+    return tag;
+}
+
+
+shared_ptr<MultiTagNode> load_multi_tag(const IMultiTag &src, const shared_ptr<FileMemory> &file,
+                                        const BlockNode &block) {
+    auto tag = make_shared<MultiTagNode>();
+    load_base_tag(src, *tag, file, block);
+
+    if (src.hasPositions()) {
+        tag->positions = block.data_arrays.byId(src.positions()->id());
+    }
+    shared_ptr<IDataArray> extents = src.extents();
+    if (extents) {
+        tag->extents = block.data_arrays.byId(extents->id());
+    }
+    tag->units = src.units();
+
+    load_times(src, *tag);
+    return tag;
+}
+
+
+template<typename T>
+void load_refs(const IGroup &src, ObjectType type, const NodeList<T> &nodes, RefList<T> &refs) {
+    for (ndsize_t i = 0; i < src.entityCount(type); i++) {
+        shared_ptr<T> node = nodes.byId(src.getEntity(type, i)->id());
+        if (node) {
+            refs.add(node);
+        }
+    }
+}
+
+
+shared_ptr<GroupNode> load_group(const IGroup &src, const shared_ptr<FileMemory> &file, const BlockNode &block) {
+    auto group = make_shared<GroupNode>();
+    load_named(src, *group);
+    load_metadata(src, *group, *file);
+    load_sources(src, *group, block);
+
+    load_refs(src, ObjectType::DataArray, block.data_arrays, group->data_arrays);
+    load_refs(src, ObjectType::DataFrame, block.data_frames, group->data_frames);
+    load_refs(src, ObjectType::Tag, block.tags, group->tags);
+    load_refs(src, ObjectType::MultiTag, block.multi_tags, group->multi_tags);
+
+    load_times(src, *group);
+    return group;
+}
+
+
+shared_ptr<BlockNode> load_block(const IBlock &src, const shared_ptr<FileMemory> &file) {
+    auto block = make_shared<BlockNode>();
+    load_named(src, *block);
+    load_metadata(src, *block, *file);
+    block->compression = file->compression();
+
+    for (ndsize_t i = 0; i < src.entityCount(ObjectType::Source); i++) {
+        block->sources.add(load_source(*src.getEntity<ISource>(i), *block, *file));
+    }
+    for (ndsize_t i = 0; i < src.entityCount(ObjectType::DataArray); i++) {
+        block->data_arrays.add(load_data_array(*src.getEntity<IDataArray>(i), file, block));
+    }
+    for (ndsize_t i = 0; i < src.entityCount(ObjectType::DataFrame); i++) {
+        block->data_frames.add(load_data_frame(*src.getEntity<IDataFrame>(i), file, block));
+    }
+    for (ndsize_t i = 0; i < src.entityCount(ObjectType::Tag); i++) {
+        block->tags.add(load_tag(*src.getEntity<ITag>(i), file, *block));
+    }
+    for (ndsize_t i = 0; i < src.entityCount(ObjectType::MultiTag); i++) {
+        block->multi_tags.add(load_multi_tag(*src.getEntity<IMultiTag>(i), file, *block));
+    }
+    for (ndsize_t i = 0; i < src.entityCount(ObjectType::Group); i++) {
+        block->groups.add(load_group(*src.getEntity<IGroup>(i), file, *block));
+    }
+
+    load_times(src, *block);
+    return block;
+}
+
+//--------------------------------------------------
+// Writing a file out as HDF5
+//--------------------------------------------------
+
+/*
+ * Writes one file; the HDF5 backend sets ids and times itself, they are
+ * overwritten right after creation and, for the times of last change,
+ * once everything is written.
+ */
+class Saver {
+
+private:
+
+    shared_ptr<hdf5::FileHDF5>                                   file;
+    vector<pair<hdf5::LocID, time_t>>                            updated;
+    // links may point anywhere in the file, they are set once every section is written
+    vector<pair<shared_ptr<ISection>, string>>                   linked;
+
+public:
+
+    explicit Saver(const shared_ptr<hdf5::FileHDF5> &file) : file(file) {}
+
+
+    void save(const IFile &src) {
+        for (ndsize_t i = 0; i < src.sectionCount(); i++) {
+            shared_ptr<ISection> section = src.getSection(i);
+            saveSection(*section, file->createSection(section->name(), section->type()));
+        }
+        for (const auto &pair : linked) {
+            pair.first->link(pair.second);
+        }
+        for (ndsize_t i = 0; i < src.blockCount(); i++) {
+            shared_ptr<IBlock> block = src.getBlock(i);
+            saveBlock(*block, file->createBlock(block->name(), block->type()));
+        }
+
+        for (const auto &stamp : updated) {
+            stamp.first.setAttr("updated_at", util::timeToStr(stamp.second));
+        }
+        file->forceCreatedAt(src.createdAt());
+        file->forceValidatedAt(src.validatedAt());
+    }
+
+private:
+
+    static hdf5::H5Group group(const shared_ptr<IEntity> &entity) {
+        return dynamic_pointer_cast<hdf5::EntityHDF5>(entity)->group();
+    }
+
+
+    void stamp(const hdf5::LocID &obj, const IEntity &src) {
+        obj.setAttr("entity_id", src.id());
+        obj.setAttr("created_at", util::timeToStr(src.createdAt()));
+        updated.emplace_back(obj, src.updatedAt());
+    }
+
+
+    void saveNamed(const INamedEntity &src, const shared_ptr<INamedEntity> &dst) {
+        stamp(group(dst), src);
+        if (src.definition()) {
+            dst->definition(*src.definition());
+        }
+    }
+
+
+    void saveMetadata(const IEntityWithMetadata &src, const shared_ptr<IEntityWithMetadata> &dst) {
+        saveNamed(src, dst);
+        shared_ptr<ISection> metadata = src.metadata();
+        if (metadata) {
+            dst->metadata(metadata->id());
+        }
+    }
+
+
+    void saveSources(const IEntityWithSources &src, const shared_ptr<IEntityWithSources> &dst) {
+        saveMetadata(src, dst);
+        for (size_t i = 0; i < src.sourceCount(); i++) {
+            dst->addSource(src.getSource(i)->id());
+        }
+    }
+
+
+    void saveSection(const ISection &src, const shared_ptr<ISection> &dst) {
+        saveNamed(src, dst);
+        if (src.repository()) {
+            dst->repository(*src.repository());
+        }
+        shared_ptr<ISection> link = src.link();
+        if (link) {
+            linked.emplace_back(dst, link->id());
+        }
+
+        for (ndsize_t i = 0; i < src.propertyCount(); i++) {
+            saveProperty(*src.getProperty(i), dst);
+        }
+        for (ndsize_t i = 0; i < src.sectionCount(); i++) {
+            shared_ptr<ISection> section = src.getSection(i);
+            saveSection(*section, dst->createSection(section->name(), section->type()));
+        }
+    }
+
+
+    void saveProperty(const IProperty &src, const shared_ptr<ISection> &section) {
+        const PropertyMemory *memory = dynamic_cast<const PropertyMemory *>(&src);
+        StringStorage strings = memory ? memory->stringStorage() : StringStorage();
+
+        shared_ptr<IProperty> dst = section->createProperty(src.name(), src.dataType(), strings);
+        stamp(group(section).openGroup("properties", false).openData(src.name()), src);
+        if (src.definition()) {
+            dst->definition(*src.definition());
+        }
+        if (src.unit()) {
+            dst->unit(*src.unit());
+        }
+        if (src.uncertainty()) {
+            dst->uncertainty(*src.uncertainty());
+        }
+        if (src.valueCount() > 0) {
+            dst->values(src.values());
+        }
+    }
+
+
+    void saveSource(const ISource &src, const shared_ptr<ISource> &dst) {
+        saveMetadata(src, dst);
+        for (ndsize_t i = 0; i < src.sourceCount(); i++) {
+            shared_ptr<ISource> source = src.getSource(i);
+            saveSource(*source, dst->createSource(source->name(), source->type()));
+        }
+    }
+
+
+    void saveDimension(const IDimension &src, const shared_ptr<IDataArray> &array) {
+        ndsize_t index = src.index();
+
+        switch (src.dimensionType()) {
+            case DimensionType::Sample: {
+                auto &sampled = dynamic_cast<const ISampledDimension &>(src);
+                auto dim = array->createSampledDimension(index, sampled.samplingInterval());
+                if (sampled.label()) {
+                    dim->label(*sampled.label());
+                }
+                if (sampled.unit()) {
+                    dim->unit(*sampled.unit());
+                }
+                if (sampled.offset()) {
+                    dim->offset(*sampled.offset());
+                }
+                break;
+            }
+            case DimensionType::Set: {
+                auto &set = dynamic_cast<const ISetDimension &>(src);
+                auto dim = array->createSetDimension(index);
+                vector<string> labels = set.labels();
+                if (!labels.empty()) {
+                    dim->labels(labels);
+                }
+                break;
+            }
+            case DimensionType::Range: {
+                auto &range = dynamic_cast<const IRangeDimension &>(src);
+                if (range.alias()) {
+                    array->createAliasRangeDimension();
+                    break;
+                }
+                auto dim = array->createRangeDimension(index, range.ticks());
+                if (range.label()) {
+                    dim->label(*range.label());
+                }
+                if (range.unit()) {
+                    dim->unit(*range.unit());
+                }
+                break;
+            }
+        }
+    }
+
+
+    void saveDataArray(const IDataArray &src, const shared_ptr<IBlock> &block) {
+        shared_ptr<IDataArray> dst = block->createDataArray(src.name(), src.type(), src.dataType(), src.dataExtent(),
+                                                            Compression::Auto, src.stringStorage());
+        saveSources(src, dst);
+
+        if (src.label()) {
+            dst->label(*src.label());
+        }
+        if (src.unit()) {
+            dst->unit(*src.unit());
+        }
+        if (src.expansionOrigin()) {
+            dst->expansionOrigin(*src.expansionOrigin());
+        }
+        vector<double> polynom = src.polynomCoefficients();
+        if (!polynom.empty()) {
+            dst->polynomCoefficients(polynom, Compression::Auto);
+        }
+
+        copy_data(src, *dst);
+        copy_envelopes(src, *dst);
+        for (ndsize_t i = 1; i <= src.dimensionCount(); i++) {
+            saveDimension(*src.getDimension(i), dst);
+        }
+    }
+
+
+    void saveDataFrame(const IDataFrame &src, const shared_ptr<IBlock> &block) {
+        shared_ptr<IDataFrame> dst = block->createDataFrame(src.name(), src.type(), src.columns(), Compression::Auto);
+        saveSources(src, dst);
+        copy_frame(src, *dst);
+    }
+
+
+    void saveBaseTag(const IBaseTag &src, const shared_ptr<IBaseTag> &dst, const shared_ptr<IBlock> &block) {
+        saveSources(src, dst);
+
+        for (ndsize_t i = 0; i < src.referenceCount(); i++) {
+            dst->addReference(src.getReference(i)->id());
+        }
+
+        // features keep their ids, which name their groups
+        for (ndsize_t i = 0; i < src.featureCount(); i++) {
+            shared_ptr<IFeature> feature = src.getFeature(i);
+            shared_ptr<IDataArray> data = feature->data();
+            if (!data) {
+                continue;
+            }
+
+            hdf5::H5Group fgroup = group(dst).openGroup("features", true).openGroup(feature->id(), true);
+            DataArray target = block->getEntity<IDataArray>(data->name());
+            make_shared<hdf5::FeatureHDF5>(file, block, fgroup, feature->id(), target, feature->linkType(),
+                                           feature->createdAt());
+            updated.emplace_back(fgroup, feature->updatedAt());
+        }
+    }
+
+
+    void saveTag(const ITag &src, const shared_ptr<IBlock> &block) {
+        shared_ptr<ITag> dst = block->createTag(src.name(), src.type(), src.position());
+        saveBaseTag(src, dst, block);
+
+        vector<double> extent = src.extent();
+        if (!extent.empty()) {
+            dst->extent(extent);
+        }
+        vector<string> units = src.units();
+        if (!units.empty()) {
+            dst->units(units);
+        }
+    }
+
+
+    void saveMultiTag(const IMultiTag &src, const shared_ptr<IBlock> &block) {
+        // a MultiTag without positions can not be written
+        if (!src.hasPositions()) {
+            return;
+        }
+
+        DataArray positions = block->getEntity<IDataArray>(src.positions()->name());
+        shared_ptr<IMultiTag> dst = block->createMultiTag(src.name(), src.type(), positions);
+        saveBaseTag(src, dst, block);
+
+        shared_ptr<IDataArray> extents = src.extents();
+        if (extents) {
+            dst->extents(extents->id());
+        }
+        vector<string> units = src.units();
+        if (!units.empty()) {
+            dst->units(units);
+        }
+    }
+
+
+    void saveGroup(const IGroup &src, const shared_ptr<IBlock> &block) {
+        shared_ptr<IGroup> dst = block->createGroup(src.name(), src.type());
+        saveSources(src, dst);
+
+        for (ObjectType type : {ObjectType::DataArray, ObjectType::DataFrame, ObjectType::Tag, ObjectType::MultiTag}) {
+            for (ndsize_t i = 0; i < src.entityCount(type); i++) {
+                dst->addEntity({src.getEntity(type, i)->id(), type});
+            }
+        }
+    }
+
+
+    void saveBlock(const IBlock &src, const shared_ptr<IBlock> &dst) {
+        saveMetadata(src, dst);
+
+        for (ndsize_t i = 0; i < src.entityCount(ObjectType::Source); i++) {
+            shared_ptr<ISource> source = src.getEntity<ISource>(i);
+            saveSource(*source, dst->createSource(source->name(), source->type()));
+        }
+        for (ndsize_t i = 0; i < src.entityCount(ObjectType::DataArray); i++) {
+            saveDataArray(*src.getEntity<IDataArray>(i), dst);
+        }
+        for (ndsize_t i = 0; i < src.entityCount(ObjectType::DataFrame); i++) {
+            saveDataFrame(*src.getEntity<IDataFrame>(i), dst);
+        }
+        for (ndsize_t i = 0; i < src.entityCount(ObjectType::Tag); i++) {
+            saveTag(*src.getEntity<ITag>(i), dst);
+        }
+        for (ndsize_t i = 0; i < src.entityCount(ObjectType::MultiTag); i++) {
+            saveMultiTag(*src.getEntity<IMultiTag>(i), dst);
+        }
+        for (ndsize_t i = 0; i < src.entityCount(ObjectType::Group); i++) {
+            saveGroup(*src.getEntity<IGroup>(i), dst);
+        }
+    }
+
+};
+
+} // anonymous namespace
+
+
+void loadFile(const IFile &source, const shared_ptr<FileMemory> &target) {
+    for (ndsize_t i = 0; i < source.sectionCount(); i++) {
+        target->addSection(load_section(*source.getSection(i), nullptr, target));
+    }
+    for (ndsize_t i = 0; i < source.sectionCount(); i++) {
+        load_links(*source.getSection(i), *target);
+    }
+    for (ndsize_t i = 0; i < source.blockCount(); i++) {
+        target->addBlock(load_block(*source.getBlock(i), target));
+    }
+
+    target->forceCreatedAt(source.createdAt());
+    target->forceValidatedAt(source.validatedAt());
+}
+
+
+void saveFile(const IFile &source, const shared_ptr<hdf5::FileHDF5> &target) {
+    Saver saver(target);
+    saver.save(source);
+}
+
+} // ns nix::memory
+} // ns nix
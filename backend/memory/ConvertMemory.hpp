@@ -0,0 +1,41 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_CONVERT_MEMORY_H
+#define NIX_CONVERT_MEMORY_H
+
+#include <nix/base/IFile.hpp>
+
+#include <memory>
+
+namespace nix {
+
+namespace hdf5 {
+class FileHDF5;
+}
+
+namespace memory {
+
+class FileMemory;
+
+/**
+ * Read every entity of source into the empty file target, keeping ids
+ * and times. Virtual DataArrays are read in as copies of their data.
+ */
+void loadFile(const base::IFile &source, const std::shared_ptr<FileMemory> &target);
+
+/**
+ * Write every entity of source into the new HDF5 file target, keeping
+ * ids and times.
+ */
+void saveFile(const base::IFile &source, const std::shared_ptr<hdf5::FileHDF5> &target);
+
+} // namespace memory
+} // namespace nix
+
+#endif // NIX_CONVERT_MEMORY_H
@@ -0,0 +1,580 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "DataArrayMemory.hpp"
+
+#include <nix/util/util.hpp>
+#include "DimensionMemory.hpp"
+#include "FileMemory.hpp"
+
+#include <algorithm>
+
+using namespace std;
+using namespace nix::base;
+
+namespace nix {
+namespace memory {
+
+// each envelope entry holds min, max and mean
+static const ndsize_t ENVELOPE_WIDTH = 3;
+
+
+/*
+ * A virtual DataArray holds no data; reads and writes go to the boxes of
+ * the DataArrays it maps, which may be virtual themselves. Elements no
+ * box maps read as 0 and are dropped on writes.
+ */
+
+static bool has_data(const DataArrayNode &node) {
+    return node.data || node.is_virtual;
+}
+
+
+static NDSize data_extent(const DataArrayNode &node) {
+    return node.data ? node.data->extent() : node.virtual_extent;
+}
+
+
+static DataType data_type(const DataArrayNode &node) {
+    return node.data ? node.data->dataType() : node.virtual_dtype;
+}
+
+
+// n elements of dtype, strings as std::string
+class Scratch {
+
+private:
+
+    vector<string>             strings;
+    vector<NDArray::byte_type> bytes;
+
+public:
+
+    Scratch(DataType dtype, ndsize_t n) {
+        const size_t count = check::fits_in_size_t(n, "Cannot allocate storage (exceeds memory)");
+        if (dtype == DataType::String) {
+            strings.resize(count);
+        } else {
+            bytes.resize(count * data_type_to_size(dtype));
+        }
+    }
+
+    void *data() {
+        return strings.empty() ? static_cast<void *>(bytes.data()) : static_cast<void *>(strings.data());
+    }
+
+};
+
+
+// the part of the box (count, offset) a slab maps
+static bool intersect(const VirtualSlab &slab, const NDSize &count, const NDSize &offset,
+                      NDSize &n, NDSize &source_offset, NDSize &box_offset) {
+    const size_t rank = count.size();
+    n = source_offset = box_offset = NDSize(rank, 0);
+    for (size_t d = 0; d < rank; d++) {
+        const ndsize_t lo = max(slab.offset[d], offset[d]);
+        const ndsize_t hi = min(slab.offset[d] + slab.count[d], offset[d] + count[d]);
+        if (lo >= hi) {
+            return false;
+        }
+        n[d] = hi - lo;
+        source_offset[d] = slab.source_offset[d] + lo - slab.offset[d];
+        box_offset[d] = lo - offset[d];
+    }
+    return rank > 0;
+}
+
+
+static void read_box(const DataArrayNode &node, DataType dtype, void *data, const NDSize &count, const NDSize &offset);
+
+
+static DataStore virtual_box(const DataArrayNode &node, DataType dtype, const NDSize &count, const NDSize &offset) {
+    NDSize box_count, box_offset;
+    DataStore::box(node.virtual_extent, count, offset, box_count, box_offset);
+
+    DataStore box(dtype, box_count);
+    for (const VirtualSlab &slab : node.slabs) {
+        NDSize n, source_offset, part_offset;
+        if (slab.source->deleted || !has_data(*slab.source) ||
+            !intersect(slab, box_count, box_offset, n, source_offset, part_offset)) {
+            continue;
+        }
+        Scratch part(dtype, n.nelms());
+        read_box(*slab.source, dtype, part.data(), n, source_offset);
+        box.write(dtype, part.data(), n, part_offset);
+    }
+    return box;
+}
+
+
+static void read_box(const DataArrayNode &node, DataType dtype, void *data, const NDSize &count, const NDSize &offset) {
+    if (node.data) {
+        node.data->read(dtype, data, count, offset);
+    } else {
+        virtual_box(node, dtype, count, offset).read(dtype, data, {}, {});
+    }
+}
+
+
+static void write_box(DataArrayNode &node, DataType dtype, const void *data, const NDSize &count, const NDSize &offset) {
+    if (node.data) {
+        node.data->write(dtype, data, count, offset);
+        return;
+    }
+
+    NDSize box_count, box_offset;
+    DataStore::box(node.virtual_extent, count, offset, box_count, box_offset);
+
+    DataStore box(dtype, box_count);
+    box.write(dtype, data, {}, {});
+    for (const VirtualSlab &slab : node.slabs) {
+        NDSize n, source_offset, part_offset;
+        if (slab.source->deleted || !has_data(*slab.source) ||
+            !intersect(slab, box_count, box_offset, n, source_offset, part_offset)) {
+            continue;
+        }
+        Scratch part(dtype, n.nelms());
+        box.read(dtype, part.data(), n, part_offset);
+        write_box(*slab.source, dtype, part.data(), n, source_offset);
+    }
+}
+
+
+DataArrayMemory::DataArrayMemory(const shared_ptr<FileMemory> &file, const shared_ptr<BlockNode> &block,
+                                 const shared_ptr<DataArrayNode> &node)
+    : EntityWithSourcesMemory(file, block, node)
+{
+}
+
+//--------------------------------------------------
+// Element getters and setters
+//--------------------------------------------------
+
+boost::optional<string> DataArrayMemory::label() const {
+    return node<DataArrayNode>()->label;
+}
+
+
+void DataArrayMemory::label(const string &label) {
+    node<DataArrayNode>()->label = label;
+    forceUpdatedAt();
+}
+
+
+void DataArrayMemory::label(const none_t t) {
+    node<DataArrayNode>()->label = boost::none;
+    forceUpdatedAt();
+}
+
+
+boost::optional<string> DataArrayMemory::unit() const {
+    return node<DataArrayNode>()->unit;
+}
+
+
+void DataArrayMemory::unit(const string &unit) {
+    node<DataArrayNode>()->unit = unit;
+    forceUpdatedAt();
+}
+
+
+void DataArrayMemory::unit(const none_t t) {
+    node<DataArrayNode>()->unit = boost::none;
+    forceUpdatedAt();
+}
+
+
+boost::optional<double> DataArrayMemory::expansionOrigin() const {
+    return node<DataArrayNode>()->expansion_origin;
+}
+
+
+void DataArrayMemory::expansionOrigin(double expansion_origin) {
+    node<DataArrayNode>()->expansion_origin = expansion_origin;
+    forceUpdatedAt();
+}
+
+
+void DataArrayMemory::expansionOrigin(const none_t t) {
+    node<DataArrayNode>()->expansion_origin = boost::none;
+    forceUpdatedAt();
+}
+
+
+vector<double> DataArrayMemory::polynomCoefficients() const {
+    return node<DataArrayNode>()->polynom;
+}
+
+
+void DataArrayMemory::polynomCoefficients(const vector<double> &coefficients, const Compression &compression) {
+    node<DataArrayNode>()->polynom = coefficients;
+    forceUpdatedAt();
+}
+
+
+void DataArrayMemory::polynomCoefficients(const none_t t) {
+    node<DataArrayNode>()->polynom.clear();
+    forceUpdatedAt();
+}
+
+//--------------------------------------------------
+// Methods concerning dimensions
+//--------------------------------------------------
+
+
+ndsize_t DataArrayMemory::dimensionCount() const {
+    return node<DataArrayNode>()->dimensions.size();
+}
+
+
+shared_ptr<IDimension> DataArrayMemory::getDimension(ndsize_t index) const {
+    const auto &dimensions = node<DataArrayNode>()->dimensions;
+    if (index == 0 || index > dimensions.size()) {
+        return nullptr;
+    }
+    return openDimensionMemory(dimensions[static_cast<size_t>(index - 1)], index);
+}
+
+
+shared_ptr<ISetDimension> DataArrayMemory::createSetDimension(ndsize_t index) {
+    return make_shared<SetDimensionMemory>(createDimensionNode(index, DimensionType::Set), index);
+}
+
+
+shared_ptr<IRangeDimension> DataArrayMemory::createRangeDimension(ndsize_t index, const vector<double> &ticks) {
+    shared_ptr<DimensionNode> dim = createDimensionNode(index, DimensionType::Range);
+    dim->ticks = ticks;
+    return make_shared<RangeDimensionMemory>(dim, index);
+}
+
+
+shared_ptr<IRangeDimension> DataArrayMemory::createAliasRangeDimension() {
+    shared_ptr<DimensionNode> dim = createDimensionNode(1, DimensionType::Range);
+    dim->alias = node<DataArrayNode>();
+    return make_shared<RangeDimensionMemory>(dim, 1);
+}
+
+
+shared_ptr<ISampledDimension> DataArrayMemory::createSampledDimension(ndsize_t index, double sampling_interval) {
+    shared_ptr<DimensionNode> dim = createDimensionNode(index, DimensionType::Sample);
+    dim->sampling_interval = sampling_interval;
+    return make_shared<SampledDimensionMemory>(dim, index);
+}
+
+
+shared_ptr<DimensionNode> DataArrayMemory::createDimensionNode(ndsize_t index, DimensionType type) {
+    auto &dimensions = node<DataArrayNode>()->dimensions;
+
+    ndsize_t dim_max = dimensions.size() + 1;
+    if (index > dim_max || index <= 0)
+        throw runtime_error("Invalid dimension index: has to be 0 < index <= " + util::numToStr(dim_max));
+
+    auto dim = make_shared<DimensionNode>(type);
+    if (index == dim_max) {
+        dimensions.push_back(dim);
+    } else {
+        dimensions[static_cast<size_t>(index - 1)] = dim;
+    }
+
+    forceUpdatedAt();
+    return dim;
+}
+
+
+bool DataArrayMemory::deleteDimensions() {
+    node<DataArrayNode>()->dimensions.clear();
+    forceUpdatedAt();
+    return true;
+}
+
+//--------------------------------------------------
+// Other methods and functions
+//--------------------------------------------------
+
+
+DataArrayMemory::~DataArrayMemory() {
+}
+
+
+void DataArrayMemory::createData(DataType dtype, const NDSize &size, const Compression &compression) {
+    createData(dtype, size, compression, StringStorage());
+}
+
+
+void DataArrayMemory::createData(DataType dtype, const NDSize &size, const Compression &compression,
+                                 const StringStorage &strings) {
+    auto da = node<DataArrayNode>();
+    if (has_data(*da)) {
+        throw ConsistencyError("DataArray's data already exists!");
+    }
+
+    da->data.reset(new DataStore(dtype, size, dtype == DataType::String ? strings : StringStorage()));
+    da->compression = compression;
+}
+
+
+vector<VirtualSlab> DataArrayMemory::virtualSlabs(const vector<VirtualSource> &sources) {
+    vector<VirtualSlab> slabs;
+    for (const VirtualSource &source : sources) {
+        auto array = dynamic_pointer_cast<DataArrayMemory>(source.array);
+        if (!array) {
+            throw std::invalid_argument("DataArray: virtual data can only map DataArrays of the memory backend");
+        }
+        if (!array->hasData()) {
+            throw ConsistencyError("DataArray with missing data");
+        }
+        if (array->stringStorage().mode == StringStorage::Mode::Dictionary) {
+            throw std::invalid_argument("DataArray: dictionary encoded data cannot be mapped");
+        }
+
+        slabs.push_back(VirtualSlab {array->node<DataArrayNode>(), source.count, source.source_offset, source.offset});
+    }
+    return slabs;
+}
+
+
+void DataArrayMemory::createVirtualData(DataType dtype, const NDSize &size, const vector<VirtualSlab> &slabs) {
+    auto da = node<DataArrayNode>();
+    if (has_data(*da)) {
+        throw ConsistencyError("DataArray's data already exists!");
+    }
+
+    da->is_virtual = true;
+    da->virtual_dtype = slabs.empty() ? dtype : data_type(*slabs[0].source);
+    da->virtual_extent = size;
+    da->slabs = slabs;
+}
+
+
+bool DataArrayMemory::hasData() const {
+    return has_data(*node<DataArrayNode>());
+}
+
+
+void DataArrayMemory::checkAccess(DataType dtype, const char *what) const {
+    if (!hasData()) {
+        throw ConsistencyError("DataArray with missing data");
+    }
+    if (dtype != DataType::String && stringStorage().mode == StringStorage::Mode::Dictionary) {
+        throw std::invalid_argument(string("DataArray: dictionary encoded data can only be ") + what + " as strings");
+    }
+}
+
+
+void DataArrayMemory::trace(IOOperation op, DataType dtype, ndsize_t nelms,
+                            chrono::steady_clock::time_point start) const {
+    const auto elapsed = chrono::steady_clock::now() - start;
+    const uint64_t ns = static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(elapsed).count());
+    const string entity = "/data/" + blockNode()->name + "/data_arrays/" + name() + "/data";
+    IOTrace::record(file()->location(), entity, op, nelms * data_type_to_size(dtype), ns);
+}
+
+
+void DataArrayMemory::write(DataType dtype, const void *data, const NDSize &count, const NDSize &offset) {
+    checkAccess(dtype, "written");
+
+    const auto start = chrono::steady_clock::now();
+    write_box(*node<DataArrayNode>(), dtype, data, count, offset);
+    if (IOTrace::enabled()) {
+        trace(IOOperation::DataWrite, dtype, count ? count.nelms() : (offset ? 1 : dataExtent().nelms()), start);
+    }
+}
+
+
+void DataArrayMemory::writeParallel(DataType dtype, const void *data, const NDSize &count, const NDSize &offset,
+                                    size_t nthreads) {
+    // copying the data is bound by memory, not by the cores
+    write(dtype, data, count, offset);
+}
+
+
+void DataArrayMemory::read(DataType dtype, void *data, const NDSize &count, const NDSize &offset) const {
+    checkAccess(dtype, "read");
+
+    const auto start = chrono::steady_clock::now();
+    read_box(*node<DataArrayNode>(), dtype, data, count, offset);
+    if (IOTrace::enabled()) {
+        trace(IOOperation::DataRead, dtype, count ? count.nelms() : (offset ? 1 : dataExtent().nelms()), start);
+    }
+}
+
+
+void DataArrayMemory::read(DataType dtype, void *data, const Selection &selection) const {
+    checkAccess(dtype, "read");
+
+    const NDSize extent = dataExtent();
+    const ndsize_t nelms = selection.shape(extent).nelms();
+    if (nelms == 0) {
+        return;
+    }
+
+    const auto start = chrono::steady_clock::now();
+    const vector<Selection::Run> runs = selection.runs(extent);
+    auto da = node<DataArrayNode>();
+    if (da->data) {
+        da->data->read(dtype, data, runs);
+    } else {
+        virtual_box(*da, dtype, {}, {}).read(dtype, data, runs);
+    }
+    if (IOTrace::enabled()) {
+        trace(IOOperation::DataRead, dtype, nelms, start);
+    }
+}
+
+
+void DataArrayMemory::readParallel(DataType dtype, void *buffer, const NDSize &count, const NDSize &offset,
+                                   size_t nthreads) const {
+    read(dtype, buffer, count, offset);
+}
+
+
+NDSize DataArrayMemory::dataExtent(void) const {
+    return data_extent(*node<DataArrayNode>());
+}
+
+
+void DataArrayMemory::dataExtent(const NDSize &extent) {
+    auto da = node<DataArrayNode>();
+    if (!has_data(*da)) {
+        throw runtime_error("Data field not found in DataArray!");
+    }
+
+    if (data_extent(*da) == extent) {
+        return;
+    }
+    if (da->data) {
+        da->data->extent(extent);
+    } else {
+        if (extent.size() != da->virtual_extent.size()) {
+            throw InvalidRank("Cannot change the rank of data");
+        }
+        da->virtual_extent = extent;
+    }
+
+    // appends resize in quick succession, stamp at most once a second
+    const time_t now = util::getTime();
+    if (now != da->extent_stamped) {
+        forceUpdatedAt();
+        da->extent_stamped = now;
+    }
+}
+
+
+DataType DataArrayMemory::dataType(void) const {
+    return data_type(*node<DataArrayNode>());
+}
+
+
+NDSize DataArrayMemory::dataChunks(void) const {
+    // the data is one contiguous block
+    return NDSize{};
+}
+
+
+ndsize_t DataArrayMemory::dataStorageSize(void) const {
+    auto da = node<DataArrayNode>();
+    return da->data ? da->data->storageSize() : 0;
+}
+
+
+StorageLayout DataArrayMemory::dataLayout(void) const {
+    auto da = node<DataArrayNode>();
+    StorageLayout layout;
+    if (da->data) {
+        layout.shape = da->data->extent();
+        layout.element_size = da->data->elementSize();
+        layout.storage_size = da->data->storageSize();
+    } else if (da->is_virtual) {
+        layout.shape = da->virtual_extent;
+        layout.element_size = data_type_to_size(da->virtual_dtype);
+        layout.virtual_sources = da->slabs.size();
+    }
+    return layout;
+}
+
+
+StringStorage DataArrayMemory::stringStorage(void) const {
+    auto da = node<DataArrayNode>();
+    return da->data ? da->data->stringStorage() : StringStorage();
+}
+
+
+vector<string> DataArrayMemory::stringDictionary(void) const {
+    if (stringStorage().mode != StringStorage::Mode::Dictionary) {
+        return vector<string>();
+    }
+    return node<DataArrayNode>()->data->dictionary();
+}
+
+
+void DataArrayMemory::readStringCodes(uint32_t *codes, const NDSize &count, const NDSize &offset) const {
+    if (stringStorage().mode != StringStorage::Mode::Dictionary) {
+        throw std::invalid_argument("DataArray: data are not dictionary encoded");
+    }
+    node<DataArrayNode>()->data->readCodes(codes, count, offset);
+}
+
+//--------------------------------------------------
+// Methods concerning data envelopes
+//--------------------------------------------------
+
+ndsize_t DataArrayMemory::envelopeFactor() const {
+    return node<DataArrayNode>()->envelope_factor;
+}
+
+
+void DataArrayMemory::envelopeFactor(ndsize_t factor) {
+    auto da = node<DataArrayNode>();
+    da->envelopes.clear();
+    da->envelope_factor = factor;
+}
+
+
+ndsize_t DataArrayMemory::envelopeSize(size_t level) const {
+    const auto &envelopes = node<DataArrayNode>()->envelopes;
+    return level < envelopes.size() ? envelopes[level].size() / ENVELOPE_WIDTH : 0;
+}
+
+
+void DataArrayMemory::envelopeSize(size_t level, ndsize_t size) {
+    auto da = node<DataArrayNode>();
+    if (da->envelope_factor == 0) {
+        throw ConsistencyError("DataArray has no envelopes");
+    }
+
+    if (level >= da->envelopes.size()) {
+        if (size == 0) {
+            return;
+        }
+        da->envelopes.resize(level + 1);
+    }
+    da->envelopes[level].resize(check::fits_in_size_t(size * ENVELOPE_WIDTH, "Cannot allocate storage (exceeds memory)"));
+}
+
+
+void DataArrayMemory::readEnvelope(size_t level, double *data, ndsize_t count, ndsize_t offset) const {
+    const ndsize_t size = envelopeSize(level);
+    if (offset + count > size) {
+        throw OutOfBounds("Trying to access envelope outside of range", offset + count);
+    }
+    const double *first = node<DataArrayNode>()->envelopes[level].data() + offset * ENVELOPE_WIDTH;
+    copy(first, first + count * ENVELOPE_WIDTH, data);
+}
+
+
+void DataArrayMemory::writeEnvelope(size_t level, const double *data, ndsize_t count, ndsize_t offset) {
+    const ndsize_t size = envelopeSize(level);
+    if (offset + count > size) {
+        throw OutOfBounds("Trying to access envelope outside of range", offset + count);
+    }
+    double *first = node<DataArrayNode>()->envelopes[level].data() + offset * ENVELOPE_WIDTH;
+    copy(data, data + count * ENVELOPE_WIDTH, first);
+}
+
+} // ns nix::memory
+} // ns nix
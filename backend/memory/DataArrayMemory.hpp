@@ -0,0 +1,209 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_DATA_ARRAY_MEMORY_H
+#define NIX_DATA_ARRAY_MEMORY_H
+
+#include <nix/base/IDataArray.hpp>
+#include <nix/IOTrace.hpp>
+#include "EntityWithSourcesMemory.hpp"
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace nix {
+namespace memory {
+
+
+/**
+ * A DataArray whose data is one contiguous DataStore in memory.
+ */
+class DataArrayMemory : virtual public base::IDataArray, public EntityWithSourcesMemory {
+
+public:
+
+    DataArrayMemory(const std::shared_ptr<FileMemory> &file, const std::shared_ptr<BlockNode> &block,
+                    const std::shared_ptr<DataArrayNode> &node);
+
+    //--------------------------------------------------
+    // Element getters and setters
+    //--------------------------------------------------
+
+
+    boost::optional<std::string> label() const;
+
+
+    void label(const std::string &label);
+
+
+    void label(const none_t t);
+
+
+    boost::optional<std::string> unit() const;
+
+
+    void unit(const std::string &unit);
+
+
+    void unit(const none_t t);
+
+
+    boost::optional<double> expansionOrigin() const;
+
+
+    void expansionOrigin(double expansion_origin);
+
+
+    void expansionOrigin(const none_t t);
+
+
+    std::vector<double> polynomCoefficients() const;
+
+
+    void polynomCoefficients(const std::vector<double> &polynom_coefficients, const Compression &compression);
+
+
+    void polynomCoefficients(const none_t t);
+
+    //--------------------------------------------------
+    // Methods concerning dimensions
+    //--------------------------------------------------
+
+
+    ndsize_t dimensionCount() const;
+
+
+    std::shared_ptr<base::IDimension> getDimension(ndsize_t index) const;
+
+
+    std::shared_ptr<base::ISetDimension> createSetDimension(ndsize_t index);
+
+
+    std::shared_ptr<base::IRangeDimension> createRangeDimension(ndsize_t index, const std::vector<double> &ticks);
+
+
+    std::shared_ptr<base::IRangeDimension> createAliasRangeDimension();
+
+
+    std::shared_ptr<base::ISampledDimension> createSampledDimension(ndsize_t index, double sampling_interval);
+
+
+    bool deleteDimensions();
+
+    //--------------------------------------------------
+    // Other methods and functions
+    //--------------------------------------------------
+
+
+    virtual ~DataArrayMemory();
+
+
+    void createData(DataType dtype, const NDSize &size, const Compression &compression);
+
+
+    void createData(DataType dtype, const NDSize &size, const Compression &compression,
+                    const StringStorage &strings);
+
+    /**
+     * The boxes of other DataArrays a virtual DataArray maps; throws
+     * before anything is created if a source cannot be mapped.
+     */
+    static std::vector<VirtualSlab> virtualSlabs(const std::vector<base::VirtualSource> &sources);
+
+
+    void createVirtualData(DataType dtype, const NDSize &size, const std::vector<VirtualSlab> &slabs);
+
+
+    bool hasData() const;
+
+
+    void write(DataType dtype, const void *data, const NDSize &count, const NDSize &offset);
+
+
+    void writeParallel(DataType dtype, const void *data, const NDSize &count, const NDSize &offset,
+                       size_t nthreads);
+
+
+    void read(DataType dtype, void *buffer, const NDSize &count, const NDSize &offset) const;
+
+
+    void read(DataType dtype, void *buffer, const Selection &selection) const;
+
+
+    void readParallel(DataType dtype, void *buffer, const NDSize &count, const NDSize &offset,
+                      size_t nthreads) const;
+
+
+    NDSize dataExtent(void) const;
+
+
+    void dataExtent(const NDSize &extent);
+
+
+    DataType dataType(void) const;
+
+
+    NDSize dataChunks(void) const;
+
+
+    ndsize_t dataStorageSize(void) const;
+
+
+    StorageLayout dataLayout(void) const;
+
+
+    StringStorage stringStorage(void) const;
+
+
+    std::vector<std::string> stringDictionary(void) const;
+
+
+    void readStringCodes(uint32_t *codes, const NDSize &count, const NDSize &offset) const;
+
+    //--------------------------------------------------
+    // Methods concerning data envelopes
+    //--------------------------------------------------
+
+
+    ndsize_t envelopeFactor() const;
+
+
+    void envelopeFactor(ndsize_t factor);
+
+
+    ndsize_t envelopeSize(size_t level) const;
+
+
+    void envelopeSize(size_t level, ndsize_t size);
+
+
+    void readEnvelope(size_t level, double *data, ndsize_t count, ndsize_t offset) const;
+
+
+    void writeEnvelope(size_t level, const double *data, ndsize_t count, ndsize_t offset);
+
+private:
+
+    std::shared_ptr<DimensionNode> createDimensionNode(ndsize_t index, DimensionType type);
+
+
+    void checkAccess(DataType dtype, const char *what) const;
+
+
+    void trace(IOOperation op, DataType dtype, ndsize_t nelms,
+               std::chrono::steady_clock::time_point start) const;
+
+};
+
+
+} // namespace memory
+} // namespace nix
+
+#endif // NIX_DATA_ARRAY_MEMORY_H
@@ -0,0 +1,219 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "DataFrameMemory.hpp"
+
+#include <nix/Exception.hpp>
+
+using namespace std;
+using namespace nix::base;
+
+namespace nix {
+namespace memory {
+
+
+DataFrameMemory::DataFrameMemory(const shared_ptr<FileMemory> &file, const shared_ptr<BlockNode> &block,
+                                 const shared_ptr<DataFrameNode> &node)
+    : EntityWithSourcesMemory(file, block, node)
+{
+}
+
+
+void DataFrameMemory::createData(const vector<Column> &cols, const Compression &compression) {
+    auto df = node<DataFrameNode>();
+    if (!df->columns.empty()) {
+        throw ConsistencyError("DataFrame's data already exists!");
+    }
+
+    for (unsigned i = 0; i < cols.size(); i++) {
+        Column col = cols[i];
+        if (col.dtype != DataType::String) {
+            col.strings = StringStorage();
+        }
+        df->cells.emplace_back(col.dtype, NDSize {0}, col.strings);
+        df->col_index[col.name] = i;
+        df->columns.push_back(col);
+    }
+    df->compression = compression;
+}
+
+
+vector<Column> DataFrameMemory::columns() const {
+    return node<DataFrameNode>()->columns;
+}
+
+
+unsigned DataFrameMemory::colIndex(const string &name) const {
+    auto df = node<DataFrameNode>();
+    auto it = df->col_index.find(name);
+    if (it == df->col_index.end()) {
+        throw std::invalid_argument("DataFrame: no column named " + name);
+    }
+    return it->second;
+}
+
+
+string DataFrameMemory::colName(unsigned col) const {
+    auto df = node<DataFrameNode>();
+    if (col >= df->columns.size()) {
+        throw OutOfBounds("DataFrame: no column at given index", col);
+    }
+    return df->columns[col].name;
+}
+
+
+vector<unsigned> DataFrameMemory::colIndex(const vector<string> &names) const {
+    vector<unsigned> cols(names.size());
+    for (size_t i = 0; i < names.size(); i++) {
+        cols[i] = colIndex(names[i]);
+    }
+    return cols;
+}
+
+
+vector<string> DataFrameMemory::colName(const vector<unsigned> &cols) const {
+    vector<string> names(cols.size());
+    for (size_t i = 0; i < cols.size(); i++) {
+        names[i] = colName(cols[i]);
+    }
+    return names;
+}
+
+
+ndsize_t DataFrameMemory::rows() const {
+    return node<DataFrameNode>()->rows;
+}
+
+
+void DataFrameMemory::rows(ndsize_t n) {
+    auto df = node<DataFrameNode>();
+    for (DataStore &cells : df->cells) {
+        cells.extent({n});
+    }
+    df->rows = n;
+}
+
+
+StorageLayout DataFrameMemory::dataLayout() const {
+    auto df = node<DataFrameNode>();
+    StorageLayout layout;
+    layout.shape = {df->rows};
+    for (const DataStore &cells : df->cells) {
+        layout.element_size += cells.elementSize();
+        layout.storage_size += cells.storageSize();
+    }
+    return layout;
+}
+
+
+const DataStore &DataFrameMemory::column(unsigned col) const {
+    auto df = node<DataFrameNode>();
+    if (col >= df->cells.size()) {
+        throw OutOfBounds("DataFrame: no column at given index", col);
+    }
+    return df->cells[col];
+}
+
+
+void DataFrameMemory::checkColumn(unsigned col, DataType dtype) const {
+    const DataStore &cells = column(col);
+    if (cells.stringStorage().mode == StringStorage::Mode::Dictionary && dtype != DataType::String) {
+        throw std::invalid_argument("DataFrame: dictionary encoded column " + colName(col) + " only holds strings");
+    }
+}
+
+
+vector<Variant> DataFrameMemory::encode(const vector<unsigned> &cols, const vector<Variant> &values) const {
+    vector<Variant> encoded(values.size());
+    for (size_t i = 0; i < values.size(); i++) {
+        const DataStore &cells = column(cols[i]);
+        checkColumn(cols[i], values[i].type());
+
+        DataStore cell(cells.dataType(), {1}, cells.stringStorage());
+        cell.values({values[i]}, 0);
+        encoded[i] = cell.values(0, 1)[0];
+    }
+    return encoded;
+}
+
+
+vector<Variant> DataFrameMemory::readRow(ndsize_t row) const {
+    auto df = node<DataFrameNode>();
+    vector<Variant> res(df->cells.size());
+    for (size_t i = 0; i < res.size(); i++) {
+        res[i] = df->cells[i].values(row, 1)[0];
+    }
+    return res;
+}
+
+
+void DataFrameMemory::writeRow(ndsize_t row, const vector<Variant> &vals) {
+    auto df = node<DataFrameNode>();
+    vector<unsigned> cols(vals.size());
+    for (unsigned i = 0; i < cols.size(); i++) {
+        cols[i] = i;
+    }
+
+    const vector<Variant> encoded = encode(cols, vals);
+    for (size_t i = 0; i < encoded.size(); i++) {
+        df->cells[cols[i]].values({encoded[i]}, row);
+    }
+}
+
+
+vector<Cell> DataFrameMemory::readCells(ndsize_t row, const vector<string> &names) const {
+    auto df = node<DataFrameNode>();
+    vector<Cell> res(names.size());
+    for (size_t i = 0; i < names.size(); i++) {
+        const unsigned col = colIndex(names[i]);
+        res[i] = Cell(names[i], df->cells[col].values(row, 1)[0]);
+        res[i].col = static_cast<int>(i);
+    }
+    return res;
+}
+
+
+void DataFrameMemory::writeCells(ndsize_t row, const vector<Cell> &cells) {
+    auto df = node<DataFrameNode>();
+    vector<unsigned> cols(cells.size());
+    vector<Variant> vals(cells.size());
+    for (size_t i = 0; i < cells.size(); i++) {
+        cols[i] = cells[i].haveName() ? colIndex(cells[i].name) : static_cast<unsigned>(cells[i].col);
+        vals[i] = cells[i];
+    }
+
+    const vector<Variant> encoded = encode(cols, vals);
+    for (size_t i = 0; i < encoded.size(); i++) {
+        df->cells[cols[i]].values({encoded[i]}, row);
+    }
+}
+
+
+void DataFrameMemory::writeColumn(const string &name,
+                                  ndsize_t offset,
+                                  ndsize_t count,
+                                  DataType dtype,
+                                  const void *data) {
+    const unsigned col = colIndex(name);
+    checkColumn(col, dtype);
+    node<DataFrameNode>()->cells[col].write(dtype, data, {count}, {offset});
+}
+
+
+void DataFrameMemory::readColumn(const string &name,
+                                 ndsize_t offset,
+                                 ndsize_t count,
+                                 DataType dtype,
+                                 void *data) const {
+    const unsigned col = colIndex(name);
+    checkColumn(col, dtype);
+    column(col).read(dtype, data, {count}, {offset});
+}
+
+} // namespace memory
+} // namespace nix
@@ -0,0 +1,80 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_DATA_FRAME_MEMORY_H
+#define NIX_DATA_FRAME_MEMORY_H
+
+#include <nix/base/IDataFrame.hpp>
+#include "EntityWithSourcesMemory.hpp"
+
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace nix {
+namespace memory {
+
+/**
+ * A DataFrame kept column by column, one DataStore per column.
+ */
+class DataFrameMemory : virtual public base::IDataFrame, public EntityWithSourcesMemory {
+
+public:
+
+    DataFrameMemory(const std::shared_ptr<FileMemory> &file, const std::shared_ptr<BlockNode> &block,
+                    const std::shared_ptr<DataFrameNode> &node);
+
+
+    void createData(const std::vector<Column> &cols, const Compression &compression);
+
+    std::vector<Column> columns() const override;
+
+    unsigned colIndex(const std::string &name) const override;
+    std::string colName(unsigned col) const override;
+
+    std::vector<unsigned> colIndex(const std::vector<std::string> &names) const override;
+    std::vector<std::string> colName(const std::vector<unsigned> &cols) const override;
+
+    ndsize_t rows() const override;
+    void rows(ndsize_t n) override;
+
+    StorageLayout dataLayout() const override;
+
+    std::vector<Variant> readRow(ndsize_t row) const override;
+    void writeRow(ndsize_t row, const std::vector<Variant> &v) override;
+
+    std::vector<Cell> readCells(ndsize_t row, const std::vector<std::string> &names) const override;
+    void writeCells(ndsize_t row, const std::vector<Cell> &cells) override;
+
+    void readColumn(const std::string &name,
+                    ndsize_t offset,
+                    ndsize_t count,
+                    DataType dtype,
+                    void *data) const override;
+
+    void writeColumn(const std::string &name,
+                     ndsize_t offset,
+                     ndsize_t count,
+                     DataType dtype,
+                     const void *data) override;
+
+private:
+
+    const DataStore &column(unsigned col) const;
+
+    // the values as stored in the columns, checked before any is written
+    std::vector<Variant> encode(const std::vector<unsigned> &cols, const std::vector<Variant> &values) const;
+
+    void checkColumn(unsigned col, DataType dtype) const;
+
+};
+
+} // namespace memory
+} // namespace nix
+
+#endif // NIX_DATA_FRAME_MEMORY_H
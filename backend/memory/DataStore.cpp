@@ -0,0 +1,503 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "DataStore.hpp"
+
+#include <nix/Exception.hpp>
+#include "hdf5/h5x/H5DataType.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+namespace nix {
+namespace memory {
+
+
+// element-wise conversion in place, data holds n elements of the larger type
+static void convert(DataType source, DataType destination, void *data, size_t n) {
+    hdf5::h5x::DataType h5_src = hdf5::data_type_to_h5_memtype(source);
+    hdf5::h5x::DataType h5_dst = hdf5::data_type_to_h5_memtype(destination);
+    hdf5::HErr res = H5Tconvert(h5_src.h5id(), h5_dst.h5id(), n, data, nullptr, H5P_DEFAULT);
+    res.check("Could not convert data");
+}
+
+
+static std::vector<size_t> strides_of(const NDSize &shape) {
+    std::vector<size_t> strides(shape.size(), 1);
+    for (size_t d = shape.size(); d > 1; d--) {
+        strides[d - 2] = strides[d - 1] * static_cast<size_t>(shape[d - 1]);
+    }
+    return strides;
+}
+
+
+DataStore::DataStore(DataType dtype, const NDSize &extent, const StringStorage &strings)
+    : dtype(dtype), strings(strings), shape(extent),
+      numbers(dtype == DataType::String ? DataType::UInt32 : dtype,
+             dtype == DataType::String && strings.mode != StringStorage::Mode::Dictionary ? NDSize{0} : extent)
+{
+    if (isText()) {
+        texts.resize(check::fits_in_size_t(extent.nelms(), "Cannot allocate storage (exceeds memory)"));
+    } else if (dtype == DataType::String) {
+        // code 0 is the empty string, the fill value of the codes
+        encode("");
+    }
+}
+
+
+DataType DataStore::storedType() const {
+    return dtype == DataType::String ? DataType::UInt32 : dtype;
+}
+
+
+size_t DataStore::elementSize() const {
+    if (isText()) {
+        return strings.mode == StringStorage::Mode::Fixed ? strings.length : data_type_to_size(DataType::String);
+    }
+    return data_type_to_size(storedType());
+}
+
+
+ndsize_t DataStore::storageSize() const {
+    if (isText() && strings.mode == StringStorage::Mode::Variable) {
+        ndsize_t size = 0;
+        for (const std::string &str : texts) {
+            size += str.size();
+        }
+        return size;
+    }
+    return shape.nelms() * elementSize();
+}
+
+
+void DataStore::extent(const NDSize &extent) {
+    if (extent.size() != shape.size()) {
+        throw InvalidRank("Cannot change the rank of data");
+    }
+    if (extent == shape) {
+        return;
+    }
+
+    // copy the runs along the last dimension both extents have in common
+    const size_t rank = shape.size();
+    NDSize common(rank, 0);
+    for (size_t d = 0; d < rank; d++) {
+        common[d] = std::min(shape[d], extent[d]);
+    }
+
+    const std::vector<size_t> from = strides_of(shape), to = strides_of(extent);
+    auto for_each_run = [&](std::function<void(size_t, size_t, size_t)> copy) {
+        if (common.nelms() == 0) {
+            return;
+        }
+        const size_t length = static_cast<size_t>(common[rank - 1]);
+        std::vector<size_t> index(rank, 0);
+        for (;;) {
+            size_t src = 0, dst = 0;
+            for (size_t d = 0; d + 1 < rank; d++) {
+                src += index[d] * from[d];
+                dst += index[d] * to[d];
+            }
+            copy(src, dst, length);
+
+            size_t d = rank - 1;
+            for (;;) {
+                if (d == 0) {
+                    return;
+                }
+                d--;
+                if (++index[d] < common[d]) {
+                    break;
+                }
+                index[d] = 0;
+            }
+        }
+    };
+
+    if (isText()) {
+        std::vector<std::string> resized(check::fits_in_size_t(extent.nelms(), "Cannot allocate storage (exceeds memory)"));
+        for_each_run([&](size_t src, size_t dst, size_t n) {
+            std::move(texts.begin() + src, texts.begin() + src + n, resized.begin() + dst);
+        });
+        texts.swap(resized);
+    } else {
+        NDArray resized(storedType(), extent);
+        const size_t esize = elementSize();
+        for_each_run([&](size_t src, size_t dst, size_t n) {
+            std::memcpy(resized.data() + dst * esize, numbers.data() + src * esize, n * esize);
+        });
+        numbers = std::move(resized);
+    }
+    shape = extent;
+}
+
+
+void DataStore::box(const NDSize &extent, const NDSize &count, const NDSize &offset,
+                    NDSize &box_count, NDSize &box_offset) {
+    const size_t rank = extent.size();
+
+    box_count = count;
+    box_offset = offset;
+    if (!offset) {
+        box_offset = NDSize(rank, 0);
+        if (!count) {
+            box_count = extent;
+        }
+    } else if (!count) {
+        box_count = NDSize(rank, 1);
+    }
+
+    // like HDF5, dimensions beyond the rank of the data are ignored as long
+    // as they select a single element
+    if (box_count.size() > rank && box_offset.size() >= rank && box_offset.size() <= box_count.size()) {
+        bool single = true;
+        for (size_t d = rank; d < box_count.size(); d++) {
+            single = single && box_count[d] == 1 && (d >= box_offset.size() || box_offset[d] == 0);
+        }
+        if (single) {
+            NDSize head_count(rank), head_offset(rank);
+            for (size_t d = 0; d < rank; d++) {
+                head_count[d] = box_count[d];
+                head_offset[d] = box_offset[d];
+            }
+            box_count = head_count;
+            box_offset = head_offset;
+        }
+    }
+    if (box_count.size() != rank || box_offset.size() != rank) {
+        throw InvalidRank("Count and offset must have the rank of the data");
+    }
+    for (size_t d = 0; d < rank; d++) {
+        if (box_offset[d] + box_count[d] > extent[d]) {
+            throw OutOfBounds("Trying to access data outside of range", box_offset[d] + box_count[d]);
+        }
+    }
+}
+
+
+std::vector<DataStore::Segment> DataStore::segments(const NDSize &count, const NDSize &offset) const {
+    const size_t rank = shape.size();
+
+    NDSize box_count, box_offset;
+    box(shape, count, offset, box_count, box_offset);
+
+    std::vector<Segment> result;
+    if (rank == 0) {
+        result.push_back(Segment {0, 1});
+        return result;
+    }
+    if (box_count.nelms() == 0) {
+        return result;
+    }
+
+    // runs along trailing dimensions the box covers completely are contiguous
+    size_t inner = rank - 1;
+    size_t length = static_cast<size_t>(box_count[inner]);
+    while (inner > 0 && box_count[inner] == shape[inner]) {
+        inner--;
+        length *= static_cast<size_t>(box_count[inner]);
+    }
+
+    const std::vector<size_t> strides = strides_of(shape);
+    std::vector<size_t> index(inner, 0);
+    for (;;) {
+        size_t start = static_cast<size_t>(box_offset[inner]) * strides[inner];
+        for (size_t d = 0; d < inner; d++) {
+            start += (static_cast<size_t>(box_offset[d]) + index[d]) * strides[d];
+        }
+        result.push_back(Segment {start, length});
+
+        size_t d = inner;
+        for (;;) {
+            if (d == 0) {
+                return result;
+            }
+            d--;
+            if (++index[d] < box_count[d]) {
+                break;
+            }
+            index[d] = 0;
+        }
+    }
+}
+
+
+void DataStore::read(DataType dtype, void *data, const NDSize &count, const NDSize &offset) const {
+    read(dtype, data, segments(count, offset));
+}
+
+
+void DataStore::read(DataType dtype, void *data, const std::vector<Selection::Run> &runs) const {
+    const std::vector<size_t> strides = strides_of(shape);
+    std::vector<Segment> segs;
+    segs.reserve(runs.size());
+    for (const Selection::Run &run : runs) {
+        size_t start = 0;
+        for (size_t d = 0; d < strides.size(); d++) {
+            start += static_cast<size_t>(run.offset[d]) * strides[d];
+        }
+        const size_t length = static_cast<size_t>(run.length);
+        if (!segs.empty() && segs.back().start + segs.back().length == start) {
+            segs.back().length += length;
+        } else {
+            segs.push_back(Segment {start, length});
+        }
+    }
+    read(dtype, data, segs);
+}
+
+
+void DataStore::read(DataType dtype, void *data, const std::vector<Segment> &segs) const {
+    if (this->dtype == DataType::String) {
+        if (dtype != DataType::String) {
+            throw std::invalid_argument("DataStore: strings can only be read as strings");
+        }
+        std::string *out = static_cast<std::string *>(data);
+        for (const Segment &seg : segs) {
+            if (isText()) {
+                out = std::copy(texts.begin() + seg.start, texts.begin() + seg.start + seg.length, out);
+            } else {
+                const uint32_t *code = reinterpret_cast<const uint32_t *>(numbers.data()) + seg.start;
+                out = std::transform(code, code + seg.length, out, [this](uint32_t c) { return dict[c]; });
+            }
+        }
+        return;
+    }
+
+    if (dtype == DataType::String) {
+        throw std::invalid_argument("DataStore: numbers cannot be read as strings");
+    }
+
+    size_t n = 0;
+    for (const Segment &seg : segs) {
+        n += seg.length;
+    }
+
+    const DataType stored = storedType();
+    const size_t esize = elementSize();
+    const size_t dsize = data_type_to_size(dtype);
+
+    // gather in place if the result is at least as wide as the stored type
+    std::vector<NDArray::byte_type> scratch;
+    NDArray::byte_type *buffer = static_cast<NDArray::byte_type *>(data);
+    if (dtype != stored && dsize < esize) {
+        scratch.resize(n * esize);
+        buffer = scratch.data();
+    }
+
+    NDArray::byte_type *out = buffer;
+    for (const Segment &seg : segs) {
+        std::memcpy(out, numbers.data() + seg.start * esize, seg.length * esize);
+        out += seg.length * esize;
+    }
+
+    if (dtype != stored && n > 0) {
+        convert(stored, dtype, buffer, n);
+        if (buffer != data) {
+            std::memcpy(data, buffer, n * dsize);
+        }
+    }
+}
+
+
+void DataStore::write(DataType dtype, const void *data, const NDSize &count, const NDSize &offset) {
+    write(dtype, data, segments(count, offset));
+}
+
+
+void DataStore::write(DataType dtype, const void *data, const std::vector<Segment> &segs) {
+    if (this->dtype == DataType::String) {
+        if (dtype != DataType::String) {
+            throw std::invalid_argument("DataStore: strings can only be written as strings");
+        }
+        const std::string *in = static_cast<const std::string *>(data);
+
+        size_t n = 0;
+        for (const Segment &seg : segs) {
+            n += seg.length;
+        }
+
+        // check all lengths before changing anything
+        if (strings.mode == StringStorage::Mode::Fixed) {
+            for (size_t i = 0; i < n; i++) {
+                if (in[i].size() > strings.length) {
+                    throw std::invalid_argument("String '" + in[i] + "' exceeds fixed length of " +
+                                                std::to_string(strings.length) + " bytes");
+                }
+            }
+        }
+
+        for (const Segment &seg : segs) {
+            for (size_t k = 0; k < seg.length; k++, in++) {
+                if (strings.mode == StringStorage::Mode::Fixed) {
+                    // fixed length strings end at the first null byte
+                    texts[seg.start + k] = in->substr(0, in->find('\0'));
+                } else if (strings.mode == StringStorage::Mode::Variable) {
+                    texts[seg.start + k] = *in;
+                } else {
+                    reinterpret_cast<uint32_t *>(numbers.data())[seg.start + k] = encode(*in);
+                }
+            }
+        }
+        return;
+    }
+
+    if (dtype == DataType::String) {
+        throw std::invalid_argument("DataStore: strings cannot be written as numbers");
+    }
+
+    size_t n = 0;
+    for (const Segment &seg : segs) {
+        n += seg.length;
+    }
+
+    const DataType stored = storedType();
+    const size_t esize = elementSize();
+    const size_t dsize = data_type_to_size(dtype);
+
+    std::vector<NDArray::byte_type> scratch;
+    const NDArray::byte_type *in = static_cast<const NDArray::byte_type *>(data);
+    if (dtype != stored && n > 0) {
+        scratch.resize(n * std::max(esize, dsize));
+        std::memcpy(scratch.data(), data, n * dsize);
+        convert(dtype, stored, scratch.data(), n);
+        in = scratch.data();
+    }
+
+    for (const Segment &seg : segs) {
+        std::memcpy(numbers.data() + seg.start * esize, in, seg.length * esize);
+        in += seg.length * esize;
+    }
+}
+
+
+std::vector<Variant> DataStore::values(ndsize_t offset, ndsize_t count) const {
+    const size_t n = check::fits_in_size_t(count, "Cannot allocate storage (exceeds memory)");
+    std::vector<Variant> result(n);
+    if (n == 0) {
+        return result;
+    }
+
+    const NDSize ncount {count}, noffset {offset};
+    switch (dtype) {
+    case DataType::String: {
+        std::vector<std::string> vals(n);
+        read(dtype, vals.data(), ncount, noffset);
+        for (size_t i = 0; i < n; i++) {
+            result[i].set(vals[i]);
+        }
+        break;
+    }
+    case DataType::Bool: {
+        std::vector<NDArray::byte_type> vals(n * sizeof(bool));
+        read(dtype, vals.data(), ncount, noffset);
+        for (size_t i = 0; i < n; i++) {
+            bool b;
+            std::memcpy(&b, vals.data() + i * sizeof(bool), sizeof(bool));
+            result[i].set(b);
+        }
+        break;
+    }
+
+#define NIX_MEMORY_VALUES(nix_type, c_type)              \
+    case DataType::nix_type: {                           \
+        std::vector<c_type> vals(n);                     \
+        read(dtype, vals.data(), ncount, noffset);       \
+        for (size_t i = 0; i < n; i++) {                 \
+            result[i].set(vals[i]);                      \
+        }                                                \
+        break;                                           \
+    }
+
+    NIX_MEMORY_VALUES(Int32, int32_t)
+    NIX_MEMORY_VALUES(UInt32, uint32_t)
+    NIX_MEMORY_VALUES(Int64, int64_t)
+    NIX_MEMORY_VALUES(UInt64, uint64_t)
+    NIX_MEMORY_VALUES(Double, double)
+#undef NIX_MEMORY_VALUES
+
+    default:
+        throw std::invalid_argument("Unhandled DataType");
+    }
+
+    return result;
+}
+
+
+void DataStore::values(const std::vector<Variant> &vals, ndsize_t offset) {
+    for (size_t i = 0; i < vals.size(); i++) {
+        const Variant &v = vals[i];
+        const NDSize count {1}, index {offset + i};
+
+        switch (v.type()) {
+        case DataType::String: {
+            const std::string str = v.get<std::string>();
+            write(DataType::String, &str, count, index);
+            break;
+        }
+
+#define NIX_MEMORY_VALUE(nix_type, c_type)                      \
+        case DataType::nix_type: {                              \
+            const c_type value = v.get<c_type>();               \
+            write(DataType::nix_type, &value, count, index);    \
+            break;                                              \
+        }
+
+        NIX_MEMORY_VALUE(Bool, bool)
+        NIX_MEMORY_VALUE(Int32, int32_t)
+        NIX_MEMORY_VALUE(UInt32, uint32_t)
+        NIX_MEMORY_VALUE(Int64, int64_t)
+        NIX_MEMORY_VALUE(UInt64, uint64_t)
+        NIX_MEMORY_VALUE(Double, double)
+#undef NIX_MEMORY_VALUE
+
+        default:
+            throw std::invalid_argument("Unhandled DataType");
+        }
+    }
+}
+
+
+void DataStore::dictionary(const std::vector<std::string> &entries) {
+    dict.clear();
+    codes.clear();
+    for (const std::string &entry : entries) {
+        codes.emplace(entry, static_cast<uint32_t>(dict.size()));
+        dict.push_back(entry);
+    }
+    if (dict.empty()) {
+        encode("");
+    }
+}
+
+
+void DataStore::readCodes(uint32_t *out, const NDSize &count, const NDSize &offset) const {
+    if (dtype != DataType::String || strings.mode != StringStorage::Mode::Dictionary) {
+        throw std::invalid_argument("DataStore: data are not dictionary encoded");
+    }
+    for (const Segment &seg : segments(count, offset)) {
+        const uint32_t *code = reinterpret_cast<const uint32_t *>(numbers.data()) + seg.start;
+        out = std::copy(code, code + seg.length, out);
+    }
+}
+
+
+uint32_t DataStore::encode(const std::string &str) {
+    auto it = codes.find(str);
+    if (it != codes.end()) {
+        return it->second;
+    }
+    const uint32_t code = static_cast<uint32_t>(dict.size());
+    codes.emplace(str, code);
+    dict.push_back(str);
+    return code;
+}
+
+} // namespace memory
+} // namespace nix
@@ -0,0 +1,155 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_DATA_STORE_MEMORY_H
+#define NIX_DATA_STORE_MEMORY_H
+
+#include <nix/DataType.hpp>
+#include <nix/NDArray.hpp>
+#include <nix/NDSize.hpp>
+#include <nix/Selection.hpp>
+#include <nix/StringStorage.hpp>
+#include <nix/Variant.hpp>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace nix {
+namespace memory {
+
+/**
+ * The values of a DataArray, a DataFrame column or a Property, kept in
+ * memory in row-major order.
+ *
+ * Numbers live in one contiguous NDArray of the stored type, strings in a
+ * vector. Dictionary encoded strings are kept as UInt32 codes in the
+ * NDArray plus the dictionary, in which code 0 is the empty string.
+ */
+class DataStore {
+
+private:
+
+    DataType                                  dtype;
+    StringStorage                             strings;
+    NDSize                                    shape;
+    NDArray                                   numbers;
+    std::vector<std::string>                  texts;
+    std::vector<std::string>                  dict;
+    std::unordered_map<std::string, uint32_t> codes;
+
+public:
+
+    DataStore(DataType dtype, const NDSize &extent, const StringStorage &strings = StringStorage());
+
+    /**
+     * The type of the values, DataType::String for every string storage.
+     */
+    DataType dataType() const {
+        return dtype;
+    }
+
+    StringStorage stringStorage() const {
+        return strings;
+    }
+
+    NDSize extent() const {
+        return shape;
+    }
+
+    /**
+     * Change the extent, keeping the values both extents have in common.
+     */
+    void extent(const NDSize &extent);
+
+    /**
+     * The number of bytes of one stored element.
+     */
+    size_t elementSize() const;
+
+    /**
+     * The number of bytes held by the values.
+     */
+    ndsize_t storageSize() const;
+
+    /**
+     * Read the box (count, offset) as dtype; an empty count is the element
+     * at offset, an empty offset the whole extent.
+     */
+    void read(DataType dtype, void *data, const NDSize &count, const NDSize &offset) const;
+
+    /**
+     * Read the runs of a selection, in order, as dtype.
+     */
+    void read(DataType dtype, void *data, const std::vector<Selection::Run> &runs) const;
+
+    void write(DataType dtype, const void *data, const NDSize &count, const NDSize &offset);
+
+    std::vector<Variant> values(ndsize_t offset, ndsize_t count) const;
+
+    void values(const std::vector<Variant> &values, ndsize_t offset);
+
+    std::vector<std::string> dictionary() const {
+        return dict;
+    }
+
+    /**
+     * Replace the dictionary, e.g. when the codes are read in at once.
+     */
+    void dictionary(const std::vector<std::string> &entries);
+
+    void readCodes(uint32_t *codes, const NDSize &count, const NDSize &offset) const;
+
+    /**
+     * The box (count, offset) selects in data of the given extent, with
+     * the defaults of read.
+     */
+    static void box(const NDSize &extent, const NDSize &count, const NDSize &offset,
+                    NDSize &box_count, NDSize &box_offset);
+
+    /**
+     * The numbers or codes, for reading them in or out at once.
+     */
+    void *data() {
+        return numbers.data();
+    }
+
+    /**
+     * The strings of variable and fixed length storage.
+     */
+    std::vector<std::string> &text() {
+        return texts;
+    }
+
+private:
+
+    struct Segment {
+        size_t start;
+        size_t length;
+    };
+
+    bool isText() const {
+        return dtype == DataType::String && strings.mode != StringStorage::Mode::Dictionary;
+    }
+
+    DataType storedType() const;
+
+    std::vector<Segment> segments(const NDSize &count, const NDSize &offset) const;
+
+    void read(DataType dtype, void *data, const std::vector<Segment> &segments) const;
+
+    void write(DataType dtype, const void *data, const std::vector<Segment> &segments);
+
+    uint32_t encode(const std::string &str);
+
+};
+
+} // namespace memory
+} // namespace nix
+
+#endif // NIX_DATA_STORE_MEMORY_H
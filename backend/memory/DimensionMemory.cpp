@@ -0,0 +1,269 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "DimensionMemory.hpp"
+
+#include <nix/Exception.hpp>
+
+using namespace std;
+using namespace nix::base;
+
+namespace nix {
+namespace memory {
+
+
+shared_ptr<IDimension> openDimensionMemory(const shared_ptr<DimensionNode> &node, ndsize_t index) {
+    shared_ptr<IDimension> dim;
+
+    switch (node->type) {
+        case DimensionType::Set:
+            dim = make_shared<SetDimensionMemory>(node, index);
+            break;
+        case DimensionType::Range:
+            dim = make_shared<RangeDimensionMemory>(node, index);
+            break;
+        case DimensionType::Sample:
+            dim = make_shared<SampledDimensionMemory>(node, index);
+            break;
+    }
+
+    return dim;
+}
+
+// Implementation of Dimension
+
+DimensionMemory::DimensionMemory(const shared_ptr<DimensionNode> &node, ndsize_t index)
+    : node(node), dim_index(index)
+{
+}
+
+
+DimensionMemory::~DimensionMemory() {}
+
+//--------------------------------------------------------------
+// Implementation of SampledDimension
+//--------------------------------------------------------------
+
+SampledDimensionMemory::SampledDimensionMemory(const shared_ptr<DimensionNode> &node, ndsize_t index)
+    : DimensionMemory(node, index)
+{
+}
+
+
+DimensionType SampledDimensionMemory::dimensionType() const {
+    return DimensionType::Sample;
+}
+
+
+boost::optional<string> SampledDimensionMemory::label() const {
+    return node->label;
+}
+
+
+void SampledDimensionMemory::label(const string &label) {
+    node->label = label;
+}
+
+
+void SampledDimensionMemory::label(const none_t t) {
+    node->label = boost::none;
+}
+
+
+boost::optional<string> SampledDimensionMemory::unit() const {
+    return node->unit;
+}
+
+
+void SampledDimensionMemory::unit(const string &unit) {
+    node->unit = unit;
+}
+
+
+void SampledDimensionMemory::unit(const none_t t) {
+    node->unit = boost::none;
+}
+
+
+double SampledDimensionMemory::samplingInterval() const {
+    if (!node->sampling_interval) {
+        throw MissingAttr("sampling_interval");
+    }
+    return *node->sampling_interval;
+}
+
+
+void SampledDimensionMemory::samplingInterval(double sampling_interval) {
+    node->sampling_interval = sampling_interval;
+}
+
+
+boost::optional<double> SampledDimensionMemory::offset() const {
+    return node->offset;
+}
+
+
+void SampledDimensionMemory::offset(double offset) {
+    node->offset = offset;
+}
+
+
+void SampledDimensionMemory::offset(const none_t t) {
+    node->offset = boost::none;
+}
+
+
+SampledDimensionMemory::~SampledDimensionMemory() {}
+
+//--------------------------------------------------------------
+// Implementation of SetDimensionMemory
+//--------------------------------------------------------------
+
+SetDimensionMemory::SetDimensionMemory(const shared_ptr<DimensionNode> &node, ndsize_t index)
+    : DimensionMemory(node, index)
+{
+}
+
+
+DimensionType SetDimensionMemory::dimensionType() const {
+    return DimensionType::Set;
+}
+
+
+vector<string> SetDimensionMemory::labels() const {
+    return node->labels;
+}
+
+
+ndsize_t SetDimensionMemory::labelCount() const {
+    return node->labels.size();
+}
+
+
+void SetDimensionMemory::labels(const vector<string> &labels) {
+    node->labels = labels;
+}
+
+
+void SetDimensionMemory::labels(const none_t t) {
+    node->labels.clear();
+}
+
+
+SetDimensionMemory::~SetDimensionMemory() {}
+
+//--------------------------------------------------------------
+// Implementation of RangeDimensionMemory
+//--------------------------------------------------------------
+
+RangeDimensionMemory::RangeDimensionMemory(const shared_ptr<DimensionNode> &node, ndsize_t index)
+    : DimensionMemory(node, index)
+{
+}
+
+
+DimensionType RangeDimensionMemory::dimensionType() const {
+    return DimensionType::Range;
+}
+
+
+shared_ptr<DataArrayNode> RangeDimensionMemory::array() const {
+    return alias() ? node->alias.lock() : nullptr;
+}
+
+
+boost::optional<string> RangeDimensionMemory::label() const {
+    shared_ptr<DataArrayNode> da = array();
+    return da ? da->label : node->label;
+}
+
+
+void RangeDimensionMemory::label(const string &label) {
+    shared_ptr<DataArrayNode> da = array();
+    (da ? da->label : node->label) = label;
+}
+
+
+void RangeDimensionMemory::label(const none_t t) {
+    shared_ptr<DataArrayNode> da = array();
+    (da ? da->label : node->label) = boost::none;
+}
+
+
+boost::optional<string> RangeDimensionMemory::unit() const {
+    shared_ptr<DataArrayNode> da = array();
+    return da ? da->unit : node->unit;
+}
+
+
+void RangeDimensionMemory::unit(const string &unit) {
+    shared_ptr<DataArrayNode> da = array();
+    (da ? da->unit : node->unit) = unit;
+}
+
+
+void RangeDimensionMemory::unit(const none_t t) {
+    shared_ptr<DataArrayNode> da = array();
+    (da ? da->unit : node->unit) = boost::none;
+}
+
+
+bool RangeDimensionMemory::alias() const {
+    return !node->ticks && !node->alias.expired();
+}
+
+
+vector<double> RangeDimensionMemory::ticks() const {
+    if (node->ticks) {
+        return *node->ticks;
+    }
+
+    shared_ptr<DataArrayNode> da = array();
+    if (!da || !da->data) {
+        throw MissingAttr("ticks");
+    }
+    vector<double> ticks(da->data->extent().nelms());
+    if (!ticks.empty()) {
+        da->data->read(DataType::Double, ticks.data(), {}, {});
+    }
+    return ticks;
+}
+
+
+ndsize_t RangeDimensionMemory::tickCount() const {
+    if (node->ticks) {
+        return node->ticks->size();
+    }
+
+    shared_ptr<DataArrayNode> da = array();
+    if (!da || !da->data) {
+        throw MissingAttr("ticks");
+    }
+    return da->data->extent().nelms();
+}
+
+
+void RangeDimensionMemory::ticks(const vector<double> &ticks) {
+    shared_ptr<DataArrayNode> da = array();
+    if (!alias()) {
+        node->ticks = ticks;
+    } else if (da->data) {
+        da->data->extent(NDSize(1, ticks.size()));
+        if (!ticks.empty()) {
+            da->data->write(DataType::Double, ticks.data(), {}, {});
+        }
+    } else {
+        throw MissingAttr("ticks");
+    }
+}
+
+
+RangeDimensionMemory::~RangeDimensionMemory() {}
+
+} // ns nix::memory
+} // ns nix
@@ -0,0 +1,175 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_DIMENSIONS_MEMORY_H
+#define NIX_DIMENSIONS_MEMORY_H
+
+#include <nix/base/IDimensions.hpp>
+
+#include "Nodes.hpp"
+
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace nix {
+namespace memory {
+
+
+std::shared_ptr<base::IDimension> openDimensionMemory(const std::shared_ptr<DimensionNode> &node, ndsize_t index);
+
+
+class DimensionMemory : virtual public base::IDimension {
+
+protected:
+
+    std::shared_ptr<DimensionNode> node;
+    ndsize_t dim_index;
+
+public:
+
+    DimensionMemory(const std::shared_ptr<DimensionNode> &node, ndsize_t index);
+
+
+    ndsize_t index() const { return dim_index; }
+
+
+    virtual ~DimensionMemory();
+
+};
+
+
+class SampledDimensionMemory : virtual public base::ISampledDimension, public DimensionMemory {
+
+public:
+
+    SampledDimensionMemory(const std::shared_ptr<DimensionNode> &node, ndsize_t index);
+
+
+    DimensionType dimensionType() const;
+
+
+    boost::optional<std::string> label() const;
+
+
+    void label(const std::string &label);
+
+
+    void label(const none_t t);
+
+
+    boost::optional<std::string> unit() const;
+
+
+    void unit(const std::string &unit);
+
+
+    void unit(const none_t t);
+
+
+    double samplingInterval() const;
+
+
+    void samplingInterval(double sampling_interval);
+
+
+    boost::optional<double> offset() const;
+
+
+    void offset(double offset);
+
+
+    void offset(const none_t t);
+
+
+    virtual ~SampledDimensionMemory();
+
+};
+
+
+class SetDimensionMemory : virtual public base::ISetDimension, public DimensionMemory {
+
+public:
+
+    SetDimensionMemory(const std::shared_ptr<DimensionNode> &node, ndsize_t index);
+
+
+    DimensionType dimensionType() const;
+
+
+    std::vector<std::string> labels() const;
+
+
+    ndsize_t labelCount() const;
+
+
+    void labels(const std::vector<std::string> &labels);
+
+
+    void labels(const none_t t);
+
+
+    virtual ~SetDimensionMemory();
+
+};
+
+
+class RangeDimensionMemory : virtual public base::IRangeDimension, public DimensionMemory {
+
+public:
+
+    RangeDimensionMemory(const std::shared_ptr<DimensionNode> &node, ndsize_t index);
+
+
+    DimensionType dimensionType() const;
+
+
+    boost::optional<std::string> label() const;
+
+
+    void label(const std::string &label);
+
+
+    void label(const none_t t);
+
+
+    boost::optional<std::string> unit() const;
+
+
+    void unit(const std::string &unit);
+
+
+    void unit(const none_t t);
+
+
+    bool alias() const;
+
+
+    std::vector<double> ticks() const;
+
+
+    ndsize_t tickCount() const;
+
+
+    void ticks(const std::vector<double> &ticks);
+
+
+    virtual ~RangeDimensionMemory();
+
+private:
+
+    // the DataArray of an alias dimension
+    std::shared_ptr<DataArrayNode> array() const;
+
+};
+
+
+} // namespace memory
+} // namespace nix
+
+#endif // NIX_DIMENSIONS_MEMORY_H
@@ -0,0 +1,75 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "EntityMemory.hpp"
+
+#include <nix/util/util.hpp>
+#include "FileMemory.hpp"
+
+using namespace std;
+using namespace nix::base;
+
+namespace nix {
+namespace memory {
+
+
+EntityMemory::EntityMemory(const shared_ptr<FileMemory> &file, const shared_ptr<EntityNode> &node)
+    : entity_file(file), entity_node(node)
+{
+}
+
+
+string EntityMemory::id() const {
+    return entity_node->id;
+}
+
+
+time_t EntityMemory::updatedAt() const {
+    return entity_node->updated_at;
+}
+
+
+void EntityMemory::setUpdatedAt() {
+    // set when the entity is created
+}
+
+
+void EntityMemory::forceUpdatedAt() {
+    entity_node->updated_at = util::getTime();
+}
+
+
+time_t EntityMemory::createdAt() const {
+    return entity_node->created_at;
+}
+
+
+void EntityMemory::setCreatedAt() {
+    // set when the entity is created
+}
+
+
+void EntityMemory::forceCreatedAt(time_t t) {
+    entity_node->created_at = t;
+}
+
+
+bool EntityMemory::isValidEntity() const {
+    return !entity_node->deleted;
+}
+
+
+shared_ptr<FileMemory> EntityMemory::file() const {
+    return entity_file;
+}
+
+
+EntityMemory::~EntityMemory() {}
+
+} // ns nix::memory
+} // ns nix
@@ -0,0 +1,83 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_ENTITY_MEMORY_H
+#define NIX_ENTITY_MEMORY_H
+
+#include <nix/base/IFile.hpp>
+#include <nix/base/IEntity.hpp>
+
+#include "Nodes.hpp"
+
+#include <string>
+#include <memory>
+
+namespace nix {
+namespace memory {
+
+class FileMemory;
+
+
+/**
+ * Memory implementation of IEntity
+ */
+class EntityMemory : virtual public base::IEntity {
+
+private:
+
+    std::shared_ptr<FileMemory> entity_file;
+    std::shared_ptr<EntityNode> entity_node;
+
+public:
+
+    EntityMemory(const std::shared_ptr<FileMemory> &file, const std::shared_ptr<EntityNode> &node);
+
+
+    std::string id() const;
+
+
+    time_t updatedAt() const;
+
+
+    time_t createdAt() const;
+
+
+    void setUpdatedAt();
+
+
+    void forceUpdatedAt();
+
+
+    void setCreatedAt();
+
+
+    void forceCreatedAt(time_t t);
+
+
+    bool isValidEntity() const;
+
+
+    virtual ~EntityMemory();
+
+protected:
+
+    std::shared_ptr<FileMemory> file() const;
+
+
+    template<typename T>
+    std::shared_ptr<T> node() const {
+        return std::static_pointer_cast<T>(entity_node);
+    }
+
+};
+
+
+} // namespace memory
+} // namespace nix
+
+#endif // NIX_ENTITY_MEMORY_H
@@ -0,0 +1,55 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "EntityWithMetadataMemory.hpp"
+
+#include <nix/Exception.hpp>
+#include "FileMemory.hpp"
+#include "SectionMemory.hpp"
+
+using namespace std;
+using namespace nix::base;
+
+namespace nix {
+namespace memory {
+
+
+EntityWithMetadataMemory::EntityWithMetadataMemory(const shared_ptr<FileMemory> &file, const shared_ptr<MetadataNode> &node)
+    : NamedEntityMemory(file, node)
+{
+}
+
+
+void EntityWithMetadataMemory::metadata(const string &id) {
+    if (id.empty())
+        throw EmptyString("metadata");
+
+    shared_ptr<SectionNode> target = file()->findSection(id);
+    if (!target)
+        throw std::runtime_error("EntityWithMetadataMemory::metadata: Section not found in file!");
+
+    node<MetadataNode>()->metadata = target;
+}
+
+
+shared_ptr<ISection> EntityWithMetadataMemory::metadata() const {
+    shared_ptr<SectionNode> sec = live(node<MetadataNode>()->metadata);
+    return sec ? make_shared<SectionMemory>(file(), sec) : nullptr;
+}
+
+
+void EntityWithMetadataMemory::metadata(const none_t t) {
+    node<MetadataNode>()->metadata.reset();
+    forceUpdatedAt();
+}
+
+
+EntityWithMetadataMemory::~EntityWithMetadataMemory() {}
+
+} // ns nix::memory
+} // ns nix
@@ -0,0 +1,49 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_ENTITY_WITH_METADATA_MEMORY_H
+#define NIX_ENTITY_WITH_METADATA_MEMORY_H
+
+#include <nix/base/IEntityWithMetadata.hpp>
+#include "NamedEntityMemory.hpp"
+
+#include <string>
+#include <memory>
+
+namespace nix {
+namespace memory {
+
+
+/**
+ * Base class for entities that can be linked to a Section.
+ */
+class EntityWithMetadataMemory: public virtual base::IEntityWithMetadata, public NamedEntityMemory {
+
+public:
+
+    EntityWithMetadataMemory(const std::shared_ptr<FileMemory> &file, const std::shared_ptr<MetadataNode> &node);
+
+
+    void metadata(const std::string &id);
+
+
+    std::shared_ptr<base::ISection> metadata() const;
+
+
+    void metadata(const none_t t);
+
+
+    virtual ~EntityWithMetadataMemory();
+
+};
+
+
+} // namespace memory
+} // namespace nix
+
+#endif // NIX_ENTITY_WITH_METADATA_MEMORY_H
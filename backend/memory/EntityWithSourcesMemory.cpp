@@ -0,0 +1,89 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "EntityWithSourcesMemory.hpp"
+
+#include <nix/util/util.hpp>
+#include <nix/Source.hpp>
+#include "BlockMemory.hpp"
+#include "SourceMemory.hpp"
+
+using namespace std;
+using namespace nix::base;
+
+namespace nix {
+namespace memory {
+
+
+EntityWithSourcesMemory::EntityWithSourcesMemory(const shared_ptr<FileMemory> &file, const shared_ptr<BlockNode> &block,
+                                                 const shared_ptr<SourcesNode> &node)
+    : EntityWithMetadataMemory(file, node), entity_block(block)
+{
+}
+
+
+ndsize_t EntityWithSourcesMemory::sourceCount() const {
+    return node<SourcesNode>()->sources.size();
+}
+
+
+bool EntityWithSourcesMemory::hasSource(const string &id) const {
+    return node<SourcesNode>()->sources.has(id);
+}
+
+
+shared_ptr<ISource> EntityWithSourcesMemory::getSource(const string &name_or_id) const {
+    const RefList<SourceNode> &refs = node<SourcesNode>()->sources;
+    shared_ptr<SourceNode> source = util::looksLikeUUID(name_or_id) ? refs.byId(name_or_id) : refs.byName(name_or_id);
+    return source ? make_shared<SourceMemory>(file(), entity_block, source) : nullptr;
+}
+
+
+shared_ptr<ISource> EntityWithSourcesMemory::getSource(const size_t index) const {
+    shared_ptr<SourceNode> source = node<SourcesNode>()->sources.at(index);
+    return make_shared<SourceMemory>(file(), entity_block, source);
+}
+
+
+void EntityWithSourcesMemory::sources(const vector<Source> &sources) {
+    node<SourcesNode>()->sources.clear();
+    for (const auto &src : sources) {
+        if (entity_block->sources.byId(src.id())) {
+            addSource(src.id());
+        }
+    }
+}
+
+
+void EntityWithSourcesMemory::addSource(const string &id) {
+    if (id.empty())
+        throw EmptyString("addSource");
+
+    auto it = entity_block->source_index.find(id);
+    shared_ptr<SourceNode> target = it != entity_block->source_index.end() ? live(it->second) : nullptr;
+    if (!target)
+        throw std::runtime_error("EntityWithSourcesMemory::addSource: Given source does not exist in this block!");
+
+    node<SourcesNode>()->sources.add(target);
+}
+
+
+bool EntityWithSourcesMemory::removeSource(const string &id) {
+    return node<SourcesNode>()->sources.remove(id);
+}
+
+
+shared_ptr<IBlock> EntityWithSourcesMemory::block() const {
+    return make_shared<BlockMemory>(file(), entity_block);
+}
+
+
+EntityWithSourcesMemory::~EntityWithSourcesMemory() {}
+
+} // ns nix::memory
+} // ns nix
@@ -0,0 +1,77 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_ENTITY_WITH_SOURCES_MEMORY_H
+#define NIX_ENTITY_WITH_SOURCES_MEMORY_H
+
+#include <nix/base/IBlock.hpp>
+#include <nix/base/IEntityWithSources.hpp>
+#include "EntityWithMetadataMemory.hpp"
+
+#include <vector>
+#include <string>
+#include <memory>
+
+namespace nix {
+namespace memory {
+
+
+/**
+ * Base class for entities that are associated with sources.
+ */
+class EntityWithSourcesMemory: public virtual base::IEntityWithSources, public EntityWithMetadataMemory {
+
+private:
+
+    std::shared_ptr<BlockNode> entity_block;
+
+public:
+
+    EntityWithSourcesMemory(const std::shared_ptr<FileMemory> &file, const std::shared_ptr<BlockNode> &block,
+                            const std::shared_ptr<SourcesNode> &node);
+
+
+    ndsize_t sourceCount() const;
+
+
+    bool hasSource(const std::string &id) const;
+
+
+    std::shared_ptr<base::ISource> getSource(const std::string &name_or_id) const;
+
+
+    std::shared_ptr<base::ISource> getSource(const size_t index) const;
+
+
+    void sources(const std::vector<Source> &sources);
+
+
+    void addSource(const std::string &id);
+
+
+    bool removeSource(const std::string &id);
+
+
+    virtual ~EntityWithSourcesMemory();
+
+
+    std::shared_ptr<base::IBlock> block() const;
+
+protected:
+
+    std::shared_ptr<BlockNode> blockNode() const {
+        return entity_block;
+    }
+
+};
+
+
+} // namespace memory
+} // namespace nix
+
+#endif // NIX_ENTITY_WITH_SOURCES_MEMORY_H
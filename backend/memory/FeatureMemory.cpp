@@ -0,0 +1,61 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "FeatureMemory.hpp"
+
+#include "DataArrayMemory.hpp"
+
+using namespace std;
+using namespace nix::base;
+
+namespace nix {
+namespace memory {
+
+
+FeatureMemory::FeatureMemory(const shared_ptr<FileMemory> &file, const shared_ptr<BlockNode> &block,
+                             const shared_ptr<FeatureNode> &node)
+    : EntityMemory(file, node), block(block)
+{
+}
+
+
+void FeatureMemory::linkType(LinkType link_type) {
+    node<FeatureNode>()->link_type = link_type;
+    forceUpdatedAt();
+}
+
+
+LinkType FeatureMemory::linkType() const {
+    const boost::optional<LinkType> &link_type = node<FeatureNode>()->link_type;
+    if (!link_type) {
+        throw MissingAttr("data");
+    }
+    return *link_type;
+}
+
+
+void FeatureMemory::data(const string &name_or_id) {
+    shared_ptr<DataArrayNode> da = findNode(block->data_arrays, {name_or_id, ObjectType::DataArray});
+    if (!da) {
+        throw std::runtime_error("FeatureMemory::data: DataArray not found in block!");
+    }
+    node<FeatureNode>()->data = da;
+    forceUpdatedAt();
+}
+
+
+shared_ptr<IDataArray> FeatureMemory::data() const {
+    shared_ptr<DataArrayNode> da = live(node<FeatureNode>()->data);
+    return da ? make_shared<DataArrayMemory>(file(), block, da) : nullptr;
+}
+
+
+FeatureMemory::~FeatureMemory() {}
+
+} // ns nix::memory
+} // ns nix
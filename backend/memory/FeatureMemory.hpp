@@ -0,0 +1,56 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_FEATURE_MEMORY_H
+#define NIX_FEATURE_MEMORY_H
+
+#include <nix/base/IFeature.hpp>
+#include "EntityMemory.hpp"
+
+#include <string>
+
+namespace nix {
+namespace memory {
+
+
+/**
+ * Class that represents a NIX feature entity
+ */
+class FeatureMemory : virtual public base::IFeature, public EntityMemory {
+
+private:
+
+    std::shared_ptr<BlockNode> block;
+
+public:
+
+    FeatureMemory(const std::shared_ptr<FileMemory> &file, const std::shared_ptr<BlockNode> &block,
+                  const std::shared_ptr<FeatureNode> &node);
+
+
+    void linkType(LinkType type);
+
+
+    LinkType linkType() const;
+
+
+    void data(const std::string &name_or_id);
+
+
+    std::shared_ptr<base::IDataArray> data() const;
+
+
+    virtual ~FeatureMemory();
+
+};
+
+
+} // namespace memory
+} // namespace nix
+
+#endif // NIX_FEATURE_MEMORY_H
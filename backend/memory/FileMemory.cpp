@@ -0,0 +1,307 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "FileMemory.hpp"
+
+#include <nix/util/util.hpp>
+#include "BlockMemory.hpp"
+#include "SectionMemory.hpp"
+#include "ConvertMemory.hpp"
+#include "hdf5/FileHDF5.hpp"
+
+#include <fstream>
+
+using namespace std;
+using namespace nix::base;
+
+namespace nix {
+namespace memory {
+
+
+FileMemory::FileMemory(const string &name, FileMode mode, Compression compression)
+    : name(name), mode(mode), compr(compression), is_open(true), validated_at(0)
+{
+    created_at = updated_at = time(NULL);
+}
+
+
+shared_ptr<FileMemory> FileMemory::open(const string &name, FileMode mode, Compression compression) {
+    if (mode == FileMode::SwmrWrite || mode == FileMode::SwmrRead) {
+        throw std::invalid_argument("FileMemory::open: files in memory do not support SWMR");
+    }
+
+    auto file = make_shared<FileMemory>(name, mode, compression);
+    if (mode != FileMode::Overwrite && ifstream(name.c_str())) {
+        auto source = make_shared<hdf5::FileHDF5>(name, FileMode::ReadOnly, compression);
+        loadFile(*source, file);
+        source->close();
+    }
+    return file;
+}
+
+
+void FileMemory::saveAs(const string &path) const {
+    auto target = make_shared<hdf5::FileHDF5>(path, FileMode::Overwrite, compr);
+    saveFile(*this, target);
+    target->close();
+}
+
+
+vector<char> FileMemory::image() const {
+    auto target = hdf5::FileHDF5::createInMemory("", compr);
+    saveFile(*this, target);
+    vector<char> buffer = target->image();
+    target->close();
+    return buffer;
+}
+
+
+bool FileMemory::flush() {
+    // nothing to write
+    return true;
+}
+
+
+shared_ptr<BlockNode> FileMemory::findBlock(const string &name_or_id) const {
+    return blocks.find(name_or_id);
+}
+
+
+ndsize_t FileMemory::blockCount() const {
+    return blocks.size();
+}
+
+
+bool FileMemory::hasBlock(const string &name_or_id) const {
+    return findBlock(name_or_id) != nullptr;
+}
+
+
+shared_ptr<IBlock> FileMemory::getBlock(const string &name_or_id) const {
+    shared_ptr<BlockNode> block = findBlock(name_or_id);
+    return block ? make_shared<BlockMemory>(const_pointer_cast<FileMemory>(shared_from_this()), block) : nullptr;
+}
+
+
+shared_ptr<IBlock> FileMemory::getBlock(ndsize_t index) const {
+    return make_shared<BlockMemory>(const_pointer_cast<FileMemory>(shared_from_this()), blocks.at(index));
+}
+
+
+shared_ptr<IBlock> FileMemory::createBlock(const string &name, const string &type) {
+    shared_ptr<BlockNode> block = makeNode<BlockNode>(name, type);
+    block->compression = compr;
+    blocks.add(block);
+    return make_shared<BlockMemory>(shared_from_this(), block);
+}
+
+
+bool FileMemory::deleteBlock(const string &name_or_id) {
+    shared_ptr<BlockNode> block = findBlock(name_or_id);
+    if (!block) {
+        return false;
+    }
+    BlockMemory::dropBlock(*block);
+    blocks.erase(block);
+    return true;
+}
+
+
+void FileMemory::addBlock(const shared_ptr<BlockNode> &block) {
+    blocks.add(block);
+}
+
+
+shared_ptr<SectionNode> FileMemory::findTopSection(const string &name_or_id) const {
+    shared_ptr<SectionNode> section = sections.byName(name_or_id);
+    if (!section && util::looksLikeUUID(name_or_id)) {
+        section = sections.byId(name_or_id);
+    }
+    return section;
+}
+
+
+bool FileMemory::hasSection(const string &name_or_id) const {
+    return findTopSection(name_or_id) != nullptr;
+}
+
+
+shared_ptr<ISection> FileMemory::getSection(const string &name_or_id) const {
+    shared_ptr<SectionNode> section = findTopSection(name_or_id);
+    return section ? make_shared<SectionMemory>(const_pointer_cast<FileMemory>(shared_from_this()), section) : nullptr;
+}
+
+
+shared_ptr<ISection> FileMemory::getSection(ndsize_t index) const {
+    return make_shared<SectionMemory>(const_pointer_cast<FileMemory>(shared_from_this()), sections.at(index));
+}
+
+
+ndsize_t FileMemory::sectionCount() const {
+    return sections.size();
+}
+
+
+shared_ptr<ISection> FileMemory::createSection(const string &name, const string &type) {
+    shared_ptr<SectionNode> section = makeNode<SectionNode>(name, type);
+    addSection(section);
+    metadata_snapshot.reset();
+    return make_shared<SectionMemory>(shared_from_this(), section);
+}
+
+
+bool FileMemory::deleteSection(const string &name_or_id) {
+    shared_ptr<SectionNode> section = findTopSection(name_or_id);
+    if (!section) {
+        return false;
+    }
+    dropSection(section);
+    sections.erase(section);
+    metadata_snapshot.reset();
+    return true;
+}
+
+
+void FileMemory::addSection(const shared_ptr<SectionNode> &section) {
+    sections.add(section);
+    indexSection(section);
+}
+
+
+shared_ptr<SectionNode> FileMemory::findSection(const string &id) const {
+    auto it = section_index.find(id);
+    return it == section_index.end() ? nullptr : live(it->second);
+}
+
+
+void FileMemory::indexSection(const shared_ptr<SectionNode> &section) {
+    section_index[section->id] = section;
+}
+
+
+void FileMemory::dropSection(const shared_ptr<SectionNode> &section) {
+    for (const auto &child : section->sections.all()) {
+        dropSection(child);
+    }
+    for (const auto &property : section->properties.all()) {
+        property->deleted = true;
+    }
+    section_index.erase(section->id);
+    section->deleted = true;
+}
+
+
+shared_ptr<const MetadataSnapshot> FileMemory::metadataSnapshot() const {
+    return metadata_snapshot;
+}
+
+
+void FileMemory::metadataSnapshot(const shared_ptr<const MetadataSnapshot> &snapshot) {
+    metadata_snapshot = snapshot;
+}
+
+
+vector<int> FileMemory::version() const {
+    return FILE_VERSION;
+}
+
+
+string FileMemory::format() const {
+    return FILE_FORMAT;
+}
+
+
+string FileMemory::location() const {
+    return name;
+}
+
+
+time_t FileMemory::createdAt() const {
+    return created_at;
+}
+
+
+time_t FileMemory::updatedAt() const {
+    return updated_at;
+}
+
+
+void FileMemory::setUpdatedAt() {
+    // set when the file is created
+}
+
+
+void FileMemory::forceUpdatedAt() {
+    updated_at = time(NULL);
+}
+
+
+void FileMemory::setCreatedAt() {
+    // set when the file is created
+}
+
+
+void FileMemory::forceCreatedAt(time_t t) {
+    created_at = t;
+}
+
+
+time_t FileMemory::validatedAt() const {
+    return validated_at;
+}
+
+
+void FileMemory::forceValidatedAt(time_t t) {
+    validated_at = t;
+}
+
+
+void FileMemory::close() {
+    if (!is_open) {
+        return;
+    }
+
+    // handles that outlive the file become invalid
+    for (const auto &block : blocks.all()) {
+        BlockMemory::dropBlock(*block);
+    }
+    for (const auto &section : sections.all()) {
+        dropSection(section);
+    }
+    blocks = NodeList<BlockNode>();
+    sections = NodeList<SectionNode>();
+    section_index.clear();
+    metadata_snapshot.reset();
+    is_open = false;
+}
+
+
+bool FileMemory::isOpen() const {
+    return is_open;
+}
+
+
+FileMode FileMemory::fileMode() const {
+    return mode;
+}
+
+
+void FileMemory::startSwmrWrite() {
+    throw std::runtime_error("FileMemory::startSwmrWrite: files in memory do not support SWMR");
+}
+
+
+Compression FileMemory::compression() const {
+    return compr;
+}
+
+
+FileMemory::~FileMemory() {}
+
+} // ns nix::memory
+} // ns nix
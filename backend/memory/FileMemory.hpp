@@ -0,0 +1,214 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_FILE_MEMORY_H
+#define NIX_FILE_MEMORY_H
+
+#include <nix/base/IFile.hpp>
+
+#include "Nodes.hpp"
+
+#include <string>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace nix {
+namespace memory {
+
+/**
+ * A NIX file that lives in memory only: every entity is a node in plain
+ * containers, looked up by hash. An HDF5 file can be read in when the
+ * file is opened and the file can be written out as HDF5 at any time.
+ */
+class FileMemory : public base::IFile, public std::enable_shared_from_this<FileMemory> {
+
+private:
+
+    std::string                                                 name;
+    FileMode                                                    mode;
+    Compression                                                 compr;
+    bool                                                        is_open;
+
+    time_t                                                      created_at;
+    time_t                                                      updated_at;
+    time_t                                                      validated_at;
+
+    NodeList<BlockNode>                                         blocks;
+    NodeList<SectionNode>                                       sections;
+    // every section of the file, nested ones included, by id
+    std::unordered_map<std::string, std::weak_ptr<SectionNode>> section_index;
+
+    std::shared_ptr<const MetadataSnapshot>                     metadata_snapshot;
+
+public:
+
+    /**
+     * Create a new, empty file; name is only used as its location.
+     */
+    FileMemory(const std::string &name, FileMode mode, Compression compression);
+
+    /**
+     * Open a file in memory: an existing HDF5 file is read in completely
+     * unless mode is FileMode::Overwrite, changes to it are not written
+     * back, see {@link saveAs}.
+     */
+    static std::shared_ptr<FileMemory> open(const std::string &name, FileMode mode, Compression compression);
+
+    /**
+     * Write the current state of the file to an HDF5 file at path.
+     */
+    void saveAs(const std::string &path) const;
+
+    /**
+     * The image of the file as an HDF5 file.
+     */
+    std::vector<char> image() const;
+
+    //--------------------------------------------------
+    // Methods concerning blocks
+    //--------------------------------------------------
+
+    bool flush();
+
+
+    ndsize_t blockCount() const;
+
+
+    bool hasBlock(const std::string &name_or_id) const;
+
+
+    std::shared_ptr<base::IBlock> getBlock(const std::string &name_or_id) const;
+
+
+    std::shared_ptr<base::IBlock> getBlock(ndsize_t index) const;
+
+
+    std::shared_ptr<base::IBlock> createBlock(const std::string &name, const std::string &type);
+
+
+    bool deleteBlock(const std::string &name_or_id);
+
+    //--------------------------------------------------
+    // Methods concerning sections
+    //--------------------------------------------------
+
+    bool hasSection(const std::string &name_or_id) const;
+
+
+    std::shared_ptr<base::ISection> getSection(const std::string &name_or_id) const;
+
+
+    std::shared_ptr<base::ISection> getSection(ndsize_t index) const;
+
+
+    ndsize_t sectionCount() const;
+
+
+    std::shared_ptr<base::ISection> createSection(const std::string &name, const std::string &type);
+
+
+    bool deleteSection(const std::string &name_or_id);
+
+
+    std::shared_ptr<const MetadataSnapshot> metadataSnapshot() const;
+
+
+    void metadataSnapshot(const std::shared_ptr<const MetadataSnapshot> &snapshot);
+
+    //--------------------------------------------------
+    // Methods for file attribute access.
+    //--------------------------------------------------
+
+    std::vector<int> version() const;
+
+
+    std::string format() const;
+
+
+    std::string location() const;
+
+
+    time_t createdAt() const;
+
+
+    time_t updatedAt() const;
+
+
+    void setUpdatedAt();
+
+
+    void forceUpdatedAt();
+
+
+    void setCreatedAt();
+
+
+    void forceCreatedAt(time_t t);
+
+
+    time_t validatedAt() const;
+
+
+    void forceValidatedAt(time_t t);
+
+
+    void close();
+
+
+    bool isOpen() const;
+
+
+    FileMode fileMode() const;
+
+
+    void startSwmrWrite();
+
+
+    Compression compression() const;
+
+    //--------------------------------------------------
+    // Access to the nodes, for the entities of the file
+    //--------------------------------------------------
+
+    /**
+     * Any section of the file by id, or null.
+     */
+    std::shared_ptr<SectionNode> findSection(const std::string &id) const;
+
+
+    void indexSection(const std::shared_ptr<SectionNode> &section);
+
+    /**
+     * Mark the section and its sub-sections deleted and forget them.
+     */
+    void dropSection(const std::shared_ptr<SectionNode> &section);
+
+
+    void addBlock(const std::shared_ptr<BlockNode> &block);
+
+
+    void addSection(const std::shared_ptr<SectionNode> &section);
+
+
+    virtual ~FileMemory();
+
+private:
+
+    std::shared_ptr<BlockNode> findBlock(const std::string &name_or_id) const;
+
+
+    std::shared_ptr<SectionNode> findTopSection(const std::string &name_or_id) const;
+
+};
+
+
+} // namespace memory
+} // namespace nix
+
+#endif // NIX_FILE_MEMORY_H
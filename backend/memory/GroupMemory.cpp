@@ -0,0 +1,160 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "GroupMemory.hpp"
+
+#include "DataArrayMemory.hpp"
+#include "DataFrameMemory.hpp"
+#include "TagMemory.hpp"
+#include "MultiTagMemory.hpp"
+
+using namespace std;
+using namespace nix::base;
+
+namespace nix {
+namespace memory {
+
+namespace {
+
+template<typename T>
+bool remove_ref(RefList<T> &refs, const nix::Identity &ident) {
+    shared_ptr<T> node = findRef(refs, ident);
+    return node ? refs.remove(node->id) : false;
+}
+
+
+template<typename T>
+void add_ref(RefList<T> &refs, const NodeList<T> &nodes, const nix::Identity &ident) {
+    shared_ptr<T> node = findNode(nodes, ident);
+    if (!node) {
+        throw std::runtime_error("Entity does not exist in this block!");
+    }
+    refs.add(node);
+}
+
+
+template<typename H, typename T>
+shared_ptr<IEntity> make_entity(const shared_ptr<FileMemory> &file, const shared_ptr<BlockNode> &block,
+                                const shared_ptr<T> &node) {
+    return node ? make_shared<H>(file, block, node) : shared_ptr<H>();
+}
+
+} // namespace
+
+
+GroupMemory::GroupMemory(const shared_ptr<FileMemory> &file, const shared_ptr<BlockNode> &block,
+                         const shared_ptr<GroupNode> &node)
+    : EntityWithSourcesMemory(file, block, node)
+{
+}
+
+
+bool GroupMemory::hasEntity(const nix::Identity &ident) const {
+    return getEntity(ident) != nullptr;
+}
+
+
+shared_ptr<IEntity> GroupMemory::getEntity(const nix::Identity &ident) const {
+    shared_ptr<GroupNode> g = node<GroupNode>();
+
+    switch (ident.type()) {
+    case ObjectType::DataArray:
+        return make_entity<DataArrayMemory>(file(), blockNode(), findRef(g->data_arrays, ident));
+    case ObjectType::DataFrame:
+        return make_entity<DataFrameMemory>(file(), blockNode(), findRef(g->data_frames, ident));
+    case ObjectType::Tag:
+        return make_entity<TagMemory>(file(), blockNode(), findRef(g->tags, ident));
+    case ObjectType::MultiTag:
+        return make_entity<MultiTagMemory>(file(), blockNode(), findRef(g->multi_tags, ident));
+    default:
+        return shared_ptr<IEntity>();
+    }
+}
+
+
+shared_ptr<IEntity> GroupMemory::getEntity(ObjectType type, ndsize_t index) const {
+    shared_ptr<GroupNode> g = node<GroupNode>();
+
+    switch (type) {
+    case ObjectType::DataArray:
+        return make_entity<DataArrayMemory>(file(), blockNode(), g->data_arrays.at(index));
+    case ObjectType::DataFrame:
+        return make_entity<DataFrameMemory>(file(), blockNode(), g->data_frames.at(index));
+    case ObjectType::Tag:
+        return make_entity<TagMemory>(file(), blockNode(), g->tags.at(index));
+    case ObjectType::MultiTag:
+        return make_entity<MultiTagMemory>(file(), blockNode(), g->multi_tags.at(index));
+    default:
+        return shared_ptr<IEntity>();
+    }
+}
+
+
+ndsize_t GroupMemory::entityCount(ObjectType type) const {
+    shared_ptr<GroupNode> g = node<GroupNode>();
+
+    switch (type) {
+    case ObjectType::DataArray:
+        return g->data_arrays.size();
+    case ObjectType::DataFrame:
+        return g->data_frames.size();
+    case ObjectType::Tag:
+        return g->tags.size();
+    case ObjectType::MultiTag:
+        return g->multi_tags.size();
+    default:
+        return 0;
+    }
+}
+
+
+bool GroupMemory::removeEntity(const nix::Identity &ident) {
+    shared_ptr<GroupNode> g = node<GroupNode>();
+
+    switch (ident.type()) {
+    case ObjectType::DataArray:
+        return remove_ref(g->data_arrays, ident);
+    case ObjectType::DataFrame:
+        return remove_ref(g->data_frames, ident);
+    case ObjectType::Tag:
+        return remove_ref(g->tags, ident);
+    case ObjectType::MultiTag:
+        return remove_ref(g->multi_tags, ident);
+    default:
+        return false;
+    }
+}
+
+
+void GroupMemory::addEntity(const nix::Identity &ident) {
+    shared_ptr<GroupNode> g = node<GroupNode>();
+    shared_ptr<BlockNode> b = blockNode();
+
+    switch (ident.type()) {
+    case ObjectType::DataArray:
+        add_ref(g->data_arrays, b->data_arrays, ident);
+        break;
+    case ObjectType::DataFrame:
+        add_ref(g->data_frames, b->data_frames, ident);
+        break;
+    case ObjectType::Tag:
+        add_ref(g->tags, b->tags, ident);
+        break;
+    case ObjectType::MultiTag:
+        add_ref(g->multi_tags, b->multi_tags, ident);
+        break;
+    default:
+        throw std::runtime_error("Entity does not exist in this block!");
+    }
+}
+
+
+GroupMemory::~GroupMemory() {}
+
+} // ns nix::memory
+} // ns nix
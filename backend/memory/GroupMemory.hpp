@@ -0,0 +1,57 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_GROUP_MEMORY_H
+#define NIX_GROUP_MEMORY_H
+
+#include <nix/base/IGroup.hpp>
+#include "EntityWithSourcesMemory.hpp"
+
+namespace nix {
+namespace memory {
+
+/**
+ * Class that represents a NIX Group entity.
+ */
+class GroupMemory : virtual public base::IGroup, public EntityWithSourcesMemory {
+
+public:
+
+    GroupMemory(const std::shared_ptr<FileMemory> &file, const std::shared_ptr<BlockNode> &block,
+                const std::shared_ptr<GroupNode> &node);
+
+    //--------------------------------------------------
+    // Generic entity methods
+    //--------------------------------------------------
+
+    bool hasEntity(const nix::Identity &ident) const;
+
+
+    std::shared_ptr<base::IEntity> getEntity(const nix::Identity &ident) const;
+
+
+    std::shared_ptr<base::IEntity> getEntity(ObjectType type, ndsize_t index) const;
+
+
+    ndsize_t entityCount(ObjectType type) const;
+
+
+    bool removeEntity(const nix::Identity &ident);
+
+
+    void addEntity(const nix::Identity &ident);
+
+
+    virtual ~GroupMemory();
+
+};
+
+} // namespace memory
+} // namespace nix
+
+#endif // NIX_GROUP_MEMORY_H
@@ -0,0 +1,99 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "MultiTagMemory.hpp"
+
+#include "DataArrayMemory.hpp"
+
+using namespace std;
+using namespace nix::base;
+
+namespace nix {
+namespace memory {
+
+
+MultiTagMemory::MultiTagMemory(const shared_ptr<FileMemory> &file, const shared_ptr<BlockNode> &block,
+                               const shared_ptr<MultiTagNode> &node)
+    : BaseTagMemory(file, block, node)
+{
+}
+
+
+shared_ptr<IDataArray> MultiTagMemory::positions() const {
+    shared_ptr<DataArrayNode> da = live(node<MultiTagNode>()->positions);
+    if (!da) {
+        throw std::runtime_error("MultiTagMemory::positions: DataArray not found!");
+    }
+    return make_shared<DataArrayMemory>(file(), blockNode(), da);
+}
+
+
+void MultiTagMemory::positions(const string &name_or_id) {
+    shared_ptr<DataArrayNode> da = findNode(blockNode()->data_arrays, {name_or_id, ObjectType::DataArray});
+    if (!da) {
+        throw std::runtime_error("MultiTagMemory::positions: DataArray not found in block!");
+    }
+    node<MultiTagNode>()->positions = da;
+    forceUpdatedAt();
+}
+
+
+bool MultiTagMemory::hasPositions() const {
+    return live(node<MultiTagNode>()->positions) != nullptr;
+}
+
+
+shared_ptr<IDataArray> MultiTagMemory::extents() const {
+    shared_ptr<DataArrayNode> da = live(node<MultiTagNode>()->extents);
+    return da ? make_shared<DataArrayMemory>(file(), blockNode(), da) : nullptr;
+}
+
+
+void MultiTagMemory::extents(const string &name_or_id) {
+    shared_ptr<DataArrayNode> da = findNode(blockNode()->data_arrays, {name_or_id, ObjectType::DataArray});
+    if (!da) {
+        throw std::runtime_error("MultiTagMemory::extents: DataArray not found in block!");
+    }
+    node<MultiTagNode>()->extents.reset();
+
+    DataArrayMemory extents(file(), blockNode(), da);
+    if (extents.dataExtent() != positions()->dataExtent()) {
+        throw std::runtime_error("MultiTagMemory::extents: cannot set Extent because dimensionality of extent and position data do not match!");
+    }
+    node<MultiTagNode>()->extents = da;
+    forceUpdatedAt();
+}
+
+
+void MultiTagMemory::extents(const none_t t) {
+    node<MultiTagNode>()->extents.reset();
+    forceUpdatedAt();
+}
+
+
+vector<string> MultiTagMemory::units() const {
+    return node<MultiTagNode>()->units;
+}
+
+
+void MultiTagMemory::units(const vector<string> &units) {
+    node<MultiTagNode>()->units = units;
+    forceUpdatedAt();
+}
+
+
+void MultiTagMemory::units(const none_t t) {
+    node<MultiTagNode>()->units.clear();
+    forceUpdatedAt();
+}
+
+
+MultiTagMemory::~MultiTagMemory() {}
+
+} // ns nix::memory
+} // ns nix
@@ -0,0 +1,66 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_MULTI_TAG_MEMORY_H
+#define NIX_MULTI_TAG_MEMORY_H
+
+#include <nix/base/IMultiTag.hpp>
+#include "BaseTagMemory.hpp"
+
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace nix {
+namespace memory {
+
+
+class MultiTagMemory : public BaseTagMemory, virtual public base::IMultiTag {
+
+public:
+
+    MultiTagMemory(const std::shared_ptr<FileMemory> &file, const std::shared_ptr<BlockNode> &block,
+                   const std::shared_ptr<MultiTagNode> &node);
+
+
+    std::shared_ptr<base::IDataArray> positions() const;
+
+
+    void positions(const std::string &name_or_id);
+
+
+    bool hasPositions() const;
+
+
+    std::shared_ptr<base::IDataArray> extents() const;
+
+
+    void extents(const std::string &name_or_id);
+
+
+    void extents(const none_t t);
+
+
+    std::vector<std::string> units() const;
+
+
+    void units(const std::vector<std::string> &units);
+
+
+    void units(const none_t t);
+
+
+    virtual ~MultiTagMemory();
+
+};
+
+
+} // namespace memory
+} // namespace nix
+
+#endif // NIX_MULTI_TAG_MEMORY_H
@@ -0,0 +1,84 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "NamedEntityMemory.hpp"
+
+#include <nix/Exception.hpp>
+
+using namespace std;
+using namespace nix::base;
+
+namespace nix {
+namespace memory {
+
+
+NamedEntityMemory::NamedEntityMemory(const shared_ptr<FileMemory> &file, const shared_ptr<NamedNode> &node)
+    : EntityMemory(file, node)
+{
+}
+
+
+void NamedEntityMemory::type(const string &type) {
+    if (type.empty()) {
+        throw EmptyString("type");
+    }
+    node<NamedNode>()->type = type;
+    forceUpdatedAt();
+}
+
+
+string NamedEntityMemory::type() const {
+    const string &type = node<NamedNode>()->type;
+    if (type.empty()) {
+        throw MissingAttr("type");
+    }
+    return type;
+}
+
+
+string NamedEntityMemory::name() const {
+    return node<NamedNode>()->name;
+}
+
+
+void NamedEntityMemory::definition(const string &definition) {
+    if (definition.empty()) {
+        throw EmptyString("definition");
+    }
+    node<NamedNode>()->definition = definition;
+    forceUpdatedAt();
+}
+
+
+boost::optional<string> NamedEntityMemory::definition() const {
+    return node<NamedNode>()->definition;
+}
+
+
+void NamedEntityMemory::definition(const nix::none_t t) {
+    node<NamedNode>()->definition = boost::none;
+    forceUpdatedAt();
+}
+
+
+int NamedEntityMemory::compare(const std::shared_ptr<INamedEntity> &other) const {
+    int cmp = 0;
+    if (!name().empty() && !other->name().empty()) {
+        cmp = (name()).compare(other->name());
+    }
+    if (cmp == 0) {
+        cmp = id().compare(other->id());
+    }
+    return cmp;
+}
+
+
+NamedEntityMemory::~NamedEntityMemory() {}
+
+} // ns nix::memory
+} // ns nix
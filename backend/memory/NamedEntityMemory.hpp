@@ -0,0 +1,61 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_NAMED_ENTITY_MEMORY_H
+#define NIX_NAMED_ENTITY_MEMORY_H
+
+#include <nix/base/INamedEntity.hpp>
+#include "EntityMemory.hpp"
+
+#include <string>
+#include <memory>
+
+namespace nix {
+namespace memory {
+
+
+/**
+ * Base class for all named entities of the memory backend.
+ */
+class NamedEntityMemory : virtual public base::INamedEntity, public EntityMemory {
+
+public:
+
+    NamedEntityMemory(const std::shared_ptr<FileMemory> &file, const std::shared_ptr<NamedNode> &node);
+
+
+    void type(const std::string &type);
+
+
+    std::string type() const;
+
+
+    std::string name() const;
+
+
+    void definition(const std::string &definition);
+
+
+    boost::optional<std::string> definition() const;
+
+
+    void definition(const none_t t);
+
+
+    int compare(const std::shared_ptr<INamedEntity> &other) const;
+
+
+    virtual ~NamedEntityMemory();
+
+};
+
+
+} // namespace memory
+} // namespace nix
+
+#endif // NIX_NAMED_ENTITY_MEMORY_H
@@ -0,0 +1,452 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_NODES_MEMORY_H
+#define NIX_NODES_MEMORY_H
+
+#include <nix/base/IDimensions.hpp>
+#include <nix/base/IFeature.hpp>
+#include <nix/base/IDataFrame.hpp>
+#include <nix/Compression.hpp>
+#include <nix/Exception.hpp>
+#include <nix/Identity.hpp>
+#include <nix/NDSize.hpp>
+#include <nix/util/util.hpp>
+
+#include "DataStore.hpp"
+
+#include <boost/optional.hpp>
+
+#include <algorithm>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace nix {
+namespace memory {
+
+/*
+ * The entities of a memory file. The handles of the backend (BlockMemory,
+ * DataArrayMemory, ...) are thin views on these nodes, so that every
+ * handle of the same entity sees the same state.
+ */
+
+struct EntityNode {
+    std::string id;
+    time_t      created_at = 0;
+    time_t      updated_at = 0;
+    bool        deleted = false;
+
+    virtual ~EntityNode() {}
+};
+
+
+struct NamedNode : public EntityNode {
+    std::string                  name;
+    std::string                  type;
+    boost::optional<std::string> definition;
+};
+
+
+struct SectionNode;
+struct SourceNode;
+struct DataArrayNode;
+struct DataFrameNode;
+struct TagNode;
+struct MultiTagNode;
+struct FeatureNode;
+struct GroupNode;
+struct PropertyNode;
+
+
+inline const std::string &nodeName(const NamedNode &node) {
+    return node.name;
+}
+
+
+/**
+ * Owned child entities in creation order, with hash lookups by name and id.
+ */
+template<typename T>
+class NodeList {
+
+private:
+
+    std::vector<std::shared_ptr<T>>                         items;
+    std::unordered_map<std::string, std::shared_ptr<T>>     by_name;
+    std::unordered_map<std::string, std::shared_ptr<T>>     by_id;
+
+public:
+
+    size_t size() const {
+        return items.size();
+    }
+
+    const std::vector<std::shared_ptr<T>> &all() const {
+        return items;
+    }
+
+    std::shared_ptr<T> at(ndsize_t index) const {
+        if (index >= items.size()) {
+            throw OutOfBounds("No object at given index", index);
+        }
+        return items[static_cast<size_t>(index)];
+    }
+
+    std::shared_ptr<T> byName(const std::string &name) const {
+        auto it = by_name.find(name);
+        return it == by_name.end() ? nullptr : it->second;
+    }
+
+    std::shared_ptr<T> byId(const std::string &id) const {
+        auto it = by_id.find(id);
+        return it == by_id.end() ? nullptr : it->second;
+    }
+
+    /**
+     * Look the node up by name first, then by id.
+     */
+    std::shared_ptr<T> find(const std::string &name_or_id) const {
+        std::shared_ptr<T> node = byName(name_or_id);
+        return node ? node : byId(name_or_id);
+    }
+
+    void add(const std::shared_ptr<T> &node) {
+        items.push_back(node);
+        by_name[nodeName(*node)] = node;
+        by_id[node->id] = node;
+    }
+
+    /**
+     * Remove the node and mark it deleted, so that handles to it become invalid.
+     */
+    void erase(const std::shared_ptr<T> &node) {
+        auto it = std::find(items.begin(), items.end(), node);
+        if (it == items.end()) {
+            return;
+        }
+        items.erase(it);
+        by_name.erase(nodeName(*node));
+        by_id.erase(node->id);
+        node->deleted = true;
+    }
+
+};
+
+
+/**
+ * Links to entities owned elsewhere in the order they were added, with a
+ * hash lookup by id. Deleting an entity removes it from every list.
+ */
+template<typename T>
+class RefList {
+
+private:
+
+    std::vector<std::weak_ptr<T>>                         items;
+    std::unordered_map<std::string, std::weak_ptr<T>>     by_id;
+
+public:
+
+    size_t size() const {
+        return items.size();
+    }
+
+    std::shared_ptr<T> at(ndsize_t index) const {
+        if (index >= items.size()) {
+            throw OutOfBounds("No object at given index", index);
+        }
+        return items[static_cast<size_t>(index)].lock();
+    }
+
+    std::shared_ptr<T> byId(const std::string &id) const {
+        auto it = by_id.find(id);
+        return it == by_id.end() ? nullptr : it->second.lock();
+    }
+
+    std::shared_ptr<T> byName(const std::string &name) const {
+        for (const std::weak_ptr<T> &item : items) {
+            std::shared_ptr<T> node = item.lock();
+            if (node && nodeName(*node) == name) {
+                return node;
+            }
+        }
+        return nullptr;
+    }
+
+    bool has(const std::string &id) const {
+        return by_id.count(id) > 0;
+    }
+
+    void add(const std::shared_ptr<T> &node) {
+        if (has(node->id)) {
+            return;
+        }
+        items.push_back(node);
+        by_id[node->id] = node;
+    }
+
+    bool remove(const std::string &id) {
+        if (by_id.erase(id) == 0) {
+            return false;
+        }
+        items.erase(std::remove_if(items.begin(), items.end(), [&id](const std::weak_ptr<T> &item) {
+            std::shared_ptr<T> node = item.lock();
+            return !node || node->id == id;
+        }), items.end());
+        return true;
+    }
+
+    void clear() {
+        items.clear();
+        by_id.clear();
+    }
+
+};
+
+
+/**
+ * Look up an entity a block owns like the HDF5 backend does: by the
+ * name if one is given, by the id otherwise; if both are given they
+ * must belong to the same entity.
+ */
+template<typename T>
+std::shared_ptr<T> findNode(const NodeList<T> &nodes, const nix::Identity &ident) {
+    const std::string &iname = ident.name();
+    const std::string &iid = ident.id();
+
+    std::shared_ptr<T> node;
+    if (!iname.empty()) {
+        node = nodes.byName(iname);
+    }
+    if (!node && !iid.empty()) {
+        node = nodes.byId(iid);
+    }
+    if (node && !iname.empty() && !iid.empty() && (node->id != iid || nodeName(*node) != iname)) {
+        return nullptr;
+    }
+    return node;
+}
+
+
+/**
+ * Look up a linked entity, by the id if one is given, by the name
+ * otherwise; if both are given they must belong to the same entity.
+ */
+template<typename T>
+std::shared_ptr<T> findRef(const RefList<T> &refs, const nix::Identity &ident) {
+    const std::string &iname = ident.name();
+    const std::string &iid = ident.id();
+
+    std::shared_ptr<T> node;
+    if (!iid.empty()) {
+        node = refs.byId(iid);
+    }
+    if (!node && !iname.empty()) {
+        node = refs.byName(iname);
+    }
+    if (node && !iname.empty() && !iid.empty() && (node->id != iid || nodeName(*node) != iname)) {
+        return nullptr;
+    }
+    return node;
+}
+
+
+/**
+ * A weak link that breaks when the target is deleted.
+ */
+template<typename T>
+std::shared_ptr<T> live(const std::weak_ptr<T> &link) {
+    std::shared_ptr<T> node = link.lock();
+    return node && !node->deleted ? node : nullptr;
+}
+
+
+struct MetadataNode : public NamedNode {
+    std::weak_ptr<SectionNode> metadata;
+};
+
+
+struct SourcesNode : public MetadataNode {
+    RefList<SourceNode> sources;
+};
+
+
+struct SourceNode : public MetadataNode {
+    NodeList<SourceNode> sources;
+};
+
+
+struct DimensionNode {
+    DimensionType                        type;
+    boost::optional<std::string>         label;
+    boost::optional<std::string>         unit;
+    boost::optional<double>              sampling_interval;
+    boost::optional<double>              offset;
+    std::vector<std::string>             labels;
+    boost::optional<std::vector<double>> ticks;
+    // the DataArray an alias range dimension takes label, unit and ticks from
+    std::weak_ptr<DataArrayNode>         alias;
+
+    explicit DimensionNode(DimensionType type) : type(type) {}
+};
+
+
+/**
+ * The box of another DataArray a virtual DataArray maps.
+ */
+struct VirtualSlab {
+    std::shared_ptr<DataArrayNode> source;
+    NDSize                         count;
+    NDSize                         source_offset;
+    NDSize                         offset;
+};
+
+
+struct DataArrayNode : public SourcesNode {
+    boost::optional<std::string>                label;
+    boost::optional<std::string>                unit;
+    boost::optional<double>                     expansion_origin;
+    std::vector<double>                         polynom;
+    std::vector<std::shared_ptr<DimensionNode>> dimensions;
+
+    std::unique_ptr<DataStore>                  data;
+    Compression                                 compression = Compression::None;
+
+    // a virtual DataArray holds no data of its own
+    bool                                        is_virtual = false;
+    DataType                                    virtual_dtype = DataType::Nothing;
+    NDSize                                      virtual_extent;
+    std::vector<VirtualSlab>                    slabs;
+
+    ndsize_t                                    envelope_factor = 0;
+    std::vector<std::vector<double>>            envelopes;
+
+    time_t                                      extent_stamped = 0;
+};
+
+
+struct BaseTagNode : public SourcesNode {
+    RefList<DataArrayNode> references;
+    NodeList<FeatureNode>  features;
+};
+
+
+struct TagNode : public BaseTagNode {
+    std::vector<double>      position;
+    std::vector<double>      extent;
+    std::vector<std::string> units;
+};
+
+
+struct MultiTagNode : public BaseTagNode {
+    std::weak_ptr<DataArrayNode> positions;
+    std::weak_ptr<DataArrayNode> extents;
+    std::vector<std::string>     units;
+};
+
+
+struct FeatureNode : public EntityNode {
+    boost::optional<LinkType>    link_type;
+    std::weak_ptr<DataArrayNode> data;
+};
+
+
+inline const std::string &nodeName(const FeatureNode &node) {
+    return node.id;
+}
+
+
+struct GroupNode : public SourcesNode {
+    RefList<DataArrayNode> data_arrays;
+    RefList<DataFrameNode> data_frames;
+    RefList<TagNode>       tags;
+    RefList<MultiTagNode>  multi_tags;
+};
+
+
+struct DataFrameNode : public SourcesNode {
+    std::vector<Column>                       columns;
+    std::vector<DataStore>                    cells;
+    std::unordered_map<std::string, unsigned> col_index;
+    ndsize_t                                  rows = 0;
+    Compression                               compression = Compression::None;
+};
+
+
+struct BlockNode : public MetadataNode {
+    NodeList<SourceNode>    sources;
+    NodeList<DataArrayNode> data_arrays;
+    NodeList<DataFrameNode> data_frames;
+    NodeList<TagNode>       tags;
+    NodeList<MultiTagNode>  multi_tags;
+    NodeList<GroupNode>     groups;
+
+    // every source of the block, nested ones included, by id
+    std::unordered_map<std::string, std::weak_ptr<SourceNode>> source_index;
+
+    Compression             compression = Compression::None;
+};
+
+
+struct PropertyNode : public EntityNode {
+    std::string                  name;
+    boost::optional<std::string> definition;
+    boost::optional<std::string> unit;
+    boost::optional<double>      uncertainty;
+    DataStore                    values;
+
+    PropertyNode(DataType dtype, const StringStorage &strings)
+        : values(dtype, {0}, strings) {}
+};
+
+
+inline const std::string &nodeName(const PropertyNode &node) {
+    return node.name;
+}
+
+
+struct SectionNode : public NamedNode {
+    boost::optional<std::string> repository;
+    std::weak_ptr<SectionNode>   link;
+    std::weak_ptr<SectionNode>   parent;
+    NodeList<SectionNode>        sections;
+    NodeList<PropertyNode>       properties;
+};
+
+/**
+ * A new entity with a fresh id, created now.
+ */
+template<typename T>
+std::shared_ptr<T> makeNode(std::shared_ptr<T> node) {
+    node->id = util::createId();
+    node->created_at = node->updated_at = util::getTime();
+    return node;
+}
+
+
+template<typename T>
+std::shared_ptr<T> makeNode(const std::string &name, const std::string &type) {
+    if (name.empty()) {
+        throw EmptyString("name");
+    }
+    if (type.empty()) {
+        throw EmptyString("type");
+    }
+    std::shared_ptr<T> node = makeNode(std::make_shared<T>());
+    node->name = name;
+    node->type = type;
+    return node;
+}
+
+} // namespace memory
+} // namespace nix
+
+#endif // NIX_NODES_MEMORY_H
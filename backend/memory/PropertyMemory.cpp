@@ -0,0 +1,170 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "PropertyMemory.hpp"
+
+#include <cstring>
+
+using namespace std;
+using namespace nix::base;
+
+namespace nix {
+namespace memory {
+
+
+PropertyMemory::PropertyMemory(const shared_ptr<FileMemory> &file, const shared_ptr<PropertyNode> &node)
+    : EntityMemory(file, node)
+{
+}
+
+
+string PropertyMemory::name() const {
+    return node<PropertyNode>()->name;
+}
+
+
+boost::optional<string> PropertyMemory::definition() const {
+    return node<PropertyNode>()->definition;
+}
+
+
+void PropertyMemory::definition(const string &definition) {
+    node<PropertyNode>()->definition = definition;
+    forceUpdatedAt();
+}
+
+
+void PropertyMemory::definition(const none_t t) {
+    node<PropertyNode>()->definition = boost::none;
+    forceUpdatedAt();
+}
+
+
+DataType PropertyMemory::dataType() const {
+    return node<PropertyNode>()->values.dataType();
+}
+
+
+StringStorage PropertyMemory::stringStorage() const {
+    return node<PropertyNode>()->values.stringStorage();
+}
+
+
+void PropertyMemory::unit(const string &unit) {
+    node<PropertyNode>()->unit = unit;
+    forceUpdatedAt();
+}
+
+
+boost::optional<string> PropertyMemory::unit() const {
+    return node<PropertyNode>()->unit;
+}
+
+
+void PropertyMemory::unit(const none_t t) {
+    node<PropertyNode>()->unit = boost::none;
+    forceUpdatedAt();
+}
+
+
+void PropertyMemory::uncertainty(double uncertainty) {
+    node<PropertyNode>()->uncertainty = uncertainty;
+    forceUpdatedAt();
+}
+
+
+boost::optional<double> PropertyMemory::uncertainty() const {
+    return node<PropertyNode>()->uncertainty;
+}
+
+
+void PropertyMemory::uncertainty(const none_t t) {
+    node<PropertyNode>()->uncertainty = boost::none;
+    forceUpdatedAt();
+}
+
+
+void PropertyMemory::deleteValues() {
+    node<PropertyNode>()->values.extent({0});
+}
+
+
+ndsize_t PropertyMemory::valueCount() const {
+    return node<PropertyNode>()->values.extent()[0];
+}
+
+
+void PropertyMemory::values(const vector<Variant> &values) {
+    if (values.size() < 1) {
+        deleteValues();
+        return;
+    }
+
+    DataStore &store = node<PropertyNode>()->values;
+    for (const Variant &v : values) {
+        if (v.type() != store.dataType()) {
+            throw std::invalid_argument("Inconsistent DataTypes!");
+        }
+    }
+
+    const StringStorage strings = store.stringStorage();
+    if (strings.mode == StringStorage::Mode::Fixed) {
+        // check all lengths before changing the extent
+        for (const Variant &v : values) {
+            if (std::strlen(v.get<const char *>()) > strings.length) {
+                throw std::invalid_argument("Property value exceeds fixed length of " +
+                                            std::to_string(strings.length) + " bytes");
+            }
+        }
+    }
+
+    store.extent({values.size()});
+    store.values(values, 0);
+}
+
+
+vector<Variant> PropertyMemory::values(void) const {
+    const DataStore &store = node<PropertyNode>()->values;
+    return store.values(0, store.extent()[0]);
+}
+
+
+void PropertyMemory::values(const nix::none_t t) {
+    deleteValues();
+}
+
+
+void PropertyMemory::readValues(DataType dtype, void *data, ndsize_t count, ndsize_t offset) const {
+    node<PropertyNode>()->values.read(dtype, data, {count}, {offset});
+}
+
+
+void PropertyMemory::writeValues(DataType dtype, const void *data, ndsize_t count, ndsize_t offset) {
+    DataStore &store = node<PropertyNode>()->values;
+    if (dtype != store.dataType()) {
+        throw std::invalid_argument("Inconsistent DataTypes!");
+    }
+
+    const ndsize_t before = valueCount();
+    if (offset + count > before) {
+        store.extent({offset + count});
+    }
+
+    try {
+        store.write(dtype, data, {count}, {offset});
+    } catch (...) {
+        store.extent({before});
+        throw;
+    }
+}
+
+
+PropertyMemory::~PropertyMemory() {}
+
+} // ns nix::memory
+} // ns nix
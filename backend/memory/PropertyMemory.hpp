@@ -0,0 +1,99 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_PROPERTY_MEMORY_H
+#define NIX_PROPERTY_MEMORY_H
+
+#include <nix/base/IProperty.hpp>
+#include "EntityMemory.hpp"
+
+#include <string>
+#include <memory>
+
+namespace nix {
+namespace memory {
+
+
+/**
+ * A Property whose values are one DataStore.
+ */
+class PropertyMemory : virtual public base::IProperty, public EntityMemory {
+
+public:
+
+    PropertyMemory(const std::shared_ptr<FileMemory> &file, const std::shared_ptr<PropertyNode> &node);
+
+
+    std::string name() const;
+
+
+    boost::optional<std::string> definition() const;
+
+
+    void definition(const std::string &definition);
+
+
+    void definition(const none_t t);
+
+
+    DataType dataType() const;
+
+    /**
+     * How the values are stored, e.g. to write the property out again.
+     */
+    StringStorage stringStorage() const;
+
+
+    void unit(const std::string &unit);
+
+
+    boost::optional<std::string> unit() const;
+
+
+    void unit(const none_t t);
+
+
+    void uncertainty(double uncertainty);
+
+
+    boost::optional<double> uncertainty() const;
+
+
+    void uncertainty(const none_t t);
+
+
+    void deleteValues();
+
+
+    ndsize_t valueCount() const;
+
+
+    void values(const std::vector<Variant> &values);
+
+
+    std::vector<Variant> values(void) const;
+
+
+    void values(const boost::none_t t);
+
+
+    void readValues(DataType dtype, void *data, ndsize_t count, ndsize_t offset) const;
+
+
+    void writeValues(DataType dtype, const void *data, ndsize_t count, ndsize_t offset);
+
+
+    virtual ~PropertyMemory();
+
+};
+
+
+} // namespace memory
+} // namespace nix
+
+#endif // NIX_PROPERTY_MEMORY_H
@@ -0,0 +1,219 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "SectionMemory.hpp"
+
+#include <nix/util/util.hpp>
+#include "FileMemory.hpp"
+#include "PropertyMemory.hpp"
+
+using namespace std;
+using namespace nix::base;
+
+namespace nix {
+namespace memory {
+
+
+SectionMemory::SectionMemory(const shared_ptr<FileMemory> &file, const shared_ptr<SectionNode> &node)
+    : NamedEntityMemory(file, node)
+{
+}
+
+
+void SectionMemory::forceUpdatedAt() {
+    NamedEntityMemory::forceUpdatedAt();
+    file()->metadataSnapshot(nullptr);
+}
+
+
+void SectionMemory::repository(const string &repository) {
+    node<SectionNode>()->repository = repository;
+    forceUpdatedAt();
+}
+
+
+boost::optional<string> SectionMemory::repository() const {
+    return node<SectionNode>()->repository;
+}
+
+
+void SectionMemory::repository(const none_t t) {
+    node<SectionNode>()->repository = boost::none;
+    forceUpdatedAt();
+}
+
+
+void SectionMemory::link(const string &id) {
+    shared_ptr<SectionNode> target = file()->findSection(id);
+    if (!target) {
+        throw std::runtime_error("SectionMemory::link: Section not found in file!");
+    }
+    node<SectionNode>()->link = target;
+    file()->metadataSnapshot(nullptr);
+}
+
+
+shared_ptr<ISection> SectionMemory::link() const {
+    shared_ptr<SectionNode> target = live(node<SectionNode>()->link);
+    return target ? make_shared<SectionMemory>(file(), target) : nullptr;
+}
+
+
+void SectionMemory::link(const none_t t) {
+    node<SectionNode>()->link.reset();
+    forceUpdatedAt();
+}
+
+
+shared_ptr<ISection> SectionMemory::parent() const {
+    shared_ptr<SectionNode> parent = live(node<SectionNode>()->parent);
+    return parent ? make_shared<SectionMemory>(file(), parent) : nullptr;
+}
+
+
+shared_ptr<SectionNode> SectionMemory::findSection(const string &name_or_id) const {
+    const NodeList<SectionNode> &sections = node<SectionNode>()->sections;
+    shared_ptr<SectionNode> section = sections.byName(name_or_id);
+    if (!section && util::looksLikeUUID(name_or_id)) {
+        section = sections.byId(name_or_id);
+    }
+    return section;
+}
+
+
+ndsize_t SectionMemory::sectionCount() const {
+    return node<SectionNode>()->sections.size();
+}
+
+
+bool SectionMemory::hasSection(const string &name_or_id) const {
+    return findSection(name_or_id) != nullptr;
+}
+
+
+shared_ptr<ISection> SectionMemory::getSection(const string &name_or_id) const {
+    shared_ptr<SectionNode> section = findSection(name_or_id);
+    return section ? make_shared<SectionMemory>(file(), section) : nullptr;
+}
+
+
+shared_ptr<ISection> SectionMemory::getSection(ndsize_t index) const {
+    return make_shared<SectionMemory>(file(), node<SectionNode>()->sections.at(index));
+}
+
+
+shared_ptr<ISection> SectionMemory::createSection(const string &name, const string &type) {
+    shared_ptr<SectionNode> section = makeNode<SectionNode>(name, type);
+    section->parent = node<SectionNode>();
+    node<SectionNode>()->sections.add(section);
+    file()->indexSection(section);
+    file()->metadataSnapshot(nullptr);
+    return make_shared<SectionMemory>(file(), section);
+}
+
+
+bool SectionMemory::deleteSection(const string &name_or_id) {
+    shared_ptr<SectionNode> section = findSection(name_or_id);
+    if (!section) {
+        return false;
+    }
+    file()->dropSection(section);
+    node<SectionNode>()->sections.erase(section);
+    file()->metadataSnapshot(nullptr);
+    return true;
+}
+
+
+shared_ptr<PropertyNode> SectionMemory::findProperty(const string &name_or_id) const {
+    const NodeList<PropertyNode> &properties = node<SectionNode>()->properties;
+    shared_ptr<PropertyNode> property = properties.byName(name_or_id);
+    if (!property && util::looksLikeUUID(name_or_id)) {
+        property = properties.byId(name_or_id);
+    }
+    return property;
+}
+
+
+ndsize_t SectionMemory::propertyCount() const {
+    return node<SectionNode>()->properties.size();
+}
+
+
+bool SectionMemory::hasProperty(const string &name_or_id) const {
+    return findProperty(name_or_id) != nullptr;
+}
+
+
+shared_ptr<IProperty> SectionMemory::getProperty(const string &name_or_id) const {
+    shared_ptr<PropertyNode> property = findProperty(name_or_id);
+    return property ? make_shared<PropertyMemory>(file(), property) : nullptr;
+}
+
+
+shared_ptr<IProperty> SectionMemory::getProperty(ndsize_t index) const {
+    return make_shared<PropertyMemory>(file(), node<SectionNode>()->properties.at(index));
+}
+
+
+shared_ptr<IProperty> SectionMemory::createProperty(const string &name, const DataType &dtype) {
+    return createProperty(name, dtype, StringStorage());
+}
+
+
+shared_ptr<IProperty> SectionMemory::createProperty(const string &name, const DataType &dtype,
+                                                    const StringStorage &strings) {
+    if (strings.mode == StringStorage::Mode::Dictionary) {
+        throw std::invalid_argument("Dictionary storage is not supported for properties");
+    }
+    if (name.empty()) {
+        throw EmptyString("name");
+    }
+
+    shared_ptr<PropertyNode> property = makeNode(make_shared<PropertyNode>(dtype, strings));
+    property->name = name;
+    node<SectionNode>()->properties.add(property);
+    file()->metadataSnapshot(nullptr);
+    return make_shared<PropertyMemory>(file(), property);
+}
+
+
+shared_ptr<IProperty> SectionMemory::createProperty(const string &name, const Variant &value) {
+    shared_ptr<IProperty> p = createProperty(name, value.type());
+    vector<Variant> val{value};
+    p->values(val);
+    return p;
+}
+
+
+shared_ptr<IProperty> SectionMemory::createProperty(const string &name, const vector<Variant> &values) {
+    shared_ptr<IProperty> p = createProperty(name, values[0].type());
+    p->values(values);
+    return p;
+}
+
+
+bool SectionMemory::deleteProperty(const string &name_or_id) {
+    shared_ptr<PropertyNode> property = findProperty(name_or_id);
+    if (!property) {
+        return false;
+    }
+    node<SectionNode>()->properties.erase(property);
+    file()->metadataSnapshot(nullptr);
+    return true;
+}
+
+
+shared_ptr<IFile> SectionMemory::parentFile() const {
+    return file();
+}
+
+
+SectionMemory::~SectionMemory() {}
+
+} // ns nix::memory
+} // ns nix
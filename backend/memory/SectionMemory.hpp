@@ -0,0 +1,135 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_SECTION_MEMORY_H
+#define NIX_SECTION_MEMORY_H
+
+#include <nix/base/ISection.hpp>
+#include "NamedEntityMemory.hpp"
+
+#include <string>
+#include <memory>
+
+namespace nix {
+namespace memory {
+
+
+/**
+ * Class that represents a NIX Section entity.
+ */
+class SectionMemory : virtual public base::ISection, public NamedEntityMemory {
+
+public:
+
+    SectionMemory(const std::shared_ptr<FileMemory> &file, const std::shared_ptr<SectionNode> &node);
+
+    //--------------------------------------------------
+    // Attribute getter and setter
+    //--------------------------------------------------
+
+    void repository(const std::string &repository);
+
+
+    boost::optional<std::string> repository() const;
+
+
+    void repository(const none_t t);
+
+
+    void link(const std::string &id);
+
+
+    std::shared_ptr<base::ISection> link() const;
+
+
+    void link(const none_t t);
+
+    //--------------------------------------------------
+    // Methods for parent access
+    //--------------------------------------------------
+
+    std::shared_ptr<base::ISection> parent() const;
+
+    //--------------------------------------------------
+    // Methods for child section access
+    //--------------------------------------------------
+
+    ndsize_t sectionCount() const;
+
+
+    bool hasSection(const std::string &name_or_id) const;
+
+
+    std::shared_ptr<base::ISection> getSection(const std::string &name_or_id) const;
+
+
+    std::shared_ptr<base::ISection> getSection(ndsize_t index) const;
+
+
+    std::shared_ptr<base::ISection> createSection(const std::string &name, const std::string &type);
+
+
+    bool deleteSection(const std::string &name_or_id);
+
+    //--------------------------------------------------
+    // Methods for property access
+    //--------------------------------------------------
+
+    ndsize_t propertyCount() const;
+
+
+    bool hasProperty(const std::string &name_or_id) const;
+
+
+    std::shared_ptr<base::IProperty> getProperty(const std::string &name_or_id) const;
+
+
+    std::shared_ptr<base::IProperty> getProperty(ndsize_t index) const;
+
+
+    std::shared_ptr<base::IProperty> createProperty(const std::string &name, const DataType &dtype);
+
+
+    std::shared_ptr<base::IProperty> createProperty(const std::string &name, const DataType &dtype,
+                                                    const StringStorage &strings);
+
+
+    std::shared_ptr<base::IProperty> createProperty(const std::string &name, const Variant &value);
+
+
+    std::shared_ptr<base::IProperty> createProperty(const std::string &name, const std::vector<Variant> &values);
+
+
+    bool deleteProperty(const std::string &name_or_id);
+
+    //--------------------------------------------------
+    // Other methods and functions
+    //--------------------------------------------------
+
+    void forceUpdatedAt();
+
+
+    std::shared_ptr<base::IFile> parentFile() const;
+
+
+    virtual ~SectionMemory();
+
+private:
+
+    std::shared_ptr<SectionNode> findSection(const std::string &name_or_id) const;
+
+
+    std::shared_ptr<PropertyNode> findProperty(const std::string &name_or_id) const;
+
+};
+
+
+} // namespace memory
+} // namespace nix
+
+#endif // NIX_SECTION_MEMORY_H
@@ -0,0 +1,81 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "SourceMemory.hpp"
+
+#include "BlockMemory.hpp"
+#include "FileMemory.hpp"
+
+using namespace std;
+using namespace nix::base;
+
+namespace nix {
+namespace memory {
+
+
+SourceMemory::SourceMemory(const shared_ptr<FileMemory> &file, const shared_ptr<BlockNode> &block,
+                           const shared_ptr<SourceNode> &node)
+    : EntityWithMetadataMemory(file, node), entity_block(block)
+{
+}
+
+
+bool SourceMemory::hasSource(const string &name_or_id) const {
+    return node<SourceNode>()->sources.find(name_or_id) != nullptr;
+}
+
+
+shared_ptr<ISource> SourceMemory::getSource(const string &name_or_id) const {
+    shared_ptr<SourceNode> source = node<SourceNode>()->sources.find(name_or_id);
+    return source ? make_shared<SourceMemory>(file(), entity_block, source) : nullptr;
+}
+
+
+shared_ptr<ISource> SourceMemory::getSource(ndsize_t index) const {
+    return make_shared<SourceMemory>(file(), entity_block, node<SourceNode>()->sources.at(index));
+}
+
+
+ndsize_t SourceMemory::sourceCount() const {
+    return node<SourceNode>()->sources.size();
+}
+
+
+shared_ptr<ISource> SourceMemory::createSource(const string &name, const string &type) {
+    shared_ptr<SourceNode> source = makeNode<SourceNode>(name, type);
+    node<SourceNode>()->sources.add(source);
+    entity_block->source_index[source->id] = source;
+    return make_shared<SourceMemory>(file(), entity_block, source);
+}
+
+
+bool SourceMemory::deleteSource(const string &name_or_id) {
+    shared_ptr<SourceNode> source = node<SourceNode>()->sources.find(name_or_id);
+    if (!source) {
+        return false;
+    }
+    BlockMemory::dropSource(*entity_block, source);
+    node<SourceNode>()->sources.erase(source);
+    return true;
+}
+
+
+shared_ptr<IFile> SourceMemory::parentFile() const {
+    return file();
+}
+
+
+shared_ptr<IBlock> SourceMemory::parentBlock() const {
+    return make_shared<BlockMemory>(file(), entity_block);
+}
+
+
+SourceMemory::~SourceMemory() {}
+
+} // ns nix::memory
+} // ns nix
@@ -0,0 +1,70 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_SOURCE_MEMORY_H
+#define NIX_SOURCE_MEMORY_H
+
+#include <nix/base/IBlock.hpp>
+#include <nix/base/ISource.hpp>
+#include "EntityWithMetadataMemory.hpp"
+
+#include <string>
+#include <memory>
+
+namespace nix {
+namespace memory {
+
+
+/**
+ * Class that represents a NIX Source entity.
+ */
+class SourceMemory : virtual public base::ISource, public EntityWithMetadataMemory {
+
+private:
+
+    std::shared_ptr<BlockNode> entity_block;
+
+public:
+
+    SourceMemory(const std::shared_ptr<FileMemory> &file, const std::shared_ptr<BlockNode> &block,
+                 const std::shared_ptr<SourceNode> &node);
+
+
+    bool hasSource(const std::string &name_or_id) const;
+
+
+    std::shared_ptr<base::ISource> getSource(const std::string &name_or_id) const;
+
+
+    std::shared_ptr<base::ISource> getSource(ndsize_t index) const;
+
+
+    ndsize_t sourceCount() const;
+
+
+    std::shared_ptr<base::ISource> createSource(const std::string &name, const std::string &type);
+
+
+    bool deleteSource(const std::string &name_or_id);
+
+
+    std::shared_ptr<base::IFile> parentFile() const;
+
+
+    std::shared_ptr<base::IBlock> parentBlock() const;
+
+
+    virtual ~SourceMemory();
+
+};
+
+
+} // namespace memory
+} // namespace nix
+
+#endif // NIX_SOURCE_MEMORY_H
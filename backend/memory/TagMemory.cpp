@@ -0,0 +1,71 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "TagMemory.hpp"
+
+using namespace std;
+using namespace nix::base;
+
+namespace nix {
+namespace memory {
+
+
+TagMemory::TagMemory(const shared_ptr<FileMemory> &file, const shared_ptr<BlockNode> &block,
+                     const shared_ptr<TagNode> &node)
+    : BaseTagMemory(file, block, node)
+{
+}
+
+
+vector<string> TagMemory::units() const {
+    return node<TagNode>()->units;
+}
+
+
+void TagMemory::units(const vector<string> &units) {
+    node<TagNode>()->units = units;
+    forceUpdatedAt();
+}
+
+
+void TagMemory::units(const none_t t) {
+    node<TagNode>()->units.clear();
+    forceUpdatedAt();
+}
+
+
+vector<double> TagMemory::position() const {
+    return node<TagNode>()->position;
+}
+
+
+void TagMemory::position(const vector<double> &position) {
+    node<TagNode>()->position = position;
+}
+
+
+vector<double> TagMemory::extent() const {
+    return node<TagNode>()->extent;
+}
+
+
+void TagMemory::extent(const vector<double> &extent) {
+    node<TagNode>()->extent = extent;
+}
+
+
+void TagMemory::extent(const none_t t) {
+    node<TagNode>()->extent.clear();
+    forceUpdatedAt();
+}
+
+
+TagMemory::~TagMemory() {}
+
+} // ns nix::memory
+} // ns nix
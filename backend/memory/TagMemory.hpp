@@ -0,0 +1,65 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_TAG_MEMORY_H
+#define NIX_TAG_MEMORY_H
+
+#include "BaseTagMemory.hpp"
+#include <nix/base/ITag.hpp>
+
+namespace nix {
+namespace memory {
+
+
+/**
+ * Class that represents a NIX tag.
+ */
+class TagMemory : public BaseTagMemory, virtual public base::ITag {
+
+public:
+
+    TagMemory(const std::shared_ptr<FileMemory> &file, const std::shared_ptr<BlockNode> &block,
+              const std::shared_ptr<TagNode> &node);
+
+
+    std::vector<std::string> units() const;
+
+
+    void units(const std::vector<std::string> &units);
+
+
+    void units(const none_t t);
+
+
+    std::vector<double> position() const;
+
+
+    void position(const std::vector<double> &position);
+
+
+    std::vector<double> extent() const;
+
+
+    void extent(const std::vector<double> &extent);
+
+
+    void extent(const none_t t);
+
+    //--------------------------------------------------
+    // Other methods and functions
+    //--------------------------------------------------
+
+    virtual ~TagMemory();
+
+};
+
+
+} // namespace memory
+} // namespace nix
+
+#endif // NIX_TAG_MEMORY_H
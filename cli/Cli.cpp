@@ -27,6 +27,8 @@ namespace po = boost::program_options;
 #include <modules/IModule.hpp>
 #include <modules/Validate.hpp>
 #include <modules/Dump.hpp>
+#include <modules/Stat.hpp>
+#include <modules/Repack.hpp>
 
 namespace cli {
 
@@ -41,7 +43,9 @@ std::ostream& operator<<(std::ostream& os, const std::vector<T>& v)
 // define all module types
 std::unordered_map<std::string, std::shared_ptr<cli::module::IModule>> modules = {
     {std::string(cli::module::Validate::module_name), std::shared_ptr<cli::module::IModule>(new cli::module::Validate())},
-    {std::string(cli::module::Dump::module_name), std::shared_ptr<cli::module::IModule>(new cli::module::Dump())}
+    {std::string(cli::module::Dump::module_name), std::shared_ptr<cli::module::IModule>(new cli::module::Dump())},
+    {std::string(cli::module::Stat::module_name), std::shared_ptr<cli::module::IModule>(new cli::module::Stat())},
+    {std::string(cli::module::Repack::module_name), std::shared_ptr<cli::module::IModule>(new cli::module::Repack())}
 };
 
 } // namespace cli
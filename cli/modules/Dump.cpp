@@ -21,6 +21,8 @@
 #include <modules/Dump.hpp>
 #include <limits>
 #include <cstddef>
+#include <map>
+#include <vector>
 
 #include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
@@ -38,17 +40,89 @@ const char* yamlstream::scalar_end = "\n";
 const char* yamlstream::item_str = "- ";
 const char* plot_script::plot_file = "dump_plot.gnu";
 
+// entity types that may contain other entity types
+static const std::map<std::string, std::vector<std::string>> nested_types = {
+    {"file",       {"block", "section"}},
+    {"block",      {"data_array", "multi_tag", "tag", "source"}},
+    {"data_array", {"dimension"}},
+    {"multi_tag",  {"feature"}},
+    {"tag",        {"feature"}},
+    {"section",    {"property"}},
+};
+
+const std::set<std::string> &yamlstream::entity_types() {
+    static const std::set<std::string> known = {
+        "block", "data_array", "dimension", "multi_tag", "tag",
+        "feature", "source", "section", "property"
+    };
+    return known;
+}
+
+void yamlstream::write(const std::string &str) {
+    if (str.empty()) {
+        return;
+    }
+    ostream << str;
+    last = *str.rbegin();
+}
+
 void yamlstream::indent_if() {
     // if endl
-    if (!strcmp(&*sstream.str().rbegin(), "\n")) {
+    if (last == '\n') {
         (*this)[level];
     }
 }
 
 void yamlstream::endl_if() {
     // if _not_ endl
-    if (strcmp(&*sstream.str().rbegin(), "\n")) {
-        sstream << "\n";
+    if (last != '\n') {
+        write("\n");
+    }
+}
+
+bool yamlstream::wants(const std::string &type) const {
+    return types.empty() || types.count(type) > 0;
+}
+
+bool yamlstream::needs(const std::string &type) const {
+    if (type == "file" || wants(type)) {
+        return true;
+    }
+
+    auto it = nested_types.find(type);
+    if (it == nested_types.end()) {
+        return false;
+    }
+
+    for (const auto &child : it->second) {
+        if (needs(child)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool yamlstream::nested(const std::string &type) const {
+    return depth <= max_depth && needs(type);
+}
+
+bool yamlstream::open(const std::string &type, const std::string &label) {
+    if (!needs(type)) {
+        return false;
+    }
+
+    (*this)[level] << item() << type << label;
+    ++(*this);
+    depth++;
+    return true;
+}
+
+void yamlstream::close() {
+    --(*this);
+    depth--;
+    // hand out every complete block or section right away
+    if (depth <= 1) {
+        ostream.flush();
     }
 }
 
@@ -57,7 +131,7 @@ std::string yamlstream::item() {
 }
 
 yamlstream& yamlstream::operator++() {
-    sstream << sequ_start;
+    write(sequ_start);
     level++;
     return *this;
 }
@@ -83,7 +157,7 @@ yamlstream yamlstream::operator--(int) {
 yamlstream& yamlstream::operator[](const size_t n_indent) {
     endl_if();
     for (size_t i = 0; i < n_indent; i++) {
-        sstream << indent_str;
+        write(indent_str);
     }
     return *this;
 }
@@ -109,10 +183,6 @@ std::string yamlstream::t(const time_t &tm) {
     return std::string(tbuff);
 }
 
-std::string yamlstream::str() {
-    return sstream.str();
-}
-
 yamlstream& yamlstream::operator<<(const nix::NDSize &t)
 {
     indent_if();
@@ -162,12 +232,11 @@ yamlstream& yamlstream::operator<<(const nix::Value &value) {
 }
 
 yamlstream& yamlstream::operator<<(const nix::Property &property) {
-    if (!property) {
+    if (!property || !open("property", " &" + property.id())) {
         return *this; // unset entity protection
     }
 
-    (*this)[level] << item() << "property &" << property.id();
-    ++(*this)
+    (*this)
         << static_cast<nix::base::Entity<nix::base::IProperty>>(property)
         << "dataType" << scalar_start << property.dataType() << scalar_end
         << "definition" << scalar_start << property.definition() << scalar_end
@@ -177,116 +246,130 @@ yamlstream& yamlstream::operator<<(const nix::Property &property) {
         << "valueCount" << scalar_start << property.valueCount() << scalar_end;
 
         // Values
-        *this << "values";
-        ++(*this);
-            auto values = property.values();
-            for (auto &value : values) {
-                *this << value;
-            }
-        --(*this);
-    --(*this);
+        if (!summary) {
+            *this << "values";
+            ++(*this);
+                auto values = property.values();
+                for (auto &value : values) {
+                    *this << value;
+                }
+            --(*this);
+        }
+    close();
     return *this;
 }
 
 yamlstream& yamlstream::operator<<(const nix::Source &source) {
-    if (!source) {
+    if (!source || !open("source", " &" + source.id())) {
         return *this; // unset entity protection
     }
 
-    (*this)[level] << item() << "source &" << source.id();
-    ++(*this)
+    (*this)
         << static_cast<nix::base::EntityWithMetadata<nix::base::ISource>>(source)
         << "sourceCount" << scalar_start << source.sourceCount() << scalar_end;
 
         // Sources
-        *this << "sources";
-        ++(*this);
-            auto sources = source.sources();
-            for (auto &source : sources) {
-                *this << source;
-            }
-        --(*this);
-    --(*this);
+        if (nested("source")) {
+            *this << "sources";
+            ++(*this);
+                auto sources = source.sources();
+                for (auto &source : sources) {
+                    *this << source;
+                }
+            --(*this);
+        }
+    close();
     return *this;
 }
 
 yamlstream& yamlstream::operator<<(const nix::Section &section) {
-    if (!section) {
+    if (!section || !open("section", " &" + section.id())) {
         return *this; // unset entity protection
     }
 
-    (*this)[level] << item() << "section &" << section.id();
-    ++(*this)
-        << static_cast<nix::base::NamedEntity<nix::base::ISection>>(section)
-        << "propertyCount" << scalar_start << section.propertyCount() << scalar_end
-        << "sectionCount" << scalar_start << section.sectionCount() << scalar_end
-        << "repository" << scalar_start << section.repository() << scalar_end
-        << "link"; ++(*this) << section.link(); --(*this);
+    if (wants("section")) {
+        (*this)
+            << static_cast<nix::base::NamedEntity<nix::base::ISection>>(section)
+            << "propertyCount" << scalar_start << section.propertyCount() << scalar_end
+            << "sectionCount" << scalar_start << section.sectionCount() << scalar_end
+            << "repository" << scalar_start << section.repository() << scalar_end
+            << "link"; ++(*this) << section.link(); --(*this);
+    }
 
         // Properties
-        *this << "properties";
-        ++(*this);
-            auto properties = section.properties();
-            for (auto &property : properties) {
-                *this << property;
-            }
-        --(*this);
+        if (nested("property")) {
+            *this << "properties";
+            ++(*this);
+                auto properties = section.properties();
+                for (auto &property : properties) {
+                    *this << property;
+                }
+            --(*this);
+        }
         // Sections
-        *this << "sections";
-        ++(*this);
-            auto sections = section.sections();
-            for (auto &section : sections) {
-                *this << section;
-            }
-        --(*this);
-    --(*this);
+        if (nested("section")) {
+            *this << "sections";
+            ++(*this);
+                auto sections = section.sections();
+                for (auto &section : sections) {
+                    *this << section;
+                }
+            --(*this);
+        }
+    close();
     return *this;
 }
 
 yamlstream& yamlstream::operator<<(const nix::SetDimension &dim) {
-    if (!dim) {
+    if (!dim || !open("dimension", " " + nix::util::numToStr(dim.index()))) {
         return *this; // unset entity protection
     }
 
-    (*this)[level] << item() << "dimension " << dim.index();
-    ++(*this)
+    (*this)
         << "index" << scalar_start << dim.index() << scalar_end
-        << "dimensionType" << scalar_start << dim.dimensionType() << scalar_end
-        << "labels" << scalar_start << dim.labels() << scalar_end;
-    --(*this);
+        << "dimensionType" << scalar_start << dim.dimensionType() << scalar_end;
+    if (summary) {
+        (*this) << "labelCount" << scalar_start << dim.labelCount() << scalar_end;
+    } else {
+        (*this) << "labels" << scalar_start << dim.labels() << scalar_end;
+    }
+    close();
     return *this;
 }
 
 yamlstream& yamlstream::operator<<(const nix::SampledDimension &dim) {
-    if (!dim) {
+    if (!dim || !open("dimension", " " + nix::util::numToStr(dim.index()))) {
         return *this; // unset entity protection
     }
 
-    (*this)[level] << item() << "dimension " << dim.index();
-    ++(*this)
+    (*this)
         << "index" << scalar_start << dim.index() << scalar_end
         << "dimensionType" << scalar_start << dim.dimensionType() << scalar_end
         << "label" << scalar_start << dim.label() << scalar_end
         << "offset" << scalar_start << dim.offset() << scalar_end
         << "samplingInterval" << scalar_start << dim.samplingInterval() << scalar_end
         << "unit" << scalar_start << dim.unit() << scalar_end;
-    --(*this);
+    close();
     return *this;
 }
 
 yamlstream& yamlstream::operator<<(const nix::RangeDimension &dim) {
-    if (!dim) {
+    if (!dim || !open("dimension", " " + nix::util::numToStr(dim.index()))) {
         return *this; // unset entity protection
     }
 
-    (*this)[level] << item() << "dimension " << dim.index();
-    ++(*this)
+    (*this)
         << "index" << scalar_start << dim.index() << scalar_end
         << "dimensionType" << scalar_start << dim.dimensionType() << scalar_end
-        << "label" << scalar_start << dim.label() << scalar_end
-        << "ticks" << scalar_start << dim.ticks() << scalar_end
+        << "label" << scalar_start << dim.label() << scalar_end;
+    if (summary) {
+        (*this) << "tickCount" << scalar_start << dim.tickCount() << scalar_end;
+    } else {
+        (*this) << "ticks" << scalar_start << dim.ticks() << scalar_end;
+    }
+    (*this)
         << "unit" << scalar_start << dim.unit() << scalar_end;
-    --(*this);
+    close();
     return *this;
 }
 
@@ -308,168 +391,228 @@ yamlstream& yamlstream::operator<<(const nix::Dimension &dim) {
     return *this;
 }
 
+void yamlstream::summarize(const nix::DataArray &data_array) {
+    const nix::DataType dtype = data_array.dataType();
+    const nix::NDSize extent = data_array.dataExtent();
+    const nix::ndsize_t stored = data_array.dataStorageSize();
+
+    (*this)
+        << "dataChunks" << scalar_start << data_array.dataChunks() << scalar_end
+        << "dataStorageSize" << scalar_start << stored << scalar_end;
+
+    if (!nix::data_type_is_numeric(dtype) || extent.nelms() == 0) {
+        return;
+    }
+
+    if (stored > 0) {
+        double raw = static_cast<double>(extent.nelms() * nix::data_type_to_size(dtype));
+        (*this) << "compressionRatio" << scalar_start << raw / static_cast<double>(stored) << scalar_end;
+    }
+
+    // reduce along the longest axis, so the partial results stay small
+    size_t axis = static_cast<size_t>(std::max_element(extent.begin(), extent.end()) - extent.begin());
+    nix::Statistics stats = data_array.statistics(axis);
+
+    double min = std::numeric_limits<double>::quiet_NaN();
+    double max = std::numeric_limits<double>::quiet_NaN();
+    for (size_t i = 0; i < stats.min.size(); i++) {
+        min = std::fmin(min, stats.min[i]);
+        max = std::fmax(max, stats.max[i]);
+    }
+
+    (*this)
+        << "min" << scalar_start << min << scalar_end
+        << "max" << scalar_start << max << scalar_end;
+}
+
 yamlstream& yamlstream::operator<<(const nix::DataArray &data_array) {
-    if (!data_array) {
+    if (!data_array || !open("data_array", " &" + data_array.id())) {
         return *this; // unset entity protection
     }
 
-    (*this)[level] << item() << "data_array &" << data_array.id();
-    ++(*this)
-        << static_cast<nix::base::EntityWithSources<nix::base::IDataArray>>(data_array)
-        << "dataType" << scalar_start << data_array.dataType() << scalar_end
-        << "dataExtent" << scalar_start << data_array.dataExtent() << scalar_end
-        << "expansionOrigin" << scalar_start << data_array.expansionOrigin() << scalar_end
-        << "polynomCoefficients" << scalar_start << data_array.polynomCoefficients() << scalar_end
-        << "label" << scalar_start << data_array.label() << scalar_end
-        << "unit" << scalar_start << data_array.unit() << scalar_end
-        << "dimensionCount" << scalar_start << data_array.dimensionCount() << scalar_end;
+    if (wants("data_array")) {
+        (*this)
+            << static_cast<nix::base::EntityWithSources<nix::base::IDataArray>>(data_array)
+            << "dataType" << scalar_start << data_array.dataType() << scalar_end
+            << "dataExtent" << scalar_start << data_array.dataExtent() << scalar_end
+            << "expansionOrigin" << scalar_start << data_array.expansionOrigin() << scalar_end
+            << "polynomCoefficients" << scalar_start << data_array.polynomCoefficients() << scalar_end
+            << "label" << scalar_start << data_array.label() << scalar_end
+            << "unit" << scalar_start << data_array.unit() << scalar_end
+            << "dimensionCount" << scalar_start << data_array.dimensionCount() << scalar_end;
+        if (summary) {
+            summarize(data_array);
+        }
+    }
         // Dimensions
-        *this << "dimensions";
-        ++(*this);
-            auto dims = data_array.dimensions();
-            for (auto &dim : dims) {
-                *this << dim;
-            }
-        --(*this);
-    --(*this);
+        if (nested("dimension")) {
+            *this << "dimensions";
+            ++(*this);
+                auto dims = data_array.dimensions();
+                for (auto &dim : dims) {
+                    *this << dim;
+                }
+            --(*this);
+        }
+    close();
     return *this;
 }
 
 yamlstream& yamlstream::operator<<(const nix::Feature &feature) {
-    if (!feature) {
+    if (!feature || !open("feature", " &" + feature.id())) {
         return *this; // unset entity protection
     }
 
-    (*this)[level] << item() << "feature &" << feature.id();
-    ++(*this)
+    (*this)
         << static_cast<nix::base::Entity<nix::base::IFeature>>(feature)
-        << "linkType" << scalar_start << feature.linkType() << scalar_end
-        << "data" << sequ_start << feature.data();
-    --(*this);
+        << "linkType" << scalar_start << feature.linkType() << scalar_end;
+    if (nested("data_array")) {
+        (*this) << "data"; ++(*this) << feature.data(); --(*this);
+    }
+    close();
     return *this;
 }
 
 yamlstream& yamlstream::operator<<(const nix::Tag &tag) {
-    if (!tag) {
+    if (!tag || !open("tag", " &" + tag.id())) {
         return *this; // unset entity protection
     }
 
-    (*this)[level] << item() << "tag &" << tag.id();
-    ++(*this)
-        << static_cast<nix::base::EntityWithSources<nix::base::ITag>>(tag)
-        << "units" << scalar_start << tag.units() << scalar_end
-        << "featureCount" << scalar_start << tag.featureCount() << scalar_end
-        << "referenceCount" << scalar_start << tag.referenceCount() << scalar_end
-        << "extent" << scalar_start << tag.extent() << scalar_end
-        << "position" << scalar_start << tag.position() << scalar_end;
+    if (wants("tag")) {
+        (*this)
+            << static_cast<nix::base::EntityWithSources<nix::base::ITag>>(tag)
+            << "units" << scalar_start << tag.units() << scalar_end
+            << "featureCount" << scalar_start << tag.featureCount() << scalar_end
+            << "referenceCount" << scalar_start << tag.referenceCount() << scalar_end
+            << "extent" << scalar_start << tag.extent() << scalar_end
+            << "position" << scalar_start << tag.position() << scalar_end;
         // References
-        *this << "references";
-        ++(*this);
-            auto refs = tag.references();
-            for (auto &ref : refs) {
-                *this << ref;
-            }
-        --(*this);
+        if (nested("data_array")) {
+            *this << "references";
+            ++(*this);
+                auto refs = tag.references();
+                for (auto &ref : refs) {
+                    *this << ref;
+                }
+            --(*this);
+        }
+    }
         // Features
-        *this << "features";
-        ++(*this);
-            auto features = tag.features();
-            for (auto &feature : features) {
-                *this << feature;
-            }
-        --(*this);
-    --(*this);
+        if (nested("feature")) {
+            *this << "features";
+            ++(*this);
+                auto features = tag.features();
+                for (auto &feature : features) {
+                    *this << feature;
+                }
+            --(*this);
+        }
+    close();
     return *this;
 }
 
 yamlstream& yamlstream::operator<<(const nix::MultiTag &multi_tag) {
-    if (!multi_tag) {
+    if (!multi_tag || !open("multi_tag", " &" + multi_tag.id())) {
         return *this; // unset entity protection
     }
 
-    (*this)[level] << item() << "multi_tag &" << multi_tag.id();
-    ++(*this)
-        << static_cast<nix::base::EntityWithSources<nix::base::IMultiTag>>(multi_tag)
-        << "units" << scalar_start << multi_tag.units() << scalar_end
-        << "featureCount" << scalar_start << multi_tag.featureCount() << scalar_end
-        << "referenceCount" << scalar_start << multi_tag.referenceCount() << scalar_end
-        << "extents"; ++(*this) << multi_tag.extents(); --(*this)
-        << "positions"; ++(*this) << multi_tag.positions(); --(*this);
-        // References
-        *this << "references";
-        ++(*this);
-            auto refs = multi_tag.references();
-            for (auto &ref : refs) {
-                *this << ref;
-            }
-        --(*this);
+    if (wants("multi_tag")) {
+        (*this)
+            << static_cast<nix::base::EntityWithSources<nix::base::IMultiTag>>(multi_tag)
+            << "units" << scalar_start << multi_tag.units() << scalar_end
+            << "featureCount" << scalar_start << multi_tag.featureCount() << scalar_end
+            << "referenceCount" << scalar_start << multi_tag.referenceCount() << scalar_end;
+        if (nested("data_array")) {
+            (*this)
+                << "extents"; ++(*this) << multi_tag.extents(); --(*this)
+                << "positions"; ++(*this) << multi_tag.positions(); --(*this);
+            // References
+            *this << "references";
+            ++(*this);
+                auto refs = multi_tag.references();
+                for (auto &ref : refs) {
+                    *this << ref;
+                }
+            --(*this);
+        }
+    }
         // Features
-        *this << "features";
-        ++(*this);
-            auto features = multi_tag.features();
-            for (auto &feature : features) {
-                *this << feature;
-            }
-        --(*this);
-    --(*this);
+        if (nested("feature")) {
+            *this << "features";
+            ++(*this);
+                auto features = multi_tag.features();
+                for (auto &feature : features) {
+                    *this << feature;
+                }
+            --(*this);
+        }
+    close();
     return *this;
 }
 
 yamlstream& yamlstream::operator<<(const nix::Block &block) {
-    if (!block) {
+    if (!block || !open("block", " &" + block.id())) {
         return *this; // unset entity protection
     }
 
-    (*this)[level] << item() << "block &" << block.id();
-    ++(*this)
-        << static_cast<nix::base::EntityWithMetadata<nix::base::IBlock>>(block)
-        << "sourceCount" << scalar_start << block.sourceCount() << scalar_end
-        << "tagCount" << scalar_start << block.tagCount() << scalar_end
-        << "multiTagCount" << scalar_start << block.multiTagCount() << scalar_end
-        << "dataArrayCount" << scalar_start << block.dataArrayCount() << scalar_end;
+    if (wants("block")) {
+        (*this)
+            << static_cast<nix::base::EntityWithMetadata<nix::base::IBlock>>(block)
+            << "sourceCount" << scalar_start << block.sourceCount() << scalar_end
+            << "tagCount" << scalar_start << block.tagCount() << scalar_end
+            << "multiTagCount" << scalar_start << block.multiTagCount() << scalar_end
+            << "dataArrayCount" << scalar_start << block.dataArrayCount() << scalar_end;
+    }
         // DataArrays
-        *this << "data_arrays";
-        ++(*this);
-            auto data_arrays = block.dataArrays();
-            for (auto &data_array : data_arrays) {
-                *this << data_array;
-            }
-        --(*this);
+        if (nested("data_array")) {
+            *this << "data_arrays";
+            ++(*this);
+                auto data_arrays = block.dataArrays();
+                for (auto &data_array : data_arrays) {
+                    *this << data_array;
+                }
+            --(*this);
+        }
         // MultiTags
-        *this << "multi_tags";
-        ++(*this);
-            auto multi_tags = block.multiTags();
-            for (auto &multi_tag : multi_tags) {
-                *this << multi_tag;
-            }
-        --(*this);
+        if (nested("multi_tag")) {
+            *this << "multi_tags";
+            ++(*this);
+                auto multi_tags = block.multiTags();
+                for (auto &multi_tag : multi_tags) {
+                    *this << multi_tag;
+                }
+            --(*this);
+        }
         // Tags
-        *this << "tags";
-        ++(*this);
-            auto tags = block.tags();
-            for (auto &tag : tags) {
-                *this << tag;
-            }
-        --(*this);
+        if (nested("tag")) {
+            *this << "tags";
+            ++(*this);
+                auto tags = block.tags();
+                for (auto &tag : tags) {
+                    *this << tag;
+                }
+            --(*this);
+        }
         // Sources
-        *this << "sources";
-        ++(*this);
-            auto sources = block.sources();
-            for (auto &source : sources) {
-                *this << source;
-            }
-        --(*this);
-    --(*this);
+        if (nested("source")) {
+            *this << "sources";
+            ++(*this);
+                auto sources = block.sources();
+                for (auto &source : sources) {
+                    *this << source;
+                }
+            --(*this);
+        }
+    close();
     return *this;
 }
 
 yamlstream& yamlstream::operator<<(const nix::File &file) {
-    if (!file) {
+    if (!file || !open("file", " &" + file.location())) {
         return *this; // unset entity protection
     }
 
-    (*this)[level] << item() << "file &" << file.location();
-    ++(*this)
+    (*this)
         << "location" << scalar_start << file.location() << scalar_end
         << "createdAt" << scalar_start << t(file.createdAt()) << scalar_end
         << "updatedAt" << scalar_start << t(file.updatedAt()) << scalar_end
@@ -479,22 +622,27 @@ yamlstream& yamlstream::operator<<(const nix::File &file) {
         << "blockCount" << scalar_start << file.blockCount() << scalar_end
         << "sectionCount" << scalar_start << file.sectionCount() << scalar_end;
         // Blocks
-        *this << "blocks";
-        ++(*this);
-            auto blocks = file.blocks();
-            for (auto &block : blocks) {
-                *this << block;
-            }
-        --(*this);
+        if (nested("block")) {
+            *this << "blocks";
+            ++(*this);
+                auto blocks = file.blocks();
+                for (auto &block : blocks) {
+                    *this << block;
+                }
+            --(*this);
+        }
         // Sections
-        *this << "sections";
-        ++(*this);
-            auto sections = file.sections();
-            for (auto &section : sections) {
-                *this << section;
-            }
-        --(*this);
-    --(*this);
+        if (nested("section")) {
+            *this << "sections";
+            ++(*this);
+                auto sections = file.sections();
+                for (auto &section : sections) {
+                    *this << section;
+                }
+            --(*this);
+        }
+    close();
+    endl_if();
 
     return *this;
 }
@@ -509,20 +657,37 @@ void Dump::load(po::options_description &desc) const {
     opt.add_options()
         (DATA_OPTION, "dump data from all 2D DataArrays")
         (PLOT_OPTION, ("dump & plot (only) data from all 2D DataArrays (linux only, invokes --" + std::string(DATA_OPTION) + ")").c_str())
+        (DEPTH_OPTION, po::value<size_t>(), "maximum depth of nested entities to dump, e.g. --depth=1; the file has depth 0")
+        (TYPE_OPTION, po::value<std::string>(), "comma separated list of entity types to dump, e.g. --type=tag,feature: block, data_array, "
+                                                "dimension, multi_tag, tag, feature, source, section, property")
+        (SUMMARY_OPTION, "summarize DataArrays (chunks, storage size, compression ratio, min & max) "
+                         "and omit ticks, labels & property values")
     ;
     desc.add(opt);
 }
 
+static std::set<std::string> parse_types(const std::string &list) {
+    std::set<std::string> types;
+    std::stringstream ss(list);
+    std::string type;
+    while (std::getline(ss, type, ',')) {
+        if (type.empty()) {
+            continue;
+        }
+        if (yamlstream::entity_types().count(type) == 0) {
+            throw std::invalid_argument("unknown entity type: " + type);
+        }
+        types.insert(type);
+    }
+    return types;
+}
+
 std::string Dump::call(const po::variables_map &vm, const po::options_description &desc) {
     std::vector<nix::File> files; // opened nix files
     std::stringstream out;
     std::ofstream fout;
     nix::File tmp_file;
     std::string file_name;
-    double A_min = std::numeric_limits<double>::max();
-    double A_max = std::numeric_limits<double>::min();
-    typedef boost::multi_array<double, 2> array_type;
-    typedef array_type::index index;
 
     // --help
     if (vm.count(HELP_OPTION)) {
@@ -548,11 +713,18 @@ std::string Dump::call(const po::variables_map &vm, const po::options_descriptio
             // save it!
             files.push_back(tmp_file); // ReadOnly, ReadWrite, Overwrite
         }
+
+        const size_t max_depth = vm.count(DEPTH_OPTION) ? vm[DEPTH_OPTION].as<size_t>()
+                                                        : std::numeric_limits<size_t>::max();
+        const std::set<std::string> types = vm.count(TYPE_OPTION) ? parse_types(vm[TYPE_OPTION].as<std::string>())
+                                                                  : std::set<std::string>();
+
         // loop through entities in all files
         for (auto &file : files) {
             if ( ! (vm.count(DATA_OPTION) || vm.count(PLOT_OPTION)) ) {
+                // written while walking the file, nothing is kept in memory
+                yamlstream yaml(std::cout, max_depth, types, vm.count(SUMMARY_OPTION) > 0);
                 yaml << file;
-                out << yaml.str();
             }
             else {
                 // loop through all data_arrays
@@ -560,23 +732,27 @@ std::string Dump::call(const po::variables_map &vm, const po::options_descriptio
                 for (auto &block : blcks) {
                     auto data_arrays = block.dataArrays();
                     for (auto &data_array : data_arrays) {
-                        // if we have a 2D data_array, output data & plot script
-                        if (data_array.dataExtent().size() == 2) {
+                        // if we have a numeric 2D data_array, output data & plot script
+                        const nix::NDSize extent = data_array.dataExtent();
+                        if (extent.size() == 2 && nix::data_type_is_numeric(data_array.dataType())) {
+                            double A_min = std::numeric_limits<double>::max();
+                            double A_max = std::numeric_limits<double>::lowest();
                             file_name = "data_array_" + data_array.id();
                             fout.open(file_name + ".txt");
-                            index dim1 = static_cast<index>(data_array.dataExtent()[0]);
-                            index dim2 = static_cast<index>(data_array.dataExtent()[1]);
-                            array_type A(boost::extents[ dim1 ]
-                                                       [ dim2 ]);
-                            data_array.getData(A);
-                            // loop through data_array values
-                            for (index i = 0; i < dim1; i++) {
-                                for (index j = 0; j < dim2; j++) {
-                                    fout << A[i][j] << ((j != dim2-1) ? " " : "");
-                                    if (A[i][j] < A_min) A_min = A[i][j];
-                                    if (A[i][j] > A_max) A_max = A[i][j];
+                            const nix::ndsize_t dim1 = extent[0];
+                            const nix::ndsize_t dim2 = extent[1];
+                            const nix::ndsize_t one = 1, zero = 0;
+                            // read row by row, the next rows are prefetched meanwhile
+                            nix::ReadAhead rows(data_array, 0, 4, nix::DataType::Double);
+                            std::vector<double> row(nix::check::fits_in_size_t(dim2, "row exceeds memory"));
+                            for (nix::ndsize_t i = 0; i < dim1; i++) {
+                                rows.getData(nix::DataType::Double, row.data(), nix::NDSize({one, dim2}), nix::NDSize({i, zero}));
+                                for (size_t j = 0; j < row.size(); j++) {
+                                    fout << row[j] << ((j != row.size() - 1) ? " " : "");
+                                    if (row[j] < A_min) A_min = row[j];
+                                    if (row[j] > A_max) A_max = row[j];
                                 }
-                                fout << ((i != dim1-1) ? "\n" : "");
+                                fout << ((i != dim1 - 1) ? "\n" : "");
                             }
                             fout.close();
 
@@ -591,7 +767,7 @@ std::string Dump::call(const po::variables_map &vm, const po::options_descriptio
                                 std::system(("./" + file_name + ".gnu").c_str());
                             }
                             #endif
-                        } // if data_array.dataExtent().size() == 2
+                        } // if extent.size() == 2
                     } // for data_arrays
                 } // for blcks
             } // if vm.count(DATA_OPTION) || vm.count(PLOT_OPTION)
@@ -22,6 +22,9 @@
 #include <modules/IModule.hpp>
 
 #include <string>
+#include <limits>
+#include <set>
+#include <sstream>
 #include <fstream>
 #include <iostream>
 #include <cstdlib>
@@ -36,6 +39,9 @@ namespace module {
 
 const char *const DATA_OPTION = "data";
 const char *const PLOT_OPTION = "plot";
+const char *const DEPTH_OPTION = "depth";
+const char *const TYPE_OPTION = "type";
+const char *const SUMMARY_OPTION = "summary";
 
 class plot_script {
 private:
@@ -101,25 +107,101 @@ class yamlstream {
     static const char* item_str;
     
     size_t level;
-    std::stringstream &sstream;
-    
+    std::ostream &ostream;
+    char last;
+
+    size_t depth;
+    size_t max_depth;
+    std::set<std::string> types;
+    bool summary;
+
+    /**
+     * @brief write string to the output stream
+     *
+     * Write the string to the output stream and remember its last
+     * char, so the output never has to be read back.
+     *
+     * @return void
+     */
+    void write(const std::string &str);
+
     /**
-     * @brief apply indentation on sstream if last char is "\n"
+     * @brief apply indentation on stream if last char is "\n"
      *
-     * Apply indentation on sstream if last char is "\n"
+     * Apply indentation on stream if last char is "\n"
      *
      * @return void
      */
     void indent_if();
     
     /**
-     * @brief apply indentation on sstream if last char is "\n"
+     * @brief put "\n" into stream if last char is not "\n"
      *
-     * Apply indentation on sstream if last char is "\n"
+     * Put "\n" into stream if last char is not "\n"
      *
      * @return void
      */
     void endl_if();
+
+    /**
+     * @brief check whether entities of the given type are dumped
+     *
+     * True if no type filter is set or type is part of it.
+     *
+     * @return bool
+     */
+    bool wants(const std::string &type) const;
+
+    /**
+     * @brief check whether entities of the given type are visited
+     *
+     * True if the entities of type are dumped or may contain entities
+     * that are dumped.
+     *
+     * @return bool
+     */
+    bool needs(const std::string &type) const;
+
+    /**
+     * @brief check whether a nested list of entities is dumped
+     *
+     * True if the entities of type are needed and the maximum depth
+     * is not reached yet.
+     *
+     * @return bool
+     */
+    bool nested(const std::string &type) const;
+
+    /**
+     * @brief start an entity
+     *
+     * Put the entity header into the stream, increase indent level
+     * and depth. Returns false and puts nothing if the entity is not
+     * needed.
+     *
+     * @return bool whether the entity was started
+     */
+    bool open(const std::string &type, const std::string &id);
+
+    /**
+     * @brief end an entity
+     *
+     * Decrease indent level and depth, flush the stream once a top
+     * level entity is complete.
+     *
+     * @return void
+     */
+    void close();
+
+    /**
+     * @brief DataArray summary output into stream
+     *
+     * Output chunking, storage size, compression ratio and the range of
+     * the values, determined by a chunk-wise scan of the data.
+     *
+     * @return void
+     */
+    void summarize(const nix::DataArray &data_array);
     
     /**
      * @brief return item_str if and only if level is not zero
@@ -193,23 +275,32 @@ public:
     /**
      * @brief default ctor
      *
-     * The default constructor.
+     * The default constructor. Everything is written to ostream as
+     * soon as it is known.
+     *
+     * @param ostream   stream to write to
+     * @param max_depth maximum depth of nested entities, the file has depth 0
+     * @param types     entity types to dump, empty for all
+     * @param summary   summarize DataArrays & skip long values
      */
-    yamlstream(std::stringstream &sstream) : level(0), sstream(sstream) {};
+    yamlstream(std::ostream &ostream,
+               size_t max_depth = std::numeric_limits<size_t>::max(),
+               const std::set<std::string> &types = std::set<std::string>(),
+               bool summary = false)
+        : level(0), ostream(ostream), last('\n'), depth(0),
+          max_depth(max_depth), types(types), summary(summary) {};
 
     /**
-     * @brief return stringstream as string
-     *
-     * Return string from stringstream
+     * @brief names of the entity types accepted by the type filter
      *
-     * @return string string content of the stream
+     * @return set of entity type names
      */
-    std::string str();
+    static const std::set<std::string> &entity_types();
 
     /**
-     * @brief default output into stringstream
+     * @brief default output into stream
      *
-     * Use the default stringstream output.
+     * Use the default stream output.
      *
      * @param t parameter of any given type T
      * @return self
@@ -217,12 +308,14 @@ public:
     template<typename T>
     yamlstream& operator<<(const T &t) {
         indent_if();
-        sstream << t;
+        std::ostringstream tmp;
+        tmp << t;
+        write(tmp.str());
         return *this;
     }
     
     /**
-     * @brief vector output into stringstream
+     * @brief vector output into stream
      *
      * Output vector elements in inline yaml sequence style.
      *
@@ -233,17 +326,19 @@ public:
     yamlstream& operator<<(const std::vector<T> &t) {
         indent_if();
         if (t.size()) {
-            sstream << "[";
-            for (auto &el : t) {
-                sstream << el << ((*t.rbegin()) != el ? ", " : "");            
+            std::ostringstream tmp;
+            tmp << "[";
+            for (size_t i = 0; i < t.size(); i++) {
+                tmp << t[i] << (i + 1 < t.size() ? ", " : "");
             }
-            sstream << "]";
+            tmp << "]";
+            write(tmp.str());
         }
         return *this;
     }
     
     /**
-     * @brief NDSize output into stringstream
+     * @brief NDSize output into stream
      *
      * Build vector of sizes and output them as vector.
      *
@@ -253,7 +348,7 @@ public:
     yamlstream& operator<<(const nix::NDSize &t);
     
     /**
-     * @brief boost::optional output into stringstream
+     * @brief boost::optional output into stream
      *
      * De-referene boost::optional if and only if it is set and output
      * content (or empty string if not set) to stream.
@@ -263,31 +358,13 @@ public:
      */
     template<typename T>
     yamlstream& operator<<(const boost::optional<T> &t) {
-        indent_if();
-        auto opt = nix::util::deRef(t);
-        sstream << opt;
-        return *this;
+        return (*this) << nix::util::deRef(t);
     }
     
     /**
-     * @brief pointer to stringstream output into stringstream
+     * @brief Entity output into stream
      *
-     * Output via pointer to stringstream.
-     *
-     * @param ps pointer to stringstream
-     * @return self
-     */
-	yamlstream& operator<<(std::stringstream& (*ps)(std::stringstream&))
-	{
-        indent_if();
-		sstream << ps;
-		return *this;
-	}
-    
-    /**
-     * @brief Entity output into stringstream
-     *
-     * Output base Entity to stringstream.
+     * Output base Entity to stream.
      *
      * @param entity nix base Entity
      * @return self
@@ -303,9 +380,9 @@ public:
     }
 
     /**
-     * @brief NamedEntity output into stringstream
+     * @brief NamedEntity output into stream
      *
-     * Output base NamedEntity to stringstream.
+     * Output base NamedEntity to stream.
      *
      * @param entity nix base NamedEntity
      * @return self
@@ -322,9 +399,9 @@ public:
     }
 
     /**
-     * @brief EntityWithMetadata output into stringstream
+     * @brief EntityWithMetadata output into stream
      *
-     * Output base EntityWithMetadata to stringstream.
+     * Output base EntityWithMetadata to stream.
      *
      * @param entity nix base EntityWithMetadata
      * @return self
@@ -332,16 +409,18 @@ public:
     template<typename T>
     yamlstream& operator<<(const nix::base::EntityWithMetadata<T> &entityWithMetadata) {
         (*this)
-        << static_cast<nix::base::NamedEntity<T>>(entityWithMetadata)
-        << "metadata"; ++(*this) << entityWithMetadata.metadata(); --(*this);
+        << static_cast<nix::base::NamedEntity<T>>(entityWithMetadata);
+        if (nested("section")) {
+            (*this) << "metadata"; ++(*this) << entityWithMetadata.metadata(); --(*this);
+        }
         
         return *this;
     }
     
     /**
-     * @brief EntityWithSources output into stringstream
+     * @brief EntityWithSources output into stream
      *
-     * Output base EntityWithSources to stringstream.
+     * Output base EntityWithSources to stream.
      *
      * @param entity nix base EntityWithSources
      * @return self
@@ -357,9 +436,9 @@ public:
     }
 
     /**
-     * @brief Value output into stringstream
+     * @brief Value output into stream
      *
-     * Output Value to stringstream.
+     * Output Value to stream.
      *
      * @param entity nix value
      * @return self
@@ -367,9 +446,9 @@ public:
     yamlstream& operator<<(const nix::Value &value);
 
     /**
-     * @brief Property output into stringstream
+     * @brief Property output into stream
      *
-     * Output Property to stringstream.
+     * Output Property to stream.
      *
      * @param entity nix Property
      * @return self
@@ -377,9 +456,9 @@ public:
     yamlstream& operator<<(const nix::Property &property);
     
     /**
-     * @brief Source output into stringstream
+     * @brief Source output into stream
      *
-     * Output Source to stringstream.
+     * Output Source to stream.
      *
      * @param entity nix Source
      * @return self
@@ -387,9 +466,9 @@ public:
     yamlstream& operator<<(const nix::Source &source);
     
     /**
-     * @brief Section output into stringstream
+     * @brief Section output into stream
      *
-     * Output Section to stringstream.
+     * Output Section to stream.
      *
      * @param entity nix Section
      * @return self
@@ -397,9 +476,9 @@ public:
     yamlstream& operator<<(const nix::Section &section);
 
     /**
-     * @brief SetDimension output into stringstream
+     * @brief SetDimension output into stream
      *
-     * Output SetDimension to stringstream.
+     * Output SetDimension to stream.
      *
      * @param entity nix SetDimension
      * @return self
@@ -407,9 +486,9 @@ public:
     yamlstream& operator<<(const nix::SetDimension &dim);
 
     /**
-     * @brief SampledDimension output into stringstream
+     * @brief SampledDimension output into stream
      *
-     * Output SampledDimension to stringstream.
+     * Output SampledDimension to stream.
      *
      * @param entity nix SampledDimension
      * @return self
@@ -417,9 +496,9 @@ public:
     yamlstream& operator<<(const nix::SampledDimension &dim);
 
     /**
-     * @brief RangeDimension output into stringstream
+     * @brief RangeDimension output into stream
      *
-     * Output RangeDimension to stringstream.
+     * Output RangeDimension to stream.
      *
      * @param entity nix RangeDimension
      * @return self
@@ -427,9 +506,9 @@ public:
     yamlstream& operator<<(const nix::RangeDimension &dim);
 
     /**
-     * @brief Dimension output into stringstream
+     * @brief Dimension output into stream
      *
-     * Output Dimension to stringstream.
+     * Output Dimension to stream.
      *
      * @param entity nix Dimension
      * @return self
@@ -437,9 +516,9 @@ public:
     yamlstream& operator<<(const nix::Dimension &dim);
 
     /**
-     * @brief DataArray output into stringstream
+     * @brief DataArray output into stream
      *
-     * Output DataArray to stringstream.
+     * Output DataArray to stream.
      *
      * @param entity nix DataArray
      * @return self
@@ -447,9 +526,9 @@ public:
     yamlstream& operator<<(const nix::DataArray &data_array);
 
     /**
-     * @brief Feature output into stringstream
+     * @brief Feature output into stream
      *
-     * Output Feature to stringstream.
+     * Output Feature to stream.
      *
      * @param entity nix Feature
      * @return self
@@ -457,9 +536,9 @@ public:
     yamlstream& operator<<(const nix::Feature &feature);
 
     /**
-     * @brief Tag output into stringstream
+     * @brief Tag output into stream
      *
-     * Output Tag to stringstream.
+     * Output Tag to stream.
      *
      * @param entity nix Tag
      * @return self
@@ -467,9 +546,9 @@ public:
     yamlstream& operator<<(const nix::Tag &tag);
 
     /**
-     * @brief MultiTag output into stringstream
+     * @brief MultiTag output into stream
      *
-     * Output MultiTag to stringstream.
+     * Output MultiTag to stream.
      *
      * @param entity nix MultiTag
      * @return self
@@ -477,9 +556,9 @@ public:
     yamlstream& operator<<(const nix::MultiTag &multi_tag);
 
     /**
-     * @brief Block output into stringstream
+     * @brief Block output into stream
      *
-     * Output Block to stringstream.
+     * Output Block to stream.
      *
      * @param entity nix Block
      * @return self
@@ -487,9 +566,9 @@ public:
     yamlstream& operator<<(const nix::Block &block);
 
     /**
-     * @brief File output into stringstream
+     * @brief File output into stream
      *
-     * Output File to stringstream.
+     * Output File to stream.
      *
      * @param entity nix File
      * @return self
@@ -500,11 +579,8 @@ public:
 
 class Dump : virtual public IModule {
     
-    yamlstream yaml;
-    std::stringstream sstream;
-    
 public:
-    Dump() : yaml(yamlstream(sstream)) {}
+    Dump() {}
 
     static const char* module_name;
 
@@ -0,0 +1,409 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <Cli.hpp>
+#include <modules/Repack.hpp>
+#include <modules/Stat.hpp>
+
+#include <algorithm>
+#include <map>
+#include <regex>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+namespace po = boost::program_options;
+
+namespace cli {
+namespace module {
+
+const char* Repack::module_name = "repack";
+
+// average chunk size below which the chunks are considered too small
+static const nix::ndsize_t min_chunk_bytes = 8 * 1024;
+
+bool needs_rechunk(const nix::StorageLayout &layout) {
+    if (!layout.chunks) {
+        return true;
+    }
+
+    const LayoutStats stats = analyze(layout);
+    if (stats.total_chunks == 0) {
+        return false;
+    }
+
+    return stats.partial_waste * 8 > stats.raw_size ||
+           stats.raw_size / stats.total_chunks < min_chunk_bytes;
+}
+
+
+struct Rule {
+    std::regex            pattern;
+    bool                  keep = false;
+    nix::RepackTarget     target;
+};
+
+
+static nix::Compression parse_compression(const std::string &str) {
+    if (str == "keep") {
+        return nix::Compression::Auto;
+    } else if (str == "none") {
+        return nix::Compression::None;
+    } else if (str == "deflate") {
+        return nix::Compression::DeflateNormal;
+    }
+    throw std::invalid_argument("unknown compression '" + str + "', use keep, none or deflate");
+}
+
+
+// REGEX=CHUNKS[,COMPRESSION] with CHUNKS auto, keep or e.g. 1024x16
+static Rule parse_rule(const std::string &str, nix::Compression compression) {
+    const size_t eq = str.rfind('=');
+    if (eq == std::string::npos || eq == 0) {
+        throw std::invalid_argument("invalid rule '" + str + "', use REGEX=CHUNKS[,COMPRESSION]");
+    }
+
+    Rule rule;
+    rule.pattern = std::regex(str.substr(0, eq));
+    rule.target.compression = compression;
+
+    std::string spec = str.substr(eq + 1);
+    const size_t comma = spec.find(',');
+    if (comma != std::string::npos) {
+        rule.target.compression = parse_compression(spec.substr(comma + 1));
+        spec = spec.substr(0, comma);
+    }
+
+    if (spec == "keep") {
+        rule.keep = true;
+    } else if (spec != "auto") {
+        std::vector<nix::ndsize_t> dims;
+        std::stringstream ss(spec);
+        std::string item;
+        while (std::getline(ss, item, 'x')) {
+            size_t pos = 0;
+            unsigned long long val = 0;
+            try {
+                val = std::stoull(item, &pos);
+            } catch (const std::exception &) {
+                pos = 0;
+            }
+            if (pos == 0 || pos != item.size() || val == 0) {
+                throw std::invalid_argument("invalid chunks '" + spec + "', use auto, keep or e.g. 1024x16");
+            }
+            dims.push_back(val);
+        }
+        rule.target.chunks = nix::NDSize(dims.size());
+        for (size_t i = 0; i < dims.size(); i++) {
+            rule.target.chunks[i] = dims[i];
+        }
+    }
+
+    return rule;
+}
+
+
+// bytes compared per step, at least one chunk row of the copy
+static const nix::ndsize_t verify_step_bytes = 32 * 1024 * 1024;
+
+
+// rows of a comparison step: whole chunks of the copy along the first axis
+static nix::ndsize_t step_rows(const nix::NDSize &chunks, nix::ndsize_t row_bytes) {
+    const nix::ndsize_t unit = chunks.size() > 0 && chunks[0] > 0 ? chunks[0] : 1;
+    const nix::ndsize_t bytes = std::max<nix::ndsize_t>(unit * row_bytes, 1);
+    return unit * std::max<nix::ndsize_t>(verify_step_bytes / bytes, 1);
+}
+
+
+static size_t element_size(nix::DataType dtype) {
+    return dtype == nix::DataType::String ? sizeof(std::string) : nix::data_type_to_size(dtype);
+}
+
+
+// compare the stored data, one chunk aligned step at a time
+static bool same_data(const nix::DataArray &da, const nix::DataArray &copy) {
+    const nix::NDSize extent = da.dataExtent();
+    const nix::DataType dtype = da.dataType();
+    if (extent != copy.dataExtent() || dtype != copy.dataType()) {
+        return false;
+    }
+    if (extent.size() == 0 || extent.nelms() == 0) {
+        return true;
+    }
+
+    const nix::ndsize_t row_elms = extent.nelms() / extent[0];
+    const nix::ndsize_t rows = step_rows(copy.dataChunks(), row_elms * element_size(dtype));
+
+    nix::NDSize offset(extent.size(), 0);
+    nix::NDSize count = extent;
+    for (nix::ndsize_t first = 0; first < extent[0]; first += rows) {
+        offset[0] = first;
+        count[0] = std::min(rows, extent[0] - first);
+        const size_t n = nix::check::fits_in_size_t(count.nelms(), "repack: step exceeds memory");
+
+        if (dtype == nix::DataType::String) {
+            std::vector<std::string> a(n), b(n);
+            da.getDataDirect(dtype, a.data(), count, offset);
+            copy.getDataDirect(dtype, b.data(), count, offset);
+            if (a != b) {
+                return false;
+            }
+        } else {
+            std::vector<char> a(n * element_size(dtype)), b(n * element_size(dtype));
+            da.getDataDirect(dtype, a.data(), count, offset);
+            copy.getDataDirect(dtype, b.data(), count, offset);
+            if (a != b) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+
+// compare the columns and their data, in the same steps as data arrays
+static bool same_data(const nix::DataFrame &df, const nix::DataFrame &copy) {
+    const std::vector<nix::Column> cols = df.columns();
+    const std::vector<nix::Column> copy_cols = copy.columns();
+    const nix::ndsize_t nrows = df.rows();
+    if (nrows != copy.rows() || cols.size() != copy_cols.size()) {
+        return false;
+    }
+
+    nix::ndsize_t row_bytes = 0;
+    for (size_t i = 0; i < cols.size(); i++) {
+        if (cols[i].name != copy_cols[i].name || cols[i].dtype != copy_cols[i].dtype ||
+            cols[i].unit != copy_cols[i].unit) {
+            return false;
+        }
+        row_bytes += element_size(cols[i].dtype);
+    }
+
+    const nix::ndsize_t rows = step_rows(copy.dataLayout().chunks, row_bytes);
+    for (nix::ndsize_t first = 0; first < nrows; first += rows) {
+        const nix::ndsize_t count = std::min(rows, nrows - first);
+        const size_t n = nix::check::fits_in_size_t(count, "repack: step exceeds memory");
+
+        for (const auto &col : cols) {
+            if (col.dtype == nix::DataType::String) {
+                std::vector<std::string> a(n), b(n);
+                df.impl()->readColumn(col.name, first, count, col.dtype, a.data());
+                copy.impl()->readColumn(col.name, first, count, col.dtype, b.data());
+                if (a != b) {
+                    return false;
+                }
+            } else {
+                std::vector<char> a(n * element_size(col.dtype)), b(n * element_size(col.dtype));
+                df.impl()->readColumn(col.name, first, count, col.dtype, a.data());
+                copy.impl()->readColumn(col.name, first, count, col.dtype, b.data());
+                if (a != b) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+
+static bool same_properties(const nix::Section &section, const nix::Section &copy) {
+    if (section.name() != copy.name() || section.propertyCount() != copy.propertyCount()) {
+        return false;
+    }
+
+    for (const auto &prop : section.properties()) {
+        nix::Property prop_copy = copy.getProperty(prop.id());
+        if (!prop_copy || prop.name() != prop_copy.name() || prop.dataType() != prop_copy.dataType() ||
+            prop.values() != prop_copy.values()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+static std::vector<std::string> verify(const std::string &src_path, const std::string &dst_path) {
+    std::vector<std::string> problems;
+
+    nix::File src = nix::File::open(src_path, nix::FileMode::ReadOnly);
+    nix::File dst = nix::File::open(dst_path, nix::FileMode::ReadOnly);
+
+    if (src.blockCount() != dst.blockCount()) {
+        problems.push_back("number of blocks differs");
+    }
+
+    std::map<std::string, nix::Section> copied_sections;
+    for (const auto &section : dst.findSections()) {
+        copied_sections[section.id()] = section;
+    }
+    for (const auto &section : src.findSections()) {
+        auto it = copied_sections.find(section.id());
+        if (it == copied_sections.end()) {
+            problems.push_back("section " + section.id() + " is missing");
+        } else if (!same_properties(section, it->second)) {
+            problems.push_back("properties of section " + section.id() + " differ");
+        }
+    }
+
+    for (const auto &block : src.blocks()) {
+        nix::Block copy = dst.getBlock(block.id());
+        if (!copy) {
+            problems.push_back("block " + block.id() + " is missing");
+            continue;
+        }
+
+        if (block.tagCount() != copy.tagCount() || block.multiTagCount() != copy.multiTagCount() ||
+            block.dataFrameCount() != copy.dataFrameCount() || block.groupCount() != copy.groupCount()) {
+            problems.push_back("number of entities of block " + block.id() + " differs");
+        }
+
+        for (const auto &da : block.dataArrays()) {
+            nix::DataArray da_copy = copy.getDataArray(da.id());
+            if (!da_copy) {
+                problems.push_back("data array " + da.id() + " is missing");
+            } else if (!same_data(da, da_copy)) {
+                problems.push_back("data of data array " + da.id() + " differs");
+            }
+        }
+
+        for (const auto &df : block.dataFrames()) {
+            nix::DataFrame df_copy = copy.getDataFrame(df.id());
+            if (!df_copy) {
+                problems.push_back("data frame " + df.id() + " is missing");
+            } else if (!same_data(df, df_copy)) {
+                problems.push_back("data of data frame " + df.id() + " differs");
+            }
+        }
+    }
+
+    const nix::valid::Result res = dst.validate();
+    for (const auto &msg : res.getErrors()) {
+        problems.push_back("ID " + msg.id + " ERROR: " + msg.msg);
+    }
+
+    src.close();
+    dst.close();
+    return problems;
+}
+
+
+void Repack::load(po::options_description &desc) const {
+    desc.add(po::options_description("nix-tool " + std::string(module_name) + ":\n\n\t" +
+                                     "Copy a nix file, rewriting the data of all DataArrays and DataFrames\n\t" +
+                                     "with new chunks and compression, and verify the copy.\n\t" +
+                                     "Without a matching rule the chunks are guessed anew if they are\n\t" +
+                                     "too small or waste space, see the stat module.\n\nSupported options"));
+    po::options_description opt;
+    opt.add_options()
+        (OUTPUT_OPTION, po::value<std::string>(), "the file to write, e.g. --output=packed.nix")
+        (RULE_OPTION, po::value< std::vector<std::string> >(),
+                      "REGEX=CHUNKS[,COMPRESSION] for the data of entities with matching names, "
+                      "CHUNKS is auto, keep or e.g. 1024x16; may be repeated, the first match wins, "
+                      "e.g. --rule=^lfp.*=4096x1,deflate")
+        (COMPRESSION_OPTION, po::value<std::string>(), "compression of all data: keep (default), none or deflate")
+        (THREADS_OPTION, po::value<size_t>(), "number of compression threads, by default one per core")
+        (NOVERIFY_OPTION, "do not compare and validate the copy")
+    ;
+    desc.add(opt);
+}
+
+
+std::string Repack::call(const po::variables_map &vm, const po::options_description &desc) {
+    std::stringstream out;
+
+    // --help
+    if (vm.count(HELP_OPTION)) {
+        po::options_description temp;
+        load(temp);
+        out << temp << std::endl;
+        return out.str();
+    }
+
+    // --input-file
+    if (! vm.count(INPFILE_OPTION)) {
+        throw NoInputFile();
+    }
+
+    const auto &file_paths = vm[INPFILE_OPTION].as< std::vector<std::string> >();
+    if (file_paths.size() != 1) {
+        throw std::invalid_argument("repack takes exactly one input file");
+    }
+
+    const std::string &src = file_paths[0];
+    if (!boost::filesystem::exists(src)) {
+        throw FileNotFound(src);
+    }
+
+    if (!vm.count(OUTPUT_OPTION)) {
+        throw std::invalid_argument("No output file given, use --output=FILE");
+    }
+    const std::string dst = vm[OUTPUT_OPTION].as<std::string>();
+
+    const nix::Compression compression = vm.count(COMPRESSION_OPTION) ?
+                                         parse_compression(vm[COMPRESSION_OPTION].as<std::string>()) :
+                                         nix::Compression::Auto;
+
+    std::vector<Rule> rules;
+    if (vm.count(RULE_OPTION)) {
+        for (const auto &str : vm[RULE_OPTION].as< std::vector<std::string> >()) {
+            rules.push_back(parse_rule(str, compression));
+        }
+    }
+
+    const size_t nthreads = vm.count(THREADS_OPTION) ? vm[THREADS_OPTION].as<size_t>() : 0;
+
+    nix::RepackRule rule = [&rules, compression](const std::string &name, const nix::StorageLayout &layout) {
+        for (const Rule &r : rules) {
+            if (std::regex_search(name, r.pattern)) {
+                nix::RepackTarget target = r.target;
+                if (r.keep) {
+                    target.chunks = layout.chunks;
+                }
+                return target;
+            }
+        }
+
+        nix::RepackTarget target;
+        target.compression = compression;
+        if (!needs_rechunk(layout)) {
+            target.chunks = layout.chunks;
+        }
+        return target;
+    };
+
+    const nix::RepackStats stats = nix::repack(src, dst, rule, nthreads);
+
+    out << "repacked " << src << " to " << dst << std::endl
+        << "groups: " << stats.groups << ", data sets: " << stats.datasets
+        << ", attributes: " << stats.attributes << ", links: " << stats.links << std::endl
+        << "rewritten data sets: " << stats.rewritten << ", bytes: "
+        << stats.bytes_in << " -> " << stats.bytes_out << std::endl
+        << "file size: " << boost::filesystem::file_size(src) << " -> "
+        << boost::filesystem::file_size(dst) << std::endl;
+
+    if (!vm.count(NOVERIFY_OPTION)) {
+        const std::vector<std::string> problems = verify(src, dst);
+        for (const auto &problem : problems) {
+            out << problem << std::endl;
+        }
+        if (!problems.empty()) {
+            std::cout << out.str();
+            throw std::runtime_error("verification of " + dst + " failed");
+        }
+        out << "verified " << dst << std::endl;
+    }
+
+    return out.str();
+}
+
+} // namespace module
+} // namespace cli
@@ -0,0 +1,60 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef CLI_REPACK_H
+#define CLI_REPACK_H
+
+#include <Cli.hpp>
+#include <modules/IModule.hpp>
+
+#include <iostream>
+#include <boost/program_options.hpp>
+namespace po = boost::program_options;
+
+namespace cli {
+namespace module {
+
+const char *const OUTPUT_OPTION = "output";
+const char *const RULE_OPTION = "rule";
+const char *const COMPRESSION_OPTION = "compression";
+const char *const THREADS_OPTION = "threads";
+const char *const NOVERIFY_OPTION = "no-verify";
+
+/**
+ * @brief decide from the cost figures of a layout whether the data
+ *        should get new chunks
+ *
+ * Unchunked data, data with more than an eighth of the chunked space
+ * wasted on partial chunks and data split into chunks of less than
+ * 8 KiB on average are rechunked.
+ *
+ * @param layout the storage layout
+ * @return true if the chunks should be guessed anew
+ */
+bool needs_rechunk(const nix::StorageLayout &layout);
+
+class Repack : virtual public IModule {
+
+public:
+
+    static const char* module_name;
+
+    std::string name() const {
+        return std::string(module_name);
+    }
+
+    void load(po::options_description &desc) const;
+
+    std::string call(const po::variables_map &vm, const po::options_description &desc);
+
+};
+
+} // namespace module
+} // namespace cli
+
+#endif
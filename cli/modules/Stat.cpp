@@ -0,0 +1,293 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <Cli.hpp>
+#include <modules/Stat.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <sstream>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+namespace po = boost::program_options;
+
+namespace cli {
+namespace module {
+
+const char* Stat::module_name = "stat";
+
+// size of the HDF5 sieve buffer for unchunked data
+static const nix::ndsize_t sieve_size = 64 * 1024;
+
+static nix::ndsize_t ceil_div(nix::ndsize_t a, nix::ndsize_t b) {
+    return (a + b - 1) / b;
+}
+
+LayoutStats analyze(const nix::StorageLayout &layout) {
+    LayoutStats stats;
+    const nix::NDSize &shape = layout.shape;
+    const nix::NDSize &chunks = layout.chunks;
+    const nix::ndsize_t esize = layout.element_size;
+    const size_t rank = shape.size();
+
+    stats.raw_size = shape.nelms() * esize;
+    if (layout.storage_size > 0) {
+        stats.compression_ratio = static_cast<double>(stats.raw_size) / static_cast<double>(layout.storage_size);
+    }
+
+    if (rank == 0 || shape.nelms() == 0 || esize == 0) {
+        return stats;
+    }
+
+    // elements of a row, i.e. one index along the first axis
+    nix::ndsize_t row_elms = 1;
+    for (size_t i = 1; i < rank; i++) {
+        row_elms *= shape[i];
+    }
+
+    if (chunks.size() != rank) {
+        stats.row_amplification = 1.0;
+        if (rank == 1) {
+            stats.column_amplification = 1.0;
+        } else {
+            // every element of a column is in its own sieve buffer fill
+            nix::ndsize_t fill = std::min(row_elms * esize, sieve_size);
+            stats.column_amplification = static_cast<double>(std::max(fill, esize)) / esize;
+        }
+        return stats;
+    }
+
+    nix::ndsize_t full = 1, covered = 1, row_chunks = 1;
+    stats.total_chunks = 1;
+    for (size_t i = 0; i < rank; i++) {
+        const nix::ndsize_t n = ceil_div(shape[i], chunks[i]);
+        stats.total_chunks *= n;
+        full *= shape[i] / chunks[i];
+        covered *= n * chunks[i];
+        if (i > 0) {
+            row_chunks *= n;
+        }
+    }
+    stats.partial_chunks = stats.total_chunks - full;
+    stats.partial_waste = (covered - shape.nelms()) * esize;
+
+    const double chunk_elms = static_cast<double>(chunks.nelms());
+    stats.row_amplification = row_chunks * chunk_elms / row_elms;
+    stats.column_amplification = ceil_div(shape[0], chunks[0]) * chunk_elms / shape[0];
+
+    return stats;
+}
+
+
+static std::string json_str(const std::string &str) {
+    std::string res = "\"";
+    for (char c : str) {
+        switch (c) {
+            case '"':  res += "\\\""; break;
+            case '\\': res += "\\\\"; break;
+            case '\n': res += "\\n"; break;
+            case '\t': res += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buf[8];
+                    std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                    res += buf;
+                } else {
+                    res += c;
+                }
+        }
+    }
+    return res + "\"";
+}
+
+static std::string json_num(double val) {
+    if (!std::isfinite(val)) {
+        return "null";
+    }
+    std::ostringstream ss;
+    ss << val;
+    return ss.str();
+}
+
+static std::string json_list(const nix::NDSize &vals) {
+    std::string res = "[";
+    for (size_t i = 0; i < vals.size(); i++) {
+        res += (i ? ", " : "") + std::to_string(vals[i]);
+    }
+    return res + "]";
+}
+
+static std::string json_list(const std::vector<int> &vals) {
+    std::string res = "[";
+    for (size_t i = 0; i < vals.size(); i++) {
+        res += (i ? ", " : "") + std::to_string(vals[i]);
+    }
+    return res + "]";
+}
+
+static std::string json_list(const std::vector<std::string> &vals) {
+    std::string res = "[";
+    for (size_t i = 0; i < vals.size(); i++) {
+        res += (i ? ", " : "") + json_str(vals[i]);
+    }
+    return res + "]";
+}
+
+
+static void print_layout(std::ostream &out, const std::string &kind, const std::string &id,
+                         const std::string &name, const std::string &dtype,
+                         const nix::StorageLayout &layout) {
+    const LayoutStats stats = analyze(layout);
+
+    out << "{\"kind\": " << json_str(kind)
+        << ", \"id\": " << json_str(id)
+        << ", \"name\": " << json_str(name)
+        << ", \"dtype\": " << json_str(dtype)
+        << ", \"shape\": " << json_list(layout.shape)
+        << ", \"chunks\": " << (layout.chunks ? json_list(layout.chunks) : "null")
+        << ", \"element_size\": " << layout.element_size
+        << ", \"raw_size\": " << stats.raw_size
+        << ", \"storage_size\": " << layout.storage_size
+        << ", \"compression_ratio\": " << (layout.storage_size ? json_num(stats.compression_ratio) : "null")
+        << ", \"filters\": " << json_list(layout.filters)
+        << ", \"chunks_allocated\": " << layout.allocated_chunks
+        << ", \"chunks_total\": " << stats.total_chunks
+        << ", \"partial_chunks\": " << stats.partial_chunks
+        << ", \"partial_chunk_waste\": " << stats.partial_waste
+        << ", \"read_amplification\": {\"row\": " << json_num(stats.row_amplification)
+        << ", \"column\": " << json_num(stats.column_amplification) << "}}";
+}
+
+
+static void print_block(std::ostream &out, const nix::Block &block) {
+    auto data_arrays = block.dataArrays();
+    auto data_frames = block.dataFrames();
+    auto multi_tags = block.multiTags();
+    auto tags = block.tags();
+
+    nix::ndsize_t dims = 0, features = 0;
+    for (const auto &da : data_arrays) {
+        dims += da.dimensionCount();
+    }
+    for (const auto &mt : multi_tags) {
+        features += mt.featureCount();
+    }
+    for (const auto &tag : tags) {
+        features += tag.featureCount();
+    }
+    const nix::ndsize_t sources = block.findSources().size();
+    const nix::ndsize_t objects = 1 + data_arrays.size() + dims + data_frames.size() +
+                                  multi_tags.size() + tags.size() + features + sources;
+
+    out << "      {\n"
+        << "        \"id\": " << json_str(block.id()) << ",\n"
+        << "        \"name\": " << json_str(block.name()) << ",\n"
+        << "        \"objects\": " << objects << ",\n"
+        << "        \"counts\": {\"data_arrays\": " << data_arrays.size()
+        << ", \"dimensions\": " << dims
+        << ", \"data_frames\": " << data_frames.size()
+        << ", \"multi_tags\": " << multi_tags.size()
+        << ", \"tags\": " << tags.size()
+        << ", \"features\": " << features
+        << ", \"sources\": " << sources << "},\n";
+
+    out << "        \"data\": [";
+    std::string sep = "\n";
+    for (const auto &da : data_arrays) {
+        std::ostringstream dtype;
+        dtype << da.dataType();
+        out << sep << "          ";
+        print_layout(out, "data_array", da.id(), da.name(), dtype.str(), da.dataLayout());
+        sep = ",\n";
+    }
+    for (const auto &df : data_frames) {
+        out << sep << "          ";
+        print_layout(out, "data_frame", df.id(), df.name(), "compound", df.dataLayout());
+        sep = ",\n";
+    }
+    out << (sep == "\n" ? "]\n" : "\n        ]\n") << "      }";
+}
+
+
+void Stat::load(po::options_description &desc) const {
+    desc.add(po::options_description("nix-tool " + std::string(module_name) + ":\n\n\t" +
+                                     "Report the storage layout and estimated I/O cost of all DataArrays\n\t" +
+                                     "and DataFrames of the given nix files as JSON to std out.\n\nSupported options"));
+}
+
+
+std::string Stat::call(const po::variables_map &vm, const po::options_description &desc) {
+    std::stringstream out;
+
+    // --help
+    if (vm.count(HELP_OPTION)) {
+        po::options_description temp;
+        load(temp);
+        out << temp << std::endl;
+        return out.str();
+    }
+
+    // --input-file
+    if (! vm.count(INPFILE_OPTION)) {
+        throw NoInputFile();
+    }
+
+    const auto &file_paths = vm[INPFILE_OPTION].as< std::vector<std::string> >();
+    for (auto &file_path : file_paths) {
+        if (!boost::filesystem::exists(file_path)) {
+            throw FileNotFound(file_path);
+        }
+    }
+
+    // one report per file, each block is written as soon as it is done
+    std::cout << "[";
+    for (size_t i = 0; i < file_paths.size(); i++) {
+        nix::File file = nix::File::open(file_paths[i], nix::FileMode::ReadOnly);
+        if (!file.isOpen()) {
+            throw FileNotOpen(file_paths[i]);
+        }
+
+        // the file backend stores a directory tree
+        const uintmax_t file_size = boost::filesystem::is_regular_file(file_paths[i]) ?
+                                    boost::filesystem::file_size(file_paths[i]) : 0;
+
+        auto sections = file.findSections();
+        nix::ndsize_t properties = 0;
+        for (const auto &section : sections) {
+            properties += section.propertyCount();
+        }
+
+        std::cout << (i ? ",\n" : "\n")
+                  << "  {\n"
+                  << "    \"file\": " << json_str(file_paths[i]) << ",\n"
+                  << "    \"file_size\": " << file_size << ",\n"
+                  << "    \"format\": " << json_str(file.format()) << ",\n"
+                  << "    \"version\": " << json_list(file.version()) << ",\n"
+                  << "    \"sections\": " << sections.size() << ",\n"
+                  << "    \"properties\": " << properties << ",\n"
+                  << "    \"blocks\": [";
+
+        auto blocks = file.blocks();
+        for (size_t k = 0; k < blocks.size(); k++) {
+            std::cout << (k ? ",\n" : "\n");
+            print_block(std::cout, blocks[k]);
+            std::cout.flush();
+        }
+        std::cout << (blocks.empty() ? "]\n" : "\n    ]\n") << "  }";
+
+        file.close();
+    }
+    std::cout << "\n]" << std::endl;
+
+    return out.str();
+}
+
+} // namespace module
+} // namespace cli
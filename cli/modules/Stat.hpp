@@ -0,0 +1,75 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef CLI_STAT_H
+#define CLI_STAT_H
+
+#include <Cli.hpp>
+#include <modules/IModule.hpp>
+
+#include <iostream>
+#include <boost/program_options.hpp>
+namespace po = boost::program_options;
+
+namespace cli {
+namespace module {
+
+/**
+ * @brief Cost figures derived from the storage layout of a data set.
+ *
+ * All sizes are in bytes of uncompressed data. The read amplification
+ * is the number of bytes that have to be read (and decompressed) per
+ * requested byte, for reading a single row (one index along the first
+ * axis, all of the others) or a single column (all of the first axis,
+ * one index along the others).
+ */
+struct LayoutStats {
+    nix::ndsize_t raw_size = 0;
+    /** raw_size / storage_size, 0 if the storage size is unknown */
+    double        compression_ratio = 0;
+    /** chunks needed to cover the shape */
+    nix::ndsize_t total_chunks = 0;
+    /** chunks only partially covered by the shape */
+    nix::ndsize_t partial_chunks = 0;
+    /** bytes of the partial chunks not covered by the shape */
+    nix::ndsize_t partial_waste = 0;
+    double        row_amplification = 0;
+    double        column_amplification = 0;
+};
+
+/**
+ * @brief compute the cost figures of a storage layout
+ *
+ * Unchunked data is assumed to be read through the 64 KiB sieve
+ * buffer of HDF5 when accessed column-wise.
+ *
+ * @param layout the storage layout
+ * @return the cost figures
+ */
+LayoutStats analyze(const nix::StorageLayout &layout);
+
+class Stat : virtual public IModule {
+
+public:
+
+    static const char* module_name;
+
+    std::string name() const {
+        return std::string(module_name);
+    }
+
+    void load(po::options_description &desc) const;
+
+    std::string call(const po::variables_map &vm, const po::options_description &desc);
+
+};
+
+} // namespace module
+} // namespace cli
+
+#endif
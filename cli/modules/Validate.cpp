@@ -11,6 +11,8 @@
 #include <nix/None.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
+
+#include <ctime>
 namespace po = boost::program_options;
 
 namespace cli {
@@ -25,6 +27,8 @@ void Validate::load(po::options_description &desc) const {
     opt.add_options()
         (NOWARN_OPTION, "ignore any warnings")
         (NOERR_OPTION, "ignore any errors")
+        (INCREMENTAL_OPTION, "only validate entities changed since the last run without errors "
+                             "and record this run in the file (opens the file read-write)")
     ;
     desc.add(opt);
 }
@@ -46,6 +50,19 @@ std::ostream &print(std::ostream &out,
     return out;
 }
 
+std::ostream &print_skipped(std::ostream &out,
+                            const std::vector<nix::valid::Message> &msgs) {
+
+    for (const auto &msg : msgs) {
+        out << "ID " << msg.id << " ";
+        if (msg.name)
+            out << "['" << *msg.name << "'] ";
+        out << "SKIPPED: " << msg.msg << std::endl;
+    }
+
+    return out;
+}
+
 std::string Validate::call(const po::variables_map &vm, const po::options_description &desc) {
     std::vector<nix::File> files; // opened nix files
     std::stringstream out;
@@ -63,6 +80,9 @@ std::string Validate::call(const po::variables_map &vm, const po::options_descri
         throw NoInputFile();
     }
 
+    const bool incremental = vm.count(INCREMENTAL_OPTION) > 0;
+    const nix::FileMode mode = incremental ? nix::FileMode::ReadWrite : nix::FileMode::ReadOnly;
+
     for (auto &file_path : vm[INPFILE_OPTION].as< std::vector<std::string> >()) {
         nix::File tmp_file;
 
@@ -70,7 +90,7 @@ std::string Validate::call(const po::variables_map &vm, const po::options_descri
             throw FileNotFound(file_path);
         }
 
-        tmp_file = nix::File::open(file_path, nix::FileMode::ReadOnly);
+        tmp_file = nix::File::open(file_path, mode);
 
         if (!tmp_file.isOpen()) {
             throw FileNotOpen(file_path);
@@ -81,7 +101,18 @@ std::string Validate::call(const po::variables_map &vm, const po::options_descri
 
     for (auto &nix_file : files) {
         out << "validating file " << nix_file.location() << std::endl;
-        const nix::valid::Result &res = nix_file.validate();
+
+        const time_t start = time(NULL);
+        const time_t since = incremental ? nix_file.validatedAt() : 0;
+        if (since != 0) {
+            out << "skipping entities unchanged since " << nix::util::timeToStr(since) << std::endl;
+        }
+
+        const nix::valid::Result &res = nix_file.validateModified(since);
+
+        if (res.hasSkipped()) {
+            print_skipped(out, res.getSkipped());
+        }
 
         if (res.hasWarnings() && ! vm.count(NOWARN_OPTION)) {
             const std::vector<nix::valid::Message> &warnings = res.getWarnings();
@@ -93,6 +124,10 @@ std::string Validate::call(const po::variables_map &vm, const po::options_descri
             print(out, errors, true);
 
         }
+
+        if (incremental && !res.hasErrors()) {
+            nix_file.forceValidatedAt(start);
+        }
     }
 
     std::cout << std::endl;
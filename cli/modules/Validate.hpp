@@ -21,6 +21,7 @@ namespace module {
 
 const char *const NOWARN_OPTION = "no-warnings";
 const char *const NOERR_OPTION = "no-errors";
+const char *const INCREMENTAL_OPTION = "incremental";
     
 class Validate : virtual public IModule {
     
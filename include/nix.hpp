@@ -24,3 +24,15 @@
 #include <nix/Source.hpp>
 #include <nix/Value.hpp>
 #include <nix/Compression.hpp>
+#include <nix/Arena.hpp>
+#include <nix/IOExecutor.hpp>
+#include <nix/ReadAhead.hpp>
+#include <nix/ChunkIterator.hpp>
+#include <nix/MapData.hpp>
+#include <nix/StorageLayout.hpp>
+#include <nix/StringStorage.hpp>
+#include <nix/Repack.hpp>
+#include <nix/IOTrace.hpp>
+#include <nix/MetadataSnapshot.hpp>
+#include <nix/IntervalIndex.hpp>
+#include <nix/Selection.hpp>
@@ -0,0 +1,179 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_ARENA_H
+#define NIX_ARENA_H
+
+#include <nix/Platform.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace nix {
+
+/**
+ * @brief A simple bump allocator for scratch buffers.
+ *
+ * The I/O paths of the library need temporary buffers for type
+ * conversions, string handling and polynomial calibration. By
+ * default these are allocated on the heap for every call. When an
+ * Arena is installed for the current thread (see {@link ArenaScope})
+ * these buffers are carved out of the arena instead and released
+ * all at once by {@link Arena::reset}.
+ *
+ * ~~~
+ * nix::Arena arena;
+ * for (auto &da : arrays) {
+ *     nix::ArenaScope scope(arena); // reset when scope ends
+ *     da.getData(values);
+ * }
+ * ~~~
+ *
+ * An Arena must only be used from one thread at a time.
+ */
+class NIXAPI Arena {
+
+public:
+
+    explicit Arena(size_t block_size = 1024 * 1024);
+
+    Arena(const Arena &other) = delete;
+    Arena &operator=(const Arena &other) = delete;
+
+    /**
+     * @brief Allocate nbytes of memory aligned to align.
+     *
+     * The memory is valid until the next call to {@link reset}.
+     */
+    void *allocate(size_t nbytes, size_t align = alignof(std::max_align_t));
+
+    /**
+     * @brief Release all allocations at once.
+     *
+     * If the arena had to grow, the blocks are coalesced into a single
+     * block, so that a steady state loop does not hit the heap at all.
+     */
+    void reset();
+
+    size_t capacity() const;
+
+    size_t bytesUsed() const { return used; }
+
+    size_t allocations() const { return nallocs; }
+
+    /**
+     * @brief The arena installed for the calling thread, or nullptr.
+     */
+    static Arena *current();
+
+private:
+
+    friend class ArenaScope;
+
+    static Arena *install(Arena *arena);
+
+    void grow(size_t min_size);
+
+    struct Chunk {
+        std::unique_ptr<char[]> mem;
+        size_t                  size;
+    };
+
+    size_t             block_size;
+    std::vector<Chunk> chunks;
+    size_t             pos;
+    size_t             used;
+    size_t             nallocs;
+};
+
+/**
+ * @brief Installs an {@link Arena} for the current thread.
+ *
+ * The previously installed arena (if any) is restored on destruction.
+ * If reset_on_exit is true (the default) the arena is reset when the
+ * scope ends, which gives a reset-per-iteration mode for loops.
+ */
+class NIXAPI ArenaScope {
+
+public:
+
+    explicit ArenaScope(Arena &arena, bool reset_on_exit = true);
+
+    ArenaScope(const ArenaScope &other) = delete;
+    ArenaScope &operator=(const ArenaScope &other) = delete;
+
+    ~ArenaScope();
+
+private:
+    Arena *arena;
+    Arena *previous;
+    bool   reset_on_exit;
+};
+
+/**
+ * @brief Scratch buffer for trivial types.
+ *
+ * Takes the memory from the current thread's {@link Arena} if one is
+ * installed, from the heap otherwise. The content is uninitialized.
+ */
+template<typename T>
+class ScratchBuffer {
+
+public:
+
+    ScratchBuffer() : nelms(0), buffer(nullptr), heap(nullptr) { }
+
+    explicit ScratchBuffer(size_t n) : ScratchBuffer() {
+        resize(n);
+    }
+
+    ScratchBuffer(const ScratchBuffer &other) = delete;
+    ScratchBuffer &operator=(const ScratchBuffer &other) = delete;
+
+    T *data() { return buffer; }
+    const T *data() const { return buffer; }
+
+    size_t size() const { return nelms; }
+
+    T &operator[](size_t i) { return buffer[i]; }
+    const T &operator[](size_t i) const { return buffer[i]; }
+
+    T *begin() { return buffer; }
+    T *end() { return buffer + nelms; }
+
+    /**
+     * @brief Replace the buffer with one of n elements; the old content is lost.
+     */
+    void resize(size_t n) {
+        delete[] heap;
+        heap = nullptr;
+        nelms = n;
+
+        Arena *arena = Arena::current();
+        if (arena != nullptr) {
+            buffer = static_cast<T *>(arena->allocate(n * sizeof(T), alignof(T)));
+        } else {
+            heap = new T[n];
+            buffer = heap;
+        }
+    }
+
+    ~ScratchBuffer() {
+        delete[] heap;
+    }
+
+private:
+    size_t  nelms;
+    T      *buffer;
+    T      *heap;
+};
+
+} // namespace nix
+
+#endif // NIX_ARENA_H
@@ -17,6 +17,7 @@
 #include <nix/MultiTag.hpp>
 #include <nix/Tag.hpp>
 #include <nix/Group.hpp>
+#include <nix/IntervalIndex.hpp>
 #include <nix/Platform.hpp>
 
 #include <nix/util/util.hpp>
@@ -26,6 +27,20 @@
 
 namespace nix {
 
+/**
+ * @brief A box of the data of a DataArray, placed into a virtual DataArray.
+ */
+struct VirtualSlice {
+    /** The DataArray holding the data. */
+    DataArray source;
+    /** The shape of the box. */
+    NDSize    count;
+    /** The position of the box in the source, empty for the origin. */
+    NDSize    source_offset;
+    /** The position of the box in the virtual DataArray, empty for the origin. */
+    NDSize    offset;
+};
+
 /**
  * @brief Class for grouping further data entities.
  *
@@ -351,14 +366,17 @@ public:
     * @param data_type    A nix::DataType indicating the format to store values.
     * @param shape        A NDSize holding the extent of the array to create.
     * @param compression  En-/disable dataset compression, default nix::Compression::Auto.
+    * @param strings      The layout of string data, see nix::StringStorage; fixed
+    *                     length storage needs an explicit length here.
     *
     * @return The newly created data array.
     */
-    DataArray createDataArray(const std::string &name,
-                              const std::string &type,
-                              nix::DataType      data_type,
-                              const NDSize      &shape,
-                              const Compression &compression=Compression::Auto);
+    DataArray createDataArray(const std::string   &name,
+                              const std::string   &type,
+                              nix::DataType        data_type,
+                              const NDSize        &shape,
+                              const Compression   &compression=Compression::Auto,
+                              const StringStorage &strings=StringStorage());
 
     /**
     * @brief Create a new data array associated with this block.
@@ -368,6 +386,7 @@ public:
     * @param data      Data to create array with.
     * @param data_type A optional nix::DataType indicating the format to store values.
     * @param compression  En-/disable dataset compression, default nix::Compression::Auto.
+    * @param strings      The layout of string data, see nix::StringStorage.
     *
     * Create a data array with shape and type inferred from data. After
     * successful creation, the contents of data will be written to the
@@ -381,7 +400,8 @@ public:
                               const std::string &type,
                               const T &data,
                               DataType data_type=DataType::Nothing,
-                              const Compression &compression=Compression::Auto) {
+                              const Compression &compression=Compression::Auto,
+                              const StringStorage &strings=StringStorage()) {
          const Hydra<const T> hydra(data);
 
          if (data_type == DataType::Nothing) {
@@ -389,7 +409,7 @@ public:
          }
 
          const NDSize shape = hydra.shape();
-         DataArray da = createDataArray(name, type, data_type, shape, compression);
+         DataArray da = createDataArray(name, type, data_type, shape, compression, strings);
 
          const NDSize offset(shape.size(), 0);
          da.setData(data, offset);
@@ -397,6 +417,78 @@ public:
          return da;
     }
 
+    /**
+     * @brief Create a data array whose data are boxes of other data arrays.
+     *
+     * The data is not copied: the data array is a view of the sources,
+     * which may be in other blocks and files. Elements no slice maps
+     * read as 0. The hdf5 and the memory backend support virtual data.
+     * The hdf5 backend stores a virtual data set that finds the sources
+     * by the name of their file, so they should not be moved; elements
+     * of missing files read as 0. The memory backend only maps sources
+     * of the memory backend, and a file that is saved stores a copy of
+     * the data.
+     *
+     * @param name       The name of the data array to create.
+     * @param type       The type of the data array.
+     * @param data_type  The data type, which all sources must have.
+     * @param shape      The extent of the data array.
+     * @param slices     The boxes of the sources and where they go.
+     *
+     * @return The newly created data array.
+     */
+    DataArray createVirtualDataArray(const std::string &name,
+                                     const std::string &type,
+                                     DataType data_type,
+                                     const NDSize &shape,
+                                     const std::vector<VirtualSlice> &slices);
+
+    /**
+     * @brief Create a virtual data array that joins data arrays along one axis.
+     *
+     * The sources must have the same data type, calibration and unit and
+     * the same extent along all other axes. The dimensions are merged:
+     * sampled dimensions along axis need the same sampling interval and
+     * stay a sampled dimension if each source starts one interval after
+     * the last sample of the previous one; otherwise they become a range
+     * dimension of the sample positions of all sources. The ticks of
+     * range dimensions, and those sample positions, are joined and
+     * shifted where they would not increase, so that each source
+     * continues where the previous one ended, and the labels of set
+     * dimensions are joined. All other dimensions are
+     * copied from the first source, as is the metadata if all sources
+     * share it and it is a section of the file of this block. See
+     * {@link createVirtualDataArray}.
+     *
+     * @param name      The name of the data array to create.
+     * @param type      The type of the data array.
+     * @param sources   The data arrays to join, in order.
+     * @param axis      The axis along which they are joined.
+     *
+     * @return The newly created data array.
+     */
+    DataArray concatenateDataArrays(const std::string &name,
+                                    const std::string &type,
+                                    const std::vector<DataArray> &sources,
+                                    size_t axis);
+
+    /**
+     * @brief Copy a data array, e.g. a virtual one, into a stored data array of this block.
+     *
+     * The raw data is copied chunk by chunk, together with the
+     * calibration, unit, label, dimensions and metadata link; the
+     * latter only if the section is in the file of this block.
+     *
+     * @param source        The data array to copy.
+     * @param name          The name of the data array to create.
+     * @param compression   The compression of the copy.
+     *
+     * @return The newly created data array.
+     */
+    DataArray materializeDataArray(const DataArray &source,
+                                   const std::string &name,
+                                   const Compression &compression=Compression::Auto);
+
     /**
      * @brief Deletes a data array from this block.
      *
@@ -437,7 +529,8 @@ public:
      *
      * @param name         The name of the data frame to create.
      * @param type         The type of the data frame.
-     * @param cols         A vector of nix::Column representing the columns to create.
+     * @param cols         A vector of nix::Column representing the columns to create;
+     *                     string columns may choose a nix::StringStorage.
      * @param compression  En-/disable dataset compression, default nix::Compression::Auto.
      *
      * @return The newly created data frame.
@@ -451,6 +544,14 @@ public:
                 std::string msg = "Incompatible DataType for column ";
                 throw std::invalid_argument(msg + c.name);
             }
+            if (c.strings.mode != StringStorage::Mode::Variable && c.dtype != DataType::String) {
+                std::string msg = "String storage for non-string column ";
+                throw std::invalid_argument(msg + c.name);
+            }
+            if (c.strings.mode == StringStorage::Mode::Fixed && c.strings.length == 0) {
+                std::string msg = "Missing length of fixed length strings for column ";
+                throw std::invalid_argument(msg + c.name);
+            }
         }
         return backend()->createDataFrame(name, type, cols, compression);
     }
@@ -637,6 +738,40 @@ public:
         return backend()->entityCount(ObjectType::Tag);
     }
 
+    /**
+     * @brief Build an index over the positions and extents of all tags along one dimension.
+     *
+     * Positions and extents are scaled from the units of each tag to
+     * the given unit, or to the unit of the first tag that has one if
+     * unit is empty; tags without a unit for the dimension are taken
+     * as is, tags with fewer dimensions are left out. The index refers
+     * to tags by their index in {@link tags}. Build a new index after
+     * creating, deleting or changing tags.
+     *
+     * @param dim       The dimension of the positions to index.
+     * @param unit      The unit of the index, may be empty.
+     *
+     * @return The index.
+     */
+    IntervalIndex tagIntervalIndex(size_t dim = 0, const std::string &unit = "") const;
+
+    /**
+     * @brief Get the tags whose extent overlaps the window [start, end].
+     *
+     * Tags without an extent match if their position lies within the
+     * window. This builds an index with {@link tagIntervalIndex} on each
+     * call; keep that index for repeated queries.
+     *
+     * @param start     The start of the window.
+     * @param end       The end of the window.
+     * @param dim       The dimension of the positions to compare.
+     * @param unit      The unit of start and end, may be empty.
+     *
+     * @return The matching tags in the order of {@link tags}.
+     */
+    std::vector<Tag> tagsOverlapping(double start, double end, size_t dim = 0,
+                                     const std::string &unit = "") const;
+
     /**
      * @brief Create a new tag associated with this block.
      *
@@ -0,0 +1,186 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_CHUNK_ITERATOR_H
+#define NIX_CHUNK_ITERATOR_H
+
+#include <nix/DataArray.hpp>
+#include <nix/DataView.hpp>
+
+#include <nix/Platform.hpp>
+
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace nix {
+
+/**
+ * @brief Sequential scan over a DataArray or DataView in storage chunk order.
+ *
+ * The data is split into steps along axis, each step spanning the full
+ * extent of all other dimensions. The step boundaries lie on the chunk
+ * grid of the array (see {@link DataArray::dataChunks}), a step spans
+ * blocks chunks along axis; for unchunked data a block is about 1 MiB.
+ * Every chunk thus belongs to exactly one step and is read and
+ * decompressed once.
+ *
+ * By default next() reads each step on the calling thread, so only
+ * the current step is held in memory and arrays larger than memory
+ * can be streamed. With prefetch the next step is read on the
+ * {@link IOExecutor} while the caller processes the current one.
+ * Unless the HDF5 library was built thread-safe, the caller must then
+ * not access the file in any other way while the iterator is alive,
+ * e.g. by reading or writing other DataArrays of it in the loop body,
+ * other than through {@link IOExecutor::submit}.
+ *
+ * ~~~
+ * nix::ChunkIterator it(array, 1, 4, nix::DataType::Double);
+ * while (it.next()) {
+ *     const double *values = it.data<double>();
+ *     // it.count() elements at it.offset()
+ * }
+ * ~~~
+ *
+ * For a DataView, offsets are relative to the view; the first and the
+ * last step may be shorter so that all others stay chunk aligned. The
+ * array must not be modified during the scan.
+ */
+class NIXAPI ChunkIterator {
+
+public:
+
+    /**
+     * @brief Create an iterator over all data of array.
+     *
+     * @param array      The DataArray to read.
+     * @param axis       The axis along which to step.
+     * @param blocks     The number of chunks along axis per step.
+     * @param dtype      The data type of the buffers; defaults to the
+     *                   data type of the array, or double if the array
+     *                   is calibrated and calibrate is true.
+     * @param calibrate  Apply polynomial and expansion origin, as
+     *                   {@link DataArray::getData} does; if false the
+     *                   raw values are returned, as by
+     *                   {@link DataArray::getDataDirect}.
+     * @param prefetch   Read the next step in the background, see
+     *                   above for the restrictions this imposes.
+     */
+    explicit ChunkIterator(const DataArray &array,
+                           size_t axis = 0,
+                           size_t blocks = 1,
+                           DataType dtype = DataType::Nothing,
+                           bool calibrate = true,
+                           bool prefetch = false);
+
+    /**
+     * @brief Create an iterator over the region of a DataView.
+     *
+     * See the DataArray constructor for the parameters.
+     */
+    explicit ChunkIterator(const DataView &view,
+                           size_t axis = 0,
+                           size_t blocks = 1,
+                           DataType dtype = DataType::Nothing,
+                           bool calibrate = true,
+                           bool prefetch = false);
+
+    ChunkIterator(const ChunkIterator &other) = delete;
+    ChunkIterator &operator=(const ChunkIterator &other) = delete;
+
+    /**
+     * @brief Advance to the next step.
+     *
+     * Must be called once before accessing the first step.
+     *
+     * @return False if there are no more steps.
+     */
+    bool next();
+
+    /**
+     * @brief The number of steps of the scan.
+     */
+    ndsize_t size() const { return nsteps; }
+
+    /**
+     * @brief The index of the current step.
+     */
+    ndsize_t index() const { return current.index; }
+
+    /**
+     * @brief The offset of the current step.
+     */
+    const NDSize &offset() const { return current.offset; }
+
+    /**
+     * @brief The shape of the current step.
+     */
+    const NDSize &count() const { return current.count; }
+
+    /**
+     * @brief The data type of the buffers.
+     */
+    DataType dataType() const { return dtype; }
+
+    /**
+     * @brief The data of the current step in row-major order.
+     *
+     * The buffer is reused for a later step by the next call to next().
+     */
+    const void *data() const;
+
+    /**
+     * @brief The data of the current step in row-major order.
+     *
+     * T must match {@link dataType}.
+     */
+    template<typename T>
+    const T *data() const {
+        if (to_data_type<T>::value != dtype) {
+            throw std::invalid_argument("ChunkIterator: type does not match the data type of the buffers");
+        }
+        return static_cast<const T *>(data());
+    }
+
+    ~ChunkIterator();
+
+private:
+
+    struct Step {
+        ndsize_t                           index;
+        NDSize                             offset;
+        NDSize                             count;
+        std::shared_ptr<std::vector<char>> buffer;
+        std::shared_future<void>           ready;
+    };
+
+    void init(const NDSize &region_offset, const NDSize &region_count);
+
+    Step fetch(ndsize_t index, std::shared_ptr<std::vector<char>> buffer) const;
+
+    DataArray array;
+    NDSize    origin;
+    NDSize    extent;
+    DataType  dtype;
+    bool      calibrate;
+    bool      prefetch;
+    size_t    axis;
+    size_t    blocks;
+    ndsize_t  step_len;
+    ndsize_t  first_step;
+    ndsize_t  nsteps;
+    bool      started;
+
+    Step current;
+    Step ahead;
+};
+
+} // namespace nix
+
+#endif // NIX_CHUNK_ITERATOR_H
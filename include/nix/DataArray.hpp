@@ -19,9 +19,45 @@
 #include <nix/Platform.hpp>
 #include <nix/util/util.hpp>
 
+#include <future>
+
 
 namespace nix {
 
+/**
+ * @brief Min, max and mean of consecutive bins of samples.
+ *
+ * See {@link DataArray::envelope}.
+ */
+struct Envelope {
+    /** The position of the first sample of each bin. */
+    std::vector<double> position;
+    std::vector<double> min;
+    std::vector<double> max;
+    std::vector<double> mean;
+    /** The number of samples per bin; the last bin may be shorter. */
+    ndsize_t            stride;
+};
+
+/**
+ * @brief Summary statistics of a DataArray along one axis.
+ *
+ * See {@link DataArray::statistics}. All vectors are stored in row-major
+ * order with the given shape.
+ */
+struct Statistics {
+    /** The extent of the data without the reduced axis. */
+    NDSize              shape;
+    /** The number of samples reduced into each element. */
+    ndsize_t            count;
+    std::vector<double> sum;
+    std::vector<double> mean;
+    /** The population variance, i.e. normalized by count. */
+    std::vector<double> variance;
+    std::vector<double> min;
+    std::vector<double> max;
+};
+
 // TODO add documentation for undocumented methods.
 
 /**
@@ -196,6 +232,7 @@ public:
      */
     void expansionOrigin(double expansion_origin) {
         backend()->expansionOrigin(expansion_origin);
+        refreshEnvelopes();
     }
 
     /**
@@ -208,6 +245,7 @@ public:
      */
     void expansionOrigin(const none_t t) {
         backend()->expansionOrigin(t);
+        refreshEnvelopes();
     }
 
     /**
@@ -221,6 +259,7 @@ public:
     void polynomCoefficients(const std::vector<double> &polynom_coefficients,
                              const Compression &compression=Compression::None) {
         backend()->polynomCoefficients(polynom_coefficients, compression);
+        refreshEnvelopes();
     }
 
     /**
@@ -239,6 +278,7 @@ public:
      */
     void polynomCoefficients(const none_t t) {
         backend()->polynomCoefficients(t);
+        refreshEnvelopes();
     }
 
     //--------------------------------------------------
@@ -456,9 +496,7 @@ public:
      *
      * @param extent    The extent of the data.
      */
-    void dataExtent(const NDSize &extent) {
-        backend()->dataExtent(extent);
-    }
+    void dataExtent(const NDSize &extent);
 
     /**
      * @brief Get the data type of the data stored in the DataArray entity.
@@ -469,8 +507,313 @@ public:
         return backend()->dataType();
     }
 
+    /**
+     * @brief Get the shape of the chunks the data is stored in.
+     *
+     * Reading and writing in chunk aligned blocks avoids decompressing
+     * or touching a chunk more than once.
+     *
+     * @return The chunk shape or an empty NDSize if the data is not chunked.
+     */
+    NDSize dataChunks(void) const {
+        return backend()->dataChunks();
+    }
+
+    /**
+     * @brief Get the number of bytes the data occupies in the file.
+     *
+     * Compared to the size of the data in memory this gives the
+     * compression ratio.
+     *
+     * @return The allocated size or 0 if the backend does not know it.
+     */
+    ndsize_t dataStorageSize(void) const {
+        return backend()->dataStorageSize();
+    }
+
+    /**
+     * @brief Get the storage layout of the data.
+     *
+     * Shape, chunking, filters and allocated space of the data, e.g.
+     * to find the cause of slow access.
+     *
+     * @return The storage layout.
+     */
+    StorageLayout dataLayout(void) const {
+        return backend()->dataLayout();
+    }
+
+    /**
+     * @brief Get the layout of string data, see {@link nix::StringStorage}.
+     *
+     * The layout is chosen when the data array is created and does not
+     * change how the strings are read or written.
+     *
+     * @return The string layout; variable if the data are not strings.
+     */
+    StringStorage stringStorage(void) const {
+        return backend()->stringStorage();
+    }
+
+    /**
+     * @brief Get the distinct strings of dictionary encoded data.
+     *
+     * Entry i of the table is the string with code i, see {@link stringCodes}.
+     *
+     * @return The string table; empty if the data are not dictionary encoded.
+     */
+    std::vector<std::string> stringDictionary(void) const {
+        return backend()->stringDictionary();
+    }
+
+    /**
+     * @brief Read the codes of dictionary encoded string data.
+     *
+     * Comparing codes is much cheaper than comparing strings: to select
+     * all entries with a certain label, look up the code of the label in
+     * the {@link stringDictionary} and compare the codes with it.
+     *
+     * @param codes     The vector to read the codes into; it is resized to
+     *                  the number of elements of count.
+     * @param count     The number of elements to read along each dimension.
+     * @param offset    The start of the selection.
+     */
+    void stringCodes(std::vector<uint32_t> &codes, const NDSize &count, const NDSize &offset) const;
+
+    /**
+     * @brief Read the codes of all dictionary encoded string data.
+     *
+     * @param codes     The vector to read the codes into.
+     */
+    void stringCodes(std::vector<uint32_t> &codes) const;
+
     void appendData(DataType dtype, const void *data, const NDSize &count, size_t axis);
 
+    //--------------------------------------------------
+    // Envelopes
+    //--------------------------------------------------
+
+    /**
+     * @brief Build a min/max/mean pyramid of the (1-d) data.
+     *
+     * Level 1 of the pyramid holds the min, max and mean of each block
+     * of factor samples, every further level combines factor entries
+     * of the level below. The levels are stored next to the data and
+     * are kept up to date by {@link setData}, {@link appendData} and
+     * {@link dataExtent}: only the blocks touched by a write are
+     * recomputed. The envelopes hold calibrated values, i.e. changing
+     * the {@link polynomCoefficients} or the {@link expansionOrigin}
+     * rebuilds them.
+     *
+     * @param factor    The number of entries combined per level.
+     */
+    void createEnvelopes(ndsize_t factor = 16);
+
+    /**
+     * @brief Check if the DataArray has envelopes.
+     */
+    bool hasEnvelopes() const {
+        return backend()->envelopeFactor() > 0;
+    }
+
+    /**
+     * @brief Remove the envelopes.
+     */
+    void deleteEnvelopes() {
+        backend()->envelopeFactor(0);
+    }
+
+    /**
+     * @brief Get the envelope of a range of samples.
+     *
+     * Returns at most points bins covering the samples [offset,
+     * offset + count), read from the coarsest pyramid level that
+     * still provides points entries. Bins are aligned to multiples of
+     * the returned stride, hence the first and last bin may include
+     * samples outside of the range. Without envelopes the data is
+     * read directly.
+     *
+     * @param offset    The index of the first sample.
+     * @param count     The number of samples.
+     * @param points    The maximum number of bins to return.
+     *
+     * @return The envelope; positions are given in units of the first dimension.
+     */
+    Envelope envelopeAt(ndsize_t offset, ndsize_t count, size_t points) const;
+
+    /**
+     * @brief Get the envelope of the samples between two positions.
+     *
+     * The positions are mapped to indices by the first dimension,
+     * see {@link envelopeAt}.
+     *
+     * @param start     The start position, e.g. a time.
+     * @param end       The end position (inclusive).
+     * @param points    The maximum number of bins to return.
+     *
+     * @return The envelope.
+     */
+    Envelope envelope(double start, double end, size_t points) const;
+
+    //--------------------------------------------------
+    // Reductions
+    //--------------------------------------------------
+
+    /**
+     * @brief Compute sum, mean, variance, min and max along an axis.
+     *
+     * The data is read tile by tile (chunk aligned, if the data is
+     * chunked) with the calibration applied, so only a few tiles are
+     * held in memory at any time. The reads are queued on the
+     * {@link IOExecutor} while the tiles are reduced on nthreads
+     * worker threads, or on the calling thread alone if it is the
+     * I/O thread.
+     *
+     * @param axis      The axis to reduce.
+     * @param nthreads  The number of worker threads; 0 uses the
+     *                  number of hardware threads.
+     *
+     * @return The statistics for all elements of the remaining dimensions.
+     */
+    Statistics statistics(size_t axis, size_t nthreads = 0) const;
+
+    //--------------------------------------------------
+    // Asynchronous data access
+    //--------------------------------------------------
+
+    /**
+     * @brief Read data asynchronously.
+     *
+     * The read is queued on the {@link nix::IOExecutor} and performed
+     * on the library's I/O thread; operations on the same DataArray
+     * are executed in submission order. The buffer must stay valid
+     * until the returned future is ready.
+     *
+     * @param dtype     The type of data to read.
+     * @param data      Buffer where the data is written.
+     * @param count     The size of the data to read.
+     * @param offset    The position where the reading should start.
+     *
+     * @return A future that becomes ready when the data has been read.
+     */
+    std::future<void> getDataAsync(DataType dtype,
+                                   void *data,
+                                   const NDSize &count,
+                                   const NDSize &offset) const;
+
+    /**
+     * @brief Read data asynchronously into value.
+     *
+     * value is resized to count before the read is queued and must stay
+     * valid until the returned future is ready.
+     */
+    template<typename T>
+    std::future<void> getDataAsync(T &value, const NDSize &count, const NDSize &offset) const {
+        Hydra<T> hydra(value);
+        hydra.resize(count);
+        return getDataAsync(hydra.element_data_type(), hydra.data(), count, offset);
+    }
+
+    /**
+     * @brief Write data asynchronously.
+     *
+     * The write is queued on the {@link nix::IOExecutor}, see
+     * {@link getDataAsync}. The data must stay valid and unmodified
+     * until the returned future is ready.
+     *
+     * @param dtype     The type of data to write.
+     * @param data      The data to write.
+     * @param count     The size of the data to write.
+     * @param offset    The position where the writing should start.
+     *
+     * @return A future that becomes ready when the data has been written.
+     */
+    std::future<void> setDataAsync(DataType dtype,
+                                   const void *data,
+                                   const NDSize &count,
+                                   const NDSize &offset);
+
+    /**
+     * @brief Write all of value asynchronously at offset.
+     */
+    template<typename T>
+    std::future<void> setDataAsync(const T &value, const NDSize &offset) {
+        const Hydra<const T> hydra(value);
+        return setDataAsync(hydra.element_data_type(), hydra.data(), hydra.shape(), offset);
+    }
+
+    //--------------------------------------------------
+    // Parallel data access
+    //--------------------------------------------------
+
+    /**
+     * @brief Read data, decompressing it on several threads.
+     *
+     * Meant for large reads from compressed DataArrays: the chunks that
+     * intersect the region are read as they are stored and decompressed
+     * on nthreads threads. Apart from that it works like
+     * {@link getData}, including the conversion to dtype and the
+     * polynomial; data that cannot be decompressed this way is read
+     * like with {@link getData}. Only the hdf5 backend decompresses in
+     * parallel.
+     *
+     * @param dtype     The type of data to read.
+     * @param data      Buffer where the data is written.
+     * @param count     The size of the data to read.
+     * @param offset    The position where the reading should start.
+     * @param nthreads  The number of threads to use, 0 for one per core.
+     */
+    void getDataParallel(DataType dtype,
+                         void *data,
+                         const NDSize &count,
+                         const NDSize &offset,
+                         size_t nthreads = 0) const;
+
+    /**
+     * @brief Read data into value, decompressing it on several threads.
+     *
+     * value is resized to count.
+     */
+    template<typename T>
+    void getDataParallel(T &value, const NDSize &count, const NDSize &offset, size_t nthreads = 0) const {
+        Hydra<T> hydra(value);
+        hydra.resize(count);
+        getDataParallel(hydra.element_data_type(), hydra.data(), count, offset, nthreads);
+    }
+
+    /**
+     * @brief Write data, compressing it on several threads.
+     *
+     * Meant for bulk ingest into compressed DataArrays: the chunks that
+     * the written region covers completely are compressed on nthreads
+     * threads and stored as they are, the remaining partial chunks are
+     * written like with {@link setData}. This only pays off when the
+     * data is compressed and the region spans many chunks, see
+     * {@link dataChunks}; everything else, e.g. data that needs a type
+     * conversion, is written like with {@link setData}. Only the hdf5
+     * backend compresses in parallel.
+     *
+     * @param dtype     The type of data to write.
+     * @param data      The data to write.
+     * @param count     The size of the data to write.
+     * @param offset    The position where the writing should start.
+     * @param nthreads  The number of threads to use, 0 for one per core.
+     */
+    void setDataParallel(DataType dtype,
+                         const void *data,
+                         const NDSize &count,
+                         const NDSize &offset,
+                         size_t nthreads = 0);
+
+    /**
+     * @brief Write all of value at offset, compressing it on several threads.
+     */
+    template<typename T>
+    void setDataParallel(const T &value, const NDSize &offset, size_t nthreads = 0) {
+        const Hydra<const T> hydra(value);
+        setDataParallel(hydra.element_data_type(), hydra.data(), hydra.shape(), offset, nthreads);
+    }
+
     //--------------------------------------------------
     // Other methods and functions
     //--------------------------------------------------
@@ -496,10 +839,21 @@ protected:
                 const NDSize &count,
                 const NDSize &offset) const;
 
+    // reads the selection with one read of the backend
+    void ioRead(DataType dtype,
+                void *data,
+                const Selection &selection) const;
+
     void ioWrite(DataType dtype,
                  const void *data,
                  const NDSize &count,
                  const NDSize &offset);
+
+private:
+    void refreshEnvelopes();
+
+    // recompute the envelope blocks touching the samples [begin, end)
+    void updateEnvelopes(ndsize_t begin, ndsize_t end);
 };
 
 
@@ -18,7 +18,9 @@
 #include <nix/base/IDataFrame.hpp>
 
 #include <nix/Hydra.hpp>
+#include <nix/IOExecutor.hpp>
 
+#include <future>
 #include <string>
 #include <vector>
 
@@ -48,6 +50,18 @@ public:
         return backend()->rows();
     }
 
+    /**
+     * @brief Get the storage layout of the rows.
+     *
+     * The rows are stored as one record per element, i.e. the
+     * element size is the size of a row.
+     *
+     * @return The storage layout.
+     */
+    StorageLayout dataLayout() const {
+        return backend()->dataLayout();
+    }
+
     /**
      * @brief Resize the number of rows of the DataFrame.
      *
@@ -336,6 +350,84 @@ public:
         const std::string name = this->colName(col);
         readColumn(name, vals, count, resize, offset);
     }
+
+    /**
+     * @brief Read an entire row asynchronously.
+     *
+     * The read is queued on the {@link nix::IOExecutor}; operations on
+     * the same DataFrame are executed in submission order.
+     *
+     * @param row     Index of the row to read from.
+     *
+     * @return A future for the row data.
+     */
+    std::future<std::vector<Variant>> readRowAsync(ndsize_t row) const {
+        const DataFrame df = *this;
+        return IOExecutor::instance().submit([df, row]() {
+            return df.backend()->readRow(row);
+        });
+    }
+
+    /**
+     * @brief Read column data asynchronously.
+     *
+     * vals is resized to count before the read is queued and must
+     * stay valid until the returned future is ready.
+     *
+     * @param name    Name of the column to read.
+     * @param vals    A std::vector to store the data in.
+     * @param count   How many rows to read.
+     * @param offset  Which row to start reading.
+     *
+     * @return A future that becomes ready when the data has been read.
+     */
+    template<typename T>
+    std::future<void> readColumnAsync(const std::string &name,
+                                      std::vector<T> &vals,
+                                      size_t count,
+                                      ndsize_t offset = 0) const {
+        Hydra<std::vector<T>> hydra(vals);
+        vals.resize(count);
+        DataType dtype = hydra.element_data_type();
+        void *data = hydra.data();
+
+        const DataFrame df = *this;
+        return IOExecutor::instance().submit([df, name, offset, count, dtype, data]() {
+            df.backend()->readColumn(name, offset, count, dtype, data);
+        });
+    }
+
+    /**
+     * @brief Write column data asynchronously.
+     *
+     * vals must stay valid and unmodified until the returned future
+     * is ready.
+     *
+     * @param name    Name of the column to write.
+     * @param vals    A std::vector with the data to write.
+     * @param offset  Where to start.
+     * @param count   How many rows to write; 0 for all of vals.
+     *
+     * @return A future that becomes ready when the data has been written.
+     */
+    template<typename T>
+    std::future<void> writeColumnAsync(const std::string &name,
+                                       const std::vector<T> &vals,
+                                       ndsize_t offset = 0,
+                                       ndsize_t count = 0) {
+        const Hydra<const std::vector<T>> hydra(vals);
+        if (count == 0)
+            count = vals.size();
+        else if (count > vals.size())
+            throw OutOfBounds("Requested to write more data than available");
+        DataType dtype = hydra.element_data_type();
+        const void *data = hydra.data();
+
+        DataFrame df = *this;
+        return IOExecutor::instance().submit([df, name, offset, count, dtype, data]() mutable {
+            df.backend()->writeColumn(name, offset, count, dtype, data);
+        });
+    }
 };
 
 
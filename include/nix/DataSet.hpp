@@ -14,6 +14,7 @@
 
 #include <nix/Dimensions.hpp>
 #include <nix/Hydra.hpp>
+#include <nix/Selection.hpp>
 
 #include <nix/Platform.hpp>
 
@@ -29,6 +30,12 @@ public:
 
     template<typename T> void getData(T &value, const NDSize &offset) const;
 
+    /**
+     * @brief Read a selection of the data; value is resized to
+     *        {@link Selection::shape}.
+     */
+    template<typename T> void getData(T &value, const Selection &selection) const;
+
     template<typename T> void setData(const T &value, const NDSize &offset);
 
 
@@ -39,6 +46,12 @@ public:
         ioRead(dtype, data, count, offset);
     }
 
+    void getData(DataType dtype,
+                 void *data,
+                 const Selection &selection) const {
+        ioRead(dtype, data, selection);
+    }
+
     void setData(DataType dtype,
                          const void *data,
                          const NDSize &count,
@@ -60,6 +73,11 @@ protected:
                         const NDSize &count,
                         const NDSize &offset) const = 0;
 
+    // reads the runs of the selection one by one; override to read it at once
+    virtual void ioRead(DataType dtype,
+                        void *data,
+                        const Selection &selection) const;
+
     virtual void ioWrite(DataType dtype,
                          const void *data,
                          const NDSize &count,
@@ -116,6 +134,16 @@ void DataSet::getData(T &value, const NDSize &offset) const
     getData(dtype, hydra.data(), count, offset);
 }
 
+template<typename T>
+void DataSet::getData(T &value, const Selection &selection) const
+{
+    Hydra<T> hydra(value);
+    DataType dtype = hydra.element_data_type();
+
+    hydra.resize(selection.shape(dataExtent()));
+    getData(dtype, hydra.data(), selection);
+}
+
 
 template<typename T>
 void DataSet::setData(const T &value, const NDSize &offset)
@@ -36,6 +36,10 @@ protected:
                 const NDSize &count,
                 const NDSize &offset) const;
 
+    void ioRead(DataType dtype,
+                void *data,
+                const Selection &selection) const;
+
     void ioWrite(DataType dtype,
                  const void *data,
                  const NDSize &count,
@@ -49,6 +53,7 @@ private:
     NDSize    offset;
     NDSize    count;
 
+    friend class ChunkIterator;
 };
 
 } // nix::
@@ -417,6 +417,15 @@ public:
         return backend()->labels();
     }
 
+    /**
+     * @brief Get the number of labels without reading them.
+     *
+     * @return The number of labels.
+     */
+    ndsize_t labelCount() const {
+        return backend()->labelCount();
+    }
+
     /**
      * @brief Set the labels for the dimension.
      *
@@ -631,6 +640,15 @@ public:
         return backend()->ticks();
     }
 
+    /**
+     * @brief Get the number of ticks without reading them.
+     *
+     * @return The number of ticks.
+     */
+    ndsize_t tickCount() const {
+        return backend()->tickCount();
+    }
+
     /**
      * @brief Set the ticks vector for the dimension.
      *
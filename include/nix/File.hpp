@@ -13,11 +13,15 @@
 #include <nix/base/IFile.hpp>
 #include <nix/Block.hpp>
 #include <nix/Section.hpp>
+#include <nix/MetadataSnapshot.hpp>
 #include <nix/Platform.hpp>
 #include <nix/ObjectType.hpp>
+#include <nix/IOTrace.hpp>
 
 #include <nix/valid/validate.hpp>
 
+#include <vector>
+
 namespace nix {
 
 
@@ -83,8 +87,12 @@ public:
      *
      * @param name          The name/path of the file.
      * @param mode          The open mode.
-     * @param impl          The back-end implementation to be used to open the file.
-     *                      (currently only hdf5)
+     * @param impl          The back-end implementation to be used to open the file:
+     *                      "hdf5" or "memory". The memory backend keeps every
+     *                      entity in plain containers: an existing HDF5 file is
+     *                      read in at once and changes are only kept in memory,
+     *                      see {@link saveAs}; otherwise a new, empty file is
+     *                      created without touching the disk.
      * @param compresssion  The compression mode, defaults to Compression::None (can be
      *                      overridden upon DataArray creation)
      *
@@ -93,6 +101,63 @@ public:
     static File open(const std::string &name, FileMode mode=FileMode::ReadWrite,
                      const std::string &impl="hdf5", Compression compression=Compression::Auto);
 
+    /**
+     * @brief Opens a file from an image of it in memory.
+     *
+     * The image is e.g. the content of a file received over the network
+     * or obtained with {@link toBuffer}. In FileMode::ReadOnly the
+     * buffer is used in place without being copied or modified; it
+     * must stay valid until the file is closed. In FileMode::ReadWrite
+     * the file works on a copy of the buffer. Only the hdf5 backend
+     * supports file images.
+     *
+     * @param data          The image of the file.
+     * @param size          The size of the image in bytes.
+     * @param mode          FileMode::ReadOnly or FileMode::ReadWrite.
+     * @param compression   The compression mode, see {@link open}.
+     *
+     * @return The opened file.
+     */
+    static File openFromBuffer(const void *data, size_t size, FileMode mode=FileMode::ReadOnly,
+                               Compression compression=Compression::Auto);
+
+    /**
+     * @brief Creates a new file that is kept in memory.
+     *
+     * If backing_store is given, the file is written to that path
+     * whenever it is flushed and when it is closed, otherwise the file
+     * is gone once it is closed; use {@link toBuffer} to keep it.
+     *
+     * @param backing_store The path to write the file to or empty.
+     * @param compression   The compression mode, see {@link open}.
+     *
+     * @return The created file.
+     */
+    static File createInMemory(const std::string &backing_store="",
+                               Compression compression=Compression::Auto);
+
+    /**
+     * @brief Get the image of the file, as it would be stored on disk.
+     *
+     * Works for every file of the hdf5 and memory backends; a file of the
+     * memory backend is written out as HDF5 for this. The image can be
+     * opened again with {@link openFromBuffer}.
+     *
+     * @return The bytes of the file.
+     */
+    std::vector<char> toBuffer() const;
+
+    /**
+     * @brief Write the current state of the file to an HDF5 file at once.
+     *
+     * Meant for files kept in memory, see {@link open} and
+     * {@link createInMemory}, but works for every file of the hdf5
+     * and memory backends. The file itself stays open and unchanged.
+     *
+     * @param path          The path of the HDF5 file to write.
+     */
+    void saveAs(const std::string &path) const;
+
     /**
      * @brief Persists all cached changes to the backend.
      *
@@ -329,6 +394,37 @@ public:
         return findSections(util::AcceptAll<Section>(), max_depth);
     }
 
+    /**
+     * @brief Load a snapshot of the metadata tree into memory.
+     *
+     * Reads the structure of all sections once; until the metadata is
+     * modified, {@link findSections}, {@link Section::findSections} and
+     * {@link Section::findRelated} are answered from the snapshot.
+     * Replaces a previously loaded snapshot.
+     *
+     * @return The loaded snapshot.
+     *
+     * @see MetadataSnapshot
+     */
+    std::shared_ptr<const MetadataSnapshot> loadMetadata();
+
+    /**
+     * @brief Get the loaded metadata snapshot.
+     *
+     * @return The snapshot, or nullptr if none is loaded or the metadata
+     *         changed since it was loaded.
+     */
+    std::shared_ptr<const MetadataSnapshot> metadataSnapshot() const {
+        return backend()->metadataSnapshot();
+    }
+
+    /**
+     * @brief Drop the loaded metadata snapshot.
+     */
+    void unloadMetadata() {
+        backend()->metadataSnapshot(nullptr);
+    }
+
 
     /**
      * @brief Creates a new Section with a given name and type. Both must not be empty.
@@ -444,6 +540,48 @@ public:
         backend()->forceCreatedAt(t);
     }
 
+    /**
+     * @brief Get the time of the last validation without errors.
+     *
+     * @return The time stored with {@link forceValidatedAt} or 0 if the
+     *         file was never marked as validated.
+     */
+    time_t validatedAt() const {
+        return backend()->validatedAt();
+    }
+
+    /**
+     * @brief Marks the file as validated at the provided time.
+     *
+     * Used as the reference point of {@link validateModified}. The time
+     * should be taken before the validation was started, so that
+     * changes made in the meantime are picked up by the next run.
+     *
+     * @param t        The validation time to set.
+     */
+    void forceValidatedAt(time_t t) {
+        backend()->forceValidatedAt(t);
+    }
+
+    /**
+     * @brief Get the I/O counters of the file.
+     *
+     * The counters are only collected while {@link IOTrace} is
+     * enabled, and only by the HDF5 backend.
+     *
+     * @return The counters, e.g. to dump with {@link IOStats::toJson}.
+     */
+    IOStats ioStats() const {
+        return IOTrace::stats(location());
+    }
+
+    /**
+     * @brief Clear the I/O counters of the file.
+     */
+    void resetIOStats() {
+        IOTrace::reset(location());
+    }
+
     //------------------------------------------------------
     // Operators and other functions
     //------------------------------------------------------
@@ -471,6 +609,43 @@ public:
         return backend()->fileMode();
     }
 
+    /**
+     * @brief Start single-writer/multiple-reader writing.
+     *
+     * A file opened with FileMode::SwmrWrite is created in, or must
+     * have been created in, a format readable while it is written. Until
+     * this method is called it can be modified like any other file, so
+     * all entities are created up front: blocks, data arrays (with
+     * their final rank and an initial extent), dimensions and so on.
+     * Afterwards no entities can be created or deleted, the data of
+     * existing data arrays can only be written and extended, e.g. with
+     * {@link DataArray::appendData}, and their updated_at times are no
+     * longer maintained.
+     *
+     * No handles to entities of the file may be held when this method
+     * is called, retrieve them again afterwards. SWMR needs HDF5 1.10
+     * or later.
+     *
+     * Readers open the file with FileMode::SwmrRead; {@link flush}
+     * makes the data written so far visible to them, and
+     * {@link DataArray::dataExtent} picks up the extent the writer
+     * flushed last.
+     *
+     * ~~~
+     * nix::File file = nix::File::open("run.nix", nix::FileMode::SwmrWrite);
+     * file.createBlock("run", "acq").createDataArray("v", "trace", nix::DataType::Double, {0});
+     * file.startSwmrWrite();
+     * nix::DataArray da = file.getBlock("run").getDataArray("v");
+     * while (acquiring) {
+     *     da.appendData(nix::DataType::Double, samples.data(), {samples.size()}, 0);
+     *     file.flush();
+     * }
+     * ~~~
+     */
+    void startSwmrWrite() {
+        backend()->startSwmrWrite();
+    }
+
     /*
     * @brief Returns the default choice for compressing datasets.
     * This choice can be made during file opening.
@@ -493,7 +668,48 @@ public:
     // Validate
     //------------------------------------------------------
 
-    valid::Result validate() const;
+    /**
+     * @brief Validate all entities of the file.
+     *
+     * The Blocks are validated in parallel if the backend allows
+     * concurrent access (e.g. a thread-safe build of the HDF5 library),
+     * serially otherwise. The results are reported in Block order.
+     *
+     * @param nthreads  The maximum number of threads; 0 uses the
+     *                  number of hardware threads.
+     *
+     * @return The validation results.
+     */
+    valid::Result validate(size_t nthreads = 0) const;
+
+    /**
+     * @brief Validate the entities that changed since the given time.
+     *
+     * Entities whose {@link updatedAt} time is before since are not
+     * validated, but listed in {@link valid::Result::getSkipped}.
+     * Tags and MultiTags are revalidated when any of the DataArrays they
+     * refer to changed; Dimensions and Features are validated with their
+     * DataArray or Tag. Changes that do not touch any updated_at time,
+     * e.g. editing the ticks of an existing RangeDimension in place, are
+     * not detected, so a full {@link validate} should still be run from
+     * time to time.
+     *
+     * ~~~
+     * time_t start = time(NULL);
+     * valid::Result res = file.validateModified(file.validatedAt());
+     * if (!res.hasErrors()) {
+     *     file.forceValidatedAt(start);
+     * }
+     * ~~~
+     *
+     * @param since     The time of the last validation; 0 validates all
+     *                  entities, just like {@link validate}.
+     * @param nthreads  The maximum number of threads; 0 uses the
+     *                  number of hardware threads.
+     *
+     * @return The validation results.
+     */
+    valid::Result validateModified(time_t since, size_t nthreads = 0) const;
 
 };
 
@@ -0,0 +1,158 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_IO_EXECUTOR_H
+#define NIX_IO_EXECUTOR_H
+
+#include <nix/Platform.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace nix {
+
+/**
+ * @brief Library managed executor for asynchronous I/O.
+ *
+ * All asynchronous operations (e.g. {@link DataArray::getDataAsync})
+ * are queued here and run on a single I/O thread in submission order.
+ * Since all I/O is funneled through one thread the ordering of
+ * operations on the same DataArray or DataFrame is guaranteed, and the
+ * (usually not thread-safe) HDF5 library is only ever entered from
+ * one thread at a time by the executor.
+ *
+ * The queue is bounded: if {@link maxQueueDepth} operations are
+ * pending, submitting a new one blocks until a slot is free.
+ * Operations submitted by a running operation are run at once on the
+ * I/O thread, so an operation may wait on the futures of those.
+ *
+ * NB: While operations are pending, the calling threads must not use
+ * the same file synchronously unless the HDF5 library was built
+ * thread-safe. Use {@link wait} or the returned futures to synchronize.
+ */
+class NIXAPI IOExecutor {
+
+public:
+
+    /**
+     * @brief The executor used by the asynchronous API.
+     */
+    static IOExecutor &instance();
+
+    explicit IOExecutor(size_t max_queue_depth = 16);
+
+    IOExecutor(const IOExecutor &other) = delete;
+    IOExecutor &operator=(const IOExecutor &other) = delete;
+
+    /**
+     * @brief Queue func for execution on the I/O thread.
+     *
+     * @return A future for the result of func; exceptions thrown
+     *         by func are rethrown by std::future::get().
+     */
+    template<typename F>
+    auto submit(F func) -> std::future<decltype(func())>;
+
+    /**
+     * @brief Block until all queued operations have been run.
+     */
+    void wait();
+
+    /**
+     * @brief Check if the calling thread is the I/O thread.
+     */
+    bool onIOThread() const;
+
+    size_t pending() const;
+
+    size_t maxQueueDepth() const;
+
+    void maxQueueDepth(size_t depth);
+
+    ~IOExecutor();
+
+private:
+
+    void enqueue(std::function<void()> job);
+
+    void run();
+
+    mutable std::mutex                mtx;
+    std::condition_variable           cv_work;
+    std::condition_variable           cv_space;
+    std::condition_variable           cv_idle;
+    std::deque<std::function<void()>> queue;
+    std::thread                       worker;
+    size_t                            max_depth;
+    bool                              busy;
+    bool                              stop;
+};
+
+
+namespace detail {
+
+// A queued operation: func is destroyed before the result is published,
+// so that handles it captured (e.g. a DataArray) are released on the I/O
+// thread before the caller can resume and, e.g., close the file.
+template<typename R, typename F>
+struct IOJob {
+    std::promise<R>    promise;
+    std::unique_ptr<F> func;
+
+    void operator()() {
+        try {
+            R result = (*func)();
+            func.reset();
+            promise.set_value(std::move(result));
+        } catch (...) {
+            func.reset();
+            promise.set_exception(std::current_exception());
+        }
+    }
+};
+
+template<typename F>
+struct IOJob<void, F> {
+    std::promise<void> promise;
+    std::unique_ptr<F> func;
+
+    void operator()() {
+        try {
+            (*func)();
+            func.reset();
+            promise.set_value();
+        } catch (...) {
+            func.reset();
+            promise.set_exception(std::current_exception());
+        }
+    }
+};
+
+} // namespace detail
+
+
+template<typename F>
+auto IOExecutor::submit(F func) -> std::future<decltype(func())>
+{
+    typedef decltype(func()) result_type;
+
+    auto job = std::make_shared<detail::IOJob<result_type, F>>();
+    job->func.reset(new F(std::move(func)));
+    std::future<result_type> res = job->promise.get_future();
+    enqueue([job]() { (*job)(); });
+    return res;
+}
+
+} // namespace nix
+
+#endif // NIX_IO_EXECUTOR_H
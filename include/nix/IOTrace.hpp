@@ -0,0 +1,115 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_IO_TRACE_H
+#define NIX_IO_TRACE_H
+
+#include <nix/Platform.hpp>
+#include <nix/NDSize.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace nix {
+
+/**
+ * @brief The kinds of operations counted by {@link IOTrace}.
+ */
+enum class IOOperation {
+    DataRead = 0,
+    DataWrite,
+    AttrRead,
+    AttrWrite,
+    GroupOpen,
+    ObjectLookup,
+    ObjectName
+};
+
+NIXAPI std::string io_operation_to_string(IOOperation op);
+
+/**
+ * @brief Calls, bytes and latencies of one kind of operation.
+ *
+ * Bucket i of the histogram counts the calls that took between 2^i
+ * and 2^(i+1) nanoseconds, the last bucket all slower ones.
+ */
+struct NIXAPI IOCounter {
+    static const size_t buckets = 32;
+
+    ndsize_t                       calls = 0;
+    ndsize_t                       bytes = 0;
+    uint64_t                       nanoseconds = 0;
+    std::array<ndsize_t, buckets>  histogram {};
+
+    void add(ndsize_t nbytes, uint64_t ns);
+};
+
+/**
+ * @brief The I/O counters of one file, in total and per HDF5 object,
+ *        e.g. "/data/block/data_arrays/signal/data".
+ *
+ * The counters of operations that call other counted operations
+ * (e.g. opening a group looks it up first) include those.
+ */
+struct NIXAPI IOStats {
+    std::map<IOOperation, IOCounter>                          operations;
+    std::map<std::string, std::map<IOOperation, IOCounter>>   entities;
+
+    /**
+     * @brief The counters as JSON object.
+     */
+    std::string toJson() const;
+};
+
+/**
+ * @brief Optional instrumentation of the I/O of the HDF5 backend.
+ *
+ * When enabled, every data set read and write, attribute read and
+ * write, group open, link lookup and link name query is timed and
+ * counted per file; see {@link File::ioStats}. Tracing is disabled
+ * unless the environment variable NIX_IO_TRACE is set to a value
+ * other than 0, or it is enabled at run time. Disabled it costs one
+ * atomic load per operation.
+ */
+class NIXAPI IOTrace {
+
+public:
+
+    static bool enabled() {
+        return on.load(std::memory_order_relaxed);
+    }
+
+    static void enable(bool enable = true);
+
+    /**
+     * @brief Count one operation on entity of file.
+     */
+    static void record(const std::string &file, const std::string &entity,
+                       IOOperation op, ndsize_t bytes, uint64_t ns);
+
+    /**
+     * @brief The counters of the file at location.
+     */
+    static IOStats stats(const std::string &location);
+
+    /**
+     * @brief Clear the counters of the file at location.
+     */
+    static void reset(const std::string &location);
+
+private:
+
+    static std::atomic<bool> on;
+};
+
+} // namespace nix
+
+#endif // NIX_IO_TRACE_H
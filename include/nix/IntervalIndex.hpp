@@ -0,0 +1,94 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_INTERVAL_INDEX_H
+#define NIX_INTERVAL_INDEX_H
+
+#include <nix/Platform.hpp>
+#include <nix/NDSize.hpp>
+
+#include <string>
+#include <vector>
+
+namespace nix {
+
+/**
+ * @brief In-memory index over closed intervals along one dimension.
+ *
+ * The index answers which intervals overlap a window in O(log n + k)
+ * for k results: the intervals are sorted by start and an implicit
+ * binary tree over that order keeps the largest end of each subtree.
+ * Points are intervals with an extent of 0.
+ *
+ * An index is built from the positions and extents of a MultiTag by
+ * {@link MultiTag::intervalIndex}; it is a copy and does not follow
+ * later changes of the tag or its DataArrays.
+ */
+class NIXAPI IntervalIndex {
+
+public:
+
+    IntervalIndex() {}
+
+    /**
+     * @brief Build the index over the intervals [starts[i], starts[i] + extents[i]].
+     *
+     * @param starts    The starts of the intervals.
+     * @param extents   The extents of the intervals, or an empty vector for points.
+     * @param unit      The unit of starts and extents, may be empty.
+     * @param keys      What queries return for each interval; by default
+     *                  its position in starts.
+     */
+    IntervalIndex(const std::vector<double> &starts, const std::vector<double> &extents,
+                  const std::string &unit = "", const std::vector<ndsize_t> &keys = {});
+
+    /**
+     * @brief The number of intervals in the index.
+     */
+    ndsize_t size() const {
+        return lower.size();
+    }
+
+    /**
+     * @brief The unit of the indexed values.
+     */
+    std::string unit() const {
+        return unit_str;
+    }
+
+    /**
+     * @brief Find all intervals that overlap the window [start, end].
+     *
+     * @param start     The start of the window.
+     * @param end       The end of the window.
+     * @param unit      The unit of start and end; an empty unit means the
+     *                  unit of the index. Other units are scaled to the
+     *                  unit of the index.
+     *
+     * @return The keys of the matching intervals in ascending order.
+     */
+    std::vector<ndsize_t> overlapping(double start, double end, const std::string &unit = "") const;
+
+private:
+
+    std::string unit_str;
+    // the intervals sorted by their lower bound
+    std::vector<double> lower, upper;
+    std::vector<ndsize_t> order;
+    // the largest upper bound below each node of a complete binary tree
+    // over the sorted intervals, the root is node 1
+    std::vector<double> max_upper;
+    size_t leaves = 0;
+
+    void collect(size_t node, size_t first, size_t last, size_t stop, double start,
+                 std::vector<ndsize_t> &result) const;
+};
+
+} // namespace nix
+
+#endif // NIX_INTERVAL_INDEX_H
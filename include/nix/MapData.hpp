@@ -0,0 +1,133 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_MAP_DATA_H
+#define NIX_MAP_DATA_H
+
+#include <nix/DataArray.hpp>
+
+#include <nix/Platform.hpp>
+
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+namespace nix {
+
+/**
+ * @brief One block of data handed to the kernel of {@link mapData}.
+ *
+ * The block spans the full extent of all dimensions but the axis of the
+ * scan. The inputs additionally contain up to halo elements before and
+ * after the block along that axis, fewer at the borders of the data.
+ */
+struct MapBlock {
+    /** The offset of the output in the target. */
+    NDSize                    offset;
+    /** The shape of the output. */
+    NDSize                    count;
+    /** The offset of the inputs in the sources. */
+    NDSize                    input_offset;
+    /** The shape of the inputs. */
+    NDSize                    input_count;
+    /** The axis of the scan. */
+    size_t                    axis;
+    /** The number of elements before the output along axis in the inputs. */
+    ndsize_t                  halo_before;
+    /** The number of elements after the output along axis in the inputs. */
+    ndsize_t                  halo_after;
+    /** The data type of inputs and output. */
+    DataType                  dtype;
+    /** The inputs, one per source, in row-major order. */
+    std::vector<const void *> inputs;
+    /** The output, to be filled by the kernel, in row-major order. */
+    void                     *output;
+
+    template<typename T>
+    const T *input(size_t index) const {
+        check_type(to_data_type<T>::value);
+        return static_cast<const T *>(inputs.at(index));
+    }
+
+    template<typename T>
+    T *outputData() const {
+        check_type(to_data_type<T>::value);
+        return static_cast<T *>(output);
+    }
+
+private:
+
+    void check_type(DataType type) const {
+        if (type != dtype) {
+            throw std::invalid_argument("MapBlock: type does not match the data type of the block");
+        }
+    }
+};
+
+/**
+ * @brief Computes the output of one block from its inputs.
+ *
+ * Kernels are called on several threads at once, for different blocks.
+ */
+typedef std::function<void(const MapBlock &block)> MapKernel;
+
+/**
+ * @brief How {@link mapData} splits and processes the data.
+ */
+struct MapOptions {
+    /** The axis along which the data is processed. */
+    size_t   axis = 0;
+    /** The number of chunks of the target along axis per block. */
+    size_t   blocks = 1;
+    /** The number of extra input elements on each side along axis. */
+    ndsize_t halo = 0;
+    /** The data type of inputs and outputs; inputs are calibrated. */
+    DataType dtype = DataType::Double;
+    /** The number of kernel threads, 0 to use one per hardware thread. */
+    size_t   nthreads = 0;
+    /** The number of blocks in memory at once, 0 for twice nthreads. */
+    size_t   depth = 0;
+};
+
+/**
+ * @brief Compute a DataArray from one or more aligned DataArrays, block by block.
+ *
+ * The sources must have the same extent; the target is resized to it.
+ * The data is split into blocks along options.axis that span the full
+ * extent of all other dimensions and are aligned to the chunks of the
+ * target (or of the first source, if the target is not chunked). The
+ * blocks run through a bounded pipeline: the inputs are read ahead on
+ * the {@link IOExecutor}, the kernel runs on options.nthreads threads
+ * and the outputs are written back in order with
+ * {@link DataArray::setDataParallel}, which compresses full chunks in
+ * parallel. At most options.depth blocks are held in memory, so data
+ * larger than memory can be processed.
+ *
+ * If the target has no dimensions, the dimensions of the first source
+ * are copied to it; if it has no metadata, it is linked to the
+ * metadata of the first source.
+ *
+ * @param sources   The aligned source arrays.
+ * @param target    The array to write, must not be one of the sources.
+ * @param kernel    Computes each block.
+ * @param options   How the data is split and processed.
+ */
+NIXAPI void mapData(const std::vector<DataArray> &sources, DataArray &target,
+                    const MapKernel &kernel, const MapOptions &options = MapOptions());
+
+/**
+ * @brief Compute a DataArray from another one, block by block.
+ *
+ * See the overload for several sources.
+ */
+NIXAPI void mapData(const DataArray &source, DataArray &target,
+                    const MapKernel &kernel, const MapOptions &options = MapOptions());
+
+} // namespace nix
+
+#endif // NIX_MAP_DATA_H
@@ -0,0 +1,147 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_METADATA_SNAPSHOT_H
+#define NIX_METADATA_SNAPSHOT_H
+
+#include <nix/Section.hpp>
+#include <nix/base/IFile.hpp>
+#include <nix/util/filter.hpp>
+
+#include <nix/Platform.hpp>
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace nix {
+
+class File;
+
+/**
+ * @brief Read-only in-memory copy of the metadata tree of a file.
+ *
+ * The snapshot holds the structure of all sections (parents, children
+ * and links), their ids, names and types and the names of their
+ * properties, with indexes on id, name, type and property name. It is
+ * created by {@link File::loadMetadata}; while it is loaded,
+ * File::findSections, Section::findSections and Section::findRelated
+ * run against it instead of walking the file.
+ *
+ * Filters on these attributes ({@link util::AcceptAll},
+ * {@link util::IdFilter}, {@link util::IdsFilter},
+ * {@link util::NameFilter} and {@link util::TypeFilter}) are evaluated
+ * in memory, Id, Name and Type filters through the indexes. Any other
+ * filter is called with the Section as usual. Sections are opened in
+ * the file only when they are returned or passed to such a filter.
+ *
+ * The file drops its snapshot when sections or properties are created
+ * or deleted, or when a section is modified; writing property values
+ * keeps it. A snapshot obtained from {@link File::metadataSnapshot}
+ * keeps describing the tree at the time it was loaded.
+ */
+class NIXAPI MetadataSnapshot {
+
+public:
+
+    /**
+     * @brief The number of sections in the file.
+     */
+    ndsize_t sectionCount() const {
+        return nodes.size();
+    }
+
+    /**
+     * @brief Get the section with the given id.
+     *
+     * @return The section or an uninitialized Section if there is none.
+     */
+    Section sectionById(const std::string &id) const;
+
+    /**
+     * @brief Get all sections with the given name, in the order of File::findSections.
+     */
+    std::vector<Section> sectionsByName(const std::string &name) const;
+
+    /**
+     * @brief Get all sections of the given type, in the order of File::findSections.
+     */
+    std::vector<Section> sectionsByType(const std::string &type) const;
+
+    /**
+     * @brief Get all sections that have a property with the given name.
+     */
+    std::vector<Section> sectionsWithProperty(const std::string &name) const;
+
+    /**
+     * @brief Get the section the given section links to.
+     *
+     * @return The linked section or an uninitialized Section.
+     */
+    Section link(const Section &section) const;
+
+    /**
+     * @brief Snapshot version of {@link File::findSections}.
+     */
+    std::vector<Section> findSections(const util::Filter<Section>::type &filter,
+                                      size_t max_depth = std::numeric_limits<size_t>::max()) const;
+
+    /**
+     * @brief Snapshot version of {@link Section::findSections}.
+     */
+    std::vector<Section> findSections(const Section &section,
+                                      const util::Filter<Section>::type &filter,
+                                      size_t max_depth = std::numeric_limits<size_t>::max()) const;
+
+    /**
+     * @brief Snapshot version of {@link Section::findRelated}.
+     */
+    std::vector<Section> findRelated(const Section &section,
+                                     const util::Filter<Section>::type &filter) const;
+
+private:
+
+    static const size_t npos = std::numeric_limits<size_t>::max();
+
+    struct Node {
+        std::string id;
+        std::string name;
+        std::string type;
+        size_t parent;
+        size_t link;
+        size_t depth;
+        std::vector<size_t> children;
+    };
+
+    class Query;
+
+    typedef std::unordered_map<std::string, std::vector<size_t>> Index;
+
+    std::weak_ptr<base::IFile> file;
+    // sections in the order of File::findSections: each root followed by
+    // its descendants in breadth first order
+    std::vector<Node> nodes;
+    std::unordered_map<std::string, size_t> by_id;
+    Index by_name, by_type, by_property;
+
+    MetadataSnapshot(const File &file, std::vector<Section> &sections);
+
+    void loadLinks(const std::vector<Section> &sections);
+
+    size_t node(const Section &section) const;
+
+    std::vector<Section> collect(const Index &index, const std::string &key) const;
+
+    friend class File;
+};
+
+} // namespace nix
+
+#endif // NIX_METADATA_SNAPSHOT_H
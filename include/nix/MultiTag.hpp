@@ -15,6 +15,7 @@
 #include <nix/Platform.hpp>
 #include <nix/DataView.hpp>
 #include <nix/ObjectType.hpp>
+#include <nix/IntervalIndex.hpp>
 
 #include <algorithm>
 #include <memory>
@@ -209,6 +210,39 @@ public:
         backend()->units(t);
     }
 
+    /**
+     * @brief Build an index over the positions and extents along one dimension.
+     *
+     * The positions (and extents, if any) are read once; the returned
+     * index then finds the positions overlapping a window in logarithmic
+     * time. The index has the unit of the tag in that dimension. Build a
+     * new index after changing positions, extents or units.
+     *
+     * @param dim       The dimension of the positions to index.
+     *
+     * @return The index, which refers to positions by their index.
+     */
+    IntervalIndex intervalIndex(size_t dim = 0) const;
+
+    /**
+     * @brief Get the positions whose extent overlaps the window [start, end].
+     *
+     * Positions without extents match if they lie within the window.
+     * This builds an {@link IntervalIndex} on each call; use
+     * {@link intervalIndex} for repeated queries.
+     *
+     * @param start     The start of the window.
+     * @param end       The end of the window.
+     * @param dim       The dimension of the positions to compare.
+     * @param unit      The unit of start and end; empty for the unit of the tag.
+     *
+     * @return The indices of the matching positions, in ascending order.
+     */
+    std::vector<ndsize_t> positionsInRange(double start, double end, size_t dim = 0,
+                                           const std::string &unit = "") const {
+        return intervalIndex(dim).overlapping(start, end, unit);
+    }
+
     //--------------------------------------------------
     // Methods concerning references.
     //--------------------------------------------------
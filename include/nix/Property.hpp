@@ -13,11 +13,13 @@
 #include <nix/base/IProperty.hpp>
 #include <nix/Variant.hpp>
 #include <nix/ObjectType.hpp>
+#include <nix/Exception.hpp>
 
 #include <nix/Platform.hpp>
 
 #include <ostream>
 #include <memory>
+#include <vector>
 
 namespace nix {
 
@@ -244,6 +246,104 @@ public:
         backend()->values(t);
     }
 
+    //--------------------------------------------------
+    // Typed value access
+    //--------------------------------------------------
+
+    /**
+     * @brief Read values straight into a buffer.
+     *
+     * Unlike {@link values} no Variant is created per value, which
+     * matters for properties with many values. Numeric values are
+     * converted to T, strings are read as std::string.
+     *
+     * @param data      The buffer for count values.
+     * @param count     The number of values to read.
+     * @param offset    The index of the first value to read.
+     */
+    template<typename T>
+    void getValues(T *data, ndsize_t count, ndsize_t offset = 0) const {
+        checkValueRange(count, offset);
+        if (count > 0) {
+            backend()->readValues(to_data_type<T>::value, data, count, offset);
+        }
+    }
+
+    /**
+     * @brief Read count values starting at offset into a vector.
+     *
+     * @param values    The vector to read into; it is resized to count.
+     * @param count     The number of values to read.
+     * @param offset    The index of the first value to read.
+     */
+    template<typename T>
+    void getValues(std::vector<T> &values, ndsize_t count, ndsize_t offset = 0) const {
+        values.resize(check::fits_in_size_t(count, "Property::getValues: count exceeds memory"));
+        getValues(values.data(), count, offset);
+    }
+
+    /**
+     * @brief Read all values into a vector.
+     *
+     * @param values    The vector to read into; it is resized to {@link valueCount}.
+     */
+    template<typename T>
+    void getValues(std::vector<T> &values) const {
+        getValues(values, valueCount());
+    }
+
+    void getValues(std::vector<bool> &values, ndsize_t count, ndsize_t offset = 0) const;
+
+    void getValues(std::vector<bool> &values) const {
+        getValues(values, valueCount());
+    }
+
+    /**
+     * @brief Write values straight from a buffer.
+     *
+     * Values after offset + count are kept, the property grows if it
+     * has less values. T must match the {@link dataType} of the property.
+     *
+     * @param data      The buffer holding count values.
+     * @param count     The number of values to write.
+     * @param offset    The index of the first value to write.
+     */
+    template<typename T>
+    void setValues(const T *data, ndsize_t count, ndsize_t offset = 0) {
+        if (count > 0) {
+            backend()->writeValues(to_data_type<T>::value, data, count, offset);
+        }
+    }
+
+    /**
+     * @brief Write the values of a vector starting at offset.
+     *
+     * @param values    The values to write.
+     * @param offset    The index of the first value to write.
+     */
+    template<typename T>
+    void setValues(const std::vector<T> &values, ndsize_t offset) {
+        setValues(values.data(), values.size(), offset);
+    }
+
+    /**
+     * @brief Replace all values of the property.
+     *
+     * @param values    The new values.
+     */
+    template<typename T>
+    void setValues(const std::vector<T> &values) {
+        if (values.size() != valueCount()) {
+            checkValueType(to_data_type<T>::value);
+            deleteValues();
+        }
+        setValues(values, 0);
+    }
+
+    void setValues(const std::vector<bool> &values, ndsize_t offset);
+
+    void setValues(const std::vector<bool> &values);
+
     //------------------------------------------------------
     // Operators and other functions
     //------------------------------------------------------
@@ -276,6 +376,12 @@ public:
      */
     virtual ~Property() {}
 
+private:
+
+    void checkValueRange(ndsize_t count, ndsize_t offset) const;
+
+    void checkValueType(DataType dtype) const;
+
 };
 
 template<>
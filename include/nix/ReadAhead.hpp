@@ -0,0 +1,146 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_READ_AHEAD_H
+#define NIX_READ_AHEAD_H
+
+#include <nix/DataArray.hpp>
+
+#include <nix/Platform.hpp>
+
+#include <deque>
+#include <future>
+#include <memory>
+#include <vector>
+
+namespace nix {
+
+/**
+ * @brief Read-only view of a DataArray that prefetches sequential scans.
+ *
+ * The data is split into slabs along axis, each slab spanning the
+ * full extent of all other dimensions. The slab length is the chunk
+ * length of the underlying data along axis (see
+ * {@link DataArray::dataChunks}), or about 1 MiB for unchunked data.
+ *
+ * When reads advance sequentially along axis, the next depth slabs
+ * are read (and decompressed) on the {@link IOExecutor} in the
+ * background, so the following windows are served from memory. At
+ * most the slabs touched by the last read plus depth slabs are kept.
+ *
+ * ~~~
+ * nix::ReadAhead ra(array, 0, 4);
+ * for (ndsize_t pos = 0; pos < n; pos += window) {
+ *     ra.getData(values, {window}, {pos});
+ * }
+ * ~~~
+ *
+ * The extent of the array is fixed when the ReadAhead is created,
+ * the array must not be modified while it is in use. Reads with a
+ * data type other than the cached one bypass the cache.
+ *
+ * NB: Prefetches are still running on the I/O thread when getData
+ * returns. Unless the HDF5 library was built thread-safe, the caller
+ * must not access the file in any other way (e.g. other DataArrays
+ * of it) while the ReadAhead is alive, or must call
+ * {@link IOExecutor::wait} before doing so.
+ */
+class NIXAPI ReadAhead : public DataSet {
+
+public:
+
+    /**
+     * @brief Create a read-ahead view of array.
+     *
+     * @param array  The DataArray to read from.
+     * @param axis   The axis along which the data is scanned.
+     * @param depth  The number of slabs to prefetch.
+     * @param dtype  The data type of the cache; defaults to the data
+     *               type of the array, or double if the array has a
+     *               polynomial or expansion origin.
+     */
+    explicit ReadAhead(const DataArray &array,
+                       size_t axis = 0,
+                       size_t depth = 4,
+                       DataType dtype = DataType::Nothing);
+
+    ReadAhead(const ReadAhead &other) = delete;
+    ReadAhead &operator=(const ReadAhead &other) = delete;
+
+    // the DataIO interface implementation
+    virtual void dataExtent(const NDSize &extent);
+    virtual NDSize dataExtent() const;
+    virtual DataType dataType() const;
+
+    /**
+     * @brief The length of a slab along the scan axis.
+     */
+    ndsize_t slabLength() const { return slab_len; }
+
+    size_t depth() const { return nahead; }
+
+    /**
+     * @brief Number of reads served entirely by prefetched slabs.
+     */
+    size_t hits() const { return nhits; }
+
+    /**
+     * @brief Number of reads that had to wait for new slabs.
+     */
+    size_t misses() const { return nmisses; }
+
+    /**
+     * @brief Number of slabs fetched ahead of the reads.
+     */
+    size_t prefetched() const { return nprefetched; }
+
+    virtual ~ReadAhead();
+
+protected:
+
+    void ioRead(DataType dtype,
+                void *data,
+                const NDSize &count,
+                const NDSize &offset) const;
+
+    void ioWrite(DataType dtype,
+                 const void *data,
+                 const NDSize &count,
+                 const NDSize &offset);
+
+private:
+
+    struct Slab {
+        ndsize_t                           index;
+        NDSize                             shape;
+        std::shared_ptr<std::vector<char>> buffer;
+        std::shared_future<void>           ready;
+    };
+
+    const Slab &fetch(ndsize_t index) const;
+
+    DataArray array;
+    NDSize    extent;
+    DataType  dtype;
+    size_t    axis;
+    size_t    nahead;
+    ndsize_t  slab_len;
+    ndsize_t  nslabs;
+
+    mutable std::deque<Slab> slabs;
+    // every prefetch still running, including those of dropped slabs
+    mutable std::vector<std::shared_future<void>> inflight;
+    mutable ndsize_t         next_pos;
+    mutable size_t           nhits;
+    mutable size_t           nmisses;
+    mutable size_t           nprefetched;
+};
+
+} // namespace nix
+
+#endif // NIX_READ_AHEAD_H
@@ -0,0 +1,83 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_REPACK_H
+#define NIX_REPACK_H
+
+#include <nix/Compression.hpp>
+#include <nix/NDSize.hpp>
+#include <nix/StorageLayout.hpp>
+
+#include <nix/Platform.hpp>
+
+#include <functional>
+#include <string>
+
+namespace nix {
+
+/**
+ * @brief The storage layout a DataArray or DataFrame is rewritten with.
+ */
+struct RepackTarget {
+    /** The new chunk shape; empty to guess it from the current extent. */
+    NDSize      chunks;
+    /** The new compression; Auto keeps the filters of the source. */
+    Compression compression = Compression::Auto;
+};
+
+/**
+ * @brief Chooses the target layout of the data of one DataArray or
+ *        DataFrame, given its name and current layout.
+ */
+typedef std::function<RepackTarget(const std::string &name, const StorageLayout &layout)> RepackRule;
+
+/**
+ * @brief Counts of what was copied by {@link repack}.
+ */
+struct RepackStats {
+    ndsize_t groups = 0;
+    ndsize_t datasets = 0;
+    ndsize_t attributes = 0;
+    /** hard links to already copied objects, soft and external links */
+    ndsize_t links = 0;
+    /** data of DataArrays and DataFrames written with a new layout */
+    ndsize_t rewritten = 0;
+    /** bytes allocated for the rewritten data in the source and the copy */
+    ndsize_t bytes_in = 0;
+    ndsize_t bytes_out = 0;
+};
+
+/**
+ * @brief Copy a nix file, rewriting the data of all DataArrays and
+ *        DataFrames with a new storage layout.
+ *
+ * All groups, data sets, attributes and links are copied as they are,
+ * so ids, references and metadata links are preserved, while the
+ * space left over by deleted entities is not. The data is copied
+ * chunk by chunk through a bounded buffer; deflate compression of the
+ * chunks is spread over nthreads threads. Data of variable length
+ * types (e.g. strings) is copied with its original layout.
+ *
+ * Only files of the HDF5 backend can be repacked.
+ *
+ * @param src       The path of the file to repack.
+ * @param dst       The path of the copy, which is overwritten.
+ * @param rule      Chooses the target layout, if empty the chunks of
+ *                  all data are guessed from the current extent and
+ *                  the compression is kept.
+ * @param nthreads  The number of compression threads, 0 to use one
+ *                  per hardware thread.
+ *
+ * @return What was copied.
+ */
+NIXAPI RepackStats repack(const std::string &src, const std::string &dst,
+                          const RepackRule &rule = RepackRule(), size_t nthreads = 0);
+
+} // namespace nix
+
+#endif // NIX_REPACK_H
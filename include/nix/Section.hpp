@@ -395,6 +395,22 @@ public:
      */
     Property createProperty(const std::string &name, const std::vector<Variant> &values);
 
+    /**
+     * @brief Add a new Property with string values stored in the given layout.
+     *
+     * Fixed length strings avoid a heap object per value in the file;
+     * a length of 0 selects the length of the longest value. Dictionary
+     * storage is not supported for properties.
+     *
+     * @param name      The name of the property.
+     * @param values    The values of the created property.
+     * @param strings   The layout of the string values.
+     *
+     * @return The newly created property.
+     */
+    Property createProperty(const std::string &name, const std::vector<Variant> &values,
+                            const StringStorage &strings);
+
     /**
      * @brief Delete the Property identified by its name or id.
      *
@@ -0,0 +1,145 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_SELECTION_H
+#define NIX_SELECTION_H
+
+#include <nix/NDSize.hpp>
+
+#include <nix/Platform.hpp>
+
+#include <vector>
+
+namespace nix {
+
+/**
+ * @brief A selection of elements of n-dimensional data that is not a
+ *        single box, for {@link DataSet::getData}.
+ *
+ * Each dimension is selected independently: all of it (the default),
+ * a strided slab (count blocks of block elements, stride elements
+ * apart) or a list of indices. The selected elements are the cartesian
+ * product of the selections of all dimensions, read in row-major order
+ * of the data with the shape given by {@link shape}. Index lists are
+ * sorted and duplicates removed.
+ *
+ * Selections can be united: the union contains every element selected
+ * by any of the parts once, in row-major order of the data, as 1-d
+ * result.
+ *
+ * ~~~
+ * // channels 3, 17, 90 and 201, every 10th sample of the first 10000
+ * nix::Selection sel;
+ * sel.indices(0, {3, 17, 90, 201}).slab(1, 0, 1000, 10);
+ * std::vector<double> values;
+ * array.getData(values, sel);    // shape {4, 1000}
+ * ~~~
+ */
+class NIXAPI Selection {
+
+public:
+
+    /**
+     * @brief The selection of one dimension.
+     */
+    struct Dim {
+        enum class Kind {
+            All,
+            Slab,
+            Indices
+        };
+
+        Kind                  kind = Kind::All;
+        ndsize_t              start = 0;
+        ndsize_t              count = 0;
+        ndsize_t              stride = 1;
+        ndsize_t              block = 1;
+        std::vector<ndsize_t> indices;
+    };
+
+    /**
+     * @brief A run of consecutive elements along the last dimension.
+     */
+    struct Run {
+        NDSize   offset;
+        ndsize_t length;
+    };
+
+    /**
+     * @brief Select everything.
+     */
+    Selection() {}
+
+    /**
+     * @brief Select the box of count elements at offset.
+     */
+    static Selection box(const NDSize &count, const NDSize &offset);
+
+    /**
+     * @brief Select count blocks of block elements, starting at start
+     *        and stride elements apart, along dimension dim.
+     *
+     * The block must not be longer than the stride.
+     */
+    Selection &slab(size_t dim, ndsize_t start, ndsize_t count, ndsize_t stride = 1, ndsize_t block = 1);
+
+    /**
+     * @brief Select the given indices along dimension dim.
+     */
+    Selection &indices(size_t dim, std::vector<ndsize_t> indices);
+
+    /**
+     * @brief Add the elements of another selection.
+     *
+     * Later calls of slab or indices refine the part added last.
+     */
+    Selection &unite(const Selection &other);
+
+    /**
+     * @brief True if the selection is the union of several parts.
+     */
+    bool isUnion() const {
+        return parts.size() > 1;
+    }
+
+    /**
+     * @brief The shape of the selected data of an array with the given extent.
+     *
+     * Throws if the selection does not fit the extent.
+     */
+    NDSize shape(const NDSize &extent) const;
+
+    /**
+     * @brief The selected elements as runs along the last dimension,
+     *        in the order the elements are read.
+     */
+    std::vector<Run> runs(const NDSize &extent) const;
+
+    /**
+     * @brief The selection of the parts, each with one entry per
+     *        dimension of extent.
+     */
+    std::vector<std::vector<Dim>> resolve(const NDSize &extent) const;
+
+    /**
+     * @brief Map a selection relative to the box (count, offset) to the
+     *        coordinates the box is in.
+     */
+    Selection within(const NDSize &count, const NDSize &offset) const;
+
+private:
+
+    std::vector<Dim> &last();
+
+    // the parts of a union; no parts selects everything
+    std::vector<std::vector<Dim>> parts;
+};
+
+} // namespace nix
+
+#endif // NIX_SELECTION_H
@@ -0,0 +1,45 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_STORAGE_LAYOUT_H
+#define NIX_STORAGE_LAYOUT_H
+
+#include <nix/Platform.hpp>
+#include <nix/NDSize.hpp>
+
+#include <string>
+#include <vector>
+
+namespace nix {
+
+/**
+ * @brief How the data of a DataArray or DataFrame is laid out in the file.
+ *
+ * Backends that do not manage the storage themselves leave the
+ * fields they do not know empty or 0.
+ */
+struct StorageLayout {
+    /** The extent of the data. */
+    NDSize                   shape;
+    /** The chunk shape, empty if the data is not chunked. */
+    NDSize                   chunks;
+    /** The number of bytes of one element in the file. */
+    size_t                   element_size = 0;
+    /** The number of bytes allocated in the file, after compression. */
+    ndsize_t                 storage_size = 0;
+    /** The number of chunks allocated in the file. */
+    ndsize_t                 allocated_chunks = 0;
+    /** The filters applied to each chunk, in pipeline order. */
+    std::vector<std::string> filters;
+    /** The number of boxes of other data a virtual DataArray maps, 0 if the data is stored. */
+    ndsize_t                 virtual_sources = 0;
+};
+
+} // namespace nix
+
+#endif // NIX_STORAGE_LAYOUT_H
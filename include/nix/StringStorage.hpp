@@ -0,0 +1,92 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_STRING_STORAGE_H
+#define NIX_STRING_STORAGE_H
+
+#include <nix/Platform.hpp>
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+namespace nix {
+
+/**
+ * @brief How string data is laid out in the file.
+ *
+ * By default strings are stored with variable length, which puts every
+ * string into a separate heap object that chunk filters cannot compress.
+ * Fixed length storage pads each string to the same number of bytes,
+ * dictionary storage keeps every distinct string once in a table and
+ * stores integer codes into that table as data. The latter pays off for
+ * categorical data with few distinct values, e.g. trial labels. Reading
+ * and writing strings works the same with every layout.
+ */
+class NIXAPI StringStorage {
+
+public:
+
+    enum class Mode {
+        Variable = 0,
+        Fixed,
+        Dictionary
+    };
+
+    StringStorage()
+        : mode(Mode::Variable), length(0) {}
+
+    /**
+     * @brief Strings of variable length (the default).
+     */
+    static StringStorage variable() {
+        return StringStorage(Mode::Variable, 0);
+    }
+
+    /**
+     * @brief Strings of at most length bytes.
+     *
+     * Writing a longer string fails. When creating a property with
+     * values, a length of 0 selects the length of the longest value.
+     */
+    static StringStorage fixed(size_t length = 0) {
+        return StringStorage(Mode::Fixed, length);
+    }
+
+    /**
+     * @brief Integer codes into a table of distinct strings.
+     */
+    static StringStorage dictionary() {
+        return StringStorage(Mode::Dictionary, 0);
+    }
+
+    Mode mode;
+    size_t length;
+
+    bool operator==(const StringStorage &other) const {
+        return mode == other.mode && length == other.length;
+    }
+
+    bool operator!=(const StringStorage &other) const {
+        return !(*this == other);
+    }
+
+private:
+
+    StringStorage(Mode mode, size_t length)
+        : mode(mode), length(length) {}
+};
+
+
+NIXAPI std::string string_storage_to_string(const StringStorage &storage);
+
+NIXAPI std::ostream &operator<<(std::ostream &out, const StringStorage &storage);
+
+} // namespace nix
+
+#endif // NIX_STRING_STORAGE_H
@@ -17,6 +17,7 @@
 #include <nix/base/IMultiTag.hpp>
 #include <nix/base/IGroup.hpp>
 #include <nix/Compression.hpp>
+#include <nix/StringStorage.hpp>
 #include <nix/NDSize.hpp>
 #include <nix/Identity.hpp>
 
@@ -78,7 +79,13 @@ public:
 
     virtual std::shared_ptr<base::IDataArray> createDataArray(const std::string &name, const std::string &type,
                                                               DataType data_type, const NDSize &shape,
-                                                              const Compression &compression) = 0;
+                                                              const Compression &compression,
+                                                              const StringStorage &strings) = 0;
+
+
+    virtual std::shared_ptr<base::IDataArray> createVirtualDataArray(const std::string &name, const std::string &type,
+                                                                     DataType data_type, const NDSize &shape,
+                                                                     const std::vector<VirtualSource> &sources) = 0;
 
     //--------------------------------------------------
     // Methods concerning data frame
@@ -15,6 +15,9 @@
 #include <nix/DataType.hpp>
 #include <nix/NDSize.hpp>
 #include <nix/ObjectType.hpp>
+#include <nix/Selection.hpp>
+#include <nix/StorageLayout.hpp>
+#include <nix/StringStorage.hpp>
 
 #include <string>
 #include <vector>
@@ -137,6 +140,20 @@ public:
      */
     virtual void write(DataType dtype, const void *data, const NDSize &count, const NDSize &offset) = 0;
 
+    /**
+     * @brief Write data into the data array, compressing it on several threads.
+     *
+     * Backends without support for it write the data like {@link write}.
+     *
+     * @param dtype     The type of data to write (e.g. {@link nix::DataType::Int32}).
+     * @param data      The data to write.
+     * @param count     The size of the data to write.
+     * @param offset    The position where the writing should start.
+     * @param nthreads  The number of threads to use, 0 for one per core.
+     */
+    virtual void writeParallel(DataType dtype, const void *data, const NDSize &count, const NDSize &offset,
+                               size_t nthreads) = 0;
+
     /**
      * @brief Read data from the data array.
      *
@@ -147,6 +164,32 @@ public:
      */
     virtual void read(DataType dtype, void *buffer, const NDSize &count, const NDSize &offset) const = 0;
 
+    /**
+     * @brief Read a selection of the data array.
+     *
+     * The selected elements are written to buffer in the order of
+     * {@link Selection::runs}.
+     *
+     * @param dtype     The type of data to read (e.g. {@link nix::DataType::Int32}).
+     * @param buffer    Buffer where the data is written.
+     * @param selection The elements to read.
+     */
+    virtual void read(DataType dtype, void *buffer, const Selection &selection) const = 0;
+
+    /**
+     * @brief Read data from the data array, decompressing it on several threads.
+     *
+     * Backends without support for it read the data like {@link read}.
+     *
+     * @param dtype     The type of data to read (e.g. {@link nix::DataType::Int32}).
+     * @param buffer    Buffer where the data is written.
+     * @param count     The size of the data to read.
+     * @param offset    The position where the reading should start.
+     * @param nthreads  The number of threads to use, 0 for one per core.
+     */
+    virtual void readParallel(DataType dtype, void *buffer, const NDSize &count, const NDSize &offset,
+                              size_t nthreads) const = 0;
+
 
     virtual NDSize dataExtent(void) const = 0;
 
@@ -156,6 +199,93 @@ public:
 
     virtual DataType dataType(void) const = 0;
 
+    /**
+     * @brief The shape of the storage chunks of the data.
+     *
+     * @return The chunk shape or an empty NDSize if the data is not
+     *         stored in chunks.
+     */
+    virtual NDSize dataChunks(void) const = 0;
+
+    /**
+     * @brief The number of bytes the data occupies in the file.
+     *
+     * @return The allocated size after compression or 0 if the size
+     *         is not known.
+     */
+    virtual ndsize_t dataStorageSize(void) const = 0;
+
+    /**
+     * @brief The storage layout of the data.
+     *
+     * @return The layout; empty if the data array has no data.
+     */
+    virtual StorageLayout dataLayout(void) const = 0;
+
+    /**
+     * @brief The layout of string data.
+     *
+     * @return The layout; variable for data that are not strings.
+     */
+    virtual StringStorage stringStorage(void) const = 0;
+
+    /**
+     * @brief The distinct strings of dictionary encoded data.
+     *
+     * @return The string table, in code order; empty if the data are
+     *         not dictionary encoded.
+     */
+    virtual std::vector<std::string> stringDictionary(void) const = 0;
+
+    /**
+     * @brief Read the codes of dictionary encoded data, without
+     *        looking up the strings.
+     */
+    virtual void readStringCodes(uint32_t *codes, const NDSize &count, const NDSize &offset) const = 0;
+
+    //--------------------------------------------------
+    // Methods concerning data envelopes.
+    //--------------------------------------------------
+
+    /**
+     * @brief The number of entries of a level that are combined into
+     *        one entry of the next level.
+     *
+     * @return The factor or 0 if the data array has no envelopes.
+     */
+    virtual ndsize_t envelopeFactor() const = 0;
+
+    /**
+     * @brief Set up the envelope storage, removing all existing levels.
+     *
+     * @param factor    The factor between two levels; 0 removes the envelopes.
+     */
+    virtual void envelopeFactor(ndsize_t factor) = 0;
+
+    /**
+     * @brief The number of entries (min, max, mean triples) of a level.
+     *
+     * @param level     The level, starting at 1.
+     *
+     * @return The number of entries or 0 if the level does not exist.
+     */
+    virtual ndsize_t envelopeSize(size_t level) const = 0;
+
+    /**
+     * @brief Resize a level, creating it if needed; a size of 0 removes it.
+     */
+    virtual void envelopeSize(size_t level, ndsize_t size) = 0;
+
+    /**
+     * @brief Read count entries (3 * count doubles) of a level.
+     */
+    virtual void readEnvelope(size_t level, double *data, ndsize_t count, ndsize_t offset) const = 0;
+
+    /**
+     * @brief Write count entries (3 * count doubles) of a level.
+     */
+    virtual void writeEnvelope(size_t level, const double *data, ndsize_t count, ndsize_t offset) = 0;
+
     /**
      * @brief Destructor
      */
@@ -163,6 +293,16 @@ public:
 
 };
 
+/**
+ * @brief A box of the data of a DataArray mapped into a virtual DataArray.
+ */
+struct VirtualSource {
+    std::shared_ptr<IDataArray> array;
+    NDSize                      count;
+    NDSize                      source_offset;
+    NDSize                      offset;
+};
+
 
 } // namespace base
 
@@ -13,6 +13,8 @@
 
 #include <nix/base/IEntityWithSources.hpp>
 #include <nix/NDSize.hpp>
+#include <nix/StorageLayout.hpp>
+#include <nix/StringStorage.hpp>
 #include <nix/Variant.hpp>
 
 #include <string>
@@ -26,6 +28,7 @@ class NIXAPI Column {
     std::string   name;
     std::string   unit;
     nix::DataType dtype;
+    StringStorage strings;
 };
 
 
@@ -96,6 +99,8 @@ public:
     virtual nix::ndsize_t rows() const = 0;
     virtual void rows(nix::ndsize_t n) = 0;
 
+    virtual StorageLayout dataLayout() const = 0;
+
     virtual std::vector<Column> columns() const = 0;
 
     virtual std::vector<unsigned> colIndex(const std::vector<std::string> &names) const = 0;
@@ -117,6 +117,9 @@ public:
     virtual std::vector<std::string> labels() const = 0;
 
 
+    virtual ndsize_t labelCount() const = 0;
+
+
     virtual void labels(const std::vector<std::string> &labels) = 0;
 
 
@@ -161,6 +164,9 @@ public:
     virtual std::vector<double> ticks() const = 0;
 
 
+    virtual ndsize_t tickCount() const = 0;
+
+
     virtual void ticks(const std::vector<double> &ticks) = 0;
 
 
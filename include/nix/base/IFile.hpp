@@ -23,17 +23,25 @@ namespace nix {
 
 /**
  * @brief File open modes
+ *
+ * SwmrWrite and SwmrRead open a file for single-writer/multiple-reader
+ * access (HDF5 backend only): one process appends data while others
+ * read it. See {@link File::startSwmrWrite}.
  */
 enum class FileMode {
     ReadOnly = 0,
     ReadWrite,
-    Overwrite
+    Overwrite,
+    SwmrWrite,
+    SwmrRead
 };
 
 
 #define FILE_VERSION std::vector<int>{1, 0, 0}
 #define FILE_FORMAT  std::string("nix")
 
+class MetadataSnapshot;
+
 namespace base {
 
 
@@ -87,6 +95,16 @@ public:
 
     virtual bool deleteSection(const std::string &name_or_id) = 0;
 
+
+    virtual std::shared_ptr<const MetadataSnapshot> metadataSnapshot() const = 0;
+
+    /**
+     * Attach a snapshot of the metadata tree; the backend resets it to
+     * nullptr whenever it modifies a section or creates or deletes
+     * sections or properties.
+     */
+    virtual void metadataSnapshot(const std::shared_ptr<const MetadataSnapshot> &snapshot) = 0;
+
     //--------------------------------------------------
     // Methods for file attribute access.
     //--------------------------------------------------
@@ -118,6 +136,12 @@ public:
     virtual void forceCreatedAt(time_t time) = 0;
 
 
+    virtual time_t validatedAt() const = 0;
+
+
+    virtual void forceValidatedAt(time_t time) = 0;
+
+
     virtual void close() = 0;
 
 
@@ -127,6 +151,9 @@ public:
     virtual FileMode fileMode() const = 0;
 
 
+    virtual void startSwmrWrite() = 0;
+
+
     virtual Compression compression() const = 0;
 
 
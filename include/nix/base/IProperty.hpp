@@ -79,6 +79,18 @@ public:
 
     virtual void values(const boost::none_t t) = 0;
 
+    /**
+     * @brief Read count values starting at offset into data, converting
+     *        numeric values to dtype.
+     */
+    virtual void readValues(DataType dtype, void *data, ndsize_t count, ndsize_t offset) const = 0;
+
+    /**
+     * @brief Write count values of type dtype starting at offset,
+     *        adding values if the property has less than offset + count.
+     */
+    virtual void writeValues(DataType dtype, const void *data, ndsize_t count, ndsize_t offset) = 0;
+
 
     virtual ~IProperty() {}
 };
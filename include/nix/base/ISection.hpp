@@ -16,6 +16,7 @@
 #include <nix/DataType.hpp>
 #include <nix/Variant.hpp>
 #include <nix/NDSize.hpp>
+#include <nix/StringStorage.hpp>
 #include <nix/ObjectType.hpp>
 
 #include <string>
@@ -101,6 +102,10 @@ public:
     virtual std::shared_ptr<IProperty> createProperty(const std::string &name, const DataType &dtype) = 0;
 
 
+    virtual std::shared_ptr<IProperty> createProperty(const std::string &name, const DataType &dtype,
+                                                      const StringStorage &strings) = 0;
+
+
     virtual std::shared_ptr<IProperty> createProperty(const std::string &name, const Variant &value) = 0;
 
 
@@ -16,6 +16,7 @@
 
 #include <nix/Exception.hpp>
 #include <nix/Platform.hpp>
+#include <nix/NDSize.hpp>
 
 #include <string>
 #include <sstream>
@@ -424,6 +425,22 @@ NIXAPI void applyPolynomial(const std::vector<double> &coefficients,
                             double *output,
                             size_t n);
 
+/**
+ * @brief Copy a n-dimensional region between two row-major buffers.
+ *
+ * @param src         The source buffer.
+ * @param src_shape   The shape of the source buffer.
+ * @param src_offset  Where the region starts in the source.
+ * @param dst         The destination buffer.
+ * @param dst_shape   The shape of the destination buffer.
+ * @param dst_offset  Where the region starts in the destination.
+ * @param count       The shape of the region to copy.
+ * @param elem_size   The size of a single element in bytes.
+ */
+NIXAPI void copyRegion(const void *src, const NDSize &src_shape, const NDSize &src_offset,
+                       void *dst, const NDSize &dst_shape, const NDSize &dst_offset,
+                       const NDSize &count, size_t elem_size);
+
 bool looksLikeUUID(const std::string &id);
 
 } // namespace util
@@ -448,9 +448,11 @@ namespace valid {
      * along the corresponding dimension in the data.
      */
     struct NIXAPI dimTicksMatchData {
-        const DataArray &data;
+        NDSize extent;
 
-        dimTicksMatchData(const DataArray &data) : data(data) {}
+        dimTicksMatchData(const DataArray &data);
+
+        dimTicksMatchData(const NDSize &extent) : extent(extent) {}
     
         bool operator()(const std::vector<Dimension> &dims) const;
     };
@@ -464,9 +466,11 @@ namespace valid {
      * along the corresponding dimension in the data.
      */
     struct NIXAPI dimLabelsMatchData {
-        const DataArray &data;
+        NDSize extent;
+
+        dimLabelsMatchData(const DataArray &data);
 
-        dimLabelsMatchData(const DataArray &data) : data(data) {}
+        dimLabelsMatchData(const NDSize &extent) : extent(extent) {}
     
         bool operator()(const std::vector<Dimension> &dims) const;
     };
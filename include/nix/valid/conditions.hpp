@@ -17,12 +17,79 @@
 #include <nix/valid/checks.hpp>
 #include <nix/valid/validator.hpp>
 
-#include <string>
+#include <exception>
 #include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
 
 namespace nix {
 namespace valid {
 
+    /**
+     * @brief memoized getter call
+     *
+     * Wraps a getter call on a parent object so that the getter is
+     * executed at most once, no matter how many conditions use it.
+     * Copies share the result; an error thrown by the getter is
+     * remembered and rethrown on every call.
+     * Use {@link memoize} to create one.
+     */
+    template<typename T>
+    class accessor {
+
+    public:
+
+        template<typename TOBJ, typename TBASEOBJ, typename TRET>
+        accessor(const TOBJ &parent, TRET(TBASEOBJ::*get)(void)const)
+            : state(std::make_shared<State>()) {
+            state->get = [parent, get] () -> T { return (parent.*get)(); };
+        }
+
+        const T &operator()() const {
+            if (!state->done) {
+                state->done = true;
+                try {
+                    state->value = state->get();
+                } catch (...) {
+                    state->error = std::current_exception();
+                }
+                state->get = nullptr;
+            }
+
+            if (state->error) {
+                std::rethrow_exception(state->error);
+            }
+
+            return state->value;
+        }
+
+    private:
+
+        struct State {
+            std::function<T(void)> get;
+            T                      value;
+            bool                   done = false;
+            std::exception_ptr     error;
+        };
+
+        std::shared_ptr<State> state;
+    };
+
+    /**
+     * @brief creates a memoized getter call
+     *
+     * @param parent     Parent object
+     * @param get        Getter method in parent object (pointer-to-member)
+     *
+     * @returns The {@link accessor} to be passed to the conditions.
+     */
+    template<typename TOBJ, typename TBASEOBJ, typename TRET>
+    accessor<typename std::decay<TRET>::type>
+    memoize(const TOBJ &parent, TRET(TBASEOBJ::*get)(void)const) {
+        return accessor<typename std::decay<TRET>::type>(parent, get);
+    }
+
     /**
      * @brief creates condition throwing error if check fails
      * 
@@ -36,7 +103,7 @@ namespace valid {
      * function call.
      *
      * @param parent     Parent object
-     * @param get        Getter method in parent object (pointer-to-member)
+     * @param get        Memoized getter of the parent object
      * @param check      The test itself (e.g. notFalse or notEmpty)
      * @param msg        The message to produce if the test fails.
      * @param subs       Init list of sub conditions to be executed only
@@ -44,28 +111,28 @@ namespace valid {
      *
      * @returns The created, callable condition of type condition
      */
-    template<typename TOBJ, typename TBASEOBJ, typename TRET, typename TCHECK>
+    template<typename TOBJ, typename TRET, typename TCHECK>
     condition
-    must(const TOBJ &parent, TRET(TBASEOBJ::*get)(void)const, const TCHECK &check,
+    must(const TOBJ &parent, const accessor<TRET> &get, const TCHECK &check,
          const std::string &msg, const std::vector<condition> &subs = {}) {
         return [parent, get, check, msg, subs] () -> Result {
-            bool errOccured = false;
-            typedef decltype((parent.*get)()) return_type;
-            return_type val;
             std::string id = nix::util::numToStr(
                                 ID<hasID<TOBJ>::value>().get(parent)
                              );
             boost::optional<std::string> name = nix::getEntityName(parent);
 
+            bool errOccured = false;
+            const TRET *val = nullptr;
+
             // execute getter call & check for error
             try {
-                val = (parent.*get)();
-            } catch (std::exception e) {
+                val = &get();
+            } catch (std::exception &e) {
                 errOccured = true;
             }
 
             // compare value & check for validity
-            if(errOccured || !check(val)) {
+            if(errOccured || !check(*val)) {
                 return Result(Message(id, msg, name), none); // failed || error
             }
 
@@ -78,6 +145,28 @@ namespace valid {
         };
     }
 
+    /**
+     * @brief creates condition throwing error if check fails
+     *
+     * See {@link must} above; the getter is called on execution of the
+     * condition (not memoized).
+     *
+     * @param parent     Parent object
+     * @param get        Getter method in parent object (pointer-to-member)
+     * @param check      The test itself (e.g. notFalse or notEmpty)
+     * @param msg        The message to produce if the test fails.
+     * @param subs       Init list of sub conditions to be executed only
+     *                   if this check succeeds.
+     *
+     * @returns The created, callable condition of type condition
+     */
+    template<typename TOBJ, typename TBASEOBJ, typename TRET, typename TCHECK>
+    condition
+    must(const TOBJ &parent, TRET(TBASEOBJ::*get)(void)const, const TCHECK &check,
+         const std::string &msg, const std::vector<condition> &subs = {}) {
+        return must(parent, memoize(parent, get), check, msg, subs);
+    }
+
     /**
      * @brief creates condition throwing warning if check fails
      * 
@@ -91,7 +180,7 @@ namespace valid {
      * function call.
      *
      * @param parent     Parent object
-     * @param get        Getter method in parent object (pointer-to-member)
+     * @param get        Memoized getter of the parent object
      * @param check      The test itself (e.g. notFalse or notEmpty)
      * @param msg        The message to produce if the test fails.
      * @param subs       Init list of sub conditions to be executed only
@@ -99,28 +188,28 @@ namespace valid {
      *
      * @returns The created, callable condition of type condition
      */
-    template<typename TOBJ, typename TBASEOBJ, typename TRET, typename TCHECK>
+    template<typename TOBJ, typename TRET, typename TCHECK>
     condition
-    should(const TOBJ &parent, TRET(TBASEOBJ::*get)(void)const, const TCHECK &check,
+    should(const TOBJ &parent, const accessor<TRET> &get, const TCHECK &check,
            const std::string &msg, const std::vector<condition> &subs = {}) {
         return [parent, get, check, msg, subs] () -> Result {
-            bool errOccured = false;
-            typedef decltype((parent.*get)()) return_type;
-            return_type val;
             std::string id = nix::util::numToStr(
                                 ID<hasID<TOBJ>::value>().get(parent)
                              );
             boost::optional<std::string> name = nix::getEntityName(parent);
 
+            bool errOccured = false;
+            const TRET *val = nullptr;
+
             // execute getter call & check for error
             try {
-                val = (parent.*get)();
-            } catch (std::exception e) {
+                val = &get();
+            } catch (std::exception &e) {
                 errOccured = true;
             }
 
             // compare value & check for validity
-            if(errOccured || !check(val)) { // failed || error
+            if(errOccured || !check(*val)) { // failed || error
                 return Result(none, Message(id, msg, name));
             }
 
@@ -133,6 +222,28 @@ namespace valid {
         };
     }
 
+    /**
+     * @brief creates condition throwing warning if check fails
+     *
+     * See {@link should} above; the getter is called on execution of the
+     * condition (not memoized).
+     *
+     * @param parent     Parent object
+     * @param get        Getter method in parent object (pointer-to-member)
+     * @param check      The test itself (e.g. notFalse or notEmpty)
+     * @param msg        The message to produce if the test fails.
+     * @param subs       Init list of sub conditions to be executed only
+     *                   if this check succeeds.
+     *
+     * @returns The created, callable condition of type condition
+     */
+    template<typename TOBJ, typename TBASEOBJ, typename TRET, typename TCHECK>
+    condition
+    should(const TOBJ &parent, TRET(TBASEOBJ::*get)(void)const, const TCHECK &check,
+           const std::string &msg, const std::vector<condition> &subs = {}) {
+        return should(parent, memoize(parent, get), check, msg, subs);
+    }
+
     /**
      * @brief creates condition not throwing any message even if check fails
      * 
@@ -147,31 +258,30 @@ namespace valid {
      * function calls.
      *
      * @param parent     Parent object
-     * @param get        Getter method in parent object (pointer-to-member)
+     * @param get        Memoized getter of the parent object
      * @param check      The test itself (e.g. notFalse or notEmpty)
      * @param subs       Init list of sub conditions to be executed only
      *                   if this check succeeds.
      *
      * @returns The created, callable condition of type condition
      */
-    template<typename TOBJ, typename TBASEOBJ, typename TRET, typename TCHECK>
+    template<typename TOBJ, typename TRET, typename TCHECK>
     condition
-    could(const TOBJ &parent, TRET(TBASEOBJ::*get)(void)const, const TCHECK &check,
+    could(const TOBJ &parent, const accessor<TRET> &get, const TCHECK &check,
           const std::vector<condition> &subs = {}) {
         return [parent, get, check, subs] () -> Result {
             bool errOccured = false;
-            typedef decltype((parent.*get)()) return_type;
-            return_type val;
+            const TRET *val = nullptr;
 
             // execute getter call & check for error
             try {
-                val = (parent.*get)();
-            } catch (std::exception e) {
+                val = &get();
+            } catch (std::exception &e) {
                 errOccured = true;
             }
 
             // compare value & check for validity
-            if(errOccured || !check(val)) { // failed || error
+            if(errOccured || !check(*val)) { // failed || error
                 return Result();
             }
 
@@ -184,6 +294,27 @@ namespace valid {
         };
     }
 
+    /**
+     * @brief creates condition not throwing any message even if check fails
+     *
+     * See {@link could} above; the getter is called on execution of the
+     * condition (not memoized).
+     *
+     * @param parent     Parent object
+     * @param get        Getter method in parent object (pointer-to-member)
+     * @param check      The test itself (e.g. notFalse or notEmpty)
+     * @param subs       Init list of sub conditions to be executed only
+     *                   if this check succeeds.
+     *
+     * @returns The created, callable condition of type condition
+     */
+    template<typename TOBJ, typename TBASEOBJ, typename TRET, typename TCHECK>
+    condition
+    could(const TOBJ &parent, TRET(TBASEOBJ::*get)(void)const, const TCHECK &check,
+          const std::vector<condition> &subs = {}) {
+        return could(parent, memoize(parent, get), check, subs);
+    }
+
 } // namespace valid
 } // namespace nix
 
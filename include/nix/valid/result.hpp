@@ -23,6 +23,7 @@ namespace valid {
 class NIXAPI Result {
     std::vector<Message> errors;
     std::vector<Message> warnings;
+    std::vector<Message> skipped;
 public:
 
     /**
@@ -99,10 +100,21 @@ public:
      */
     std::vector<Message> getErrors() const;
 
+    /**
+     * @brief Returns the skipped entities vector.
+     * 
+     * Returns one msg per entity that was not validated, because it
+     * did not change since the last validation (see
+     * {@link File::validateModified}).
+     *
+     * @return vector of skipped msgs
+     */
+    std::vector<Message> getSkipped() const;
+
     /**
      * @brief Appends the warnings & errors of given Result to this one
      * 
-     * Concatenates the {@link errors} and {@link warnings} vectors
+     * Concatenates the {@link errors}, {@link warnings} and {@link skipped} vectors
      * of the given {@link Result} object to those if this {@link Result}
      * object and returns a reference to this object.
      *
@@ -130,6 +142,16 @@ public:
      */
     Result addWarning(const Message &warning);
 
+    /**
+     * @brief Adds a skipped entity message
+     * 
+     * Records that an entity was not validated and returns a
+     * reference to this object.
+     *
+     * @return reference to this Result
+     */
+    Result addSkipped(const Message &skip);
+
     /**
      * @brief Returns true if no msgs added at all
      * 
@@ -160,6 +182,13 @@ public:
      */
     bool hasWarnings() const;
 
+    /**
+     * @brief Returns true if any entity was skipped
+     *
+     * @return bool indicating whether skipped msgs added
+     */
+    bool hasSkipped() const;
+
     /**
      * @brief Output operator
      * 
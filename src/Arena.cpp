@@ -0,0 +1,103 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/Arena.hpp>
+
+#include <algorithm>
+#include <cstdint>
+
+namespace nix {
+
+static Arena *&thread_arena() {
+    static thread_local Arena *arena = nullptr;
+    return arena;
+}
+
+
+Arena::Arena(size_t block_size)
+    : block_size(std::max<size_t>(block_size, 64)), pos(0), used(0), nallocs(0) {
+}
+
+
+void *Arena::allocate(size_t nbytes, size_t align) {
+    if (chunks.empty()) {
+        grow(nbytes + align);
+    }
+
+    Chunk *chunk = &chunks.back();
+    uintptr_t base = reinterpret_cast<uintptr_t>(chunk->mem.get());
+    size_t start = ((base + pos + align - 1) & ~(uintptr_t(align) - 1)) - base;
+
+    if (start + nbytes > chunk->size) {
+        grow(nbytes + align);
+        chunk = &chunks.back();
+        base = reinterpret_cast<uintptr_t>(chunk->mem.get());
+        start = ((base + align - 1) & ~(uintptr_t(align) - 1)) - base;
+    }
+
+    pos = start + nbytes;
+    used += nbytes;
+    nallocs++;
+    return chunk->mem.get() + start;
+}
+
+
+void Arena::grow(size_t min_size) {
+    const size_t size = std::max(block_size, min_size);
+    chunks.push_back(Chunk{std::unique_ptr<char[]>(new char[size]), size});
+    pos = 0;
+}
+
+
+void Arena::reset() {
+    if (chunks.size() > 1) {
+        const size_t total = capacity();
+        chunks.clear();
+        grow(total);
+    }
+
+    pos = 0;
+    used = 0;
+    nallocs = 0;
+}
+
+
+size_t Arena::capacity() const {
+    size_t total = 0;
+    for (const Chunk &c : chunks) {
+        total += c.size;
+    }
+    return total;
+}
+
+
+Arena *Arena::current() {
+    return thread_arena();
+}
+
+
+Arena *Arena::install(Arena *arena) {
+    Arena *previous = thread_arena();
+    thread_arena() = arena;
+    return previous;
+}
+
+
+ArenaScope::ArenaScope(Arena &arena, bool reset_on_exit)
+    : arena(&arena), previous(Arena::install(&arena)), reset_on_exit(reset_on_exit) {
+}
+
+
+ArenaScope::~ArenaScope() {
+    Arena::install(previous);
+    if (reset_on_exit) {
+        arena->reset();
+    }
+}
+
+} // namespace nix
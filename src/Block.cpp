@@ -7,10 +7,107 @@
 // LICENSE file in the root of the Project.
 
 #include <nix/Block.hpp>
+#include <nix/ChunkIterator.hpp>
+#include <nix/IOExecutor.hpp>
+#include <nix/base/IFile.hpp>
 #include <nix/util/util.hpp>
 
+#include <algorithm>
+#include <cmath>
+
 namespace nix {
 
+// metadata can only be linked within the file of the section
+static bool in_file_of(const Section &section, const Block &block) {
+    return section && section.impl()->parentFile()->hasBlock(block.id());
+}
+
+// append a copy of dim to target
+static void append_dimension(DataArray &target, const Dimension &dim) {
+    switch (dim.dimensionType()) {
+        case DimensionType::Sample: {
+            SampledDimension src = dim.asSampledDimension();
+            SampledDimension dst = target.appendSampledDimension(src.samplingInterval());
+            if (src.label()) {
+                dst.label(*src.label());
+            }
+            if (src.unit()) {
+                dst.unit(*src.unit());
+            }
+            if (src.offset()) {
+                dst.offset(*src.offset());
+            }
+            break;
+        }
+        case DimensionType::Range: {
+            RangeDimension src = dim.asRangeDimension();
+            if (src.alias()) {
+                target.appendAliasRangeDimension();
+                break;
+            }
+            RangeDimension dst = target.appendRangeDimension(src.ticks());
+            if (src.label()) {
+                dst.label(*src.label());
+            }
+            if (src.unit()) {
+                dst.unit(*src.unit());
+            }
+            break;
+        }
+        case DimensionType::Set: {
+            SetDimension dst = target.appendSetDimension();
+            dst.labels(dim.asSetDimension().labels());
+            break;
+        }
+    }
+}
+
+// the ticks of a range dimension or the sample positions of a sampled one
+static std::vector<double> axis_ticks(const DataArray &source, ndsize_t index) {
+    const Dimension dim = source.getDimension(index);
+    if (dim.dimensionType() == DimensionType::Sample) {
+        return dim.asSampledDimension().axis(source.dataExtent()[index - 1]);
+    }
+    return dim.asRangeDimension().ticks();
+}
+
+// whether each sampled source starts one interval after the last sample of the previous one
+static bool contiguous_samples(const std::vector<DataArray> &sources, ndsize_t index) {
+    double end = 0.0;
+    for (size_t k = 0; k < sources.size(); k++) {
+        const SampledDimension dim = sources[k].getDimension(index).asSampledDimension();
+        const double interval = dim.samplingInterval();
+        const double offset = dim.offset() ? *dim.offset() : 0.0;
+        if (k > 0 && std::abs(offset - end) > interval * 1e-6) {
+            return false;
+        }
+        end = offset + sources[k].dataExtent()[index - 1] * interval;
+    }
+    return true;
+}
+
+// join the ticks along a dimension, shifting those that would not increase
+static std::vector<double> join_ticks(const std::vector<DataArray> &sources, ndsize_t index) {
+    std::vector<double> ticks;
+    for (const DataArray &source : sources) {
+        std::vector<double> next = axis_ticks(source, index);
+        if (!ticks.empty() && !next.empty() && next.front() <= ticks.back()) {
+            double step = 1.0;
+            if (ticks.size() > 1) {
+                step = ticks.back() - ticks[ticks.size() - 2];
+            } else if (next.size() > 1) {
+                step = next[1] - next[0];
+            }
+            const double shift = ticks.back() + step - next.front();
+            for (double &tick : next) {
+                tick += shift;
+            }
+        }
+        ticks.insert(ticks.end(), next.begin(), next.end());
+    }
+    return ticks;
+}
+
 Source Block::createSource(const std::string &name, const std::string &type){
     util::checkEntityNameAndType(name, type);
     if (hasSource(name)) {
@@ -46,12 +143,249 @@ bool Block::deleteSource(const Source &source) {
 }
 
 DataArray Block::createDataArray(const std::string &name, const std::string &type, nix::DataType data_type,
-                                 const NDSize &shape, const Compression &compression) {
+                                 const NDSize &shape, const Compression &compression,
+                                 const StringStorage &strings) {
     util::checkEntityNameAndType(name, type);
     if (hasDataArray(name)){
         throw DuplicateName("create DataArray");
     }
-    return backend()->createDataArray(name, type, data_type, shape, compression);
+    if (strings.mode != StringStorage::Mode::Variable && data_type != DataType::String) {
+        throw std::invalid_argument("Block::createDataArray: string storage requires DataType::String");
+    }
+    if (strings.mode == StringStorage::Mode::Fixed && strings.length == 0) {
+        throw std::invalid_argument("Block::createDataArray: fixed length strings need a length");
+    }
+    return backend()->createDataArray(name, type, data_type, shape, compression, strings);
+}
+
+DataArray Block::createVirtualDataArray(const std::string &name, const std::string &type, DataType data_type,
+                                        const NDSize &shape, const std::vector<VirtualSlice> &slices) {
+    util::checkEntityNameAndType(name, type);
+    if (hasDataArray(name)) {
+        throw DuplicateName("create DataArray");
+    }
+
+    const size_t rank = shape.size();
+    std::vector<base::VirtualSource> sources;
+    for (const VirtualSlice &slice : slices) {
+        if (!slice.source) {
+            throw UninitializedEntity();
+        }
+        if (slice.source.dataType() != data_type) {
+            throw std::invalid_argument("Block::createVirtualDataArray: sources must have the data type of the array");
+        }
+
+        const NDSize extent = slice.source.dataExtent();
+        const NDSize source_offset = slice.source_offset ? slice.source_offset : NDSize(rank, 0);
+        const NDSize offset = slice.offset ? slice.offset : NDSize(rank, 0);
+        if (extent.size() != rank || slice.count.size() != rank || source_offset.size() != rank ||
+            offset.size() != rank) {
+            throw IncompatibleDimensions("Slices must have the rank of the DataArray", "Block::createVirtualDataArray");
+        }
+        if (source_offset + slice.count > extent || offset + slice.count > shape) {
+            throw OutOfBounds("Block::createVirtualDataArray: slice is out of bounds");
+        }
+        sources.push_back(base::VirtualSource {slice.source.impl(), slice.count, source_offset, offset});
+    }
+
+    return backend()->createVirtualDataArray(name, type, data_type, shape, sources);
+}
+
+DataArray Block::concatenateDataArrays(const std::string &name, const std::string &type,
+                                       const std::vector<DataArray> &sources, size_t axis) {
+    if (sources.empty()) {
+        throw std::invalid_argument("Block::concatenateDataArrays: no source");
+    }
+    const DataArray &first = sources[0];
+    if (!first) {
+        throw UninitializedEntity();
+    }
+
+    NDSize shape = first.dataExtent();
+    const size_t rank = shape.size();
+    if (axis >= rank) {
+        throw InvalidRank("axis is out of bounds");
+    }
+
+    const DataType dtype = first.dataType();
+    const std::vector<double> poly = first.polynomCoefficients();
+    const ndsize_t ndims = first.dimensionCount();
+    const ndsize_t index = axis + 1;
+    const bool merge = index <= ndims;
+    const DimensionType kind = merge ? first.getDimension(index).dimensionType() : DimensionType::Set;
+
+    std::vector<VirtualSlice> slices;
+    ndsize_t length = 0;
+    for (const DataArray &source : sources) {
+        if (!source) {
+            throw UninitializedEntity();
+        }
+        const NDSize extent = source.dataExtent();
+        if (extent.size() != rank) {
+            throw IncompatibleDimensions("Sources must have the same rank", "Block::concatenateDataArrays");
+        }
+        for (size_t i = 0; i < rank; i++) {
+            if (i != axis && extent[i] != shape[i]) {
+                throw IncompatibleDimensions("Sources must have the same extent apart from axis",
+                                             "Block::concatenateDataArrays");
+            }
+        }
+        if (source.dataType() != dtype) {
+            throw std::invalid_argument("Block::concatenateDataArrays: sources must have the same data type");
+        }
+        if (source.polynomCoefficients() != poly || source.expansionOrigin() != first.expansionOrigin() ||
+            source.unit() != first.unit()) {
+            throw std::invalid_argument("Block::concatenateDataArrays: sources must have the same calibration and unit");
+        }
+
+        if (merge) {
+            if (source.dimensionCount() < index || source.getDimension(index).dimensionType() != kind) {
+                throw IncompatibleDimensions("Sources must have the same kind of dimension along axis",
+                                             "Block::concatenateDataArrays");
+            }
+            const Dimension dim = source.getDimension(index);
+            const Dimension dim0 = first.getDimension(index);
+            if (kind == DimensionType::Sample &&
+                (dim.asSampledDimension().samplingInterval() != dim0.asSampledDimension().samplingInterval() ||
+                 dim.asSampledDimension().unit() != dim0.asSampledDimension().unit())) {
+                throw IncompatibleDimensions("Sources must have the same sampling interval along axis",
+                                             "Block::concatenateDataArrays");
+            }
+            if (kind == DimensionType::Range &&
+                (dim.asRangeDimension().alias() != dim0.asRangeDimension().alias() ||
+                 dim.asRangeDimension().unit() != dim0.asRangeDimension().unit())) {
+                throw IncompatibleDimensions("Sources must have the same unit of ticks along axis",
+                                             "Block::concatenateDataArrays");
+            }
+        }
+
+        VirtualSlice slice;
+        slice.source = source;
+        slice.count = extent;
+        slice.offset = NDSize(rank, 0);
+        slice.offset[axis] = length;
+        slices.push_back(slice);
+        length += extent[axis];
+    }
+    shape[axis] = length;
+
+    Section metadata = first.metadata();
+    bool shared = in_file_of(metadata, *this);
+    for (const DataArray &source : sources) {
+        shared = shared && source.metadata() && source.metadata().id() == metadata.id();
+    }
+
+    DataArray da = createVirtualDataArray(name, type, dtype, shape, slices);
+    if (first.label()) {
+        da.label(*first.label());
+    }
+    if (first.unit()) {
+        da.unit(*first.unit());
+    }
+    if (poly.size()) {
+        da.polynomCoefficients(poly);
+    }
+    if (first.expansionOrigin()) {
+        da.expansionOrigin(*first.expansionOrigin());
+    }
+
+    for (ndsize_t i = 1; i <= ndims; i++) {
+        const Dimension dim = first.getDimension(i);
+        if (i != index || (kind == DimensionType::Sample && contiguous_samples(sources, index))) {
+            append_dimension(da, dim);
+        } else if (kind == DimensionType::Range && dim.asRangeDimension().alias()) {
+            da.appendAliasRangeDimension();
+        } else if (kind == DimensionType::Range) {
+            RangeDimension src = dim.asRangeDimension();
+            RangeDimension dst = da.appendRangeDimension(join_ticks(sources, index));
+            if (src.label()) {
+                dst.label(*src.label());
+            }
+            if (src.unit()) {
+                dst.unit(*src.unit());
+            }
+        } else if (kind == DimensionType::Sample) {
+            // sampled sources with gaps between them
+            SampledDimension src = dim.asSampledDimension();
+            RangeDimension dst = da.appendRangeDimension(join_ticks(sources, index));
+            if (src.label()) {
+                dst.label(*src.label());
+            }
+            if (src.unit()) {
+                dst.unit(*src.unit());
+            }
+        } else {
+            // the labels are kept only if every source has them
+            std::vector<std::string> labels;
+            bool complete = true;
+            for (const DataArray &source : sources) {
+                std::vector<std::string> next = source.getDimension(index).asSetDimension().labels();
+                complete = complete && next.size() == source.dataExtent()[axis];
+                labels.insert(labels.end(), next.begin(), next.end());
+            }
+            SetDimension dst = da.appendSetDimension();
+            if (complete) {
+                dst.labels(labels);
+            }
+        }
+    }
+
+    if (shared) {
+        da.metadata(metadata);
+    }
+    return da;
+}
+
+DataArray Block::materializeDataArray(const DataArray &source, const std::string &name,
+                                      const Compression &compression) {
+    if (!source) {
+        throw UninitializedEntity();
+    }
+
+    const DataType dtype = source.dataType();
+    const NDSize extent = source.dataExtent();
+    const StringStorage strings = dtype == DataType::String ? source.stringStorage() : StringStorage();
+    const Section metadata = source.metadata();
+    const bool linked = in_file_of(metadata, *this);
+    DataArray da = createDataArray(name, source.type(), dtype, extent, compression, strings);
+
+    if (extent.size() > 0 && extent.nelms() > 0) {
+        const NDSize origin(extent.size(), 0);
+        if (dtype == DataType::String) {
+            std::vector<std::string> values(check::fits_in_size_t(extent.nelms(), "Cannot allocate storage (exceeds memory)"));
+            source.getDataDirect(dtype, values.data(), extent, origin);
+            da.setDataDirect(dtype, values.data(), extent, origin);
+        } else {
+            // the raw data, in chunk aligned and prefetched steps; the writes
+            // go through the executor too, so HDF5 is only entered from the I/O thread
+            ChunkIterator it(source, 0, 1, dtype, false, true);
+            while (it.next()) {
+                IOExecutor::instance().submit([&da, &it, dtype]() {
+                    da.setDataDirect(dtype, it.data(), it.count(), it.offset());
+                }).get();
+            }
+        }
+    }
+
+    if (source.label()) {
+        da.label(*source.label());
+    }
+    if (source.unit()) {
+        da.unit(*source.unit());
+    }
+    if (source.polynomCoefficients().size()) {
+        da.polynomCoefficients(source.polynomCoefficients());
+    }
+    if (source.expansionOrigin()) {
+        da.expansionOrigin(*source.expansionOrigin());
+    }
+    for (const Dimension &dim : source.dimensions()) {
+        append_dimension(da, dim);
+    }
+    if (linked) {
+        da.metadata(metadata);
+    }
+    return da;
 }
 
 std::vector<DataArray> Block::dataArrays(const util::AcceptAll<DataArray>::type &filter) const {
@@ -77,6 +411,70 @@ std::vector<Tag> Block::tags(const util::Filter<Tag>::type &filter) const {
     return getEntities<Tag>(f, tagCount(), filter);
 }
 
+IntervalIndex Block::tagIntervalIndex(size_t dim, const std::string &unit) const {
+    struct Entry {
+        ndsize_t    id;
+        std::string name;
+        std::string unit;
+        double      position;
+        double      extent;
+    };
+
+    const ndsize_t count = tagCount();
+    std::vector<Entry> entries;
+    auto has_unit = [](const std::string &u) { return !u.empty() && u != "none"; };
+
+    for (ndsize_t i = 0; i < count; i++) {
+        Tag tag = getTag(i);
+        std::vector<double> position = tag.position();
+        if (dim >= position.size()) {
+            continue;
+        }
+        std::vector<double> extent = tag.extent();
+        std::vector<std::string> units = tag.units();
+        entries.push_back(Entry {i, tag.name(), dim < units.size() ? units[dim] : "",
+                                 position[dim], dim < extent.size() ? extent[dim] : 0.0});
+    }
+
+    // without a unit the first tag with one sets it, so that the others are scaled
+    std::string index_unit = util::unitSanitizer(unit);
+    if (index_unit.empty()) {
+        auto first = std::find_if(entries.begin(), entries.end(),
+                                  [&](const Entry &e) { return has_unit(e.unit); });
+        if (first != entries.end()) {
+            index_unit = util::unitSanitizer(first->unit);
+        }
+    }
+
+    std::vector<double> starts, extents;
+    std::vector<ndsize_t> ids;
+    for (const Entry &e : entries) {
+        double scaling = 1.0;
+        if (has_unit(index_unit) && has_unit(e.unit) && e.unit != index_unit) {
+            try {
+                scaling = util::getSIScaling(e.unit, index_unit);
+            } catch (...) {
+                throw IncompatibleDimensions("Unit " + e.unit + " of tag " + e.name +
+                                             " cannot be scaled to " + index_unit,
+                                             "Block::tagIntervalIndex");
+            }
+        }
+        starts.push_back(e.position * scaling);
+        extents.push_back(e.extent * scaling);
+        ids.push_back(e.id);
+    }
+
+    return IntervalIndex(starts, extents, index_unit, ids);
+}
+
+std::vector<Tag> Block::tagsOverlapping(double start, double end, size_t dim, const std::string &unit) const {
+    std::vector<Tag> result;
+    for (ndsize_t i : tagIntervalIndex(dim, unit).overlapping(start, end)) {
+        result.push_back(getTag(i));
+    }
+    return result;
+}
+
 MultiTag Block::createMultiTag(const std::string &name, const std::string &type, const DataArray &positions) {
     util::checkEntityNameAndType(name, type);
     util::checkEntityInput(positions);
@@ -0,0 +1,174 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/ChunkIterator.hpp>
+#include <nix/IOExecutor.hpp>
+
+#include <nix/Exception.hpp>
+
+#include <algorithm>
+
+namespace nix {
+
+// block size used if the data is not chunked
+static const size_t unchunked_block_bytes = 1024 * 1024;
+
+
+ChunkIterator::ChunkIterator(const DataArray &da, size_t axis, size_t blocks, DataType dtype, bool calibrate,
+                             bool prefetch)
+    : array(da), dtype(dtype), calibrate(calibrate), prefetch(prefetch), axis(axis), blocks(blocks) {
+    const NDSize shape = da.dataExtent();
+    init(NDSize(shape.size(), 0), shape);
+}
+
+
+ChunkIterator::ChunkIterator(const DataView &view, size_t axis, size_t blocks, DataType dtype, bool calibrate,
+                             bool prefetch)
+    : array(view.array), dtype(dtype), calibrate(calibrate), prefetch(prefetch), axis(axis), blocks(blocks) {
+    init(view.offset, view.count);
+}
+
+
+void ChunkIterator::init(const NDSize &region_offset, const NDSize &region_count) {
+    origin = region_offset;
+    extent = region_count;
+    started = false;
+    current = Step();
+    ahead = current;
+
+    if (axis >= extent.size()) {
+        throw InvalidRank("axis is out of bounds");
+    }
+
+    if (blocks == 0) {
+        throw std::invalid_argument("ChunkIterator: blocks must be at least 1");
+    }
+
+    if (dtype == DataType::Nothing) {
+        const bool calibrated = array.polynomCoefficients().size() || array.expansionOrigin();
+        dtype = calibrate && calibrated ? DataType::Double : array.dataType();
+    }
+
+    if (dtype == DataType::String || dtype == DataType::Nothing) {
+        throw std::invalid_argument("ChunkIterator: unsupported data type");
+    }
+
+    NDSize chunks = array.dataChunks();
+    if (chunks.size() == extent.size() && chunks[axis] > 0) {
+        step_len = chunks[axis] * blocks;
+    } else {
+        ndsize_t row_bytes = data_type_to_size(dtype);
+        for (size_t i = 0; i < extent.size(); i++) {
+            if (i != axis) {
+                row_bytes *= std::max<ndsize_t>(extent[i], 1);
+            }
+        }
+        step_len = std::max<ndsize_t>(unchunked_block_bytes / row_bytes, 1) * blocks;
+    }
+
+    // steps are aligned to the chunk grid of the array, not to the region
+    first_step = origin[axis] / step_len;
+    if (extent.nelms() == 0) {
+        nsteps = 0;
+    } else {
+        nsteps = (origin[axis] + extent[axis] - 1) / step_len - first_step + 1;
+    }
+}
+
+
+ChunkIterator::Step ChunkIterator::fetch(ndsize_t index, std::shared_ptr<std::vector<char>> buffer) const {
+    const ndsize_t start = std::max(origin[axis], (first_step + index) * step_len);
+    const ndsize_t end = std::min(origin[axis] + extent[axis], (first_step + index + 1) * step_len);
+
+    Step step;
+    step.index = index;
+    step.offset = NDSize(extent.size(), 0);
+    step.offset[axis] = start - origin[axis];
+    step.count = extent;
+    step.count[axis] = end - start;
+
+    const size_t nbytes = check::fits_in_size_t(step.count.nelms() * data_type_to_size(dtype),
+                                                "ChunkIterator: step exceeds memory");
+    step.buffer = buffer ? buffer : std::make_shared<std::vector<char>>();
+    step.buffer->resize(nbytes);
+
+    const DataArray da = array;
+    const DataType type = dtype;
+    const bool raw = !calibrate;
+    const NDSize count = step.count;
+    const NDSize offset = origin + step.offset;
+    std::shared_ptr<std::vector<char>> data = step.buffer;
+    auto read = [da, type, raw, data, count, offset]() {
+        if (raw) {
+            da.getDataDirect(type, data->data(), count, offset);
+        } else {
+            da.getData(type, data->data(), count, offset);
+        }
+    };
+
+    if (prefetch) {
+        step.ready = IOExecutor::instance().submit(read).share();
+    } else {
+        read();
+    }
+    return step;
+}
+
+
+bool ChunkIterator::next() {
+    if (!prefetch) {
+        const ndsize_t index = started ? current.index + 1 : 0;
+        started = true;
+        if (index >= nsteps) {
+            return false;
+        }
+        current = fetch(index, current.buffer);
+        return true;
+    }
+
+    std::shared_ptr<std::vector<char>> spare;
+
+    if (!started) {
+        started = true;
+        if (nsteps == 0) {
+            return false;
+        }
+        current = fetch(0, nullptr);
+    } else if (ahead.buffer) {
+        // the buffer of the finished step takes the step after the next one
+        spare = current.buffer;
+        current = ahead;
+        ahead = Step();
+    } else {
+        return false;
+    }
+
+    if (current.index + 1 < nsteps) {
+        ahead = fetch(current.index + 1, spare);
+    }
+    current.ready.get();
+    return true;
+}
+
+
+ChunkIterator::~ChunkIterator() {
+    // the prefetch owns its buffer, but must not outlive the file
+    if (ahead.ready.valid()) {
+        ahead.ready.wait();
+    }
+}
+
+
+const void *ChunkIterator::data() const {
+    if (!current.buffer) {
+        throw std::runtime_error("ChunkIterator: no current step, call next() first");
+    }
+    return current.buffer->data();
+}
+
+} // namespace nix
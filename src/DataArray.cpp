@@ -7,10 +7,20 @@
 // LICENSE file in the root of the Project.
 
 #include <nix/DataArray.hpp>
+#include <nix/Arena.hpp>
+#include <nix/IOExecutor.hpp>
 
 #include "hdf5/h5x/H5DataType.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <cstring>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <thread>
 
 using namespace nix;
 
@@ -24,15 +34,18 @@ static void convertData(DataType source, DataType destination, void *data, size_
 }
 
 
-void DataArray::ioRead(DataType dtype, void *data, const NDSize &count, const NDSize &offset) const {
-    const std::vector<double> poly = polynomCoefficients();
-    boost::optional<double> opt_origin = expansionOrigin();
+// read with read_direct and apply the polynomial and origin of the DataArray
+static void read_calibrated(const DataArray &da, DataType dtype, void *data, const NDSize &count,
+                            const std::function<void(DataType, void *)> &read_direct)
+{
+    const std::vector<double> poly = da.polynomCoefficients();
+    boost::optional<double> opt_origin = da.expansionOrigin();
 
     if (poly.size() || opt_origin) {
         size_t data_esize = data_type_to_size(dtype);
         size_t nelms = check::fits_in_size_t(count.nelms(),
 			"Cannot apply polynom or origin transform. Buffer needed exceeds memory.");
-        std::vector<double> tmp;
+        ScratchBuffer<double> tmp;
         double *read_buffer;
 
         if (data_esize < sizeof(double)) {
@@ -43,7 +56,7 @@ void DataArray::ioRead(DataType dtype, void *data, const NDSize &count, const ND
             read_buffer = reinterpret_cast<double *>(data);
         }
 
-        getDataDirect(DataType::Double, read_buffer, count, offset);
+        read_direct(DataType::Double, read_buffer);
         const double origin = opt_origin ? *opt_origin : 0.0;
 
         util::applyPolynomial(poly, origin, read_buffer, read_buffer, nelms);
@@ -54,12 +67,73 @@ void DataArray::ioRead(DataType dtype, void *data, const NDSize &count, const ND
         }
 
     } else {
-        getDataDirect(dtype, data, count, offset);
+        read_direct(dtype, data);
     }
 }
 
+
+void DataArray::ioRead(DataType dtype, void *data, const NDSize &count, const NDSize &offset) const {
+    read_calibrated(*this, dtype, data, count, [&](DataType read_type, void *buffer) {
+        getDataDirect(read_type, buffer, count, offset);
+    });
+}
+
+
+void DataArray::ioRead(DataType dtype, void *data, const Selection &selection) const {
+    read_calibrated(*this, dtype, data, selection.shape(dataExtent()), [&](DataType read_type, void *buffer) {
+        backend()->read(read_type, buffer, selection);
+    });
+}
+
+
+void DataArray::getDataParallel(DataType dtype, void *data, const NDSize &count, const NDSize &offset,
+                                size_t nthreads) const {
+    read_calibrated(*this, dtype, data, count, [&](DataType read_type, void *buffer) {
+        backend()->readParallel(read_type, buffer, count, offset, nthreads);
+    });
+}
+
 void DataArray::ioWrite(DataType dtype, const void *data, const NDSize &count, const NDSize &offset) {
     setDataDirect(dtype, data, count, offset);
+
+    if (count.size() == 1 && hasEnvelopes()) {
+        const ndsize_t begin = offset ? offset[0] : 0;
+        updateEnvelopes(begin, begin + count[0]);
+    }
+}
+
+void DataArray::setDataParallel(DataType dtype, const void *data, const NDSize &count, const NDSize &offset,
+                                size_t nthreads) {
+    backend()->writeParallel(dtype, data, count, offset, nthreads);
+
+    if (count.size() == 1 && hasEnvelopes()) {
+        const ndsize_t begin = offset ? offset[0] : 0;
+        updateEnvelopes(begin, begin + count[0]);
+    }
+}
+
+void DataArray::stringCodes(std::vector<uint32_t> &codes, const NDSize &count, const NDSize &offset) const {
+    codes.resize(check::fits_in_size_t(count.nelms(), "Cannot allocate storage (exceeds memory)"));
+    backend()->readStringCodes(codes.data(), count, offset);
+}
+
+void DataArray::stringCodes(std::vector<uint32_t> &codes) const {
+    const NDSize extent = dataExtent();
+    stringCodes(codes, extent, NDSize(extent.size(), 0));
+}
+
+void DataArray::dataExtent(const NDSize &extent) {
+    if (!hasEnvelopes()) {
+        backend()->dataExtent(extent);
+        return;
+    }
+
+    const NDSize old_extent = dataExtent();
+    backend()->dataExtent(extent);
+
+    if (extent.size() == 1 && old_extent.size() == 1) {
+        updateEnvelopes(std::min(old_extent[0], extent[0]), extent[0]);
+    }
 }
 
 void DataArray::appendData(DataType dtype, const void *data, const NDSize &count, size_t axis) {
@@ -90,13 +164,565 @@ void DataArray::appendData(DataType dtype, const void *data, const NDSize &count
     offset[axis] = extent[axis];
     extent[axis] += count[axis];
 
-    //enlarge the DataArray to fit the new data
-    dataExtent(extent);
+    //enlarge the DataArray to fit the new data; envelopes are updated by setData
+    backend()->dataExtent(extent);
 
     setData(dtype, data, count, offset);
 
 }
 
+std::future<void> DataArray::getDataAsync(DataType dtype, void *data, const NDSize &count, const NDSize &offset) const {
+    const DataArray da = *this;
+    return IOExecutor::instance().submit([da, dtype, data, count, offset]() {
+        da.getData(dtype, data, count, offset);
+    });
+}
+
+std::future<void> DataArray::setDataAsync(DataType dtype, const void *data, const NDSize &count, const NDSize &offset) {
+    DataArray da = *this;
+    return IOExecutor::instance().submit([da, dtype, data, count, offset]() mutable {
+        da.setData(dtype, data, count, offset);
+    });
+}
+
+// the maximum number of samples or entries held in memory while computing envelopes
+static const ndsize_t envelope_batch = 1 << 20;
+
+void DataArray::createEnvelopes(ndsize_t factor) {
+    if (factor < 2) {
+        throw std::invalid_argument("createEnvelopes: factor must be at least 2");
+    }
+
+    const NDSize extent = dataExtent();
+    if (extent.size() != 1) {
+        throw IncompatibleDimensions("Envelopes are only supported for 1-d data", "createEnvelopes");
+    }
+
+    if (!data_type_is_numeric(dataType())) {
+        throw std::invalid_argument("createEnvelopes: data must be numeric");
+    }
+
+    backend()->envelopeFactor(factor);
+    updateEnvelopes(0, extent[0]);
+}
+
+
+void DataArray::refreshEnvelopes() {
+    const ndsize_t factor = backend()->envelopeFactor();
+    if (factor > 0) {
+        createEnvelopes(factor);
+    }
+}
+
+
+void DataArray::updateEnvelopes(ndsize_t begin, ndsize_t end) {
+    const ndsize_t factor = backend()->envelopeFactor();
+    const ndsize_t total = dataExtent()[0];
+    const ndsize_t batch = std::max<ndsize_t>(envelope_batch / factor, 1);
+
+    ndsize_t n = total;   // number of entries of the level below
+    ndsize_t span = 1;    // number of samples per entry of the level below
+    size_t level = 1;
+
+    for (; n > 1; level++) {
+        const ndsize_t n_level = (n + factor - 1) / factor;
+        const ndsize_t b0 = std::min(begin, n) / factor;
+        const ndsize_t b1 = std::min((std::min(end, n) + factor - 1) / factor, n_level);
+
+        backend()->envelopeSize(level, n_level);
+
+        for (ndsize_t b = b0; b < b1; b += batch) {
+            const size_t nblocks = static_cast<size_t>(std::min(batch, b1 - b));
+            const ndsize_t src_offset = b * factor;
+            const size_t nsrc = static_cast<size_t>(std::min(nblocks * factor, n - src_offset));
+
+            ScratchBuffer<double> src(level == 1 ? nsrc : 3 * nsrc);
+            if (level == 1) {
+                ioRead(DataType::Double, src.data(), {nsrc}, {src_offset});
+            } else {
+                backend()->readEnvelope(level - 1, src.data(), nsrc, src_offset);
+            }
+
+            ScratchBuffer<double> out(3 * nblocks);
+            for (size_t k = 0; k < nblocks; k++) {
+                double vmin = std::numeric_limits<double>::infinity();
+                double vmax = -vmin;
+                double sum = 0.0, weight = 0.0;
+
+                const size_t j_end = std::min<size_t>((k + 1) * factor, nsrc);
+                for (size_t j = k * factor; j < j_end; j++) {
+                    if (level == 1) {
+                        vmin = std::min(vmin, src[j]);
+                        vmax = std::max(vmax, src[j]);
+                        sum += src[j];
+                        weight += 1.0;
+                    } else {
+                        // the last entry of a level may cover less samples
+                        const double w = static_cast<double>(std::min(span, total - (src_offset + j) * span));
+                        vmin = std::min(vmin, src[3 * j]);
+                        vmax = std::max(vmax, src[3 * j + 1]);
+                        sum += src[3 * j + 2] * w;
+                        weight += w;
+                    }
+                }
+
+                out[3 * k] = vmin;
+                out[3 * k + 1] = vmax;
+                out[3 * k + 2] = sum / weight;
+            }
+
+            backend()->writeEnvelope(level, out.data(), nblocks, b);
+        }
+
+        begin = b0;
+        end = b1;
+        n = n_level;
+        span *= factor;
+    }
+
+    // remove levels that are no longer needed, e.g. after shrinking
+    while (backend()->envelopeSize(level) > 0) {
+        backend()->envelopeSize(level++, 0);
+    }
+}
+
+
+Envelope DataArray::envelopeAt(ndsize_t offset, ndsize_t count, size_t points) const {
+    const NDSize extent = dataExtent();
+    if (extent.size() != 1) {
+        throw IncompatibleDimensions("Envelopes are only supported for 1-d data", "envelopeAt");
+    }
+
+    const ndsize_t total = extent[0];
+    if (offset + count > total) {
+        throw OutOfBounds("Trying to access data outside of range", 0);
+    }
+
+    Envelope env;
+    env.stride = 0;
+    if (count == 0 || points == 0) {
+        return env;
+    }
+
+    // pick the coarsest level that still has enough entries
+    const ndsize_t factor = backend()->envelopeFactor();
+    size_t level = 0;
+    ndsize_t span = 1;
+    while (factor > 0 && backend()->envelopeSize(level + 1) > 0 && count / (span * factor) >= points) {
+        level++;
+        span *= factor;
+    }
+
+    // align the bins to multiples of the stride, so that they do not change when panning
+    const ndsize_t n_level = level > 0 ? backend()->envelopeSize(level) : total;
+    ndsize_t e1 = (offset + count + span - 1) / span;
+    ndsize_t per_bin = (e1 - offset / span + points - 1) / points;
+    ndsize_t e0 = offset / span / per_bin * per_bin;
+    while ((e1 - e0 + per_bin - 1) / per_bin > points) {
+        per_bin++;
+        e0 = offset / span / per_bin * per_bin;
+    }
+    e1 = std::min((e1 + per_bin - 1) / per_bin * per_bin, n_level);
+
+    const ndsize_t batch = std::max<ndsize_t>(envelope_batch / per_bin, 1) * per_bin;
+    env.stride = per_bin * span;
+
+    std::function<double(ndsize_t)> position = [](ndsize_t index) { return static_cast<double>(index); };
+    if (dimensionCount() > 0) {
+        Dimension dim = getDimension(1);
+        if (dim.dimensionType() == DimensionType::Sample) {
+            SampledDimension sd = dim.asSampledDimension();
+            position = [sd](ndsize_t index) { return sd.positionAt(index); };
+        } else if (dim.dimensionType() == DimensionType::Range) {
+            RangeDimension rd = dim.asRangeDimension();
+            position = [rd](ndsize_t index) { return rd.tickAt(index); };
+        }
+    }
+
+    for (ndsize_t e = e0; e < e1; e += batch) {
+        const size_t nentries = static_cast<size_t>(std::min(batch, e1 - e));
+
+        ScratchBuffer<double> src(level == 0 ? nentries : 3 * nentries);
+        if (level == 0) {
+            ioRead(DataType::Double, src.data(), {nentries}, {e});
+        } else {
+            backend()->readEnvelope(level, src.data(), nentries, e);
+        }
+
+        for (size_t k = 0; k < nentries; k += per_bin) {
+            double vmin = std::numeric_limits<double>::infinity();
+            double vmax = -vmin;
+            double sum = 0.0, weight = 0.0;
+
+            const size_t j_end = std::min<size_t>(k + per_bin, nentries);
+            for (size_t j = k; j < j_end; j++) {
+                if (level == 0) {
+                    vmin = std::min(vmin, src[j]);
+                    vmax = std::max(vmax, src[j]);
+                    sum += src[j];
+                    weight += 1.0;
+                } else {
+                    const double w = static_cast<double>(std::min(span, total - (e + j) * span));
+                    vmin = std::min(vmin, src[3 * j]);
+                    vmax = std::max(vmax, src[3 * j + 1]);
+                    sum += src[3 * j + 2] * w;
+                    weight += w;
+                }
+            }
+
+            env.position.push_back(position(std::max(offset, (e + k) * span)));
+            env.min.push_back(vmin);
+            env.max.push_back(vmax);
+            env.mean.push_back(sum / weight);
+        }
+    }
+
+    return env;
+}
+
+
+Envelope DataArray::envelope(double start, double end, size_t points) const {
+    std::pair<ndsize_t, ndsize_t> range;
+    DimensionType dtype = dimensionCount() > 0 ? getDimension(1).dimensionType() : DimensionType::Set;
+
+    if (dtype == DimensionType::Sample) {
+        range = getDimension(1).asSampledDimension().indexOf(start, end);
+    } else if (dtype == DimensionType::Range) {
+        range = getDimension(1).asRangeDimension().indexOf(start, end);
+    } else {
+        range.first = static_cast<ndsize_t>(std::max(std::ceil(start), 0.0));
+        range.second = static_cast<ndsize_t>(std::max(std::floor(end), 0.0));
+    }
+
+    const NDSize extent = dataExtent();
+    if (extent.size() != 1) {
+        throw IncompatibleDimensions("Envelopes are only supported for 1-d data", "envelope");
+    }
+
+    const ndsize_t last = std::min(range.second, extent[0] - 1);
+    if (extent[0] == 0 || range.first > last) {
+        return envelopeAt(0, 0, points);
+    }
+
+    return envelopeAt(range.first, last - range.first + 1, points);
+}
+
+
+// the number of elements per tile when computing statistics
+static const ndsize_t statistics_tile = 1 << 20;
+
+namespace {
+
+// running sum, mean, squared deviation, min and max of a block of elements
+struct Moments {
+    ndsize_t            n;
+    std::vector<double> sum;
+    std::vector<double> mean;
+    std::vector<double> m2;
+    std::vector<double> min;
+    std::vector<double> max;
+
+    explicit Moments(size_t size = 0)
+        : n(0), sum(size, 0.0), mean(size, 0.0), m2(size, 0.0),
+          min(size, std::numeric_limits<double>::infinity()),
+          max(size, -std::numeric_limits<double>::infinity()) { }
+
+    // pairwise update of Chan et al., exact for mean and min/max
+    void merge(const Moments &other) {
+        if (other.n == 0) {
+            return;
+        } else if (n == 0) {
+            *this = other;
+            return;
+        }
+
+        const double na = static_cast<double>(n);
+        const double nb = static_cast<double>(other.n);
+        const double nab = na + nb;
+
+        for (size_t i = 0; i < sum.size(); i++) {
+            const double delta = other.mean[i] - mean[i];
+            mean[i] += delta * nb / nab;
+            m2[i] += other.m2[i] + delta * delta * na * nb / nab;
+            sum[i] += other.sum[i];
+            min[i] = std::min(min[i], other.min[i]);
+            max[i] = std::max(max[i], other.max[i]);
+        }
+
+        n += other.n;
+    }
+};
+
+// reduce a row-major (outer, len, inner) block along its middle dimension
+void reduce_tile(const double *data, size_t outer, size_t len, size_t inner, Moments &res) {
+    res = Moments(outer * inner);
+    res.n = len;
+
+    for (size_t o = 0; o < outer; o++) {
+        const double *block = data + o * len * inner;
+        double *sum = &res.sum[o * inner];
+        double *mean = &res.mean[o * inner];
+        double *m2 = &res.m2[o * inner];
+        double *vmin = &res.min[o * inner];
+        double *vmax = &res.max[o * inner];
+
+        if (inner == 1) {
+            // four independent lanes, so that the compiler can vectorize
+            double s[4] = {0.0, 0.0, 0.0, 0.0};
+            double lo[4] = {vmin[0], vmin[0], vmin[0], vmin[0]};
+            double hi[4] = {vmax[0], vmax[0], vmax[0], vmax[0]};
+            size_t a = 0;
+            for (; a + 4 <= len; a += 4) {
+                for (size_t k = 0; k < 4; k++) {
+                    const double x = block[a + k];
+                    s[k] += x;
+                    lo[k] = x < lo[k] ? x : lo[k];
+                    hi[k] = x > hi[k] ? x : hi[k];
+                }
+            }
+            for (; a < len; a++) {
+                const double x = block[a];
+                s[0] += x;
+                lo[0] = x < lo[0] ? x : lo[0];
+                hi[0] = x > hi[0] ? x : hi[0];
+            }
+
+            sum[0] = (s[0] + s[1]) + (s[2] + s[3]);
+            vmin[0] = std::min(std::min(lo[0], lo[1]), std::min(lo[2], lo[3]));
+            vmax[0] = std::max(std::max(hi[0], hi[1]), std::max(hi[2], hi[3]));
+            mean[0] = sum[0] / len;
+
+            double q[4] = {0.0, 0.0, 0.0, 0.0};
+            for (a = 0; a + 4 <= len; a += 4) {
+                for (size_t k = 0; k < 4; k++) {
+                    const double d = block[a + k] - mean[0];
+                    q[k] += d * d;
+                }
+            }
+            for (; a < len; a++) {
+                const double d = block[a] - mean[0];
+                q[0] += d * d;
+            }
+            m2[0] = (q[0] + q[1]) + (q[2] + q[3]);
+
+        } else {
+            for (size_t a = 0; a < len; a++) {
+                const double *row = block + a * inner;
+                for (size_t i = 0; i < inner; i++) {
+                    const double x = row[i];
+                    sum[i] += x;
+                    vmin[i] = x < vmin[i] ? x : vmin[i];
+                    vmax[i] = x > vmax[i] ? x : vmax[i];
+                }
+            }
+
+            for (size_t i = 0; i < inner; i++) {
+                mean[i] = sum[i] / len;
+            }
+
+            for (size_t a = 0; a < len; a++) {
+                const double *row = block + a * inner;
+                for (size_t i = 0; i < inner; i++) {
+                    const double d = row[i] - mean[i];
+                    m2[i] += d * d;
+                }
+            }
+        }
+    }
+}
+
+} // anonymous namespace
+
+
+Statistics DataArray::statistics(size_t axis, size_t nthreads) const {
+    const NDSize extent = dataExtent();
+    const size_t rank = extent.size();
+
+    if (axis >= rank) {
+        throw InvalidRank("axis is out of bounds");
+    }
+
+    if (!data_type_is_numeric(dataType())) {
+        throw std::invalid_argument("statistics: data must be numeric");
+    }
+
+    Statistics stats;
+    stats.shape = NDSize(rank - 1);
+    for (size_t d = 0, k = 0; d < rank; d++) {
+        if (d != axis) {
+            stats.shape[k++] = extent[d];
+        }
+    }
+    stats.count = extent[axis];
+
+    const size_t out_size = check::fits_in_size_t(stats.shape.nelms(), "statistics: result exceeds memory");
+    if (extent.nelms() == 0) {
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        stats.sum.assign(out_size, 0.0);
+        stats.mean.assign(out_size, nan);
+        stats.variance.assign(out_size, nan);
+        stats.min.assign(out_size, nan);
+        stats.max.assign(out_size, nan);
+        return stats;
+    }
+
+    // tiles are chunk aligned, combining chunks along the axis
+    NDSize tile = dataChunks();
+    if (tile.size() == rank) {
+        const ndsize_t k = std::max<ndsize_t>(statistics_tile / tile.nelms(), 1);
+        tile[axis] *= k;
+    } else {
+        tile = extent;
+        for (size_t d = 0; d < rank && tile.nelms() > statistics_tile; d++) {
+            const ndsize_t rest = tile.nelms() / tile[d];
+            tile[d] = std::max<ndsize_t>(statistics_tile / rest, 1);
+        }
+    }
+
+    NDSize grid(rank);
+    size_t ncolumns = 1;
+    for (size_t d = 0; d < rank; d++) {
+        tile[d] = std::min(tile[d], extent[d]);
+        grid[d] = (extent[d] + tile[d] - 1) / tile[d];
+        if (d != axis) {
+            ncolumns *= static_cast<size_t>(grid[d]);
+        }
+    }
+
+    // every column of tiles along the axis is split into nranges work items
+    if (nthreads == 0) {
+        nthreads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    if (IOExecutor::instance().onIOThread()) {
+        // other threads could not get their reads run while this one waits for them
+        nthreads = 1;
+    }
+    const size_t ntiles = static_cast<size_t>(grid[axis]);
+    const size_t nranges = std::min(std::max<size_t>((nthreads + ncolumns - 1) / ncolumns, 1), ntiles);
+    const size_t nitems = ncolumns * nranges;
+
+    auto column_region = [&](size_t column, NDSize &offset, NDSize &count) {
+        offset = NDSize(rank, 0);
+        count = NDSize(rank, 0);
+        for (size_t d = rank; d-- > 0; ) {
+            if (d == axis) {
+                continue;
+            }
+            offset[d] = (column % grid[d]) * tile[d];
+            count[d] = std::min(tile[d], extent[d] - offset[d]);
+            column /= static_cast<size_t>(grid[d]);
+        }
+    };
+
+    std::vector<Moments> partials(nitems);
+    std::atomic<size_t> next_item(0);
+    std::exception_ptr error;
+    std::mutex error_mtx;
+    const DataArray da = *this;
+
+    auto worker = [&]() {
+        std::vector<double> buffer;
+
+        for (size_t item = next_item++; item < nitems; item = next_item++) {
+            try {
+                const size_t range = item % nranges;
+                NDSize offset, count;
+                column_region(item / nranges, offset, count);
+
+                for (size_t t = range * ntiles / nranges; t < (range + 1) * ntiles / nranges; t++) {
+                    offset[axis] = t * tile[axis];
+                    count[axis] = std::min(tile[axis], extent[axis] - offset[axis]);
+                    buffer.resize(static_cast<size_t>(count.nelms()));
+
+                    // HDF5 is only entered from the I/O thread
+                    double *data = buffer.data();
+                    IOExecutor::instance().submit([da, data, count, offset]() {
+                        da.getData(DataType::Double, data, count, offset);
+                    }).get();
+
+                    size_t outer = 1, inner = 1;
+                    for (size_t d = 0; d < rank; d++) {
+                        if (d < axis) {
+                            outer *= static_cast<size_t>(count[d]);
+                        } else if (d > axis) {
+                            inner *= static_cast<size_t>(count[d]);
+                        }
+                    }
+
+                    Moments m;
+                    reduce_tile(data, outer, static_cast<size_t>(count[axis]), inner, m);
+                    partials[item].merge(m);
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mtx);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                next_item = nitems;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < std::min(nthreads, nitems); i++) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+
+    stats.sum.resize(out_size);
+    stats.mean.resize(out_size);
+    stats.variance.resize(out_size);
+    stats.min.resize(out_size);
+    stats.max.resize(out_size);
+
+    for (size_t column = 0; column < ncolumns; column++) {
+        Moments &col = partials[column * nranges];
+        for (size_t r = 1; r < nranges; r++) {
+            col.merge(partials[column * nranges + r]);
+        }
+
+        for (double &v : col.m2) {
+            v /= static_cast<double>(col.n);
+        }
+
+        NDSize offset, count;
+        column_region(column, offset, count);
+
+        if (rank == 1) {
+            stats.sum = col.sum;
+            stats.mean = col.mean;
+            stats.variance = col.m2;
+            stats.min = col.min;
+            stats.max = col.max;
+            continue;
+        }
+
+        NDSize col_shape(rank - 1), out_offset(rank - 1), zeros(rank - 1, 0);
+        for (size_t d = 0, k = 0; d < rank; d++) {
+            if (d != axis) {
+                col_shape[k] = count[d];
+                out_offset[k++] = offset[d];
+            }
+        }
+
+        util::copyRegion(col.sum.data(), col_shape, zeros, stats.sum.data(), stats.shape, out_offset, col_shape, sizeof(double));
+        util::copyRegion(col.mean.data(), col_shape, zeros, stats.mean.data(), stats.shape, out_offset, col_shape, sizeof(double));
+        util::copyRegion(col.m2.data(), col_shape, zeros, stats.variance.data(), stats.shape, out_offset, col_shape, sizeof(double));
+        util::copyRegion(col.min.data(), col_shape, zeros, stats.min.data(), stats.shape, out_offset, col_shape, sizeof(double));
+        util::copyRegion(col.max.data(), col_shape, zeros, stats.max.data(), stats.shape, out_offset, col_shape, sizeof(double));
+    }
+
+    return stats;
+}
+
+
 void DataArray::unit(const std::string &unit) {
     std::string dblnk_unit = util::deblankString(unit);
     util::checkEmptyString(dblnk_unit, "unit");
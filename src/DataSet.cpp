@@ -0,0 +1,28 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/DataSet.hpp>
+
+#include <string>
+
+namespace nix {
+
+void DataSet::ioRead(DataType dtype, void *data, const Selection &selection) const {
+    const NDSize extent = dataExtent();
+    const size_t esize = dtype == DataType::String ? sizeof(std::string) : data_type_to_size(dtype);
+    char *ptr = static_cast<char *>(data);
+
+    for (const Selection::Run &run : selection.runs(extent)) {
+        NDSize count(extent.size(), 1);
+        count[count.size() - 1] = run.length;
+        ioRead(dtype, ptr, count, run.offset);
+        ptr += run.length * esize;
+    }
+}
+
+} // namespace nix
@@ -49,6 +49,10 @@ void DataView::ioRead(DataType dtype, void *data, const NDSize &count, const NDS
     array.getData(dtype, data, real_count, base);
 }
 
+void DataView::ioRead(DataType dtype, void *data, const Selection &selection) const {
+    array.getData(dtype, data, selection.within(count, offset));
+}
+
 void DataView::ioWrite(DataType dtype, const void *data, const NDSize &count, const NDSize &offset) {
 
     const NDSize &real_count =  count ? count : this->count;
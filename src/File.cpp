@@ -9,6 +9,7 @@
 #include <nix/File.hpp>
 #include <nix/util/util.hpp>
 #include "hdf5/FileHDF5.hpp"
+#include "memory/FileMemory.hpp"
 
 #ifdef ENABLE_FS_BACKEND
 #include "fs/FileFS.hpp"
@@ -17,12 +18,17 @@
 #include <nix/valid/validate.hpp>
 #include <boost/filesystem.hpp>
 
+#include <atomic>
+#include <future>
+#include <thread>
+#include <unordered_set>
+
 namespace bfs = boost::filesystem;
 
 namespace nix {
 
 File File::open(const std::string &name, FileMode mode, const std::string &impl, Compression compression) {
-    if (mode == nix::FileMode::ReadOnly && !bfs::exists({name})) {
+    if ((mode == nix::FileMode::ReadOnly || mode == nix::FileMode::SwmrRead) && !bfs::exists(bfs::path{name})) {
         throw std::runtime_error("Cannot open non-existent file in ReadOnly mode!");
     }
     if (compression == Compression::Auto) {
@@ -31,8 +37,14 @@ File File::open(const std::string &name, FileMode mode, const std::string &impl,
     if (impl == "hdf5") {
          return File(std::make_shared<hdf5::FileHDF5>(name, mode, compression));
     }
+    else if (impl == "memory") {
+         return File(memory::FileMemory::open(name, mode, compression));
+    }
 #ifdef  ENABLE_FS_BACKEND
     else if (impl == "file") {
+         if (mode == FileMode::SwmrWrite || mode == FileMode::SwmrRead) {
+             throw std::runtime_error("SWMR is only supported by the hdf5 backend!");
+         }
          return File(std::make_shared<file::FileFS>(name, mode, compression));
     }
 #endif
@@ -42,6 +54,50 @@ File File::open(const std::string &name, FileMode mode, const std::string &impl,
 }
 
 
+
+File File::openFromBuffer(const void *data, size_t size, FileMode mode, Compression compression) {
+    if (data == nullptr || size == 0) {
+        throw std::invalid_argument("Cannot open a file from an empty buffer!");
+    }
+    if (compression == Compression::Auto) {
+         compression = Compression::None;
+    }
+    return File(hdf5::FileHDF5::openImage(data, size, mode, compression));
+}
+
+
+File File::createInMemory(const std::string &backing_store, Compression compression) {
+    if (compression == Compression::Auto) {
+         compression = Compression::None;
+    }
+    return File(hdf5::FileHDF5::createInMemory(backing_store, compression));
+}
+
+
+std::vector<char> File::toBuffer() const {
+    if (auto file = dynamic_cast<const hdf5::FileHDF5 *>(backend())) {
+        return file->image();
+    }
+    if (auto file = dynamic_cast<const memory::FileMemory *>(backend())) {
+        return file->image();
+    }
+    throw std::runtime_error("File::toBuffer: only files of the hdf5 and memory backends have an image");
+}
+
+
+void File::saveAs(const std::string &path) const {
+    if (auto file = dynamic_cast<const hdf5::FileHDF5 *>(backend())) {
+        file->saveImage(path);
+        return;
+    }
+    if (auto file = dynamic_cast<const memory::FileMemory *>(backend())) {
+        file->saveAs(path);
+        return;
+    }
+    throw std::runtime_error("File::saveAs: only files of the hdf5 and memory backends can be saved");
+}
+
+
 bool File::flush() {
     return backend()->flush();
 }
@@ -112,6 +168,11 @@ bool File::deleteSection(const Section &section) {
 
 
 std::vector<Section> File::findSections(const util::Filter<Section>::type &filter, size_t max_depth) const {
+    std::shared_ptr<const MetadataSnapshot> snapshot = metadataSnapshot();
+    if (snapshot) {
+        return snapshot->findSections(filter, max_depth);
+    }
+
     std::vector<Section> results;
     std::vector<Section> roots = sections();
     if (max_depth == 0) {
@@ -127,72 +188,215 @@ std::vector<Section> File::findSections(const util::Filter<Section>::type &filte
 }
 
 
-valid::Result File::validate() const {
+std::shared_ptr<const MetadataSnapshot> File::loadMetadata() {
+    backend()->metadataSnapshot(nullptr);
+
+    std::vector<Section> sections;
+    std::shared_ptr<MetadataSnapshot> snapshot(new MetadataSnapshot(*this, sections));
+    // links are resolved through findSections, which can already use
+    // the index of the attached snapshot
+    backend()->metadataSnapshot(snapshot);
+    try {
+        snapshot->loadLinks(sections);
+    } catch (...) {
+        backend()->metadataSnapshot(nullptr);
+        throw;
+    }
+    return snapshot;
+}
+
+
+// true if the entity changed at or after since; timestamps have a
+// resolution of one second, so equal times count as modified
+template<typename T>
+static bool is_modified(const T &entity, time_t since) {
+    return since == 0 || entity.updatedAt() >= since;
+}
+
+
+template<typename T>
+static valid::Message skip_msg(const T &entity) {
+    return valid::Message(entity.id(), "unchanged since last validation", entity.name());
+}
+
+
+static bool array_changed(const DataArray &da, const std::unordered_set<std::string> &changed) {
+    return da && changed.count(da.id()) > 0;
+}
+
+
+template<typename T>
+static bool tag_modified(const T &tag, time_t since, const std::unordered_set<std::string> &changed) {
+    if (is_modified(tag, since)) {
+        return true;
+    }
+
+    auto refs = tag.references();
+    for (const auto &ref : refs) {
+        if (array_changed(ref, changed)) {
+            return true;
+        }
+    }
+
+    auto features = tag.features();
+    for (const auto &feature : features) {
+        if (is_modified(feature, since) || array_changed(feature.data(), changed)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+static valid::Result validate_block(const Block &block, time_t since) {
+    valid::Result result;
+
+    if (is_modified(block, since)) {
+        result.concat(valid::validate(block));
+    } else {
+        result.addSkipped(skip_msg(block));
+    }
+
+    // DataArrays; Tags referencing a changed array must be revalidated
+    std::unordered_set<std::string> changed;
+    auto data_arrays = block.dataArrays();
+    for (auto &data_array : data_arrays) {
+        if (!is_modified(data_array, since)) {
+            result.addSkipped(skip_msg(data_array));
+            continue;
+        }
+        changed.insert(data_array.id());
+
+        result.concat(valid::validate(data_array));
+        // Dimensions
+        auto dims = data_array.dimensions();
+        for (auto &dim : dims) {
+            if (dim.dimensionType() == DimensionType::Range) {
+                auto d = dim.asRangeDimension();
+                result.concat(valid::validate(d));
+            }
+            if (dim.dimensionType() == DimensionType::Set) {
+                auto d = dim.asSetDimension();
+                result.concat(valid::validate(d));
+            }
+            if (dim.dimensionType() == DimensionType::Sample) {
+                auto d = dim.asSampledDimension();
+                result.concat(valid::validate(d));
+            }
+        }
+    }
+    // MultiTags
+    auto multi_tags = block.multiTags();
+    for (auto &multi_tag : multi_tags) {
+        if (!tag_modified(multi_tag, since, changed) &&
+            !array_changed(multi_tag.positions(), changed) &&
+            !array_changed(multi_tag.extents(), changed)) {
+            result.addSkipped(skip_msg(multi_tag));
+            continue;
+        }
+
+        result.concat(valid::validate(multi_tag));
+        // Features
+        auto features = multi_tag.features();
+        for (auto &feature : features) {
+            result.concat(valid::validate(feature));
+        }
+    }
+    // Tags
+    auto tags = block.tags();
+    for (auto &tag : tags) {
+        if (!tag_modified(tag, since, changed)) {
+            result.addSkipped(skip_msg(tag));
+            continue;
+        }
+
+        result.concat(valid::validate(tag));
+        // Features
+        auto features = tag.features();
+        for (auto &feature : features) {
+            result.concat(valid::validate(feature));
+        }
+    }
+    // Sources
+    auto sources = block.findSources();
+    for (auto &source : sources) {
+        if (is_modified(source, since)) {
+            result.concat(valid::validate(source));
+        } else {
+            result.addSkipped(skip_msg(source));
+        }
+    }
+
+    return result;
+}
+
+
+valid::Result File::validate(size_t nthreads) const {
+    return validateModified(0, nthreads);
+}
+
+
+valid::Result File::validateModified(time_t since, size_t nthreads) const {
     valid::Result result;
     // now get all entities from the file: use the multi-getter for each type of entity
     // (the multi-getters use size_t-getter which in the end use H5Lget_name_by_idx
     // to get each file objects name - the count is determined by H5::Group::getNumObjs
     // so that in the end really all file objects are retrieved)
 
-    // Blocks
+    // Blocks; only a thread-safe HDF5 library may be entered concurrently
     auto blcks = blocks();
-    for (auto &block : blcks) {
-        result.concat(valid::validate(block));
-        // DataArrays
-        auto data_arrays = block.dataArrays();
-        for (auto &data_array : data_arrays) {
-            result.concat(valid::validate(data_array));
-            // Dimensions
-            auto dims = data_array.dimensions();
-            for (auto &dim : dims) {
-                if (dim.dimensionType() == DimensionType::Range) {
-                    auto d = dim.asRangeDimension();
-                    result.concat(valid::validate(d));
-                }
-                if (dim.dimensionType() == DimensionType::Set) {
-                    auto d = dim.asSetDimension();
-                    result.concat(valid::validate(d));
-                }
-                if (dim.dimensionType() == DimensionType::Sample) {
-                    auto d = dim.asSampledDimension();
-                    result.concat(valid::validate(d));
-                }
+    hbool_t threadsafe = 0;
+    if (dynamic_cast<const hdf5::FileHDF5 *>(backend()) != nullptr) {
+        H5is_library_threadsafe(&threadsafe);
+    }
+
+    if (nthreads == 0) {
+        nthreads = std::thread::hardware_concurrency();
+    }
+
+    if (threadsafe && nthreads > 1 && blcks.size() > 1) {
+        std::vector<valid::Result> results(blcks.size());
+        std::atomic<size_t> next(0);
+        auto worker = [&]() {
+            for (size_t i = next++; i < blcks.size(); i = next++) {
+                results[i] = validate_block(blcks[i], since);
             }
+        };
+
+        std::vector<std::future<void>> workers;
+        for (size_t i = 0; i < std::min(nthreads, blcks.size()); i++) {
+            workers.push_back(std::async(std::launch::async, worker));
         }
-        // MultiTags
-        auto multi_tags = block.multiTags();
-        for (auto &multi_tag : multi_tags) {
-            result.concat(valid::validate(multi_tag));
-            // Features
-            auto features = multi_tag.features();
-            for (auto &feature : features) {
-                result.concat(valid::validate(feature));
-            }
+        for (auto &w : workers) {
+            w.get();
         }
-        // Tags
-        auto tags = block.tags();
-        for (auto &tag : tags) {
-            result.concat(valid::validate(tag));
-            // Features
-            auto features = tag.features();
-            for (auto &feature : features) {
-                result.concat(valid::validate(feature));
-            }
+
+        for (auto &r : results) {
+            result.concat(r);
         }
-        // Sources
-        auto sources = block.findSources();
-        for (auto &source : sources) {
-            result.concat(valid::validate(source));
+    } else {
+        for (auto &block : blcks) {
+            result.concat(validate_block(block, since));
         }
     }
+
     // Sections
     auto sections = findSections();
     for (auto &section : sections) {
-        result.concat(valid::validate(section));
+        if (is_modified(section, since)) {
+            result.concat(valid::validate(section));
+        } else {
+            result.addSkipped(skip_msg(section));
+        }
         // Properties
         auto props = section.properties();
         for (auto &prop : props) {
-            result.concat(valid::validate(prop));
+            if (is_modified(prop, since)) {
+                result.concat(valid::validate(prop));
+            } else {
+                result.addSkipped(skip_msg(prop));
+            }
         }
     }
 
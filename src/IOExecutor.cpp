@@ -0,0 +1,117 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/IOExecutor.hpp>
+
+#include <algorithm>
+
+namespace nix {
+
+IOExecutor &IOExecutor::instance() {
+    static IOExecutor executor;
+    return executor;
+}
+
+
+IOExecutor::IOExecutor(size_t max_queue_depth)
+    : max_depth(std::max<size_t>(max_queue_depth, 1)), busy(false), stop(false) {
+}
+
+
+void IOExecutor::enqueue(std::function<void()> job) {
+    std::unique_lock<std::mutex> lock(mtx);
+
+    // submitted by a running job: queueing it would leave the job waiting on itself
+    if (std::this_thread::get_id() == worker.get_id()) {
+        lock.unlock();
+        job();
+        return;
+    }
+
+    if (!worker.joinable()) {
+        worker = std::thread(&IOExecutor::run, this);
+    }
+
+    cv_space.wait(lock, [this] { return queue.size() < max_depth; });
+    queue.push_back(std::move(job));
+    cv_work.notify_one();
+}
+
+
+void IOExecutor::run() {
+    std::unique_lock<std::mutex> lock(mtx);
+
+    while (true) {
+        cv_work.wait(lock, [this] { return stop || !queue.empty(); });
+
+        if (queue.empty()) {
+            break; // stop requested and nothing left to do
+        }
+
+        std::function<void()> job = std::move(queue.front());
+        queue.pop_front();
+        busy = true;
+        cv_space.notify_one();
+
+        lock.unlock();
+        job(); // exceptions are captured by the job's promise
+        job = nullptr;
+        lock.lock();
+
+        busy = false;
+        if (queue.empty()) {
+            cv_idle.notify_all();
+        }
+    }
+}
+
+
+void IOExecutor::wait() {
+    std::unique_lock<std::mutex> lock(mtx);
+    cv_idle.wait(lock, [this] { return queue.empty() && !busy; });
+}
+
+
+bool IOExecutor::onIOThread() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return std::this_thread::get_id() == worker.get_id();
+}
+
+
+size_t IOExecutor::pending() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return queue.size() + (busy ? 1 : 0);
+}
+
+
+size_t IOExecutor::maxQueueDepth() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return max_depth;
+}
+
+
+void IOExecutor::maxQueueDepth(size_t depth) {
+    std::lock_guard<std::mutex> lock(mtx);
+    max_depth = std::max<size_t>(depth, 1);
+    cv_space.notify_all();
+}
+
+
+IOExecutor::~IOExecutor() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stop = true;
+        cv_work.notify_all();
+    }
+
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+} // namespace nix
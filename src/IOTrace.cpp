@@ -0,0 +1,142 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/IOTrace.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <sstream>
+
+namespace nix {
+
+static bool env_enabled() {
+    const char *val = std::getenv("NIX_IO_TRACE");
+    return val != nullptr && *val != '\0' && std::strcmp(val, "0") != 0;
+}
+
+std::atomic<bool> IOTrace::on(env_enabled());
+
+static std::mutex &registry_lock() {
+    static std::mutex lock;
+    return lock;
+}
+
+static std::map<std::string, IOStats> &registry() {
+    static std::map<std::string, IOStats> files;
+    return files;
+}
+
+
+std::string io_operation_to_string(IOOperation op) {
+    switch (op) {
+        case IOOperation::DataRead:     return "data_read";
+        case IOOperation::DataWrite:    return "data_write";
+        case IOOperation::AttrRead:     return "attr_read";
+        case IOOperation::AttrWrite:    return "attr_write";
+        case IOOperation::GroupOpen:    return "group_open";
+        case IOOperation::ObjectLookup: return "object_lookup";
+        case IOOperation::ObjectName:   return "object_name";
+    }
+    return "unknown";
+}
+
+
+void IOCounter::add(ndsize_t nbytes, uint64_t ns) {
+    calls++;
+    bytes += nbytes;
+    nanoseconds += ns;
+
+    size_t bucket = 0;
+    while (bucket + 1 < buckets && (ns >> (bucket + 1)) != 0) {
+        bucket++;
+    }
+    histogram[bucket]++;
+}
+
+
+static std::string json_str(const std::string &str) {
+    std::string res = "\"";
+    for (char c : str) {
+        if (c == '"' || c == '\\') {
+            res += '\\';
+            res += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char buf[8];
+            std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+            res += buf;
+        } else {
+            res += c;
+        }
+    }
+    return res + "\"";
+}
+
+static void write_counters(std::ostream &out, const std::map<IOOperation, IOCounter> &counters) {
+    out << "{";
+    std::string sep;
+    for (const auto &entry : counters) {
+        const IOCounter &counter = entry.second;
+        out << sep << json_str(io_operation_to_string(entry.first))
+            << ": {\"calls\": " << counter.calls
+            << ", \"bytes\": " << counter.bytes
+            << ", \"nanoseconds\": " << counter.nanoseconds
+            << ", \"histogram\": [";
+        for (size_t i = 0; i < IOCounter::buckets; i++) {
+            out << (i ? ", " : "") << counter.histogram[i];
+        }
+        out << "]}";
+        sep = ", ";
+    }
+    out << "}";
+}
+
+std::string IOStats::toJson() const {
+    std::ostringstream out;
+    out << "{\"operations\": ";
+    write_counters(out, operations);
+    out << ", \"entities\": {";
+    std::string sep;
+    for (const auto &entity : entities) {
+        out << sep << json_str(entity.first) << ": ";
+        write_counters(out, entity.second);
+        sep = ", ";
+    }
+    out << "}}";
+    return out.str();
+}
+
+
+void IOTrace::enable(bool enable) {
+    on.store(enable, std::memory_order_relaxed);
+}
+
+
+void IOTrace::record(const std::string &file, const std::string &entity,
+                     IOOperation op, ndsize_t bytes, uint64_t ns) {
+    std::lock_guard<std::mutex> guard(registry_lock());
+    IOStats &stats = registry()[file];
+    stats.operations[op].add(bytes, ns);
+    stats.entities[entity][op].add(bytes, ns);
+}
+
+
+IOStats IOTrace::stats(const std::string &location) {
+    std::lock_guard<std::mutex> guard(registry_lock());
+    auto it = registry().find(location);
+    return it != registry().end() ? it->second : IOStats();
+}
+
+
+void IOTrace::reset(const std::string &location) {
+    std::lock_guard<std::mutex> guard(registry_lock());
+    registry().erase(location);
+}
+
+} // namespace nix
@@ -0,0 +1,110 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/IntervalIndex.hpp>
+
+#include <nix/Exception.hpp>
+#include <nix/util/util.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace nix {
+
+
+IntervalIndex::IntervalIndex(const std::vector<double> &starts, const std::vector<double> &extents,
+                             const std::string &unit, const std::vector<ndsize_t> &keys)
+    : unit_str(util::unitSanitizer(unit))
+{
+    if (!extents.empty() && extents.size() != starts.size()) {
+        throw std::invalid_argument("IntervalIndex: number of extents does not match number of starts");
+    }
+    if (!keys.empty() && keys.size() != starts.size()) {
+        throw std::invalid_argument("IntervalIndex: number of keys does not match number of starts");
+    }
+
+    const size_t n = starts.size();
+    std::vector<double> lo(n), hi(n);
+    for (size_t k = 0; k < n; k++) {
+        const double extent = extents.empty() ? 0.0 : extents[k];
+        // a negative extent spans the same interval backwards
+        lo[k] = std::min(starts[k], starts[k] + extent);
+        hi[k] = std::max(starts[k], starts[k] + extent);
+    }
+
+    std::vector<size_t> sorted(n);
+    std::iota(sorted.begin(), sorted.end(), 0);
+    std::stable_sort(sorted.begin(), sorted.end(), [&lo](size_t a, size_t b) {
+        return lo[a] < lo[b];
+    });
+
+    lower.resize(n);
+    upper.resize(n);
+    order.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        lower[i] = lo[sorted[i]];
+        upper[i] = hi[sorted[i]];
+        order[i] = keys.empty() ? sorted[i] : keys[sorted[i]];
+    }
+
+    leaves = 1;
+    while (leaves < n) {
+        leaves *= 2;
+    }
+    max_upper.assign(2 * leaves, -std::numeric_limits<double>::infinity());
+    std::copy(upper.begin(), upper.end(), max_upper.begin() + leaves);
+    for (size_t node = leaves - 1; node > 0; node--) {
+        max_upper[node] = std::max(max_upper[2 * node], max_upper[2 * node + 1]);
+    }
+}
+
+
+void IntervalIndex::collect(size_t node, size_t first, size_t last, size_t stop, double start,
+                            std::vector<ndsize_t> &result) const {
+    if (first >= stop || max_upper[node] < start) {
+        return;
+    }
+    if (node >= leaves) {
+        result.push_back(order[first]);
+        return;
+    }
+    const size_t middle = first + (last - first) / 2;
+    collect(2 * node, first, middle, stop, start, result);
+    collect(2 * node + 1, middle, last, stop, start, result);
+}
+
+
+std::vector<ndsize_t> IntervalIndex::overlapping(double start, double end, const std::string &unit) const {
+    const std::string window_unit = util::unitSanitizer(unit);
+    if (!window_unit.empty() && window_unit != "none" && !unit_str.empty() &&
+        unit_str != "none" && window_unit != unit_str) {
+        double scaling;
+        try {
+            scaling = util::getSIScaling(window_unit, unit_str);
+        } catch (...) {
+            throw IncompatibleDimensions("Unit " + window_unit + " cannot be scaled to " + unit_str,
+                                         "IntervalIndex::overlapping");
+        }
+        start *= scaling;
+        end *= scaling;
+    }
+
+    std::vector<ndsize_t> result;
+    if (lower.empty() || end < start) {
+        return result;
+    }
+
+    // only intervals that start before the end of the window can overlap it
+    const size_t stop = static_cast<size_t>(std::upper_bound(lower.begin(), lower.end(), end) - lower.begin());
+    collect(1, 0, leaves, stop, start, result);
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+} // namespace nix
@@ -0,0 +1,265 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/MapData.hpp>
+#include <nix/IOExecutor.hpp>
+
+#include <nix/Exception.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace nix {
+
+// block size used if neither target nor source are chunked
+static const size_t unchunked_block_bytes = 1024 * 1024;
+
+namespace {
+
+// caps the number of kernels running at once
+class Slots {
+
+public:
+
+    explicit Slots(size_t n) : free(n) { }
+
+    void acquire() {
+        std::unique_lock<std::mutex> lock(mtx);
+        cv.wait(lock, [this] { return free > 0; });
+        free--;
+    }
+
+    void release() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            free++;
+        }
+        cv.notify_one();
+    }
+
+private:
+
+    std::mutex              mtx;
+    std::condition_variable cv;
+    size_t                  free;
+};
+
+// the buffers of one block in flight; shared with the tasks working on it
+struct Pending {
+    MapBlock                         block;
+    std::vector<std::vector<char>>   inputs;
+    std::vector<char>                output;
+};
+
+void copy_dimensions(const DataArray &source, DataArray &target) {
+    for (const Dimension &dim : source.dimensions()) {
+        switch (dim.dimensionType()) {
+            case DimensionType::Sample: {
+                SampledDimension src = dim.asSampledDimension();
+                SampledDimension dst = target.appendSampledDimension(src.samplingInterval());
+                if (src.label()) {
+                    dst.label(*src.label());
+                }
+                if (src.unit()) {
+                    dst.unit(*src.unit());
+                }
+                if (src.offset()) {
+                    dst.offset(*src.offset());
+                }
+                break;
+            }
+            case DimensionType::Range: {
+                RangeDimension src = dim.asRangeDimension();
+                RangeDimension dst;
+                if (src.alias() && target.dataExtent().size() == 1 && target.dataType() != DataType::String) {
+                    dst = target.appendAliasRangeDimension();
+                } else {
+                    dst = target.appendRangeDimension(src.ticks());
+                    if (src.label()) {
+                        dst.label(*src.label());
+                    }
+                    if (src.unit()) {
+                        dst.unit(*src.unit());
+                    }
+                }
+                break;
+            }
+            case DimensionType::Set: {
+                SetDimension dst = target.appendSetDimension();
+                dst.labels(dim.asSetDimension().labels());
+                break;
+            }
+        }
+    }
+}
+
+} // anonymous namespace
+
+
+void mapData(const std::vector<DataArray> &sources, DataArray &target,
+             const MapKernel &kernel, const MapOptions &options) {
+    if (sources.empty()) {
+        throw std::invalid_argument("mapData: no source");
+    }
+
+    const NDSize extent = sources[0].dataExtent();
+    const size_t rank = extent.size();
+    const size_t axis = options.axis;
+    for (const DataArray &source : sources) {
+        if (!source) {
+            throw UninitializedEntity();
+        }
+        if (source.dataExtent() != extent) {
+            throw IncompatibleDimensions("Sources must have the same extent", "mapData");
+        }
+        if (source.id() == target.id()) {
+            throw std::invalid_argument("mapData: the target must not be a source");
+        }
+    }
+    if (!target) {
+        throw UninitializedEntity();
+    }
+    if (axis >= rank) {
+        throw InvalidRank("axis is out of bounds");
+    }
+    if (options.blocks == 0) {
+        throw std::invalid_argument("mapData: blocks must be at least 1");
+    }
+    if (options.dtype == DataType::String || options.dtype == DataType::Nothing) {
+        throw std::invalid_argument("mapData: unsupported data type");
+    }
+
+    if (target.dataExtent() != extent) {
+        target.dataExtent(extent);
+    }
+    if (target.dimensionCount() == 0) {
+        copy_dimensions(sources[0], target);
+    }
+    if (!target.metadata() && sources[0].metadata()) {
+        target.metadata(sources[0].metadata());
+    }
+
+    if (extent.nelms() == 0) {
+        return;
+    }
+
+    // blocks are aligned to the chunks the data is written to
+    ndsize_t block_len;
+    NDSize chunks = target.dataChunks();
+    if (chunks.size() != rank) {
+        chunks = sources[0].dataChunks();
+    }
+    if (chunks.size() == rank && chunks[axis] > 0) {
+        block_len = chunks[axis] * options.blocks;
+    } else {
+        ndsize_t row_bytes = data_type_to_size(options.dtype);
+        for (size_t i = 0; i < rank; i++) {
+            if (i != axis) {
+                row_bytes *= std::max<ndsize_t>(extent[i], 1);
+            }
+        }
+        block_len = std::max<ndsize_t>(unchunked_block_bytes / row_bytes, 1) * options.blocks;
+    }
+    const ndsize_t nblocks = (extent[axis] + block_len - 1) / block_len;
+
+    size_t nthreads = options.nthreads;
+    if (nthreads == 0) {
+        nthreads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    const size_t depth = options.depth > 0 ? options.depth : 2 * nthreads;
+    const size_t elem_size = data_type_to_size(options.dtype);
+    const DataType dtype = options.dtype;
+    Slots slots(nthreads);
+
+    struct InFlight {
+        std::shared_ptr<Pending> pending;
+        std::future<void>        done;
+    };
+
+    auto launch = [&](ndsize_t index) {
+        std::shared_ptr<Pending> p = std::make_shared<Pending>();
+        MapBlock &b = p->block;
+        b.axis = axis;
+        b.dtype = dtype;
+        b.offset = NDSize(rank, 0);
+        b.offset[axis] = index * block_len;
+        b.count = extent;
+        b.count[axis] = std::min(block_len, extent[axis] - b.offset[axis]);
+        b.halo_before = std::min(options.halo, b.offset[axis]);
+        b.halo_after = std::min(options.halo, extent[axis] - b.offset[axis] - b.count[axis]);
+        b.input_offset = b.offset;
+        b.input_offset[axis] -= b.halo_before;
+        b.input_count = b.count;
+        b.input_count[axis] += b.halo_before + b.halo_after;
+
+        const size_t in_bytes = check::fits_in_size_t(b.input_count.nelms() * elem_size,
+                                                      "mapData: block exceeds memory");
+        p->inputs.assign(sources.size(), std::vector<char>(in_bytes));
+        p->output.resize(check::fits_in_size_t(b.count.nelms() * elem_size, "mapData: block exceeds memory"));
+        for (const std::vector<char> &input : p->inputs) {
+            b.inputs.push_back(input.data());
+        }
+        b.output = p->output.data();
+
+        // HDF5 is only entered from the I/O thread
+        std::shared_future<void> read = IOExecutor::instance().submit([p, sources]() {
+            for (size_t i = 0; i < sources.size(); i++) {
+                sources[i].getData(p->block.dtype, p->inputs[i].data(),
+                                   p->block.input_count, p->block.input_offset);
+            }
+        }).share();
+
+        InFlight f;
+        f.pending = p;
+        f.done = std::async(std::launch::async, [p, read, &slots, &kernel]() {
+            read.get();
+            slots.acquire();
+            try {
+                kernel(p->block);
+            } catch (...) {
+                slots.release();
+                throw;
+            }
+            slots.release();
+        });
+        return f;
+    };
+
+    // blocks in flight, in order; the destructor of a std::async future
+    // waits for its task, so nothing outlives the locals on error
+    std::deque<InFlight> queue;
+    ndsize_t next = 0;
+    for (ndsize_t written = 0; written < nblocks; written++) {
+        while (next < nblocks && queue.size() < depth) {
+            queue.push_back(launch(next++));
+        }
+
+        InFlight &f = queue.front();
+        f.done.get();
+        std::shared_ptr<Pending> p = f.pending;
+        DataArray out = target;
+        const size_t compress_threads = nthreads;
+        IOExecutor::instance().submit([p, out, compress_threads]() mutable {
+            out.setDataParallel(p->block.dtype, p->output.data(), p->block.count,
+                                p->block.offset, compress_threads);
+        }).get();
+        queue.pop_front();
+    }
+}
+
+
+void mapData(const DataArray &source, DataArray &target, const MapKernel &kernel, const MapOptions &options) {
+    mapData(std::vector<DataArray> {source}, target, kernel, options);
+}
+
+} // namespace nix
@@ -0,0 +1,341 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/MetadataSnapshot.hpp>
+
+#include <nix/File.hpp>
+
+#include <stdexcept>
+
+namespace nix {
+
+/**
+ * State of a single lookup: the filter, classified once, and the
+ * sections opened so far, so that every section is opened at most once
+ * and only from its (already opened) parent.
+ */
+class MetadataSnapshot::Query {
+
+public:
+
+    Query(const MetadataSnapshot &snapshot, const util::Filter<Section>::type *filter = nullptr)
+        : snapshot(snapshot), filter(filter), kind(Kind::All), key(nullptr), ids(nullptr) {
+        std::shared_ptr<base::IFile> f = snapshot.file.lock();
+        if (!f) {
+            throw std::runtime_error("MetadataSnapshot: the file of the snapshot is gone");
+        }
+        file = File(f);
+
+        if (filter == nullptr || filter->target<util::AcceptAll<Section>>() != nullptr) {
+            kind = Kind::All;
+        } else if (auto f_id = filter->target<util::IdFilter<Section>>()) {
+            kind = Kind::Id;
+            key = &f_id->id;
+        } else if (auto f_name = filter->target<util::NameFilter<Section>>()) {
+            kind = Kind::Name;
+            key = &f_name->name;
+        } else if (auto f_type = filter->target<util::TypeFilter<Section>>()) {
+            kind = Kind::Type;
+            key = &f_type->type;
+        } else if (auto f_ids = filter->target<util::IdsFilter<Section>>()) {
+            kind = Kind::Ids;
+            ids = &f_ids->ids;
+        } else {
+            kind = Kind::Other;
+        }
+    }
+
+    /**
+     * True if only the sections returned by candidates() can match.
+     */
+    bool indexed() const {
+        return kind == Kind::Id || kind == Kind::Name || kind == Kind::Type;
+    }
+
+    /**
+     * The sections that can match an indexed filter, in node order.
+     */
+    std::vector<size_t> candidates() const {
+        std::vector<size_t> result;
+        if (kind == Kind::Id) {
+            auto it = snapshot.by_id.find(*key);
+            if (it != snapshot.by_id.end()) {
+                result.push_back(it->second);
+            }
+        } else {
+            const Index &index = kind == Kind::Name ? snapshot.by_name : snapshot.by_type;
+            auto it = index.find(*key);
+            if (it != index.end()) {
+                result = it->second;
+            }
+        }
+        return result;
+    }
+
+    bool accept(size_t i) {
+        const Node &n = snapshot.nodes[i];
+        switch (kind) {
+            case Kind::All:  return true;
+            case Kind::Id:   return n.id == *key;
+            case Kind::Name: return n.name == *key;
+            case Kind::Type: return n.type == *key;
+            case Kind::Ids:  return ids->count(n.id) > 0;
+            case Kind::Other: break;
+        }
+        return (*filter)(section(i));
+    }
+
+    void seed(size_t i, const Section &section) {
+        handles.emplace(i, section);
+    }
+
+    Section section(size_t i) {
+        auto it = handles.find(i);
+        if (it != handles.end()) {
+            return it->second;
+        }
+
+        const Node &n = snapshot.nodes[i];
+        Section s = n.parent == npos ? file.getSection(n.name) : section(n.parent).getSection(n.name);
+        handles.emplace(i, s);
+        return s;
+    }
+
+private:
+
+    enum class Kind {
+        All, Id, Name, Type, Ids, Other
+    };
+
+    const MetadataSnapshot &snapshot;
+    const util::Filter<Section>::type *filter;
+    Kind kind;
+    const std::string *key;
+    const std::unordered_set<std::string> *ids;
+    File file;
+    std::unordered_map<size_t, Section> handles;
+};
+
+
+MetadataSnapshot::MetadataSnapshot(const File &f, std::vector<Section> &sections)
+    : file(f.impl())
+{
+    auto add = [this, &sections](const Section &s, size_t parent, size_t depth) {
+        size_t i = nodes.size();
+        nodes.push_back(Node {s.id(), s.name(), s.type(), parent, npos, depth, {}});
+        sections.push_back(s);
+
+        if (parent != npos) {
+            nodes[parent].children.push_back(i);
+        }
+        by_id.emplace(nodes[i].id, i);
+        by_name[nodes[i].name].push_back(i);
+        by_type[nodes[i].type].push_back(i);
+        for (const Property &p : s.properties()) {
+            by_property[p.name()].push_back(i);
+        }
+    };
+
+    for (const Section &root : f.sections()) {
+        size_t first = nodes.size();
+        add(root, npos, 0);
+        // nodes appended behind i are visited in turn: breadth first
+        for (size_t i = first; i < nodes.size(); i++) {
+            for (const Section &child : sections[i].sections()) {
+                add(child, i, nodes[i].depth + 1);
+            }
+        }
+    }
+}
+
+
+void MetadataSnapshot::loadLinks(const std::vector<Section> &sections) {
+    for (size_t i = 0; i < sections.size(); i++) {
+        Section target = sections[i].link();
+        if (target) {
+            auto it = by_id.find(target.id());
+            if (it != by_id.end()) {
+                nodes[i].link = it->second;
+            }
+        }
+    }
+}
+
+
+size_t MetadataSnapshot::node(const Section &section) const {
+    const std::string id = section.id();
+    auto it = by_id.find(id);
+    if (it == by_id.end()) {
+        throw std::invalid_argument("MetadataSnapshot: section " + id + " is not part of the snapshot");
+    }
+    return it->second;
+}
+
+
+std::vector<Section> MetadataSnapshot::collect(const Index &index, const std::string &key) const {
+    std::vector<Section> results;
+    auto it = index.find(key);
+    if (it != index.end()) {
+        Query query(*this);
+        for (size_t i : it->second) {
+            results.push_back(query.section(i));
+        }
+    }
+    return results;
+}
+
+
+Section MetadataSnapshot::sectionById(const std::string &id) const {
+    auto it = by_id.find(id);
+    if (it == by_id.end()) {
+        return Section();
+    }
+    return Query(*this).section(it->second);
+}
+
+
+std::vector<Section> MetadataSnapshot::sectionsByName(const std::string &name) const {
+    return collect(by_name, name);
+}
+
+
+std::vector<Section> MetadataSnapshot::sectionsByType(const std::string &type) const {
+    return collect(by_type, type);
+}
+
+
+std::vector<Section> MetadataSnapshot::sectionsWithProperty(const std::string &name) const {
+    return collect(by_property, name);
+}
+
+
+Section MetadataSnapshot::link(const Section &section) const {
+    size_t target = nodes[node(section)].link;
+    if (target == npos) {
+        return Section();
+    }
+    return Query(*this).section(target);
+}
+
+
+std::vector<Section> MetadataSnapshot::findSections(const util::Filter<Section>::type &filter,
+                                                    size_t max_depth) const {
+    std::vector<Section> results;
+    Query query(*this, &filter);
+
+    auto visit = [&](size_t i) {
+        if (nodes[i].depth < max_depth && query.accept(i)) {
+            results.push_back(query.section(i));
+        }
+    };
+
+    if (query.indexed()) {
+        for (size_t i : query.candidates()) {
+            visit(i);
+        }
+    } else {
+        for (size_t i = 0; i < nodes.size(); i++) {
+            visit(i);
+        }
+    }
+    return results;
+}
+
+
+std::vector<Section> MetadataSnapshot::findSections(const Section &section,
+                                                    const util::Filter<Section>::type &filter,
+                                                    size_t max_depth) const {
+    std::vector<Section> results;
+    const size_t start = node(section);
+    Query query(*this, &filter);
+    query.seed(start, section);
+
+    if (query.indexed()) {
+        // descendants of a section are in node order in breadth first order
+        const size_t base = nodes[start].depth;
+        for (size_t i : query.candidates()) {
+            if (nodes[i].depth <= base || nodes[i].depth - base > max_depth) {
+                continue;
+            }
+            size_t distance = nodes[i].depth - base;
+            size_t ancestor = i;
+            for (size_t k = 0; k < distance; k++) {
+                ancestor = nodes[ancestor].parent;
+            }
+            if (ancestor == start) {
+                results.push_back(query.section(i));
+            }
+        }
+        return results;
+    }
+
+    std::vector<size_t> level = nodes[start].children;
+    for (size_t depth = 1; depth <= max_depth && !level.empty(); depth++) {
+        std::vector<size_t> next;
+        for (size_t i : level) {
+            if (query.accept(i)) {
+                results.push_back(query.section(i));
+            }
+            next.insert(next.end(), nodes[i].children.begin(), nodes[i].children.end());
+        }
+        level.swap(next);
+    }
+    return results;
+}
+
+
+std::vector<Section> MetadataSnapshot::findRelated(const Section &section,
+                                                   const util::Filter<Section>::type &filter) const {
+    std::vector<Section> results;
+    const size_t start = node(section);
+    Query query(*this, &filter);
+    query.seed(start, section);
+
+    // the matching descendants closest to the section
+    std::vector<size_t> level = nodes[start].children;
+    while (!level.empty()) {
+        std::vector<size_t> next;
+        for (size_t i : level) {
+            if (query.accept(i)) {
+                results.push_back(query.section(i));
+            }
+            next.insert(next.end(), nodes[i].children.begin(), nodes[i].children.end());
+        }
+        if (!results.empty()) {
+            return results;
+        }
+        level.swap(next);
+    }
+
+    // else the closest matching ancestor
+    for (size_t p = nodes[start].parent; p != npos; p = nodes[p].parent) {
+        if (query.accept(p)) {
+            results.push_back(query.section(p));
+            return results;
+        }
+    }
+
+    // else the matching siblings of the closest ancestor that has any
+    for (size_t p = nodes[start].parent; p != npos; p = nodes[p].parent) {
+        bool found = false;
+        for (size_t i : nodes[p].children) {
+            if (query.accept(i)) {
+                found = true;
+                if (i != start) {
+                    results.push_back(query.section(i));
+                }
+            }
+        }
+        if (found) {
+            break;
+        }
+    }
+    return results;
+}
+
+} // namespace nix
@@ -61,6 +61,57 @@ void MultiTag::units(const std::vector<std::string> &units) {
 }
 
 
+/**
+ * One column of a positions or extents array: the values along dimension
+ * dim of every position.
+ */
+static std::vector<double> read_column(const DataArray &array, size_t dim) {
+    const NDSize size = array.dataExtent();
+    if (size.size() < 1 || size.size() > 2) {
+        throw IncompatibleDimensions("Positions and extents must be 1-d or 2-d",
+                                     "MultiTag::intervalIndex");
+    }
+    const ndsize_t columns = size.size() == 1 ? 1 : size[1];
+    if (dim >= columns) {
+        throw OutOfBounds("MultiTag::intervalIndex: no such dimension in positions", dim);
+    }
+
+    std::vector<double> values(check::fits_in_size_t(size[0], "Cannot allocate storage (exceeds memory)"));
+    if (!values.empty()) {
+        NDSize count = size, offset(size.size(), 0);
+        if (size.size() == 2) {
+            count[1] = 1;
+            offset[1] = dim;
+        }
+        array.getData(DataType::Double, values.data(), count, offset);
+    }
+    return values;
+}
+
+
+IntervalIndex MultiTag::intervalIndex(size_t dim) const {
+    DataArray pos = positions();
+    if (!pos) {
+        throw UninitializedEntity();
+    }
+    std::vector<double> starts = read_column(pos, dim);
+
+    std::vector<double> lengths;
+    DataArray ext = extents();
+    if (ext) {
+        if (ext.dataExtent() != pos.dataExtent()) {
+            throw IncompatibleDimensions("Number of dimensions in extents does not match positions",
+                                         "MultiTag::intervalIndex");
+        }
+        lengths = read_column(ext, dim);
+    }
+
+    std::vector<std::string> dim_units = units();
+    std::string unit = dim < dim_units.size() ? dim_units[dim] : "";
+    return IntervalIndex(starts, lengths, unit);
+}
+
+
 bool MultiTag::hasReference(const DataArray &reference) const {
     if(!util::checkEntityInput(reference, false)) {
         return false;
@@ -10,6 +10,8 @@
 
 #include <nix/util/util.hpp>
 
+#include <algorithm>
+
 namespace nix {
 
 void Property::unit(const std::string &unit) {
@@ -21,6 +23,41 @@ void Property::unit(const std::string &unit) {
     backend()->unit(dblnk_unit);
 }
 
+void Property::checkValueRange(ndsize_t count, ndsize_t offset) const {
+    if (offset + count > valueCount()) {
+        throw OutOfBounds("Property: trying to access values outside of range", offset + count);
+    }
+}
+
+// check before replacing the values, so a mismatch leaves them untouched
+void Property::checkValueType(DataType dtype) const {
+    if (dtype != dataType()) {
+        throw std::invalid_argument("Inconsistent DataTypes!");
+    }
+}
+
+// std::vector<bool> has no contiguous bool storage
+void Property::getValues(std::vector<bool> &values, ndsize_t count, ndsize_t offset) const {
+    const size_t n = check::fits_in_size_t(count, "Property::getValues: count exceeds memory");
+    std::unique_ptr<bool[]> buffer(new bool[n]);
+    getValues(buffer.get(), count, offset);
+    values.assign(buffer.get(), buffer.get() + n);
+}
+
+void Property::setValues(const std::vector<bool> &values, ndsize_t offset) {
+    std::unique_ptr<bool[]> buffer(new bool[values.size()]);
+    std::copy(values.begin(), values.end(), buffer.get());
+    setValues(buffer.get(), values.size(), offset);
+}
+
+void Property::setValues(const std::vector<bool> &values) {
+    if (values.size() != valueCount()) {
+        checkValueType(DataType::Bool);
+        deleteValues();
+    }
+    setValues(values, 0);
+}
+
 std::ostream& operator<<(std::ostream &out, const Property &ent) {
     out << "Property: {name = " << ent.name() << "}";
     return out;
@@ -0,0 +1,216 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/ReadAhead.hpp>
+#include <nix/IOExecutor.hpp>
+
+#include <nix/Exception.hpp>
+
+#include <algorithm>
+#include <chrono>
+
+namespace nix {
+
+// slab size used if the data is not chunked
+static const size_t unchunked_slab_bytes = 1024 * 1024;
+
+
+ReadAhead::ReadAhead(const DataArray &da, size_t axis, size_t depth, DataType dtype)
+    : array(da), extent(da.dataExtent()), dtype(dtype), axis(axis), nahead(depth),
+      next_pos(0), nhits(0), nmisses(0), nprefetched(0) {
+
+    if (axis >= extent.size()) {
+        throw InvalidRank("axis is out of bounds");
+    }
+
+    if (this->dtype == DataType::Nothing) {
+        const bool calibrated = da.polynomCoefficients().size() || da.expansionOrigin();
+        this->dtype = calibrated ? DataType::Double : da.dataType();
+    }
+
+    if (this->dtype == DataType::String || this->dtype == DataType::Nothing) {
+        throw std::invalid_argument("ReadAhead: unsupported data type");
+    }
+
+    NDSize chunks = da.dataChunks();
+    if (chunks.size() == extent.size() && chunks[axis] > 0) {
+        slab_len = chunks[axis];
+    } else {
+        ndsize_t row_bytes = data_type_to_size(this->dtype);
+        for (size_t i = 0; i < extent.size(); i++) {
+            if (i != axis) {
+                row_bytes *= std::max<ndsize_t>(extent[i], 1);
+            }
+        }
+        slab_len = std::max<ndsize_t>(unchunked_slab_bytes / row_bytes, 1);
+    }
+
+    nslabs = (extent[axis] + slab_len - 1) / slab_len;
+}
+
+
+void ReadAhead::dataExtent(const NDSize &extent) {
+    throw std::runtime_error("ReadAhead: changing the extent is not allowed");
+}
+
+
+NDSize ReadAhead::dataExtent() const {
+    return extent;
+}
+
+
+DataType ReadAhead::dataType() const {
+    return dtype;
+}
+
+
+const ReadAhead::Slab &ReadAhead::fetch(ndsize_t index) const {
+    auto it = std::find_if(slabs.begin(), slabs.end(),
+                           [index](const Slab &s) { return s.index == index; });
+    if (it != slabs.end()) {
+        return *it;
+    }
+
+    Slab slab;
+    slab.index = index;
+    slab.shape = extent;
+    slab.shape[axis] = std::min(slab_len, extent[axis] - index * slab_len);
+
+    NDSize offset(extent.size(), 0);
+    offset[axis] = index * slab_len;
+
+    const size_t nbytes = check::fits_in_size_t(slab.shape.nelms() * data_type_to_size(dtype),
+                                                "ReadAhead: slab exceeds memory");
+    slab.buffer = std::make_shared<std::vector<char>>(nbytes);
+
+    const DataArray da = array;
+    const DataType type = dtype;
+    const NDSize shape = slab.shape;
+    std::shared_ptr<std::vector<char>> buffer = slab.buffer;
+    slab.ready = IOExecutor::instance().submit([da, type, buffer, shape, offset]() {
+        da.getData(type, buffer->data(), shape, offset);
+    }).share();
+
+    inflight.erase(std::remove_if(inflight.begin(), inflight.end(), [](const std::shared_future<void> &f) {
+        return f.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }), inflight.end());
+    inflight.push_back(slab.ready);
+
+    // keep the deque sorted by slab index
+    auto pos = std::find_if(slabs.begin(), slabs.end(),
+                            [index](const Slab &s) { return s.index > index; });
+    return *slabs.insert(pos, std::move(slab));
+}
+
+
+void ReadAhead::ioRead(DataType dtype, void *data, const NDSize &count, const NDSize &offset) const {
+    const NDSize real_count = count ? count : extent;
+    const NDSize real_offset = offset ? offset : NDSize(extent.size(), 0);
+
+    if (real_count.size() != extent.size() || real_offset.size() != extent.size()) {
+        throw IncompatibleDimensions("Rank of count and offset must match the data", "ReadAhead::getData");
+    }
+
+    if (real_offset + real_count > extent) {
+        throw OutOfBounds("Trying to access data outside of range", 0);
+    }
+
+    if (real_count.nelms() == 0) {
+        return;
+    }
+
+    if (dtype != this->dtype) {
+        // not cacheable, but must still be serialized with the prefetches
+        nmisses++;
+        const DataArray da = array;
+        IOExecutor::instance().submit([da, dtype, data, real_count, real_offset]() {
+            da.getData(dtype, data, real_count, real_offset);
+        }).get();
+        return;
+    }
+
+    const ndsize_t start = real_offset[axis];
+    const ndsize_t end = start + real_count[axis];
+    const ndsize_t k0 = start / slab_len;
+    const ndsize_t k1 = (end - 1) / slab_len;
+
+    const bool cached = std::any_of(slabs.begin(), slabs.end(),
+                                    [k0](const Slab &s) { return s.index == k0; });
+    const bool sequential = start == next_pos || cached;
+
+    // drop everything we have scanned past, or all of it on a seek
+    while (!slabs.empty() && (!sequential || slabs.front().index < k0)) {
+        slabs.pop_front();
+    }
+
+    bool hit = true;
+    for (ndsize_t k = k0; k <= k1; k++) {
+        size_t before = slabs.size();
+        fetch(k);
+        hit = hit && slabs.size() == before;
+    }
+
+    if (hit) {
+        nhits++;
+    } else {
+        nmisses++;
+    }
+
+    if (sequential) {
+        const ndsize_t last = std::min<ndsize_t>(k1 + nahead, nslabs - 1);
+        for (ndsize_t k = k1 + 1; k <= last; k++) {
+            size_t before = slabs.size();
+            fetch(k);
+            nprefetched += slabs.size() - before;
+        }
+    }
+
+    const size_t esize = data_type_to_size(dtype);
+    NDSize dst_offset(extent.size(), 0);
+
+    for (const Slab &slab : slabs) {
+        if (slab.index < k0 || slab.index > k1) {
+            continue;
+        }
+
+        slab.ready.get();
+
+        const ndsize_t slab_start = slab.index * slab_len;
+        const ndsize_t lo = std::max(start, slab_start);
+        const ndsize_t hi = std::min(end, slab_start + slab.shape[axis]);
+
+        NDSize src_offset = real_offset;
+        src_offset[axis] = lo - slab_start;
+
+        NDSize region = real_count;
+        region[axis] = hi - lo;
+
+        dst_offset[axis] = lo - start;
+
+        util::copyRegion(slab.buffer->data(), slab.shape, src_offset,
+                         data, real_count, dst_offset, region, esize);
+    }
+
+    next_pos = end;
+}
+
+
+void ReadAhead::ioWrite(DataType dtype, const void *data, const NDSize &count, const NDSize &offset) {
+    throw std::runtime_error("ReadAhead: writing is not allowed");
+}
+
+
+ReadAhead::~ReadAhead() {
+    // the prefetches own their buffers, but must not outlive the file;
+    // slabs dropped by a seek may still be in flight
+    for (const std::shared_future<void> &f : inflight) {
+        f.wait();
+    }
+}
+
+} // namespace nix
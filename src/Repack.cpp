@@ -0,0 +1,32 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/Repack.hpp>
+#include "hdf5/RepackHDF5.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <stdexcept>
+
+namespace nix {
+
+RepackStats repack(const std::string &src, const std::string &dst, const RepackRule &rule, size_t nthreads) {
+    namespace fs = boost::filesystem;
+
+    if (!fs::is_regular_file(src)) {
+        throw std::invalid_argument("repack: " + src + " is not a file of the HDF5 backend");
+    }
+
+    if (fs::exists(dst) && fs::equivalent(src, dst)) {
+        throw std::invalid_argument("repack: Cannot repack a file onto itself");
+    }
+
+    return hdf5::repack(src, dst, rule, nthreads);
+}
+
+} // namespace nix
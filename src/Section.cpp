@@ -11,8 +11,10 @@
 #include <list>
 #include <algorithm>
 #include <iterator>
+#include <cstring>
 #include <nix/Block.hpp>
 #include <nix/File.hpp>
+#include <nix/MetadataSnapshot.hpp>
 #include <nix/DataArray.hpp>
 #include <nix/util/util.hpp>
 
@@ -97,6 +99,11 @@ void addChildrenIfNotMaxDepth(std::tuple<Section, size_t>& current,
 
 std::vector<Section> Section::findSections(const util::Filter<Section>::type &filter,
                                            size_t max_depth) const {
+    std::shared_ptr<const MetadataSnapshot> snapshot = backend()->parentFile()->metadataSnapshot();
+    if (snapshot) {
+        return snapshot->findSections(*this, filter, max_depth);
+    }
+
     std::vector<Section> results;
     std::list<std::tuple<Section, size_t>> todo;
     std::tuple<Section, size_t> current = std::make_tuple(*this, 0);
@@ -130,6 +137,11 @@ static inline auto erase_section_with_id(std::vector<Section> &sections, const s
 
 std::vector<Section> Section::findRelated(const util::Filter<Section>::type &filter) const
 {
+    std::shared_ptr<const MetadataSnapshot> snapshot = backend()->parentFile()->metadataSnapshot();
+    if (snapshot) {
+        return snapshot->findRelated(*this, filter);
+    }
+
     std::vector<Section> results = findDownstream(filter);
     const std::string &my_id = id();
 
@@ -302,6 +314,34 @@ Property Section::createProperty(const std::string &name, const std::vector<Vari
     return backend()->createProperty(name, values);
 }
 
+Property Section::createProperty(const std::string &name, const std::vector<Variant> &values,
+                                 const StringStorage &strings) {
+    if (strings.mode == StringStorage::Mode::Variable) {
+        return createProperty(name, values);
+    }
+    if (values.size() < 1)
+        throw std::runtime_error("Trying to create a property without a value!");
+    if (values[0].type() != DataType::String) {
+        throw std::invalid_argument("Section::createProperty: string storage requires string values");
+    }
+    util::checkEntityName(name);
+    if (backend()->hasProperty(name)) {
+        throw DuplicateName("hasProperty");
+    }
+
+    StringStorage storage = strings;
+    if (storage.mode == StringStorage::Mode::Fixed && storage.length == 0) {
+        storage.length = 1;
+        for (const Variant &v : values) {
+            storage.length = std::max(storage.length, std::strlen(v.get<const char *>()));
+        }
+    }
+
+    Property p = backend()->createProperty(name, DataType::String, storage);
+    p.values(values);
+    return p;
+}
+
 Property Section::createProperty(const std::string &name, const Variant &value) {
     util::checkEntityName(name);
     if (backend()->hasProperty(name)){
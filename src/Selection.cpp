@@ -0,0 +1,266 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/Selection.hpp>
+
+#include <nix/Exception.hpp>
+
+#include <algorithm>
+
+namespace nix {
+
+// the number of elements selected along one dimension
+static ndsize_t dim_count(const Selection::Dim &dim) {
+    return dim.kind == Selection::Dim::Kind::Indices ? dim.indices.size() : dim.count * dim.block;
+}
+
+// check dim against an extent of n and resolve All
+static Selection::Dim check_dim(Selection::Dim dim, ndsize_t n) {
+    switch (dim.kind) {
+        case Selection::Dim::Kind::All:
+            dim.kind = Selection::Dim::Kind::Slab;
+            dim.start = 0;
+            dim.count = n;
+            dim.stride = 1;
+            dim.block = 1;
+            break;
+        case Selection::Dim::Kind::Slab:
+            if (dim.count > 0 && dim.start + (dim.count - 1) * dim.stride + dim.block > n) {
+                throw OutOfBounds("Selection: slab is out of bounds", dim.start);
+            }
+            break;
+        case Selection::Dim::Kind::Indices:
+            if (!dim.indices.empty() && dim.indices.back() >= n) {
+                throw OutOfBounds("Selection: index is out of bounds", dim.indices.back());
+            }
+            break;
+    }
+    return dim;
+}
+
+
+Selection Selection::box(const NDSize &count, const NDSize &offset) {
+    Selection sel;
+    for (size_t d = 0; d < count.size(); d++) {
+        sel.slab(d, offset ? offset[d] : 0, count[d]);
+    }
+    if (count.size() == 0) {
+        sel.last();
+    }
+    return sel;
+}
+
+
+std::vector<Selection::Dim> &Selection::last() {
+    if (parts.empty()) {
+        parts.emplace_back();
+    }
+    return parts.back();
+}
+
+
+Selection &Selection::slab(size_t dim, ndsize_t start, ndsize_t count, ndsize_t stride, ndsize_t block) {
+    if (block == 0 || (count > 1 && stride < block)) {
+        throw std::invalid_argument("Selection: blocks of a slab must not be empty or overlap");
+    }
+
+    std::vector<Dim> &part = last();
+    if (part.size() <= dim) {
+        part.resize(dim + 1);
+    }
+    Dim &d = part[dim];
+    d.kind = Dim::Kind::Slab;
+    d.start = start;
+    d.count = count;
+    d.stride = std::max<ndsize_t>(stride, 1);
+    d.block = block;
+    d.indices.clear();
+    return *this;
+}
+
+
+Selection &Selection::indices(size_t dim, std::vector<ndsize_t> indices) {
+    std::sort(indices.begin(), indices.end());
+    indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+
+    std::vector<Dim> &part = last();
+    if (part.size() <= dim) {
+        part.resize(dim + 1);
+    }
+    Dim &d = part[dim];
+    d = Dim();
+    d.kind = Dim::Kind::Indices;
+    d.indices = std::move(indices);
+    return *this;
+}
+
+
+Selection &Selection::unite(const Selection &other) {
+    last();
+    if (other.parts.empty()) {
+        parts.emplace_back();
+    } else {
+        parts.insert(parts.end(), other.parts.begin(), other.parts.end());
+    }
+    return *this;
+}
+
+
+std::vector<std::vector<Selection::Dim>> Selection::resolve(const NDSize &extent) const {
+    const size_t rank = extent.size();
+    if (rank == 0) {
+        throw IncompatibleDimensions("Selections need data with at least one dimension", "Selection");
+    }
+
+    std::vector<std::vector<Dim>> result = parts;
+    if (result.empty()) {
+        result.emplace_back();
+    }
+    for (std::vector<Dim> &part : result) {
+        if (part.size() > rank) {
+            throw IncompatibleDimensions("Selection has more dimensions than the data", "Selection");
+        }
+        part.resize(rank);
+        for (size_t d = 0; d < rank; d++) {
+            part[d] = check_dim(part[d], extent[d]);
+        }
+    }
+    return result;
+}
+
+
+std::vector<Selection::Run> Selection::runs(const NDSize &extent) const {
+    const std::vector<std::vector<Dim>> resolved = resolve(extent);
+    const size_t rank = extent.size();
+    std::vector<Run> result;
+
+    for (const std::vector<Dim> &part : resolved) {
+        // the coordinates of the outer dimensions and the runs of the last
+        std::vector<std::vector<ndsize_t>> coords(rank - 1);
+        bool empty = false;
+        for (size_t d = 0; d + 1 < rank; d++) {
+            const Dim &dim = part[d];
+            if (dim.kind == Dim::Kind::Indices) {
+                coords[d] = dim.indices;
+            } else {
+                for (ndsize_t k = 0; k < dim.count; k++) {
+                    for (ndsize_t b = 0; b < dim.block; b++) {
+                        coords[d].push_back(dim.start + k * dim.stride + b);
+                    }
+                }
+            }
+            empty = empty || coords[d].empty();
+        }
+
+        std::vector<std::pair<ndsize_t, ndsize_t>> inner;
+        const Dim &dim = part[rank - 1];
+        if (dim.kind == Dim::Kind::Indices) {
+            for (ndsize_t i : dim.indices) {
+                if (!inner.empty() && inner.back().first + inner.back().second == i) {
+                    inner.back().second++;
+                } else {
+                    inner.emplace_back(i, 1);
+                }
+            }
+        } else if (dim.block == dim.stride) {
+            if (dim.count > 0) {
+                inner.emplace_back(dim.start, dim.count * dim.block);
+            }
+        } else {
+            for (ndsize_t k = 0; k < dim.count; k++) {
+                inner.emplace_back(dim.start + k * dim.stride, dim.block);
+            }
+        }
+        if (empty || inner.empty()) {
+            continue;
+        }
+
+        std::vector<size_t> pos(rank - 1, 0);
+        while (true) {
+            NDSize offset(rank, 0);
+            for (size_t d = 0; d + 1 < rank; d++) {
+                offset[d] = coords[d][pos[d]];
+            }
+            for (const auto &r : inner) {
+                offset[rank - 1] = r.first;
+                result.push_back(Run {offset, r.second});
+            }
+
+            size_t d = rank - 1;
+            while (d > 0 && ++pos[d - 1] == coords[d - 1].size()) {
+                pos[--d] = 0;
+            }
+            if (d == 0) {
+                break;
+            }
+        }
+    }
+
+    if (resolved.size() > 1) {
+        // a union: row-major order, every element once
+        std::sort(result.begin(), result.end(), [rank](const Run &a, const Run &b) {
+            return std::lexicographical_compare(a.offset.data(), a.offset.data() + rank,
+                                                b.offset.data(), b.offset.data() + rank);
+        });
+        std::vector<Run> merged;
+        for (const Run &r : result) {
+            if (!merged.empty()) {
+                Run &prev = merged.back();
+                const bool same_row = std::equal(prev.offset.data(), prev.offset.data() + rank - 1,
+                                                 r.offset.data());
+                const ndsize_t prev_end = prev.offset[rank - 1] + prev.length;
+                if (same_row && r.offset[rank - 1] <= prev_end) {
+                    prev.length = std::max(prev_end, r.offset[rank - 1] + r.length) - prev.offset[rank - 1];
+                    continue;
+                }
+            }
+            merged.push_back(r);
+        }
+        result.swap(merged);
+    }
+    return result;
+}
+
+
+NDSize Selection::shape(const NDSize &extent) const {
+    const std::vector<std::vector<Dim>> resolved = resolve(extent);
+    if (resolved.size() == 1) {
+        NDSize result(extent.size());
+        for (size_t d = 0; d < extent.size(); d++) {
+            result[d] = dim_count(resolved[0][d]);
+        }
+        return result;
+    }
+
+    ndsize_t n = 0;
+    for (const Run &r : runs(extent)) {
+        n += r.length;
+    }
+    return NDSize({n});
+}
+
+
+Selection Selection::within(const NDSize &count, const NDSize &offset) const {
+    Selection result;
+    result.parts = resolve(count);
+    for (std::vector<Dim> &part : result.parts) {
+        for (size_t d = 0; d < part.size(); d++) {
+            const ndsize_t base = offset ? offset[d] : 0;
+            if (part[d].kind == Dim::Kind::Indices) {
+                for (ndsize_t &i : part[d].indices) {
+                    i += base;
+                }
+            } else {
+                part[d].start += base;
+            }
+        }
+    }
+    return result;
+}
+
+} // namespace nix
@@ -0,0 +1,29 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/StringStorage.hpp>
+
+#include <ostream>
+
+namespace nix {
+
+std::string string_storage_to_string(const StringStorage &storage) {
+    switch (storage.mode) {
+        case StringStorage::Mode::Variable:   return "variable";
+        case StringStorage::Mode::Fixed:      return "fixed(" + std::to_string(storage.length) + ")";
+        case StringStorage::Mode::Dictionary: return "dictionary";
+    }
+    return "unknown";
+}
+
+std::ostream &operator<<(std::ostream &out, const StringStorage &storage) {
+    out << string_storage_to_string(storage);
+    return out;
+}
+
+} // namespace nix
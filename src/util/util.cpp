@@ -331,6 +331,52 @@ void applyPolynomial(const std::vector<double> &coefficients,
     }
 }
 
+static void copy_region(const char *src, const NDSize &src_shape,
+                        char *dst, const NDSize &dst_shape,
+                        const NDSize &count, size_t dim, size_t elem_size) {
+    // byte strides of the current dimension
+    size_t src_stride = elem_size, dst_stride = elem_size;
+    for (size_t i = dim + 1; i < count.size(); i++) {
+        src_stride *= static_cast<size_t>(src_shape[i]);
+        dst_stride *= static_cast<size_t>(dst_shape[i]);
+    }
+
+    const size_t n = static_cast<size_t>(count[dim]);
+    if (dim + 1 == count.size()) {
+        memcpy(dst, src, n * elem_size);
+        return;
+    }
+
+    for (size_t k = 0; k < n; k++) {
+        copy_region(src + k * src_stride, src_shape, dst + k * dst_stride, dst_shape,
+                    count, dim + 1, elem_size);
+    }
+}
+
+void copyRegion(const void *src, const NDSize &src_shape, const NDSize &src_offset,
+                void *dst, const NDSize &dst_shape, const NDSize &dst_offset,
+                const NDSize &count, size_t elem_size) {
+    const size_t rank = count.size();
+    if (src_shape.size() != rank || dst_shape.size() != rank ||
+        src_offset.size() != rank || dst_offset.size() != rank) {
+        throw IncompatibleDimensions("Rank of region, source and destination must match", "copyRegion");
+    }
+
+    if (rank == 0 || count.nelms() == 0) {
+        return;
+    }
+
+    size_t src_start = 0, dst_start = 0;
+    for (size_t i = 0; i < rank; i++) {
+        src_start = src_start * static_cast<size_t>(src_shape[i]) + static_cast<size_t>(src_offset[i]);
+        dst_start = dst_start * static_cast<size_t>(dst_shape[i]) + static_cast<size_t>(dst_offset[i]);
+    }
+
+    copy_region(static_cast<const char *>(src) + src_start * elem_size, src_shape,
+                static_cast<char *>(dst) + dst_start * elem_size, dst_shape,
+                count, 0, elem_size);
+}
+
 bool looksLikeUUID(const std::string &id) {
     // we don't want a complete check, just a glance
     // uuid form is: 8-4-4-4-12 = 36 [8, 13, 18, 23, ]
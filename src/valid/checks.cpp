@@ -114,18 +114,22 @@ bool positionsMatchRefs::operator()(const std::vector<double> &positions) const
 }
 
 
+dimTicksMatchData::dimTicksMatchData(const DataArray &data) : extent(data.dataExtent()) {
+}
+
+
 bool dimTicksMatchData::operator()(const std::vector<Dimension> &dims) const {
     bool mismatch = false;
     auto it = dims.begin();
     while (!mismatch && it != dims.end()) {
         if ((*it).dimensionType() == DimensionType::Range) {
             ndsize_t dimIndex = (*it).index() - 1;
-            if (dimIndex >= data.dataExtent().size()) {
+            if (dimIndex >= extent.size()) {
                 break;
             }
             auto dim = (*it).asRangeDimension();
             size_t idx = check::fits_in_size_t(dimIndex, "Cannot check ticks: dimension bigger than size_t.");
-            mismatch = !(dim.ticks().size() == data.dataExtent()[idx]);
+            mismatch = !(dim.tickCount() == extent[idx]);
         }
         ++it;
     }
@@ -133,18 +137,23 @@ bool dimTicksMatchData::operator()(const std::vector<Dimension> &dims) const {
 }
 
 
+dimLabelsMatchData::dimLabelsMatchData(const DataArray &data) : extent(data.dataExtent()) {
+}
+
+
 bool dimLabelsMatchData::operator()(const std::vector<Dimension> &dims) const {
     bool mismatch = false;
     auto it = dims.begin();
     while (!mismatch && it != dims.end()) {
         if ((*it).dimensionType() == DimensionType::Set) {
             ndsize_t dimIndex = (*it).index() - 1;
-            if (dimIndex >= data.dataExtent().size()) {
+            if (dimIndex >= extent.size()) {
                 break;
             }
             auto dim = (*it).asSetDimension();
             size_t idx = check::fits_in_size_t(dimIndex, "Cannot check labels: dimension bigger than size_t.");
-            mismatch = dim.labels().size() > 0 && !(dim.labels().size() == data.dataExtent()[idx]);
+            const ndsize_t nlabels = dim.labelCount();
+            mismatch = nlabels > 0 && !(nlabels == extent[idx]);
         }
         ++it;
     }
@@ -41,11 +41,16 @@ std::vector<Message> Result::getErrors() const {
     return errors;
 }
 
+std::vector<Message> Result::getSkipped() const {
+    return skipped;
+}
+
 Result Result::concat(const Result &result) {
     errors.reserve(errors.size() + result.errors.size());
     errors.insert(errors.end(), result.errors.begin(), result.errors.end());
     warnings.reserve(warnings.size() + result.warnings.size());
     warnings.insert(warnings.end(), result.warnings.begin(), result.warnings.end());
+    skipped.insert(skipped.end(), result.skipped.begin(), result.skipped.end());
 
     return *this;
 }
@@ -60,6 +65,11 @@ Result Result::addWarning(const Message &warning) {
     return *this;
 }
 
+Result Result::addSkipped(const Message &skip) {
+    skipped.push_back(skip);
+    return *this;
+}
+
 bool Result::ok() const {
     return (errors.size() == 0) && (warnings.size() == 0);
 }
@@ -72,5 +82,9 @@ bool Result::hasWarnings() const {
     return warnings.size() > 0;
 }
 
+bool Result::hasSkipped() const {
+    return skipped.size() > 0;
+}
+
 } // namespace valid
 } // namespace nix
@@ -99,18 +99,24 @@ Result validate(const Block &block) {
 
 Result validate(const DataArray &data_array) {
     Result result_base = validate_entity_with_sources(data_array);
+    const NDSize extent = data_array.dataExtent();
+    auto dimensions = memoize(data_array, &DataArray::dimensions);
+    auto unit = memoize(data_array, &DataArray::unit);
+    auto polynom_coefficients = memoize(data_array, &DataArray::polynomCoefficients);
+    auto expansion_origin = memoize(data_array, &DataArray::expansionOrigin);
+
     Result result = validator({
         must(data_array, &DataArray::dataType, notEqual<DataType>(DataType::Nothing), "data type is not set!"),
-        must(data_array, &DataArray::dimensionCount, isEqual<size_t>(data_array.dataExtent().size()), "data dimensionality does not match number of defined dimensions!", {
-            could(data_array, &DataArray::dimensions, notEmpty(), {
-                must(data_array, &DataArray::dimensions, dimTicksMatchData(data_array), "in some of the Range dimensions the number of ticks differs from the number of data entries along the corresponding data dimension!"),
-                must(data_array, &DataArray::dimensions, dimLabelsMatchData(data_array), "in some of the Set dimensions the number of labels differs from the number of data entries along the corresponding data dimension!") }) }),
-        could(data_array, &DataArray::unit, notFalse(), {
-            should(data_array, &DataArray::unit, isValidUnit(), "Unit is not SI or composite of SI units.") }),
-        could(data_array, &DataArray::polynomCoefficients, notEmpty(), {
-            should(data_array, &DataArray::expansionOrigin, notFalse(), "polynomial coefficients for calibration are set, but expansion origin is missing!") }),
-        could(data_array, &DataArray::expansionOrigin, notFalse(), {
-            should(data_array, &DataArray::polynomCoefficients, notEmpty(), "expansion origin for calibration is set, but polynomial coefficients are missing!") })
+        must(data_array, &DataArray::dimensionCount, isEqual<size_t>(extent.size()), "data dimensionality does not match number of defined dimensions!", {
+            could(data_array, dimensions, notEmpty(), {
+                must(data_array, dimensions, dimTicksMatchData(extent), "in some of the Range dimensions the number of ticks differs from the number of data entries along the corresponding data dimension!"),
+                must(data_array, dimensions, dimLabelsMatchData(extent), "in some of the Set dimensions the number of labels differs from the number of data entries along the corresponding data dimension!") }) }),
+        could(data_array, unit, notFalse(), {
+            should(data_array, unit, isValidUnit(), "Unit is not SI or composite of SI units.") }),
+        could(data_array, polynom_coefficients, notEmpty(), {
+            should(data_array, expansion_origin, notFalse(), "polynomial coefficients for calibration are set, but expansion origin is missing!") }),
+        could(data_array, expansion_origin, notFalse(), {
+            should(data_array, polynom_coefficients, notEmpty(), "expansion origin for calibration is set, but polynomial coefficients are missing!") })
     });
 
     return result.concat(result_base);
@@ -118,21 +124,26 @@ Result validate(const DataArray &data_array) {
 
 Result validate(const Tag &tag) {
     Result result_base = validate_entity_with_sources(tag);
+    auto position = memoize(tag, &Tag::position);
+    auto extent = memoize(tag, &Tag::extent);
+    auto references = memoize(tag, &Tag::references);
+    auto units = memoize(tag, &Tag::units);
+
     Result result = validator({
-        must(tag, &Tag::position, notEmpty(), "position is not set!"),
-        could(tag, &Tag::references, notEmpty(), {
-            must(tag, &Tag::position, positionsMatchRefs(tag.references()),
+        must(tag, position, notEmpty(), "position is not set!"),
+        could(tag, references, notEmpty(), {
+            must(tag, position, positionsMatchRefs(references()),
                 "number of entries in position does not match number of dimensions in all referenced DataArrays!"),
-            could(tag, &Tag::extent, notEmpty(), {
-                must(tag, &Tag::position, extentsMatchPositions(tag.extent()), "Number of entries in position and extent do not match!"),
-                must(tag, &Tag::extent, extentsMatchRefs(tag.references()),
+            could(tag, extent, notEmpty(), {
+                must(tag, position, extentsMatchPositions(extent()), "Number of entries in position and extent do not match!"),
+                must(tag, extent, extentsMatchRefs(references()),
                     "number of entries in extent does not match number of dimensions in all referenced DataArrays!") })
         }),
         // check units for validity
-        could(tag, &Tag::units, notEmpty(), {
-            must(tag, &Tag::units, isValidUnit(), "Unit is invalid: not an atomic SI. Note: So far composite units are not supported!"),
-            must(tag, &Tag::references, tagRefsHaveUnits(tag.units()), "Some of the referenced DataArrays' dimensions don't have units where the tag has. Make sure that all references have the same number of dimensions as the tag has units and that each dimension has a unit set."),
-                must(tag, &Tag::references, tagUnitsMatchRefsUnits(tag.units()), "Some of the referenced DataArrays' dimensions have units that are not convertible to the units set in tag. Note: So far composite SI units are not supported!")}),
+        could(tag, units, notEmpty(), {
+            must(tag, units, isValidUnit(), "Unit is invalid: not an atomic SI. Note: So far composite units are not supported!"),
+            must(tag, references, tagRefsHaveUnits(units()), "Some of the referenced DataArrays' dimensions don't have units where the tag has. Make sure that all references have the same number of dimensions as the tag has units and that each dimension has a unit set."),
+                must(tag, references, tagUnitsMatchRefsUnits(units()), "Some of the referenced DataArrays' dimensions have units that are not convertible to the units set in tag. Note: So far composite SI units are not supported!")}),
     });
 
     return result.concat(result_base);
@@ -140,12 +151,14 @@ Result validate(const Tag &tag) {
 
 Result validate(const Property &property) {
     Result result_base = validate_entity(property);
+    auto unit = memoize(property, &Property::unit);
+
     Result result = validator({
         must(property, &Property::name, notEmpty(), "name is not set!"),
         could(property, &Property::valueCount, notFalse(), {
-            should(property, &Property::unit, notFalse(), "values are set, but unit is missing!") }),
-        could(property, &Property::unit, notFalse(), {
-            must(property, &Property::unit, isValidUnit(), "Unit is not SI or composite of SI units.") })
+            should(property, unit, notFalse(), "values are set, but unit is missing!") }),
+        could(property, unit, notFalse(), {
+            must(property, unit, isValidUnit(), "Unit is not SI or composite of SI units.") })
         // TODO: dataType to be tested too?
     });
 
@@ -154,19 +167,24 @@ Result validate(const Property &property) {
 
 Result validate(const MultiTag &multi_tag) {
     Result result_base = validate_entity_with_sources(multi_tag);
+    auto positions = memoize(multi_tag, &MultiTag::positions);
+    auto extents = memoize(multi_tag, &MultiTag::extents);
+    auto references = memoize(multi_tag, &MultiTag::references);
+    auto units = memoize(multi_tag, &MultiTag::units);
+
     Result result = validator({
-        must(multi_tag, &MultiTag::positions, notFalse(), "positions are not set!"),
+        must(multi_tag, positions, notFalse(), "positions are not set!"),
         // check units for validity
-        could(multi_tag, &MultiTag::units, notEmpty(), {
-            must(multi_tag, &MultiTag::units, isValidUnit(), "Some of the units in tag are invalid: not an atomic SI. Note: So far composite SI units are not supported!"),
-            must(multi_tag, &MultiTag::references, tagUnitsMatchRefsUnits(multi_tag.units()), "Some of the referenced DataArrays' dimensions have units that are not convertible to the units set in tag. Note: So far composite SI units are not supported!")}),
+        could(multi_tag, units, notEmpty(), {
+            must(multi_tag, units, isValidUnit(), "Some of the units in tag are invalid: not an atomic SI. Note: So far composite SI units are not supported!"),
+            must(multi_tag, references, tagUnitsMatchRefsUnits(units()), "Some of the referenced DataArrays' dimensions have units that are not convertible to the units set in tag. Note: So far composite SI units are not supported!")}),
         // check positions & extents
-        could(multi_tag, &MultiTag::extents, notFalse(), {
-            must(multi_tag, &MultiTag::positions, extentsMatchPositions(multi_tag.extents()), "Number of entries in positions and extents do not match!") }),
-        could(multi_tag, &MultiTag::references, notEmpty(), {
-            could(multi_tag, &MultiTag::extents, notFalse(), {
-                must(multi_tag, &MultiTag::extents, extentsMatchRefs(multi_tag.references()), "number of entries (in 2nd dim) in extents does not match number of dimensions in all referenced DataArrays!") }),
-            must(multi_tag, &MultiTag::positions, positionsMatchRefs(multi_tag.references()), "number of entries (in 2nd dim) in positions does not match number of dimensions in all referenced DataArrays!") })
+        could(multi_tag, extents, notFalse(), {
+            must(multi_tag, positions, extentsMatchPositions(extents()), "Number of entries in positions and extents do not match!") }),
+        could(multi_tag, references, notEmpty(), {
+            could(multi_tag, extents, notFalse(), {
+                must(multi_tag, extents, extentsMatchRefs(references()), "number of entries (in 2nd dim) in extents does not match number of dimensions in all referenced DataArrays!") }),
+            must(multi_tag, positions, positionsMatchRefs(references()), "number of entries (in 2nd dim) in positions does not match number of dimensions in all referenced DataArrays!") })
     });
 
     return result.concat(result_base);
@@ -179,25 +197,29 @@ Result validate(const Dimension &dim) {
 }
 
 Result validate(const RangeDimension &range_dim) {
+    auto unit = memoize(range_dim, &RangeDimension::unit);
+
     return validator({
         must(range_dim, &RangeDimension::index, notSmaller(1), "index is not set to valid value (size_t > 0)!"),
-        must(range_dim, &RangeDimension::ticks, notEmpty(), "ticks are not set!"),
+        must(range_dim, &RangeDimension::tickCount, notFalse(), "ticks are not set!"),
         must(range_dim, &RangeDimension::dimensionType, isEqual<DimensionType>(DimensionType::Range), "dimension type is not correct!"),
-        could(range_dim, &RangeDimension::unit, notFalse(), {
-            must(range_dim, &RangeDimension::unit, isAtomicUnit(), "Unit is set but not an atomic SI. Note: So far composite units are not supported!") }),
+        could(range_dim, unit, notFalse(), {
+            must(range_dim, unit, isAtomicUnit(), "Unit is set but not an atomic SI. Note: So far composite units are not supported!") }),
         must(range_dim, &RangeDimension::ticks, isSorted(), "Ticks are not sorted!")
     });
 }
 
 Result validate(const SampledDimension &sampled_dim) {
+    auto unit = memoize(sampled_dim, &SampledDimension::unit);
+
     return validator({
         must(sampled_dim, &SampledDimension::index, notSmaller(1), "index is not set to valid value (size_t > 0)!"),
         must(sampled_dim, &SampledDimension::samplingInterval, isGreater(0), "samplingInterval is not set to valid value (> 0)!"),
         must(sampled_dim, &SampledDimension::dimensionType, isEqual<DimensionType>(DimensionType::Sample), "dimension type is not correct!"),
         could(sampled_dim, &SampledDimension::offset, notFalse(), {
-            should(sampled_dim, &SampledDimension::unit, isAtomicUnit(), "offset is set, but no valid unit set!") }),
-        could(sampled_dim, &SampledDimension::unit, notFalse(), {
-            must(sampled_dim, &SampledDimension::unit, isAtomicUnit(), "Unit is set but not an atomic SI. Note: So far composite units are not supported!") })
+            should(sampled_dim, unit, isAtomicUnit(), "offset is set, but no valid unit set!") }),
+        could(sampled_dim, unit, notFalse(), {
+            must(sampled_dim, unit, isAtomicUnit(), "Unit is set but not an atomic SI. Note: So far composite units are not supported!") })
     });
 }
 
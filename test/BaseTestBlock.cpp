@@ -9,6 +9,7 @@
 #include "BaseTestBlock.hpp"
 
 #include <iterator>
+#include <set>
 #include <boost/math/constants/constants.hpp>
 
 #include <nix/hydra/multiArray.hpp>
@@ -287,6 +288,211 @@ void BaseTestBlock::testTagAccess() {
 }
 
 
+void BaseTestBlock::testTagsOverlapping() {
+    Tag a = block.createTag("tag_a", "segment", {0.0, 1.0});
+    a.extent({0.5, 1.0});
+    a.units({"s", "mV"});
+    Tag b = block.createTag("tag_b", "segment", {2000.0, 1.0});
+    b.units({"ms", "mV"});
+    Tag c = block.createTag("tag_c", "segment", {3.0});
+    c.extent({2.0});
+    c.units({"s"});
+    // no units: taken as is
+    block.createTag("tag_d", "segment", {10.0, 1.0});
+
+    auto names = [](const std::vector<Tag> &tags) {
+        std::set<std::string> result;
+        for (const Tag &t : tags) {
+            result.insert(t.name());
+        }
+        return result;
+    };
+
+    std::set<std::string> expected = {"tag_a", "tag_b"};
+    CPPUNIT_ASSERT(names(block.tagsOverlapping(0.2, 2.5, 0, "s")) == expected);
+    expected = {"tag_c"};
+    CPPUNIT_ASSERT(names(block.tagsOverlapping(4500, 6000, 0, "ms")) == expected);
+    CPPUNIT_ASSERT(block.tagsOverlapping(5.5, 6, 0, "s").empty());
+
+    // tag_c has no second dimension
+    expected = {"tag_a", "tag_b", "tag_d"};
+    CPPUNIT_ASSERT(names(block.tagsOverlapping(0.5, 1.5, 1)) == expected);
+
+    IntervalIndex index = block.tagIntervalIndex(0, "s");
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(4), index.size());
+    CPPUNIT_ASSERT_THROW(block.tagIntervalIndex(1, "s"), IncompatibleDimensions);
+
+    // without a unit, the ms of tag_b are scaled to the s of tag_a
+    index = block.tagIntervalIndex(0);
+    CPPUNIT_ASSERT_EQUAL(std::string("s"), index.unit());
+    expected = {"tag_a", "tag_b"};
+    CPPUNIT_ASSERT(names(block.tagsOverlapping(0.2, 2.5)) == expected);
+    expected = {"tag_c"};
+    CPPUNIT_ASSERT(names(block.tagsOverlapping(4.5, 6)) == expected);
+
+    Tag e = block.createTag("tag_e", "segment", {1.0});
+    e.units({"Hz"});
+    CPPUNIT_ASSERT_THROW(block.tagIntervalIndex(0), IncompatibleDimensions);
+}
+
+
+void BaseTestBlock::testVirtualDataArray() {
+    // two sessions of two channels, in different blocks
+    const ndsize_t channels = 2, first_len = 100, second_len = 50;
+    std::vector<int16_t> first_data(channels * first_len), second_data(channels * second_len);
+    for (size_t i = 0; i < first_data.size(); i++) {
+        first_data[i] = static_cast<int16_t>(i);
+    }
+    for (size_t i = 0; i < second_data.size(); i++) {
+        second_data[i] = static_cast<int16_t>(1000 + i);
+    }
+    auto session = [&](Block b, const std::string &name, std::vector<int16_t> &data, ndsize_t len, double offset) {
+        const NDSize extent({channels, len});
+        DataArray da = b.createDataArray(name, "session", DataType::Int16, extent);
+        da.setData(DataType::Int16, data.data(), extent, {0, 0});
+        da.polynomCoefficients({1.0, 0.5});
+        da.unit("mV");
+        da.appendSetDimension().labels({"ch1", "ch2"});
+        SampledDimension time = da.appendSampledDimension(0.001);
+        time.unit("s");
+        time.offset(offset);
+        da.metadata(section);
+        return da;
+    };
+    DataArray first = session(block, "session_1", first_data, first_len, 5.0);
+    DataArray second = session(block_other, "session_2", second_data, second_len, 5.1);
+
+    DataArray joined = block.concatenateDataArrays("sessions", "joined", {first, second}, 1);
+    CPPUNIT_ASSERT(joined.dataExtent() == NDSize({channels, first_len + second_len}));
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(2), joined.dataLayout().virtual_sources);
+    CPPUNIT_ASSERT(joined.dataType() == DataType::Int16);
+    CPPUNIT_ASSERT(*joined.unit() == "mV");
+    CPPUNIT_ASSERT(joined.metadata().id() == section.id());
+
+    std::vector<double> values(channels * (first_len + second_len));
+    joined.getData(DataType::Double, values.data(), joined.dataExtent(), {0, 0});
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0 + 0.5 * first_data[first_len + 7], values[first_len + second_len + 7], 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0 + 0.5 * second_data[3], values[first_len + 3], 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0 + 0.5 * second_data[second_len + 49],
+                                 values[2 * (first_len + second_len) - 1], 1e-9);
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(2), joined.dimensionCount());
+    CPPUNIT_ASSERT(joined.getDimension(1).asSetDimension().labels().size() == 2);
+    SampledDimension time = joined.getDimension(2).asSampledDimension();
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.001, time.samplingInterval(), 1e-15);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(5.0, *time.offset(), 1e-12);
+
+    // sessions with a gap between them, or overlapping ones, are joined along their sample times
+    DataArray later = session(block_other, "session_3", second_data, second_len, 20.0);
+    DataArray gap = block.concatenateDataArrays("gap", "joined", {first, later}, 1);
+    CPPUNIT_ASSERT(gap.getDimension(2).dimensionType() == DimensionType::Range);
+    RangeDimension gap_time = gap.getDimension(2).asRangeDimension();
+    CPPUNIT_ASSERT(*gap_time.unit() == "s");
+    std::vector<double> gap_ticks = gap_time.ticks();
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(first_len + second_len), gap_ticks.size());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(5.0, gap_ticks[0], 1e-12);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(5.099, gap_ticks[first_len - 1], 1e-12);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(20.0, gap_ticks[first_len], 1e-12);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(20.049, gap_ticks.back(), 1e-12);
+
+    gap_ticks = block.concatenateDataArrays("overlap", "joined", {later, first}, 1)
+        .getDimension(2).asRangeDimension().ticks();
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(20.049, gap_ticks[second_len - 1], 1e-12);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(20.05, gap_ticks[second_len], 1e-12);
+
+    // ticks of each session continue where the previous one ended
+    DataArray ticks_a = block.createDataArray("ticks_a", "session", DataType::Double, NDSize({3}));
+    ticks_a.appendRangeDimension({0.0, 0.5, 1.0}).unit("s");
+    DataArray ticks_b = block_other.createDataArray("ticks_b", "session", DataType::Double, NDSize({2}));
+    ticks_b.appendRangeDimension({0.0, 2.0}).unit("s");
+    DataArray ticks = block.concatenateDataArrays("ticks", "joined", {ticks_a, ticks_b}, 0);
+    const std::vector<double> joined_ticks = ticks.getDimension(1).asRangeDimension().ticks();
+    const std::vector<double> expected_ticks = {0.0, 0.5, 1.0, 1.5, 3.5};
+    CPPUNIT_ASSERT(joined_ticks == expected_ticks);
+
+    // explicit slices; elements not mapped read as 0
+    VirtualSlice slice;
+    slice.source = second;
+    slice.count = NDSize({1, 10});
+    slice.source_offset = NDSize({1, 0});
+    slice.offset = NDSize({0, 5});
+    DataArray picked = block.createVirtualDataArray("picked", "slice", DataType::Int16, NDSize({1, 20}), {slice});
+    std::vector<int16_t> raw(20);
+    picked.getDataDirect(DataType::Int16, raw.data(), NDSize({1, 20}), {0, 0});
+    CPPUNIT_ASSERT_EQUAL(static_cast<int16_t>(0), raw[0]);
+    CPPUNIT_ASSERT_EQUAL(second_data[second_len], raw[5]);
+    CPPUNIT_ASSERT_EQUAL(second_data[second_len + 9], raw[14]);
+    CPPUNIT_ASSERT_EQUAL(static_cast<int16_t>(0), raw[15]);
+
+    // a stored copy
+    DataArray stored = block.materializeDataArray(joined, "sessions_stored");
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(0), stored.dataLayout().virtual_sources);
+    std::vector<double> copied(values.size());
+    stored.getData(DataType::Double, copied.data(), stored.dataExtent(), {0, 0});
+    CPPUNIT_ASSERT(copied == values);
+    CPPUNIT_ASSERT(stored.getDimension(2).asSampledDimension().offset() == time.offset());
+    CPPUNIT_ASSERT(stored.metadata().id() == section.id());
+
+    // mismatching sources
+    DataArray coarse = block_other.createDataArray("coarse", "session", DataType::Int16, NDSize({2, 10}));
+    coarse.polynomCoefficients({1.0, 0.5});
+    coarse.unit("mV");
+    coarse.appendSetDimension();
+    coarse.appendSampledDimension(0.002).unit("s");
+    CPPUNIT_ASSERT_THROW(block.concatenateDataArrays("bad", "joined", {first, coarse}, 1),
+                         IncompatibleDimensions);
+    CPPUNIT_ASSERT_THROW(block.concatenateDataArrays("bad", "joined", {first, ticks_a}, 1),
+                         IncompatibleDimensions);
+    CPPUNIT_ASSERT_THROW(block.concatenateDataArrays("bad", "joined", {first, second}, 2), InvalidRank);
+    CPPUNIT_ASSERT_THROW(block.concatenateDataArrays("sessions", "joined", {first, second}, 1), DuplicateName);
+    slice.count = NDSize({1, 60});
+    CPPUNIT_ASSERT_THROW(block.createVirtualDataArray("bad", "slice", DataType::Int16, NDSize({1, 100}), {slice}),
+                         OutOfBounds);
+    CPPUNIT_ASSERT(!block.hasDataArray("bad"));
+
+    // sources the backend cannot map leave nothing behind
+    std::vector<std::string> words = {"go", "stop"};
+    DataArray dict = block.createDataArray("dict", "labels", words, DataType::String, Compression::Auto,
+                                           StringStorage::dictionary());
+    VirtualSlice coded;
+    coded.source = dict;
+    coded.count = NDSize({2});
+    CPPUNIT_ASSERT_THROW(block.createVirtualDataArray("bad", "slice", DataType::String, NDSize({2}), {coded}),
+                         std::invalid_argument);
+    CPPUNIT_ASSERT(!block.hasDataArray("bad"));
+}
+
+
+void BaseTestBlock::testVirtualDataArrayFiles() {
+    const NDSize extent({4});
+    std::vector<double> here = {1.0, 2.0, 3.0, 4.0}, there = {5.0, 6.0, 7.0, 8.0};
+    DataArray local = block.createDataArray("local", "session", here);
+    {
+        File other = File::open("test_block_virtual_source.h5", FileMode::Overwrite);
+        Block b = other.createBlock("session_2", "session");
+        DataArray remote = b.createDataArray("remote", "session", there);
+        block.concatenateDataArrays("joined", "joined", {local, remote}, 0);
+
+        // metadata of the other file is not linked
+        remote.metadata(other.createSection("recording", "recording"));
+        CPPUNIT_ASSERT(!block.concatenateDataArrays("remote_joined", "joined", {remote}, 0).metadata());
+        CPPUNIT_ASSERT(!block.materializeDataArray(remote, "remote_stored").metadata());
+        other.close();
+    }
+
+    DataArray joined = block.getDataArray("joined");
+    std::vector<double> values;
+    joined.getData(values);
+    const std::vector<double> expected = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0};
+    CPPUNIT_ASSERT(values == expected);
+
+    DataArray stored = block.materializeDataArray(joined, "stored");
+    values.clear();
+    stored.getData(values);
+    CPPUNIT_ASSERT(values == expected);
+}
+
+
 void BaseTestBlock::testMultiTagAccess() {
     std::vector<std::string> names = { "tag_a", "tag_b", "tag_c", "tag_d", "tag_e" };
     MultiTag mtag, m;
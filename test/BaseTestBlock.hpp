@@ -34,6 +34,9 @@ public:
     void testDataArrayAccess();
     void testDataFrameAccess();
     void testTagAccess();
+    void testTagsOverlapping();
+    void testVirtualDataArray();
+    void testVirtualDataArrayFiles();
     void testMultiTagAccess();
     void testGroupAccess();
 
@@ -13,6 +13,9 @@
 #include <iterator>
 #include <stdexcept>
 #include <limits>
+#include <numeric>
+#include <future>
+#include <atomic>
 
 #include <boost/math/constants/constants.hpp>
 #include <boost/math/tools/rational.hpp>
@@ -21,6 +24,7 @@
 #include <nix/util/util.hpp>
 #include <nix/valid/validate.hpp>
 #include <nix/hydra/multiArray.hpp>
+#include <nix/NDArray.hpp>
 
 #include "BaseTestDataArray.hpp"
 
@@ -259,6 +263,778 @@ void BaseTestDataArray::testData() {
 }
 
 
+void BaseTestDataArray::testDataAsync() {
+    nix::DataArray da = block.createDataArray("async", "double", nix::DataType::Double, {0});
+
+    std::vector<double> chunk(128);
+    std::vector<std::future<void>> writes;
+    std::vector<std::vector<double>> chunks;
+    for (size_t k = 0; k < 8; k++) {
+        std::iota(chunk.begin(), chunk.end(), k * 128.0);
+        chunks.push_back(chunk);
+    }
+
+    da.dataExtent({8 * 128});
+    for (size_t k = 0; k < chunks.size(); k++) {
+        writes.push_back(da.setDataAsync(chunks[k], {k * 128}));
+    }
+
+    // reads are queued after the writes, ordering is guaranteed
+    std::vector<double> out;
+    std::future<void> read = da.getDataAsync(out, {8 * 128}, {0});
+    read.get();
+
+    for (auto &w : writes) {
+        CPPUNIT_ASSERT_NO_THROW(w.get());
+    }
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(8 * 128), out.size());
+    for (size_t i = 0; i < out.size(); i++) {
+        CPPUNIT_ASSERT_EQUAL(static_cast<double>(i), out[i]);
+    }
+
+    // errors are delivered through the future
+    std::vector<double> oob;
+    std::future<void> bad = da.getDataAsync(oob, {16}, {8 * 128});
+    CPPUNIT_ASSERT_THROW(bad.get(), std::exception);
+
+    // operations may submit operations and wait on them
+    nix::IOExecutor &executor = nix::IOExecutor::instance();
+    std::future<double> nested = executor.submit([&executor, &da]() {
+        CPPUNIT_ASSERT(executor.onIOThread());
+        double first = executor.submit([&da]() {
+            std::vector<double> values;
+            da.getData(values);
+            return values[1];
+        }).get();
+        return first + da.statistics(0, 4).max[0];
+    });
+    CPPUNIT_ASSERT_EQUAL(1.0 + 8 * 128 - 1, nested.get());
+    CPPUNIT_ASSERT(!executor.onIOThread());
+
+    nix::IOExecutor::instance().wait();
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), nix::IOExecutor::instance().pending());
+}
+
+
+void BaseTestDataArray::testDataParallel() {
+    const nix::NDSize extent({96, 4000});
+    std::vector<int16_t> data(extent.nelms());
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<int16_t>((i % 4000) / 10 - (i / 4000) * 3);
+    }
+
+    nix::DataArray da = block.createDataArray("parallel", "int16", nix::DataType::Int16, extent,
+                                              nix::Compression::DeflateNormal);
+    const nix::NDSize chunks = da.dataChunks();
+    CPPUNIT_ASSERT(chunks.nelms() < extent.nelms());
+
+    // the split is not chunk aligned: partial chunks on both sides
+    const nix::NDSize left({96, 2500});
+    const nix::NDSize right({96, 1500});
+    std::vector<int16_t> buffer(left.nelms());
+    for (size_t r = 0; r < 96; r++) {
+        std::copy_n(data.begin() + r * 4000, 2500, buffer.begin() + r * 2500);
+    }
+    da.setDataParallel(nix::DataType::Int16, buffer.data(), left, {0, 0}, 3);
+    buffer.resize(right.nelms());
+    for (size_t r = 0; r < 96; r++) {
+        std::copy_n(data.begin() + r * 4000 + 2500, 1500, buffer.begin() + r * 1500);
+    }
+    da.setDataParallel(nix::DataType::Int16, buffer.data(), right, {0, 2500}, 2);
+
+    std::vector<int16_t> out(data.size());
+    da.getData(nix::DataType::Int16, out.data(), extent, {0, 0});
+    CPPUNIT_ASSERT(data == out);
+    nix::StorageLayout layout = da.dataLayout();
+    CPPUNIT_ASSERT(layout.storage_size < extent.nelms() * sizeof(int16_t));
+    CPPUNIT_ASSERT_EQUAL(std::string("deflate 6"), layout.filters.at(0));
+
+    // data that must be converted takes the normal path
+    std::vector<double> converted(data.begin(), data.end());
+    nix::DataArray dd = block.createDataArray("parallel_float", "float", nix::DataType::Float, extent,
+                                              nix::Compression::DeflateNormal);
+    dd.setDataParallel(nix::DataType::Double, converted.data(), extent, {0, 0});
+    std::vector<double> back(converted.size());
+    dd.getData(nix::DataType::Double, back.data(), extent, {0, 0});
+    CPPUNIT_ASSERT(converted == back);
+
+    // same as setData
+    nix::DataArray plain = block.createDataArray("parallel_plain", "int16", nix::DataType::Int16, extent);
+    plain.setDataParallel(nix::DataType::Int16, data.data(), extent, {0, 0});
+    plain.getData(nix::DataType::Int16, out.data(), extent, {0, 0});
+    CPPUNIT_ASSERT(data == out);
+
+    CPPUNIT_ASSERT_THROW(da.setDataParallel(nix::DataType::Int16, data.data(), extent, {1, 0}), std::exception);
+}
+
+void BaseTestDataArray::testGetDataParallel() {
+    const nix::NDSize extent({96, 4000});
+    std::vector<int16_t> data(extent.nelms());
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<int16_t>((i % 4000) / 10 - (i / 4000) * 3);
+    }
+
+    nix::DataArray da = block.createDataArray("parallel", "int16", nix::DataType::Int16, extent,
+                                              nix::Compression::DeflateNormal);
+    da.setData(nix::DataType::Int16, data.data(), extent, {0, 0});
+    nix::DataArray plain = block.createDataArray("parallel_plain", "int16", nix::DataType::Int16, extent);
+    plain.setData(nix::DataType::Int16, data.data(), extent, {0, 0});
+
+    // parallel reads, of everything and of an unaligned region
+    std::vector<int16_t> all(data.size());
+    da.getDataParallel(nix::DataType::Int16, all.data(), extent, {0, 0}, 3);
+    CPPUNIT_ASSERT(data == all);
+
+    const nix::NDSize region({50, 1777});
+    const nix::NDSize at({7, 1111});
+    std::vector<int16_t> part(region.nelms());
+    da.getDataParallel(nix::DataType::Int16, part.data(), region, at, 2);
+    for (size_t r = 0; r < 50; r++) {
+        for (size_t c = 0; c < 1777; c++) {
+            CPPUNIT_ASSERT_EQUAL(data[(r + 7) * 4000 + c + 1111], part[r * 1777 + c]);
+        }
+    }
+
+    // converted and calibrated
+    std::vector<double> scaled(region.nelms());
+    da.polynomCoefficients({1.0, 0.5});
+    da.getDataParallel(nix::DataType::Double, scaled.data(), region, at);
+    for (size_t i = 0; i < part.size(); i++) {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0 + 0.5 * part[i], scaled[i], 1e-9);
+    }
+    da.polynomCoefficients(nix::none);
+
+    // chunks that were never written read as fill value
+    nix::DataArray sparse = block.createDataArray("parallel_sparse", "int16", nix::DataType::Int16, extent,
+                                                  nix::Compression::DeflateNormal);
+    std::vector<int16_t> ones(region.nelms(), 1);
+    sparse.setData(nix::DataType::Int16, ones.data(), region, at);
+    sparse.getDataParallel(nix::DataType::Int16, all.data(), extent, {0, 0});
+    CPPUNIT_ASSERT_EQUAL(static_cast<long>(region.nelms()), static_cast<long>(std::count(all.begin(), all.end(), 1)));
+    CPPUNIT_ASSERT_EQUAL(static_cast<int16_t>(1), all[7 * 4000 + 1111]);
+
+    // uncompressed data takes the normal path
+    std::fill(all.begin(), all.end(), 0);
+    plain.getDataParallel(nix::DataType::Int16, all.data(), extent, {0, 0});
+    CPPUNIT_ASSERT(data == all);
+
+    std::vector<double> series;
+    array3.getDataParallel(series, {20}, {0});
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(20), series.size());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.3 * 19, series[19], 1e-12);
+}
+
+
+void BaseTestDataArray::testChunkIterator() {
+    const nix::NDSize extent({8, 100000});
+    std::vector<int32_t> data(extent.nelms());
+    std::iota(data.begin(), data.end(), 0);
+
+    nix::DataArray da = block.createDataArray("stream", "int32", nix::DataType::Int32, extent,
+                                              nix::Compression::DeflateNormal);
+    da.setData(nix::DataType::Int32, data.data(), extent, {0, 0});
+    const nix::NDSize chunks = da.dataChunks();
+    CPPUNIT_ASSERT(chunks[1] < extent[1]);
+
+    // every element is read once, in chunk aligned steps
+    nix::IOTrace::enable();
+    file.resetIOStats();
+
+    nix::ChunkIterator it(da, 1, 2);
+    CPPUNIT_ASSERT(it.dataType() == nix::DataType::Int32);
+    CPPUNIT_ASSERT_EQUAL((extent[1] + 2 * chunks[1] - 1) / (2 * chunks[1]), it.size());
+    std::vector<int32_t> out(data.size());
+    nix::ndsize_t steps = 0;
+    while (it.next()) {
+        CPPUNIT_ASSERT_EQUAL(steps++, it.index());
+        const nix::NDSize &offset = it.offset();
+        const nix::NDSize &count = it.count();
+        CPPUNIT_ASSERT(offset[0] == 0 && count[0] == extent[0]);
+        CPPUNIT_ASSERT_EQUAL(static_cast<nix::ndsize_t>(0), offset[1] % (2 * chunks[1]));
+        const int32_t *values = it.data<int32_t>();
+        for (size_t r = 0; r < count[0]; r++) {
+            std::copy_n(values + r * count[1], count[1], out.begin() + r * extent[1] + offset[1]);
+        }
+    }
+    CPPUNIT_ASSERT_EQUAL(it.size(), steps);
+    CPPUNIT_ASSERT(!it.next());
+    CPPUNIT_ASSERT(out == data);
+
+    nix::IOTrace::enable(false);
+    const nix::IOCounter reads = file.ioStats().operations[nix::IOOperation::DataRead];
+    CPPUNIT_ASSERT_EQUAL(steps, reads.calls);
+    CPPUNIT_ASSERT_EQUAL(extent.nelms() * sizeof(int32_t), reads.bytes);
+    CPPUNIT_ASSERT_THROW(it.data<double>(), std::invalid_argument);
+
+    // a view: the first step ends on a chunk boundary of the array
+    nix::NDSize view_count(2), view_offset(2);
+    view_count[0] = 4;
+    view_count[1] = 3 * chunks[1];
+    view_offset[0] = 2;
+    view_offset[1] = chunks[1] / 2;
+    nix::DataView view(da, view_count, view_offset);
+    // prefetching, nothing else touches the file meanwhile
+    nix::ChunkIterator vit(view, 1, 1, nix::DataType::Nothing, true, true);
+    CPPUNIT_ASSERT_EQUAL(static_cast<nix::ndsize_t>(4), vit.size());
+    nix::ndsize_t covered = 0;
+    while (vit.next()) {
+        const nix::NDSize &offset = vit.offset();
+        const nix::NDSize &count = vit.count();
+        CPPUNIT_ASSERT_EQUAL(covered, offset[1]);
+        if (vit.index() == 0) {
+            CPPUNIT_ASSERT_EQUAL(chunks[1] - chunks[1] / 2, count[1]);
+        }
+        const int32_t *values = vit.data<int32_t>();
+        for (size_t r = 0; r < count[0]; r++) {
+            for (size_t c = 0; c < count[1]; c++) {
+                CPPUNIT_ASSERT_EQUAL(data[(r + 2) * extent[1] + chunks[1] / 2 + offset[1] + c],
+                                     values[r * count[1] + c]);
+            }
+        }
+        covered += count[1];
+    }
+    CPPUNIT_ASSERT_EQUAL(3 * chunks[1], covered);
+
+    // calibration
+    da.polynomCoefficients({1.0, 0.5});
+    nix::ChunkIterator calibrated(da, 0);
+    CPPUNIT_ASSERT(calibrated.dataType() == nix::DataType::Double);
+    CPPUNIT_ASSERT(calibrated.next());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0 + 0.5 * 17, calibrated.data<double>()[17], 1e-9);
+    nix::ChunkIterator raw(da, 0, 1, nix::DataType::Nothing, false);
+    CPPUNIT_ASSERT(raw.dataType() == nix::DataType::Int32);
+    CPPUNIT_ASSERT(raw.next());
+    CPPUNIT_ASSERT_EQUAL(17, raw.data<int32_t>()[17]);
+
+    CPPUNIT_ASSERT_THROW(nix::ChunkIterator(da, 2), nix::InvalidRank);
+    CPPUNIT_ASSERT_THROW(nix::ChunkIterator(da, 0, 0), std::invalid_argument);
+}
+
+
+void BaseTestDataArray::testMapData() {
+    const nix::ndsize_t rows = 4, cols = 50000;
+    const nix::NDSize extent({rows, cols});
+    std::vector<double> a(extent.nelms()), b(extent.nelms());
+    for (size_t i = 0; i < a.size(); i++) {
+        a[i] = static_cast<double>(i % 997);
+        b[i] = static_cast<double>(i / 997);
+    }
+
+    nix::DataArray src_a = block.createDataArray("map_a", "double", nix::DataType::Double, extent,
+                                                 nix::Compression::DeflateNormal);
+    src_a.setData(nix::DataType::Double, a.data(), extent, {0, 0});
+    src_a.appendSetDimension().labels({"a", "b", "c", "d"});
+    nix::SampledDimension time = src_a.appendSampledDimension(0.5);
+    time.unit("ms");
+    time.offset(10.0);
+    nix::Section section = file.createSection("map_metadata", "test");
+    src_a.metadata(section);
+
+    nix::DataArray src_b = block.createDataArray("map_b", "double", nix::DataType::Double, extent,
+                                                 nix::Compression::DeflateNormal);
+    src_b.setData(nix::DataType::Double, b.data(), extent, {0, 0});
+
+    // a three point moving sum along the rows, with a halo of one sample
+    nix::DataArray smooth = block.createDataArray("map_smooth", "double", nix::DataType::Double,
+                                                  nix::NDSize({rows, rows}), nix::Compression::DeflateNormal);
+    nix::MapOptions options;
+    options.axis = 1;
+    options.halo = 1;
+    options.nthreads = 3;
+    options.depth = 4;
+    std::atomic<size_t> calls(0);
+    nix::mapData(src_a, smooth, [&calls](const nix::MapBlock &blk) {
+        calls++;
+        const double *in = blk.input<double>(0);
+        double *out = blk.outputData<double>();
+        const size_t n = static_cast<size_t>(blk.count[1]);
+        const size_t m = static_cast<size_t>(blk.input_count[1]);
+        for (size_t r = 0; r < blk.count[0]; r++) {
+            for (size_t c = 0; c < n; c++) {
+                const size_t k = c + blk.halo_before;
+                double sum = in[r * m + k];
+                sum += k > 0 ? in[r * m + k - 1] : 0.0;
+                sum += k + 1 < m ? in[r * m + k + 1] : 0.0;
+                out[r * n + c] = sum;
+            }
+        }
+    }, options);
+
+    CPPUNIT_ASSERT(smooth.dataExtent() == extent);
+    CPPUNIT_ASSERT(calls > 1);
+    std::vector<double> result(extent.nelms());
+    smooth.getData(nix::DataType::Double, result.data(), extent, {0, 0});
+    for (size_t r = 0; r < rows; r++) {
+        for (size_t c = 0; c < cols; c++) {
+            double expected = a[r * cols + c];
+            expected += c > 0 ? a[r * cols + c - 1] : 0.0;
+            expected += c + 1 < cols ? a[r * cols + c + 1] : 0.0;
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(expected, result[r * cols + c], 1e-9);
+        }
+    }
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<nix::ndsize_t>(2), smooth.dimensionCount());
+    CPPUNIT_ASSERT(smooth.getDimension(1).dimensionType() == nix::DimensionType::Set);
+    CPPUNIT_ASSERT(smooth.getDimension(1).asSetDimension().labels().size() == 4);
+    nix::SampledDimension copied = smooth.getDimension(2).asSampledDimension();
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5, copied.samplingInterval(), 1e-12);
+    CPPUNIT_ASSERT(*copied.unit() == "ms");
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(10.0, *copied.offset(), 1e-12);
+    CPPUNIT_ASSERT(smooth.metadata().id() == section.id());
+
+    // several sources, in float along the first axis
+    nix::DataArray sum = block.createDataArray("map_sum", "float", nix::DataType::Float, extent);
+    nix::MapOptions float_options;
+    float_options.dtype = nix::DataType::Float;
+    nix::mapData({src_a, src_b}, sum, [](const nix::MapBlock &blk) {
+        const float *x = blk.input<float>(0);
+        const float *y = blk.input<float>(1);
+        float *out = blk.outputData<float>();
+        for (size_t i = 0; i < blk.count.nelms(); i++) {
+            out[i] = x[i] + y[i];
+        }
+    }, float_options);
+    std::vector<float> sums(extent.nelms());
+    sum.getData(nix::DataType::Float, sums.data(), extent, {0, 0});
+    for (size_t i = 0; i < sums.size(); i++) {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(a[i] + b[i], sums[i], 1e-3);
+    }
+
+    // errors of the kernel reach the caller
+    CPPUNIT_ASSERT_THROW(nix::mapData(src_a, sum, [](const nix::MapBlock &blk) {
+        blk.outputData<double>();
+    }, float_options), std::invalid_argument);
+    CPPUNIT_ASSERT_THROW(nix::mapData(src_a, src_a, [](const nix::MapBlock &) {}), std::invalid_argument);
+    nix::DataArray other = block.createDataArray("map_other", "double", nix::DataType::Double, nix::NDSize({3}));
+    CPPUNIT_ASSERT_THROW(nix::mapData({src_a, other}, sum, [](const nix::MapBlock &) {}),
+                         nix::IncompatibleDimensions);
+}
+
+void BaseTestDataArray::testSelection() {
+    const nix::ndsize_t channels = 32, samples = 2000;
+    const nix::NDSize extent({channels, samples});
+    std::vector<int32_t> data(extent.nelms());
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<int32_t>(i);
+    }
+    nix::DataArray da = block.createDataArray("selection", "int32", nix::DataType::Int32, extent,
+                                              nix::Compression::DeflateNormal);
+    da.setData(nix::DataType::Int32, data.data(), extent, {0, 0});
+    auto at = [samples](nix::ndsize_t c, nix::ndsize_t s) {
+        return static_cast<int32_t>(c * samples + s);
+    };
+
+    // a channel list and every 10th of the first 1000 samples, in one read
+    nix::Selection sel;
+    sel.indices(0, {17, 3, 30, 4, 17}).slab(1, 5, 100, 10);
+    CPPUNIT_ASSERT(sel.shape(extent) == nix::NDSize({4, 100}));
+    nix::IOTrace::enable();
+    file.resetIOStats();
+    std::vector<int32_t> out(sel.shape(extent).nelms());
+    da.getData(nix::DataType::Int32, out.data(), sel);
+    nix::IOTrace::enable(false);
+    CPPUNIT_ASSERT_EQUAL(static_cast<nix::ndsize_t>(1),
+                         file.ioStats().operations[nix::IOOperation::DataRead].calls);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(400), out.size());
+    const nix::ndsize_t picked[] = {3, 4, 17, 30};
+    for (size_t c = 0; c < 4; c++) {
+        for (size_t k = 0; k < 100; k++) {
+            CPPUNIT_ASSERT_EQUAL(at(picked[c], 5 + k * 10), out[c * 100 + k]);
+        }
+    }
+
+    // index lists in both dimensions, too many combinations for hyperslabs
+    nix::Selection grid;
+    grid.indices(0, {1, 5, 9, 13, 17, 21, 25, 29, 31, 2})
+        .indices(1, {1999, 3, 700, 42, 1000, 8, 1500, 77, 999, 1234});
+    CPPUNIT_ASSERT(grid.shape(extent) == nix::NDSize({10, 10}));
+    boost::multi_array<int32_t, 2> scattered;
+    da.getData(scattered, grid);
+    const nix::ndsize_t rows[] = {1, 2, 5, 9, 13, 17, 21, 25, 29, 31};
+    const nix::ndsize_t cols[] = {3, 8, 42, 77, 700, 999, 1000, 1234, 1500, 1999};
+    for (size_t r = 0; r < 10; r++) {
+        for (size_t s = 0; s < 10; s++) {
+            CPPUNIT_ASSERT_EQUAL(at(rows[r], cols[s]), scattered[r][s]);
+        }
+    }
+
+    // blocks of 3 samples, 8 apart, into a multi_array
+    nix::Selection blocks;
+    blocks.slab(0, 1, 2).slab(1, 100, 4, 8, 3);
+    boost::multi_array<double, 2> values;
+    da.getData(values, blocks);
+    CPPUNIT_ASSERT(values.shape()[0] == 2 && values.shape()[1] == 12);
+    for (size_t c = 0; c < 2; c++) {
+        for (size_t k = 0; k < 12; k++) {
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(at(1 + c, 100 + (k / 3) * 8 + k % 3), values[c][k], 1e-12);
+        }
+    }
+
+    // a union is read as 1-d, in row-major order and without duplicates
+    nix::Selection both = nix::Selection::box({2, 4}, {0, 10});
+    both.unite(nix::Selection::box({1, 4}, {1, 12}));
+    CPPUNIT_ASSERT(both.isUnion());
+    CPPUNIT_ASSERT(both.shape(extent) == nix::NDSize({10}));
+    std::vector<int32_t> united;
+    da.getData(united, both);
+    const std::vector<int32_t> expected = {at(0, 10), at(0, 11), at(0, 12), at(0, 13),
+                                           at(1, 10), at(1, 11), at(1, 12), at(1, 13), at(1, 14), at(1, 15)};
+    CPPUNIT_ASSERT(united == expected);
+
+    // relative to a view
+    nix::DataView view(da, {4, 100}, {10, 500});
+    nix::Selection rel;
+    rel.indices(0, {0, 3}).slab(1, 0, 10, 10);
+    boost::multi_array<int32_t, 2> viewed;
+    view.getData(viewed, rel);
+    CPPUNIT_ASSERT(viewed.shape()[0] == 2 && viewed.shape()[1] == 10);
+    CPPUNIT_ASSERT_EQUAL(at(13, 590), viewed[1][9]);
+    CPPUNIT_ASSERT_THROW(view.getData(viewed, nix::Selection().indices(0, {4})), nix::OutOfBounds);
+
+    // into an NDArray, calibrated
+    da.polynomCoefficients({1.0, 0.5});
+    nix::NDArray nd(nix::DataType::Double, {1});
+    da.getData(nd, nix::Selection().indices(0, {2}).slab(1, 0, 3, 2));
+    CPPUNIT_ASSERT(nd.size() == nix::NDSize({1, 3}));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0 + 0.5 * at(2, 4), nd.get<double>(2), 1e-9);
+
+    // strings
+    std::vector<std::string> words = {"a", "bb", "ccc", "dddd", "eeeee"};
+    nix::DataArray text = block.createDataArray("selection_text", "text", words);
+    std::vector<std::string> picked_words;
+    text.getData(picked_words, nix::Selection().indices(0, {4, 1}));
+    CPPUNIT_ASSERT(picked_words == std::vector<std::string>({"bb", "eeeee"}));
+
+    // nothing selected
+    std::vector<int32_t> none;
+    da.getData(none, nix::Selection().indices(0, {}).indices(1, {7}));
+    CPPUNIT_ASSERT(none.empty());
+
+    CPPUNIT_ASSERT_THROW(da.getData(values, nix::Selection().slab(1, 1990, 2, 10)), nix::OutOfBounds);
+    CPPUNIT_ASSERT_THROW(da.getData(values, nix::Selection().slab(2, 0, 1)), nix::IncompatibleDimensions);
+    CPPUNIT_ASSERT_THROW(nix::Selection().slab(0, 0, 4, 2, 3), std::invalid_argument);
+}
+
+void BaseTestDataArray::testDataStorageSize() {
+    const size_t n = 10000;
+    const nix::ndsize_t nbytes = n * sizeof(double);
+    std::vector<double> values(n);
+    for (size_t i = 0; i < n; i++) {
+        values[i] = static_cast<double>(i % 10);
+    }
+
+    nix::DataArray plain = block.createDataArray("storage_plain", "double", nix::DataType::Double,
+                                                 nix::NDSize({n}), nix::Compression::None);
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(0), plain.dataStorageSize());
+    plain.setData(values);
+    // chunks may extend beyond the data, but never hold less
+    CPPUNIT_ASSERT(plain.dataStorageSize() >= nbytes);
+
+    nix::DataArray packed = block.createDataArray("storage_packed", "double", nix::DataType::Double,
+                                                  nix::NDSize({n}), nix::Compression::DeflateNormal);
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(0), packed.dataStorageSize());
+    packed.setData(values);
+    CPPUNIT_ASSERT(packed.dataStorageSize() > 0);
+    CPPUNIT_ASSERT(packed.dataStorageSize() < nbytes);
+}
+
+void BaseTestDataArray::testReadAhead() {
+    const int nrows = 20000;
+    typedef boost::multi_array<double, 2> array_type;
+    array_type data(boost::extents[nrows][3]);
+    for (int i = 0; i < nrows; i++) {
+        for (int j = 0; j < 3; j++) {
+            data[i][j] = i * 3.0 + j;
+        }
+    }
+
+    nix::DataArray da = block.createDataArray("readahead", "double", data);
+
+    nix::ReadAhead ra(da, 0, 2);
+    CPPUNIT_ASSERT(ra.dataExtent() == nix::NDSize({nrows, 3}));
+    CPPUNIT_ASSERT_EQUAL(nix::DataType::Double, ra.dataType());
+    CPPUNIT_ASSERT(ra.slabLength() > 0);
+
+    const int window = 7;
+    size_t nreads = 0;
+    array_type out;
+    for (int pos = 0; pos + window <= nrows; pos += window) {
+        ra.getData(out, {window, 2}, {pos, 1});
+        nreads++;
+        for (int i = 0; i < window; i++) {
+            CPPUNIT_ASSERT_EQUAL((pos + i) * 3.0 + 1, out[i][0]);
+            CPPUNIT_ASSERT_EQUAL((pos + i) * 3.0 + 2, out[i][1]);
+        }
+    }
+
+    CPPUNIT_ASSERT_EQUAL(nreads, ra.hits() + ra.misses());
+    CPPUNIT_ASSERT(ra.hits() > ra.misses());
+    CPPUNIT_ASSERT(ra.prefetched() > 0);
+
+    // a seek backwards must still return the right data
+    ra.getData(out, {3, 3}, {10, 0});
+    CPPUNIT_ASSERT_EQUAL(30.0, out[0][0]);
+    CPPUNIT_ASSERT_EQUAL(38.0, out[2][2]);
+    boost::multi_array<int, 2> ints;
+    ra.getData(ints, {1, 3}, {nrows - 1, 0});
+    CPPUNIT_ASSERT_EQUAL(nrows * 3 - 1, ints[0][2]);
+
+    CPPUNIT_ASSERT_THROW(ra.getData(out, {2, 3}, {nrows - 1, 0}), nix::OutOfBounds);
+    CPPUNIT_ASSERT_THROW(ra.setData(out, {0, 0}), std::runtime_error);
+    CPPUNIT_ASSERT_THROW(nix::ReadAhead(da, 2), nix::InvalidRank);
+}
+
+
+void BaseTestDataArray::testEnvelopes() {
+    std::vector<double> data(10000);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<double>((i * 37) % 101) - 50.0;
+    }
+
+    nix::DataArray da = block.createDataArray("envelopes", "double", data);
+    da.appendSampledDimension(0.5);
+    CPPUNIT_ASSERT(!da.hasEnvelopes());
+
+    auto check = [&da](const std::vector<double> &values, nix::ndsize_t offset, nix::ndsize_t count, size_t points) {
+        nix::Envelope env = da.envelopeAt(offset, count, points);
+        CPPUNIT_ASSERT(env.min.size() <= points);
+        CPPUNIT_ASSERT(env.min.size() > 0);
+        CPPUNIT_ASSERT(env.stride > 0);
+
+        // bins are aligned to the stride
+        const nix::ndsize_t first = offset / env.stride * env.stride;
+        for (size_t k = 0; k < env.min.size(); k++) {
+            const size_t lo = static_cast<size_t>(first + k * env.stride);
+            const size_t hi = static_cast<size_t>(std::min<nix::ndsize_t>(lo + env.stride, values.size()));
+            double vmin = values[lo], vmax = values[lo], sum = 0.0;
+            for (size_t i = lo; i < hi; i++) {
+                vmin = std::min(vmin, values[i]);
+                vmax = std::max(vmax, values[i]);
+                sum += values[i];
+            }
+            CPPUNIT_ASSERT_EQUAL(vmin, env.min[k]);
+            CPPUNIT_ASSERT_EQUAL(vmax, env.max[k]);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(sum / (hi - lo), env.mean[k], 1e-9);
+        }
+    };
+
+    // without envelopes the data is read directly
+    check(data, 0, data.size(), 100);
+
+    // a handle retrieved before the envelopes exist
+    nix::DataArray other = block.getDataArray(da.name());
+    CPPUNIT_ASSERT(!other.hasEnvelopes());
+
+    da.createEnvelopes(16);
+    CPPUNIT_ASSERT(da.hasEnvelopes());
+    check(data, 0, data.size(), 100);
+    check(data, 0, data.size(), 7);
+    check(data, 1234, 5000, 20);
+
+    nix::Envelope env = da.envelope(0.0, 4999 * 0.5, 10);
+    CPPUNIT_ASSERT(env.min.size() <= 10);
+    CPPUNIT_ASSERT_EQUAL(0.0, env.position[0]);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(env.stride * 0.5, env.position[1], 1e-9);
+
+    // writes update the affected blocks
+    std::vector<double> extra(777, 1000.0);
+    da.appendData(nix::DataType::Double, extra.data(), {777}, 0);
+    data.insert(data.end(), extra.begin(), extra.end());
+    data[4321] = -1000.0;
+    other.setData(nix::DataType::Double, &data[4321], {1}, {4321});
+    CPPUNIT_ASSERT(other.hasEnvelopes());
+    check(data, 0, data.size(), 50);
+    CPPUNIT_ASSERT_EQUAL(1000.0, da.envelopeAt(0, data.size(), 1).max[0]);
+    CPPUNIT_ASSERT_EQUAL(-1000.0, da.envelopeAt(0, data.size(), 1).min[0]);
+
+    da.dataExtent({3000});
+    data.resize(3000);
+    check(data, 0, data.size(), 30);
+    CPPUNIT_ASSERT_EQUAL(-50.0, da.envelopeAt(0, data.size(), 1).min[0]);
+
+    // envelopes follow the calibration
+    da.polynomCoefficients({0.0, 2.0});
+    for (auto &v : data) {
+        v *= 2.0;
+    }
+    check(data, 0, data.size(), 30);
+
+    CPPUNIT_ASSERT_THROW(da.envelopeAt(0, data.size() + 1, 10), nix::OutOfBounds);
+    CPPUNIT_ASSERT_THROW(da.createEnvelopes(1), std::invalid_argument);
+
+    da.deleteEnvelopes();
+    CPPUNIT_ASSERT(!da.hasEnvelopes());
+    check(data, 0, data.size(), 30);
+}
+
+
+void BaseTestDataArray::testStatistics() {
+    typedef boost::multi_array<int, 3> array_type;
+    array_type data(boost::extents[300][5][7]);
+    for (int i = 0; i < 300; i++) {
+        for (int j = 0; j < 5; j++) {
+            for (int k = 0; k < 7; k++) {
+                data[i][j][k] = (i * 31 + j * 17 + k * 5) % 97 - 40;
+            }
+        }
+    }
+
+    nix::DataArray da = block.createDataArray("statistics", "int", data);
+    da.polynomCoefficients({1.0, 0.5});
+
+    const int extent[3] = {300, 5, 7};
+    for (size_t axis = 0; axis < 3; axis++) {
+        for (size_t nthreads : {1, 4}) {
+            nix::Statistics stats = da.statistics(axis, nthreads);
+            CPPUNIT_ASSERT_EQUAL(static_cast<nix::ndsize_t>(extent[axis]), stats.count);
+            CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), stats.shape.size());
+            CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(stats.shape.nelms()), stats.mean.size());
+
+            const int d1 = axis == 0 ? 1 : 0;
+            const int d2 = axis == 2 ? 1 : 2;
+            for (int a = 0; a < extent[d1]; a++) {
+                for (int b = 0; b < extent[d2]; b++) {
+                    double sum = 0.0, sq = 0.0;
+                    double vmin = std::numeric_limits<double>::infinity(), vmax = -vmin;
+                    for (int r = 0; r < extent[axis]; r++) {
+                        int idx[3];
+                        idx[axis] = r;
+                        idx[d1] = a;
+                        idx[d2] = b;
+                        const double x = 1.0 + 0.5 * data[idx[0]][idx[1]][idx[2]];
+                        sum += x;
+                        sq += x * x;
+                        vmin = std::min(vmin, x);
+                        vmax = std::max(vmax, x);
+                    }
+                    const double mean = sum / extent[axis];
+                    const size_t o = static_cast<size_t>(a * extent[d2] + b);
+                    CPPUNIT_ASSERT_DOUBLES_EQUAL(sum, stats.sum[o], 1e-9);
+                    CPPUNIT_ASSERT_DOUBLES_EQUAL(mean, stats.mean[o], 1e-9);
+                    CPPUNIT_ASSERT_DOUBLES_EQUAL(sq / extent[axis] - mean * mean, stats.variance[o], 1e-9);
+                    CPPUNIT_ASSERT_EQUAL(vmin, stats.min[o]);
+                    CPPUNIT_ASSERT_EQUAL(vmax, stats.max[o]);
+                }
+            }
+        }
+    }
+
+    std::vector<double> values(2500001); // more than one tile
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = std::sin(i * 0.001);
+    }
+    nix::DataArray trace = block.createDataArray("trace", "double", values);
+    nix::Statistics stats = trace.statistics(0, 3);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), stats.shape.size());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), stats.mean.size());
+    const double sum = std::accumulate(values.begin(), values.end(), 0.0);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(sum, stats.sum[0], 1e-6);
+    CPPUNIT_ASSERT_EQUAL(*std::max_element(values.begin(), values.end()), stats.max[0]);
+    CPPUNIT_ASSERT_EQUAL(*std::min_element(values.begin(), values.end()), stats.min[0]);
+
+    CPPUNIT_ASSERT_THROW(trace.statistics(1), nix::InvalidRank);
+}
+
+
+
+void BaseTestDataArray::testDataLayout() {
+    std::vector<double> data(10000, 1.0);
+    nix::DataArray da = block.createDataArray("layout", "double", nix::DataType::Double,
+                                              nix::NDSize({10000}), nix::Compression::DeflateNormal);
+    da.setData(data);
+
+    nix::StorageLayout layout = da.dataLayout();
+    CPPUNIT_ASSERT(layout.shape == nix::NDSize({10000}));
+    CPPUNIT_ASSERT(layout.chunks == da.dataChunks());
+    CPPUNIT_ASSERT_EQUAL(sizeof(double), layout.element_size);
+    CPPUNIT_ASSERT_EQUAL(da.dataStorageSize(), layout.storage_size);
+    // constant data compresses well
+    CPPUNIT_ASSERT(layout.storage_size < 10000 * sizeof(double) / 10);
+    CPPUNIT_ASSERT(layout.allocated_chunks > 0);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), layout.filters.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("deflate 6"), layout.filters[0]);
+
+    nix::DataArray empty = block.createDataArray("empty", "double", nix::DataType::Double, nix::NDSize({0}));
+    CPPUNIT_ASSERT_EQUAL(static_cast<nix::ndsize_t>(0), empty.dataLayout().allocated_chunks);
+    CPPUNIT_ASSERT(empty.dataLayout().filters.empty());
+}
+
+void BaseTestDataArray::testStringStorage() {
+    const std::vector<std::string> states = {"go", "stop", "wait"};
+    std::vector<std::string> labels(3000);
+    for (size_t i = 0; i < labels.size(); i++) {
+        labels[i] = states[(i / 7) % states.size()];
+    }
+    const nix::NDSize extent({labels.size()});
+
+    nix::DataArray var = block.createDataArray("var", "labels", labels);
+    CPPUNIT_ASSERT(var.stringStorage() == nix::StringStorage::variable());
+    CPPUNIT_ASSERT(var.stringDictionary().empty());
+
+    // fixed length
+    nix::DataArray fixed = block.createDataArray("fixed", "labels", labels, nix::DataType::String,
+                                                 nix::Compression::DeflateNormal, nix::StringStorage::fixed(4));
+    CPPUNIT_ASSERT(fixed.stringStorage() == nix::StringStorage::fixed(4));
+    CPPUNIT_ASSERT_EQUAL(nix::DataType::String, fixed.dataType());
+
+    std::vector<std::string> out;
+    fixed.getData(out);
+    CPPUNIT_ASSERT(out == labels);
+    // unlike variable length strings the data are compressed
+    CPPUNIT_ASSERT(fixed.dataStorageSize() < labels.size() * 4 / 10);
+
+    fixed.setData(std::vector<std::string>{"", "halt"}, {10});
+    fixed.getData(out, {3}, {9});
+    CPPUNIT_ASSERT(out == std::vector<std::string>({labels[9], "", "halt"}));
+    CPPUNIT_ASSERT_THROW(fixed.setData(std::vector<std::string>{"pause"}, {0}), std::invalid_argument);
+
+    // dictionary encoded
+    nix::DataArray dict = block.createDataArray("dict", "labels", labels, nix::DataType::String,
+                                                nix::Compression::DeflateNormal, nix::StringStorage::dictionary());
+    CPPUNIT_ASSERT(dict.stringStorage() == nix::StringStorage::dictionary());
+    CPPUNIT_ASSERT_EQUAL(nix::DataType::String, dict.dataType());
+    CPPUNIT_ASSERT(dict.dataExtent() == extent);
+
+    dict.getData(out);
+    CPPUNIT_ASSERT(out == labels);
+
+    const std::vector<std::string> table = dict.stringDictionary();
+    CPPUNIT_ASSERT(table == std::vector<std::string>({"", "go", "stop", "wait"}));
+
+    std::vector<uint32_t> codes;
+    dict.stringCodes(codes);
+    CPPUNIT_ASSERT_EQUAL(labels.size(), codes.size());
+    for (size_t i = 0; i < labels.size(); i++) {
+        CPPUNIT_ASSERT_EQUAL(labels[i], table[codes[i]]);
+    }
+    dict.stringCodes(codes, {2}, {6});
+    CPPUNIT_ASSERT(codes == std::vector<uint32_t>({1, 2}));
+
+    // new strings are appended to the table, unwritten entries are empty
+    dict.dataExtent({labels.size() + 2});
+    dict.setData(std::vector<std::string>{"halt", "go"}, {labels.size()});
+    dict.getData(out, {3}, {labels.size() - 1});
+    CPPUNIT_ASSERT(out == std::vector<std::string>({labels.back(), "halt", "go"}));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(5), dict.stringDictionary().size());
+
+    dict.dataExtent({labels.size() + 3});
+    dict.getData(out, {1}, {labels.size() + 2});
+    CPPUNIT_ASSERT_EQUAL(std::string(""), out[0]);
+
+    std::vector<double> numbers(10);
+    CPPUNIT_ASSERT_THROW(dict.getData(numbers, {10}, {0}), std::invalid_argument);
+    CPPUNIT_ASSERT_THROW(dict.setData(numbers, {0}), std::invalid_argument);
+    CPPUNIT_ASSERT_THROW(var.stringCodes(codes), std::invalid_argument);
+
+    CPPUNIT_ASSERT_THROW(block.createDataArray("bad", "double", nix::DataType::Double, extent,
+                                               nix::Compression::Auto, nix::StringStorage::dictionary()),
+                         std::invalid_argument);
+    CPPUNIT_ASSERT_THROW(block.createDataArray("bad", "labels", nix::DataType::String, extent,
+                                               nix::Compression::Auto, nix::StringStorage::fixed()),
+                         std::invalid_argument);
+}
+
 void BaseTestDataArray::testPolynomial() {
     double PI = boost::math::constants::pi<double>();
     boost::array<double, 10> coefficients1;
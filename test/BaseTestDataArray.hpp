@@ -30,6 +30,18 @@ public:
     void testName();
     void testDefinition();
     void testData();
+    void testDataAsync();
+    void testDataParallel();
+    void testGetDataParallel();
+    void testChunkIterator();
+    void testMapData();
+    void testSelection();
+    void testDataStorageSize();
+    void testReadAhead();
+    void testEnvelopes();
+    void testStatistics();
+    void testDataLayout();
+    void testStringStorage();
     void testPolynomial();
     void testPolynomialSetter();
     void testLabel();
@@ -13,6 +13,7 @@
 #include <iterator>
 #include <stdexcept>
 #include <limits>
+#include <future>
 
 #include "BaseTestDataFrame.hpp"
 
@@ -244,3 +245,98 @@ void BaseTestDataFrame::testCellIO() {
     }
 
 }
+
+void BaseTestDataFrame::testStringStorage() {
+    std::vector<nix::Column> cols = {
+        {"trial", "", nix::DataType::String, nix::StringStorage::dictionary()},
+        {"code", "", nix::DataType::String, nix::StringStorage::fixed(4)},
+        {"value", "mV", nix::DataType::Double}};
+
+    nix::DataFrame df = block.createDataFrame("strings", "frame", cols);
+
+    std::vector<nix::Column> cc = df.columns();
+    CPPUNIT_ASSERT_EQUAL(cols.size(), cc.size());
+    for (size_t i = 0; i < cols.size(); i++) {
+        CPPUNIT_ASSERT_EQUAL(cols[i].dtype, cc[i].dtype);
+        CPPUNIT_ASSERT(cols[i].strings == cc[i].strings);
+    }
+
+    const size_t n = 100;
+    df.rows(n);
+
+    std::vector<std::string> trials(n), codes(n);
+    for (size_t i = 0; i < n; i++) {
+        trials[i] = i % 3 == 0 ? "left" : "right";
+        codes[i] = std::to_string(i);
+    }
+
+    df.writeColumn("trial", trials);
+    df.writeColumn("code", codes);
+
+    std::vector<std::string> out;
+    df.readColumn("trial", out, true);
+    CPPUNIT_ASSERT(out == trials);
+    df.readColumn("code", out, true);
+    CPPUNIT_ASSERT(out == codes);
+
+    std::vector<nix::Variant> row = {nix::Variant("center"), nix::Variant("abcd"), nix::Variant(1.5)};
+    df.writeRow(2, row);
+    std::vector<nix::Variant> rr = df.readRow(2);
+    for (size_t i = 0; i < row.size(); i++) {
+        CPPUNIT_ASSERT_EQUAL(row[i], rr[i]);
+    }
+    CPPUNIT_ASSERT_EQUAL(nix::Variant("left"), df.readRow(3)[0]);
+
+    std::vector<nix::Cell> cells = {{"trial", nix::Variant("left")}, {"code", nix::Variant("x")}};
+    df.writeCells(4, cells);
+    std::vector<nix::Cell> cout = df.readCells(4, {"trial", "code"});
+    CPPUNIT_ASSERT_EQUAL(nix::Variant("left"), static_cast<const nix::Variant &>(cout[0]));
+    CPPUNIT_ASSERT_EQUAL(nix::Variant("x"), static_cast<const nix::Variant &>(cout[1]));
+
+    CPPUNIT_ASSERT_THROW(df.writeRow(5, {nix::Variant("left"), nix::Variant("toolong"), nix::Variant(1.0)}),
+                         std::invalid_argument);
+    CPPUNIT_ASSERT_THROW(df.writeCells(5, {{"trial", nix::Variant(1.0)}}), std::invalid_argument);
+
+    std::vector<nix::Column> bad = {{"value", "", nix::DataType::Double, nix::StringStorage::dictionary()}};
+    CPPUNIT_ASSERT_THROW(block.createDataFrame("bad", "frame", bad), std::invalid_argument);
+}
+
+void BaseTestDataFrame::testAsyncIO() {
+    nix::DataFrame df = createStandardFrame(block);
+    size_t n = 10;
+
+    df.rows(n);
+
+    std::vector<int32_t> i32(n);
+    std::vector<double> dbl(n);
+    for (size_t i = 0; i < n; i++) {
+        i32[i] = static_cast<int32_t>(i);
+        dbl[i] = i / static_cast<double>(n);
+    }
+
+    std::future<void> w1 = df.writeColumnAsync("int32", i32);
+    std::future<void> w2 = df.writeColumnAsync("double", dbl);
+
+    std::vector<int32_t> i32_out;
+    std::vector<double> dbl_out;
+    std::future<void> r1 = df.readColumnAsync("int32", i32_out, n);
+    std::future<void> r2 = df.readColumnAsync("double", dbl_out, n);
+    std::future<std::vector<nix::Variant>> row = df.readRowAsync(3);
+
+    w1.get();
+    w2.get();
+    r1.get();
+    r2.get();
+
+    for (size_t i = 0; i < n; i++) {
+        CPPUNIT_ASSERT_EQUAL(i32[i], i32_out[i]);
+        CPPUNIT_ASSERT_EQUAL(dbl[i], dbl_out[i]);
+    }
+
+    std::vector<nix::Variant> vals = row.get();
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), vals.size());
+    CPPUNIT_ASSERT_EQUAL(int32_t(3), vals[0].get<int32_t>());
+
+    // nothing may still hold the frame when tearDown closes the file
+    nix::IOExecutor::instance().wait();
+}
@@ -27,7 +27,9 @@ public:
     void testBasic();
     void testRowIO();
     void testColIO();
+    void testAsyncIO();
     void testCellIO();
+    void testStringStorage();
 };
 
 #endif // NIX_BASETESTDATAFRAME_HPP
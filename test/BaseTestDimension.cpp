@@ -307,6 +307,7 @@ void BaseTestDimension::testSetDimLabels() {
     sd.labels(labels);
     std::vector<std::string> retrieved_labels = sd.labels();
     CPPUNIT_ASSERT(retrieved_labels.size() == labels.size());
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(labels.size()), sd.labelCount());
     for (size_t i = 0; i < labels.size(); i++){
         CPPUNIT_ASSERT(labels[i] == retrieved_labels[i]);
     }
@@ -321,6 +322,7 @@ void BaseTestDimension::testSetDimLabels() {
     sd.labels(boost::none);
     retrieved_labels = sd.labels();
     CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), retrieved_labels.size());
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(0), sd.labelCount());
 
     data_array.deleteDimensions();
 }
@@ -385,6 +387,7 @@ void BaseTestDimension::testRangeTicks() {
     RangeDimension rd;
     rd = d;
     CPPUNIT_ASSERT(rd.ticks().size() == ticks.size());
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(ticks.size()), rd.tickCount());
     std::vector<double> retrieved_ticks = rd.ticks();
     CPPUNIT_ASSERT(retrieved_ticks.size() == ticks.size());
     for (
@@ -294,6 +294,72 @@ void BaseTestMultiTag::testPositionExtents() {
 }
 
 
+void BaseTestMultiTag::testIntervalIndex() {
+    const ndsize_t n = 1000, columns = 2;
+    std::vector<double> starts(2 * n), lengths(2 * n);
+    for (ndsize_t i = 0; i < n; i++) {
+        starts[2 * i] = 10.0 * i;
+        starts[2 * i + 1] = 1.0;
+        lengths[2 * i] = 5.0;
+        lengths[2 * i + 1] = 0.0;
+    }
+    const NDSize shape({n, columns}), origin({0, 0});
+    DataArray pos = block.createDataArray("interval_positions", "nix.positions", DataType::Double, shape);
+    pos.setData(DataType::Double, starts.data(), shape, origin);
+    DataArray ext = block.createDataArray("interval_extents", "nix.extents", DataType::Double, shape);
+    ext.setData(DataType::Double, lengths.data(), shape, origin);
+
+    MultiTag events = block.createMultiTag("events", "nix.events", pos);
+    events.units({"ms", "mV"});
+
+    // points: [0], [10], [20], ...
+    std::vector<ndsize_t> expected = {1, 2, 3};
+    CPPUNIT_ASSERT(events.positionsInRange(10, 30) == expected);
+    CPPUNIT_ASSERT(events.positionsInRange(11, 19).empty());
+    CPPUNIT_ASSERT(events.positionsInRange(0.01, 0.03, 0, "s") == expected);
+    CPPUNIT_ASSERT(events.positionsInRange(1, 1, 1).size() == n);
+
+    // intervals: [0, 5], [10, 15], [20, 25], ...
+    events.extents(ext);
+    CPPUNIT_ASSERT(events.positionsInRange(12, 31) == expected);
+    CPPUNIT_ASSERT(events.positionsInRange(0.012, 0.031, 0, "s") == expected);
+    CPPUNIT_ASSERT(events.positionsInRange(6, 9).empty());
+    CPPUNIT_ASSERT(events.positionsInRange(30, 20).empty());
+
+    IntervalIndex index = events.intervalIndex();
+    CPPUNIT_ASSERT_EQUAL(n, index.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("ms"), index.unit());
+    expected = {n - 1};
+    CPPUNIT_ASSERT(index.overlapping(9995, 1e9) == expected);
+
+    CPPUNIT_ASSERT_THROW(index.overlapping(0, 1, "mV"), IncompatibleDimensions);
+    CPPUNIT_ASSERT_THROW(events.intervalIndex(2), OutOfBounds);
+
+    // against a scan over random intervals, some with negative extents
+    std::vector<double> s(500), e(500);
+    unsigned seed = 42;
+    auto next = [&seed]() {
+        seed = seed * 1103515245 + 12345;
+        return static_cast<double>((seed >> 8) % 10000) / 10.0;
+    };
+    for (size_t i = 0; i < s.size(); i++) {
+        s[i] = next();
+        e[i] = next() / 10.0 - 20.0;
+    }
+    IntervalIndex random(s, e);
+    for (int q = 0; q < 100; q++) {
+        double a = next(), b = a + next() / 20.0;
+        std::vector<ndsize_t> scan;
+        for (size_t i = 0; i < s.size(); i++) {
+            if (std::min(s[i], s[i] + e[i]) <= b && std::max(s[i], s[i] + e[i]) >= a) {
+                scan.push_back(i);
+            }
+        }
+        CPPUNIT_ASSERT(random.overlapping(a, b) == scan);
+    }
+}
+
+
 void BaseTestMultiTag::testDataAccess() {
     DataArray data_array = block.createDataArray("dimensionTest",
                                        "test",
@@ -63,6 +63,93 @@ void BaseTestProperty::testDefinition() {
 }
 
 
+void BaseTestProperty::testStringStorage()
+{
+    nix::Section section = file.createSection("Storage", "strings");
+    std::vector<nix::Variant> values = { nix::Variant("Freude"),
+                                         nix::Variant("schoener"),
+                                         nix::Variant("Goetterfunken") };
+
+    nix::Property p = section.createProperty("fixed", values, nix::StringStorage::fixed());
+    CPPUNIT_ASSERT_EQUAL(nix::DataType::String, p.dataType());
+    CPPUNIT_ASSERT(p.values() == values);
+
+    // the length is set by the longest value
+    values.pop_back();
+    p.values(values);
+    CPPUNIT_ASSERT(p.values() == values);
+    values.emplace_back("Wir betreten feuertrunken");
+    CPPUNIT_ASSERT_THROW(p.values(values), std::invalid_argument);
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(2), p.valueCount());
+
+    CPPUNIT_ASSERT_THROW(section.createProperty("dict", values, nix::StringStorage::dictionary()),
+                         std::invalid_argument);
+    CPPUNIT_ASSERT_THROW(section.createProperty("ints", {nix::Variant(1)}, nix::StringStorage::fixed()),
+                         std::invalid_argument);
+}
+
+void BaseTestProperty::testTypedValues()
+{
+    nix::Section section = file.createSection("Typed", "values");
+
+    std::vector<double> dbl(100000);
+    for (size_t i = 0; i < dbl.size(); i++) {
+        dbl[i] = i * 0.5;
+    }
+    nix::Property pd = section.createProperty("double", nix::DataType::Double);
+    pd.setValues(dbl);
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(dbl.size()), pd.valueCount());
+
+    std::vector<double> dout;
+    pd.getValues(dout);
+    CPPUNIT_ASSERT(dout == dbl);
+    pd.getValues(dout, 3, 1000);
+    CPPUNIT_ASSERT(dout == std::vector<double>({500.0, 500.5, 501.0}));
+    CPPUNIT_ASSERT_EQUAL(nix::Variant(2.5), pd.values()[5]);
+    CPPUNIT_ASSERT_THROW(pd.getValues(dout, 2, dbl.size() - 1), nix::OutOfBounds);
+
+    // range writes keep the other values, writes past the end grow
+    pd.setValues(std::vector<double>{-1.0, -2.0}, 10);
+    pd.setValues(std::vector<double>{7.0}, dbl.size());
+    pd.getValues(dout, 3, 9);
+    CPPUNIT_ASSERT(dout == std::vector<double>({4.5, -1.0, -2.0}));
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(dbl.size() + 1), pd.valueCount());
+
+    pd.setValues(std::vector<double>{1.0, 2.0});
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(2), pd.valueCount());
+    CPPUNIT_ASSERT_THROW(pd.setValues(std::vector<int32_t>{1}), std::invalid_argument);
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(2), pd.valueCount());
+
+    nix::Property pi = section.createProperty("int", nix::DataType::Int32);
+    pi.setValues(std::vector<int32_t>{1, 2, 3});
+    pi.getValues(dout);
+    CPPUNIT_ASSERT(dout == std::vector<double>({1.0, 2.0, 3.0}));
+
+    std::vector<std::string> str = {"Freude", "schoener", "Goetterfunken"};
+    nix::Property ps = section.createProperty("string", nix::DataType::String);
+    ps.setValues(str);
+    std::vector<std::string> sout;
+    ps.getValues(sout);
+    CPPUNIT_ASSERT(sout == str);
+    ps.getValues(sout, 1, 2);
+    CPPUNIT_ASSERT_EQUAL(str[2], sout[0]);
+
+    nix::Property pf = section.createProperty("fixed", {nix::Variant("a"), nix::Variant("bcd")},
+                                              nix::StringStorage::fixed());
+    pf.setValues(std::vector<std::string>{"xyz"}, 1);
+    pf.getValues(sout);
+    CPPUNIT_ASSERT(sout == std::vector<std::string>({"a", "xyz"}));
+    CPPUNIT_ASSERT_THROW(pf.setValues(std::vector<std::string>{"toolong"}, 0), std::invalid_argument);
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(2), pf.valueCount());
+
+    std::vector<bool> bl = {true, false, true};
+    nix::Property pb = section.createProperty("bool", nix::DataType::Bool);
+    pb.setValues(bl);
+    std::vector<bool> bout;
+    pb.getValues(bout);
+    CPPUNIT_ASSERT(bout == bl);
+}
+
 void BaseTestProperty::testValues()
 {
     nix::Section section = file.createSection("Area51", "Boolean");
@@ -32,6 +32,8 @@ public:
     void testDefinition();
     void testDataType();
     void testValues();
+    void testStringStorage();
+    void testTypedValues();
     void testUnit();
     void testUncertainty();
     void testIsValidEntity();
@@ -436,6 +436,109 @@ void BaseTestSection::testFindRelated() {
 }
 
 
+static std::vector<std::string> section_names(const std::vector<Section> &sections) {
+    std::vector<std::string> names;
+    for (const Section &s : sections) {
+        names.push_back(s.name());
+    }
+    return names;
+}
+
+
+void BaseTestSection::testMetadataSnapshot() {
+    Section l1n1 = section.createSection("L1N1", "t1");
+    Section l2n1 = l1n1.createSection("L2N1", "t2");
+    Section l2n2 = l1n1.createSection("L2N2", "t3");
+    Section l2n3 = l1n1.createSection("L2N3", "t2");
+    Section l3n1 = l2n1.createSection("L3N1", "t1");
+    Section l3n2 = l2n2.createSection("L3N2", "t2");
+    Section l4n1 = l3n1.createSection("L4N1", "t3");
+    l3n2.createProperty("prop", DataType::Double);
+    l2n3.link(l3n1);
+
+    std::vector<Section> all = {section, l1n1, l2n1, l2n2, l2n3, l3n1, l3n2, l4n1};
+    std::vector<util::Filter<Section>::type> filters = {
+        util::AcceptAll<Section>(),
+        util::TypeFilter<Section>("t1"),
+        util::TypeFilter<Section>("t2"),
+        util::TypeFilter<Section>("t3"),
+        util::NameFilter<Section>("L3N2"),
+        util::IdFilter<Section>(l4n1.id()),
+        util::IdsFilter<Section>({l2n2.id(), l3n1.id()}),
+        [](const Section &s) { return s.name().back() == '1'; }
+    };
+    std::vector<size_t> depths = {0, 1, 2, 10};
+
+    std::vector<std::vector<std::string>> expected;
+    for (auto &filter : filters) {
+        for (size_t depth : depths) {
+            expected.push_back(section_names(file.findSections(filter, depth)));
+        }
+        for (const Section &s : all) {
+            expected.push_back(section_names(s.findRelated(filter)));
+            for (size_t depth : depths) {
+                expected.push_back(section_names(s.findSections(filter, depth)));
+            }
+        }
+    }
+
+    std::shared_ptr<const MetadataSnapshot> snapshot = file.loadMetadata();
+    CPPUNIT_ASSERT(file.metadataSnapshot() == snapshot);
+    // all sections and section_other
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(all.size() + 1), snapshot->sectionCount());
+
+    size_t k = 0;
+    for (auto &filter : filters) {
+        for (size_t depth : depths) {
+            CPPUNIT_ASSERT(expected[k++] == section_names(file.findSections(filter, depth)));
+        }
+        for (const Section &s : all) {
+            CPPUNIT_ASSERT(expected[k++] == section_names(s.findRelated(filter)));
+            for (size_t depth : depths) {
+                CPPUNIT_ASSERT(expected[k++] == section_names(s.findSections(filter, depth)));
+            }
+        }
+    }
+
+    CPPUNIT_ASSERT_EQUAL(l2n2.id(), snapshot->sectionById(l2n2.id()).id());
+    CPPUNIT_ASSERT(!snapshot->sectionById("nonexistent"));
+    CPPUNIT_ASSERT(section_names(snapshot->sectionsByType("t2")) ==
+                   std::vector<std::string>({"L2N1", "L2N3", "L3N2"}));
+    CPPUNIT_ASSERT(section_names(snapshot->sectionsByName("L3N1")) == std::vector<std::string>({"L3N1"}));
+    CPPUNIT_ASSERT(section_names(snapshot->sectionsWithProperty("prop")) == std::vector<std::string>({"L3N2"}));
+    CPPUNIT_ASSERT_EQUAL(l3n1.id(), snapshot->link(l2n3).id());
+    CPPUNIT_ASSERT(!snapshot->link(l2n1));
+    CPPUNIT_ASSERT_EQUAL(l3n1.id(), l2n3.link().id());
+
+    // property values are not part of the snapshot
+    l3n2.getProperty("prop").values({Variant(1.0)});
+    CPPUNIT_ASSERT(file.metadataSnapshot() == snapshot);
+
+    l4n1.type("t2");
+    CPPUNIT_ASSERT(!file.metadataSnapshot());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(4), file.findSections(util::TypeFilter<Section>("t2")).size());
+
+    file.loadMetadata();
+    Section l5n1 = l4n1.createSection("L5N1", "t2");
+    CPPUNIT_ASSERT(!file.metadataSnapshot());
+
+    file.loadMetadata();
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(5), file.findSections(util::TypeFilter<Section>("t2")).size());
+    l1n1.deleteSection(l2n1);
+    CPPUNIT_ASSERT(!file.metadataSnapshot());
+
+    file.loadMetadata();
+    l2n2.createProperty("other", DataType::Int32);
+    CPPUNIT_ASSERT(!file.metadataSnapshot());
+
+    file.loadMetadata();
+    file.unloadMetadata();
+    CPPUNIT_ASSERT(!file.metadataSnapshot());
+    // a detached snapshot keeps describing the tree at load time
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(all.size() + 1), snapshot->sectionCount());
+}
+
+
 void BaseTestSection::testPropertyAccess() {
     std::vector<std::string> names = { "property_a", "property_b", "property_c", "property_d", "property_e" };
 
@@ -34,6 +34,7 @@ public:
     void testSectionAccess();
     void testFindSection();
     void testFindRelated();
+    void testMetadataSnapshot();
     void testPropertyAccess();
     void testReferringData();
     void testReferringTags();
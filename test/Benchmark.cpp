@@ -10,599 +10,835 @@
 
 #include <nix.hpp>
 #include <nix/NDArray.hpp>
+#include <nix/util/dataAccess.hpp>
 
+#include "BenchmarkAlloc.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
 #include <cstdio>
-#include <queue>
-#include <random>
-#include <type_traits>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <functional>
 #include <iostream>
-#include <mutex>
-#include <condition_variable>
-#include <thread>
+#include <random>
+#include <regex>
+#include <sstream>
 #include <stdexcept>
-#include <cstdio>
 #include <string>
-#include <cstdint>
+#include <thread>
 #include <utility>
-
-/* ************************************ */
-namespace nix {
-
-template<typename Func, typename... Args>
-auto data_type_dispatch(nix::DataType dtype, Func &&F, Args&&... args)
-    -> decltype(std::forward<Func>(F)(double(), std::forward<Args>(args)...))
-{
-    switch (dtype) {
-
-        case DataType::Double:
-            return std::forward<Func>(F)(double(), std::forward<Args>(args)...);
-            break;
-
-        case DataType::Int8:
-            return std::forward<Func>(F)(int8_t(), std::forward<Args>(args)...);
-            break;
-
-        case DataType::Int16:
-            return std::forward<Func>(F)(int16_t(), std::forward<Args>(args)...);
-            break;
-
-        default:
-            throw std::invalid_argument("Unkown DataType");
-    }
-
-}
-
-
-}
+#include <vector>
 
 /* ************************************ */
 
 class Stopwatch {
 
 public:
-    typedef std::chrono::high_resolution_clock::time_point time_point_t;
-    typedef std::chrono::high_resolution_clock clock_t;
+    typedef std::chrono::steady_clock clock_t;
 
     Stopwatch() : t_start(clock_t::now()) { };
 
-    ssize_t ms() {
-        time_point_t t_end = clock_t::now();
-        ssize_t count = std::chrono::duration_cast<std::chrono::milliseconds>(t_end - t_start).count();
-        return count;
+    double seconds() const {
+        return std::chrono::duration<double>(clock_t::now() - t_start).count();
     }
 
 private:
-    time_point_t t_start;
+    clock_t::time_point t_start;
 };
 
 /* ************************************ */
 
-class RndGenBase {
-public:
-    RndGenBase() : rd(), rd_gen(rd()) { };
-
-protected:
-    std::random_device rd;
-    std::mt19937 rd_gen;
+struct Options {
+    std::vector<std::string> backends;
+    nix::ndsize_t            max_scale = 10000;
+    size_t                   repeat = 3;
+    std::string              filter;
+    std::string              output;
+    std::string              dir = ".";
 };
 
-template<typename T, typename Enable = void>
-class RndGen { };
-
-template<typename T>
-class RndGen<T, typename std::enable_if<std::is_floating_point<T>::value >::type> : RndGenBase {
-public:
-    RndGen() : dis(-1024.0, +1024.0) { };
-
-    T operator()(void) {
-        return dis(rd_gen);
-    };
-
-private:
-    std::uniform_real_distribution<T> dis;
+/**
+ * One measured operation. A run performs ops operations of the same
+ * kind on a problem of size n, e.g. 1000 lookups in 10^5 entities.
+ */
+struct Result {
+    std::string         suite;
+    std::string         name;
+    std::string         backend;
+    nix::ndsize_t       n = 0;
+    nix::ndsize_t       ops = 0;
+    nix::ndsize_t       bytes = 0;
+    std::vector<double> seconds;
+    double              allocs = -1;
+    std::string         error;
+
+    double median() const {
+        std::vector<double> sorted = seconds;
+        std::sort(sorted.begin(), sorted.end());
+        return sorted.empty() ? 0 : sorted[sorted.size() / 2];
+    }
 };
 
-template<typename T>
-class RndGen<T, typename std::enable_if<std::is_integral<T>::value >::type> : RndGenBase {
-public:
-    RndGen() : dis(std::numeric_limits<T>::min(), std::numeric_limits<T>::max()) { };
 
-    T operator()(void) {
-        return dis(rd_gen);
-    };
-
-private:
-    std::uniform_int_distribution<T> dis;
-};
+class Runner {
 
-/* ************************************ */
+public:
 
-class Config {
+    Runner(const Options &opts) : opts(opts), filter(opts.filter.empty() ? ".*" : opts.filter) { }
 
-public:
-    Config(nix::DataType data_type, const nix::NDSize &blocksize)
-            : data_type(data_type), block_size(blocksize) {
+    bool wanted(const std::string &suite, const std::string &name) const {
+        return std::regex_search(suite + "/" + name, filter);
+    }
 
-        sdim = find_single_dim();
-        shape = blocksize;
-        shape[sdim] = 0;
+    bool wanted(const std::string &suite, const std::vector<std::string> &names) const {
+        return std::any_of(names.begin(), names.end(),
+                           [&](const std::string &name) { return wanted(suite, name); });
+    }
 
-        make_name();
-    };
+    /**
+     * Run op repeat times, each time after setup, and time op only.
+     */
+    void run(const std::string &suite, const std::string &name, const std::string &backend,
+             nix::ndsize_t n, nix::ndsize_t ops, nix::ndsize_t bytes,
+             const std::function<void()> &op, const std::function<void()> &setup = std::function<void()>()) {
+        if (!wanted(suite, name)) {
+            return;
+        }
 
-    size_t find_single_dim() {
-        size_t sdim;
-        bool have_rdim = false;
-        for (size_t i = 0; i < block_size.size(); i ++) {
-            if (block_size[i] == 1) {
-                sdim = i;
-                have_rdim = true;
+        Result res;
+        res.suite = suite;
+        res.name = name;
+        res.backend = backend;
+        res.n = n;
+        res.ops = ops;
+        res.bytes = bytes;
+
+        std::cerr << suite << "/" << name << " [" << backend << ", n=" << n << "] " << std::flush;
+        try {
+            for (size_t i = 0; i < opts.repeat; i++) {
+                if (setup) {
+                    setup();
+                }
+                const size_t before = alloc_count;
+                Stopwatch sw;
+                op();
+                res.seconds.push_back(sw.seconds());
+                res.allocs = static_cast<double>(alloc_count - before) / std::max<nix::ndsize_t>(ops, 1);
             }
+            std::cerr << res.median() << " s" << std::endl;
+        } catch (const std::exception &e) {
+            res.error = e.what();
+            std::cerr << "failed: " << e.what() << std::endl;
         }
 
-        if (!have_rdim) {
-            throw std::runtime_error("Could not find singelton dimension");
-        }
-        return sdim;
+        results.push_back(res);
     }
 
-    nix::DataType dtype() const { return data_type; }
-    const nix::NDSize& size() const { return block_size; }
-    const nix::NDSize& extend() const { return shape; }
-    size_t singleton_dimension() const { return sdim; }
-    const std::string & name() const { return my_name; };
+    const Options &options() const {
+        return opts;
+    }
 
+    std::vector<nix::ndsize_t> scales(nix::ndsize_t from = 1000) const {
+        std::vector<nix::ndsize_t> ns;
+        for (nix::ndsize_t n = from; n <= opts.max_scale; n *= 10) {
+            ns.push_back(n);
+        }
+        return ns;
+    }
 
-private:
-    void make_name() {
-        std::stringstream s;
+    std::string path(const std::string &backend, const std::string &name) const {
+        return opts.dir + "/nix-bench-" + name + (backend == "hdf5" ? ".h5" : "");
+    }
 
-        s << data_type << "@{ ";
-        for (auto x : block_size) {
-            s << x << " ";
-        }
-        s << "}";
+    nix::File create(const std::string &backend, const std::string &name) const {
+        return nix::File::open(path(backend, name), nix::FileMode::Overwrite, backend);
+    }
 
-        my_name = s.str();
+    const std::vector<Result> &all() const {
+        return results;
     }
 
 private:
-    const nix::DataType data_type;
-    const nix::NDSize block_size;
+    const Options       opts;
+    std::regex          filter;
+    std::vector<Result> results;
+};
 
-    size_t        sdim;
-    nix::NDSize   shape;
+/* ************************************ */
+// metadata scaling: create, look up and enumerate entities
 
-    std::string   my_name;
-};
+static void bench_metadata(Runner &runner, const std::string &backend) {
+    const nix::ndsize_t nlookups = 100;
 
+    for (nix::ndsize_t n : runner.scales()) {
+        nix::File file;
+        nix::Block block;
 
+        auto setup = [&] {
+            file = runner.create(backend, "metadata");
+            block = file.createBlock("block", "nix.bench");
+        };
+        auto create = [&] {
+            for (nix::ndsize_t i = 0; i < n; i++) {
+                block.createSource("source_" + std::to_string(i), "nix.bench");
+            }
+        };
 
-class BlockGenerator : public RndGenBase {
-public:
+        runner.run("metadata", "create_sources", backend, n, n, 0, create, setup);
+        if (!runner.wanted("metadata", {"lookup_name", "lookup_id", "has_name", "enumerate", "enumerate_index"})) {
+            continue;
+        }
+        if (!block || block.sourceCount() != n) {
+            setup();
+            create();
+        }
 
-    BlockGenerator(const Config &cfg, size_t bufsize)
-            : blocksize(cfg.size()), dtype(cfg.dtype()), uni_dis(0, bufsize-1) {
-        for(size_t i = 0; i < bufsize; i++) {
-            blocks.push_back(make_block());
+        std::vector<std::string> names, ids;
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<nix::ndsize_t> dis(0, n - 1);
+        for (nix::ndsize_t i = 0; i < nlookups; i++) {
+            const nix::ndsize_t k = dis(gen);
+            names.push_back("source_" + std::to_string(k));
+            ids.push_back(block.getSource(names.back()).id());
         }
-    };
 
-    struct BlockMaker {
+        runner.run("metadata", "lookup_name", backend, n, nlookups, 0, [&] {
+            for (const auto &name : names) {
+                block.getSource(name);
+            }
+        });
 
-    public:
-        template<typename U>
-        nix::NDArray operator()(U tag, const nix::NDSize &size) {
-            RndGen<U> rnd_gen;
+        runner.run("metadata", "lookup_id", backend, n, nlookups, 0, [&] {
+            for (const auto &id : ids) {
+                block.getSource(id);
+            }
+        });
 
-            nix::NDArray data(nix::to_data_type<U>::value, size);
-            for(size_t i = 0; i < data.num_elements(); i++) {
-                data.set(i, rnd_gen());
+        runner.run("metadata", "has_name", backend, n, nlookups, 0, [&] {
+            for (const auto &name : names) {
+                block.hasSource(name);
             }
+        });
 
-            return data;
-        };
-    };
+        runner.run("metadata", "enumerate", backend, n, n, 0, [&] {
+            block.sources();
+        });
 
-    nix::NDArray make_block() {
-        BlockMaker maker;
-        return nix::data_type_dispatch(dtype, maker, std::ref(blocksize));
-    }
+        runner.run("metadata", "enumerate_index", backend, n, n, 0, [&] {
+            for (nix::ndsize_t i = 0; i < n; i++) {
+                block.getSource(i);
+            }
+        });
 
-    nix::NDArray next_block() {
-        size_t index = uni_dis(rd_gen);
-        nix::NDArray block = blocks[index];
-        return block;
+        file.close();
     }
+}
 
-    double speed_test(size_t &iterations) {
-
-        Stopwatch sw;
+/* ************************************ */
+// Section / Property trees
 
-        size_t N = 100;
-        iterations = 0;
+static void bench_sections(Runner &runner, const std::string &backend) {
+    const size_t fanout = 10;
+    const size_t nprops = 10;
+    const nix::ndsize_t nlookups = 1000;
 
-        do {
-            Stopwatch inner;
+    for (nix::ndsize_t n : runner.scales(100)) {
+        // three levels of fanout sections each, n sections in total
+        const size_t roots = std::max<size_t>(static_cast<size_t>(n / (fanout * fanout + fanout + 1)), 1);
+        const nix::ndsize_t nsections = roots * (1 + fanout + fanout * fanout);
 
-            for (size_t i = 0; i < N; i++) {
-                nix::NDArray data = next_block();
-                assert(data.size() == blocksize);
-                iterations++;
-            }
+        nix::File file;
+        std::vector<nix::Section> leaves;
 
-            if (inner.ms() < 100) {
-                N *= 2;
+        auto setup = [&] {
+            file = runner.create(backend, "sections");
+            leaves.clear();
+        };
+        auto create = [&] {
+            for (size_t r = 0; r < roots; r++) {
+                nix::Section root = file.createSection("root_" + std::to_string(r), "nix.bench");
+                for (size_t i = 0; i < fanout; i++) {
+                    nix::Section mid = root.createSection("mid_" + std::to_string(i), "nix.bench");
+                    for (size_t k = 0; k < fanout; k++) {
+                        nix::Section leaf = mid.createSection("leaf_" + std::to_string(k), "nix.bench");
+                        for (size_t p = 0; p < nprops; p++) {
+                            leaf.createProperty("prop_" + std::to_string(p), nix::Variant(1.0 * p));
+                        }
+                        leaves.push_back(leaf);
+                    }
+                }
             }
+        };
 
-        } while (sw.ms() < 1000);
-
-        ssize_t count = sw.ms();
-        return count;
-    }
-
-private:
-    nix::NDSize blocksize;
-    nix::DataType dtype;
-    std::uniform_int_distribution<size_t> uni_dis;
-    std::vector<nix::NDArray> blocks;
-};
-
-
-class Benchmark {
-public:
-    Benchmark(const Config &cfg) : config(cfg) { }
-    const Config & cfg() const { return config; }
-
-    nix::DataArray openDataArray(nix::Block block) const {
-        const std::string &cfg_name = config.name();
-        std::vector<nix::DataArray> v = block.dataArrays(nix::util::NameFilter<nix::DataArray>(cfg_name));
-        if (v.empty()) {
-            return block.createDataArray(cfg_name, "nix.test.da", config.dtype(), config.extend());
-        } else {
-            return v[0];
+        runner.run("sections", "create_tree", backend, nsections, nsections, 0, create, setup);
+        if (!runner.wanted("sections", {"find_all", "find_by_name", "property_lookup", "property_values",
+                                        "property_write", "parent"})) {
+            continue;
+        }
+        if (leaves.size() != roots * fanout * fanout) {
+            setup();
+            create();
         }
-    }
-
-    virtual ~Benchmark() { }
-
-    virtual double speed_in_mbs() {
-        return count * config.size().nelms() * nix::data_type_to_size(config.dtype()) *
-                (1000.0/millis) / (1024 * 1024);
-    }
 
-    virtual double speed_in_nps() {
-        return count * config.size().nelms() * (1000.0/millis);
-    }
+        runner.run("sections", "find_all", backend, nsections, nsections, 0, [&] {
+            file.findSections();
+        });
 
-    template<typename F>
-    ssize_t time_it(F func) {
-        Stopwatch watch;
-        func();
-        return watch.ms();
-    }
+        runner.run("sections", "find_by_name", backend, nsections, nsections, 0, [&] {
+            file.findSections(nix::util::NameFilter<nix::Section>("leaf_3"));
+        });
 
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<size_t> dis(0, leaves.size() - 1);
+        std::vector<nix::Property> props;
+        for (nix::ndsize_t i = 0; i < nlookups; i++) {
+            props.push_back(leaves[dis(gen)].getProperty("prop_" + std::to_string(i % nprops)));
+        }
 
-    virtual void run(nix::Block block) = 0;
-    virtual std::string id() = 0;
+        runner.run("sections", "property_lookup", backend, nsections, nlookups, 0, [&] {
+            for (nix::ndsize_t i = 0; i < nlookups; i++) {
+                leaves[i % leaves.size()].getProperty("prop_" + std::to_string(i % nprops));
+            }
+        });
 
-protected:
-    const Config config;
-    size_t       count;
-    double       millis;
-};
+        runner.run("sections", "property_values", backend, nsections, nlookups, 0, [&] {
+            for (auto &prop : props) {
+                prop.values();
+            }
+        });
 
-class GeneratorBenchmark : public Benchmark {
-public:
-    GeneratorBenchmark(const Config &cfg)
-            : Benchmark(cfg) {
+        const std::vector<nix::Variant> values(16, nix::Variant(42.0));
+        runner.run("sections", "property_write", backend, nsections, nlookups, 0, [&] {
+            for (auto &prop : props) {
+                prop.values(values);
+            }
+        });
 
-    };
+        runner.run("sections", "parent", backend, nsections, nlookups, 0, [&] {
+            for (nix::ndsize_t i = 0; i < nlookups; i++) {
+                leaves[i % leaves.size()].parent();
+            }
+        });
 
-    void run(nix::Block block) override {
-        BlockGenerator generator(config, 10);
-        this->millis = generator.speed_test(this->count);
+        file.close();
     }
+}
 
-    std::string id() override {
-        return "G";
-    }
-};
+/* ************************************ */
+// DataFrame row and column I/O
+
+static void bench_dataframe(Runner &runner, const std::string &backend) {
+    const std::vector<nix::Column> cols = {{"label", "", nix::DataType::String},
+                                           {"time", "s", nix::DataType::Double},
+                                           {"value", "mV", nix::DataType::Double},
+                                           {"trial", "", nix::DataType::Int32}};
+
+    for (nix::ndsize_t n : runner.scales()) {
+        nix::File file;
+        nix::DataFrame df;
+
+        auto setup = [&] {
+            file = runner.create(backend, "dataframe");
+            df = file.createBlock("block", "nix.bench").createDataFrame("frame", "nix.bench", cols);
+            df.rows(n);
+        };
+        auto write = [&] {
+            for (nix::ndsize_t i = 0; i < n; i++) {
+                df.writeRow(i, {nix::Variant("trial"), nix::Variant(0.001 * i),
+                                nix::Variant(1.0 * i), nix::Variant(static_cast<int32_t>(i))});
+            }
+        };
 
+        runner.run("dataframe", "write_rows", backend, n, n, 0, write, setup);
+        if (!runner.wanted("dataframe", {"read_rows", "write_column", "read_column"})) {
+            continue;
+        }
+        try {
+            if (!df) {
+                setup();
+                write();
+            }
+        } catch (const std::exception &e) {
+            std::cerr << "dataframe [" << backend << "] not supported: " << e.what() << std::endl;
+            continue;
+        }
 
-class WriteBenchmark : public Benchmark {
+        runner.run("dataframe", "read_rows", backend, n, n, 0, [&] {
+            for (nix::ndsize_t i = 0; i < n; i++) {
+                df.readRow(i);
+            }
+        });
 
-public:
-    WriteBenchmark(const Config &cfg)
-            : Benchmark(cfg) {
-    };
+        const nix::ndsize_t column_bytes = n * sizeof(double);
+        std::vector<double> values(n, 1.0);
+        runner.run("dataframe", "write_column", backend, n, 1, column_bytes, [&] {
+            df.writeColumn("value", values);
+        });
 
-    void run(nix::Block block) override {
-        nix::DataArray da = openDataArray(block);
+        runner.run("dataframe", "read_column", backend, n, 1, column_bytes, [&] {
+            std::vector<double> column;
+            df.readColumn("value", column, true);
+        });
 
-        BlockGenerator generator(config, 10);
+        file.close();
+    }
+}
 
-        size_t N = 100;
-        size_t iterations = 0;
+/* ************************************ */
+// bulk data I/O, in blocks along one dimension
+
+static void bench_data(Runner &runner, const std::string &backend) {
+    const std::vector<nix::NDSize> block_sizes = {{2048, 1}, {1, 2048}};
+    const nix::ndsize_t nblocks = std::min<nix::ndsize_t>(runner.options().max_scale, 1000);
+
+    for (const nix::NDSize &bs : block_sizes) {
+        const size_t axis = bs[0] == 1 ? 0 : 1;
+        const std::string shape = std::to_string(bs[0]) + "x" + std::to_string(bs[1]);
+        const nix::ndsize_t bytes = nblocks * bs.nelms() * sizeof(double);
+
+        std::vector<double> block(bs.nelms());
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<double> dis(-1024.0, 1024.0);
+        std::generate(block.begin(), block.end(), [&] { return dis(gen); });
+
+        nix::File file;
+        nix::DataArray da;
+
+        auto setup = [&] {
+            file = runner.create(backend, "data");
+            nix::NDSize extent = bs;
+            extent[axis] = 0;
+            da = file.createBlock("block", "nix.bench").createDataArray("data", "nix.bench",
+                                                                          nix::DataType::Double, extent);
+        };
+        auto write = [&] {
+            nix::NDSize pos = {0, 0};
+            for (nix::ndsize_t i = 0; i < nblocks; i++) {
+                da.dataExtent(bs + pos);
+                da.setData(nix::DataType::Double, block.data(), bs, pos);
+                pos[axis] += 1;
+            }
+        };
 
-        nix::NDSize pos = {0, 0};
-        Stopwatch sw;
-        ssize_t ms = 0;
-        do {
-            Stopwatch inner;
+        runner.run("data", "write_" + shape, backend, nblocks, nblocks, bytes, write, setup);
+        if (!runner.wanted("data", {"read_" + shape, "read_poly_" + shape})) {
+            continue;
+        }
+        if (!da) {
+            setup();
+            write();
+        }
 
-            for (size_t i = 0; i < N; i++) {
-                nix::NDArray block = generator.next_block();
-                da.dataExtent(config.size() + pos);
-                da.setData(config.dtype(), block.data(), config.size(), pos);
-                pos[config.singleton_dimension()] += 1;
-                iterations++;
+        auto read = [&] {
+            nix::NDSize pos = {0, 0};
+            for (nix::ndsize_t i = 0; i < nblocks; i++) {
+                da.getData(nix::DataType::Double, block.data(), bs, pos);
+                pos[axis] += 1;
             }
+        };
 
-            if (inner.ms() < 100) {
-                N *= 2;
-            }
+        runner.run("data", "read_" + shape, backend, nblocks, nblocks, bytes, read);
 
-        } while ((ms = sw.ms()) < 3*1000);
+        da.polynomCoefficients({3, 4, 5, 6});
+        runner.run("data", "read_poly_" + shape, backend, nblocks, nblocks, bytes, read);
 
-        this->count = iterations;
-        this->millis = ms;
+        file.close();
     }
+}
 
-    std::string id() override {
-        return "W";
+/* ************************************ */
+// compressed multichannel data, written and read serially and on several threads
+
+static void bench_compression(Runner &runner, const std::string &backend) {
+    const nix::ndsize_t nchannels = 384;
+    const nix::ndsize_t nsamples = std::min<nix::ndsize_t>(runner.options().max_scale, 1000000);
+    const nix::NDSize extent = {nchannels, nsamples};
+    const nix::ndsize_t bytes = extent.nelms() * sizeof(int16_t);
+
+    // band limited noise around a slow oscillation, like a recording
+    std::vector<int16_t> data(extent.nelms());
+    std::mt19937 gen(42);
+    std::normal_distribution<double> noise(0.0, 20.0);
+    for (nix::ndsize_t c = 0; c < nchannels; c++) {
+        double level = 0;
+        for (nix::ndsize_t t = 0; t < nsamples; t++) {
+            level = 0.9 * level + noise(gen);
+            data[c * nsamples + t] = static_cast<int16_t>(level + 200.0 * std::sin(0.001 * t + c));
+        }
     }
-};
-
 
-class ReadBenchmark : public Benchmark {
+    nix::File file;
+    nix::DataArray da;
 
-public:
-    ReadBenchmark(const Config &cfg)
-            : Benchmark(cfg) {
+    auto setup = [&] {
+        if (file) {
+            file.close();
+        }
+        file = runner.create(backend, "compression");
+        da = file.createBlock("block", "nix.bench").createDataArray("data", "nix.bench", nix::DataType::Int16,
+                                                                      extent, nix::Compression::DeflateNormal);
     };
 
-    void test_read_io(nix::DataArray da) {
-
-        nix::NDArray array(config.dtype(), config.size());
-        nix::NDSize extend = da.dataExtent();
-        size_t N = extend[config.singleton_dimension()];
-
-        nix::NDSize pos = {0, 0};
-
-        ssize_t ms = time_it([this, &da, &N, &pos, &array] {
-            for(size_t i = 0; i < N; i++) {
-                da.getData(config.dtype(), array.data(), config.size(), pos);
-                pos[config.singleton_dimension()] += 1;
-            }
-        });
+    runner.run("compression", "write_serial", backend, nsamples, 1, bytes, [&] {
+        da.setData(nix::DataType::Int16, data.data(), extent, {0, 0});
+    }, setup);
 
-        this->count = N;
-        this->millis = ms;
+    const size_t ncores = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    std::vector<size_t> nthreads;
+    for (size_t n = 1; n < ncores; n *= 2) {
+        nthreads.push_back(n);
     }
+    nthreads.push_back(ncores);
 
-    void run(nix::Block block) override {
-        nix::DataArray da = openDataArray(block);
-        test_read_io(da);
+    for (size_t n : nthreads) {
+        runner.run("compression", "write_parallel_" + std::to_string(n), backend, nsamples, 1, bytes, [&] {
+            da.setDataParallel(nix::DataType::Int16, data.data(), extent, {0, 0}, n);
+        }, setup);
     }
 
-    std::string id() override {
-        return "R";
+    std::vector<std::string> reads = {"read_serial"};
+    for (size_t n : nthreads) {
+        reads.push_back("read_parallel_" + std::to_string(n));
+    }
+    if (!runner.wanted("compression", reads)) {
+        if (file) {
+            file.close();
+        }
+        return;
+    }
+    if (!da) {
+        setup();
+        da.setData(nix::DataType::Int16, data.data(), extent, {0, 0});
     }
-};
-
-
-class ReadPolyBenchmark : public ReadBenchmark {
 
-public:
-    ReadPolyBenchmark(const Config &cfg)
-            : ReadBenchmark(cfg) {
-    };
+    std::vector<int16_t> out(data.size());
+    runner.run("compression", "read_serial", backend, nsamples, 1, bytes, [&] {
+        da.getData(nix::DataType::Int16, out.data(), extent, {0, 0});
+    });
 
-    void run(nix::Block block) override {
-        nix::DataArray da = openDataArray(block);
-        da.polynomCoefficients({3, 4, 5, 6});
-        test_read_io(da);
+    for (size_t n : nthreads) {
+        runner.run("compression", "read_parallel_" + std::to_string(n), backend, nsamples, 1, bytes, [&] {
+            da.getDataParallel(nix::DataType::Int16, out.data(), extent, {0, 0}, n);
+        });
     }
 
-    std::string id() override {
-        return "P";
+    if (file) {
+        file.close();
     }
-};
-
-class DiskBenchmark : public Benchmark {
-public:
-    DiskBenchmark(const Config &cfg)
-            : Benchmark(cfg), fd(nullptr) {
+}
 
-    };
+/* ************************************ */
+// MultiTag data retrieval, dimension index lookups and unit scaling
 
-    void openFile(bool readOnly) {
-        std::string path = config.name() + "io.raw";
-        const char *mode = readOnly ? "rb" : "wb";
-        fd = fopen(path.c_str(), mode);
-        setvbuf(fd, nullptr, _IONBF, 0);
+static void bench_tagging(Runner &runner, const std::string &backend) {
+    if (!runner.wanted("tagging", {"retrieve_data", "retrieve_data_batch", "sampled_index_of",
+                                   "range_index_of", "position_to_index"})) {
+        return;
     }
 
-    void read_test() {
-        const size_t nelms = config.size().nelms();
-        const size_t elmsize = nix::data_type_to_size(config.dtype());
-        const size_t nbytes = nelms * elmsize;
-        std::vector<char> buffer(nbytes, 0);
+    const nix::ndsize_t nsamples = std::max<nix::ndsize_t>(runner.options().max_scale * 100, 100000);
+    const nix::ndsize_t npositions = 1000;
+    const nix::ndsize_t nlookups = 100000;
 
-        Stopwatch sw;
-        ssize_t n;
-        size_t count = 0;
+    nix::File file = runner.create(backend, "tagging");
+    nix::Block block = file.createBlock("block", "nix.bench");
 
-        while ((n = fread(buffer.data(), nbytes, 1, fd)) > 0) {
-            count += n;
-        }
+    std::vector<double> samples(nsamples, 1.0);
+    nix::DataArray signal = block.createDataArray("signal", "nix.bench", samples);
+    nix::SampledDimension sampled = signal.appendSampledDimension(0.001);
+    sampled.unit("s");
 
-        this->millis = sw.ms();
-        this->count = count;
+    std::vector<double> ticks(nsamples);
+    for (nix::ndsize_t i = 0; i < nsamples; i++) {
+        ticks[i] = 0.001 * i;
     }
+    nix::DataArray events = block.createDataArray("events", "nix.bench", samples);
+    nix::RangeDimension range = events.appendRangeDimension(ticks);
+    range.unit("s");
 
-    void write_test() {
-        BlockGenerator generator(config, 10);
+    const double duration = 0.001 * nsamples;
+    std::vector<double> positions(npositions), extents(npositions, 0.5 * duration / npositions);
+    for (nix::ndsize_t i = 0; i < npositions; i++) {
+        positions[i] = duration * i / npositions;
+    }
+    nix::DataArray pos_da = block.createDataArray("positions", "nix.bench", positions);
+    pos_da.appendSetDimension();
+    nix::DataArray ext_da = block.createDataArray("extents", "nix.bench", extents);
+    ext_da.appendSetDimension();
 
-        size_t N = 100;
-        size_t iterations = 0;
+    nix::MultiTag mtag = block.createMultiTag("mtag", "nix.bench", pos_da);
+    mtag.extents(ext_da);
+    mtag.units({"s"});
+    mtag.addReference(signal);
 
-        nix::NDSize pos = {0, 0};
-        Stopwatch sw;
-        ssize_t ms = 0;
-        const size_t elm_size = nix::data_type_to_size(config.dtype());
-        do {
-            Stopwatch inner;
+    runner.run("tagging", "retrieve_data", backend, npositions, npositions, 0, [&] {
+        for (nix::ndsize_t i = 0; i < npositions; i++) {
+            mtag.retrieveData(i, 0);
+        }
+    });
 
-            for (size_t i = 0; i < N; i++) {
-                nix::NDArray block = generator.next_block();
+    std::vector<nix::ndsize_t> indices(npositions);
+    for (nix::ndsize_t i = 0; i < npositions; i++) {
+        indices[i] = i;
+    }
+    runner.run("tagging", "retrieve_data_batch", backend, npositions, npositions, 0, [&] {
+        mtag.retrieveData(indices, 0);
+    });
 
-                ssize_t nwritten = fwrite(block.data(), elm_size, block.num_elements(), fd);
+    std::vector<double> lookups(nlookups);
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dis(0, duration);
+    std::generate(lookups.begin(), lookups.end(), [&] { return dis(gen); });
 
-                if (nwritten != block.num_elements()) {
-                    throw std::runtime_error("Output error in disk write test.");
-                }
+    runner.run("tagging", "sampled_index_of", backend, nsamples, nlookups, 0, [&] {
+        for (double x : lookups) {
+            sampled.indexOf(x);
+        }
+    });
 
-                iterations++;
-            }
+    const nix::ndsize_t nrange = 1000;
+    runner.run("tagging", "range_index_of", backend, nsamples, nrange, 0, [&] {
+        for (nix::ndsize_t i = 0; i < nrange; i++) {
+            range.indexOf(lookups[i]);
+        }
+    });
 
-            fflush(fd);
+    runner.run("tagging", "position_to_index", backend, nsamples, nrange, 0, [&] {
+        for (nix::ndsize_t i = 0; i < nrange; i++) {
+            nix::util::positionToIndex(lookups[i] * 1000, "ms", sampled);
+        }
+    });
 
-            if (inner.ms() < 100) {
-                N *= 2;
-            }
+    file.close();
+}
 
-        } while ((ms = sw.ms()) < 3 * 1000);
+static void bench_units(Runner &runner) {
+    const nix::ndsize_t n = 1000;
+    const std::vector<std::pair<std::string, std::string>> units = {
+        {"mV", "V"}, {"ms", "s"}, {"kHz", "Hz"}, {"uV^2", "mV^2"}
+    };
 
-        count = iterations;
-        millis = ms;
-    }
+    runner.run("units", "si_scaling", "none", n, n, 0, [&] {
+        for (nix::ndsize_t i = 0; i < n; i++) {
+            const auto &u = units[i % units.size()];
+            nix::util::getSIScaling(u.first, u.second);
+        }
+    });
 
-    void closeFile() {
-        if (fd) {
-            fclose(fd);
-            fd = nullptr;
+    runner.run("units", "is_scalable", "none", n, n, 0, [&] {
+        for (nix::ndsize_t i = 0; i < n; i++) {
+            const auto &u = units[i % units.size()];
+            nix::util::isScalable(u.first, u.second);
         }
-    }
+    });
+}
 
+/* ************************************ */
+// heap allocations of common accessors
 
-    ~DiskBenchmark() {
-        closeFile();
+static void bench_alloc(Runner &runner, const std::string &backend) {
+    if (!runner.wanted("alloc", {"get_data_string", "get_data_poly", "get_data_poly_arena", "property_values"})) {
+        return;
     }
 
-private:
-    std::FILE *fd;
-};
+    const nix::ndsize_t n = 1000;
 
-class DiskReadBenchmark : public DiskBenchmark {
-public:
-    DiskReadBenchmark(const Config &cfg)
-            : DiskBenchmark(cfg) {
+    nix::File fd = runner.create(backend, "alloc");
+    nix::Block block = fd.createBlock("alloc", "nix.bench");
 
-    };
+    std::vector<std::string> strings(128, "trial-label");
+    nix::DataArray sa = block.createDataArray("alloc_strings", "nix.bench", strings);
+    runner.run("alloc", "get_data_string", backend, 128, n, 0, [&] {
+        std::vector<std::string> out(128);
+        for (nix::ndsize_t i = 0; i < n; i++) {
+            sa.getData(nix::DataType::String, out.data(), {128}, {0});
+        }
+    });
+
+    std::vector<int16_t> raw(2048, 42);
+    nix::DataArray pa = block.createDataArray("alloc_poly", "nix.bench", raw);
+    pa.polynomCoefficients({0.5, 2.0});
+    runner.run("alloc", "get_data_poly", backend, 2048, n, 0, [&] {
+        int16_t out[2048];
+        for (nix::ndsize_t i = 0; i < n; i++) {
+            pa.getData(nix::DataType::Int16, out, {2048}, {0});
+        }
+    });
+
+    runner.run("alloc", "get_data_poly_arena", backend, 2048, n, 0, [&] {
+        int16_t out[2048];
+        nix::Arena arena;
+        for (nix::ndsize_t i = 0; i < n; i++) {
+            nix::ArenaScope scope(arena);
+            pa.getData(nix::DataType::Int16, out, {2048}, {0});
+        }
+    });
+
+    nix::Section sec = fd.createSection("alloc_section", "nix.bench");
+    std::vector<nix::Variant> vals(64, nix::Variant(23.0));
+    nix::Property prop = sec.createProperty("alloc_values", vals);
+    runner.run("alloc", "property_values", backend, 64, n, 0, [&] {
+        for (nix::ndsize_t i = 0; i < n; i++) {
+            prop.values();
+        }
+    });
 
-    void run(nix::Block b) override {
-        openFile(true);
-        read_test();
-        closeFile();
-    }
+    fd.close();
+}
 
-    std::string id() override {
-        return "I";
-    }
-};
+/* ************************************ */
 
-class DiskWriteBenchmark : public DiskBenchmark {
-public:
-    DiskWriteBenchmark(const Config &cfg)
-            : DiskBenchmark(cfg) {
+static std::string json_str(const std::string &str) {
+    std::string res = "\"";
+    for (char c : str) {
+        if (c == '"' || c == '\\') {
+            res += '\\';
+            res += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char buf[8];
+            std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+            res += buf;
+        } else {
+            res += c;
+        }
+    }
+    return res + "\"";
+}
 
-    };
+static void write_json(std::ostream &out, const Options &opts, const std::vector<Result> &results) {
+    char date[32];
+    const time_t now = time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+    std::ostringstream version;
+    version << nix::FormatVersion(nix::apiVersion());
+
+    out.precision(6);
+    out << "{\n"
+        << "  \"version\": " << json_str(version.str()) << ",\n"
+        << "  \"date\": " << json_str(date) << ",\n"
+        << "  \"max_scale\": " << opts.max_scale << ",\n"
+        << "  \"repeat\": " << opts.repeat << ",\n"
+        << "  \"results\": [";
+
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result &r = results[i];
+        const double median = r.median();
+
+        out << (i ? ",\n" : "\n") << "    {\"suite\": " << json_str(r.suite)
+            << ", \"name\": " << json_str(r.name)
+            << ", \"backend\": " << json_str(r.backend)
+            << ", \"n\": " << r.n
+            << ", \"ops\": " << r.ops;
+
+        if (!r.error.empty()) {
+            out << ", \"error\": " << json_str(r.error) << "}";
+            continue;
+        }
 
-    void run(nix::Block b) override {
-        openFile(false);
-        write_test();
-        closeFile();
+        out << ", \"seconds\": [";
+        for (size_t k = 0; k < r.seconds.size(); k++) {
+            out << (k ? ", " : "") << r.seconds[k];
+        }
+        out << "], \"median\": " << median
+            << ", \"seconds_per_op\": " << median / std::max<nix::ndsize_t>(r.ops, 1)
+            << ", \"ops_per_second\": " << (median > 0 ? r.ops / median : 0);
+        if (r.bytes > 0) {
+            out << ", \"mb_per_second\": " << (median > 0 ? r.bytes / median / (1024 * 1024) : 0);
+        }
+        out << ", \"allocs_per_op\": " << r.allocs << "}";
     }
 
-    std::string id() override {
-        return "O";
-    }
-};
+    out << (results.empty() ? "]\n" : "\n  ]\n") << "}" << std::endl;
+}
 
 /* ************************************ */
 
-static std::vector<Config> make_configs() {
-
-    std::vector<Config> configs;
-
-    configs.emplace_back(nix::DataType::Double, nix::NDSize{2048, 1});
-    configs.emplace_back(nix::DataType::Double, nix::NDSize{1, 2048});
-
-    return configs;
+static void usage() {
+    std::cerr << "Usage: nix-bench [options]\n\n"
+              << "  --backend=NAME    run the file benchmarks with backend NAME (hdf5 or file),\n"
+              << "                    may be repeated; default: all available backends\n"
+              << "  --max-scale=N     largest number of entities/rows (powers of 10, default 10000)\n"
+              << "  --repeat=N        number of runs of each benchmark (default 3)\n"
+              << "  --filter=REGEX    only run benchmarks whose suite/name matches REGEX\n"
+              << "  --output=FILE     write the results as JSON to FILE (default: std out)\n"
+              << "  --dir=DIR         directory for the benchmark files (default: .)\n\n"
+              << "Compare two result files with test/benchmark-compare.py." << std::endl;
 }
 
-int main(int argc, char **argv)
-{
-    nix::File fd = nix::File::open("iospeed.h5", nix::FileMode::Overwrite);
-    nix::Block block = fd.createBlock("speed", "nix.test");
-
-    std::vector<Config> configs = make_configs();
-    std::vector<Benchmark *> marks;
-
-    std::cout << "Performing generators tests..." << std::endl;
-    for (const Config &cfg : configs) {
-        GeneratorBenchmark *benchmark = new GeneratorBenchmark(cfg);
-        benchmark->run(block);
-        marks.push_back(benchmark);
-    }
-
-    std::cout << "Performing disk IO tests..." << std::endl;
-    for (const Config &cfg : configs) {
-        DiskWriteBenchmark *b = new DiskWriteBenchmark(cfg);
-        b->run(block);
-        marks.push_back(b);
-    }
-
-    std::cout << "Performing read tests..." << std::endl;
-    for (const Config &cfg : configs) {
-        DiskReadBenchmark *b = new DiskReadBenchmark(cfg);
-        b->run(block);
-        marks.push_back(b);
+static Options parse_options(int argc, char **argv) {
+    Options opts;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        const size_t eq = arg.find('=');
+        const std::string key = arg.substr(0, eq);
+        const std::string val = eq == std::string::npos ? "" : arg.substr(eq + 1);
+
+        if (key == "--backend") {
+            opts.backends.push_back(val);
+        } else if (key == "--max-scale") {
+            opts.max_scale = std::stoull(val);
+        } else if (key == "--repeat") {
+            opts.repeat = std::max<size_t>(std::stoul(val), 1);
+        } else if (key == "--filter") {
+            opts.filter = val;
+        } else if (key == "--output") {
+            opts.output = val;
+        } else if (key == "--dir") {
+            opts.dir = val;
+        } else {
+            usage();
+            std::exit(key == "--help" ? 0 : 1);
+        }
     }
 
-    std::cout << "Performing write tests..." << std::endl;
-    for (const Config &cfg : configs) {
-        WriteBenchmark *benchmark = new WriteBenchmark(cfg);
-        benchmark->run(block);
-        marks.push_back(benchmark);
+    if (opts.backends.empty()) {
+        opts.backends.push_back("hdf5");
+#ifdef ENABLE_FS_BACKEND
+        opts.backends.push_back("file");
+#endif
     }
 
-    std::cout << "Performing read tests..." << std::endl;
-    for (const Config &cfg : configs) {
-        ReadBenchmark *benchmark = new ReadBenchmark(cfg);
-        benchmark->run(block);
-        marks.push_back(benchmark);
-    }
+    return opts;
+}
 
-    std::cout << "Performing read (poly) tests..." << std::endl;
-    for (const Config &cfg : configs) {
-        ReadPolyBenchmark *benchmark = new ReadPolyBenchmark(cfg);
-        benchmark->run(block);
-        marks.push_back(benchmark);
+int main(int argc, char **argv)
+{
+    const Options opts = parse_options(argc, argv);
+    Runner runner(opts);
+
+    for (const std::string &backend : opts.backends) {
+        bench_metadata(runner, backend);
+        bench_sections(runner, backend);
+        bench_dataframe(runner, backend);
+        bench_data(runner, backend);
+        bench_compression(runner, backend);
+        bench_tagging(runner, backend);
+        bench_alloc(runner, backend);
+    }
+    bench_units(runner);
+
+    for (const char *name : {"metadata", "sections", "dataframe", "data", "compression", "tagging", "alloc"}) {
+        for (const std::string &backend : opts.backends) {
+            boost::system::error_code ec;
+            boost::filesystem::remove_all(runner.path(backend, name), ec);
+        }
     }
 
-    std::cout << " === Reports ===" << std::endl;
-    std::cout.precision(5);
-    std::cout.unsetf (std::ios::floatfield);
-    for (Benchmark *mark : marks) {
-        std::cout << mark->cfg().name() << ", " << mark->id() << ", "
-                << mark->speed_in_mbs() << " MB/s, "
-                << mark->speed_in_nps() << " N/s" << std::endl;
-        delete mark;
+    if (opts.output.empty() || opts.output == "-") {
+        write_json(std::cout, opts, runner.all());
+    } else {
+        std::ofstream out(opts.output);
+        write_json(out, opts, runner.all());
     }
 
-
     return 0;
 }
@@ -0,0 +1,40 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "BenchmarkAlloc.hpp"
+
+#include <nix/Platform.hpp>
+
+#include <cstdlib>
+#include <new>
+
+// Kept apart from Benchmark.cpp: where GCC can inline these it pairs
+// malloc with operator delete and warns about mismatched new and delete.
+
+std::atomic<size_t> alloc_count(0);
+
+void *operator new(std::size_t size) {
+    alloc_count++;
+    void *p = std::malloc(size ? size : 1);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void *p) NOEXCEPT {
+    std::free(p);
+}
+
+void *operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete[](void *p) NOEXCEPT {
+    operator delete(p);
+}
@@ -0,0 +1,19 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_BENCHMARK_ALLOC_H
+#define NIX_BENCHMARK_ALLOC_H
+
+#include <atomic>
+#include <cstddef>
+
+// the number of heap allocations of the whole process, counted by the
+// replacement operator new of BenchmarkAlloc.cpp
+extern std::atomic<size_t> alloc_count;
+
+#endif // NIX_BENCHMARK_ALLOC_H
@@ -12,6 +12,7 @@
 #include "TestVariant.hpp"
 #include "TestValue.hpp"
 #include "TestVersion.hpp"
+#include "TestArena.hpp"
 #include "TestOptionalObligatory.hpp"
 
 #include "TestValidate.hpp"
@@ -38,6 +39,19 @@
 #include "hdf5/TestDataAccessHDF5.hpp"
 #include "hdf5/TestReadOnlyHDF5.hpp"
 #include "hdf5/TestGroupHDF5.hpp"
+#include "memory/TestFileMemory.hpp"
+#include "memory/TestBlockMemory.hpp"
+#include "memory/TestDataArrayMemory.hpp"
+#include "memory/TestMultiTagMemory.hpp"
+#include "memory/TestSectionMemory.hpp"
+#include "memory/TestPropertyMemory.hpp"
+#include "memory/TestDataFrameMemory.hpp"
+#include "memory/TestTagMemory.hpp"
+#include "memory/TestGroupMemory.hpp"
+#include "memory/TestSourceMemory.hpp"
+#include "memory/TestFeatureMemory.hpp"
+#include "memory/TestDimensionMemory.hpp"
+#include "memory/TestBaseTagMemory.hpp"
 
 #ifdef ENABLE_FS_BACKEND
 #include "fs/TestAttributesFS.hpp"
@@ -89,6 +103,20 @@ int main(int argc, char* argv[]) {
     CPPUNIT_TEST_SUITE_REGISTRATION(TestVersion);
     CPPUNIT_TEST_SUITE_REGISTRATION(TestReadOnlyHDF5);
     CPPUNIT_TEST_SUITE_REGISTRATION(TestGroupHDF5);
+    CPPUNIT_TEST_SUITE_REGISTRATION(TestArena);
+    CPPUNIT_TEST_SUITE_REGISTRATION(TestFileMemory);
+    CPPUNIT_TEST_SUITE_REGISTRATION(TestBlockMemory);
+    CPPUNIT_TEST_SUITE_REGISTRATION(TestDataArrayMemory);
+    CPPUNIT_TEST_SUITE_REGISTRATION(TestMultiTagMemory);
+    CPPUNIT_TEST_SUITE_REGISTRATION(TestSectionMemory);
+    CPPUNIT_TEST_SUITE_REGISTRATION(TestPropertyMemory);
+    CPPUNIT_TEST_SUITE_REGISTRATION(TestDataFrameMemory);
+    CPPUNIT_TEST_SUITE_REGISTRATION(TestTagMemory);
+    CPPUNIT_TEST_SUITE_REGISTRATION(TestGroupMemory);
+    CPPUNIT_TEST_SUITE_REGISTRATION(TestSourceMemory);
+    CPPUNIT_TEST_SUITE_REGISTRATION(TestFeatureMemory);
+    CPPUNIT_TEST_SUITE_REGISTRATION(TestDimensionMemory);
+    CPPUNIT_TEST_SUITE_REGISTRATION(TestBaseTagMemory);
 
 #ifdef ENABLE_FS_BACKEND
     CPPUNIT_TEST_SUITE_REGISTRATION(TestAttributesFS);
@@ -0,0 +1,81 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "TestArena.hpp"
+
+#include <nix/Arena.hpp>
+
+#include <cstdint>
+
+void TestArena::testAllocate() {
+    nix::Arena arena(128);
+
+    void *a = arena.allocate(3, 1);
+    void *b = arena.allocate(sizeof(double), alignof(double));
+    CPPUNIT_ASSERT(a != b);
+    CPPUNIT_ASSERT_EQUAL(static_cast<uintptr_t>(0), reinterpret_cast<uintptr_t>(b) % alignof(double));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), arena.allocations());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3 + sizeof(double)), arena.bytesUsed());
+
+    // larger than a block: arena has to grow
+    arena.allocate(1024);
+    CPPUNIT_ASSERT(arena.capacity() >= 1024 + 128);
+
+    size_t cap = arena.capacity();
+    arena.reset();
+    CPPUNIT_ASSERT_EQUAL(cap, arena.capacity());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), arena.bytesUsed());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), arena.allocations());
+
+    // after coalescing everything fits in one block again
+    void *c = arena.allocate(1024);
+    void *d = arena.allocate(128);
+    CPPUNIT_ASSERT(static_cast<char *>(d) >= static_cast<char *>(c) + 1024);
+    CPPUNIT_ASSERT_EQUAL(cap, arena.capacity());
+}
+
+void TestArena::testScope() {
+    nix::Arena outer, inner;
+    CPPUNIT_ASSERT(nix::Arena::current() == nullptr);
+
+    {
+        nix::ArenaScope s1(outer, false);
+        CPPUNIT_ASSERT(nix::Arena::current() == &outer);
+        outer.allocate(16);
+        {
+            nix::ArenaScope s2(inner);
+            CPPUNIT_ASSERT(nix::Arena::current() == &inner);
+            inner.allocate(16);
+        }
+        CPPUNIT_ASSERT(nix::Arena::current() == &outer);
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), inner.allocations());
+    }
+
+    CPPUNIT_ASSERT(nix::Arena::current() == nullptr);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), outer.allocations());
+}
+
+void TestArena::testScratchBuffer() {
+    nix::ScratchBuffer<double> heap(16);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(16), heap.size());
+
+    nix::Arena arena;
+    nix::ArenaScope scope(arena);
+
+    nix::ScratchBuffer<double> buf(32);
+    for (size_t i = 0; i < buf.size(); i++) {
+        buf[i] = static_cast<double>(i);
+    }
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), arena.allocations());
+    CPPUNIT_ASSERT_EQUAL(31.0, buf[31]);
+
+    buf.resize(8);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(8), buf.size());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), arena.allocations());
+}
@@ -0,0 +1,31 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#ifndef NIX_TESTARENA
+#define NIX_TESTARENA
+
+class TestArena: public CPPUNIT_NS::TestFixture {
+private:
+
+    CPPUNIT_TEST_SUITE(TestArena);
+    CPPUNIT_TEST(testAllocate);
+    CPPUNIT_TEST(testScope);
+    CPPUNIT_TEST(testScratchBuffer);
+    CPPUNIT_TEST_SUITE_END ();
+
+public:
+
+    void testAllocate();
+    void testScope();
+    void testScratchBuffer();
+};
+
+#endif //NIX_TESTARENA
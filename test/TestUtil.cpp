@@ -10,6 +10,7 @@
 
 #include <ctime>
 #include <cmath>
+#include <numeric>
 
 
 using namespace std;
@@ -199,3 +200,20 @@ void TestUtil::testStringVectors() {
     CPPUNIT_ASSERT(util::isSetAtSamePos(vec_a, vec_c));
     CPPUNIT_ASSERT(!util::isSetAtSamePos(vec_a, vec_d));
 }
+
+void TestUtil::testCopyRegion() {
+    // 3x4 source, copy the 2x2 block at (1, 1) into a 3x3 destination at (0, 1)
+    std::vector<int> src(12);
+    std::iota(src.begin(), src.end(), 0);
+    std::vector<int> dst(9, -1);
+
+    util::copyRegion(src.data(), {3, 4}, {1, 1}, dst.data(), {3, 3}, {0, 1}, {2, 2}, sizeof(int));
+
+    std::vector<int> expected{-1, 5, 6,
+                              -1, 9, 10,
+                              -1, -1, -1};
+    CPPUNIT_ASSERT(dst == expected);
+
+    CPPUNIT_ASSERT_THROW(util::copyRegion(src.data(), {12}, {0}, dst.data(), {3, 3}, {0, 0}, {2, 2}, sizeof(int)),
+                         IncompatibleDimensions);
+}
@@ -393,3 +393,32 @@ void TestValidate::test() {
     setValid();
 
 }
+
+
+void TestValidate::testModified() {
+    setValid();
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<time_t>(0), file.validatedAt());
+    Result full = file.validate();
+    CPPUNIT_ASSERT(!full.hasErrors());
+    CPPUNIT_ASSERT(!full.hasSkipped());
+
+    // everything changed since startup
+    Result res = file.validateModified(startup_time);
+    CPPUNIT_ASSERT(!res.hasSkipped());
+    CPPUNIT_ASSERT_EQUAL(full.getWarnings().size(), res.getWarnings().size());
+
+    // nothing changed after now
+    time_t stamp = time(NULL) + 1;
+    file.forceValidatedAt(stamp);
+    CPPUNIT_ASSERT_EQUAL(stamp, file.validatedAt());
+
+    res = file.validateModified(file.validatedAt());
+    CPPUNIT_ASSERT(!res.hasErrors());
+    CPPUNIT_ASSERT(!res.hasWarnings());
+    // block, six data arrays, multi tag & tag
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(9), res.getSkipped().size());
+    CPPUNIT_ASSERT_EQUAL(block.id(), res.getSkipped()[0].id);
+
+    setValid();
+}
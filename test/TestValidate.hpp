@@ -54,6 +54,7 @@ private:
 
     CPPUNIT_TEST_SUITE(TestValidate);
     CPPUNIT_TEST(test);
+    CPPUNIT_TEST(testModified);
     CPPUNIT_TEST_SUITE_END ();
 
     time_t startup_time;
@@ -93,4 +94,5 @@ public:
     void tearDown();
 
     void test();
+    void testModified();
 };
@@ -0,0 +1,89 @@
+#!/usr/bin/env python3
+# Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+#
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted under the terms of the BSD License. See
+# LICENSE file in the root of the Project.
+
+"""Compare two result files of nix-bench.
+
+Benchmarks are matched by suite, name, backend and problem size; the
+median time per operation of the current run is compared to the
+baseline. Exits with status 1 if any benchmark got slower by more than
+the threshold, so it can be used to catch regressions between releases:
+
+    nix-bench --output=baseline.json     # with the last release
+    nix-bench --output=current.json      # with the current tree
+    benchmark-compare.py baseline.json current.json --threshold=10
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as fd:
+        data = json.load(fd)
+    results = {}
+    for res in data["results"]:
+        key = (res["suite"], res["name"], res["backend"], res["n"])
+        results[key] = res
+    return data, results
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("baseline", help="results of the reference run")
+    parser.add_argument("current", help="results of the run to check")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="slowdown in percent that counts as regression (default: 10)")
+    parser.add_argument("--all", action="store_true",
+                        help="list all benchmarks, not only the changed ones")
+    args = parser.parse_args()
+
+    base_info, base = load(args.baseline)
+    cur_info, cur = load(args.current)
+
+    print("baseline: %s (%s)" % (base_info.get("version"), base_info.get("date")))
+    print("current:  %s (%s)" % (cur_info.get("version"), cur_info.get("date")))
+    print()
+    print("%-44s %-6s %9s %12s %12s %8s" % ("benchmark", "backend", "n", "base s/op", "cur s/op", "change"))
+
+    regressions = []
+    for key in sorted(set(base) | set(cur)):
+        name = "%s/%s" % key[:2]
+        b, c = base.get(key), cur.get(key)
+        if b is None or c is None:
+            print("%-44s %-6s %9d %s" % (name, key[2], key[3], "only in " + ("current" if b is None else "baseline")))
+            continue
+        if "error" in b or "error" in c:
+            print("%-44s %-6s %9d %s" % (name, key[2], key[3], "error: " + c.get("error", b.get("error", ""))))
+            continue
+
+        b_op, c_op = b["seconds_per_op"], c["seconds_per_op"]
+        change = (c_op / b_op - 1) * 100 if b_op > 0 else 0.0
+        mark = ""
+        if change > args.threshold:
+            mark = "  REGRESSION"
+            regressions.append(name)
+        elif change < -args.threshold:
+            mark = "  faster"
+
+        if args.all or mark:
+            print("%-44s %-6s %9d %12.4g %12.4g %+7.1f%%%s" % (name, key[2], key[3], b_op, c_op, change, mark))
+
+    print()
+    if regressions:
+        print("%d regression(s) above %.0f%%" % (len(regressions), args.threshold))
+        return 1
+
+    print("no regressions above %.0f%%" % args.threshold)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
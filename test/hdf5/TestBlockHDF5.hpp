@@ -26,6 +26,9 @@ class TestBlockHDF5 : public BaseTestBlock {
     CPPUNIT_TEST(testDataArrayAccess);
     CPPUNIT_TEST(testDataFrameAccess);
     CPPUNIT_TEST(testTagAccess);
+    CPPUNIT_TEST(testTagsOverlapping);
+    CPPUNIT_TEST(testVirtualDataArray);
+    CPPUNIT_TEST(testVirtualDataArrayFiles);
     CPPUNIT_TEST(testMultiTagAccess);
     CPPUNIT_TEST(testGroupAccess);
 
@@ -21,6 +21,18 @@ class TestDataArrayHDF5 : public BaseTestDataArray {
     CPPUNIT_TEST(testName);
     CPPUNIT_TEST(testDefinition);
     CPPUNIT_TEST(testData);
+    CPPUNIT_TEST(testDataAsync);
+    CPPUNIT_TEST(testDataParallel);
+    CPPUNIT_TEST(testGetDataParallel);
+    CPPUNIT_TEST(testChunkIterator);
+    CPPUNIT_TEST(testMapData);
+    CPPUNIT_TEST(testSelection);
+    CPPUNIT_TEST(testDataStorageSize);
+    CPPUNIT_TEST(testReadAhead);
+    CPPUNIT_TEST(testEnvelopes);
+    CPPUNIT_TEST(testStatistics);
+    CPPUNIT_TEST(testDataLayout);
+    CPPUNIT_TEST(testStringStorage);
     CPPUNIT_TEST(testPolynomial);
     CPPUNIT_TEST(testLabel);
     CPPUNIT_TEST(testUnit);
@@ -19,7 +19,9 @@ class TestDataFrameHDF5 : public BaseTestDataFrame {
     CPPUNIT_TEST(testBasic);
     CPPUNIT_TEST(testRowIO);
     CPPUNIT_TEST(testColIO);
+    CPPUNIT_TEST(testAsyncIO);
     CPPUNIT_TEST(testCellIO);
+    CPPUNIT_TEST(testStringStorage);
     CPPUNIT_TEST_SUITE_END ();
 
 public:
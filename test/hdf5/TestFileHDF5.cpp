@@ -14,9 +14,15 @@
 #include "hdf5/h5x/H5Group.hpp"
 #include "hdf5/FileHDF5.hpp"
 
+#include <cstdio>
 #include <sstream>
 #include <nix/util/util.hpp>
 
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 namespace h5x = nix::hdf5;
 
 static std::string make_file_with_version(int x, int y, int z) {
@@ -89,3 +95,284 @@ void TestFileHDF5::testVersion() {
     ASSERT_NOOPEN(mbc.c_str(), nix::FileMode::ReadWrite);
     ASSERT_NOOPEN(mbc.c_str(), nix::FileMode::ReadOnly);
 }
+
+
+void TestFileHDF5::testRepack() {
+    nix::File src = nix::File::open("test_repack.h5", nix::FileMode::Overwrite);
+    nix::Block block = src.createBlock("block", "test");
+    nix::Section section = src.createSection("section", "test");
+
+    // grown in small steps from a tiny initial extent
+    std::vector<double> values(100);
+    nix::DataArray da = block.createDataArray("signal", "test", nix::DataType::Double, nix::NDSize({10}));
+    for (size_t i = 0; i < 100; i++) {
+        std::fill(values.begin(), values.end(), static_cast<double>(i));
+        da.appendData(nix::DataType::Double, values.data(), {100}, 0);
+    }
+    da.appendSampledDimension(1.0);
+    da.metadata(section);
+
+    std::vector<std::string> names = {"a", "b", "c"};
+    nix::DataArray labels = block.createDataArray("labels", "test", names);
+    labels.appendSetDimension();
+
+    nix::Tag tag = block.createTag("tag", "test", {1.0});
+    tag.addReference(da);
+
+    const time_t created = src.createdAt();
+    const std::string block_id = block.id(), da_id = da.id(), labels_id = labels.id();
+    const std::string tag_id = tag.id(), section_id = section.id();
+    const nix::NDSize src_chunks = da.dataChunks();
+    src.close();
+
+    const nix::NDSize chunks = {4096};
+    nix::RepackStats stats = nix::repack("test_repack.h5", "test_repack_copy.h5",
+                                         [&chunks](const std::string &name, const nix::StorageLayout &layout) {
+                                             nix::RepackTarget target;
+                                             target.compression = nix::Compression::DeflateNormal;
+                                             if (name == "signal") {
+                                                 target.chunks = chunks;
+                                             }
+                                             return target;
+                                         }, 2);
+    CPPUNIT_ASSERT_EQUAL(static_cast<nix::ndsize_t>(1), stats.rewritten);
+    CPPUNIT_ASSERT(stats.links > 0);
+
+    nix::File copy = nix::File::open("test_repack_copy.h5", nix::FileMode::ReadOnly);
+    CPPUNIT_ASSERT_EQUAL(created, copy.createdAt());
+    CPPUNIT_ASSERT(!copy.validate().hasErrors());
+
+    nix::Block block_copy = copy.getBlock(block_id);
+    nix::DataArray da_copy = block_copy.getDataArray(da_id);
+    CPPUNIT_ASSERT(da_copy.dataChunks() == chunks);
+    CPPUNIT_ASSERT(da_copy.dataChunks() != src_chunks);
+    CPPUNIT_ASSERT(da_copy.dataLayout().filters.size() == 1);
+    CPPUNIT_ASSERT(da_copy.dataExtent() == nix::NDSize({10010}));
+
+    std::vector<double> data;
+    da_copy.getData(data);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(10010), data.size());
+    CPPUNIT_ASSERT_EQUAL(0.0, data[9]);
+    CPPUNIT_ASSERT_EQUAL(42.0, data[10 + 42 * 100 + 7]);
+    CPPUNIT_ASSERT_EQUAL(99.0, data.back());
+
+    // strings are copied as they are
+    std::vector<std::string> names_copy;
+    block_copy.getDataArray(labels_id).getData(names_copy);
+    CPPUNIT_ASSERT(names == names_copy);
+
+    // references and metadata links point to the copies
+    nix::Tag tag_copy = block_copy.getTag(tag_id);
+    CPPUNIT_ASSERT(tag_copy.hasReference(da_id));
+    CPPUNIT_ASSERT_EQUAL(section_id, da_copy.metadata().id());
+    CPPUNIT_ASSERT_EQUAL(section_id, copy.getSection(section_id).id());
+    copy.close();
+
+    CPPUNIT_ASSERT_THROW(nix::repack("test_repack.h5", "test_repack.h5"), std::invalid_argument);
+}
+
+
+void TestFileHDF5::testIOStats() {
+    nix::File file = nix::File::open("test_io_stats.h5", nix::FileMode::Overwrite);
+    nix::Block block = file.createBlock("block", "test");
+
+    nix::IOTrace::enable();
+    file.resetIOStats();
+
+    std::vector<double> values(100, 1.0);
+    nix::DataArray da = block.createDataArray("signal", "test", values);
+    std::vector<double> read;
+    da.getData(read);
+    da.getData(read);
+    block.getDataArray("signal");
+
+    nix::IOTrace::enable(false);
+    nix::IOStats stats = file.ioStats();
+
+    const nix::IOCounter &reads = stats.operations[nix::IOOperation::DataRead];
+    CPPUNIT_ASSERT_EQUAL(static_cast<nix::ndsize_t>(2), reads.calls);
+    CPPUNIT_ASSERT_EQUAL(static_cast<nix::ndsize_t>(1600), reads.bytes);
+    nix::ndsize_t hist = 0;
+    for (nix::ndsize_t n : reads.histogram) {
+        hist += n;
+    }
+    CPPUNIT_ASSERT_EQUAL(reads.calls, hist);
+
+    CPPUNIT_ASSERT(stats.operations[nix::IOOperation::DataWrite].bytes >= 800);
+    CPPUNIT_ASSERT(stats.operations[nix::IOOperation::AttrWrite].calls > 0);
+    CPPUNIT_ASSERT(stats.operations[nix::IOOperation::ObjectLookup].calls > 0);
+
+    auto entity = stats.entities.find("/data/block/data_arrays/signal/data");
+    CPPUNIT_ASSERT(entity != stats.entities.end());
+    CPPUNIT_ASSERT_EQUAL(static_cast<nix::ndsize_t>(2), entity->second[nix::IOOperation::DataRead].calls);
+
+    const std::string json = stats.toJson();
+    CPPUNIT_ASSERT(json.find("\"data_read\": {\"calls\": 2, \"bytes\": 1600") != std::string::npos);
+
+    // nothing is counted while disabled
+    da.getData(read);
+    CPPUNIT_ASSERT_EQUAL(static_cast<nix::ndsize_t>(2), file.ioStats().operations[nix::IOOperation::DataRead].calls);
+
+    file.resetIOStats();
+    CPPUNIT_ASSERT(file.ioStats().operations.empty());
+    file.close();
+}
+
+
+#ifndef _WIN32
+
+// reader process of testSwmr: follows the appended data until all of
+// it arrived and checks it; the exit status is the result
+static int swmr_reader(int ready, size_t total) {
+    char c;
+    if (read(ready, &c, 1) != 1) {
+        return 2;
+    }
+
+    try {
+        nix::File file = nix::File::open("test_swmr.h5", nix::FileMode::SwmrRead);
+        nix::DataArray da = file.getBlock("run").getDataArray("trace");
+
+        nix::ndsize_t n = 0;
+        for (int polls = 0; polls < 10000 && n < total; polls++) {
+            n = da.dataExtent()[0];
+            usleep(1000);
+        }
+
+        std::vector<double> values;
+        da.getData(values);
+        if (values.size() != total) {
+            return 3;
+        }
+        for (size_t i = 0; i < total; i++) {
+            if (values[i] != static_cast<double>(i)) {
+                return 4;
+            }
+        }
+    } catch (...) {
+        return 5;
+    }
+    return 0;
+}
+
+#endif
+
+
+void TestFileHDF5::testSwmr() {
+    CPPUNIT_ASSERT_THROW(file_open.startSwmrWrite(), std::runtime_error);
+    CPPUNIT_ASSERT_THROW(nix::File::open("test_swmr_none.h5", nix::FileMode::SwmrRead), std::runtime_error);
+
+    std::remove("test_swmr.h5");
+#if !H5_VERSION_GE(1, 10, 0)
+    CPPUNIT_ASSERT_THROW(nix::File::open("test_swmr.h5", nix::FileMode::SwmrWrite), std::runtime_error);
+    return;
+#endif
+
+    // entity layout; SwmrWrite keeps the content of existing files
+    nix::File file = nix::File::open("test_swmr.h5", nix::FileMode::SwmrWrite);
+    CPPUNIT_ASSERT(file.fileMode() == nix::FileMode::SwmrWrite);
+    file.createBlock("run", "acquisition").createDataArray("trace", "voltage", nix::DataType::Double, {0});
+    file.close();
+
+#ifndef _WIN32
+    const size_t batch = 100, batches = 10;
+
+    // the reader must not inherit the open file: fork before opening it
+    int ready[2];
+    CPPUNIT_ASSERT_EQUAL(0, pipe(ready));
+    pid_t pid = fork();
+    CPPUNIT_ASSERT(pid >= 0);
+    if (pid == 0) {
+        close(ready[1]);
+        _exit(swmr_reader(ready[0], batch * batches));
+    }
+    close(ready[0]);
+
+    int status = -1;
+    try {
+        file = nix::File::open("test_swmr.h5", nix::FileMode::SwmrWrite);
+        nix::DataArray da = file.getBlock("run").getDataArray("trace");
+        time_t updated = da.updatedAt();
+        CPPUNIT_ASSERT_THROW(file.startSwmrWrite(), std::runtime_error);
+        da = nix::DataArray();
+        file.startSwmrWrite();
+        da = file.getBlock("run").getDataArray("trace");
+        CPPUNIT_ASSERT_EQUAL(static_cast<ssize_t>(1), write(ready[1], "x", 1));
+
+        std::vector<double> values(batch);
+        for (size_t k = 0; k < batches; k++) {
+            for (size_t i = 0; i < batch; i++) {
+                values[i] = static_cast<double>(k * batch + i);
+            }
+            da.appendData(nix::DataType::Double, values.data(), {batch}, 0);
+            file.flush();
+            usleep(2000);
+        }
+        CPPUNIT_ASSERT_EQUAL(updated, da.updatedAt());
+        CPPUNIT_ASSERT_EQUAL(nix::NDSize({batch * batches}), da.dataExtent());
+        file.close();
+    } catch (...) {
+        close(ready[1]);
+        waitpid(pid, &status, 0);
+        throw;
+    }
+    close(ready[1]);
+
+    CPPUNIT_ASSERT_EQUAL(pid, waitpid(pid, &status, 0));
+    CPPUNIT_ASSERT(WIFEXITED(status));
+    CPPUNIT_ASSERT_EQUAL(0, WEXITSTATUS(status));
+#endif
+}
+
+
+void TestFileHDF5::testFileImage() {
+    std::vector<double> values {1.0, 2.0, 3.0, 4.0};
+
+    // create in memory and serialize
+    nix::File mem = nix::File::createInMemory();
+    CPPUNIT_ASSERT(mem.isOpen());
+    mem.createBlock("run", "acquisition").createDataArray("trace", "voltage", values);
+    mem.createSection("meta", "recording");
+    std::vector<char> image = mem.toBuffer();
+    mem.close();
+    CPPUNIT_ASSERT(!image.empty());
+
+    // read-only, zero-copy
+    const std::vector<char> pristine = image;
+    nix::File ro = nix::File::openFromBuffer(image.data(), image.size());
+    CPPUNIT_ASSERT(ro.fileMode() == nix::FileMode::ReadOnly);
+    CPPUNIT_ASSERT_EQUAL(std::string("nix"), ro.format());
+    std::vector<double> read;
+    ro.getBlock("run").getDataArray("trace").getData(read);
+    CPPUNIT_ASSERT(values == read);
+    CPPUNIT_ASSERT(ro.hasSection("meta"));
+    CPPUNIT_ASSERT_THROW(ro.createBlock("other", "acquisition"), std::exception);
+    ro.close();
+    CPPUNIT_ASSERT(image == pristine);
+
+    // read-write works on a copy
+    nix::File rw = nix::File::openFromBuffer(image.data(), image.size(), nix::FileMode::ReadWrite);
+    rw.createBlock("other", "acquisition");
+    std::vector<char> changed = rw.toBuffer();
+    rw.close();
+    CPPUNIT_ASSERT(image == pristine);
+
+    nix::File reopened = nix::File::openFromBuffer(changed.data(), changed.size());
+    CPPUNIT_ASSERT(reopened.hasBlock("other"));
+    CPPUNIT_ASSERT(reopened.hasBlock("run"));
+    reopened.close();
+
+    // backing store
+    std::remove("test_file_image.h5");
+    mem = nix::File::createInMemory("test_file_image.h5");
+    mem.createBlock("run", "acquisition");
+    mem.close();
+    nix::File disk = nix::File::open("test_file_image.h5", nix::FileMode::ReadOnly);
+    CPPUNIT_ASSERT(disk.hasBlock("run"));
+    CPPUNIT_ASSERT(disk.toBuffer().size() > 0);
+    disk.close();
+
+    CPPUNIT_ASSERT_THROW(nix::File::openFromBuffer(nullptr, 0), std::invalid_argument);
+    CPPUNIT_ASSERT_THROW(nix::File::openFromBuffer(pristine.data(), pristine.size(), nix::FileMode::Overwrite),
+                         std::invalid_argument);
+}
@@ -22,12 +22,24 @@ class TestFileHDF5: public BaseTestFile {
     CPPUNIT_TEST(testSectionAccess);
     CPPUNIT_TEST(testOperators);
     CPPUNIT_TEST(testReopen);
+    CPPUNIT_TEST(testRepack);
+    CPPUNIT_TEST(testIOStats);
+    CPPUNIT_TEST(testSwmr);
+    CPPUNIT_TEST(testFileImage);
     CPPUNIT_TEST_SUITE_END ();
 
 public:
 
     void testVersion() override;
 
+    void testRepack();
+
+    void testIOStats();
+
+    void testSwmr();
+
+    void testFileImage();
+
     void setUp() override {
         startup_time = time(NULL);
         file_open = nix::File::open("test_file.h5", nix::FileMode::Overwrite);
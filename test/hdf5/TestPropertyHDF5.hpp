@@ -21,6 +21,8 @@ class TestPropertyHDF5 : public BaseTestProperty {
     CPPUNIT_TEST(testDefinition);
 
     CPPUNIT_TEST(testValues);
+    CPPUNIT_TEST(testStringStorage);
+    CPPUNIT_TEST(testTypedValues);
     CPPUNIT_TEST(testDataType);
     CPPUNIT_TEST(testUnit);
 
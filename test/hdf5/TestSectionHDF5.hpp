@@ -27,6 +27,7 @@ class TestSectionHDF5 : public BaseTestSection {
     CPPUNIT_TEST(testSectionAccess);
     CPPUNIT_TEST(testFindSection);
     CPPUNIT_TEST(testFindRelated);
+    CPPUNIT_TEST(testMetadataSnapshot);
     CPPUNIT_TEST(testPropertyAccess);
     CPPUNIT_TEST(testReferringData);
     CPPUNIT_TEST(testReferringTags);
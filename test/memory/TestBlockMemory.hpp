@@ -0,0 +1,61 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_TESTBLOCKMEMORY_HPP
+#define NIX_TESTBLOCKMEMORY_HPP
+
+#include "BaseTestBlock.hpp"
+
+class TestBlockMemory : public BaseTestBlock {
+
+    CPPUNIT_TEST_SUITE(TestBlockMemory);
+
+    CPPUNIT_TEST(testValidate);
+    CPPUNIT_TEST(testId);
+    CPPUNIT_TEST(testType);
+    CPPUNIT_TEST(testName);
+    CPPUNIT_TEST(testDefinition);
+
+    CPPUNIT_TEST(testMetadataAccess);
+    CPPUNIT_TEST(testSourceAccess);
+    CPPUNIT_TEST(testDataArrayAccess);
+    CPPUNIT_TEST(testDataFrameAccess);
+    CPPUNIT_TEST(testTagAccess);
+    CPPUNIT_TEST(testTagsOverlapping);
+    CPPUNIT_TEST(testVirtualDataArray);
+    CPPUNIT_TEST(testMultiTagAccess);
+    CPPUNIT_TEST(testGroupAccess);
+
+    CPPUNIT_TEST(testOperators);
+    CPPUNIT_TEST(testUpdatedAt);
+    CPPUNIT_TEST(testCreatedAt);
+
+    CPPUNIT_TEST(testCompare);
+
+    CPPUNIT_TEST_SUITE_END ();
+
+public:
+    void setUp() {
+        startup_time = time(NULL);
+        file = nix::File::open("test_block_memory", nix::FileMode::Overwrite, "memory");
+
+        section = file.createSection("foo_section", "metadata");
+
+        block = file.createBlock("block_one", "dataset");
+        block_other = file.createBlock("block_two", "dataset");
+        block_null  = nix::none;
+    }
+
+
+    void tearDown() {
+        file.close();
+    }
+    
+};
+
+#endif //NIX_TESTBLOCKMEMORY_HPP
@@ -0,0 +1,38 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_TESTDATAFRAMEMEMORY_HPP
+#define NIX_TESTDATAFRAMEMEMORY_HPP
+
+#include "BaseTestDataFrame.hpp"
+
+class TestDataFrameMemory : public BaseTestDataFrame {
+
+    CPPUNIT_TEST_SUITE(TestDataFrameMemory);
+    CPPUNIT_TEST(testBasic);
+    CPPUNIT_TEST(testRowIO);
+    CPPUNIT_TEST(testColIO);
+    CPPUNIT_TEST(testAsyncIO);
+    CPPUNIT_TEST(testCellIO);
+    CPPUNIT_TEST(testStringStorage);
+    CPPUNIT_TEST_SUITE_END ();
+
+public:
+    void setUp() {
+        startup_time = time(NULL);
+        file = nix::File::open("test_DataFrame_memory", nix::FileMode::Overwrite, "memory");
+        block = file.createBlock("b1", "dataset");
+    }
+
+    void tearDown() {
+        file.close();
+    }
+
+};
+
+#endif //NIX_TESTDATAFRAMEMEMORY_HPP
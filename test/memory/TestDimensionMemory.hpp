@@ -0,0 +1,55 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_TESTDIMENSIONMEMORY_HPP
+#define NIX_TESTDIMENSIONMEMORY_HPP
+
+#include "BaseTestDimension.hpp"
+
+class TestDimensionMemory : public BaseTestDimension {
+
+    CPPUNIT_TEST_SUITE(TestDimensionMemory);
+    CPPUNIT_TEST(testValidate);
+    CPPUNIT_TEST(testSetValidate);
+    CPPUNIT_TEST(testSampleValidate);
+    CPPUNIT_TEST(testRangeValidate);
+    CPPUNIT_TEST(testIndex);
+    CPPUNIT_TEST(testSampledDimLabel);
+    CPPUNIT_TEST(testSampledDimOffset);
+    CPPUNIT_TEST(testSampledDimUnit);
+    CPPUNIT_TEST(testSampledDimSamplingInterval);
+    CPPUNIT_TEST(testSampledDimOperators);
+    CPPUNIT_TEST(testSampledDimIndexOf);
+    CPPUNIT_TEST(testSampledDimPositionAt);
+    CPPUNIT_TEST(testSampledDimAxis);
+    CPPUNIT_TEST(testSetDimLabels);
+    CPPUNIT_TEST(testRangeDimLabel);
+    CPPUNIT_TEST(testRangeDimUnit);
+    CPPUNIT_TEST(testRangeTicks);
+    CPPUNIT_TEST(testRangeDimIndexOf);
+    CPPUNIT_TEST(testRangeDimTickAt);
+    CPPUNIT_TEST(testRangeDimAxis);
+    CPPUNIT_TEST(testAsDimensionMethods);
+    CPPUNIT_TEST_SUITE_END ();
+
+public:
+    void setUp() {
+        file = nix::File::open("test_dimension_memory", nix::FileMode::Overwrite, "memory");
+        block = file.createBlock("dimensionTest","test");
+        data_array = block.createDataArray("dimensionTest", "Test",
+                                           nix::DataType::Double, nix::NDSize({ 0 }));
+    }
+
+
+    void tearDown() {
+        file.deleteBlock(block.id());
+        file.close();
+    }
+};
+
+#endif //NIX_TESTDIMENSIONMEMORY_HPP
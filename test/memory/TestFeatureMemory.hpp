@@ -0,0 +1,46 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_TESTFEATUREMEMORY_HPP
+#define NIX_TESTFEATUREMEMORY_HPP
+
+#include "BaseTestFeature.hpp"
+
+class TestFeatureMemory : public BaseTestFeature {
+
+
+    CPPUNIT_TEST_SUITE(TestFeatureMemory);
+    CPPUNIT_TEST(testValidate);
+    CPPUNIT_TEST(testId);
+    CPPUNIT_TEST(testLinkType);
+    CPPUNIT_TEST(testData);
+    CPPUNIT_TEST(testLinkType2Str);
+    CPPUNIT_TEST(testStreamOperator);
+    CPPUNIT_TEST(testOperator);
+    CPPUNIT_TEST_SUITE_END ();
+
+public:
+    void setUp() {
+        file = nix::File::open("test_feature_memory", nix::FileMode::Overwrite, "memory");
+        block = file.createBlock("featureTest","test");
+
+        data_array = block.createDataArray("featureTest", "Test",
+                                           nix::DataType::Double, nix::NDSize({ 0 }));
+
+        tag = block.createTag("featureTest", "Test", {0.0, 2.0, 3.4});
+    }
+
+    void tearDown() {
+        file.deleteBlock(block.id());
+        file.close();
+    }
+
+};
+
+
+#endif //NIX_TESTFEATUREMEMORY_HPP
@@ -0,0 +1,207 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "TestFileMemory.hpp"
+
+#include <cstdio>
+#include <fstream>
+
+namespace {
+
+// check the entities written by fill_file, read back from file
+void check_file(const nix::File &file, const nix::File &orig) {
+    CPPUNIT_ASSERT_EQUAL(orig.createdAt(), file.createdAt());
+
+    nix::Section section = file.getSection("recording");
+    nix::Section osection = orig.getSection("recording");
+    CPPUNIT_ASSERT_EQUAL(osection.id(), section.id());
+    CPPUNIT_ASSERT_EQUAL(osection.createdAt(), section.createdAt());
+    CPPUNIT_ASSERT_EQUAL(osection.updatedAt(), section.updatedAt());
+    CPPUNIT_ASSERT(section.repository() && *section.repository() == "lab");
+
+    nix::Property prop = section.getProperty("gain");
+    CPPUNIT_ASSERT_EQUAL(osection.getProperty("gain").id(), prop.id());
+    CPPUNIT_ASSERT(prop.unit() && *prop.unit() == "dB");
+    CPPUNIT_ASSERT_EQUAL(42.0, prop.values()[0].get<double>());
+    CPPUNIT_ASSERT_EQUAL(std::string("amp"), section.getSection("device").getProperty("model").values()[0].get<std::string>());
+    CPPUNIT_ASSERT_EQUAL(section.getSection("device").id(), file.getSection("template").link().id());
+
+    nix::Block block = file.getBlock("session");
+    nix::Block oblock = orig.getBlock("session");
+    CPPUNIT_ASSERT_EQUAL(oblock.id(), block.id());
+    CPPUNIT_ASSERT_EQUAL(section.id(), block.metadata().id());
+    CPPUNIT_ASSERT_EQUAL(oblock.getSource("cell").getSource("channel").id(),
+                         block.getSource("cell").getSource("channel").id());
+
+    nix::DataArray trace = block.getDataArray("trace");
+    CPPUNIT_ASSERT_EQUAL(oblock.getDataArray("trace").id(), trace.id());
+    CPPUNIT_ASSERT(trace.unit() && *trace.unit() == "mV");
+    CPPUNIT_ASSERT_EQUAL(nix::NDSize({2, 3}), trace.dataExtent());
+    std::vector<double> values(6);
+    trace.getData(nix::DataType::Double, values.data(), nix::NDSize({2, 3}), nix::NDSize({0, 0}));
+    CPPUNIT_ASSERT(values == std::vector<double>({1.0, 2.0, 3.0, 4.0, 5.0, 6.0}));
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(2), trace.dimensionCount());
+    CPPUNIT_ASSERT(trace.getDimension(1).asSetDimension().labels() == std::vector<std::string>({"left", "right"}));
+    CPPUNIT_ASSERT_EQUAL(0.1, trace.getDimension(2).asSampledDimension().samplingInterval());
+    CPPUNIT_ASSERT_EQUAL(block.getSource("cell").getSource("channel").id(), trace.getSource(0).id());
+
+    nix::DataArray labels = block.getDataArray("labels");
+    std::vector<std::string> strings;
+    labels.getData(strings);
+    CPPUNIT_ASSERT(strings == std::vector<std::string>({"a", "b", "a"}));
+    CPPUNIT_ASSERT(labels.stringStorage().mode == nix::StringStorage::Mode::Dictionary);
+
+    nix::DataArray times = block.getDataArray("times");
+    CPPUNIT_ASSERT(times.getDimension(1).asRangeDimension().alias());
+
+    nix::Tag tag = block.getTag("stimulus");
+    CPPUNIT_ASSERT_EQUAL(oblock.getTag("stimulus").id(), tag.id());
+    CPPUNIT_ASSERT(tag.position() == std::vector<double>({0.0, 0.2}));
+    CPPUNIT_ASSERT(tag.hasReference(trace));
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(1), tag.featureCount());
+    nix::Feature feature = tag.getFeature(0);
+    CPPUNIT_ASSERT_EQUAL(oblock.getTag("stimulus").getFeature(0).id(), feature.id());
+    CPPUNIT_ASSERT_EQUAL(nix::LinkType::Indexed, feature.linkType());
+    CPPUNIT_ASSERT_EQUAL(times.id(), feature.data().id());
+
+    nix::MultiTag mtag = block.getMultiTag("spikes");
+    CPPUNIT_ASSERT_EQUAL(times.id(), mtag.positions().id());
+    CPPUNIT_ASSERT(mtag.hasReference(trace));
+
+    nix::DataFrame frame = block.getDataFrame("table");
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(2), frame.rows());
+    std::vector<std::string> names;
+    frame.readColumn("name", names, true);
+    CPPUNIT_ASSERT(names == std::vector<std::string>({"x", "y"}));
+    std::vector<int32_t> counts;
+    frame.readColumn("count", counts, true);
+    CPPUNIT_ASSERT(counts == std::vector<int32_t>({7, 8}));
+
+    nix::Group group = block.getGroup("selection");
+    CPPUNIT_ASSERT(group.hasDataArray(trace.id()));
+    CPPUNIT_ASSERT(group.hasTag(tag.id()));
+    CPPUNIT_ASSERT(group.hasDataFrame(frame.id()));
+}
+
+
+void fill_file(nix::File &file) {
+    nix::Section section = file.createSection("recording", "metadata");
+    section.repository("lab");
+    nix::Property prop = section.createProperty("gain", nix::Variant(42.0));
+    prop.unit("dB");
+    nix::Section device = section.createSection("device", "hardware");
+    device.createProperty("model", nix::Variant("amp"));
+    file.createSection("template", "metadata").link(device);
+
+    nix::Block block = file.createBlock("session", "recording");
+    block.metadata(section);
+    nix::Source channel = block.createSource("cell", "neuron").createSource("channel", "electrode");
+
+    nix::DataArray trace = block.createDataArray("trace", "voltage", nix::DataType::Double, nix::NDSize({2, 3}));
+    std::vector<double> values({1.0, 2.0, 3.0, 4.0, 5.0, 6.0});
+    trace.setData(nix::DataType::Double, values.data(), nix::NDSize({2, 3}), nix::NDSize({0, 0}));
+    trace.unit("mV");
+    trace.appendSetDimension().labels({"left", "right"});
+    trace.appendSampledDimension(0.1);
+    trace.addSource(channel);
+
+    nix::DataArray labels = block.createDataArray("labels", "labels", nix::DataType::String, nix::NDSize({3}),
+                                                  nix::Compression::Auto, nix::StringStorage::dictionary());
+    labels.setData(std::vector<std::string>({"a", "b", "a"}));
+
+    nix::DataArray times = block.createDataArray("times", "times", std::vector<double>({0.1, 0.4}));
+    times.appendAliasRangeDimension();
+
+    nix::Tag tag = block.createTag("stimulus", "event", {0.0, 0.2});
+    tag.addReference(trace);
+    tag.createFeature(times, nix::LinkType::Indexed);
+
+    nix::MultiTag mtag = block.createMultiTag("spikes", "events", times);
+    mtag.addReference(trace);
+
+    std::vector<nix::Column> cols = {
+        {"name", "", nix::DataType::String},
+        {"count", "", nix::DataType::Int32}};
+    nix::DataFrame frame = block.createDataFrame("table", "table", cols);
+    frame.rows(2);
+    frame.writeColumn("name", std::vector<std::string>({"x", "y"}));
+    frame.writeColumn("count", std::vector<int32_t>({7, 8}));
+
+    nix::Group group = block.createGroup("selection", "group");
+    group.addDataArray(trace);
+    group.addTag(tag);
+    group.addDataFrame(frame);
+
+    file.forceCreatedAt(file.createdAt() - 1000);
+}
+
+} // anonymous namespace
+
+
+void TestFileMemory::testSaveAs() {
+    std::vector<double> values {1.0, 2.0, 3.0};
+
+    // nothing is written to disk
+    std::remove("test_memory.h5");
+    nix::File mem = nix::File::open("test_memory.h5", nix::FileMode::Overwrite, "memory");
+    mem.createBlock("run", "acquisition").createDataArray("trace", "voltage", values);
+    mem.flush();
+    CPPUNIT_ASSERT(!std::ifstream("test_memory.h5"));
+
+    // save as HDF5
+    mem.saveAs("test_memory.h5");
+    mem.createBlock("later", "acquisition");
+    mem.close();
+
+    nix::File disk = nix::File::open("test_memory.h5", nix::FileMode::ReadOnly);
+    CPPUNIT_ASSERT(disk.hasBlock("run"));
+    CPPUNIT_ASSERT(!disk.hasBlock("later"));
+    disk.close();
+
+    // load from HDF5, changes stay in memory
+    mem = nix::File::open("test_memory.h5", nix::FileMode::ReadWrite, "memory");
+    std::vector<double> read;
+    mem.getBlock("run").getDataArray("trace").getData(read);
+    CPPUNIT_ASSERT(values == read);
+    mem.deleteBlock("run");
+    mem.close();
+
+    disk = nix::File::open("test_memory.h5", nix::FileMode::ReadOnly);
+    CPPUNIT_ASSERT(disk.hasBlock("run"));
+    disk.close();
+
+    CPPUNIT_ASSERT_THROW(nix::File::open("test_memory.h5", nix::FileMode::SwmrWrite, "memory"),
+                         std::invalid_argument);
+}
+
+
+void TestFileMemory::testRoundTrip() {
+    fill_file(file_open);
+    check_file(file_open, file_open);
+
+    // ids, times and links survive the way to HDF5 and back
+    file_open.saveAs("test_file_memory.h5");
+    nix::File disk = nix::File::open("test_file_memory.h5", nix::FileMode::ReadOnly);
+    check_file(disk, file_open);
+    CPPUNIT_ASSERT(nix::valid::validate(disk).getErrors().empty());
+    disk.close();
+
+    nix::File mem = nix::File::open("test_file_memory.h5", nix::FileMode::ReadWrite, "memory");
+    check_file(mem, file_open);
+    mem.close();
+}
+
+
+void TestFileMemory::testImage() {
+    fill_file(file_open);
+
+    std::vector<char> image = file_open.toBuffer();
+    nix::File copy = nix::File::openFromBuffer(image.data(), image.size());
+    check_file(copy, file_open);
+    copy.close();
+}
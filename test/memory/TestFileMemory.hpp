@@ -0,0 +1,65 @@
+// Copyright (c) 2018, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_TESTFILEMEMORY_HPP
+#define NIX_TESTFILEMEMORY_HPP
+
+#include "BaseTestFile.hpp"
+
+class TestFileMemory: public BaseTestFile {
+
+    CPPUNIT_TEST_SUITE(TestFileMemory);
+    CPPUNIT_TEST(testOpen);
+    CPPUNIT_TEST(testFlush);
+    CPPUNIT_TEST(testValidate);
+    CPPUNIT_TEST(testFormat);
+    CPPUNIT_TEST(testLocation);
+    CPPUNIT_TEST(testVersion);
+    CPPUNIT_TEST(testCreatedAt);
+    CPPUNIT_TEST(testUpdatedAt);
+    CPPUNIT_TEST(testBlockAccess);
+    CPPUNIT_TEST(testSectionAccess);
+    CPPUNIT_TEST(testOperators);
+    CPPUNIT_TEST(testSaveAs);
+    CPPUNIT_TEST(testRoundTrip);
+    CPPUNIT_TEST(testImage);
+    CPPUNIT_TEST_SUITE_END ();
+
+public:
+
+    void testSaveAs();
+
+    void testRoundTrip();
+
+    void testImage();
+
+    void setUp() override {
+        startup_time = time(NULL);
+        file_open = nix::File::open("test_file_memory", nix::FileMode::Overwrite, "memory");
+        file_other = nix::File::open("test_file_memory_other", nix::FileMode::Overwrite, "memory");
+        file_null = nix::none;
+    }
+
+
+    void tearDown() override {
+        file_open.close();
+        file_other.close();
+    }
+
+    nix::File openFile(const std::string &name, nix::FileMode mode) override {
+        return nix::File::open(name, mode, "memory");
+    }
+
+    void testLocation() override {
+        CPPUNIT_ASSERT(file_open.location() == "test_file_memory");
+        CPPUNIT_ASSERT(file_other.location() == "test_file_memory_other");
+    }
+
+};
+
+#endif // NIX_TESTFILEMEMORY_HPP